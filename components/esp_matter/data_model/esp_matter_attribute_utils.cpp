@@ -221,6 +221,94 @@ esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
     return update_or_report(endpoint_id, cluster_id, attribute_id, val, false /* call_attribute_callbacks */);
 }
 
+// Clusters changed by a batch which are not reported yet. The attribute_id is kInvalidAttributeId once more than
+// one attribute of the cluster has changed, so that the whole cluster is marked dirty.
+struct pending_report_t {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+};
+
+// Batches usually touch a handful of clusters, the pending reports are flushed early if there are more.
+static constexpr size_t k_max_pending_reports = 8;
+
+static void flush_pending_reports(pending_report_t *reports, size_t &count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        // The data version is increased once per cluster by ReportAttributeChanged()
+        data_model::provider::get_instance().ReportAttributeChanged(
+            chip::app::AttributePathParams(reports[i].endpoint_id, reports[i].cluster_id, reports[i].attribute_id));
+    }
+    count = 0;
+}
+
+static void add_pending_report(pending_report_t *reports, size_t &count, const batch_entry_t &entry)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (reports[i].endpoint_id == entry.endpoint_id && reports[i].cluster_id == entry.cluster_id) {
+            if (reports[i].attribute_id != entry.attribute_id) {
+                reports[i].attribute_id = chip::kInvalidAttributeId;
+            }
+            return;
+        }
+    }
+    if (count == k_max_pending_reports) {
+        flush_pending_reports(reports, count);
+    }
+    reports[count++] = { entry.endpoint_id, entry.cluster_id, entry.attribute_id };
+}
+
+static esp_err_t update_or_report_batch(const batch_entry_t *entries, size_t count, bool call_attribute_callbacks)
+{
+    VerifyOrReturnError(entries || count == 0, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "entries cannot be NULL"));
+
+    // Validate the whole batch before applying any of the values
+    for (size_t i = 0; i < count; ++i) {
+        VerifyOrReturnError(entries[i].val, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "val cannot be NULL"));
+        VerifyOrReturnError(get(entries[i].endpoint_id, entries[i].cluster_id, entries[i].attribute_id),
+                            ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Failed to get attribute handle"));
+    }
+
+    pending_report_t reports[k_max_pending_reports];
+    size_t report_count = 0;
+    esp_err_t ret = ESP_OK;
+
+    lock::ScopedChipStackLock lock(portMAX_DELAY);
+
+    for (size_t i = 0; i < count; ++i) {
+        const batch_entry_t &entry = entries[i];
+        attribute::val_print(entry.endpoint_id, entry.cluster_id, entry.attribute_id, entry.val, false);
+
+        esp_err_t err = attribute::set_val(entry.endpoint_id, entry.cluster_id, entry.attribute_id, entry.val,
+                                           call_attribute_callbacks);
+        if (err == ESP_OK) {
+            // Writable attributes are reported by the data model provider when they are written
+            attribute_t *attr = get(entry.endpoint_id, entry.cluster_id, entry.attribute_id);
+            if (!(get_flags(attr) & ATTRIBUTE_FLAG_WRITABLE)) {
+                add_pending_report(reports, report_count, entry);
+            }
+        } else if (err != ESP_ERR_NOT_FINISHED) {
+            ESP_LOGE(TAG, "Failed to set attribute value for path: 0x%x/0x%" PRIx32 "/0x%" PRIX32 " err: %d",
+                     entry.endpoint_id, entry.cluster_id, entry.attribute_id, err);
+            if (ret == ESP_OK) {
+                ret = err;
+            }
+        }
+    }
+    flush_pending_reports(reports, report_count);
+    return ret;
+}
+
+esp_err_t update_batch(const batch_entry_t *entries, size_t count)
+{
+    return update_or_report_batch(entries, count, true /* call_attribute_callbacks */);
+}
+
+esp_err_t report_batch(const batch_entry_t *entries, size_t count)
+{
+    return update_or_report_batch(entries, count, false /* call_attribute_callbacks */);
+}
+
 bool val_compare(const esp_matter_attr_val_t *val1, const esp_matter_attr_val_t *val2)
 {
     if (val1 == nullptr || val2 == nullptr) {
@@ -851,6 +851,53 @@ esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
  */
 esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
 
+/** Attribute value for the batch APIs */
+typedef struct {
+    /** Endpoint ID of the attribute */
+    uint16_t endpoint_id;
+    /** Cluster ID of the attribute */
+    uint32_t cluster_id;
+    /** Attribute ID of the attribute */
+    uint32_t attribute_id;
+    /** Pointer to the new value of the attribute */
+    esp_matter_attr_val_t *val;
+} batch_entry_t;
+
+/** Batched attribute update
+ *
+ * This API updates multiple attribute values in one go, the attributes are updated in the order of the entries
+ * and the application gets the `PRE_UPDATE` and `POST_UPDATE` callbacks for each of them, as with `update()`.
+ *
+ * The Matter stack lock is taken once for the whole batch and the changes are reported once per cluster: the data
+ * version of each changed cluster is increased once and the cluster is marked dirty for the next subscription
+ * report, instead of once per attribute. Attributes with the `ATTRIBUTE_FLAG_WRITABLE` flag are still written through
+ * the data model provider and are reported by it individually.
+ *
+ * All the paths are validated before any attribute is updated. If updating an attribute fails, the remaining
+ * entries are still applied and the first error is returned.
+ *
+ * @param[in] entries Array of attribute paths and values.
+ * @param[in] count Number of entries in the array.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if an entry has a NULL value or the attribute does not exist.
+ * @return error in case of failure.
+ */
+esp_err_t update_batch(const batch_entry_t *entries, size_t count);
+
+/** Batched attribute report
+ *
+ * Same as `update_batch()` but the application doesn't get the attribute update callbacks, as with `report()`.
+ *
+ * @param[in] entries Array of attribute paths and values.
+ * @param[in] count Number of entries in the array.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if an entry has a NULL value or the attribute does not exist.
+ * @return error in case of failure.
+ */
+esp_err_t report_batch(const batch_entry_t *entries, size_t count);
+
 /** Attribute value print
  *
  * This API prints the attribute value according to the type.
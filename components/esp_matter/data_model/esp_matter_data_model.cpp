@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <esp_check.h>
@@ -21,16 +22,20 @@
 #include <esp_matter_attribute_utils.h>
 #include <esp_matter_core.h>
 #include <esp_matter_data_model.h>
+#include <esp_matter_data_model_index.h>
 #include <esp_matter_data_model_priv.h>
 #include <esp_matter_data_model_provider.h>
 #include <esp_matter_attr_data_buffer.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_nvs.h>
 #include <esp_random.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include <nvs_flash.h>
 #include <singly_linked_list.h>
 
 #include <access/SubjectDescriptor.h>
+#include <app/AttributeAccessInterfaceRegistry.h>
 #include <app/clusters/identify-server/identify-server.h>
 #include <app/data-model-provider/MetadataTypes.h>
 #include <app/data-model-provider/Provider.h>
@@ -62,16 +67,16 @@ namespace esp_matter {
 
 struct _attribute_base_t {
     uint16_t flags; // This struct is for attributes managed internally.
+    uint16_t endpoint_id;
     esp_matter_val_type_t attribute_val_type;
     uint32_t attribute_id;
+    uint32_t cluster_id;
     struct _attribute_base_t *next;
 };
 
 struct _attribute_t : public _attribute_base_t {
     esp_matter_val_t attribute_val;
     esp_matter_attr_bounds_t *bounds;
-    uint16_t endpoint_id;
-    uint32_t cluster_id;
     attribute::callback_t override_callback;
 };
 
@@ -88,10 +93,25 @@ typedef struct _event {
     struct _event *next;
 } _event_t;
 
+/* Sorted, contiguous copy of the attribute and command lists of a cluster, see node::freeze(). The arrays are
+ * allocated in the same block as the table, the linked lists stay the owners of the nodes. */
+typedef struct _frozen_cluster {
+    uint16_t attribute_count;
+    uint16_t command_count;
+    uint16_t accepted_command_count;
+    uint16_t generated_command_count;
+    _attribute_base_t **attributes;
+    _command_t **commands;
+    uint32_t *attribute_ids;
+    uint32_t *command_ids;
+    uint16_t *command_flags;
+} _frozen_cluster_t;
+
 typedef struct _cluster {
     uint32_t cluster_id;
     uint16_t endpoint_id;
     uint8_t flags;
+    bool freeze_failed; /* The last freeze failed, cleared when the attribute or command lists change */
     const cluster::function_generic_t *functions;
     cluster::plugin_server_init_callback_t plugin_server_init_callback;
     cluster::delegate_init_callback_t delegate_init_callback;
@@ -106,6 +126,7 @@ typedef struct _cluster {
                                      _internal_attribute_t. When operating attribute_list, do check the flags first! */
     _command_t *command_list;
     _event_t *event_list;
+    _frozen_cluster_t *frozen; /* NULL unless the cluster is frozen */
     struct _cluster *next;
 } _cluster_t;
 
@@ -135,6 +156,157 @@ typedef struct _node {
     uint16_t min_unused_endpoint_id;
 } _node_t;
 
+#ifdef CONFIG_ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB
+#define ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB CONFIG_ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB
+#else
+#define ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB 1
+#endif
+
+// One pool per node type, see CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+static esp_matter_mem_pool_t s_endpoint_pool =
+    ESP_MATTER_MEM_POOL_INIT("endpoint", _endpoint_t, ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB);
+static esp_matter_mem_pool_t s_cluster_pool =
+    ESP_MATTER_MEM_POOL_INIT("cluster", _cluster_t, ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB);
+static esp_matter_mem_pool_t s_attribute_pool =
+    ESP_MATTER_MEM_POOL_INIT("attribute", _attribute_t, ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB);
+static esp_matter_mem_pool_t s_internal_attribute_pool =
+    ESP_MATTER_MEM_POOL_INIT("internal_attribute", _attribute_base_t, ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB);
+static esp_matter_mem_pool_t s_command_pool =
+    ESP_MATTER_MEM_POOL_INIT("command", _command_t, ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB);
+static esp_matter_mem_pool_t s_event_pool =
+    ESP_MATTER_MEM_POOL_INIT("event", _event_t, ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB);
+
+// The slabs of the pools are kept while the node exists, they are released with it
+static void trim_mem_pools()
+{
+    esp_matter_mem_pool_t *pools[] = {
+        &s_endpoint_pool, &s_cluster_pool, &s_attribute_pool, &s_internal_attribute_pool, &s_command_pool,
+        &s_event_pool,
+    };
+    for (esp_matter_mem_pool_t *pool : pools) {
+        esp_matter_mem_pool_trim(pool);
+    }
+}
+
+static void free_command(_command_t *command)
+{
+    esp_matter_mem_pool_free(&s_command_pool, command);
+}
+
+static void free_event(_event_t *event)
+{
+    esp_matter_mem_pool_free(&s_event_pool, event);
+}
+
+/* Drop the frozen tables of a cluster, this is done before any change to its attribute or command lists. */
+static void thaw_cluster(_cluster_t *cluster)
+{
+    cluster->freeze_failed = false;
+    if (cluster->frozen) {
+        esp_matter_mem_free(cluster->frozen);
+        cluster->frozen = nullptr;
+    }
+}
+
+static void free_cluster(_cluster_t *cluster)
+{
+    thaw_cluster(cluster);
+    esp_matter_mem_pool_free(&s_cluster_pool, cluster);
+}
+
+static esp_err_t freeze_cluster(_cluster_t *cluster)
+{
+    thaw_cluster(cluster);
+    size_t attribute_count = SinglyLinkedList<_attribute_base_t>::count(cluster->attribute_list);
+    size_t command_count = SinglyLinkedList<_command_t>::count(cluster->command_list);
+    if (attribute_count > UINT16_MAX || command_count > UINT16_MAX) {
+        cluster->freeze_failed = true;
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    /* Pointers first, then the ids and the flags to keep every array aligned */
+    size_t size = sizeof(_frozen_cluster_t) + attribute_count * (sizeof(_attribute_base_t *) + sizeof(uint32_t)) +
+                  command_count * (sizeof(_command_t *) + sizeof(uint32_t) + sizeof(uint16_t));
+    uint8_t *block = (uint8_t *)esp_matter_mem_calloc(1, size);
+    if (!block) {
+        ESP_LOGE(TAG, "Couldn't allocate the frozen tables");
+        cluster->freeze_failed = true;
+        return ESP_ERR_NO_MEM;
+    }
+    _frozen_cluster_t *frozen = (_frozen_cluster_t *)block;
+    block += sizeof(_frozen_cluster_t);
+    frozen->attributes = (_attribute_base_t **)block;
+    block += attribute_count * sizeof(_attribute_base_t *);
+    frozen->commands = (_command_t **)block;
+    block += command_count * sizeof(_command_t *);
+    frozen->attribute_ids = (uint32_t *)block;
+    block += attribute_count * sizeof(uint32_t);
+    frozen->command_ids = (uint32_t *)block;
+    block += command_count * sizeof(uint32_t);
+    frozen->command_flags = (uint16_t *)block;
+    frozen->attribute_count = attribute_count;
+    frozen->command_count = command_count;
+
+    size_t index = 0;
+    for (_attribute_base_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+        frozen->attributes[index++] = attribute;
+    }
+    std::sort(frozen->attributes, frozen->attributes + attribute_count,
+              [](const _attribute_base_t *a, const _attribute_base_t *b) {
+                  return a->attribute_id < b->attribute_id;
+              });
+    for (index = 0; index < attribute_count; ++index) {
+        frozen->attribute_ids[index] = frozen->attributes[index]->attribute_id;
+    }
+
+    index = 0;
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        frozen->commands[index++] = command;
+    }
+    /* A command id may be used by both an accepted and a generated command, keep them in list order */
+    std::stable_sort(frozen->commands, frozen->commands + command_count,
+                     [](const _command_t *a, const _command_t *b) {
+                         return a->command_id < b->command_id;
+                     });
+    for (index = 0; index < command_count; ++index) {
+        frozen->command_ids[index] = frozen->commands[index]->command_id;
+        frozen->command_flags[index] = frozen->commands[index]->flags;
+        if (frozen->commands[index]->flags & COMMAND_FLAG_ACCEPTED) {
+            frozen->accepted_command_count++;
+        }
+        if (frozen->commands[index]->flags & COMMAND_FLAG_GENERATED) {
+            frozen->generated_command_count++;
+        }
+    }
+    cluster->frozen = frozen;
+    return ESP_OK;
+}
+
+static _attribute_base_t *find_frozen_attribute(const _frozen_cluster_t *frozen, uint32_t attribute_id)
+{
+    const uint32_t *begin = frozen->attribute_ids;
+    const uint32_t *end = begin + frozen->attribute_count;
+    const uint32_t *it = std::lower_bound(begin, end, attribute_id);
+    if (it == end || *it != attribute_id) {
+        return nullptr;
+    }
+    return frozen->attributes[it - begin];
+}
+
+/* Find a command with the id and any of the flags, or with the id only if flags is COMMAND_FLAG_NONE */
+static _command_t *find_frozen_command(const _frozen_cluster_t *frozen, uint32_t command_id, uint16_t flags)
+{
+    const uint32_t *begin = frozen->command_ids;
+    const uint32_t *end = begin + frozen->command_count;
+    for (const uint32_t *it = std::lower_bound(begin, end, command_id); it != end && *it == command_id; ++it) {
+        size_t index = it - begin;
+        if (flags == COMMAND_FLAG_NONE || (frozen->command_flags[index] & flags)) {
+            return frozen->commands[index];
+        }
+    }
+    return nullptr;
+}
+
 namespace {
 // Treat 0xFFFF'FFFF as wildcard cluster
 inline bool is_wildcard_cluster_id(uint32_t cluster_id)
@@ -153,6 +325,9 @@ inline bool is_wildcard_endpoint_id(uint16_t endpoint_id)
 const uint32_t k_max_tlv_size_to_read_attribute_value = 512;
 const uint32_t k_max_tlv_size_to_write_attribute_value = 512;
 
+// Changes whenever an endpoint or a cluster is added to or removed from the node, see endpoint::get_list_generation()
+uint32_t s_endpoint_list_generation = 0;
+
 } // namespace
 
 namespace node {
@@ -500,7 +675,7 @@ attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, e
 
     if (flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
         /* Create */
-        attribute = (_attribute_t *)esp_matter_mem_calloc(1, sizeof(_attribute_base_t));
+        attribute = (_attribute_t *)esp_matter_mem_pool_calloc(&s_internal_attribute_pool);
         if (!attribute) {
             return nullptr;
         }
@@ -509,8 +684,10 @@ attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, e
         attribute->flags = flags;
         attribute->attribute_val_type = val.type;
         attribute->attribute_id = attribute_id;
+        attribute->cluster_id = current_cluster->cluster_id;
+        attribute->endpoint_id = current_cluster->endpoint_id;
     } else {
-        attribute = (_attribute_t *)esp_matter_mem_calloc(1, sizeof(_attribute_t));
+        attribute = (_attribute_t *)esp_matter_mem_pool_calloc(&s_attribute_pool);
         if (!attribute) {
             return nullptr;
         }
@@ -551,7 +728,9 @@ attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, e
     }
 
     /* Add */
+    thaw_cluster(current_cluster);
     SinglyLinkedList<_attribute_base_t>::append(&current_cluster->attribute_list, attribute);
+    data_model::path_index::add(current_cluster->endpoint_id, current_cluster->cluster_id, attribute_id, attribute);
     return (attribute_t *)attribute;
 }
 
@@ -562,7 +741,7 @@ static esp_err_t free_attribute(attribute_t *attribute)
 
     if (current_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
         // For attribute managed internally, free as the _attribute_base_t pointer.
-        esp_matter_mem_free((_attribute_base_t *)attribute);
+        esp_matter_mem_pool_free(&s_internal_attribute_pool, (_attribute_base_t *)attribute);
         return ESP_OK;
     }
 
@@ -587,7 +766,7 @@ static esp_err_t free_attribute(attribute_t *attribute)
     }
 
     /* Free */
-    esp_matter_mem_free(current_attribute);
+    esp_matter_mem_pool_free(&s_attribute_pool, current_attribute);
     return ESP_OK;
 }
 
@@ -603,7 +782,11 @@ esp_err_t destroy(cluster_t *cluster, attribute_t *attribute)
     }
 
     VerifyOrReturnError(*current_attribute, ESP_ERR_NOT_FOUND, ESP_LOGE(TAG, "Attribute not found in the cluster"));
+    thaw_cluster(current_cluster);
     *current_attribute = target_attribute->next;
+    data_model::path_index::remove(current_cluster->endpoint_id, current_cluster->cluster_id,
+                                   target_attribute->attribute_id);
+    invalidate_read_cache(current_cluster->endpoint_id, current_cluster->cluster_id, target_attribute->attribute_id);
     return free_attribute(attribute);
 }
 
@@ -611,6 +794,14 @@ attribute_t *get(cluster_t *cluster, uint32_t attribute_id)
 {
     VerifyOrReturnValue(cluster, NULL, ESP_LOGE(TAG, "Cluster cannot be NULL."));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
+    void *indexed_attribute = nullptr;
+    if (data_model::path_index::find(current_cluster->endpoint_id, current_cluster->cluster_id, attribute_id,
+                                     &indexed_attribute)) {
+        return (attribute_t *)indexed_attribute;
+    }
+    if (current_cluster->frozen) {
+        return (attribute_t *)find_frozen_attribute(current_cluster->frozen, attribute_id);
+    }
     _attribute_base_t *current_attribute = current_cluster->attribute_list;
     while (current_attribute) {
         if (current_attribute->attribute_id == attribute_id) {
@@ -850,37 +1041,221 @@ static esp_err_t get_val_from_tlv_data(const uint8_t *tlv_data, uint32_t tlv_len
     return ESP_OK;
 }
 
-// Helper function to find the cluster_id and attribute_id for internally managed attributes
-static esp_err_t find_cluster_and_endpoint_id_for_internally_managed_attribute(const _attribute_base_t *attribute_base,
-                                                                               uint16_t &out_endpoint_id,
-                                                                               uint32_t &out_cluster_id)
+// An attribute is served from the esp-matter storage when it is not managed internally and neither a
+// ServerClusterInterface nor an AttributeAccessInterface is registered for its cluster. This mirrors the order of
+// the checks in provider::ReadAttribute().
+static bool is_served_from_esp_matter_storage(uint16_t endpoint_id, uint32_t cluster_id, const _attribute_t *attribute)
 {
-    VerifyOrReturnError(attribute_base, ESP_ERR_INVALID_ARG);
-    _node_t *node = (_node_t *)node::get();
-    VerifyOrReturnError(node, ESP_ERR_INVALID_STATE);
+    if (attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
+        return false;
+    }
+    if (data_model::provider::get_instance().registry().Get(chip::app::ConcreteClusterPath(endpoint_id, cluster_id))) {
+        return false;
+    }
+    return chip::app::AttributeAccessInterfaceRegistry::Instance().Get(endpoint_id, cluster_id) == nullptr;
+}
 
-    // This is a linear search and it's not efficient, but we don't have a better way to do it right now.
-    for (_endpoint_t *endpoint = node->endpoint_list; endpoint != nullptr; endpoint = endpoint->next) {
-        for (_cluster_t *cluster = endpoint->cluster_list; cluster != nullptr; cluster = cluster->next) {
-            for (_attribute_base_t *attr = cluster->attribute_list; attr != nullptr; attr = attr->next) {
-                if (attr == attribute_base) {
-                    out_endpoint_id = endpoint->endpoint_id;
-                    out_cluster_id = cluster::get_id((cluster_t *)cluster);
-                    return ESP_OK;
-                }
-            }
+// Copy the value from the esp-matter storage, the result is the same as the one decoded from the TLV encoded by
+// provider::ReadAttribute(), including the ownership of the string buffers which is passed on to the caller.
+static esp_err_t copy_val_from_esp_matter_storage(const _attribute_t *attribute, esp_matter_attr_val_t *val)
+{
+    val->type = attribute->attribute_val_type;
+    val->val = attribute->attribute_val;
+
+    bool is_type_string = (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING
+                           || val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING);
+    bool is_type_octet_string = (val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING
+                                 || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING);
+    if (!is_type_string && !is_type_octet_string) {
+        return ESP_OK;
+    }
+
+    bool is_long = (val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING
+                    || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING);
+    uint16_t null_len = is_long ? UINT16_MAX : UINT8_MAX;
+    const uint8_t *stored_buf = attribute->attribute_val.a.b;
+    if (stored_buf == nullptr && attribute->attribute_val.a.s == null_len) {
+        val->val.a.s = null_len;
+        val->val.a.t = null_len;
+        return ESP_OK;
+    }
+
+    uint16_t len = stored_buf ? attribute->attribute_val.a.s : 0;
+    val->val.a.b = nullptr;
+    val->val.a.s = len;
+    val->val.a.t = len + (is_long ? 2 : 1);
+    // for strings, we need to copy at least null terminator
+    uint32_t bytes_to_copy = (is_type_string ? len + 1 : len);
+    if (bytes_to_copy > 0) {
+        uint8_t *new_buf = (uint8_t *)esp_matter_mem_calloc(sizeof(uint8_t), bytes_to_copy);
+        VerifyOrReturnError(new_buf != nullptr, ESP_ERR_NO_MEM);
+        if (len > 0) {
+            memcpy(new_buf, stored_buf, len);
+        }
+        val->val.a.b = new_buf; // new buffer is now owned by the caller
+    }
+    return ESP_OK;
+}
+
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+namespace {
+
+// Last TLV encoded by provider::ReadAttribute() for the attributes managed by connectedhomeip. An entry is valid while
+// the data version of its cluster is the one sampled before the read and until the path is reported as changed.
+struct read_cache_entry_t {
+    uint16_t endpoint_id;
+    uint16_t tlv_len;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    chip::DataVersion data_version;
+    uint32_t last_used;
+    uint8_t *tlv; /* NULL marks an empty entry */
+};
+
+constexpr size_t k_read_cache_size = CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE_SIZE;
+
+read_cache_entry_t s_read_cache[k_read_cache_size];
+uint32_t s_read_cache_use_count = 0;
+uint32_t s_read_cache_hits = 0;
+uint32_t s_read_cache_misses = 0;
+
+SemaphoreHandle_t get_read_cache_lock()
+{
+    static StaticSemaphore_t s_read_cache_lock_buffer;
+    static SemaphoreHandle_t s_read_cache_lock = xSemaphoreCreateMutexStatic(&s_read_cache_lock_buffer);
+    return s_read_cache_lock;
+}
+
+class scoped_read_cache_lock {
+public:
+    scoped_read_cache_lock()
+    {
+        xSemaphoreTake(get_read_cache_lock(), portMAX_DELAY);
+    }
+    ~scoped_read_cache_lock()
+    {
+        xSemaphoreGive(get_read_cache_lock());
+    }
+};
+
+// The code-driven clusters keep their own data version, the other clusters use the one of the esp-matter cluster
+bool get_current_data_version(uint16_t endpoint_id, uint32_t cluster_id, chip::DataVersion &data_version)
+{
+    chip::app::ConcreteClusterPath path(endpoint_id, cluster_id);
+    chip::app::ServerClusterInterface *server_cluster = data_model::provider::get_instance().registry().Get(path);
+    if (server_cluster) {
+        data_version = server_cluster->GetDataVersion(path);
+        return true;
+    }
+    cluster_t *cluster = cluster::get(endpoint_id, cluster_id);
+    return cluster && cluster::get_data_version(cluster, data_version) == ESP_OK;
+}
+
+void release_read_cache_entry(read_cache_entry_t &entry)
+{
+    esp_matter_mem_free(entry.tlv);
+    entry.tlv = nullptr;
+}
+
+esp_err_t get_val_from_read_cache(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                  chip::DataVersion data_version, esp_matter_attr_val_t *val)
+{
+    scoped_read_cache_lock lock;
+    for (read_cache_entry_t &entry : s_read_cache) {
+        if (!entry.tlv || entry.endpoint_id != endpoint_id || entry.cluster_id != cluster_id ||
+                entry.attribute_id != attribute_id) {
+            continue;
+        }
+        if (entry.data_version != data_version) {
+            release_read_cache_entry(entry);
+            break;
         }
+        entry.last_used = ++s_read_cache_use_count;
+        s_read_cache_hits++;
+        return get_val_from_tlv_data(entry.tlv, entry.tlv_len, val);
     }
+    s_read_cache_misses++;
     return ESP_ERR_NOT_FOUND;
 }
 
+void store_val_in_read_cache(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                             chip::DataVersion data_version, const uint8_t *tlv, uint32_t tlv_len)
+{
+    VerifyOrReturn(tlv_len <= UINT16_MAX);
+    uint8_t *copy = (uint8_t *)esp_matter_mem_calloc(1, tlv_len);
+    VerifyOrReturn(copy);
+    memcpy(copy, tlv, tlv_len);
+
+    scoped_read_cache_lock lock;
+    read_cache_entry_t *victim = &s_read_cache[0];
+    for (read_cache_entry_t &entry : s_read_cache) {
+        if (entry.tlv && entry.endpoint_id == endpoint_id && entry.cluster_id == cluster_id &&
+                entry.attribute_id == attribute_id) {
+            victim = &entry;
+            break;
+        }
+        if (!entry.tlv || (victim->tlv && entry.last_used < victim->last_used)) {
+            victim = &entry;
+        }
+    }
+    release_read_cache_entry(*victim);
+    victim->endpoint_id = endpoint_id;
+    victim->cluster_id = cluster_id;
+    victim->attribute_id = attribute_id;
+    victim->data_version = data_version;
+    victim->last_used = ++s_read_cache_use_count;
+    victim->tlv_len = (uint16_t)tlv_len;
+    victim->tlv = copy;
+}
+
+} // namespace
+
+void get_read_cache_stats(uint32_t &hits, uint32_t &misses)
+{
+    scoped_read_cache_lock lock;
+    hits = s_read_cache_hits;
+    misses = s_read_cache_misses;
+}
+#endif // CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+
+void invalidate_read_cache(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+    scoped_read_cache_lock lock;
+    for (read_cache_entry_t &entry : s_read_cache) {
+        if (entry.tlv && (is_wildcard_endpoint_id(endpoint_id) || entry.endpoint_id == endpoint_id) &&
+                (is_wildcard_cluster_id(cluster_id) || entry.cluster_id == cluster_id) &&
+                (attribute_id == chip::kInvalidAttributeId || entry.attribute_id == attribute_id)) {
+            release_read_cache_entry(entry);
+        }
+    }
+#endif // CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+}
+
 esp_err_t get_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
 {
     VerifyOrReturnError(val, ESP_ERR_INVALID_ARG);
-    esp_matter_val_type_t val_type = get_val_type(endpoint_id, cluster_id, attribute_id);
+    attribute_t *attribute = get(endpoint_id, cluster_id, attribute_id);
+    esp_matter_val_type_t val_type = get_val_type(attribute);
     VerifyOrReturnError(val_type != ESP_MATTER_VAL_TYPE_INVALID, ESP_ERR_INVALID_ARG);
     VerifyOrReturnError(val_type != ESP_MATTER_VAL_TYPE_ARRAY, ESP_ERR_NOT_SUPPORTED);
 
+    // Fast path: esp-matter managed attributes are copied directly without the TLV round trip.
+    if (is_served_from_esp_matter_storage(endpoint_id, cluster_id, (const _attribute_t *)attribute)) {
+        return copy_val_from_esp_matter_storage((const _attribute_t *)attribute, val);
+    }
+
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+    // Sampled before the read so that a change racing with the read leaves a stale data version in the cache
+    chip::DataVersion data_version = 0;
+    bool cacheable = get_current_data_version(endpoint_id, cluster_id, data_version);
+    if (cacheable) {
+        val->type = val_type;
+        esp_err_t err = get_val_from_read_cache(endpoint_id, cluster_id, attribute_id, data_version, val);
+        VerifyOrReturnError(err == ESP_ERR_NOT_FOUND, err);
+    }
+#endif // CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+
     chip::Platform::ScopedMemoryBuffer<uint8_t> scoped_buf;
     scoped_buf.Calloc(k_max_tlv_size_to_read_attribute_value);
     if (scoped_buf.IsNull()) {
@@ -913,20 +1288,22 @@ esp_err_t get_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_
 
     ESP_LOG_BUFFER_HEX_LEVEL("TLV data", scoped_buf.Get(), writer.GetLengthWritten(), ESP_LOG_DEBUG);
 
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+    if (cacheable) {
+        store_val_in_read_cache(endpoint_id, cluster_id, attribute_id, data_version, scoped_buf.Get(),
+                                writer.GetLengthWritten());
+    }
+#endif // CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+
     val->type = val_type;
     return get_val_from_tlv_data(scoped_buf.Get(), writer.GetLengthWritten(), val);
 }
 
-static esp_err_t get_path_from_attribute_handle(const _attribute_t *attribute, uint16_t &endpoint_id,
+static esp_err_t get_path_from_attribute_handle(const _attribute_base_t *attribute, uint16_t &endpoint_id,
                                                 uint32_t &cluster_id, uint32_t &attribute_id)
 {
+    // Both the esp-matter and the connectedhomeip managed attributes carry the path of their cluster
     attribute_id = attribute->attribute_id;
-    if (attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
-        // for connectedhomeip managed attributes, we need to find the cluster and endpoint id
-        return find_cluster_and_endpoint_id_for_internally_managed_attribute(attribute, endpoint_id, cluster_id);
-    }
-
-    // in case of esp-matter managed attributes, we can directly use the endpoint and cluster id
     endpoint_id = attribute->endpoint_id;
     cluster_id = attribute->cluster_id;
     return ESP_OK;
@@ -1199,7 +1576,7 @@ command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callba
     }
 
     /* Allocate */
-    _command_t *command = (_command_t *)esp_matter_mem_calloc(1, sizeof(_command_t));
+    _command_t *command = (_command_t *)esp_matter_mem_pool_calloc(&s_command_pool);
     VerifyOrReturnValue(command, NULL, ESP_LOGE(TAG, "Couldn't allocate _command_t"));
 
     /* Set */
@@ -1209,6 +1586,7 @@ command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callba
     command->user_callback = NULL;
 
     /* Add */
+    thaw_cluster(current_cluster);
     SinglyLinkedList<_command_t>::append(&current_cluster->command_list, command);
     return (command_t *)command;
 }
@@ -1218,7 +1596,8 @@ esp_err_t destroy(cluster_t *cluster, command_t *command)
     VerifyOrReturnError(cluster && command, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster or command cannot be NULL"));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
     _command_t *current_command = (_command_t *)command;
-    SinglyLinkedList<_command_t>::remove(&current_cluster->command_list, current_command);
+    thaw_cluster(current_cluster);
+    SinglyLinkedList<_command_t>::remove(&current_cluster->command_list, current_command, free_command);
     return ESP_OK;
 }
 
@@ -1226,6 +1605,9 @@ command_t *get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id)
 {
     _cluster_t *current_cluster = (_cluster_t *)cluster::get(endpoint_id, cluster_id);
     VerifyOrReturnValue(current_cluster, NULL);
+    if (current_cluster->frozen) {
+        return (command_t *)find_frozen_command(current_cluster->frozen, command_id, COMMAND_FLAG_NONE);
+    }
     _command_t *command = (_command_t *)current_cluster->command_list;
 
     while (command) {
@@ -1241,6 +1623,9 @@ command_t *get(cluster_t *cluster, uint32_t command_id, uint16_t flags)
 {
     VerifyOrReturnValue(cluster, NULL, ESP_LOGE(TAG, "Cluster cannot be NULL."));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
+    if (current_cluster->frozen) {
+        return (command_t *)find_frozen_command(current_cluster->frozen, command_id, flags);
+    }
     _command_t *current_command = (_command_t *)current_cluster->command_list;
     while (current_command) {
         if ((current_command->command_id == command_id) && (current_command->flags & flags)) {
@@ -1320,7 +1705,7 @@ event_t *create(cluster_t *cluster, uint32_t event_id)
     }
 
     /* Allocate */
-    _event_t *event = (_event_t *)esp_matter_mem_calloc(1, sizeof(_event_t));
+    _event_t *event = (_event_t *)esp_matter_mem_pool_calloc(&s_event_pool);
     VerifyOrReturnValue(event, NULL, ESP_LOGE(TAG, "Couldn't allocate _event_t"));
 
     /* Set */
@@ -1336,7 +1721,7 @@ esp_err_t destroy(cluster_t *cluster, event_t *event)
     VerifyOrReturnError(cluster && event, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster or event cannot be NULL"));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
     _event_t *current_event = (_event_t *)event;
-    SinglyLinkedList<_event_t>::remove(&current_cluster->event_list, current_event);
+    SinglyLinkedList<_event_t>::remove(&current_cluster->event_list, current_event, free_event);
     return ESP_OK;
 }
 
@@ -1394,7 +1779,7 @@ cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags)
     }
 
     /* Allocate */
-    _cluster_t *cluster = (_cluster_t *)esp_matter_mem_calloc(1, sizeof(_cluster_t));
+    _cluster_t *cluster = (_cluster_t *)esp_matter_mem_pool_calloc(&s_cluster_pool);
     if (!cluster) {
         ESP_LOGE(TAG, "Couldn't allocate _cluster_t");
         return NULL;
@@ -1415,6 +1800,8 @@ cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags)
 
     /* Add */
     SinglyLinkedList<_cluster_t>::append(&current_endpoint->cluster_list, cluster);
+    data_model::path_index::add(cluster->endpoint_id, cluster_id, kInvalidAttributeId, cluster);
+    s_endpoint_list_generation++;
     return (cluster_t *)cluster;
 }
 
@@ -1424,25 +1811,31 @@ esp_err_t destroy(cluster_t *cluster)
     _cluster_t *current_cluster = (_cluster_t *)cluster;
 
     /* Parse and delete all commands */
-    SinglyLinkedList<_command_t>::delete_list(&current_cluster->command_list);
+    SinglyLinkedList<_command_t>::delete_list(&current_cluster->command_list, free_command);
 
     /* Parse and delete all attributes */
+    attribute::invalidate_read_cache(current_cluster->endpoint_id, current_cluster->cluster_id,
+                                     chip::kInvalidAttributeId);
     _attribute_base_t *attribute = current_cluster->attribute_list;
     while (attribute) {
         _attribute_base_t *next_attribute = attribute->next;
+        data_model::path_index::remove(current_cluster->endpoint_id, current_cluster->cluster_id,
+                                       attribute->attribute_id);
         attribute::free_attribute((attribute_t *)attribute);
         attribute = next_attribute;
     }
 
     /* Parse and delete all events */
-    SinglyLinkedList<_event_t>::delete_list(&current_cluster->event_list);
+    SinglyLinkedList<_event_t>::delete_list(&current_cluster->event_list, free_event);
 
     /* Remove from parent endpoint's cluster list and free */
+    data_model::path_index::remove(current_cluster->endpoint_id, current_cluster->cluster_id, kInvalidAttributeId);
+    s_endpoint_list_generation++;
     _endpoint_t *parent_endpoint = (_endpoint_t *)endpoint::get(current_cluster->endpoint_id);
     if (parent_endpoint) {
-        SinglyLinkedList<_cluster_t>::remove(&parent_endpoint->cluster_list, current_cluster);
+        SinglyLinkedList<_cluster_t>::remove(&parent_endpoint->cluster_list, current_cluster, free_cluster);
     } else {
-        esp_matter_mem_free(current_cluster);
+        free_cluster(current_cluster);
     }
     return ESP_OK;
 }
@@ -1451,6 +1844,11 @@ cluster_t *get(endpoint_t *endpoint, uint32_t cluster_id)
 {
     VerifyOrReturnValue(endpoint, NULL, ESP_LOGE(TAG, "Endpoint cannot be NULL"));
     _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    void *indexed_cluster = nullptr;
+    if (data_model::path_index::find(current_endpoint->endpoint_id, cluster_id, kInvalidAttributeId,
+                                     &indexed_cluster)) {
+        return (cluster_t *)indexed_cluster;
+    }
     _cluster_t *current_cluster = (_cluster_t *)current_endpoint->cluster_list;
 
     while (current_cluster) {
@@ -1496,6 +1894,66 @@ uint8_t get_flags(cluster_t *cluster)
     return current_cluster->flags;
 }
 
+size_t get_attribute_count(cluster_t *cluster)
+{
+    VerifyOrReturnValue(cluster, 0, ESP_LOGE(TAG, "Cluster cannot be NULL"));
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    if (current_cluster->frozen) {
+        return current_cluster->frozen->attribute_count;
+    }
+    return SinglyLinkedList<_attribute_base_t>::count(current_cluster->attribute_list);
+}
+
+size_t get_command_count(cluster_t *cluster, uint16_t flags)
+{
+    VerifyOrReturnValue(cluster, 0, ESP_LOGE(TAG, "Cluster cannot be NULL"));
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    if (current_cluster->frozen && flags == COMMAND_FLAG_ACCEPTED) {
+        return current_cluster->frozen->accepted_command_count;
+    }
+    if (current_cluster->frozen && flags == COMMAND_FLAG_GENERATED) {
+        return current_cluster->frozen->generated_command_count;
+    }
+    return SinglyLinkedList<_command_t>::count_with_flag(current_cluster->command_list, flags);
+}
+
+bool is_frozen(cluster_t *cluster)
+{
+    VerifyOrReturnValue(cluster, false, ESP_LOGE(TAG, "Cluster cannot be NULL"));
+    return ((_cluster_t *)cluster)->frozen != nullptr;
+}
+
+esp_err_t get_frozen_tables(cluster_t *cluster, frozen_tables_t &tables)
+{
+    VerifyOrReturnError(cluster, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster cannot be NULL"));
+    const _frozen_cluster_t *frozen = ((_cluster_t *)cluster)->frozen;
+    VerifyOrReturnError(frozen, ESP_ERR_INVALID_STATE);
+    tables.attribute_count = frozen->attribute_count;
+    tables.attribute_ids = frozen->attribute_ids;
+    tables.attributes = (attribute_t *const *)frozen->attributes;
+    tables.command_count = frozen->command_count;
+    tables.command_ids = frozen->command_ids;
+    tables.command_flags = frozen->command_flags;
+    return ESP_OK;
+}
+
+esp_err_t freeze(cluster_t *cluster)
+{
+    VerifyOrReturnError(cluster, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster cannot be NULL"));
+    return freeze_cluster((_cluster_t *)cluster);
+}
+
+esp_err_t freeze_if_needed(cluster_t *cluster)
+{
+    VerifyOrReturnError(cluster, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster cannot be NULL"));
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    if (current_cluster->frozen) {
+        return ESP_OK;
+    }
+    VerifyOrReturnError(!current_cluster->freeze_failed, ESP_ERR_INVALID_STATE);
+    return freeze_cluster(current_cluster);
+}
+
 esp_err_t get_data_version(cluster_t *cluster, chip::DataVersion &data_version)
 {
     VerifyOrReturnValue(cluster, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster cannot be NULL"));
@@ -1661,7 +2119,7 @@ endpoint_t *create(node_t *node, uint8_t flags, void *priv_data)
                  CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT));
 
     /* Allocate */
-    _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_calloc(1, sizeof(_endpoint_t));
+    _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_pool_calloc(&s_endpoint_pool);
     VerifyOrReturnValue(endpoint, NULL, ESP_LOGE(TAG, "Couldn't allocate _endpoint_t"));
 
     /* Set */
@@ -1680,6 +2138,8 @@ endpoint_t *create(node_t *node, uint8_t flags, void *priv_data)
 
     /* Add */
     SinglyLinkedList<_endpoint_t>::append(&current_node->endpoint_list, endpoint);
+    data_model::path_index::add(endpoint->endpoint_id, kInvalidClusterId, kInvalidAttributeId, endpoint);
+    s_endpoint_list_generation++;
 
     return (endpoint_t *)endpoint;
 }
@@ -1703,7 +2163,7 @@ endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv
                         ESP_LOGE(TAG, "The endpoint_id of the resumed endpoint should have been used"));
 
     /* Allocate */
-    _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_calloc(1, sizeof(_endpoint_t));
+    _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_pool_calloc(&s_endpoint_pool);
     VerifyOrReturnValue(endpoint, NULL, ESP_LOGE(TAG, "Couldn't allocate _endpoint_t"));
 
     /* Set */
@@ -1719,6 +2179,8 @@ endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv
     } else {
         previous_endpoint->next = endpoint;
     }
+    data_model::path_index::add(endpoint_id, kInvalidClusterId, kInvalidAttributeId, endpoint);
+    s_endpoint_list_generation++;
 
     return (endpoint_t *)endpoint;
 }
@@ -1784,13 +2246,15 @@ esp_err_t destroy(node_t *node, endpoint_t *endpoint)
     } else {
         previous_endpoint->next = current_endpoint->next;
     }
+    data_model::path_index::remove(current_endpoint->endpoint_id, kInvalidClusterId, kInvalidAttributeId);
+    s_endpoint_list_generation++;
 
     /* Free */
     if (current_endpoint->identify != NULL) {
         chip::Platform::Delete(current_endpoint->identify);
         current_endpoint->identify = NULL;
     }
-    esp_matter_mem_free(current_endpoint);
+    esp_matter_mem_pool_free(&s_endpoint_pool, current_endpoint);
 
     return ESP_OK;
 }
@@ -1799,6 +2263,11 @@ endpoint_t *get(node_t *node, uint16_t endpoint_id)
 {
     VerifyOrReturnValue(node, NULL, ESP_LOGE(TAG, "Node cannot be NULL"));
     _node_t *current_node = (_node_t *)node;
+    void *indexed_endpoint = nullptr;
+    if (node == node::get() &&
+            data_model::path_index::find(endpoint_id, kInvalidClusterId, kInvalidAttributeId, &indexed_endpoint)) {
+        return (endpoint_t *)indexed_endpoint;
+    }
     _endpoint_t *current_endpoint = (_endpoint_t *)current_node->endpoint_list;
     while (current_endpoint) {
         if (current_endpoint->endpoint_id == endpoint_id) {
@@ -1841,6 +2310,11 @@ uint16_t get_count(node_t *node)
     return count;
 }
 
+uint32_t get_list_generation()
+{
+    return s_endpoint_list_generation;
+}
+
 uint16_t get_id(endpoint_t *endpoint)
 {
     VerifyOrReturnValue(endpoint, kInvalidEndpointId, ESP_LOGE(TAG, "Endpoint cannot be NULL"));
@@ -2054,6 +2528,40 @@ esp_err_t set_identify(uint16_t endpoint_id, void *identify)
 
 namespace node {
 
+size_t get_mem_stats(esp_matter_mem_pool_stats_t *stats, size_t max_count)
+{
+    VerifyOrReturnValue(stats, 0, ESP_LOGE(TAG, "stats cannot be NULL"));
+    const esp_matter_mem_pool_t *pools[] = {
+        &s_endpoint_pool, &s_cluster_pool, &s_attribute_pool, &s_internal_attribute_pool, &s_command_pool,
+        &s_event_pool,
+    };
+    size_t count = 0;
+    for (const esp_matter_mem_pool_t *pool : pools) {
+        if (count == max_count) {
+            break;
+        }
+        esp_matter_mem_pool_get_stats(pool, &stats[count++]);
+    }
+    return count;
+}
+
+esp_err_t freeze()
+{
+    VerifyOrReturnError(node, ESP_ERR_INVALID_STATE, ESP_LOGE(TAG, "Node has not been created"));
+    size_t cluster_count = 0;
+    for (_endpoint_t *endpoint = node->endpoint_list; endpoint; endpoint = endpoint->next) {
+        for (_cluster_t *cluster = endpoint->cluster_list; cluster; cluster = cluster->next) {
+            esp_err_t err = freeze_cluster(cluster);
+            VerifyOrReturnError(err == ESP_OK, err,
+                                ESP_LOGE(TAG, "Couldn't freeze cluster 0x%08" PRIX32 " on endpoint %u",
+                                         cluster->cluster_id, endpoint->endpoint_id));
+            cluster_count++;
+        }
+    }
+    ESP_LOGI(TAG, "Froze the attribute and command tables of %u clusters", (unsigned)cluster_count);
+    return ESP_OK;
+}
+
 node_t *create_raw()
 {
     VerifyOrReturnValue(!node, (node_t *)node, ESP_LOGE(TAG, "Node already exists"));
@@ -2068,6 +2576,9 @@ esp_err_t destroy_raw()
     _node_t *current_node = (_node_t *)node;
     esp_matter_mem_free(current_node);
     node = NULL;
+    data_model::path_index::clear();
+    s_endpoint_list_generation++;
+    trim_mem_pools();
     return ESP_OK;
 }
 
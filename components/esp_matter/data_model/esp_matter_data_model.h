@@ -15,6 +15,7 @@
 #pragma once
 #include <esp_err.h>
 #include <esp_matter_attribute_utils.h>
+#include <esp_matter_mem.h>
 #include <app/data-model-provider/Provider.h>
 #include "app/ConcreteCommandPath.h"
 #include "app/server-cluster/ServerClusterInterface.h"
@@ -171,6 +172,35 @@ uint32_t get_server_cluster_endpoint_count(uint32_t cluster_id);
  */
 uint32_t get_client_cluster_endpoint_count(uint32_t cluster_id);
 
+/** Get the memory usage of the data model
+ *
+ * Get the usage of the memory pools of the endpoints, clusters, attributes, internally managed attributes,
+ * commands and events. The usage is reported even if CONFIG_ESP_MATTER_MEM_POOL_ENABLE is disabled.
+ *
+ * @param[out] stats Array which receives the usage of each pool.
+ * @param[in] max_count Number of elements in the array.
+ *
+ * @return Number of elements written to the array.
+ */
+size_t get_mem_stats(esp_matter_mem_pool_stats_t *stats, size_t max_count);
+
+/** Freeze the attribute and command tables
+ *
+ * Copy the attributes and commands of every cluster of the node into contiguous arrays sorted by id. Lookups on a
+ * frozen cluster use a binary search and the enumeration of its attributes and commands does not walk the lists.
+ *
+ * Creating or destroying an attribute or a command of a frozen cluster thaws it, it goes back to the list walks until
+ * the node is frozen again. Clusters created after this call are not frozen, unless
+ * CONFIG_ESP_MATTER_COMMAND_DISPATCH_TABLE freezes them on their first command.
+ *
+ * @note: This is called by esp_matter::start() if CONFIG_ESP_MATTER_DATA_MODEL_FREEZE_ON_START is enabled. Hold the
+ * Matter stack lock if calling this after esp_matter::start().
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure, the clusters frozen before the failure stay frozen.
+ */
+esp_err_t freeze();
+
 } /* node */
 
 namespace endpoint {
@@ -654,6 +684,39 @@ uint32_t get_id(cluster_t *cluster);
  */
 uint8_t get_flags(cluster_t *cluster);
 
+/** Get attribute count
+ *
+ * Get the number of attributes in the cluster. This is constant time if the cluster is frozen.
+ *
+ * @param[in] cluster Cluster handle.
+ *
+ * @return Number of attributes on success.
+ * @return 0 in case of failure.
+ */
+size_t get_attribute_count(cluster_t *cluster);
+
+/** Get command count
+ *
+ * Get the number of commands in the cluster having any of the flags. This is constant time if the cluster is frozen
+ * and the flags are either COMMAND_FLAG_ACCEPTED or COMMAND_FLAG_GENERATED.
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[in] flags Bitmap of `command_flags_t`.
+ *
+ * @return Number of commands on success.
+ * @return 0 in case of failure.
+ */
+size_t get_command_count(cluster_t *cluster, uint16_t flags);
+
+/** Check if the cluster is frozen
+ *
+ * @param[in] cluster Cluster handle.
+ *
+ * @return true if the attribute and command tables of the cluster are frozen, see node::freeze().
+ * @return false otherwise.
+ */
+bool is_frozen(cluster_t *cluster);
+
 /** Get cluster data version
  *
  * Get the cluster data version for the cluster.
@@ -1102,6 +1165,34 @@ callback_t get_override_callback(attribute_t *attribute);
  */
 esp_err_t set_deferred_persistence(attribute_t *attribute);
 
+/** Flush the persistent attribute values
+ *
+ * If CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE is enabled, the changes of the non-volatile attributes are buffered and
+ * written to the NVS together every CONFIG_ESP_MATTER_NVS_WRITE_BACK_INTERVAL_MS and before restart. This API writes
+ * the buffered values immediately, for example before entering deep sleep or cutting the power.
+ *
+ * It does nothing if the write-back cache is disabled.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t flush_persistent_values();
+
+/** Invalidate the cached attribute reads
+ *
+ * If CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE is enabled, get_val() keeps the last values read from the
+ * attributes managed by connectedhomeip until the data version of their cluster changes or the change is reported.
+ * This API drops the cached values of attributes which change without being reported, like the UpTime of General
+ * Diagnostics, before they are read again.
+ *
+ * It does nothing if the read cache is disabled.
+ *
+ * @param[in] endpoint_id Endpoint ID, chip::kInvalidEndpointId matches all the endpoints.
+ * @param[in] cluster_id Cluster ID, chip::kInvalidClusterId matches all the clusters.
+ * @param[in] attribute_id Attribute ID, chip::kInvalidAttributeId matches all the attributes.
+ */
+void invalidate_read_cache(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
 } /* attribute */
 
 namespace command {
@@ -16,6 +16,7 @@
 #include <esp_matter.h>
 #include <esp_matter_command_impl.h>
 #include <esp_matter_core.h>
+#include <esp_matter_data_model_priv.h>
 
 #include <app-common/zap-generated/callback.h>
 #include <app/InteractionModelEngine.h>
@@ -36,10 +37,14 @@ void dispatch_single_cluster_command(const ConcreteCommandPath &command_path, TL
     uint16_t endpoint_id = command_path.mEndpointId;
     uint32_t cluster_id = command_path.mClusterId;
     uint32_t command_id = command_path.mCommandId;
-    ESP_LOGI(TAG, "Received command 0x%08" PRIX32 " for endpoint 0x%04" PRIX16 "'s cluster 0x%08" PRIX32 "", command_id, endpoint_id, cluster_id);
+    ESP_MATTER_TRACE_COMMAND_DISPATCH(command_path);
 
     cluster_t *cluster = cluster::get(endpoint_id, cluster_id);
     VerifyOrReturn(cluster);
+#ifdef CONFIG_ESP_MATTER_COMMAND_DISPATCH_TABLE
+    // The frozen command table of the cluster is its dispatch table, a failure leaves the lookup on the list walk
+    cluster::freeze_if_needed(cluster);
+#endif // CONFIG_ESP_MATTER_COMMAND_DISPATCH_TABLE
     command_t *command = get(cluster, command_id, COMMAND_FLAG_ACCEPTED);
     VerifyOrReturn(command, ESP_LOGE(TAG, "Command 0x%08" PRIX32 " not found", command_id));
     esp_err_t err = ESP_OK;
@@ -0,0 +1,197 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_matter_data_model_index.h>
+
+#ifdef CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX
+
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+
+namespace esp_matter {
+namespace data_model {
+namespace path_index {
+
+static const char *TAG = "dm_path_index";
+
+namespace {
+
+struct entry_t {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint16_t endpoint_id;
+    void *handle; /* NULL marks an empty slot */
+};
+
+// The capacity is always a power of two so that the probe can wrap with a mask.
+constexpr size_t k_initial_capacity = 64;
+
+entry_t *s_entries = nullptr;
+size_t s_capacity = 0;
+size_t s_count = 0;
+bool s_disabled = false;
+
+inline size_t hash_path(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    // 64-bit finalizer from MurmurHash3, the attribute and cluster ids are mostly small and clustered
+    uint64_t h = ((uint64_t)cluster_id << 32) | attribute_id;
+    h ^= (uint64_t)endpoint_id * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+inline bool entry_matches(const entry_t &entry, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    return entry.handle && entry.endpoint_id == endpoint_id && entry.cluster_id == cluster_id &&
+           entry.attribute_id == attribute_id;
+}
+
+// Returns the slot holding the path, or the empty slot where the path should be inserted.
+size_t probe(const entry_t *entries, size_t capacity, uint16_t endpoint_id, uint32_t cluster_id,
+             uint32_t attribute_id)
+{
+    size_t mask = capacity - 1;
+    size_t slot = hash_path(endpoint_id, cluster_id, attribute_id) & mask;
+    while (entries[slot].handle && !entry_matches(entries[slot], endpoint_id, cluster_id, attribute_id)) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void disable()
+{
+    ESP_LOGE(TAG, "Failed to grow the path index, falling back to list lookups");
+    esp_matter_mem_free(s_entries);
+    s_entries = nullptr;
+    s_capacity = 0;
+    s_count = 0;
+    s_disabled = true;
+}
+
+esp_err_t grow()
+{
+    size_t new_capacity = s_capacity ? s_capacity * 2 : k_initial_capacity;
+    entry_t *new_entries = (entry_t *)esp_matter_mem_calloc(new_capacity, sizeof(entry_t));
+    if (!new_entries) {
+        disable();
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < s_capacity; ++i) {
+        const entry_t &entry = s_entries[i];
+        if (entry.handle) {
+            new_entries[probe(new_entries, new_capacity, entry.endpoint_id, entry.cluster_id, entry.attribute_id)] =
+                entry;
+        }
+    }
+    esp_matter_mem_free(s_entries);
+    s_entries = new_entries;
+    s_capacity = new_capacity;
+    return ESP_OK;
+}
+
+} // namespace
+
+esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, void *handle)
+{
+    if (s_disabled || !handle) {
+        return s_disabled ? ESP_ERR_NO_MEM : ESP_ERR_INVALID_ARG;
+    }
+    // Keep the load factor under 3/4 to bound the probe length
+    if ((s_count + 1) * 4 > s_capacity * 3) {
+        esp_err_t err = grow();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    entry_t &entry = s_entries[probe(s_entries, s_capacity, endpoint_id, cluster_id, attribute_id)];
+    if (!entry.handle) {
+        entry.endpoint_id = endpoint_id;
+        entry.cluster_id = cluster_id;
+        entry.attribute_id = attribute_id;
+        s_count++;
+    }
+    entry.handle = handle;
+    return ESP_OK;
+}
+
+void remove(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    if (!s_entries) {
+        return;
+    }
+    size_t mask = s_capacity - 1;
+    size_t hole = probe(s_entries, s_capacity, endpoint_id, cluster_id, attribute_id);
+    if (!s_entries[hole].handle) {
+        return;
+    }
+    s_entries[hole].handle = nullptr;
+    s_count--;
+
+    // Backward-shift deletion: move the following entries of the probe sequence into the hole so that the
+    // lookups never need tombstones.
+    size_t slot = (hole + 1) & mask;
+    while (s_entries[slot].handle) {
+        const entry_t &entry = s_entries[slot];
+        size_t home = hash_path(entry.endpoint_id, entry.cluster_id, entry.attribute_id) & mask;
+        // Move the entry if its home slot is not in the cyclic range (hole, slot]
+        bool in_range = (hole <= slot) ? (hole < home && home <= slot) : (hole < home || home <= slot);
+        if (!in_range) {
+            s_entries[hole] = entry;
+            s_entries[slot].handle = nullptr;
+            hole = slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+bool find(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, void **handle)
+{
+    if (s_disabled) {
+        return false;
+    }
+    *handle = nullptr;
+    if (s_entries) {
+        *handle = s_entries[probe(s_entries, s_capacity, endpoint_id, cluster_id, attribute_id)].handle;
+    }
+    return true;
+}
+
+void clear()
+{
+    esp_matter_mem_free(s_entries);
+    s_entries = nullptr;
+    s_capacity = 0;
+    s_count = 0;
+    s_disabled = false;
+}
+
+size_t get_count()
+{
+    return s_count;
+}
+
+size_t get_capacity()
+{
+    return s_capacity;
+}
+
+} // namespace path_index
+} // namespace data_model
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX
@@ -0,0 +1,105 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <sdkconfig.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace data_model {
+
+/** Hashed path index for the esp-matter data model
+ *
+ * Maps an (endpoint_id, cluster_id, attribute_id) path to the handle of the corresponding data model node.
+ * Endpoints are stored with the cluster_id and attribute_id set to 0xFFFF'FFFF and clusters are stored with the
+ * attribute_id set to 0xFFFF'FFFF. The index is an open-addressing hash table with linear probing and it is kept
+ * in sync by the create/resume/destroy APIs of the data model.
+ *
+ * If the index fails to grow, it disables itself and the lookups fall back to the linked list walks until the
+ * node is destroyed.
+ */
+namespace path_index {
+
+#ifdef CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX
+
+/** Add or replace the handle for a path
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id, 0xFFFF'FFFF for an endpoint entry.
+ * @param[in] attribute_id Attribute id, 0xFFFF'FFFF for an endpoint or cluster entry.
+ * @param[in] handle Handle of the data model node, cannot be NULL.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM if the index could not grow, the index is disabled in this case.
+ */
+esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, void *handle);
+
+/** Remove the handle for a path
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[in] attribute_id Attribute id.
+ */
+void remove(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+/** Find the handle for a path
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[in] attribute_id Attribute id.
+ * @param[out] handle Handle of the data model node, NULL if the path is not in the index.
+ *
+ * @return true if the index is usable and `handle` is authoritative.
+ * @return false if the index is disabled and the caller should walk the data model lists.
+ */
+bool find(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, void **handle);
+
+/** Free the index and re-enable it if it was disabled */
+void clear();
+
+/** Get the number of paths in the index */
+size_t get_count();
+
+/** Get the number of slots allocated for the index */
+size_t get_capacity();
+
+#else
+
+inline esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, void *handle)
+{
+    return ESP_OK;
+}
+inline void remove(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {}
+inline bool find(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, void **handle)
+{
+    return false;
+}
+inline void clear() {}
+inline size_t get_count()
+{
+    return 0;
+}
+inline size_t get_capacity()
+{
+    return 0;
+}
+
+#endif // CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX
+
+} // namespace path_index
+} // namespace data_model
+} // namespace esp_matter
@@ -15,12 +15,31 @@
 #pragma once
 
 #include <esp_err.h>
+#include <esp_log.h>
+#include <inttypes.h>
+#include <sdkconfig.h>
 #include <esp_matter_attribute_utils.h>
 #include <app/util/attribute-storage.h>
 #include <app/ConcreteCommandPath.h>
 
 #include <esp_matter_data_model.h>
 
+/** Trace hook of the commands dispatched to the esp-matter clusters
+ *
+ * It logs the received commands if CONFIG_ESP_MATTER_LOG_RECEIVED_COMMANDS is enabled and does nothing otherwise. It
+ * can be replaced at compile time by defining ESP_MATTER_TRACE_COMMAND_DISPATCH(command_path) in the compile
+ * definitions of the esp_matter component, e.g. to record the commands into a trace buffer.
+ */
+#ifndef ESP_MATTER_TRACE_COMMAND_DISPATCH
+#ifdef CONFIG_ESP_MATTER_LOG_RECEIVED_COMMANDS
+#define ESP_MATTER_TRACE_COMMAND_DISPATCH(command_path)                                                               \
+    ESP_LOGI(TAG, "Received command 0x%08" PRIX32 " for endpoint 0x%04" PRIX16 "'s cluster 0x%08" PRIX32 "",         \
+             (command_path).mCommandId, (command_path).mEndpointId, (command_path).mClusterId)
+#else
+#define ESP_MATTER_TRACE_COMMAND_DISPATCH(command_path) ((void)0)
+#endif // CONFIG_ESP_MATTER_LOG_RECEIVED_COMMANDS
+#endif // ESP_MATTER_TRACE_COMMAND_DISPATCH
+
 namespace esp_matter {
 namespace command {
 void dispatch_single_cluster_command(const chip::app::ConcreteCommandPath &command_path, chip::TLV::TLVReader &tlv_data,
@@ -38,6 +57,16 @@ namespace endpoint {
 
 esp_err_t enable_all();
 
+/** Get the generation of the endpoint list
+ *
+ * The generation changes whenever an endpoint is added to or removed from the node, or a cluster is added to or
+ * removed from an endpoint. Lookup tables derived from the endpoint and cluster lists can be kept until the
+ * generation changes.
+ *
+ * @return The current generation.
+ */
+uint32_t get_list_generation();
+
 /** Invoke the init callbacks for the clusters on the endpoint
  *
  * @param[in] endpoint Endpoint handle.
@@ -45,6 +74,61 @@ esp_err_t enable_all();
 void invoke_init_callbacks_internal(endpoint_t *endpoint);
 }
 
+namespace cluster {
+
+/** Frozen tables of a cluster, see node::freeze()
+ *
+ * The attributes are sorted by id. The commands are sorted by id and the commands sharing an id stay in the order
+ * they were created in.
+ */
+typedef struct {
+    size_t attribute_count;
+    const uint32_t *attribute_ids;
+    attribute_t *const *attributes;
+    size_t command_count;
+    const uint32_t *command_ids;
+    const uint16_t *command_flags;
+} frozen_tables_t;
+
+/** Get the frozen tables of a cluster
+ *
+ * The tables are valid until an attribute or a command is created in or destroyed from the cluster.
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[out] tables Frozen tables.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if the cluster is not frozen.
+ */
+esp_err_t get_frozen_tables(cluster_t *cluster, frozen_tables_t &tables);
+
+/** Freeze the attribute and command tables of a cluster, see node::freeze()
+ *
+ * If CONFIG_ESP_MATTER_COMMAND_DISPATCH_TABLE is enabled, this is done with freeze_if_needed() on the first command
+ * dispatched to a cluster which is not frozen so that the commands are looked up with a binary search.
+ *
+ * @param[in] cluster Cluster handle.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure, the cluster is then not frozen.
+ */
+esp_err_t freeze(cluster_t *cluster);
+
+/** Freeze the attribute and command tables of a cluster unless they are frozen
+ *
+ * A failed freeze is not retried until the attribute or command lists of the cluster change, so that a cluster which
+ * cannot be frozen, e.g. on a low heap, is looked up with the list walk instead of an allocation on every call.
+ *
+ * @param[in] cluster Cluster handle.
+ *
+ * @return ESP_OK if the cluster is frozen.
+ * @return ESP_ERR_INVALID_STATE if the last freeze of the cluster failed.
+ * @return error in case of failure, the cluster is then not frozen.
+ */
+esp_err_t freeze_if_needed(cluster_t *cluster);
+
+} // namespace cluster
+
 namespace attribute {
 
 /** Get the attribute value from the esp-matter storage
@@ -100,6 +184,15 @@ esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, b
  */
 esp_err_t destroy(cluster_t *cluster, attribute_t *attribute);
 
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+/** Get the number of get_val() calls served from and missed by the read cache
+ *
+ * @param[out] hits Number of reads served from the cache.
+ * @param[out] misses Number of reads which went through the data model provider.
+ */
+void get_read_cache_stats(uint32_t &hits, uint32_t &misses);
+#endif // CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+
 } // namespace attribute
 
 namespace command {
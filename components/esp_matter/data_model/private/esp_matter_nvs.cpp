@@ -21,6 +21,25 @@
 #include <esp_matter_nvs.h>
 
 #include <lib/support/Base64.h>
+#include <lib/support/CodeUtils.h>
+
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+#include <esp_matter_core.h>
+#include <esp_system.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <platform/CHIPDeviceLayer.h>
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+#include <esp_matter_core.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
 
 #define ESP_MATTER_NVS_PART_NAME CONFIG_ESP_MATTER_NVS_PART_NAME
 
@@ -176,14 +195,9 @@ static esp_err_t nvs_get_val(const char *nvs_namespace, const char *attribute_ke
     return err;
 }
 
-static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_key, const esp_matter_attr_val_t  &val)
+static esp_err_t nvs_set_val(nvs_handle_t handle, const char *attribute_key, const esp_matter_attr_val_t &val)
 {
-    nvs_handle_t handle;
-    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE, &handle);
-    if (err != ESP_OK) {
-        return err;
-    }
-
+    esp_err_t err = ESP_OK;
     if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
             val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
             val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
@@ -195,7 +209,6 @@ static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_
         } else {
             err = nvs_erase_key(handle, attribute_key);
         }
-        nvs_commit(handle);
     } else {
         // This switch case handles primitive data types
         // always store values as primitive data type
@@ -259,6 +272,17 @@ static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_
         }
         }
     }
+    return err;
+}
+
+static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_key, const esp_matter_attr_val_t  &val)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = nvs_set_val(handle, attribute_key, val);
     nvs_commit(handle);
     nvs_close(handle);
     return err;
@@ -277,6 +301,656 @@ static esp_err_t nvs_erase_val(const char *nvs_namespace, const char *attribute_
     return err;
 }
 
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+// Write-back cache for the ESP_MATTER_KVS_NAMESPACE. The latest value of each changed attribute is kept in RAM and
+// all of them are written through a long-lived handle, followed by a single commit, when the flush timer expires,
+// when the table is full, before restart or on demand. An attribute changed many times within the interval is
+// written only once.
+namespace {
+
+struct cache_entry_t {
+    char attribute_key[16];
+    // Pending erase of the key, val is unused
+    bool erase;
+    // Owned copy of the value, the buffer of string and array values is allocated for the entry
+    esp_matter_attr_val_t val;
+};
+
+constexpr size_t k_cache_size = CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE_SIZE;
+constexpr uint32_t k_flush_interval_ms = CONFIG_ESP_MATTER_NVS_WRITE_BACK_INTERVAL_MS;
+
+cache_entry_t s_cache[k_cache_size];
+size_t s_cache_count = 0;
+nvs_handle_t s_kvs_handle;
+bool s_kvs_handle_opened = false;
+bool s_flush_scheduled = false;
+
+SemaphoreHandle_t get_cache_lock()
+{
+    static StaticSemaphore_t s_cache_lock_buffer;
+    static SemaphoreHandle_t s_cache_lock = xSemaphoreCreateMutexStatic(&s_cache_lock_buffer);
+    return s_cache_lock;
+}
+
+class scoped_cache_lock {
+public:
+    scoped_cache_lock()
+    {
+        xSemaphoreTake(get_cache_lock(), portMAX_DELAY);
+    }
+    ~scoped_cache_lock()
+    {
+        xSemaphoreGive(get_cache_lock());
+    }
+};
+
+bool is_buffer_type(esp_matter_val_type_t type)
+{
+    return type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+           type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+           type == ESP_MATTER_VAL_TYPE_ARRAY;
+}
+
+void release_entry(cache_entry_t &entry)
+{
+    if (!entry.erase && is_buffer_type(entry.val.type)) {
+        esp_matter_mem_free(entry.val.val.a.b);
+    }
+    entry.val.val.a.b = nullptr;
+}
+
+esp_err_t copy_val(esp_matter_attr_val_t &dst, const esp_matter_attr_val_t &src)
+{
+    dst = src;
+    if (is_buffer_type(src.type) && src.val.a.b) {
+        dst.val.a.b = (uint8_t *)esp_matter_mem_calloc(1, src.val.a.s ? src.val.a.s : 1);
+        VerifyOrReturnError(dst.val.a.b, ESP_ERR_NO_MEM);
+        memcpy(dst.val.a.b, src.val.a.b, src.val.a.s);
+    }
+    return ESP_OK;
+}
+
+void flush_on_shutdown();
+
+nvs_handle_t *get_kvs_handle()
+{
+    if (!s_kvs_handle_opened) {
+        if (nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE,
+                                    &s_kvs_handle) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to open the %s namespace", ESP_MATTER_KVS_NAMESPACE);
+            return nullptr;
+        }
+        s_kvs_handle_opened = true;
+        static bool s_shutdown_handler_registered = false;
+        if (!s_shutdown_handler_registered) {
+            s_shutdown_handler_registered = esp_register_shutdown_handler(flush_on_shutdown) == ESP_OK;
+        }
+    }
+    return &s_kvs_handle;
+}
+
+// Must be called with the cache lock held
+esp_err_t flush_locked()
+{
+    VerifyOrReturnError(s_cache_count > 0, ESP_OK);
+    nvs_handle_t *handle = get_kvs_handle();
+    esp_err_t ret = handle ? ESP_OK : ESP_FAIL;
+    for (size_t i = 0; i < s_cache_count; ++i) {
+        cache_entry_t &entry = s_cache[i];
+        if (handle) {
+            esp_err_t err = entry.erase ? nvs_erase_key(*handle, entry.attribute_key)
+                                        : nvs_set_val(*handle, entry.attribute_key, entry.val);
+            if (err != ESP_OK && !(entry.erase && err == ESP_ERR_NVS_NOT_FOUND)) {
+                ESP_LOGE(TAG, "Failed to write attribute key %s: %d", entry.attribute_key, err);
+                ret = ret == ESP_OK ? err : ret;
+            }
+        }
+        release_entry(entry);
+    }
+    if (handle) {
+        esp_err_t err = nvs_commit(*handle);
+        ret = ret == ESP_OK ? err : ret;
+    }
+    ESP_LOGD(TAG, "Flushed %u attribute values", (unsigned)s_cache_count);
+    s_cache_count = 0;
+    return ret;
+}
+
+void flush_on_shutdown()
+{
+    scoped_cache_lock lock;
+    flush_locked();
+}
+
+void flush_timer_callback(chip::System::Layer *layer, void *context)
+{
+    scoped_cache_lock lock;
+    s_flush_scheduled = false;
+    flush_locked();
+}
+
+void start_flush_timer(intptr_t context)
+{
+    chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_flush_interval_ms),
+                                                flush_timer_callback, nullptr);
+}
+
+// Must be called with the cache lock held
+void schedule_flush_locked()
+{
+    if (s_flush_scheduled) {
+        return;
+    }
+    // The timer must be started in the Matter context, the values might be changed from any task
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(start_flush_timer) == CHIP_NO_ERROR) {
+        s_flush_scheduled = true;
+    } else {
+        flush_locked();
+    }
+}
+
+cache_entry_t *find_entry(const char *attribute_key)
+{
+    for (size_t i = 0; i < s_cache_count; ++i) {
+        if (strcmp(s_cache[i].attribute_key, attribute_key) == 0) {
+            return &s_cache[i];
+        }
+    }
+    return nullptr;
+}
+
+// Must be called with the cache lock held, val is NULL for an erase
+esp_err_t cache_val_locked(const char *attribute_key, const esp_matter_attr_val_t *val)
+{
+    cache_entry_t *entry = find_entry(attribute_key);
+    if (entry) {
+        release_entry(*entry);
+    } else {
+        if (s_cache_count == k_cache_size) {
+            flush_locked();
+        }
+        entry = &s_cache[s_cache_count++];
+        strlcpy(entry->attribute_key, attribute_key, sizeof(entry->attribute_key));
+    }
+    entry->erase = (val == nullptr);
+    esp_err_t err = val ? copy_val(entry->val, *val) : ESP_OK;
+    if (err != ESP_OK) {
+        // Drop the entry, the previous value is still in NVS
+        *entry = s_cache[--s_cache_count];
+        return err;
+    }
+    schedule_flush_locked();
+    return ESP_OK;
+}
+
+// The write-back cache is used once esp_matter is started, the values written before (e.g. while restoring the
+// attributes) are stored directly.
+bool use_cache()
+{
+    return esp_matter::is_started();
+}
+
+} // namespace
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+// Values of the ESP_MATTER_KVS_NAMESPACE read with one walk of the partition before the data model is created. The
+// non-volatile attributes take their value from this table instead of opening the namespace and probing their key one
+// by one, and the attributes which were never stored do not probe the legacy endpoint_%X namespaces. The legacy
+// entries are moved to the ESP_MATTER_KVS_NAMESPACE by the same walk.
+namespace {
+
+struct preload_entry_t {
+    char attribute_key[16];
+    nvs_type_t type;
+    // The value was taken by an attribute or changed since the preload, it is read from the NVS again
+    bool stale;
+    // Integer value, in the low bytes
+    uint64_t raw;
+    // Value of NVS_TYPE_BLOB entries
+    uint8_t *blob;
+    size_t blob_len;
+};
+
+enum preload_state_t {
+    PRELOAD_NONE,
+    PRELOAD_LOADED,
+    // Released once esp_matter is started or if the preload failed, the values are read from the NVS
+    PRELOAD_RELEASED,
+};
+
+preload_entry_t *s_preload_entries = nullptr;
+size_t s_preload_count = 0;
+preload_state_t s_preload_state = PRELOAD_NONE;
+
+SemaphoreHandle_t get_preload_lock()
+{
+    static StaticSemaphore_t s_preload_lock_buffer;
+    static SemaphoreHandle_t s_preload_lock = xSemaphoreCreateMutexStatic(&s_preload_lock_buffer);
+    return s_preload_lock;
+}
+
+class scoped_preload_lock {
+public:
+    scoped_preload_lock()
+    {
+        xSemaphoreTake(get_preload_lock(), portMAX_DELAY);
+    }
+    ~scoped_preload_lock()
+    {
+        xSemaphoreGive(get_preload_lock());
+    }
+};
+
+bool is_blob_type(esp_matter_val_type_t type)
+{
+    return type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+           type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+           type == ESP_MATTER_VAL_TYPE_ARRAY || type == ESP_MATTER_VAL_TYPE_FLOAT;
+}
+
+// NVS type of the values written by nvs_set_val()
+nvs_type_t get_nvs_type(const esp_matter_attr_val_t &val)
+{
+    switch (val.get_storage_type()) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_UINT8:
+        return NVS_TYPE_U8;
+    case ESP_MATTER_VAL_TYPE_INT8:
+        return NVS_TYPE_I8;
+    case ESP_MATTER_VAL_TYPE_INT16:
+        return NVS_TYPE_I16;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+        return NVS_TYPE_U16;
+    case ESP_MATTER_VAL_TYPE_INT32:
+        return NVS_TYPE_I32;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+        return NVS_TYPE_U32;
+    case ESP_MATTER_VAL_TYPE_INT64:
+        return NVS_TYPE_I64;
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        return NVS_TYPE_U64;
+    default:
+        return is_blob_type(val.get_storage_type()) ? NVS_TYPE_BLOB : NVS_TYPE_ANY;
+    }
+}
+
+// Read an entry with its own type, the integers are kept in the low bytes of raw
+esp_err_t read_entry(nvs_handle_t handle, const char *key, nvs_type_t type, uint64_t &raw, uint8_t *&blob,
+                     size_t &blob_len)
+{
+    raw = 0;
+    blob = nullptr;
+    blob_len = 0;
+    switch (type) {
+    case NVS_TYPE_U8:
+        return nvs_get_u8(handle, key, reinterpret_cast<uint8_t *>(&raw));
+    case NVS_TYPE_I8:
+        return nvs_get_i8(handle, key, reinterpret_cast<int8_t *>(&raw));
+    case NVS_TYPE_U16:
+        return nvs_get_u16(handle, key, reinterpret_cast<uint16_t *>(&raw));
+    case NVS_TYPE_I16:
+        return nvs_get_i16(handle, key, reinterpret_cast<int16_t *>(&raw));
+    case NVS_TYPE_U32:
+        return nvs_get_u32(handle, key, reinterpret_cast<uint32_t *>(&raw));
+    case NVS_TYPE_I32:
+        return nvs_get_i32(handle, key, reinterpret_cast<int32_t *>(&raw));
+    case NVS_TYPE_U64:
+        return nvs_get_u64(handle, key, &raw);
+    case NVS_TYPE_I64:
+        return nvs_get_i64(handle, key, reinterpret_cast<int64_t *>(&raw));
+    case NVS_TYPE_BLOB: {
+        esp_err_t err = nvs_get_blob(handle, key, nullptr, &blob_len);
+        VerifyOrReturnError(err == ESP_OK, err);
+        blob = (uint8_t *)esp_matter_mem_calloc(1, blob_len ? blob_len : 1);
+        VerifyOrReturnError(blob, ESP_ERR_NO_MEM);
+        err = nvs_get_blob(handle, key, blob, &blob_len);
+        if (err != ESP_OK) {
+            esp_matter_mem_free(blob);
+            blob = nullptr;
+        }
+        return err;
+    }
+    default:
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+}
+
+esp_err_t write_entry(nvs_handle_t handle, const char *key, nvs_type_t type, uint64_t raw, const uint8_t *blob,
+                      size_t blob_len)
+{
+    switch (type) {
+    case NVS_TYPE_U8:
+        return nvs_set_u8(handle, key, static_cast<uint8_t>(raw));
+    case NVS_TYPE_I8:
+        return nvs_set_i8(handle, key, static_cast<int8_t>(raw));
+    case NVS_TYPE_U16:
+        return nvs_set_u16(handle, key, static_cast<uint16_t>(raw));
+    case NVS_TYPE_I16:
+        return nvs_set_i16(handle, key, static_cast<int16_t>(raw));
+    case NVS_TYPE_U32:
+        return nvs_set_u32(handle, key, static_cast<uint32_t>(raw));
+    case NVS_TYPE_I32:
+        return nvs_set_i32(handle, key, static_cast<int32_t>(raw));
+    case NVS_TYPE_U64:
+        return nvs_set_u64(handle, key, raw);
+    case NVS_TYPE_I64:
+        return nvs_set_i64(handle, key, static_cast<int64_t>(raw));
+    case NVS_TYPE_BLOB:
+        return nvs_set_blob(handle, key, blob, blob_len);
+    default:
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+}
+
+void release_preload_locked()
+{
+    for (size_t i = 0; i < s_preload_count; ++i) {
+        esp_matter_mem_free(s_preload_entries[i].blob);
+    }
+    esp_matter_mem_free(s_preload_entries);
+    s_preload_entries = nullptr;
+    s_preload_count = 0;
+    s_preload_state = PRELOAD_RELEASED;
+}
+
+preload_entry_t *find_preload_entry(const char *attribute_key)
+{
+    size_t low = 0, high = s_preload_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = strcmp(s_preload_entries[mid].attribute_key, attribute_key);
+        if (cmp == 0) {
+            return &s_preload_entries[mid];
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t append_preload_entry(const preload_entry_t &entry, size_t &capacity)
+{
+    if (s_preload_count == capacity) {
+        size_t new_capacity = capacity ? capacity * 2 : 32;
+        preload_entry_t *entries = (preload_entry_t *)esp_matter_mem_realloc(s_preload_entries,
+                                                                             new_capacity * sizeof(preload_entry_t));
+        VerifyOrReturnError(entries, ESP_ERR_NO_MEM);
+        s_preload_entries = entries;
+        capacity = new_capacity;
+    }
+    s_preload_entries[s_preload_count++] = entry;
+    return ESP_OK;
+}
+
+int compare_preload_entries(const void *a, const void *b)
+{
+    return strcmp(static_cast<const preload_entry_t *>(a)->attribute_key,
+                  static_cast<const preload_entry_t *>(b)->attribute_key);
+}
+
+// Legacy values are stored in the endpoint_%X namespaces with the cluster_id:attribute_id key
+bool parse_legacy_entry(const nvs_entry_info_t &info, char *attribute_key)
+{
+    unsigned endpoint_id;
+    uint32_t cluster_id, attribute_id;
+    char end;
+    if (sscanf(info.namespace_name, "endpoint_%X%c", &endpoint_id, &end) != 1 || endpoint_id > UINT16_MAX ||
+            sscanf(info.key, "%" SCNx32 ":%" SCNx32 "%c", &cluster_id, &attribute_id, &end) != 2) {
+        return false;
+    }
+    get_attribute_key(static_cast<uint16_t>(endpoint_id), cluster_id, attribute_id, attribute_key);
+    return true;
+}
+
+struct legacy_entry_t {
+    nvs_entry_info_t info;
+    char attribute_key[16];
+};
+
+int compare_legacy_entries(const void *a, const void *b)
+{
+    return strcmp(static_cast<const legacy_entry_t *>(a)->info.namespace_name,
+                  static_cast<const legacy_entry_t *>(b)->info.namespace_name);
+}
+
+int compare_key_to_preload_entry(const void *key, const void *entry)
+{
+    return strcmp(static_cast<const char *>(key), static_cast<const preload_entry_t *>(entry)->attribute_key);
+}
+
+esp_err_t find_legacy_entries(legacy_entry_t *&entries, size_t &count)
+{
+    size_t capacity = 0;
+    entries = nullptr;
+    count = 0;
+    nvs_iterator_t it = nullptr;
+    esp_err_t err = nvs_entry_find(ESP_MATTER_NVS_PART_NAME, nullptr, NVS_TYPE_ANY, &it);
+    for (; err == ESP_OK; err = nvs_entry_next(&it)) {
+        legacy_entry_t entry;
+        if (nvs_entry_info(it, &entry.info) != ESP_OK || !parse_legacy_entry(entry.info, entry.attribute_key)) {
+            continue;
+        }
+        if (count == capacity) {
+            size_t new_capacity = capacity ? capacity * 2 : 8;
+            legacy_entry_t *new_entries = (legacy_entry_t *)esp_matter_mem_realloc(entries,
+                                                                                   new_capacity * sizeof(legacy_entry_t));
+            if (!new_entries) {
+                err = ESP_ERR_NO_MEM;
+                break;
+            }
+            entries = new_entries;
+            capacity = new_capacity;
+        }
+        entries[count++] = entry;
+    }
+    nvs_release_iterator(it);
+    // ESP_ERR_NVS_NOT_FOUND is returned after the last entry
+    return err == ESP_ERR_NVS_NOT_FOUND ? ESP_OK : err;
+}
+
+// Move the legacy values which are not overridden by a value of the ESP_MATTER_KVS_NAMESPACE, with a single commit,
+// then erase the legacy namespaces. Must be called with the preloaded entries sorted.
+esp_err_t migrate_legacy_entries_locked()
+{
+    legacy_entry_t *entries = nullptr;
+    size_t count = 0;
+    esp_err_t err = find_legacy_entries(entries, count);
+    if (err != ESP_OK || count == 0) {
+        esp_matter_mem_free(entries);
+        return err;
+    }
+    // Group the entries by namespace so that every legacy namespace is opened once
+    qsort(entries, count, sizeof(legacy_entry_t), compare_legacy_entries);
+
+    size_t kvs_count = s_preload_count;
+    size_t capacity = s_preload_count;
+    size_t migrated = 0;
+    nvs_handle_t kvs_handle;
+    err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE, &kvs_handle);
+    if (err != ESP_OK) {
+        esp_matter_mem_free(entries);
+        return err;
+    }
+    for (size_t i = 0; i < count && err == ESP_OK;) {
+        const char *nvs_namespace = entries[i].info.namespace_name;
+        nvs_handle_t legacy_handle;
+        err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READONLY, &legacy_handle);
+        if (err != ESP_OK) {
+            break;
+        }
+        for (; err == ESP_OK && i < count && strcmp(entries[i].info.namespace_name, nvs_namespace) == 0; ++i) {
+            const legacy_entry_t &legacy = entries[i];
+            if (bsearch(legacy.attribute_key, s_preload_entries, kvs_count, sizeof(preload_entry_t),
+                        compare_key_to_preload_entry)) {
+                // The value was stored again with the current key, the legacy value is outdated
+                continue;
+            }
+            preload_entry_t entry = {};
+            strlcpy(entry.attribute_key, legacy.attribute_key, sizeof(entry.attribute_key));
+            entry.type = legacy.info.type;
+            err = read_entry(legacy_handle, legacy.info.key, entry.type, entry.raw, entry.blob, entry.blob_len);
+            if (err == ESP_OK) {
+                err = write_entry(kvs_handle, entry.attribute_key, entry.type, entry.raw, entry.blob, entry.blob_len);
+            }
+            if (err == ESP_OK) {
+                err = append_preload_entry(entry, capacity);
+            }
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to migrate %s/%s: %d", nvs_namespace, legacy.info.key, err);
+                esp_matter_mem_free(entry.blob);
+            } else {
+                migrated++;
+            }
+        }
+        nvs_close(legacy_handle);
+    }
+    if (err == ESP_OK) {
+        err = nvs_commit(kvs_handle);
+    }
+    nvs_close(kvs_handle);
+
+    // The legacy namespaces are kept if the migration failed, their values are still read after the preload is
+    // released
+    for (size_t i = 0; i < count && err == ESP_OK; ++i) {
+        if (i > 0 && strcmp(entries[i].info.namespace_name, entries[i - 1].info.namespace_name) == 0) {
+            continue;
+        }
+        nvs_handle_t legacy_handle;
+        if (nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, entries[i].info.namespace_name, NVS_READWRITE,
+                                    &legacy_handle) == ESP_OK) {
+            nvs_erase_all(legacy_handle);
+            nvs_commit(legacy_handle);
+            nvs_close(legacy_handle);
+        }
+    }
+    esp_matter_mem_free(entries);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Migrated %u attribute values from the legacy namespaces", (unsigned)migrated);
+    }
+    return err;
+}
+
+esp_err_t load_kvs_entries_locked()
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READONLY, &handle);
+    // The namespace is created by the first stored value
+    VerifyOrReturnError(err != ESP_ERR_NVS_NOT_FOUND, ESP_OK);
+    VerifyOrReturnError(err == ESP_OK, err);
+    size_t capacity = 0;
+    nvs_iterator_t it = nullptr;
+    err = nvs_entry_find(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_TYPE_ANY, &it);
+    for (; err == ESP_OK; err = nvs_entry_next(&it)) {
+        nvs_entry_info_t info;
+        preload_entry_t entry = {};
+        err = nvs_entry_info(it, &info);
+        if (err == ESP_OK) {
+            strlcpy(entry.attribute_key, info.key, sizeof(entry.attribute_key));
+            entry.type = info.type;
+            err = read_entry(handle, info.key, info.type, entry.raw, entry.blob, entry.blob_len);
+            if (err == ESP_ERR_NVS_TYPE_MISMATCH) {
+                // Not written by nvs_set_val(), the key is kept so that its reads go to the NVS
+                entry.stale = true;
+                err = ESP_OK;
+            }
+        }
+        if (err == ESP_OK) {
+            err = append_preload_entry(entry, capacity);
+        }
+        if (err != ESP_OK) {
+            esp_matter_mem_free(entry.blob);
+            break;
+        }
+    }
+    nvs_release_iterator(it);
+    nvs_close(handle);
+    return err == ESP_ERR_NVS_NOT_FOUND ? ESP_OK : err;
+}
+
+esp_err_t preload_locked()
+{
+    VerifyOrReturnError(s_preload_state == PRELOAD_NONE, ESP_OK);
+    int64_t start = esp_timer_get_time();
+    esp_err_t err = load_kvs_entries_locked();
+    if (err == ESP_OK) {
+        qsort(s_preload_entries, s_preload_count, sizeof(preload_entry_t), compare_preload_entries);
+        err = migrate_legacy_entries_locked();
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to preload the attribute values: %d", err);
+        release_preload_locked();
+        return err;
+    }
+    qsort(s_preload_entries, s_preload_count, sizeof(preload_entry_t), compare_preload_entries);
+    s_preload_state = PRELOAD_LOADED;
+    ESP_LOGI(TAG, "Preloaded %u attribute values in %" PRId64 " us", (unsigned)s_preload_count,
+             esp_timer_get_time() - start);
+    return ESP_OK;
+}
+
+// Take the preloaded value of the key. Returns ESP_ERR_NOT_FINISHED if the value must be read from the NVS.
+esp_err_t get_preloaded_val(const char *attribute_key, esp_matter_attr_val_t &val)
+{
+    scoped_preload_lock lock;
+    if (s_preload_state == PRELOAD_NONE && !esp_matter::is_started()) {
+        preload_locked();
+    }
+    VerifyOrReturnError(s_preload_state == PRELOAD_LOADED, ESP_ERR_NOT_FINISHED);
+    preload_entry_t *entry = find_preload_entry(attribute_key);
+    // The attribute was never stored, and the legacy value would have been migrated
+    VerifyOrReturnError(entry, ESP_ERR_NVS_NOT_FOUND);
+    // Read the values with another type, like the legacy values stored as blobs, through nvs_get_val()
+    VerifyOrReturnError(!entry->stale && entry->type == get_nvs_type(val), ESP_ERR_NOT_FINISHED);
+    entry->stale = true;
+
+    esp_matter_val_type_t storage_type = val.get_storage_type();
+    if (storage_type == ESP_MATTER_VAL_TYPE_FLOAT) {
+        VerifyOrReturnError(entry->blob_len == sizeof(val.val.f), ESP_ERR_NOT_FINISHED);
+        memcpy(&val.val.f, entry->blob, sizeof(val.val.f));
+    } else if (entry->type == NVS_TYPE_BLOB) {
+        // Same as nvs_get_val(), the size of the attribute value is not decreased
+        size_t len = std::max(entry->blob_len, static_cast<size_t>(val.val.a.s));
+        bool null_reserve = (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING) || (val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING);
+        uint8_t *buffer = (uint8_t *)esp_matter_mem_calloc(1, len + (null_reserve ? 1 : 0));
+        VerifyOrReturnError(buffer, ESP_ERR_NO_MEM);
+        memcpy(buffer, entry->blob, entry->blob_len);
+        val.val.a.b = buffer;
+        val.val.a.t = len + (val.val.a.t - val.val.a.s);
+        val.val.a.s = len;
+    } else if (storage_type == ESP_MATTER_VAL_TYPE_BOOLEAN) {
+        val.val.b = static_cast<uint8_t>(entry->raw) != 0;
+    } else {
+        // The integer members of the value share their first bytes
+        memcpy(&val.val.u64, &entry->raw, sizeof(entry->raw));
+    }
+    esp_matter_mem_free(entry->blob);
+    entry->blob = nullptr;
+    return ESP_OK;
+}
+
+// The value of the key is changed, the preloaded value must not be used anymore
+void invalidate_preloaded_val(const char *attribute_key)
+{
+    scoped_preload_lock lock;
+    VerifyOrReturn(s_preload_state == PRELOAD_LOADED);
+    preload_entry_t *entry = find_preload_entry(attribute_key);
+    if (!entry) {
+        // A miss would return ESP_ERR_NVS_NOT_FOUND, fall back to the NVS for all the keys
+        release_preload_locked();
+        return;
+    }
+    entry->stale = true;
+    esp_matter_mem_free(entry->blob);
+    entry->blob = nullptr;
+}
+
+} // namespace
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
+
 esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t  &val)
 {
     /* Get attribute key */
@@ -285,6 +959,21 @@ esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
 
     ESP_LOGD(TAG, "read attribute from nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ","
              " attribute_id-0x%" PRIx32 "", endpoint_id, cluster_id, attribute_id);
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+    {
+        // Write back the pending values first so that the read does not return a stale value
+        scoped_cache_lock lock;
+        if (find_entry(attribute_key)) {
+            flush_locked();
+        }
+    }
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+    esp_err_t preload_err = get_preloaded_val(attribute_key, val);
+    if (preload_err != ESP_ERR_NOT_FINISHED) {
+        return preload_err;
+    }
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
     esp_err_t err = nvs_get_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
     if (err == ESP_ERR_NVS_NOT_FOUND) {
         // If we don't find attribute key in the esp_matter_kvs namespace, we will try to get the attribute value
@@ -315,6 +1004,15 @@ esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
     get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
     ESP_LOGD(TAG, "Store attribute in nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ", attribute_id-0x%" PRIx32 "",
              endpoint_id, cluster_id, attribute_id);
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+    invalidate_preloaded_val(attribute_key);
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+    if (use_cache()) {
+        scoped_cache_lock lock;
+        return cache_val_locked(attribute_key, &val);
+    }
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
     return nvs_store_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
 }
 
@@ -325,8 +1023,83 @@ esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
     get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
     ESP_LOGD(TAG, "Erase attribute in nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ", attribute_id-0x%" PRIx32 "",
              endpoint_id, cluster_id, attribute_id);
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+    invalidate_preloaded_val(attribute_key);
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+    if (use_cache()) {
+        scoped_cache_lock lock;
+        return cache_val_locked(attribute_key, nullptr);
+    }
+    {
+        // Drop the pending value so that it does not overwrite the erase later
+        scoped_cache_lock lock;
+        if (cache_entry_t *entry = find_entry(attribute_key)) {
+            release_entry(*entry);
+            *entry = s_cache[--s_cache_count];
+        }
+    }
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
     return nvs_erase_val(ESP_MATTER_KVS_NAMESPACE, attribute_key);
 }
 
+esp_err_t flush_persistent_values()
+{
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+    scoped_cache_lock lock;
+    return flush_locked();
+#else
+    return ESP_OK;
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+}
+
+esp_err_t preload_nvs_values()
+{
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+    // The pending values must be in the NVS before it is walked
+    flush_persistent_values();
+    scoped_preload_lock lock;
+    release_preload_locked();
+    s_preload_state = PRELOAD_NONE;
+    return preload_locked();
+#else
+    return ESP_OK;
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
+}
+
+void release_preloaded_nvs_values()
+{
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+    scoped_preload_lock lock;
+    release_preload_locked();
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
+}
+
+esp_err_t erase_all_in_nvs()
+{
+    release_preloaded_nvs_values();
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+    {
+        // The pending values must not be written back after the erase
+        scoped_cache_lock lock;
+        for (size_t i = 0; i < s_cache_count; ++i) {
+            release_entry(s_cache[i]);
+        }
+        s_cache_count = 0;
+    }
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = nvs_erase_all(handle);
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return err;
+}
+
 } // namespace attribute
 } // namespace esp_matter
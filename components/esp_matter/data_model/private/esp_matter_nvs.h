@@ -55,5 +55,30 @@ esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
  */
 esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
 
+/**
+ * @brief Reads all the attribute values of the ESP_MATTER_KVS_NAMESPACE with one walk of the NVS partition, and moves
+ * the values of the legacy endpoint_%X namespaces to the ESP_MATTER_KVS_NAMESPACE.
+ *
+ * get_val_from_nvs() takes the values from the preloaded table until release_preloaded_nvs_values() is called. If
+ * CONFIG_ESP_MATTER_NVS_PRELOAD is enabled, this is done by the first get_val_from_nvs() call before esp_matter is
+ * started. It does nothing if CONFIG_ESP_MATTER_NVS_PRELOAD is disabled.
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t preload_nvs_values();
+
+/**
+ * @brief Frees the preloaded attribute values, get_val_from_nvs() reads the values from the NVS afterwards.
+ */
+void release_preloaded_nvs_values();
+
+/**
+ * @brief Erases all the attribute values in the ESP_MATTER_KVS_NAMESPACE, including the values pending in the
+ * write-back cache.
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t erase_all_in_nvs();
+
 } // namespace attribute
 } // namespace esp_matter
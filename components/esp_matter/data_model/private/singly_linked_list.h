@@ -29,20 +29,29 @@ public:
      */
     static void append(T **head, T *newNode);
 
+    /**
+     * @brief Frees a node with esp_matter_mem_free(), the default deleter of remove() and delete_list().
+     *
+     * @param node  Pointer to the node to free.
+     */
+    static void release(T *node);
+
     /**
      * @brief Removes a specific target node from the list.
      *
-     * @param head    Pointer to the head pointer of the list.
-     * @param target  Pointer to the target node to remove.
+     * @param head     Pointer to the head pointer of the list.
+     * @param target   Pointer to the target node to remove.
+     * @param deleter  Function which frees the removed node.
      */
-    static void remove(T **head, T *target);
+    static void remove(T **head, T *target, void (*deleter)(T *) = release);
 
     /**
      * @brief Deletes the entire list, freeing all nodes.
      *
-     * @param head  Pointer to the head pointer of the list.
+     * @param head     Pointer to the head pointer of the list.
+     * @param deleter  Function which frees each node.
      */
-    static void delete_list(T **head);
+    static void delete_list(T **head, void (*deleter)(T *) = release);
 
     /**
      * @brief Counts the number of nodes in the list.
@@ -75,7 +84,13 @@ void SinglyLinkedList<T>::append(T **head, T *newNode)
 }
 
 template <typename T>
-void SinglyLinkedList<T>::remove(T **head, T *target)
+void SinglyLinkedList<T>::release(T *node)
+{
+    esp_matter_mem_free(node);
+}
+
+template <typename T>
+void SinglyLinkedList<T>::remove(T **head, T *target, void (*deleter)(T *))
 {
     T **p = head;
     while (*p && *p != target) {
@@ -83,17 +98,17 @@ void SinglyLinkedList<T>::remove(T **head, T *target)
     }
     if (*p != nullptr) {
         *p = target->next;
-        free(target);
+        deleter(target);
     }
 }
 
 template <typename T>
-void SinglyLinkedList<T>::delete_list(T **head)
+void SinglyLinkedList<T>::delete_list(T **head, void (*deleter)(T *))
 {
     T *current = *head;
     while (current) {
         T *next = current->next;
-        free(current);
+        deleter(current);
         current = next;
     }
     *head = nullptr;
@@ -19,11 +19,11 @@
 #include <app/clusters/air-quality-server/AirQualityCluster.h>
 #include <clusters/AirQuality/Enums.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/CodeUtils.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -32,19 +32,21 @@ using namespace chip::app::Clusters::AirQuality;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<AirQualityCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<AirQualityCluster>> gServers("air_quality");
 } // namespace
 
 void ESPMatterAirQualityClusterServerInitCallback(EndpointId endpointId)
 {
     VerifyOrReturn(cluster::get(endpointId, AirQuality::Id) != nullptr,
                    ChipLogError(AppServer, "AirQuality: cluster missing in esp-matter data model for endpoint %u", endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         const uint32_t raw = read_feature_map_u32(endpointId, AirQuality::Id);
-        gServers[endpointId].Create(endpointId, BitFlags<Feature>(raw));
+        server->Create(endpointId, BitFlags<Feature>(raw));
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "AirQuality register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -52,16 +54,16 @@ void ESPMatterAirQualityClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterAirQualityClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "AirQuality unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
@@ -14,22 +14,24 @@
 
 #include <app/ClusterCallbacks.h>
 #include <app/clusters/bindings/BindingCluster.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
 using namespace chip::app::Clusters;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<BindingCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<BindingCluster>> gServers("binding");
 
 } // namespace
 
 void ESPMatterBindingClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
-        gServers[endpointId].Create(
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
+        server->Create(
         BindingCluster::Context{
             .bindingTable    = Binding::Table::GetInstance(),
             .bindingManager  = Binding::Manager::GetInstance(),
@@ -39,7 +41,7 @@ void ESPMatterBindingClusterServerInitCallback(EndpointId endpointId)
     }
 
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register Binding on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -48,18 +50,18 @@ void ESPMatterBindingClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterBindingClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister Binding on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
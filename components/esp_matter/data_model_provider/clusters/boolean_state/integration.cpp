@@ -14,25 +14,28 @@
 
 #include <app/ClusterCallbacks.h>
 #include <app/clusters/boolean-state-server/BooleanStateCluster.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
 using namespace chip::app::Clusters;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<BooleanStateCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<BooleanStateCluster>>
+    gServers("boolean_state");
 
 } // namespace
 
 void ESPMatterBooleanStateClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
-        gServers[endpointId].Create(endpointId);
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
+        server->Create(endpointId);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register BooleanState on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -41,18 +44,18 @@ void ESPMatterBooleanStateClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterBooleanStateClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister BooleanState on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
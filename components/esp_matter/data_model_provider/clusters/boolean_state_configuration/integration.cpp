@@ -17,7 +17,7 @@
 #include "esp_matter_data_model.h"
 #include "esp_matter_data_model_priv.h"
 #include "esp_matter_data_model_provider.h"
-#include <unordered_map>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include "app/clusters/boolean-state-configuration-server/BooleanStateConfigurationCluster.h"
 #include "app/server-cluster/ServerClusterInterfaceRegistry.h"
 #include "clusters/BooleanStateConfiguration/Enums.h"
@@ -28,7 +28,8 @@ using namespace chip::app::Clusters;
 using namespace chip::app::Clusters::BooleanStateConfiguration;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<BooleanStateConfigurationCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<BooleanStateConfigurationCluster>>
+    gServers("boolean_state_configuration");
 
 esp_err_t get_attr_val(esp_matter::cluster_t *cluster, uint32_t attribute_id, esp_matter_attr_val_t &val)
 {
@@ -85,8 +86,9 @@ namespace chip::app::Clusters::BooleanStateConfiguration {
 
 BooleanStateConfigurationCluster *FindClusterOnEndpoint(EndpointId endpointId)
 {
-    if (gServers[endpointId].IsConstructed()) {
-        return &gServers[endpointId].Cluster();
+    auto *server = gServers.find(endpointId);
+    if (server != nullptr && server->IsConstructed()) {
+        return &server->Cluster();
     }
     return nullptr;
 }
@@ -94,7 +96,9 @@ BooleanStateConfigurationCluster *FindClusterOnEndpoint(EndpointId endpointId)
 
 void ESPMatterBooleanStateConfigurationClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         BitMask<Feature> featureMap;
         uint8_t supportedSensitivityLevels = 0, defaultSensitivityLevel = 0;
         AlarmModeBitmap alarmsSupported = AlarmModeBitmap::kAudible;
@@ -105,7 +109,7 @@ void ESPMatterBooleanStateConfigurationClusterServerInitCallback(EndpointId endp
         VerifyOrReturn(err == CHIP_NO_ERROR, ChipLogError(AppServer,
                                                           "Failed to get config of BooleanStateConfiguration - Error %" CHIP_ERROR_FORMAT, err.Format()));
 
-        gServers[endpointId].Create(endpointId, featureMap, optionalAttrSet,
+        server->Create(endpointId, featureMap, optionalAttrSet,
         BooleanStateConfigurationCluster::StartupConfiguration{
             .supportedSensitivityLevels = supportedSensitivityLevels,
             .defaultSensitivityLevel = defaultSensitivityLevel,
@@ -113,7 +117,7 @@ void ESPMatterBooleanStateConfigurationClusterServerInitCallback(EndpointId endp
         });
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register BooleanStateConfiguration - Error %" CHIP_ERROR_FORMAT, err.Format());
     }
@@ -122,16 +126,16 @@ void ESPMatterBooleanStateConfigurationClusterServerInitCallback(EndpointId endp
 void ESPMatterBooleanStateConfigurationClusterServerShutdownCallback(EndpointId endpointId,
                                                                      ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister BooleanStateConfiguration - Error %" CHIP_ERROR_FORMAT, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
@@ -18,7 +18,7 @@
 #include <data_model/esp_matter_data_model.h>
 #include <data_model/esp_matter_endpoint.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
-#include <unordered_map>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include "integration.h"
 
 using namespace chip;
@@ -28,8 +28,10 @@ using namespace chip::app::Clusters::CameraAvStreamManagement;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<CameraAVStreamManagementCluster>> gServers;
-std::unordered_map<EndpointId, CameraAvStreamManagementConfig> gConfigs;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<CameraAVStreamManagementCluster>>
+    gServers("camera_av_stream_management");
+esp_matter::data_model::cluster_instance_pool<CameraAvStreamManagementConfig>
+    gConfigs("camera_av_stream_management configs");
 
 bool IsClusterEnabled(EndpointId endpointId)
 {
@@ -91,30 +93,32 @@ namespace chip::app::Clusters::CameraAvStreamManagement {
 
 void SetConfig(EndpointId endpointId, const CameraAvStreamManagementConfig  &config)
 {
-    gConfigs[endpointId] = config;
+    auto *entry = gConfigs.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    *entry = config;
 }
 
 const CameraAvStreamManagementConfig * GetConfig(EndpointId endpointId)
 {
-    auto it = gConfigs.find(endpointId);
-    return (it == gConfigs.end()) ? nullptr : &it->second;
+    return gConfigs.find(endpointId);
 }
 
 void SetDelegate(EndpointId endpointId, CameraAVStreamManagementDelegate * delegate)
 {
-    if (gConfigs.find(endpointId) == gConfigs.end()) {
+    auto *config = gConfigs.find(endpointId);
+    if (config == nullptr) {
         ChipLogError(AppServer, "Camera AV Stream Management config not found for endpoint %u", endpointId);
         return;
     }
-    gConfigs[endpointId].delegate = delegate;
+    config->delegate = delegate;
 }
 
 CameraAVStreamManagementCluster * GetServer(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturnValue(it != gServers.end(), nullptr);
-    VerifyOrReturnValue(it->second.IsConstructed(), nullptr);
-    return &it->second.Cluster();
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturnValue(server != nullptr, nullptr);
+    VerifyOrReturnValue(server->IsConstructed(), nullptr);
+    return &server->Cluster();
 }
 
 } // namespace chip::app::Clusters::CameraAvStreamManagement
@@ -125,7 +129,9 @@ void ESPMatterCameraAvStreamManagementClusterServerInitCallback(EndpointId endpo
         return;
     }
 
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         const CameraAvStreamManagementConfig *config = CameraAvStreamManagement::GetConfig(endpointId);
         if (config == nullptr || config->delegate == nullptr) {
             ChipLogError(AppServer, "Camera AV Stream Management config/delegate missing for endpoint %u", endpointId);
@@ -163,10 +169,10 @@ void ESPMatterCameraAvStreamManagementClusterServerInitCallback(EndpointId endpo
             .supportedStreamUsages        = config->supportedStreamUsages,
             .streamUsagePriorities        = config->streamUsagePriorities,
         };
-        gServers[endpointId].Create(std::move(initArgs));
+        server->Create(std::move(initArgs));
     }
 
-    CHIP_ERROR err = data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+    CHIP_ERROR err = data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
                      "Failed to register Camera AV Stream Management on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
@@ -176,19 +182,19 @@ void ESPMatterCameraAvStreamManagementClusterServerInitCallback(EndpointId endpo
 
 void ESPMatterCameraAvStreamManagementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto serverIt = gServers.find(endpointId);
-    VerifyOrReturn(serverIt != gServers.end());
-    VerifyOrReturn(serverIt->second.IsConstructed());
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
 
-    CHIP_ERROR err = data_model::provider::get_instance().registry().Unregister(&serverIt->second.Cluster(), shutdownType);
+    CHIP_ERROR err = data_model::provider::get_instance().registry().Unregister(&server->Cluster(), shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
                      "Failed to unregister Camera AV Stream Management on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        serverIt->second.Destroy();
-        gServers.erase(serverIt);
+        server->Destroy();
+        gServers.erase(endpointId);
         gConfigs.erase(endpointId);
     }
 }
@@ -21,12 +21,12 @@
 #include <clusters/ClosureControl/Attributes.h>
 #include <clusters/ClosureControl/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <platform/DefaultTimerDelegate.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -38,8 +38,9 @@ namespace {
 
 DefaultTimerDelegate gTimerDelegate;
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ClosureControlCluster>> gServers;
-std::unordered_map<EndpointId, ClosureControlClusterDelegate *> gDelegates;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ClosureControlCluster>>
+    gServers("closure_control");
+esp_matter::data_model::cluster_instance_pool<ClosureControlClusterDelegate *> gDelegates("closure_control delegates");
 
 } // namespace
 
@@ -50,10 +51,12 @@ namespace ClosureControl {
 
 void MatterClosureControlSetDelegate(EndpointId endpointId, ClosureControlClusterDelegate &delegate)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it == gServers.end() || !it->second.IsConstructed(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server == nullptr || !server->IsConstructed(),
                    ChipLogError(AppServer, "ClosureControl: cluster already initialized; cannot set delegate"));
-    gDelegates[endpointId] = &delegate;
+    auto *entry = gDelegates.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    *entry = &delegate;
 }
 
 } // namespace ClosureControl
@@ -65,15 +68,17 @@ void ESPMatterClosureControlClusterServerInitCallback(EndpointId endpointId)
 {
     VerifyOrReturn(cluster::get(endpointId, ClosureControl::Id) != nullptr,
                    ChipLogError(AppServer, "ClosureControl: cluster missing in esp-matter data model for endpoint %u", endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         ClosureControlClusterDelegate *delegate = nullptr;
         {
-            auto it = gDelegates.find(endpointId);
-            VerifyOrReturn(it != gDelegates.end() && it->second != nullptr,
+            auto *entry = gDelegates.find(endpointId);
+            VerifyOrReturn(entry != nullptr && *entry != nullptr,
                            ChipLogError(AppServer,
                                         "ClosureControl: delegate not set for ep %u (call MatterClosureControlSetDelegate first)",
                                         endpointId));
-            delegate = it->second;
+            delegate = *entry;
         }
 
         // Read feature map from esp-matter data model
@@ -117,10 +122,10 @@ void ESPMatterClosureControlClusterServerInitCallback(EndpointId endpointId)
         // no reliable values in esp-matter store. Use Config defaults; the code-driven
         // cluster initializes them properly via Startup().
 
-        gServers[endpointId].Create(config);
+        server->Create(config);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ClosureControl register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -128,17 +133,17 @@ void ESPMatterClosureControlClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterClosureControlClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ClosureControl unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -20,11 +20,11 @@
 #include <app/clusters/closure-dimension-server/ClosureDimensionCluster.h>
 #include <clusters/ClosureDimension/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -34,8 +34,10 @@ using namespace esp_matter;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ClosureDimensionCluster>> gServers;
-std::unordered_map<EndpointId, ClosureDimensionClusterDelegate *> gDelegates;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ClosureDimensionCluster>>
+    gServers("closure_dimension");
+esp_matter::data_model::cluster_instance_pool<ClosureDimensionClusterDelegate *>
+    gDelegates("closure_dimension delegates");
 
 } // namespace
 
@@ -46,10 +48,12 @@ namespace ClosureDimension {
 
 void MatterClosureDimensionSetDelegate(EndpointId endpointId, ClosureDimensionClusterDelegate &delegate)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it == gServers.end() || !it->second.IsConstructed(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server == nullptr || !server->IsConstructed(),
                    ChipLogError(AppServer, "ClosureDimension: cluster already initialized; cannot set delegate"));
-    gDelegates[endpointId] = &delegate;
+    auto *entry = gDelegates.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    *entry = &delegate;
 }
 
 } // namespace ClosureDimension
@@ -64,15 +68,17 @@ void ESPMatterClosureDimensionClusterServerInitCallback(EndpointId endpointId)
                    ChipLogError(AppServer,
                                 "ClosureDimension: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         ClosureDimensionClusterDelegate *delegate = nullptr;
         {
-            auto it = gDelegates.find(endpointId);
-            VerifyOrReturn(it != gDelegates.end() && it->second != nullptr,
+            auto *entry = gDelegates.find(endpointId);
+            VerifyOrReturn(entry != nullptr && *entry != nullptr,
                            ChipLogError(AppServer,
                                         "ClosureDimension: delegate not set for ep %u (call MatterClosureDimensionSetDelegate first)",
                                         endpointId));
-            delegate = it->second;
+            delegate = *entry;
         }
 
         // Read feature map from esp-matter data model
@@ -103,11 +109,11 @@ void ESPMatterClosureDimensionClusterServerInitCallback(EndpointId endpointId)
             config.WithSpeed();
         }
 
-        gServers[endpointId].Create(config);
+        server->Create(config);
     }
 
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ClosureDimension register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -115,18 +121,18 @@ void ESPMatterClosureDimensionClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterClosureDimensionClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return;
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(), shutdownType);
+        esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(), shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ClosureDimension unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
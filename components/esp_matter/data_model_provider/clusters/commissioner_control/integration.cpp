@@ -21,10 +21,10 @@
 #include <app/clusters/commissioner-control-server/Delegate.h>
 #include <clusters/CommissionerControl/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -34,8 +34,9 @@ using namespace esp_matter;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<CommissionerControlCluster>> gServers;
-std::unordered_map<EndpointId, Delegate *> gDelegates;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<CommissionerControlCluster>>
+    gServers("commissioner_control");
+esp_matter::data_model::cluster_instance_pool<Delegate *> gDelegates("commissioner_control delegates");
 
 } // namespace
 
@@ -46,10 +47,12 @@ namespace CommissionerControl {
 
 void MatterCommissionerControlSetDelegate(EndpointId endpointId, Delegate *delegate)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it == gServers.end() || !it->second.IsConstructed(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server == nullptr || !server->IsConstructed(),
                    ChipLogError(AppServer, "CommissionerControl: cluster already initialized; cannot set delegate"));
-    gDelegates[endpointId] = delegate;
+    auto *entry = gDelegates.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    *entry = delegate;
 }
 
 } // namespace CommissionerControl
@@ -64,23 +67,25 @@ void ESPMatterCommissionerControlClusterServerInitCallback(EndpointId endpointId
                    ChipLogError(AppServer,
                                 "CommissionerControl: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         Delegate *delegate = nullptr;
         {
-            auto it = gDelegates.find(endpointId);
-            VerifyOrReturn(it != gDelegates.end() && it->second != nullptr,
+            auto *entry = gDelegates.find(endpointId);
+            VerifyOrReturn(entry != nullptr && *entry != nullptr,
                            ChipLogError(AppServer,
                                         "CommissionerControl: delegate not set for ep %u "
                                         "(call MatterCommissionerControlSetDelegate first)",
                                         endpointId));
-            delegate = it->second;
+            delegate = *entry;
         }
 
-        gServers[endpointId].Create(endpointId, *delegate);
+        server->Create(endpointId, *delegate);
     }
 
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "CommissionerControl register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -88,18 +93,18 @@ void ESPMatterCommissionerControlClusterServerInitCallback(EndpointId endpointId
 
 void ESPMatterCommissionerControlClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return;
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(), shutdownType);
+        esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(), shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "CommissionerControl unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -15,6 +15,7 @@
 #include <app/clusters/descriptor/DescriptorCluster.h>
 #include <esp_matter_data_model.h>
 
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
@@ -86,22 +87,25 @@ private:
     bool mFetchedSemanticTags = false;
 };
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ESPMatterDescriptorCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ESPMatterDescriptorCluster>>
+    gServers("descriptor");
 
 } // namespace
 
 void ESPMatterDescriptorClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         DescriptorCluster::OptionalAttributesSet optionalAttrSet;
         if (esp_matter::endpoint::is_attribute_enabled(endpointId, Descriptor::Id,
                                                        Descriptor::Attributes::EndpointUniqueID::Id)) {
             optionalAttrSet.Set<Descriptor::Attributes::EndpointUniqueID::Id>();
         }
-        gServers[endpointId].Create(endpointId, optionalAttrSet);
+        server->Create(endpointId, optionalAttrSet);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register Descriptor on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -110,18 +114,18 @@ void ESPMatterDescriptorClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterDescriptorClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister Descriptor on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -16,7 +16,7 @@
 #include "esp_matter_data_model.h"
 #include "esp_matter_data_model_priv.h"
 #include "esp_matter_data_model_provider.h"
-#include <unordered_map>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include "app/clusters/electrical-energy-measurement-server/ElectricalEnergyMeasurementCluster.h"
 #include "app/clusters/electrical-energy-measurement-server/ElectricalEnergyMeasurementDelegate.h"
 #include "app/server-cluster/ServerClusterInterfaceRegistry.h"
@@ -32,7 +32,8 @@ using namespace chip::app::Clusters::ElectricalEnergyMeasurement;
 using namespace chip::app::Clusters::ElectricalEnergyMeasurement::Structs;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ElectricalEnergyMeasurementCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ElectricalEnergyMeasurementCluster>>
+    gServers("electrical_energy_measurement");
 
 // Fallback delegate when the app does not provide one via config_t.delegate.
 // The upstream Config requires a Delegate& (reference, cannot be null).
@@ -80,10 +81,10 @@ namespace chip::app::Clusters::ElectricalEnergyMeasurement {
 
 ElectricalEnergyMeasurementCluster *GetClusterInstance(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturnValue(it != gServers.end(), nullptr);
-    VerifyOrReturnValue(it->second.IsConstructed(), nullptr);
-    return &it->second.Cluster();
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturnValue(server != nullptr, nullptr);
+    VerifyOrReturnValue(server->IsConstructed(), nullptr);
+    return &server->Cluster();
 }
 
 CHIP_ERROR SetMeasurementAccuracy(EndpointId endpointId, const Structs::MeasurementAccuracyStruct::Type &accuracy)
@@ -132,7 +133,9 @@ bool NotifyPeriodicEnergyMeasured(EndpointId endpointId,
 void ESPMatterElectricalEnergyMeasurementClusterServerInitCallback(EndpointId endpoint)
 {
     static const MeasurementAccuracyStruct::Type kDefaultAccuracy = {};
-    if (!gServers[endpoint].IsConstructed()) {
+    auto *server = gServers.emplace(endpoint);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
 
         esp_matter::cluster_t *cluster = esp_matter::cluster::get(endpoint, ElectricalEnergyMeasurement::Id);
         VerifyOrReturn(cluster != nullptr,
@@ -157,10 +160,10 @@ void ESPMatterElectricalEnergyMeasurementClusterServerInitCallback(EndpointId en
             .delegate           = *delegate_p,
             .timerDelegate      = gDefaultTimerDelegate,
         };
-        gServers[endpoint].Create(config);
+        server->Create(config);
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpoint].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
                      "Failed to register ElectricalEnergyMeasurement - Error %" CHIP_ERROR_FORMAT, err.Format());
@@ -170,17 +173,17 @@ void ESPMatterElectricalEnergyMeasurementClusterServerInitCallback(EndpointId en
 void ESPMatterElectricalEnergyMeasurementClusterServerShutdownCallback(EndpointId endpointId,
                                                                        ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
                      "Failed to unregister ElectricalEnergyMeasurement - Error %" CHIP_ERROR_FORMAT, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
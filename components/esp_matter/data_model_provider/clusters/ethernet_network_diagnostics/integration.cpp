@@ -14,19 +14,20 @@
 
 #include <app/ClusterCallbacks.h>
 #include <app/clusters/ethernet-network-diagnostics-server/EthernetDiagnosticsCluster.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <esp_matter_data_model.h>
 #include <esp_matter_data_model_priv.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
 using namespace chip::app::Clusters;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<EthernetDiagnosticsServerCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<EthernetDiagnosticsServerCluster>>
+    gServers("ethernet_network_diagnostics");
 
 uint32_t get_feature_map(esp_matter::cluster_t *cluster)
 {
@@ -63,19 +64,21 @@ EthernetDiagnosticsServerCluster::OptionalAttributeSet get_attribute_set(esp_mat
 
 void ESPMatterEthernetNetworkDiagnosticsClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         esp_matter::cluster_t *cluster = esp_matter::cluster::get(endpointId, EthernetNetworkDiagnostics::Id);
         VerifyOrReturn(cluster != nullptr,
                        ChipLogError(AppServer,
                                     "EthernetNetworkDiagnostics: cluster missing in esp-matter data model for endpoint %u",
                                     endpointId));
 
-        gServers[endpointId].Create(DeviceLayer::GetDiagnosticDataProvider(),
+        server->Create(DeviceLayer::GetDiagnosticDataProvider(),
                                     BitFlags<EthernetNetworkDiagnostics::Feature>(get_feature_map(cluster)),
                                     get_attribute_set(cluster));
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
                      "Failed to register EthernetNetworkDiagnostics on endpoint %u - Error: %" CHIP_ERROR_FORMAT,
@@ -86,10 +89,10 @@ void ESPMatterEthernetNetworkDiagnosticsClusterServerInitCallback(EndpointId end
 void ESPMatterEthernetNetworkDiagnosticsClusterServerShutdownCallback(EndpointId endpointId,
                                                                       ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
@@ -97,8 +100,8 @@ void ESPMatterEthernetNetworkDiagnosticsClusterServerShutdownCallback(EndpointId
                      endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -24,10 +24,10 @@
 #include <clusters/FanControl/EnumsCheck.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -93,7 +93,7 @@ struct FanControlEndpoint {
     LazyRegisteredServerCluster<FanControlCluster> server;
 };
 
-std::unordered_map<EndpointId, FanControlEndpoint> gServers;
+esp_matter::data_model::cluster_instance_pool<FanControlEndpoint> gServers("fan_control");
 
 } // namespace
 
@@ -102,13 +102,14 @@ void ESPMatterFanControlClusterServerInitCallback(EndpointId endpointId)
     VerifyOrReturn(cluster::get(endpointId, FanControl::Id) != nullptr,
                    ChipLogError(AppServer, "FanControl: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    auto  &entry = gServers[endpointId];
-    if (!entry.server.IsConstructed()) {
+    auto *entry = gServers.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    if (!entry->server.IsConstructed()) {
         const uint32_t featureMap = read_feature_map_u32(endpointId, FanControl::Id);
         BitFlags<FanControl::Feature> features(featureMap);
 
-        entry.delegateWrapper.SetWrapped(endpointId, nullptr);
-        FanControlCluster::Config config(endpointId, entry.delegateWrapper);
+        entry->delegateWrapper.SetWrapped(endpointId, nullptr);
+        FanControlCluster::Config config(endpointId, entry->delegateWrapper);
 
         // FanModeSequence
         uint8_t fanModeSeqRaw = 0;
@@ -144,10 +145,10 @@ void ESPMatterFanControlClusterServerInitCallback(EndpointId endpointId)
             config.WithStep();
         }
 
-        entry.server.Create(config);
+        entry->server.Create(config);
     }
 
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(entry.server.Registration());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(entry->server.Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "FanControl register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -155,17 +156,17 @@ void ESPMatterFanControlClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterFanControlClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.server.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.server.Cluster(),
+    auto *entry = gServers.find(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    VerifyOrReturn(entry->server.IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&entry->server.Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "FanControl unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.server.Destroy();
-        gServers.erase(it);
+        entry->server.Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -188,18 +189,18 @@ namespace FanControl {
 
 FanControlCluster * FindClusterOnEndpoint(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.server.IsConstructed()) {
+    auto *entry = gServers.find(endpointId);
+    if (entry == nullptr || !entry->server.IsConstructed()) {
         return nullptr;
     }
-    return &it->second.server.Cluster();
+    return &entry->server.Cluster();
 }
 
 void SetDefaultDelegate(EndpointId endpointId, Delegate * delegate)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end() && it->second.server.IsConstructed());
-    it->second.delegateWrapper.SetWrapped(endpointId, delegate);
+    auto *entry = gServers.find(endpointId);
+    VerifyOrReturn(entry != nullptr && entry->server.IsConstructed());
+    entry->delegateWrapper.SetWrapped(endpointId, delegate);
 }
 
 } // namespace FanControl
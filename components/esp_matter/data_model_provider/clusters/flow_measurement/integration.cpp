@@ -19,11 +19,11 @@
 #include <app/clusters/flow-measurement-server/FlowMeasurementCluster.h>
 #include <clusters/FlowMeasurement/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/CodeUtils.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -33,18 +33,19 @@ using namespace chip::app::Clusters::FlowMeasurement::Attributes;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<FlowMeasurementCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<FlowMeasurementCluster>>
+    gServers("flow_measurement");
 } // namespace
 
 namespace chip::app::Clusters::FlowMeasurement {
 
 FlowMeasurementCluster * FindClusterOnEndpoint(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return nullptr;
     }
-    return &it->second.Cluster();
+    return &server->Cluster();
 }
 
 CHIP_ERROR SetMeasuredValue(EndpointId endpointId, DataModel::Nullable<uint16_t> measuredValue)
@@ -63,7 +64,9 @@ void ESPMatterFlowMeasurementClusterServerInitCallback(EndpointId endpointId)
                    ChipLogError(AppServer,
                                 "FlowMeasurement: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         FlowMeasurementCluster::Config config;
         esp_matter_attr_val_t val = esp_matter_invalid(nullptr);
 
@@ -90,10 +93,10 @@ void ESPMatterFlowMeasurementClusterServerInitCallback(EndpointId endpointId)
             }
         }
 
-        gServers[endpointId].Create(endpointId, config);
+        server->Create(endpointId, config);
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "FlowMeasurement register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -101,17 +104,17 @@ void ESPMatterFlowMeasurementClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterFlowMeasurementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return;
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(), shutdownType);
+        esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(), shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "FlowMeasurement unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
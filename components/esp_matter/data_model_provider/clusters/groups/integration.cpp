@@ -15,11 +15,11 @@
 #include <app/clusters/groups-server/GroupsCluster.h>
 #include <app/server-cluster/ServerClusterInterfaceRegistry.h>
 #include <credentials/GroupDataProvider.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <esp_matter_data_model.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 #include <zap-generated/gen_config.h>
 
 #ifdef MATTER_DM_PLUGIN_SCENES_MANAGEMENT
@@ -36,7 +36,7 @@ using namespace chip::app::Clusters::Groups;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<GroupsCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<GroupsCluster>> gServers("groups");
 
 } // namespace
 
@@ -45,11 +45,13 @@ void ESPMatterGroupsClusterServerInitCallback(EndpointId endpointId)
     VerifyOrReturn(esp_matter::cluster::get(endpointId, Groups::Id) != nullptr,
                    ChipLogError(AppServer, "Groups: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         Credentials::GroupDataProvider * groupDataProvider = Credentials::GetGroupDataProvider();
         VerifyOrDie(groupDataProvider != nullptr);
 
-        gServers[endpointId].Create(endpointId,
+        server->Create(endpointId,
         GroupsCluster::Context{
             .groupDataProvider = *groupDataProvider,
 #ifdef MATTER_DM_PLUGIN_SCENES_MANAGEMENT
@@ -71,7 +73,7 @@ void ESPMatterGroupsClusterServerInitCallback(EndpointId endpointId)
         });
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register Groups - Error %" CHIP_ERROR_FORMAT, err.Format());
     }
@@ -79,17 +81,17 @@ void ESPMatterGroupsClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterGroupsClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister Groups - Error %" CHIP_ERROR_FORMAT, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
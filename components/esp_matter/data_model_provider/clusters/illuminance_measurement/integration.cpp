@@ -18,10 +18,10 @@
 #include <app/clusters/illuminance-measurement-server/IlluminanceMeasurementCluster.h>
 #include <clusters/IlluminanceMeasurement/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/CodeUtils.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -32,7 +32,8 @@ using namespace chip::Protocols::InteractionModel;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<IlluminanceMeasurementCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<IlluminanceMeasurementCluster>>
+    gServers("illuminance_measurement");
 } // namespace
 
 void ESPMatterIlluminanceMeasurementClusterServerInitCallback(EndpointId endpointId)
@@ -41,7 +42,9 @@ void ESPMatterIlluminanceMeasurementClusterServerInitCallback(EndpointId endpoin
                    ChipLogError(AppServer,
                                 "IlluminanceMeasurement: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         IlluminanceMeasurementCluster::OptionalAttributeSet optionalAttributeSet(0);
         if (endpoint::is_attribute_enabled(endpointId, IlluminanceMeasurement::Id, Tolerance::Id)) {
             optionalAttributeSet.Set<Tolerance::Id>();
@@ -70,7 +73,7 @@ void ESPMatterIlluminanceMeasurementClusterServerInitCallback(EndpointId endpoin
             VerifyOrDie(LightSensorType::GetDefault(endpointId, lightSensorType) == Status::Success);
         }
 
-        gServers[endpointId].Create(
+        server->Create(
             endpointId, optionalAttributeSet,
             IlluminanceMeasurementCluster::StartupConfiguration{ .minMeasuredValue = minMeasuredValue,
                                                                  .maxMeasuredValue = maxMeasuredValue,
@@ -78,7 +81,7 @@ void ESPMatterIlluminanceMeasurementClusterServerInitCallback(EndpointId endpoin
                                                                  .lightSensorType  = lightSensorType });
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "IlluminanceMeasurement register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -87,17 +90,17 @@ void ESPMatterIlluminanceMeasurementClusterServerInitCallback(EndpointId endpoin
 void ESPMatterIlluminanceMeasurementClusterServerShutdownCallback(EndpointId endpointId,
                                                                   ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "IlluminanceMeasurement unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
@@ -20,10 +20,10 @@
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/clusters/occupancy-sensor-server/OccupancySensingCluster.h>
 #include <app/server-cluster/OptionalAttributeSet.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <platform/DefaultTimerDelegate.h>
 
-#include <unordered_map>
 #include "support/logging/TextOnlyLogging.h"
 
 using namespace chip;
@@ -34,7 +34,8 @@ using namespace chip::app::Clusters::OccupancySensing::Attributes;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<OccupancySensingCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<OccupancySensingCluster>>
+    gServers("occupancy_sensing");
 
 DefaultTimerDelegate gDefaultTimerDelegate;
 
@@ -54,7 +55,9 @@ OccupancySensing::Feature getFeature(EndpointId endpointId)
 
 void ESPMatterOccupancySensingClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         OccupancySensingCluster::Config config(endpointId);
 
         config.WithFeatures(getFeature(endpointId));
@@ -77,10 +80,10 @@ void ESPMatterOccupancySensingClusterServerInitCallback(EndpointId endpointId)
                       esp_matter::endpoint::is_attribute_enabled(endpointId, OccupancySensing::Id,
                                                                  Attributes::PhysicalContactOccupiedToUnoccupiedDelay::Id));
         }
-        gServers[endpointId].Create(config);
+        server->Create(config);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register OccupancySensing - Error %" CHIP_ERROR_FORMAT, err.Format());
     }
@@ -88,17 +91,17 @@ void ESPMatterOccupancySensingClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterOccupancySensingClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister OccupancySensing - Error %" CHIP_ERROR_FORMAT, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -14,8 +14,8 @@
 
 #include <app/ClusterCallbacks.h>
 #include <app/clusters/ota-provider/OTAProviderCluster.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
-#include <unordered_map>
 
 #include "integration.h"
 
@@ -24,16 +24,19 @@ using namespace chip::app;
 using namespace chip::app::Clusters;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<OtaProviderServer>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<OtaProviderServer>>
+    gServers("ota_software_update_provider");
 } // namespace
 
 void ESPMatterOtaSoftwareUpdateProviderClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
-        gServers[endpointId].Create(endpointId);
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
+        server->Create(endpointId);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register OTA on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -43,18 +46,18 @@ void ESPMatterOtaSoftwareUpdateProviderClusterServerInitCallback(EndpointId endp
 void ESPMatterOtaSoftwareUpdateProviderClusterServerShutdownCallback(EndpointId endpointId,
                                                                      ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister OTA on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -66,7 +69,11 @@ namespace chip::app::Clusters::OTAProvider {
 
 void SetDelegate(EndpointId endpointId, OTAProviderDelegate *delegate)
 {
-    gServers[endpointId].Cluster().SetDelegate(delegate);
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr && server->IsConstructed(),
+                   ChipLogError(AppServer, "OTAProvider: cluster of endpoint %u is not constructed, "
+                                "SetDelegate ignored", endpointId));
+    server->Cluster().SetDelegate(delegate);
 }
 
 } // namespace chip::app::Clusters::OTAProvider
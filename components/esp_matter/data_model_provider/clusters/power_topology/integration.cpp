@@ -14,8 +14,8 @@
 
 #include <app/ClusterCallbacks.h>
 #include <app/clusters/power-topology-server/PowerTopologyCluster.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
-#include <unordered_map>
 
 #include "integration.h"
 
@@ -24,7 +24,8 @@ using namespace chip::app;
 using namespace chip::app::Clusters;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<PowerTopology::PowerTopologyCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<PowerTopology::PowerTopologyCluster>>
+    gServers("power_topology");
 
 } // namespace
 
@@ -19,11 +19,11 @@
 #include <app/clusters/pressure-measurement-server/PressureMeasurementCluster.h>
 #include <clusters/PressureMeasurement/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/CodeUtils.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -33,18 +33,19 @@ using namespace chip::app::Clusters::PressureMeasurement::Attributes;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<PressureMeasurementCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<PressureMeasurementCluster>>
+    gServers("pressure_measurement");
 } // namespace
 
 namespace chip::app::Clusters::PressureMeasurement {
 
 PressureMeasurementCluster * FindClusterOnEndpoint(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return nullptr;
     }
-    return &it->second.Cluster();
+    return &server->Cluster();
 }
 
 CHIP_ERROR SetMeasuredValue(EndpointId endpointId, DataModel::Nullable<int16_t> measuredValue)
@@ -70,7 +71,9 @@ void ESPMatterPressureMeasurementClusterServerInitCallback(EndpointId endpointId
                    ChipLogError(AppServer,
                                 "PressureMeasurement: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         PressureMeasurementCluster::Config config;
         esp_matter_attr_val_t val = esp_matter_invalid(nullptr);
 
@@ -138,11 +141,11 @@ void ESPMatterPressureMeasurementClusterServerInitCallback(EndpointId endpointId
             }
         }
 
-        gServers[endpointId].Create(endpointId, config);
+        server->Create(endpointId, config);
     }
 
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "PressureMeasurement register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -150,17 +153,17 @@ void ESPMatterPressureMeasurementClusterServerInitCallback(EndpointId endpointId
 
 void ESPMatterPressureMeasurementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return;
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(), shutdownType);
+        esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(), shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "PressureMeasurement unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
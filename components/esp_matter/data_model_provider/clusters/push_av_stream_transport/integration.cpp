@@ -17,11 +17,11 @@
 #include <app/ClusterCallbacks.h>
 #include <app/clusters/push-av-stream-transport-server/PushAVStreamTransportCluster.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/support/CodeUtils.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -30,7 +30,8 @@ using namespace chip::app::Clusters::PushAvStreamTransport::Attributes;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<PushAvStreamTransportServer>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<PushAvStreamTransportServer>>
+    gServers("push_av_stream_transport");
 } // namespace
 
 void ESPMatterPushAvStreamTransportClusterServerInitCallback(EndpointId endpointId)
@@ -39,12 +40,14 @@ void ESPMatterPushAvStreamTransportClusterServerInitCallback(EndpointId endpoint
                    ChipLogError(AppServer,
                                 "PushAvStreamTransport: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         uint32_t rawFeatureMap = read_feature_map_u32(endpointId, PushAvStreamTransport::Id);
         ChipLogProgress(AppServer, "Registering Push AV Stream Transport on endpoint %u", endpointId);
-        gServers[endpointId].Create(endpointId, BitFlags<PushAvStreamTransport::Feature>(rawFeatureMap));
+        server->Create(endpointId, BitFlags<PushAvStreamTransport::Feature>(rawFeatureMap));
     }
-    CHIP_ERROR err = data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+    CHIP_ERROR err = data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
                      "Failed to register Push AV Stream Transport on endpoint %u - Error: %" CHIP_ERROR_FORMAT,
@@ -59,10 +62,10 @@ void ESPMatterPushAvStreamTransportClusterServerShutdownCallback(EndpointId endp
                    ChipLogError(AppServer,
                                 "PushAvStreamTransport: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
@@ -70,8 +73,8 @@ void ESPMatterPushAvStreamTransportClusterServerShutdownCallback(EndpointId endp
                      endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -83,18 +86,30 @@ namespace chip::app::Clusters::PushAvStreamTransport {
 
 void SetDelegate(EndpointId endpointId, PushAvStreamTransportDelegate * delegate)
 {
-    gServers[endpointId].Cluster().SetDelegate(delegate);
-    (void)gServers[endpointId].Cluster().Init();
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr && server->IsConstructed(),
+                   ChipLogError(AppServer, "PushAvStreamTransport: cluster of endpoint %u is not constructed, "
+                                "SetDelegate ignored", endpointId));
+    server->Cluster().SetDelegate(delegate);
+    (void)server->Cluster().Init();
 }
 
 void SetTLSClientManagementDelegate(EndpointId endpointId, TLSClientManagementDelegate * delegate)
 {
-    gServers[endpointId].Cluster().SetTLSClientManagementDelegate(delegate);
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr && server->IsConstructed(),
+                   ChipLogError(AppServer, "PushAvStreamTransport: cluster of endpoint %u is not constructed, "
+                                "SetTLSClientManagementDelegate ignored", endpointId));
+    server->Cluster().SetTLSClientManagementDelegate(delegate);
 }
 
 void SetTLSCertificateManagementDelegate(EndpointId endpointId, TLSCertificateManagementDelegate * delegate)
 {
-    gServers[endpointId].Cluster().SetTLSCertificateManagementDelegate(delegate);
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr && server->IsConstructed(),
+                   ChipLogError(AppServer, "PushAvStreamTransport: cluster of endpoint %u is not constructed, "
+                                "SetTLSCertificateManagementDelegate ignored", endpointId));
+    server->Cluster().SetTLSCertificateManagementDelegate(delegate);
 }
 
 }
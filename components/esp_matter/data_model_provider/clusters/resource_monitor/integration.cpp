@@ -15,11 +15,11 @@
 #include "integration.h"
 #include <app/clusters/resource-monitoring-server/ResourceMonitoringCluster.h>
 #include <app/server-cluster/ServerClusterInterfaceRegistry.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <esp_check.h>
 #include <esp_matter_data_model.h>
 #include <esp_matter_data_model_priv.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -27,7 +27,22 @@ using namespace chip::app::Clusters;
 using namespace chip::app::Clusters::ResourceMonitoring;
 
 namespace {
-std::unordered_map<uint64_t, LazyRegisteredServerCluster<ResourceMonitoringCluster>> gServers;
+using ResourceMonitoringServers =
+    esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ResourceMonitoringCluster>>;
+ResourceMonitoringServers gHepaFilterServers("hepa_filter_monitoring");
+ResourceMonitoringServers gActivatedCarbonFilterServers("activated_carbon_filter_monitoring");
+
+ResourceMonitoringServers *GetServers(ClusterId clusterId)
+{
+    switch (clusterId) {
+    case HepaFilterMonitoring::Id:
+        return &gHepaFilterServers;
+    case ActivatedCarbonFilterMonitoring::Id:
+        return &gActivatedCarbonFilterServers;
+    default:
+        return nullptr;
+    }
+}
 
 esp_err_t get_attr_val(esp_matter::cluster_t *cluster, uint32_t attribute_id, esp_matter_attr_val_t &val)
 {
@@ -78,8 +93,11 @@ esp_err_t GetClusterConfig(EndpointId endpointId, ClusterId clusterId,
 
 void ESPMatterResourceMonitoringClusterInitCallback(EndpointId endpointId, ClusterId clusterId)
 {
-    uint64_t index = ((uint64_t)(endpointId) << 32) + clusterId;
-    if (!gServers[index].IsConstructed()) {
+    ResourceMonitoringServers *servers = GetServers(clusterId);
+    VerifyOrReturn(servers != nullptr);
+    auto *server = servers->emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         BitFlags<ResourceMonitoring::Feature> enabledFeatures;
         ResourceMonitoringCluster::OptionalAttributeSet optionalAttributeSet;
         Attributes::DegradationDirection::TypeInfo::Type degradationDirection;
@@ -87,10 +105,10 @@ void ESPMatterResourceMonitoringClusterInitCallback(EndpointId endpointId, Clust
         VerifyOrReturn(GetClusterConfig(endpointId, clusterId, enabledFeatures, optionalAttributeSet, degradationDirection,
                                         resetConditionCommandSupported) == ESP_OK,
                        ChipLogError(AppServer, "Failed to get config for Cluster %" PRIu32, clusterId));
-        gServers[index].Create(endpointId, clusterId, enabledFeatures, optionalAttributeSet, degradationDirection,
-                               resetConditionCommandSupported);
+        server->Create(endpointId, clusterId, enabledFeatures, optionalAttributeSet, degradationDirection,
+                       resetConditionCommandSupported);
     }
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(gServers[index].Registration());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register Cluster %" PRIu32 " - Error %" CHIP_ERROR_FORMAT, clusterId, err.Format());
     }
@@ -99,19 +117,20 @@ void ESPMatterResourceMonitoringClusterInitCallback(EndpointId endpointId, Clust
 void ESPMatterResourceMonitoringClusterShutdownCallback(EndpointId endpointId, ClusterId clusterId,
                                                         ClusterShutdownType shutdownType)
 {
-    uint64_t index = ((uint64_t)(endpointId) << 32) + clusterId;
-    auto it = gServers.find(index);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    ResourceMonitoringServers *servers = GetServers(clusterId);
+    VerifyOrReturn(servers != nullptr);
+    auto *server = servers->find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister Cluster %" PRIu32 " - Error %" CHIP_ERROR_FORMAT, clusterId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        servers->erase(endpointId);
     };
 }
 } // namespace
@@ -120,18 +139,20 @@ namespace chip::app::Clusters::ResourceMonitoring {
 
 ResourceMonitoringCluster *GetClusterInstance(EndpointId endpointId, ClusterId clusterId)
 {
-    uint64_t index = ((uint64_t)(endpointId) << 32) + clusterId;
-    if (gServers[index].IsConstructed()) {
-        return &gServers[index].Cluster();
+    ResourceMonitoringServers *servers = GetServers(clusterId);
+    auto *server = servers ? servers->find(endpointId) : nullptr;
+    if (server && server->IsConstructed()) {
+        return &server->Cluster();
     }
     return nullptr;
 }
 
 CHIP_ERROR SetDefaultDelegate(EndpointId endpointId, ClusterId clusterId, Delegate *delegate)
 {
-    uint64_t index = ((uint64_t)(endpointId) << 32) + clusterId;
-    if (gServers[index].IsConstructed()) {
-        return gServers[index].Cluster().SetDelegate(delegate);
+    ResourceMonitoringServers *servers = GetServers(clusterId);
+    auto *server = servers ? servers->find(endpointId) : nullptr;
+    if (server && server->IsConstructed()) {
+        return server->Cluster().SetDelegate(delegate);
     }
     return CHIP_ERROR_INCORRECT_STATE;
 }
@@ -22,9 +22,9 @@
 #include <app/clusters/scenes-server/SceneTableImpl.h>
 #include <app/clusters/scenes-server/ScenesManagementCluster.h>
 #include <app/server/Server.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <filesystem>
-#include <unordered_map>
 #include "credentials/GroupDataProvider.h"
 
 using SceneTable = chip::scenes::SceneTable<chip::scenes::ExtensionFieldSetsImpl>;
@@ -56,15 +56,18 @@ private:
     uint16_t mEndpointTableSize = scenes::kMaxScenesPerEndpoint;
 };
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ScenesManagementCluster>> gServers;
-std::unordered_map<EndpointId, DefaultScenesManagementTableProvider> gTableProviders;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ScenesManagementCluster>>
+    gServers("scenes_management");
+esp_matter::data_model::cluster_instance_pool<DefaultScenesManagementTableProvider>
+    gTableProviders("scenes_management table providers");
 
 } // namespace
 
 ScenesManagementCluster *FindClusterOnEndpoint(EndpointId endpointId)
 {
-    if (gServers[endpointId].IsConstructed()) {
-        return &gServers[endpointId].Cluster();
+    auto *server = gServers.find(endpointId);
+    if (server != nullptr && server->IsConstructed()) {
+        return &server->Cluster();
     }
     return nullptr;
 }
@@ -187,24 +190,28 @@ esp_err_t GetScenesClusterContextParams(EndpointId endpointId, BitMask<ScenesMan
 
 void ESPMatterScenesManagementClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         BitMask<ScenesManagement::Feature> featureMap;
         bool supportsCopyScene;
         uint16_t tableSize;
         VerifyOrReturn(GetScenesClusterContextParams(endpointId, featureMap, supportsCopyScene, tableSize) == ESP_OK,
                        ChipLogError(AppServer, "Failed to get cluster context parameters"));
-        gTableProviders[endpointId].SetParameters(endpointId, tableSize);
-        gServers[endpointId].Create(endpointId,
+        auto *tableProvider = gTableProviders.emplace(endpointId);
+        VerifyOrReturn(tableProvider != nullptr);
+        tableProvider->SetParameters(endpointId, tableSize);
+        server->Create(endpointId,
         ScenesManagementCluster::Context{
             .groupDataProvider = Credentials::GetGroupDataProvider(),
             .fabricTable = &Server::GetInstance().GetFabricTable(),
             .features = featureMap,
-            .sceneTableProvider = gTableProviders[endpointId],
+            .sceneTableProvider = *tableProvider,
             .supportsCopyScene = supportsCopyScene,
         });
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register Scenes on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -213,21 +220,19 @@ void ESPMatterScenesManagementClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterScenesManagementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto serverIt = gServers.find(endpointId);
-    VerifyOrReturn(serverIt != gServers.end());
-    VerifyOrReturn(serverIt->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&serverIt->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister Scenes on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        serverIt->second.Destroy();
-        gServers.erase(serverIt);
-        auto tableProviderIt = gTableProviders.find(endpointId);
-        VerifyOrReturn(tableProviderIt != gTableProviders.end());
-        gTableProviders.erase(tableProviderIt);
+        server->Destroy();
+        gServers.erase(endpointId);
+        gTableProviders.erase(endpointId);
     }
 }
 
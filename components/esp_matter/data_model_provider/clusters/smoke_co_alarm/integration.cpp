@@ -20,10 +20,10 @@
 #include <clusters/SmokeCoAlarm/ClusterId.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -38,7 +38,7 @@ struct SmokeCoAlarmEndpoint {
     LazyRegisteredServerCluster<SmokeCoAlarmCluster> server;
 };
 
-std::unordered_map<EndpointId, SmokeCoAlarmEndpoint> gServers;
+esp_matter::data_model::cluster_instance_pool<SmokeCoAlarmEndpoint> gServers("smoke_co_alarm");
 
 } // namespace
 
@@ -47,8 +47,9 @@ void ESPMatterSmokeCoAlarmClusterServerInitCallback(EndpointId endpointId)
     VerifyOrReturn(cluster::get(endpointId, SmokeCoAlarm::Id) != nullptr,
                    ChipLogError(AppServer, "SmokeCoAlarm: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    auto &entry = gServers[endpointId];
-    if (!entry.server.IsConstructed()) {
+    auto *entry = gServers.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    if (!entry->server.IsConstructed()) {
         const uint32_t featureMap = read_feature_map_u32(endpointId, SmokeCoAlarm::Id);
 
         SmokeCoAlarmCluster::Config config;
@@ -78,10 +79,10 @@ void ESPMatterSmokeCoAlarmClusterServerInitCallback(EndpointId endpointId)
         }
         config.optionalAttribs = optAttribs;
 
-        entry.server.Create(endpointId, config);
+        entry->server.Create(endpointId, config);
     }
 
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(entry.server.Registration());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(entry->server.Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "SmokeCoAlarm register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -89,17 +90,17 @@ void ESPMatterSmokeCoAlarmClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterSmokeCoAlarmClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.server.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.server.Cluster(),
+    auto *entry = gServers.find(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    VerifyOrReturn(entry->server.IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&entry->server.Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "SmokeCoAlarm unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.server.Destroy();
-        gServers.erase(it);
+        entry->server.Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -112,9 +113,9 @@ namespace Clusters {
 
 void SetSmokeCoAlarmDefaultDelegate(EndpointId endpointId, SmokeCoAlarmDelegate * delegate)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end() && it->second.server.IsConstructed());
-    it->second.server.Cluster().SetDelegate(delegate);
+    auto *entry = gServers.find(endpointId);
+    VerifyOrReturn(entry != nullptr && entry->server.IsConstructed());
+    entry->server.Cluster().SetDelegate(delegate);
 }
 
 } // namespace Clusters
@@ -18,7 +18,7 @@
 #include <app/clusters/soil-measurement-server/SoilMeasurementCluster.h>
 #include <app/server-cluster/ServerClusterInterfaceRegistry.h>
 #include <clusters/SoilMeasurement/Attributes.h>
-#include <unordered_map>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include "support/CodeUtils.h"
 
 using namespace chip;
@@ -27,8 +27,10 @@ using namespace chip::app::Clusters;
 using namespace chip::app::Clusters::SoilMeasurement;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<SoilMeasurementCluster>> gServers;
-std::unordered_map<EndpointId, Attributes::SoilMoistureMeasurementLimits::TypeInfo::Type> gLimits;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<SoilMeasurementCluster>>
+    gServers("soil_measurement");
+esp_matter::data_model::cluster_instance_pool<Attributes::SoilMoistureMeasurementLimits::TypeInfo::Type>
+    gLimits("soil_measurement limits");
 } // namespace
 
 namespace chip::app::Clusters::SoilMeasurement {
@@ -37,31 +39,35 @@ CHIP_ERROR SetSoilMoistureMeasuredValue(
     EndpointId endpointId,
     const SoilMeasurement::Attributes::SoilMoistureMeasuredValue::TypeInfo::Type &soilMoistureMeasuredValue)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturnError(it != gServers.end(), CHIP_ERROR_NOT_FOUND);
-    VerifyOrReturnError(it->second.IsConstructed(), CHIP_ERROR_INCORRECT_STATE);
-    return it->second.Cluster().SetSoilMoistureMeasuredValue(soilMoistureMeasuredValue);
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturnError(server != nullptr, CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError(server->IsConstructed(), CHIP_ERROR_INCORRECT_STATE);
+    return server->Cluster().SetSoilMoistureMeasuredValue(soilMoistureMeasuredValue);
 }
 
 void SetSoilMoistureLimits(
     EndpointId endpointId,
     const SoilMeasurement::Attributes::SoilMoistureMeasurementLimits::TypeInfo::Type &soilMoistureLimits)
 {
-    auto [it, _] = gLimits.try_emplace(endpointId);
-    it->second = soilMoistureLimits;
+    auto *limits = gLimits.emplace(endpointId);
+    VerifyOrReturn(limits != nullptr);
+    *limits = soilMoistureLimits;
 }
 
 } // namespace chip::app::Clusters::SoilMeasurement
 
 void ESPMatterSoilMeasurementClusterServerInitCallback(EndpointId endpointId)
 {
-    if (!gServers[endpointId].IsConstructed()) {
-        VerifyOrDieWithMsg(gLimits.find(endpointId) != gLimits.end(), AppServer,
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
+        auto *limits = gLimits.find(endpointId);
+        VerifyOrDieWithMsg(limits != nullptr, AppServer,
                            "Please set the limit for SoilMeasurementCluster on Endpoint 0x%" PRIx16, endpointId);
-        gServers[endpointId].Create(endpointId, gLimits[endpointId]);
+        server->Create(endpointId, *limits);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register SoilMeasurement - Error: %" CHIP_ERROR_FORMAT, err.Format());
     }
@@ -69,19 +75,17 @@ void ESPMatterSoilMeasurementClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterSoilMeasurementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto serverIt = gServers.find(endpointId);
-    VerifyOrReturn(serverIt != gServers.end());
-    VerifyOrReturn(serverIt->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&serverIt->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "SoilMeasurement unregister error: %" CHIP_ERROR_FORMAT, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        serverIt->second.Destroy();
-        gServers.erase(serverIt);
-        auto limitIt = gLimits.find(endpointId);
-        VerifyOrReturn(limitIt != gLimits.end());
-        gLimits.erase(limitIt);
+        server->Destroy();
+        gServers.erase(endpointId);
+        gLimits.erase(endpointId);
     }
 }
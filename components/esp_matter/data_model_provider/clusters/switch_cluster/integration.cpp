@@ -19,11 +19,11 @@
 #include <clusters/Switch/Attributes.h>
 #include <clusters/Switch/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -33,7 +33,7 @@ using namespace esp_matter;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<SwitchCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<SwitchCluster>> gServers("switch_cluster");
 
 } // namespace
 
@@ -42,7 +42,9 @@ void ESPMatterSwitchClusterServerInitCallback(EndpointId endpointId)
     VerifyOrReturn(cluster::get(endpointId, Switch::Id) != nullptr,
                    ChipLogError(AppServer, "Switch: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         const uint32_t rawFeatureMap = read_feature_map_u32(endpointId, Switch::Id);
         BitFlags<Switch::Feature> features(rawFeatureMap);
 
@@ -58,10 +60,10 @@ void ESPMatterSwitchClusterServerInitCallback(EndpointId endpointId)
 
         SwitchCluster::StartupConfiguration startupConfig{ .numberOfPositions = numberOfPositions, .multiPressMax = multiPressMax };
 
-        gServers[endpointId].Create(endpointId, features, startupConfig);
+        server->Create(endpointId, features, startupConfig);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Switch cluster register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -69,17 +71,17 @@ void ESPMatterSwitchClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterSwitchClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Switch cluster unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -92,10 +94,10 @@ namespace Switch {
 
 SwitchCluster * FindClusterOnEndpoint(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturnValue(it != gServers.end(), nullptr);
-    VerifyOrReturnValue(it->second.IsConstructed(), nullptr);
-    return &it->second.Cluster();
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturnValue(server != nullptr, nullptr);
+    VerifyOrReturnValue(server->IsConstructed(), nullptr);
+    return &server->Cluster();
 }
 
 } // namespace Switch
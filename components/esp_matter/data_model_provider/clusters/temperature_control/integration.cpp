@@ -21,11 +21,11 @@
 #include <clusters/TemperatureControl/Attributes.h>
 #include <clusters/TemperatureControl/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -35,7 +35,8 @@ using namespace esp_matter;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<TemperatureControlCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<TemperatureControlCluster>>
+    gServers("temperature_control");
 
 } // namespace
 
@@ -46,7 +47,9 @@ void ESPMatterTemperatureControlClusterServerInitCallback(EndpointId endpointId)
                    ChipLogError(AppServer,
                                 "TemperatureControl: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         const uint32_t rawFeatureMap = read_feature_map_u32(endpointId, TemperatureControl::Id);
         BitFlags<TemperatureControl::Feature> features(rawFeatureMap);
 
@@ -87,10 +90,10 @@ void ESPMatterTemperatureControlClusterServerInitCallback(EndpointId endpointId)
                                                                        .step                     = step,
                                                                        .selectedTemperatureLevel = selectedTemperatureLevel };
 
-        gServers[endpointId].Create(endpointId, features, startupConfig);
+        server->Create(endpointId, features, startupConfig);
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "TemperatureControl register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -98,17 +101,17 @@ void ESPMatterTemperatureControlClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterTemperatureControlClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "TemperatureControl unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
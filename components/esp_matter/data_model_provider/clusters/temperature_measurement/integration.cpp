@@ -18,10 +18,10 @@
 #include <app/clusters/temperature-measurement-server/TemperatureMeasurementCluster.h>
 #include <clusters/TemperatureMeasurement/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/CodeUtils.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -32,18 +32,19 @@ using namespace chip::Protocols::InteractionModel;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<TemperatureMeasurementCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<TemperatureMeasurementCluster>>
+    gServers("temperature_measurement");
 } // namespace
 
 namespace chip::app::Clusters::TemperatureMeasurement {
 
 TemperatureMeasurementCluster * FindClusterOnEndpoint(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return nullptr;
     }
-    return &it->second.Cluster();
+    return &server->Cluster();
 }
 
 CHIP_ERROR SetMeasuredValue(EndpointId endpointId, DataModel::Nullable<int16_t> measuredValue)
@@ -60,7 +61,9 @@ void ESPMatterTemperatureMeasurementClusterServerInitCallback(EndpointId endpoin
     VerifyOrReturn(cluster::get(endpointId, TemperatureMeasurement::Id) != nullptr,
                    ChipLogError(AppServer, "TemperatureMeasurement: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         TemperatureMeasurementCluster::OptionalAttributeSet optionalAttributeSet(0);
         if (endpoint::is_attribute_enabled(endpointId, TemperatureMeasurement::Id, Tolerance::Id)) {
             optionalAttributeSet.Set<Tolerance::Id>();
@@ -81,14 +84,14 @@ void ESPMatterTemperatureMeasurementClusterServerInitCallback(EndpointId endpoin
             VerifyOrDie(Tolerance::GetDefault(endpointId, &tolerance) == Status::Success);
         }
 
-        gServers[endpointId].Create(
+        server->Create(
             endpointId, optionalAttributeSet,
             TemperatureMeasurementCluster::StartupConfiguration{ .minMeasuredValue = minMeasuredValue,
                                                                  .maxMeasuredValue = maxMeasuredValue,
                                                                  .tolerance        = tolerance });
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "TemperatureMeasurement register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -97,17 +100,17 @@ void ESPMatterTemperatureMeasurementClusterServerInitCallback(EndpointId endpoin
 void ESPMatterTemperatureMeasurementClusterServerShutdownCallback(EndpointId endpointId,
                                                                   ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "TemperatureMeasurement unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
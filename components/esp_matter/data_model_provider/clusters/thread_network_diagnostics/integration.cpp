@@ -20,11 +20,11 @@
 #include <app/server-cluster/ServerClusterInterfaceRegistry.h>
 #include <clusters/ThreadNetworkDiagnostics/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -33,7 +33,8 @@ using namespace esp_matter;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ThreadNetworkDiagnosticsCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ThreadNetworkDiagnosticsCluster>>
+    gServers("thread_network_diagnostics");
 
 ThreadNetworkDiagnostics::DirectThreadNetworkDiagnosticsProvider  &GetDirectProvider()
 {
@@ -48,18 +49,20 @@ void ESPMatterThreadNetworkDiagnosticsClusterServerInitCallback(EndpointId endpo
     VerifyOrReturn(cluster::get(endpointId, ThreadNetworkDiagnostics::Id) != nullptr,
                    ChipLogError(AppServer, "ThreadNetworkDiagnostics: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         const uint32_t rawFeatureMap = read_feature_map_u32(endpointId, ThreadNetworkDiagnostics::Id);
         VerifyOrDie(rawFeatureMap == 0 || rawFeatureMap == ThreadNetworkDiagnostics::kFeaturesAll.Raw());
 
         const auto cluster_type = rawFeatureMap == 0 ? ThreadNetworkDiagnosticsCluster::ClusterType::kMinimal
                                   : ThreadNetworkDiagnosticsCluster::ClusterType::kFull;
 
-        gServers[endpointId].Create(endpointId, cluster_type, GetDirectProvider());
+        server->Create(endpointId, cluster_type, GetDirectProvider());
     }
 
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
                      "Failed to register ThreadNetworkDiagnostics on endpoint %u - Error: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
@@ -69,10 +72,10 @@ void ESPMatterThreadNetworkDiagnosticsClusterServerInitCallback(EndpointId endpo
 void ESPMatterThreadNetworkDiagnosticsClusterServerShutdownCallback(EndpointId endpointId,
                                                                     ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer,
@@ -80,8 +83,8 @@ void ESPMatterThreadNetworkDiagnosticsClusterServerShutdownCallback(EndpointId e
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
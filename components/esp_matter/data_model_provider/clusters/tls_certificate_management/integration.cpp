@@ -21,12 +21,12 @@
 #include <app/server/Server.h>
 #include <clusters/TlsCertificateManagement/Attributes.h>
 #include <data_model/esp_matter_attribute_helpers.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -43,28 +43,27 @@ struct EndpointState {
     LazyRegisteredServerCluster<TLSCertificateManagementCluster> cluster;
 };
 
-std::unordered_map<EndpointId, EndpointState> gState;
+esp_matter::data_model::cluster_instance_pool<EndpointState> gState("tls_certificate_management state");
 
 } // namespace
 
 void ESPMatterTlsCertificateManagementClusterServerInitCallback(EndpointId endpointId)
 {
-    auto it = gState.find(endpointId);
-    if (it == gState.end() || it->second.delegate == nullptr) {
+    auto *state = gState.find(endpointId);
+    if (state == nullptr || state->delegate == nullptr) {
         ChipLogError(AppServer, "TlsCertificateManagement: no delegate set for endpoint %u — call SetDelegate() first",
                      endpointId);
         return;
     }
-    if (it->second.dependencyChecker == nullptr) {
+    if (state->dependencyChecker == nullptr) {
         ChipLogError(AppServer,
                      "TlsCertificateManagement: no dependency checker set for endpoint %u — call SetDependencyChecker() first",
                      endpointId);
         return;
     }
-    auto &state = it->second;
 
-    if (!state.cluster.IsConstructed()) {
-        Tls::CertificateTableImpl &certTable = state.certTable ? *state.certTable : state.defaultCertTable;
+    if (!state->cluster.IsConstructed()) {
+        Tls::CertificateTableImpl &certTable = state->certTable ? *state->certTable : state->defaultCertTable;
 
         LogErrorOnFailure(certTable.SetEndpoint(endpointId));
 
@@ -76,11 +75,12 @@ void ESPMatterTlsCertificateManagementClusterServerInitCallback(EndpointId endpo
                                              Attributes::MaxClientCertificates::Id, maxClientCerts);
 
         TLSCertificateManagementCluster::Context context{ Server::GetInstance().GetFabricTable() };
-        state.cluster.Create(context, endpointId, *state.delegate, *state.dependencyChecker, certTable,
+        state->cluster.Create(context, endpointId, *state->delegate, *state->dependencyChecker, certTable,
                              maxRootCerts, maxClientCerts);
     }
 
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(state.cluster.Registration());
+    CHIP_ERROR err =
+        esp_matter::data_model::provider::get_instance().registry().Register(state->cluster.Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "TlsCertificateManagement: Register failed on endpoint %u: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -89,15 +89,15 @@ void ESPMatterTlsCertificateManagementClusterServerInitCallback(EndpointId endpo
 
 void ESPMatterTlsCertificateManagementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gState.find(endpointId);
-    VerifyOrReturn(it != gState.end());
-    VerifyOrReturn(it->second.cluster.IsConstructed());
+    auto *state = gState.find(endpointId);
+    VerifyOrReturn(state != nullptr);
+    VerifyOrReturn(state->cluster.IsConstructed());
 
-    LogErrorOnFailure(
-        esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.cluster.Cluster(), shutdownType));
+    LogErrorOnFailure(esp_matter::data_model::provider::get_instance().registry().Unregister(&state->cluster.Cluster(),
+                                                                                             shutdownType));
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.cluster.Destroy();
-        gState.erase(it);
+        state->cluster.Destroy();
+        gState.erase(endpointId);
     }
 }
 
@@ -107,17 +107,23 @@ namespace chip::app::Clusters::TlsCertificateManagement {
 
 void SetDelegate(EndpointId endpointId, TLSCertificateManagementDelegate &delegate)
 {
-    gState[endpointId].delegate = &delegate;
+    auto *state = gState.emplace(endpointId);
+    VerifyOrReturn(state != nullptr);
+    state->delegate = &delegate;
 }
 
 void SetDependencyChecker(EndpointId endpointId, Tls::CertificateDependencyChecker &checker)
 {
-    gState[endpointId].dependencyChecker = &checker;
+    auto *state = gState.emplace(endpointId);
+    VerifyOrReturn(state != nullptr);
+    state->dependencyChecker = &checker;
 }
 
 void SetCertificateTable(EndpointId endpointId, Tls::CertificateTableImpl &certificate_table)
 {
-    gState[endpointId].certTable = &certificate_table;
+    auto *state = gState.emplace(endpointId);
+    VerifyOrReturn(state != nullptr);
+    state->certTable = &certificate_table;
 }
 
 } // namespace chip::app::Clusters::TlsCertificateManagement
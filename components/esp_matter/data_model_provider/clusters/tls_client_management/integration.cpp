@@ -20,12 +20,12 @@
 #include <app/server/Server.h>
 #include <clusters/TlsClientManagement/Attributes.h>
 #include <data_model/esp_matter_attribute_helpers.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -41,22 +41,21 @@ struct EndpointState {
     LazyRegisteredServerCluster<TLSClientManagementCluster> cluster;
 };
 
-std::unordered_map<EndpointId, EndpointState> gState;
+esp_matter::data_model::cluster_instance_pool<EndpointState> gState("tls_client_management state");
 
 } // namespace
 
 void ESPMatterTlsClientManagementClusterServerInitCallback(EndpointId endpointId)
 {
-    auto it = gState.find(endpointId);
-    if (it == gState.end() || it->second.delegate == nullptr) {
+    auto *state = gState.find(endpointId);
+    if (state == nullptr || state->delegate == nullptr) {
         ChipLogError(AppServer, "TlsClientManagement: no delegate set for endpoint %u — call SetDelegate() first",
                      endpointId);
         return;
     }
-    auto &state = it->second;
 
-    if (!state.cluster.IsConstructed()) {
-        Tls::CertificateTableImpl &certTable = state.certTable ? *state.certTable : state.defaultCertTable;
+    if (!state->cluster.IsConstructed()) {
+        Tls::CertificateTableImpl &certTable = state->certTable ? *state->certTable : state->defaultCertTable;
 
         LogErrorOnFailure(certTable.SetEndpoint(endpointId));
 
@@ -64,10 +63,11 @@ void ESPMatterTlsClientManagementClusterServerInitCallback(EndpointId endpointId
         esp_matter::read_attribute_raw_value(endpointId, TlsClientManagement::Id, Attributes::MaxProvisioned::Id, maxProvisioned);
 
         TLSClientManagementCluster::Context context{ Server::GetInstance().GetFabricTable() };
-        state.cluster.Create(context, endpointId, *state.delegate, certTable, maxProvisioned);
+        state->cluster.Create(context, endpointId, *state->delegate, certTable, maxProvisioned);
     }
 
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(state.cluster.Registration());
+    CHIP_ERROR err =
+        esp_matter::data_model::provider::get_instance().registry().Register(state->cluster.Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "TlsClientManagement: Register failed on endpoint %u: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -76,15 +76,15 @@ void ESPMatterTlsClientManagementClusterServerInitCallback(EndpointId endpointId
 
 void ESPMatterTlsClientManagementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gState.find(endpointId);
-    VerifyOrReturn(it != gState.end());
-    VerifyOrReturn(it->second.cluster.IsConstructed());
+    auto *state = gState.find(endpointId);
+    VerifyOrReturn(state != nullptr);
+    VerifyOrReturn(state->cluster.IsConstructed());
 
-    LogErrorOnFailure(
-        esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.cluster.Cluster(), shutdownType));
+    LogErrorOnFailure(esp_matter::data_model::provider::get_instance().registry().Unregister(&state->cluster.Cluster(),
+                                                                                             shutdownType));
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.cluster.Destroy();
-        gState.erase(it);
+        state->cluster.Destroy();
+        gState.erase(endpointId);
     }
 }
 
@@ -94,12 +94,16 @@ namespace chip::app::Clusters::TlsClientManagement {
 
 void SetDelegate(EndpointId endpointId, TLSClientManagementDelegate &delegate)
 {
-    gState[endpointId].delegate = &delegate;
+    auto *state = gState.emplace(endpointId);
+    VerifyOrReturn(state != nullptr);
+    state->delegate = &delegate;
 }
 
 void SetCertificateTable(EndpointId endpointId, Tls::CertificateTableImpl &certificate_table)
 {
-    gState[endpointId].certTable = &certificate_table;
+    auto *state = gState.emplace(endpointId);
+    VerifyOrReturn(state != nullptr);
+    state->certTable = &certificate_table;
 }
 
 } // namespace chip::app::Clusters::TlsClientManagement
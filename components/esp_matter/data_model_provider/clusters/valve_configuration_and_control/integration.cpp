@@ -20,11 +20,11 @@
 #include <clusters/ValveConfigurationAndControl/Attributes.h>
 #include <clusters/ValveConfigurationAndControl/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -34,7 +34,8 @@ using namespace esp_matter;
 
 namespace {
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ValveConfigurationAndControlCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ValveConfigurationAndControlCluster>>
+    gServers("valve_configuration_and_control");
 
 DataModel::Nullable<uint32_t> ReadNullableU32(EndpointId endpointId, AttributeId attributeId)
 {
@@ -89,7 +90,9 @@ void ESPMatterValveConfigurationAndControlClusterServerInitCallback(EndpointId e
                    ChipLogError(AppServer,
                                 "ValveConfigurationAndControl: cluster missing in esp-matter data model for endpoint %u",
                                 endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         const uint32_t featureMap = read_feature_map_u32(endpointId, ValveConfigurationAndControl::Id);
         const auto optionalSet    = BuildOptionalSet(endpointId);
 
@@ -111,10 +114,10 @@ void ESPMatterValveConfigurationAndControlClusterServerInitCallback(EndpointId e
             .delegate             = nullptr,
         };
 
-        gServers[endpointId].Create(endpointId, context);
+        server->Create(endpointId, context);
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ValveConfigurationAndControl register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
@@ -124,18 +127,18 @@ void ESPMatterValveConfigurationAndControlClusterServerInitCallback(EndpointId e
 void ESPMatterValveConfigurationAndControlClusterServerShutdownCallback(EndpointId endpointId,
                                                                         ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ValveConfigurationAndControl unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId,
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -148,9 +151,9 @@ namespace ValveConfigurationAndControl {
 
 void SetDefaultDelegate(EndpointId endpointId, Delegate * delegate)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end() && it->second.IsConstructed());
-    it->second.Cluster().SetDelegate(delegate);
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr && server->IsConstructed());
+    server->Cluster().SetDelegate(delegate);
 }
 
 } // namespace ValveConfigurationAndControl
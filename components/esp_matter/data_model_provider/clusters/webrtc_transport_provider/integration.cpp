@@ -16,7 +16,7 @@
 #include <app/ClusterCallbacks.h>
 #include <data_model/esp_matter_data_model.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
-#include <unordered_map>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include "integration.h"
 
 using namespace chip;
@@ -26,8 +26,10 @@ using namespace chip::app::Clusters::WebRTCTransportProvider;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<WebRTCTransportProviderCluster>> gServers;
-std::unordered_map<EndpointId, Clusters::WebRTCTransportProvider::Delegate *> gDelegates;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<WebRTCTransportProviderCluster>>
+    gServers("webrtc_transport_provider");
+esp_matter::data_model::cluster_instance_pool<Clusters::WebRTCTransportProvider::Delegate *>
+    gDelegates("webrtc_transport_provider delegates");
 
 bool IsClusterEnabled(EndpointId endpointId)
 {
@@ -40,15 +42,17 @@ namespace chip::app::Clusters::WebRTCTransportProvider {
 
 void SetDelegate(EndpointId endpointId, Delegate * delegate)
 {
-    gDelegates[endpointId] = delegate;
+    auto *entry = gDelegates.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    *entry = delegate;
 }
 
 WebRTCTransportProviderCluster * GetServer(EndpointId endpointId)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturnValue(it != gServers.end(), nullptr);
-    VerifyOrReturnValue(it->second.IsConstructed(), nullptr);
-    return &it->second.Cluster();
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturnValue(server != nullptr, nullptr);
+    VerifyOrReturnValue(server->IsConstructed(), nullptr);
+    return &server->Cluster();
 }
 
 } // namespace chip::app::Clusters::WebRTCTransportProvider
@@ -59,17 +63,20 @@ void ESPMatterWebRTCTransportProviderClusterServerInitCallback(EndpointId endpoi
         ChipLogError(AppServer, "WebRTC Transport Provider cluster not enabled for endpoint %u", endpointId);
         return;
     }
-    if (!gServers[endpointId].IsConstructed()) {
-        if (gDelegates[endpointId] == nullptr) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
+        auto *delegate = gDelegates.find(endpointId);
+        if (delegate == nullptr || *delegate == nullptr) {
             ChipLogError(AppServer, "WebRTC Transport Provider delegate missing for endpoint %u", endpointId);
             return;
         }
 
         ChipLogProgress(AppServer, "Registering WebRTC Transport Provider on endpoint %u", endpointId);
-        gServers[endpointId].Create(endpointId, *gDelegates[endpointId]);
+        server->Create(endpointId, **delegate);
     }
 
-    CHIP_ERROR err = data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+    CHIP_ERROR err = data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register WebRTC Transport Provider on endpoint %u - Error: %" CHIP_ERROR_FORMAT,
                      endpointId, err.Format());
@@ -78,18 +85,18 @@ void ESPMatterWebRTCTransportProviderClusterServerInitCallback(EndpointId endpoi
 
 void ESPMatterWebRTCTransportProviderClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto serverIt = gServers.find(endpointId);
-    VerifyOrReturn(serverIt != gServers.end());
-    VerifyOrReturn(serverIt->second.IsConstructed());
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
 
-    CHIP_ERROR err = data_model::provider::get_instance().registry().Unregister(&serverIt->second.Cluster(), shutdownType);
+    CHIP_ERROR err = data_model::provider::get_instance().registry().Unregister(&server->Cluster(), shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister WebRTC Transport Provider on endpoint %u - Error: %" CHIP_ERROR_FORMAT,
                      endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        serverIt->second.Destroy();
-        gServers.erase(serverIt);
+        server->Destroy();
+        gServers.erase(endpointId);
         gDelegates.erase(endpointId);
     }
 }
@@ -19,10 +19,10 @@
 #include <app/server-cluster/ServerClusterInterfaceRegistry.h>
 #include <clusters/WiFiNetworkDiagnostics/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -30,7 +30,8 @@ using namespace chip::app::Clusters;
 using namespace esp_matter;
 
 namespace {
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<WiFiDiagnosticsServerCluster>> gServers;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<WiFiDiagnosticsServerCluster>>
+    gServers("wifi_network_diagnostic");
 
 bool IsClusterEnabled(EndpointId endpointId)
 {
@@ -48,7 +49,9 @@ bool IsAttributeEnabled(EndpointId endpointId, AttributeId attributeId)
 void ESPMatterWiFiNetworkDiagnosticsClusterServerInitCallback(EndpointId endpointId)
 {
     VerifyOrReturn(IsClusterEnabled(endpointId));
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         WiFiDiagnosticsServerCluster::OptionalAttributeSet attrSet;
         if (IsAttributeEnabled(endpointId, WiFiNetworkDiagnostics::Attributes::CurrentMaxRate::Id)) {
             attrSet.Set<WiFiNetworkDiagnostics::Attributes::CurrentMaxRate::Id>();
@@ -57,12 +60,12 @@ void ESPMatterWiFiNetworkDiagnosticsClusterServerInitCallback(EndpointId endpoin
         // NOTE: Currently, diagnostics only support a single provider (DeviceLayer::GetDiagnosticDataProvider())
         // and do not properly support secondary network interfaces or per-endpoint diagnostics.
         // See issue:#40317
-        gServers[endpointId].Create(endpointId, DeviceLayer::GetDiagnosticDataProvider(), attrSet,
+        server->Create(endpointId, DeviceLayer::GetDiagnosticDataProvider(), attrSet,
                                     BitFlags<WiFiNetworkDiagnostics::Feature>(
                                         read_feature_map_u32(endpointId, WiFiNetworkDiagnostics::Id)));
     }
     CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Register(
-                         gServers[endpointId].Registration());
+                         server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to register WiFiNetworkDiagnostics on endpoint %u - Error: %" CHIP_ERROR_FORMAT,
                      endpointId,
@@ -75,10 +78,10 @@ void ESPMatterWiFiNetworkDiagnosticsClusterServerShutdownCallback(EndpointId end
                                                                   ClusterShutdownType shutdownType)
 {
     VerifyOrReturn(IsClusterEnabled(endpointId));
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it != gServers.end());
-    VerifyOrReturn(it->second.IsConstructed());
-    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server != nullptr);
+    VerifyOrReturn(server->IsConstructed());
+    CHIP_ERROR err = esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(),
                                                                                             shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "Failed to unregister WiFiNetworkDiagnostics on endpoint %u - Error: %" CHIP_ERROR_FORMAT,
@@ -86,8 +89,8 @@ void ESPMatterWiFiNetworkDiagnosticsClusterServerShutdownCallback(EndpointId end
                      err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -21,11 +21,11 @@
 #include <app/clusters/zone-management-server/ZoneManagementCluster.h>
 #include <clusters/ZoneManagement/ClusterId.h>
 #include <data_model/esp_matter_data_model.h>
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <data_model/esp_matter_attribute_helpers.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <unordered_map>
 
 using namespace chip;
 using namespace chip::app;
@@ -42,10 +42,11 @@ struct ZoneManagementConfig {
     TwoDCartesianVertexStruct twoDCartesianMax{};
 };
 
-std::unordered_map<EndpointId, LazyRegisteredServerCluster<ZoneManagementCluster>> gServers;
-std::unordered_map<EndpointId, Delegate *> gDelegates;
-std::unordered_map<EndpointId, ZoneManagementConfig> gConfigs;
-std::unordered_map<EndpointId, BitFlags<Feature>> gFeatures;
+esp_matter::data_model::cluster_instance_pool<LazyRegisteredServerCluster<ZoneManagementCluster>>
+    gServers("zone_management");
+esp_matter::data_model::cluster_instance_pool<Delegate *> gDelegates("zone_management delegates");
+esp_matter::data_model::cluster_instance_pool<ZoneManagementConfig> gConfigs("zone_management configs");
+esp_matter::data_model::cluster_instance_pool<BitFlags<Feature>> gFeatures("zone_management features");
 
 } // namespace
 
@@ -56,19 +57,23 @@ namespace ZoneManagement {
 
 void MatterZoneManagementSetDelegate(EndpointId endpointId, Delegate *delegate)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it == gServers.end() || !it->second.IsConstructed(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server == nullptr || !server->IsConstructed(),
                    ChipLogError(AppServer, "ZoneManagement: cluster already initialized; cannot set delegate"));
-    gDelegates[endpointId] = delegate;
+    auto *entry = gDelegates.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    *entry = delegate;
 }
 
 void MatterZoneManagementSetConfig(EndpointId endpointId, uint8_t maxUserDefinedZones, uint8_t maxZones,
                                    uint8_t sensitivityMax, const TwoDCartesianVertexStruct &twoDCartesianMax)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it == gServers.end() || !it->second.IsConstructed(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server == nullptr || !server->IsConstructed(),
                    ChipLogError(AppServer, "ZoneManagement: cluster already initialized; cannot set config"));
-    gConfigs[endpointId] = ZoneManagementConfig{
+    auto *config = gConfigs.emplace(endpointId);
+    VerifyOrReturn(config != nullptr);
+    *config = ZoneManagementConfig{
         .maxUserDefinedZones = maxUserDefinedZones,
         .maxZones            = maxZones,
         .sensitivityMax      = sensitivityMax,
@@ -78,10 +83,12 @@ void MatterZoneManagementSetConfig(EndpointId endpointId, uint8_t maxUserDefined
 
 void MatterZoneManagementSetFeatures(EndpointId endpointId, BitFlags<Feature> features)
 {
-    auto it = gServers.find(endpointId);
-    VerifyOrReturn(it == gServers.end() || !it->second.IsConstructed(),
+    auto *server = gServers.find(endpointId);
+    VerifyOrReturn(server == nullptr || !server->IsConstructed(),
                    ChipLogError(AppServer, "ZoneManagement: cluster already initialized; cannot set features"));
-    gFeatures[endpointId] = features;
+    auto *entry = gFeatures.emplace(endpointId);
+    VerifyOrReturn(entry != nullptr);
+    *entry = features;
 }
 
 } // namespace ZoneManagement
@@ -96,33 +103,35 @@ void ESPMatterZoneManagementClusterServerInitCallback(EndpointId endpointId)
                    ChipLogError(AppServer,
                                 "ZoneManagement: cluster missing in esp-matter data model for endpoint %u", endpointId));
 
-    if (!gServers[endpointId].IsConstructed()) {
+    auto *server = gServers.emplace(endpointId);
+    VerifyOrReturn(server != nullptr);
+    if (!server->IsConstructed()) {
         Delegate *delegate = nullptr;
         {
-            auto it = gDelegates.find(endpointId);
-            VerifyOrReturn(it != gDelegates.end() && it->second != nullptr,
+            auto *entry = gDelegates.find(endpointId);
+            VerifyOrReturn(entry != nullptr && *entry != nullptr,
                            ChipLogError(AppServer,
                                         "ZoneManagement: delegate not set for ep %u "
                                         "(call MatterZoneManagementSetDelegate first)",
                                         endpointId));
-            delegate = it->second;
+            delegate = *entry;
         }
 
         BitFlags<Feature> features;
-        auto featIt = gFeatures.find(endpointId);
-        if (featIt != gFeatures.end()) {
-            features = featIt->second;
+        auto *featEntry = gFeatures.find(endpointId);
+        if (featEntry != nullptr) {
+            features = *featEntry;
         } else {
             features = BitFlags<Feature>(read_feature_map_u32(endpointId, ZoneManagement::Id));
         }
 
         ZoneManagementConfig config;
-        auto cfgIt = gConfigs.find(endpointId);
-        if (cfgIt != gConfigs.end()) {
-            config = cfgIt->second;
+        auto *cfgEntry = gConfigs.find(endpointId);
+        if (cfgEntry != nullptr) {
+            config = *cfgEntry;
         }
 
-        gServers[endpointId].Create(ZoneManagementCluster::Context{
+        server->Create(ZoneManagementCluster::Context{
             .delegate   = *delegate,
             .endpointId = endpointId,
             .features   = features,
@@ -136,7 +145,7 @@ void ESPMatterZoneManagementClusterServerInitCallback(EndpointId endpointId)
     }
 
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Register(gServers[endpointId].Registration());
+        esp_matter::data_model::provider::get_instance().registry().Register(server->Registration());
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ZoneManagement register failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
@@ -144,18 +153,18 @@ void ESPMatterZoneManagementClusterServerInitCallback(EndpointId endpointId)
 
 void ESPMatterZoneManagementClusterServerShutdownCallback(EndpointId endpointId, ClusterShutdownType shutdownType)
 {
-    auto it = gServers.find(endpointId);
-    if (it == gServers.end() || !it->second.IsConstructed()) {
+    auto *server = gServers.find(endpointId);
+    if (server == nullptr || !server->IsConstructed()) {
         return;
     }
     CHIP_ERROR err =
-        esp_matter::data_model::provider::get_instance().registry().Unregister(&it->second.Cluster(), shutdownType);
+        esp_matter::data_model::provider::get_instance().registry().Unregister(&server->Cluster(), shutdownType);
     if (err != CHIP_NO_ERROR) {
         ChipLogError(AppServer, "ZoneManagement unregister failed ep %u: %" CHIP_ERROR_FORMAT, endpointId, err.Format());
     }
     if (shutdownType == ClusterShutdownType::kPermanentRemove) {
-        it->second.Destroy();
-        gServers.erase(it);
+        server->Destroy();
+        gServers.erase(endpointId);
     }
 }
 
@@ -0,0 +1,119 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <string.h>
+
+namespace esp_matter {
+namespace data_model {
+
+static const char *TAG = "cluster_pool";
+
+static cluster_instance_pool_base *s_pools = nullptr;
+
+size_t cluster_instance_pool_base::lower_bound(chip::EndpointId endpoint_id) const
+{
+    size_t low = 0, high = m_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (m_endpoint_ids[mid] < endpoint_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void *cluster_instance_pool_base::find_instance(chip::EndpointId endpoint_id) const
+{
+    size_t index = lower_bound(endpoint_id);
+    return index < m_count && m_endpoint_ids[index] == endpoint_id ? m_instances[index] : nullptr;
+}
+
+void *cluster_instance_pool_base::allocate(chip::EndpointId endpoint_id)
+{
+    if (!m_endpoint_ids) {
+        // Both arrays in a single allocation, with the pointers first for their alignment
+        void *index = esp_matter_mem_calloc(k_cluster_instance_pool_capacity,
+                                            sizeof(void *) + sizeof(chip::EndpointId));
+        if (!index) {
+            ESP_LOGE(TAG, "Failed to allocate the index of %s", m_name);
+            return nullptr;
+        }
+        m_instances = static_cast<void **>(index);
+        m_endpoint_ids = reinterpret_cast<chip::EndpointId *>(m_instances + k_cluster_instance_pool_capacity);
+        m_next = s_pools;
+        s_pools = this;
+    }
+    if (m_count == k_cluster_instance_pool_capacity) {
+        ESP_LOGE(TAG, "%s is full, cannot add endpoint %u", m_name, endpoint_id);
+        return nullptr;
+    }
+    void *storage = esp_matter_mem_calloc(1, m_object_size);
+    if (!storage) {
+        ESP_LOGE(TAG, "Failed to allocate %s for endpoint %u", m_name, endpoint_id);
+        return nullptr;
+    }
+    size_t index = lower_bound(endpoint_id);
+    memmove(&m_endpoint_ids[index + 1], &m_endpoint_ids[index], (m_count - index) * sizeof(chip::EndpointId));
+    memmove(&m_instances[index + 1], &m_instances[index], (m_count - index) * sizeof(void *));
+    m_endpoint_ids[index] = endpoint_id;
+    m_instances[index] = storage;
+    m_count++;
+    if (m_count > m_high_water_mark) {
+        m_high_water_mark = m_count;
+    }
+    return storage;
+}
+
+void *cluster_instance_pool_base::release(chip::EndpointId endpoint_id)
+{
+    size_t index = lower_bound(endpoint_id);
+    if (index == m_count || m_endpoint_ids[index] != endpoint_id) {
+        return nullptr;
+    }
+    void *storage = m_instances[index];
+    m_count--;
+    memmove(&m_endpoint_ids[index], &m_endpoint_ids[index + 1], (m_count - index) * sizeof(chip::EndpointId));
+    memmove(&m_instances[index], &m_instances[index + 1], (m_count - index) * sizeof(void *));
+    return storage;
+}
+
+void cluster_instance_pool_base::free_storage(void *storage)
+{
+    esp_matter_mem_free(storage);
+}
+
+size_t get_cluster_instance_pool_stats(cluster_instance_pool_stats_t *stats, size_t max_count)
+{
+    size_t count = 0;
+    for (cluster_instance_pool_base *pool = s_pools; pool; pool = pool->m_next, ++count) {
+        if (!stats || count >= max_count) {
+            continue;
+        }
+        stats[count].name = pool->m_name;
+        stats[count].object_size = pool->m_object_size;
+        stats[count].in_use = pool->m_count;
+        stats[count].high_water_mark = pool->m_high_water_mark;
+        stats[count].heap_bytes = pool->m_count * pool->m_object_size +
+                                  k_cluster_instance_pool_capacity * (sizeof(void *) + sizeof(chip::EndpointId));
+    }
+    return count;
+}
+
+} // namespace data_model
+} // namespace esp_matter
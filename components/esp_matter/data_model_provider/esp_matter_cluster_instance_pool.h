@@ -0,0 +1,148 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <zap-generated/endpoint_config.h>
+
+namespace esp_matter {
+namespace data_model {
+
+/** Maximum number of instances of a cluster instance pool, one per endpoint */
+constexpr size_t k_cluster_instance_pool_capacity = CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT + FIXED_ENDPOINT_COUNT;
+
+/** Usage of a cluster instance pool */
+typedef struct {
+    /** Name of the pool */
+    const char *name;
+    /** Size of one instance */
+    size_t object_size;
+    /** Number of instances currently allocated */
+    size_t in_use;
+    /** Maximum number of instances allocated at the same time */
+    size_t high_water_mark;
+    /** Bytes of heap currently used by the pool, including its index */
+    size_t heap_bytes;
+} cluster_instance_pool_stats_t;
+
+/** Get the usage of the cluster instance pools
+ *
+ * Only the pools which had at least one instance are reported.
+ *
+ * @param[out] stats array of usages, can be NULL to count the pools.
+ * @param[in] max_count number of elements of the array.
+ *
+ * @return the number of pools, which can be more than max_count.
+ */
+size_t get_cluster_instance_pool_stats(cluster_instance_pool_stats_t *stats, size_t max_count);
+
+/** Non-template part of cluster_instance_pool
+ *
+ * The index is a sorted array of endpoint IDs with the matching instances, allocated with the capacity of the pool
+ * when the first instance is created. So looking up an endpoint is a binary search without hashing, the index never
+ * rehashes, and each instance is a single allocation.
+ */
+class cluster_instance_pool_base {
+public:
+    size_t size() const
+    {
+        return m_count;
+    }
+
+protected:
+    constexpr cluster_instance_pool_base(const char *name, size_t object_size)
+        : m_name(name), m_object_size(object_size) {}
+
+    void *find_instance(chip::EndpointId endpoint_id) const;
+    // Allocate the storage of the instance of an endpoint which has none, nullptr if the pool is full
+    void *allocate(chip::EndpointId endpoint_id);
+    // Remove the instance of the endpoint from the index and return its storage, nullptr if there is none
+    void *release(chip::EndpointId endpoint_id);
+    void free_storage(void *storage);
+
+    chip::EndpointId endpoint_at(size_t index) const
+    {
+        return m_endpoint_ids[index];
+    }
+    void *instance_at(size_t index) const
+    {
+        return m_instances[index];
+    }
+
+private:
+    friend size_t get_cluster_instance_pool_stats(cluster_instance_pool_stats_t *stats, size_t max_count);
+
+    size_t lower_bound(chip::EndpointId endpoint_id) const;
+
+    const char *m_name;
+    size_t m_object_size;
+    chip::EndpointId *m_endpoint_ids = nullptr;
+    void **m_instances = nullptr;
+    uint16_t m_count = 0;
+    uint16_t m_high_water_mark = 0;
+    // Pools are linked once they have allocated their index
+    cluster_instance_pool_base *m_next = nullptr;
+};
+
+/** Instances of a server cluster, or of its per-endpoint state, by endpoint
+ *
+ * Replaces the std::unordered_map<EndpointId, T> of the cluster integrations: find() never inserts, emplace()
+ * default-constructs the instance of an endpoint on first use and returns nullptr once the pool holds one instance
+ * per endpoint. The pool is not thread safe, it is used from the Matter context like the maps it replaces.
+ */
+template <typename T>
+class cluster_instance_pool : public cluster_instance_pool_base {
+public:
+    constexpr explicit cluster_instance_pool(const char *name) : cluster_instance_pool_base(name, sizeof(T)) {}
+
+    T *find(chip::EndpointId endpoint_id) const
+    {
+        return static_cast<T *>(find_instance(endpoint_id));
+    }
+
+    T *emplace(chip::EndpointId endpoint_id)
+    {
+        T *instance = find(endpoint_id);
+        if (!instance) {
+            void *storage = allocate(endpoint_id);
+            instance = storage ? new (storage) T() : nullptr;
+        }
+        return instance;
+    }
+
+    void erase(chip::EndpointId endpoint_id)
+    {
+        T *instance = static_cast<T *>(release(endpoint_id));
+        if (instance) {
+            instance->~T();
+            free_storage(instance);
+        }
+    }
+
+    /** Call fn(endpoint_id, instance) for every instance, in the order of the endpoint IDs */
+    template <typename F>
+    void for_each(F &&fn)
+    {
+        for (size_t i = 0; i < size(); ++i) {
+            fn(endpoint_at(i), *static_cast<T *>(instance_at(i)));
+        }
+    }
+};
+
+} // namespace data_model
+} // namespace esp_matter
@@ -254,28 +254,27 @@ chip::Access::Privilege MatterGetAccessPrivilegeForReadEvent(ClusterId cluster,
     return chip::Access::Privilege::kView;
 }
 
-size_t get_command_count(esp_matter::cluster_t *cluster, uint8_t flag)
+DataModel::AttributeEntry get_attribute_entry(ClusterId cluster_id, AttributeId attribute_id, uint16_t flags)
 {
-    size_t ret = 0;
-    esp_matter::command_t *command = esp_matter::command::get_first(cluster);
-    while (command) {
-        if (esp_matter::command::get_flags(command) & flag) {
-            ret++;
-        }
-        command = esp_matter::command::get_next(command);
-    }
-    return ret;
+    chip::BitFlags<DataModel::AttributeQualityFlags> attr_quality_flags;
+    // TODO Array
+    attr_quality_flags.Set(DataModel::AttributeQualityFlags::kTimed,
+                           flags & esp_matter::ATTRIBUTE_FLAG_MUST_USE_TIMED_WRITE);
+    chip::Access::Privilege read_privilege = MatterGetAccessPrivilegeForReadAttribute(cluster_id, attribute_id);
+    auto write_privilege = (flags & esp_matter::ATTRIBUTE_FLAG_WRITABLE)
+                           ? std::make_optional(MatterGetAccessPrivilegeForWriteAttribute(cluster_id, attribute_id))
+                           : std::nullopt;
+    return DataModel::AttributeEntry(attribute_id, attr_quality_flags, read_privilege, write_privilege);
 }
 
-size_t get_attribute_count(esp_matter::cluster_t *cluster)
+DataModel::AcceptedCommandEntry get_accepted_command_entry(ClusterId cluster_id, CommandId command_id)
 {
-    size_t ret = 0;
-    esp_matter::attribute_t *attribute = esp_matter::attribute::get_first(cluster);
-    while (attribute) {
-        ret++;
-        attribute = esp_matter::attribute::get_next(attribute);
-    }
-    return ret;
+    BitMask<DataModel::CommandQualityFlags> quality_flags;
+    quality_flags.Set(DataModel::CommandQualityFlags::kFabricScoped, CommandIsFabricScoped(cluster_id, command_id))
+    .Set(DataModel::CommandQualityFlags::kTimed, CommandNeedsTimedInvoke(cluster_id, command_id))
+    .Set(DataModel::CommandQualityFlags::kLargeMessage, CommandHasLargePayload(cluster_id, command_id));
+    return DataModel::AcceptedCommandEntry(command_id, quality_flags,
+                                           MatterGetAccessPrivilegeForInvokeCommand(cluster_id, command_id));
 }
 
 DefaultAttributePersistenceProvider gDefaultAttributePersistence;
@@ -596,8 +595,16 @@ CHIP_ERROR provider::GeneratedCommands(const ConcreteClusterPath &path, ReadOnly
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
     cluster_t *cluster = cluster::get(path.mEndpointId, path.mClusterId);
-    size_t count = get_command_count(cluster, COMMAND_FLAG_GENERATED);
-    ReturnErrorOnFailure(builder.EnsureAppendCapacity(count));
+    ReturnErrorOnFailure(builder.EnsureAppendCapacity(cluster::get_command_count(cluster, COMMAND_FLAG_GENERATED)));
+    cluster::frozen_tables_t tables;
+    if (cluster::get_frozen_tables(cluster, tables) == ESP_OK) {
+        for (size_t index = 0; index < tables.command_count; ++index) {
+            if (tables.command_flags[index] & COMMAND_FLAG_GENERATED) {
+                ReturnErrorOnFailure(builder.Append(tables.command_ids[index]));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
     command_t *command = command::get_first(cluster);
     while (command) {
         if (command::get_flags(command) & COMMAND_FLAG_GENERATED) {
@@ -627,21 +634,21 @@ CHIP_ERROR provider::AcceptedCommands(const ConcreteClusterPath &path,
     }
     // If we cannot get AcceptedCommands array from CommandHandlerinterface, get it from esp_matter data model.
     cluster_t *cluster = cluster::get(path.mEndpointId, path.mClusterId);
-    size_t count = get_command_count(cluster, COMMAND_FLAG_ACCEPTED);
-    ReturnErrorOnFailure(builder.EnsureAppendCapacity(count));
+    ReturnErrorOnFailure(builder.EnsureAppendCapacity(cluster::get_command_count(cluster, COMMAND_FLAG_ACCEPTED)));
+    cluster::frozen_tables_t tables;
+    if (cluster::get_frozen_tables(cluster, tables) == ESP_OK) {
+        for (size_t index = 0; index < tables.command_count; ++index) {
+            if (tables.command_flags[index] & COMMAND_FLAG_ACCEPTED) {
+                ReturnErrorOnFailure(
+                    builder.Append(get_accepted_command_entry(path.mClusterId, tables.command_ids[index])));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
     command_t *command = command::get_first(cluster);
     while (command) {
         if (command::get_flags(command) & COMMAND_FLAG_ACCEPTED) {
-            uint32_t command_id = command::get_id(command);
-            BitMask<DataModel::CommandQualityFlags> quality_flags;
-            quality_flags
-            .Set(DataModel::CommandQualityFlags::kFabricScoped, CommandIsFabricScoped(path.mClusterId, command_id))
-            .Set(DataModel::CommandQualityFlags::kTimed, CommandNeedsTimedInvoke(path.mClusterId, command_id))
-            .Set(DataModel::CommandQualityFlags::kLargeMessage,
-                 CommandHasLargePayload(path.mClusterId, command_id));
-            AcceptedCommandEntry entry(command_id, quality_flags,
-                                       MatterGetAccessPrivilegeForInvokeCommand(path.mClusterId, command_id));
-            ReturnErrorOnFailure(builder.Append(entry));
+            ReturnErrorOnFailure(builder.Append(get_accepted_command_entry(path.mClusterId, command::get_id(command))));
         }
         command = command::get_next(command);
     }
@@ -665,24 +672,22 @@ CHIP_ERROR provider::Attributes(const ConcreteClusterPath &path, ReadOnlyBufferB
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
     cluster_t *cluster = cluster::get(path.mEndpointId, path.mClusterId);
-    size_t count = get_attribute_count(cluster);
     // There are three attributes(Attributes, AcceptedCommands, and GeneratedCommands) which are not
     // in esp_matter data model metadata;
-    ReturnErrorOnFailure(builder.EnsureAppendCapacity(count + k_global_attributes_count));
-    attribute_t *attribute = attribute::get_first(cluster);
-    while (attribute) {
-        uint32_t id = attribute::get_id(attribute);
-        uint16_t flags = attribute::get_flags(attribute);
-        chip::BitFlags<DataModel::AttributeQualityFlags> attr_quality_flags;
-        // TODO Array
-        attr_quality_flags.Set(DataModel::AttributeQualityFlags::kTimed, flags & ATTRIBUTE_FLAG_MUST_USE_TIMED_WRITE);
-        chip::Access::Privilege read_privilege = MatterGetAccessPrivilegeForReadAttribute(path.mClusterId, id);
-        auto write_privilege = (flags & ATTRIBUTE_FLAG_WRITABLE)
-                               ? std::make_optional(MatterGetAccessPrivilegeForWriteAttribute(path.mClusterId, id))
-                               : std::nullopt;
-        AttributeEntry entry(id, attr_quality_flags, read_privilege, write_privilege);
-        ReturnErrorOnFailure(builder.Append(entry));
-        attribute = attribute::get_next(attribute);
+    ReturnErrorOnFailure(builder.EnsureAppendCapacity(cluster::get_attribute_count(cluster) + k_global_attributes_count));
+    cluster::frozen_tables_t tables;
+    if (cluster::get_frozen_tables(cluster, tables) == ESP_OK) {
+        for (size_t index = 0; index < tables.attribute_count; ++index) {
+            ReturnErrorOnFailure(builder.Append(get_attribute_entry(path.mClusterId, tables.attribute_ids[index],
+                                                                    attribute::get_flags(tables.attributes[index]))));
+        }
+    } else {
+        attribute_t *attribute = attribute::get_first(cluster);
+        while (attribute) {
+            ReturnErrorOnFailure(builder.Append(get_attribute_entry(path.mClusterId, attribute::get_id(attribute),
+                                                                    attribute::get_flags(attribute))));
+            attribute = attribute::get_next(attribute);
+        }
     }
     // Append the three Global attributes
     for (size_t index = 0; index < k_global_attributes_count; ++index) {
@@ -697,6 +702,7 @@ CHIP_ERROR provider::Attributes(const ConcreteClusterPath &path, ReadOnlyBufferB
 
 void provider::ReportAttributeChanged(const AttributePathParams &path)
 {
+    attribute::invalidate_read_cache(path.mEndpointId, path.mClusterId, path.mAttributeId);
     VerifyOrReturn(!path.HasWildcardEndpointId());
     // If the cluster is not wildcard, increase the data version
     if (!path.HasWildcardClusterId()) {
@@ -20,6 +20,7 @@
 #include <esp_matter_attribute_utils.h>
 #include <esp_matter_data_model.h>
 #include <esp_matter_data_model_priv.h>
+#include <esp_matter_mem.h>
 
 #include <app-common/zap-generated/attribute-type.h>
 #include <app/AttributePathParams.h>
@@ -31,6 +32,7 @@
 #include <lib/core/DataModelTypes.h>
 #include <protocols/interaction_model/StatusCode.h>
 
+#include <algorithm>
 #include <cstdint>
 
 #include "esp_matter_attr_val_ember_buffer.h"
@@ -39,17 +41,133 @@ using chip::Protocols::InteractionModel::Status;
 
 namespace {
 
+// Position of the last endpoint resolved by get_endpoint_at_index(). The users of the index walk the endpoints in
+// order, so resuming from the cursor keeps a full iteration linear in the endpoint count.
+struct endpoint_cursor_t {
+    uint32_t generation;
+    uint16_t index;
+    esp_matter::endpoint_t *endpoint;
+};
+
+endpoint_cursor_t s_endpoint_cursor = { 0, 0, nullptr };
+
 esp_matter::endpoint_t *get_endpoint_at_index(uint16_t index)
 {
-    esp_matter::endpoint_t *ep = esp_matter::endpoint::get_first(esp_matter::node::get());
+    uint32_t generation = esp_matter::endpoint::get_list_generation();
+    esp_matter::endpoint_t *ep = nullptr;
     uint16_t idx = 0;
+    if (s_endpoint_cursor.endpoint && s_endpoint_cursor.generation == generation &&
+            s_endpoint_cursor.index <= index) {
+        ep = s_endpoint_cursor.endpoint;
+        idx = s_endpoint_cursor.index;
+    } else {
+        ep = esp_matter::endpoint::get_first(esp_matter::node::get());
+    }
     while (idx < index && ep) {
         ep = esp_matter::endpoint::get_next(ep);
         idx++;
     }
+    if (ep) {
+        s_endpoint_cursor = { generation, idx, ep };
+    }
     return ep;
 }
 
+// Per-cluster tables for emberAfGetClusterServerEndpointIndex(). Each table maps the id of every endpoint having the
+// cluster to its position among those endpoints, sorted by endpoint id. A table is rebuilt when the endpoint list
+// generation changes and the least recently used table is replaced when all of them are taken.
+struct server_endpoint_index_t {
+    chip::EndpointId endpoint_id;
+    uint16_t index;
+};
+
+struct server_index_table_t {
+    uint32_t generation;
+    uint32_t last_used;
+    chip::ClusterId cluster_id;
+    uint16_t count;
+    uint16_t capacity;
+    server_endpoint_index_t *entries;
+};
+
+constexpr size_t k_server_index_table_count = 8;
+server_index_table_t s_server_index_tables[k_server_index_table_count];
+uint32_t s_server_index_use_count = 0;
+
+uint16_t walk_server_endpoint_index(chip::EndpointId endpoint, chip::ClusterId clusterId)
+{
+    esp_matter::endpoint_t *ep = esp_matter::endpoint::get_first(esp_matter::node::get());
+    uint16_t ret = 0;
+    while (ep && esp_matter::endpoint::get_id(ep) != endpoint) {
+        if (esp_matter::cluster::get(ep, clusterId)) {
+            ret++;
+        }
+        ep = esp_matter::endpoint::get_next(ep);
+    }
+    return ret;
+}
+
+bool build_server_index_table(server_index_table_t &table, chip::ClusterId clusterId, uint32_t generation)
+{
+    esp_matter::node_t *node = esp_matter::node::get();
+    uint16_t count = 0;
+    for (esp_matter::endpoint_t *ep = esp_matter::endpoint::get_first(node); ep;
+            ep = esp_matter::endpoint::get_next(ep)) {
+        if (esp_matter::cluster::get(ep, clusterId)) {
+            count++;
+        }
+    }
+    if (count > table.capacity || !table.entries) {
+        esp_matter_mem_free(table.entries);
+        table.capacity = 0;
+        table.entries = (server_endpoint_index_t *)esp_matter_mem_calloc(count ? count : 1,
+                                                                          sizeof(server_endpoint_index_t));
+        if (!table.entries) {
+            table.count = 0;
+            return false;
+        }
+        table.capacity = count ? count : 1;
+    }
+    uint16_t index = 0;
+    for (esp_matter::endpoint_t *ep = esp_matter::endpoint::get_first(node); ep && index < count;
+            ep = esp_matter::endpoint::get_next(ep)) {
+        if (esp_matter::cluster::get(ep, clusterId)) {
+            table.entries[index] = { esp_matter::endpoint::get_id(ep), index };
+            index++;
+        }
+    }
+    std::sort(table.entries, table.entries + index,
+              [](const server_endpoint_index_t &a, const server_endpoint_index_t &b) {
+                  return a.endpoint_id < b.endpoint_id;
+              });
+    table.count = index;
+    table.cluster_id = clusterId;
+    table.generation = generation;
+    return true;
+}
+
+server_index_table_t *get_server_index_table(chip::ClusterId clusterId)
+{
+    uint32_t generation = esp_matter::endpoint::get_list_generation();
+    server_index_table_t *table = nullptr;
+    for (server_index_table_t &candidate : s_server_index_tables) {
+        if (candidate.entries && candidate.cluster_id == clusterId) {
+            table = &candidate;
+            break;
+        }
+        if (!table || candidate.last_used < table->last_used) {
+            table = &candidate;
+        }
+    }
+    if (table->cluster_id != clusterId || table->generation != generation || !table->entries) {
+        if (!build_server_index_table(*table, clusterId, generation)) {
+            return nullptr;
+        }
+    }
+    table->last_used = ++s_server_index_use_count;
+    return table;
+}
+
 Status get_raw_data_buffer_from_attr_val(const esp_matter_attr_val_t &val, uint8_t *dataPtr, uint16_t readLength)
 {
     switch (val.get_storage_type()) {
@@ -637,15 +755,18 @@ uint16_t emberAfGetClusterServerEndpointIndex(chip::EndpointId endpoint, chip::C
         if (!cluster) {
             return 0xFFFF;
         }
-        ep = esp_matter::endpoint::get_first(esp_matter::node::get());
-        uint16_t ret = 0;
-        while (ep && esp_matter::endpoint::get_id(ep) != endpoint) {
-            if (esp_matter::cluster::get(ep, clusterId)) {
-                ret++;
-            }
-            ep = esp_matter::endpoint::get_next(ep);
+        server_index_table_t *table = get_server_index_table(clusterId);
+        if (!table) {
+            return walk_server_endpoint_index(endpoint, clusterId);
+        }
+        server_endpoint_index_t *end = table->entries + table->count;
+        server_endpoint_index_t *entry = std::lower_bound(
+            table->entries, end, endpoint,
+            [](const server_endpoint_index_t &a, chip::EndpointId id) { return a.endpoint_id < id; });
+        if (entry != end && entry->endpoint_id == endpoint) {
+            return entry->index;
         }
-        return ret;
+        return walk_server_endpoint_index(endpoint, clusterId);
     }
     return 0xFFFF;
 }
@@ -209,6 +209,135 @@ void binding_manager_init()
 namespace interaction {
 using chip::app::DataModel::EncodableToTLV;
 
+static constexpr size_t k_min_tlv_buf_len = 16;
+static constexpr uint8_t k_max_encode_attempts = 4;
+
+// The TLV encoding is usually shorter than the JSON string it comes from, the buffer is grown for the other ones and
+// shrunk to the length of the encoding at the end.
+template <typename encode_fn_t>
+static esp_err_t encode_to_buffer(size_t json_len, encode_fn_t encode_fn, ScopedMemoryBufferWithSize<uint8_t> &buf)
+{
+    size_t buf_len = json_len + k_min_tlv_buf_len;
+    for (uint8_t attempt = 0; attempt < k_max_encode_attempts; ++attempt, buf_len *= 2) {
+        ScopedMemoryBufferWithSize<uint8_t> encode_buf;
+        encode_buf.Alloc(buf_len);
+        VerifyOrReturnError(encode_buf.Get(), ESP_ERR_NO_MEM, ESP_LOGE(TAG, "No memory for the TLV encoding"));
+        chip::TLV::TLVWriter writer;
+        writer.Init(encode_buf.Get(), buf_len);
+        esp_err_t err = encode_fn(writer);
+        if (err == ESP_ERR_INVALID_SIZE) {
+            continue;
+        }
+        VerifyOrReturnError(err == ESP_OK, err, ESP_LOGE(TAG, "Failed to convert JSON to TLV"));
+        VerifyOrReturnError(writer.Finalize() == CHIP_NO_ERROR, ESP_FAIL, ESP_LOGE(TAG, "Failed to finalize TLV writer"));
+        buf.Alloc(writer.GetLengthWritten());
+        VerifyOrReturnError(buf.Get(), ESP_ERR_NO_MEM, ESP_LOGE(TAG, "No memory for the TLV encoding"));
+        memcpy(buf.Get(), encode_buf.Get(), buf.AllocatedSize());
+        return ESP_OK;
+    }
+    ESP_LOGE(TAG, "The TLV encoding does not fit in %u bytes", (unsigned)(buf_len / 2));
+    return ESP_ERR_INVALID_SIZE;
+}
+
+static CHIP_ERROR copy_encoded_element(const uint8_t *tlv, size_t len, chip::TLV::TLVWriter &writer,
+                                       chip::TLV::Tag tag)
+{
+    TLVReader reader;
+    reader.Init(tlv, len);
+    reader.ImplicitProfileId = writer.ImplicitProfileId;
+    ReturnErrorOnFailure(reader.Next());
+    return writer.CopyElement(tag, reader);
+}
+
+encoded_payload::encoded_payload(const char *json_str)
+{
+    VerifyOrReturn(json_str, ESP_LOGE(TAG, "JSON string cannot be NULL"));
+    auto encoding = std::make_shared<ScopedMemoryBufferWithSize<uint8_t>>();
+    auto encode_fn = [json_str](chip::TLV::TLVWriter &writer) {
+        return json_to_tlv(json_str, writer, chip::TLV::AnonymousTag());
+    };
+    VerifyOrReturn(encode_to_buffer(strlen(json_str), encode_fn, *encoding) == ESP_OK);
+    m_encoding = std::move(encoding);
+}
+
+CHIP_ERROR encoded_payload::EncodeTo(chip::TLV::TLVWriter &writer, chip::TLV::Tag tag) const
+{
+    VerifyOrReturnError(m_encoding, CHIP_ERROR_INTERNAL);
+    return copy_encoded_element(m_encoding->Get(), m_encoding->AllocatedSize(), writer, tag);
+}
+
+// A NULL JSON string is an empty command or a null attribute value
+custom_encodable_type::custom_encodable_type(const char *json_str, interaction_type usage)
+    : encoded_payload(json_str ? json_str : (usage == k_invoke_cmd ? "{}" : "null"))
+{
+}
+
+multiple_write_encodable_type::multiple_write_encodable_type(const char *json_str)
+{
+    cJSON *json = cJSON_Parse(json_str);
+    VerifyOrReturn(json, ESP_LOGE(TAG, "Failed to parse the attribute values"));
+    m_value_count = static_cast<size_t>(cJSON_GetArraySize(json));
+    // An object is the value of all the attribute paths
+    m_single_value = json->type != cJSON_Array;
+    size_t encoded_count = m_single_value ? 1 : m_value_count;
+
+    auto values = std::make_shared<encoding>();
+    values->offsets.Alloc(encoded_count + 1);
+    if (!values->offsets.Get()) {
+        ESP_LOGE(TAG, "No memory for the attribute value offsets");
+        cJSON_Delete(json);
+        return;
+    }
+    auto encode_fn = [json, encoded_count, &values](chip::TLV::TLVWriter &writer) -> esp_err_t {
+        cJSON *value = json->type == cJSON_Array ? json->child : json;
+        for (size_t i = 0; i < encoded_count && value; ++i, value = value->next) {
+            values->offsets[i] = writer.GetLengthWritten();
+            esp_err_t err = json_to_tlv(value, writer, chip::TLV::AnonymousTag());
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        values->offsets[encoded_count] = writer.GetLengthWritten();
+        return ESP_OK;
+    };
+    esp_err_t err = encode_to_buffer(strlen(json_str), encode_fn, values->tlv);
+    cJSON_Delete(json);
+    VerifyOrReturn(err == ESP_OK);
+    m_encoding = std::move(values);
+}
+
+CHIP_ERROR multiple_write_encodable_type::get_encoded_value(size_t index, const uint8_t *&tlv, size_t &len) const
+{
+    VerifyOrReturnError(m_encoding, CHIP_ERROR_INVALID_ARGUMENT);
+    size_t value_index = m_single_value ? 0 : index;
+    VerifyOrReturnError(value_index + 1 < m_encoding->offsets.AllocatedSize(), CHIP_ERROR_INVALID_ARGUMENT);
+    const uint32_t *offsets = m_encoding->offsets.Get();
+    tlv = m_encoding->tlv.Get() + offsets[value_index];
+    len = offsets[value_index + 1] - offsets[value_index];
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR multiple_write_encodable_type::EncodeTo(chip::TLV::TLVWriter &writer, chip::TLV::Tag tag, size_t index) const
+{
+    const uint8_t *tlv = nullptr;
+    size_t len = 0;
+    ReturnErrorOnFailure(get_encoded_value(index, tlv, len));
+    return copy_encoded_element(tlv, len, writer, tag);
+}
+
+CHIP_ERROR multiple_write_encodable_type::GetValueReader(size_t index, TLVReader &reader) const
+{
+    const uint8_t *tlv = nullptr;
+    size_t len = 0;
+    TLVReader struct_reader;
+    ReturnErrorOnFailure(get_encoded_value(index, tlv, len));
+    struct_reader.Init(tlv, len);
+    ReturnErrorOnFailure(struct_reader.Next());
+    VerifyOrReturnError(struct_reader.GetType() == chip::TLV::kTLVType_Structure, CHIP_ERROR_WRONG_TLV_TYPE);
+    ReturnErrorOnFailure(struct_reader.OpenContainer(reader));
+    return reader.Next();
+}
+
 namespace invoke {
 
 using command_data_tag = chip::app::CommandDataIB::Tag;
@@ -547,7 +676,8 @@ esp_err_t send_request(client::peer_device_t *remote_device, AttributePathParams
 }
 
 esp_err_t send_request(client::peer_device_t *remote_device,
-                       ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths, multiple_write_encodable_type &json_encodable,
+                       ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                       const multiple_write_encodable_type &json_encodable,
                        WriteClient::Callback &callback, const chip::Optional<uint16_t> &timeout_ms)
 {
     VerifyOrReturnError(
@@ -565,25 +695,10 @@ esp_err_t send_request(client::peer_device_t *remote_device,
 
     for (size_t i = 0; i < attr_paths.AllocatedSize(); ++i) {
         ConcreteDataAttributePath path(attr_paths[i].mEndpointId, attr_paths[i].mClusterId, attr_paths[i].mAttributeId);
-        chip::Platform::ScopedMemoryBuffer<uint8_t> encoded_buf;
-        encoded_buf.Alloc(k_encoded_buf_size);
-        VerifyOrReturnError((encoded_buf.Get()), ESP_ERR_NO_MEM,
-                            ESP_LOGE(TAG, "Failed to alloc memory for encoded_buf"));
-        TLVReader reader;
-        TLVWriter writer;
+        // The values were encoded when json_encodable was constructed
         TLVReader attr_val_reader;
-        writer.Init(encoded_buf.Get(), k_encoded_buf_size);
-        VerifyOrReturnError(json_encodable.EncodeTo(writer, chip::TLV::AnonymousTag(), i) == CHIP_NO_ERROR, ESP_FAIL,
+        VerifyOrReturnError(json_encodable.GetValueReader(i, attr_val_reader) == CHIP_NO_ERROR, ESP_FAIL,
                             ESP_LOGE(TAG, "Failed to encode attribute value"));
-        VerifyOrReturnError(writer.Finalize() == CHIP_NO_ERROR, ESP_FAIL,
-                            ESP_LOGE(TAG, "Failed to finalize TLV writer"));
-        reader.Init(encoded_buf.Get(), writer.GetLengthWritten());
-        VerifyOrReturnError(reader.Next() == CHIP_NO_ERROR, ESP_FAIL, ESP_LOGE(TAG, "Failed to read next"));
-        VerifyOrReturnError(reader.GetType() == chip::TLV::TLVType::kTLVType_Structure, ESP_ERR_INVALID_ARG,
-                            ESP_LOGE(TAG, "The TLV type must be structure"));
-        VerifyOrReturnError(reader.OpenContainer(attr_val_reader) == CHIP_NO_ERROR, ESP_FAIL,
-                            ESP_LOGE(TAG, "Failed to open container"));
-        VerifyOrReturnError(attr_val_reader.Next() == CHIP_NO_ERROR, ESP_FAIL, ESP_LOGE(TAG, "Failed to read next"));
         VerifyOrReturnError(write_client->PutPreencodedAttribute(path, attr_val_reader) == CHIP_NO_ERROR, ESP_FAIL,
                             ESP_LOGE(TAG, "Failed to put pre-encoded attribute value to WriteClient"));
     }
@@ -18,8 +18,10 @@
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/data-model/EncodableToTLV.h>
 #include <cassert>
+#include <memory>
 #include <esp_err.h>
 #include <esp_matter_core.h>
+#include <lib/support/ScopedBuffer.h>
 #include <string.h>
 
 namespace esp_matter {
@@ -178,81 +180,65 @@ using chip::TLV::TLVReader;
 using client::peer_device_t;
 using chip::app::DataModel::EncodableToTLV;
 
-class custom_encodable_type : public EncodableToTLV {
+/** TLV payload compiled from a JSON string
+ *
+ * The JSON string is converted to TLV once, see json_to_tlv(). The encoding is immutable and shared by the copies of
+ * the payload, so one payload can be sent to many nodes and on every retry without converting the JSON again.
+ */
+class encoded_payload : public EncodableToTLV {
+public:
+    encoded_payload() = default;
+    explicit encoded_payload(const char *json_str);
+
+    bool is_valid() const { return m_encoding != nullptr; }
+
+    CHIP_ERROR EncodeTo(chip::TLV::TLVWriter &writer, chip::TLV::Tag tag) const override;
+
+private:
+    std::shared_ptr<const chip::Platform::ScopedMemoryBufferWithSize<uint8_t>> m_encoding;
+};
+
+class custom_encodable_type : public encoded_payload {
 public:
-    const char *k_empty_command_data = "{}";
-    const char *k_null_attribute_data = "null";
     enum interaction_type {
         k_invoke_cmd = 0,
         k_write_attr,
     };
 
-    custom_encodable_type(const char *json_str, interaction_type usage)
-    {
-        if (json_str) {
-            m_json_str = strdup(json_str);
-        } else {
-            if (usage == k_invoke_cmd) {
-                m_json_str = strdup("{}");
-            } else if (usage == k_write_attr) {
-                m_json_str = strdup("null");
-            }
-        }
-        assert(m_json_str);
-    }
-
-    ~custom_encodable_type()
-    {
-        free(m_json_str);
-    }
-
-    CHIP_ERROR EncodeTo(chip::TLV::TLVWriter  &writer, chip::TLV::Tag tag) const override
-    {
-        if (json_to_tlv(m_json_str, writer, tag) != ESP_OK) {
-            return CHIP_ERROR_INTERNAL;
-        }
-        return CHIP_NO_ERROR;
-    }
-private:
-    char *m_json_str = NULL;
+    custom_encodable_type(const char *json_str, interaction_type usage);
+    explicit custom_encodable_type(const encoded_payload &payload) : encoded_payload(payload) {}
 };
 
+/** Attribute values of a write request, compiled from a JSON string
+ *
+ * The JSON string is either an array with the value of each attribute path or an object with the value of all the
+ * attribute paths. All the values are converted to TLV in one pass when the object is constructed, and the copies of
+ * the object share the encoding.
+ */
 class multiple_write_encodable_type {
 public:
-    explicit multiple_write_encodable_type(const char *json_str)
-    {
-        json = cJSON_Parse(json_str);
-    }
+    explicit multiple_write_encodable_type(const char *json_str);
 
-    ~multiple_write_encodable_type()
-    {
-        cJSON_Delete(json);
-    }
+    bool is_valid() const { return m_encoding != nullptr; }
 
-    CHIP_ERROR EncodeTo(chip::TLV::TLVWriter &writer, chip::TLV::Tag tag, size_t index)
-    {
-        cJSON *json_at_index = NULL;
-        if (!json) {
-            return CHIP_ERROR_INVALID_ARGUMENT;
-        }
-        if (json->type != cJSON_Array) {
-            json_at_index = json;
-        } else {
-            json_at_index = cJSON_GetArrayItem(json, index);
-        }
-        if (json_to_tlv(json_at_index, writer, tag) != ESP_OK) {
-            return CHIP_ERROR_INTERNAL;
-        }
-        return CHIP_NO_ERROR;
-    }
+    CHIP_ERROR EncodeTo(chip::TLV::TLVWriter &writer, chip::TLV::Tag tag, size_t index) const;
 
-    size_t GetJsonArraySize()
-    {
-        return static_cast<size_t>(cJSON_GetArraySize(json));
-    }
+    /** Get a reader on the attribute value at index, as expected by WriteClient::PutPreencodedAttribute() */
+    CHIP_ERROR GetValueReader(size_t index, TLVReader &reader) const;
+
+    size_t GetJsonArraySize() const { return m_value_count; }
 
 private:
-    cJSON *json = NULL;
+    CHIP_ERROR get_encoded_value(size_t index, const uint8_t *&tlv, size_t &len) const;
+
+    struct encoding {
+        chip::Platform::ScopedMemoryBufferWithSize<uint8_t> tlv;
+        // Offsets of the encoded values in tlv, the last one is the length of the encoding
+        chip::Platform::ScopedMemoryBufferWithSize<uint32_t> offsets;
+    };
+    std::shared_ptr<const encoding> m_encoding;
+    size_t m_value_count = 0;
+    bool m_single_value = false;
 };
 
 /** Command invoke APIs
@@ -366,7 +352,7 @@ esp_err_t send_request(client::peer_device_t *remote_device, AttributePathParams
                        const chip::Optional<uint16_t> &timeout_ms);
 
 esp_err_t send_request(client::peer_device_t *remote_device, ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
-                       multiple_write_encodable_type &json_encodable, WriteClient::Callback &callback,
+                       const multiple_write_encodable_type &json_encodable, WriteClient::Callback &callback,
                        const chip::Optional<uint16_t> &timeout_ms);
 } // namespace write
 
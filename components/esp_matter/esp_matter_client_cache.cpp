@@ -0,0 +1,453 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_matter_client_cache.h>
+
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+#include <cinttypes>
+#include <cstring>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <lib/core/TLVWriter.h>
+#include "support/CodeUtils.h"
+
+using chip::app::AttributePathParams;
+using chip::app::ConcreteDataAttributePath;
+using chip::app::DataVersionFilterIBs;
+
+static const char *TAG = "esp_matter_client_cache";
+
+namespace esp_matter {
+namespace client {
+namespace cache {
+namespace {
+
+// The encoded value follows the structure in the same allocation
+struct cached_attribute_t {
+    cached_attribute_t *next;
+    uint32_t attribute_id;
+    /* Latest data version of the cluster at which the value is known to be current */
+    chip::DataVersion data_version;
+    uint16_t tlv_len;
+    bool has_data_version;
+};
+
+struct cached_cluster_t {
+    uint64_t node_id;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    chip::DataVersion data_version;
+    chip::DataVersion pending_data_version;
+    uint32_t last_used;
+    bool in_use;
+    bool has_data_version;
+    bool has_pending_data_version;
+    /* An attribute data of the current report did not have a data version */
+    bool data_version_lost;
+    cached_attribute_t *attributes;
+};
+
+// The event numbers are counted per node, they are kept apart from the clusters so that the events do not evict them
+struct cached_event_number_t {
+    uint64_t node_id;
+    chip::EventNumber event_number;
+    uint32_t last_used;
+    bool in_use;
+};
+
+constexpr size_t k_cluster_count = CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE_CLUSTER_COUNT;
+constexpr size_t k_event_node_count = CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE_EVENT_NODE_COUNT;
+constexpr size_t k_max_value_len = CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE_MAX_VALUE_SIZE;
+constexpr size_t k_min_value_len = 32;
+
+cached_cluster_t s_clusters[k_cluster_count];
+cached_event_number_t s_event_numbers[k_event_node_count];
+uint32_t s_use_count = 0;
+
+SemaphoreHandle_t get_cache_lock()
+{
+    static StaticSemaphore_t s_cache_lock_buffer;
+    static SemaphoreHandle_t s_cache_lock = xSemaphoreCreateMutexStatic(&s_cache_lock_buffer);
+    return s_cache_lock;
+}
+
+class scoped_cache_lock {
+public:
+    scoped_cache_lock()
+    {
+        xSemaphoreTake(get_cache_lock(), portMAX_DELAY);
+    }
+    ~scoped_cache_lock()
+    {
+        xSemaphoreGive(get_cache_lock());
+    }
+};
+
+uint8_t *get_tlv(cached_attribute_t *attribute)
+{
+    return reinterpret_cast<uint8_t *>(attribute + 1);
+}
+
+void release_cluster(cached_cluster_t &cluster)
+{
+    cached_attribute_t *attribute = cluster.attributes;
+    while (attribute) {
+        cached_attribute_t *next = attribute->next;
+        esp_matter_mem_free(attribute);
+        attribute = next;
+    }
+    memset(&cluster, 0, sizeof(cluster));
+}
+
+cached_cluster_t *find_cluster(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id)
+{
+    for (cached_cluster_t &cluster : s_clusters) {
+        if (cluster.in_use && cluster.node_id == node_id && cluster.endpoint_id == endpoint_id &&
+                cluster.cluster_id == cluster_id) {
+            return &cluster;
+        }
+    }
+    return nullptr;
+}
+
+// The least recently used cluster is evicted when all the entries are taken, its data version goes with it
+cached_cluster_t *find_or_create_cluster(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id)
+{
+    cached_cluster_t *victim = &s_clusters[0];
+    for (cached_cluster_t &cluster : s_clusters) {
+        if (cluster.in_use && cluster.node_id == node_id && cluster.endpoint_id == endpoint_id &&
+                cluster.cluster_id == cluster_id) {
+            victim = &cluster;
+            break;
+        }
+        if (!cluster.in_use || (victim->in_use && cluster.last_used < victim->last_used)) {
+            victim = &cluster;
+        }
+    }
+    if (!victim->in_use || victim->node_id != node_id || victim->endpoint_id != endpoint_id ||
+            victim->cluster_id != cluster_id) {
+        release_cluster(*victim);
+        victim->in_use = true;
+        victim->node_id = node_id;
+        victim->endpoint_id = endpoint_id;
+        victim->cluster_id = cluster_id;
+    }
+    victim->last_used = ++s_use_count;
+    return victim;
+}
+
+cached_attribute_t *find_attribute(const cached_cluster_t &cluster, uint32_t attribute_id)
+{
+    for (cached_attribute_t *attribute = cluster.attributes; attribute; attribute = attribute->next) {
+        if (attribute->attribute_id == attribute_id) {
+            return attribute;
+        }
+    }
+    return nullptr;
+}
+
+void remove_attribute(cached_cluster_t &cluster, uint32_t attribute_id)
+{
+    cached_attribute_t **link = &cluster.attributes;
+    while (*link) {
+        if ((*link)->attribute_id == attribute_id) {
+            cached_attribute_t *attribute = *link;
+            *link = attribute->next;
+            esp_matter_mem_free(attribute);
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+bool is_covered(const AttributePathParams &attr_path, uint16_t endpoint_id, uint32_t cluster_id)
+{
+    return (attr_path.HasWildcardEndpointId() || attr_path.mEndpointId == endpoint_id) &&
+           (attr_path.HasWildcardClusterId() || attr_path.mClusterId == cluster_id);
+}
+
+bool is_covered(const chip::Span<AttributePathParams> &attr_paths, const cached_cluster_t &cluster,
+                uint32_t attribute_id)
+{
+    for (const AttributePathParams &attr_path : attr_paths) {
+        if (is_covered(attr_path, cluster.endpoint_id, cluster.cluster_id) &&
+                (attr_path.HasWildcardAttributeId() || attr_path.mAttributeId == attribute_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The value is current if no change of the cluster was reported since the one which brought it
+bool is_current(const cached_cluster_t &cluster, const cached_attribute_t *attribute)
+{
+    return attribute && attribute->has_data_version && cluster.has_data_version &&
+           attribute->data_version == cluster.data_version;
+}
+
+void invalidate_data_version(cached_cluster_t &cluster)
+{
+    cluster.has_data_version = false;
+    cluster.has_pending_data_version = false;
+    cluster.data_version_lost = true;
+}
+
+// The size of the encoding is not known before it is copied, the copy is retried with larger buffers
+esp_err_t copy_value(uint32_t attribute_id, const chip::TLV::TLVReader &data, cached_attribute_t **out)
+{
+    for (size_t buf_len = k_min_value_len; buf_len <= k_max_value_len * 2; buf_len *= 2) {
+        size_t value_len = buf_len < k_max_value_len ? buf_len : k_max_value_len;
+        cached_attribute_t *attribute =
+            (cached_attribute_t *)esp_matter_mem_calloc(1, sizeof(cached_attribute_t) + value_len);
+        ESP_RETURN_ON_FALSE(attribute, ESP_ERR_NO_MEM, TAG, "No memory for the attribute value");
+        chip::TLV::TLVReader reader;
+        reader.Init(data);
+        chip::TLV::TLVWriter writer;
+        writer.Init(get_tlv(attribute), value_len);
+        CHIP_ERROR err = writer.CopyElement(chip::TLV::AnonymousTag(), reader);
+        if (err == CHIP_NO_ERROR) {
+            err = writer.Finalize();
+        }
+        if (err == CHIP_NO_ERROR) {
+            attribute->attribute_id = attribute_id;
+            attribute->tlv_len = (uint16_t)writer.GetLengthWritten();
+            void *shrunk = esp_matter_mem_realloc(attribute, sizeof(cached_attribute_t) + attribute->tlv_len);
+            *out = shrunk ? (cached_attribute_t *)shrunk : attribute;
+            return ESP_OK;
+        }
+        esp_matter_mem_free(attribute);
+        if ((err != CHIP_ERROR_NO_MEMORY && err != CHIP_ERROR_BUFFER_TOO_SMALL) || value_len == k_max_value_len) {
+            break;
+        }
+    }
+    ESP_LOGW(TAG, "Attribute 0x%08" PRIx32 " is not cached, its value is invalid or larger than %u bytes",
+             attribute_id, (unsigned)k_max_value_len);
+    return ESP_ERR_NO_MEM;
+}
+
+// The AttributeList tells whether a wildcard path over the cluster is fully cached at its data version
+bool has_all_attributes(const cached_cluster_t &cluster)
+{
+    cached_attribute_t *attribute_list =
+        find_attribute(cluster, chip::app::Clusters::Globals::Attributes::AttributeList::Id);
+    VerifyOrReturnValue(is_current(cluster, attribute_list), false);
+    chip::TLV::TLVReader reader;
+    reader.Init(get_tlv(attribute_list), attribute_list->tlv_len);
+    VerifyOrReturnValue(reader.Next() == CHIP_NO_ERROR && reader.GetType() == chip::TLV::kTLVType_Array, false);
+    chip::TLV::TLVType outer;
+    VerifyOrReturnValue(reader.EnterContainer(outer) == CHIP_NO_ERROR, false);
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR) {
+        uint32_t attribute_id;
+        VerifyOrReturnValue(reader.Get(attribute_id) == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(is_current(cluster, find_attribute(cluster, attribute_id)), false);
+    }
+    return err == CHIP_END_OF_TLV;
+}
+
+// A cluster is filtered only if all the attributes requested in it are cached at its data version. The other
+// interactions with the node may have reported a newer data version of the cluster without these attributes.
+bool is_filterable(const cached_cluster_t &cluster, const chip::Span<AttributePathParams> &attr_paths)
+{
+    bool covered = false;
+    for (const AttributePathParams &attr_path : attr_paths) {
+        if (!is_covered(attr_path, cluster.endpoint_id, cluster.cluster_id)) {
+            continue;
+        }
+        if (attr_path.HasWildcardAttributeId() ? !has_all_attributes(cluster)
+                : !is_current(cluster, find_attribute(cluster, attr_path.mAttributeId))) {
+            return false;
+        }
+        covered = true;
+    }
+    return covered;
+}
+
+CHIP_ERROR encode_data_version_filter(DataVersionFilterIBs::Builder &builder, const cached_cluster_t &cluster)
+{
+    chip::app::DataVersionFilterIB::Builder &filter = builder.CreateDataVersionFilter();
+    ReturnErrorOnFailure(builder.GetError());
+    chip::app::ClusterPathIB::Builder &path = filter.CreatePath();
+    ReturnErrorOnFailure(filter.GetError());
+    ReturnErrorOnFailure(path.Endpoint(cluster.endpoint_id).Cluster(cluster.cluster_id).EndOfClusterPathIB());
+    return filter.DataVersion(cluster.data_version).EndOfDataVersionFilterIB();
+}
+
+} // namespace
+
+esp_err_t update_attribute(uint64_t node_id, const ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
+                           const chip::app::StatusIB &status)
+{
+    scoped_cache_lock lock;
+    cached_cluster_t *cluster = find_or_create_cluster(node_id, path.mEndpointId, path.mClusterId);
+    if (!status.IsSuccess() || !data || path.IsListItemOperation()) {
+        // The value of the attribute is unknown, so is the one of the cluster at the data version of the report
+        remove_attribute(*cluster, path.mAttributeId);
+        invalidate_data_version(*cluster);
+        return ESP_OK;
+    }
+
+    cached_attribute_t *attribute = nullptr;
+    esp_err_t err = copy_value(path.mAttributeId, *data, &attribute);
+    remove_attribute(*cluster, path.mAttributeId);
+    if (err != ESP_OK) {
+        invalidate_data_version(*cluster);
+        return err;
+    }
+    attribute->next = cluster->attributes;
+    cluster->attributes = attribute;
+    attribute->data_version = path.mDataVersion.ValueOr(0);
+    attribute->has_data_version = path.mDataVersion.HasValue();
+
+    if (!path.mDataVersion.HasValue()) {
+        invalidate_data_version(*cluster);
+    } else if (!cluster->data_version_lost) {
+        cluster->pending_data_version = path.mDataVersion.Value();
+        cluster->has_pending_data_version = true;
+    }
+    return ESP_OK;
+}
+
+void update_event(uint64_t node_id, const chip::app::EventHeader &event_header)
+{
+    scoped_cache_lock lock;
+    cached_event_number_t *entry = &s_event_numbers[0];
+    for (cached_event_number_t &event_number : s_event_numbers) {
+        if (event_number.in_use && event_number.node_id == node_id) {
+            entry = &event_number;
+            break;
+        }
+        if (!event_number.in_use || (entry->in_use && event_number.last_used < entry->last_used)) {
+            entry = &event_number;
+        }
+    }
+    if (!entry->in_use || entry->node_id != node_id) {
+        entry->in_use = true;
+        entry->node_id = node_id;
+        entry->event_number = event_header.mEventNumber;
+    } else if (event_header.mEventNumber > entry->event_number) {
+        entry->event_number = event_header.mEventNumber;
+    }
+    entry->last_used = ++s_use_count;
+}
+
+void end_report(uint64_t node_id, const chip::Span<AttributePathParams> &attr_paths)
+{
+    scoped_cache_lock lock;
+    for (cached_cluster_t &cluster : s_clusters) {
+        if (!cluster.in_use || cluster.node_id != node_id) {
+            continue;
+        }
+        if (cluster.has_pending_data_version) {
+            cluster.data_version = cluster.pending_data_version;
+            cluster.has_data_version = true;
+            // The report carried every change of the requested attributes up to this data version, the attributes
+            // out of the paths of the interaction keep the data version which they were reported with
+            for (cached_attribute_t *attribute = cluster.attributes; attribute; attribute = attribute->next) {
+                if (attribute->has_data_version && is_covered(attr_paths, cluster, attribute->attribute_id)) {
+                    attribute->data_version = cluster.data_version;
+                }
+            }
+        }
+        cluster.has_pending_data_version = false;
+        cluster.data_version_lost = false;
+    }
+}
+
+esp_err_t get_attribute(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                        uint8_t *buf, size_t buf_size, size_t *len)
+{
+    ESP_RETURN_ON_FALSE(len && (buf || buf_size == 0), ESP_ERR_INVALID_ARG, TAG, "len and buf cannot be NULL");
+    scoped_cache_lock lock;
+    cached_cluster_t *cluster = find_cluster(node_id, endpoint_id, cluster_id);
+    cached_attribute_t *attribute = cluster ? find_attribute(*cluster, attribute_id) : nullptr;
+    VerifyOrReturnError(attribute, ESP_ERR_NOT_FOUND);
+    cluster->last_used = ++s_use_count;
+    *len = attribute->tlv_len;
+    VerifyOrReturnError(attribute->tlv_len <= buf_size, ESP_ERR_INVALID_SIZE);
+    memcpy(buf, get_tlv(attribute), attribute->tlv_len);
+    return ESP_OK;
+}
+
+esp_err_t get_data_version(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id,
+                           chip::DataVersion &data_version)
+{
+    scoped_cache_lock lock;
+    cached_cluster_t *cluster = find_cluster(node_id, endpoint_id, cluster_id);
+    VerifyOrReturnError(cluster && cluster->has_data_version, ESP_ERR_NOT_FOUND);
+    data_version = cluster->data_version;
+    return ESP_OK;
+}
+
+CHIP_ERROR encode_data_version_filters(uint64_t node_id, DataVersionFilterIBs::Builder &builder,
+                                       const chip::Span<AttributePathParams> &attr_paths, bool &encoded)
+{
+    encoded = false;
+    scoped_cache_lock lock;
+    for (const cached_cluster_t &cluster : s_clusters) {
+        if (!cluster.in_use || cluster.node_id != node_id || !cluster.has_data_version ||
+                !is_filterable(cluster, attr_paths)) {
+            continue;
+        }
+        chip::TLV::TLVWriter backup;
+        builder.Checkpoint(backup);
+        CHIP_ERROR err = encode_data_version_filter(builder, cluster);
+        if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL) {
+            // The request is full, the remaining clusters are reported as if they were not cached
+            builder.Rollback(backup);
+            builder.ResetError();
+            break;
+        }
+        ReturnErrorOnFailure(err);
+        encoded = true;
+    }
+    return CHIP_NO_ERROR;
+}
+
+esp_err_t get_highest_event_number(uint64_t node_id, chip::EventNumber &event_number)
+{
+    scoped_cache_lock lock;
+    for (const cached_event_number_t &entry : s_event_numbers) {
+        if (entry.in_use && entry.node_id == node_id) {
+            event_number = entry.event_number;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+void remove_node(uint64_t node_id)
+{
+    scoped_cache_lock lock;
+    for (cached_cluster_t &cluster : s_clusters) {
+        if (cluster.in_use && (node_id == chip::kUndefinedNodeId || cluster.node_id == node_id)) {
+            release_cluster(cluster);
+        }
+    }
+    for (cached_event_number_t &entry : s_event_numbers) {
+        if (entry.in_use && (node_id == chip::kUndefinedNodeId || entry.node_id == node_id)) {
+            memset(&entry, 0, sizeof(entry));
+        }
+    }
+}
+
+} // namespace cache
+} // namespace client
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
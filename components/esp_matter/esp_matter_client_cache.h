@@ -0,0 +1,150 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/EventHeader.h>
+#include <app/MessageDef/DataVersionFilterIBs.h>
+#include <app/MessageDef/StatusIB.h>
+#include <esp_err.h>
+#include <lib/core/NodeId.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/Span.h>
+
+namespace esp_matter {
+namespace client {
+/** State of the clusters of remote nodes, as reported to the read and subscribe interactions
+ *
+ * The cache keeps the last reported value of the attributes and the data version of their cluster. The values are
+ * read locally, without any request to the remote node, and the data versions are sent as DataVersionFilters when
+ * the node is subscribed again, so that the node only reports the clusters which changed in the meantime.
+ *
+ * The reports are fed by the ReadClient::Callback of the interaction: update_attribute() and update_event() for every
+ * attribute and event data, and end_report() when the report ends. Every cached value records the data version of its
+ * cluster at which it was last reported, so that the interactions with different paths over the same cluster do not
+ * filter out the attributes which only the other interactions saw. Lists have to be reported as a whole, i.e. the
+ * callback must be behind a chip::app::BufferedReadCallback.
+ */
+namespace cache {
+
+/** Store the attribute data of a report
+ *
+ * The value replaces the cached one. An error status or an incremental list operation drops the cached value. The data
+ * version of the path is applied to its cluster at the end of the report, an attribute data without data version
+ * invalidates the data version of its cluster.
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] path Path of the attribute data
+ * @param[in] data Value of the attribute, NULL if the status is an error
+ * @param[in] status Status of the attribute data
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM if the value could not be cached, the data version of its cluster is invalidated.
+ * @return error in case of failure.
+ */
+esp_err_t update_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                           chip::TLV::TLVReader *data, const chip::app::StatusIB &status);
+
+/** Record the event number of an event data of a report
+ *
+ * The highest event number is kept per node, apart from the clusters, so the events never evict cached attributes.
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] event_header Header of the event data
+ */
+void update_event(uint64_t node_id, const chip::app::EventHeader &event_header);
+
+/** Apply the data versions received in the report of a node
+ *
+ * The cached attributes covered by the attribute paths of the interaction are current at the data versions of the
+ * report, the other attributes of the reported clusters keep their data version.
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] attr_paths Attribute paths of the interaction which received the report
+ */
+void end_report(uint64_t node_id, const chip::Span<chip::app::AttributePathParams> &attr_paths);
+
+/** Get the cached value of an attribute
+ *
+ * The value is copied as an anonymous TLV element. Initialize a TLVReader on the buffer and call Next() to read it.
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] endpoint_id EndpointId of the attribute
+ * @param[in] cluster_id ClusterId of the attribute
+ * @param[in] attribute_id AttributeId of the attribute
+ * @param[out] buf Buffer for the TLV encoded value
+ * @param[in] buf_size Size of the buffer
+ * @param[out] len Length of the TLV encoded value
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the attribute is not cached.
+ * @return ESP_ERR_INVALID_SIZE if the buffer is too small, len is set to the needed size.
+ */
+esp_err_t get_attribute(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                        uint8_t *buf, size_t buf_size, size_t *len);
+
+/** Get the data version of a cached cluster
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] endpoint_id EndpointId of the cluster
+ * @param[in] cluster_id ClusterId of the cluster
+ * @param[out] data_version Data version of the cluster
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the cluster is not cached or its data version is unknown.
+ */
+esp_err_t get_data_version(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id,
+                           chip::DataVersion &data_version);
+
+/** Encode the DataVersionFilters of a read or subscribe request
+ *
+ * A filter is encoded for the cached clusters with a data version which are covered by the attribute paths of the
+ * request and hold all the attributes requested by these paths at that data version. The filters which do not fit in the request are
+ * omitted. To be called from ReadClient::Callback::OnUpdateDataVersionFilterList().
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] builder Builder of the DataVersionFilters of the request
+ * @param[in] attr_paths Attribute paths of the request
+ * @param[out] encoded Set to true if at least one filter is encoded
+ *
+ * @return CHIP_NO_ERROR on success.
+ * @return error in case of failure.
+ */
+CHIP_ERROR encode_data_version_filters(uint64_t node_id, chip::app::DataVersionFilterIBs::Builder &builder,
+                                       const chip::Span<chip::app::AttributePathParams> &attr_paths, bool &encoded);
+
+/** Get the highest event number received from a node
+ *
+ * To be called from ReadClient::Callback::GetHighestReceivedEventNumber(), so that the events already received are
+ * not reported again.
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[out] event_number Highest event number
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if no event of the node is cached.
+ */
+esp_err_t get_highest_event_number(uint64_t node_id, chip::EventNumber &event_number);
+
+/** Remove the cached state of a node
+ *
+ * @param[in] node_id Remote NodeId, chip::kUndefinedNodeId for all the nodes
+ */
+void remove_node(uint64_t node_id);
+
+} // namespace cache
+} // namespace client
+} // namespace esp_matter
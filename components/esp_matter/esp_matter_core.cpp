@@ -14,6 +14,7 @@
 
 #include <esp_check.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <esp_matter.h>
 #include <esp_matter_core.h>
 #include <esp_matter_icd_configuration.h>
@@ -139,7 +140,24 @@ FabricDelegateImpl s_fabric_delegate;
 
 namespace lock {
 #define DEFAULT_TICKS (500 / portTICK_PERIOD_MS) /* 500 ms in ticks */
-status_t ScopedChipStackLock::chip_stack_lock(uint32_t ticks_to_wait)
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+/* Only updated with the lock held */
+static stats_t s_lock_stats;
+
+void get_stats(stats_t *stats)
+{
+    if (stats) {
+        *stats = s_lock_stats;
+    }
+}
+
+void reset_stats()
+{
+    s_lock_stats = {};
+}
+#endif // CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+
+static status_t take_chip_stack_lock(uint32_t ticks_to_wait)
 {
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     VerifyOrReturnValue(!PlatformMgr().IsChipStackLockedByCurrentThread(), ALREADY_TAKEN);
@@ -157,8 +175,27 @@ status_t ScopedChipStackLock::chip_stack_lock(uint32_t ticks_to_wait)
     return FAILED;
 }
 
+status_t ScopedChipStackLock::chip_stack_lock(uint32_t ticks_to_wait)
+{
+    status_t status = take_chip_stack_lock(ticks_to_wait);
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    if (status == SUCCESS) {
+        acquire_time_us = esp_timer_get_time();
+        s_lock_stats.acquisitions++;
+    }
+#endif
+    return status;
+}
+
 esp_err_t ScopedChipStackLock::chip_stack_unlock()
 {
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    int64_t hold_time_us = esp_timer_get_time() - acquire_time_us;
+    s_lock_stats.total_hold_time_us += hold_time_us;
+    if (hold_time_us > s_lock_stats.max_hold_time_us) {
+        s_lock_stats.max_hold_time_us = hold_time_us;
+    }
+#endif
     PlatformMgr().UnlockChipStack();
     return ESP_OK;
 }
@@ -381,6 +418,14 @@ esp_err_t start(event_callback_t callback, intptr_t callback_arg)
     esp_matter_ota_requestor_init();
 #endif // CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
 
+#ifdef CONFIG_ESP_MATTER_DATA_MODEL_FREEZE_ON_START
+    if (node::get()) {
+        // The clusters which could not be frozen keep the list lookups, like when the path index cannot grow
+        if (node::freeze() != ESP_OK) {
+            ESP_LOGW(TAG, "Couldn't freeze the data model, some clusters use the list lookups");
+        }
+    }
+#endif // CONFIG_ESP_MATTER_DATA_MODEL_FREEZE_ON_START
     err = chip_init(callback, callback_arg);
     VerifyOrReturnError(err == ESP_OK, err, ESP_LOGE(TAG, "Error initializing matter"));
 #if CHIP_DEVICE_CONFIG_ENABLE_THREAD
@@ -396,6 +441,10 @@ esp_err_t start(event_callback_t callback, intptr_t callback_arg)
 #endif // CONFIG_ESP_MATTER_ENABLE_OPENTHREAD
 #endif // CHIP_DEVICE_CONFIG_ENABLE_THREAD
     esp_matter_started = true;
+#if defined(CONFIG_ESP_MATTER_ENABLE_DATA_MODEL) && defined(CONFIG_ESP_MATTER_NVS_PRELOAD)
+    // The attributes created from now on read their values from the NVS
+    attribute::release_preloaded_nvs_values();
+#endif // defined(CONFIG_ESP_MATTER_ENABLE_DATA_MODEL) && defined(CONFIG_ESP_MATTER_NVS_PRELOAD)
 #if defined(CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER) && defined(CONFIG_ESP_MATTER_ENABLE_DATA_MODEL)
     err = node::read_min_unused_endpoint_id();
     // If the min_unused_endpoint_id is not found, we will write the current min_unused_endpoint_id in nvs.
@@ -413,18 +462,9 @@ esp_err_t factory_reset()
     node_t *node = node::get();
     if (node) {
         /* ESP Matter data model is used. Erase all the data that we have added in nvs. */
-        nvs_handle_t handle;
-        err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE, &handle);
+        err = attribute::erase_all_in_nvs();
         if (err != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to open esp_matter nvs partition ");
-        } else {
-            err = nvs_erase_all(handle);
-            if (err != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to erase esp_matter nvs namespace");
-            } else {
-                nvs_commit(handle);
-            }
-            nvs_close(handle);
+            ESP_LOGE(TAG, "Failed to erase esp_matter nvs namespace");
         }
     }
 #endif
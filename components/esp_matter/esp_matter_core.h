@@ -109,6 +109,30 @@ typedef enum status {
     SUCCESS,
 } status_t;
 
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+/** Statistics of the Matter stack lock taken with ScopedChipStackLock */
+typedef struct {
+    /** Number of times the lock was taken */
+    uint32_t acquisitions;
+    /** Total and longest time the lock was held */
+    int64_t total_hold_time_us;
+    int64_t max_hold_time_us;
+} stats_t;
+
+/** Get the statistics of the Matter stack lock
+ *
+ * The statistics are updated with the lock held, they are only consistent when no other task takes the lock.
+ *
+ * @param[out] stats Statistics of the lock
+ */
+void get_stats(stats_t *stats);
+
+/** Reset the statistics of the Matter stack lock, like get_stats() it should be called when no other task takes the
+ *  lock
+ */
+void reset_stats();
+#endif // CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+
 /**
  * @brief RAII-style scoped lock for the Matter (CHIP) stack.
  *
@@ -150,6 +174,9 @@ private:
     ScopedChipStackLock(ScopedChipStackLock &&) = default;
     ScopedChipStackLock &operator=(ScopedChipStackLock &&) = default;
     status_t status;
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    int64_t acquire_time_us;
+#endif
 
     /** Stack lock
     *
@@ -211,6 +211,46 @@ TEST_CASE("get_val uint32 - Feature map", "[get_val][esp_matter_managed][uint32]
     teardown_for_get_val();
 }
 
+TEST_CASE("get_val char_string returns a caller owned copy", "[get_val][esp_matter_managed][char_string]")
+{
+    setup_for_get_val();
+
+    static constexpr uint32_t k_custom_cluster_id = 0xFFF1FC01;
+    static constexpr uint32_t k_custom_attribute_id = 0x0;
+    cluster_t *cluster = cluster::create(test_endpoint, k_custom_cluster_id, CLUSTER_FLAG_SERVER);
+    TEST_ASSERT_NOT_NULL(cluster);
+    char label[] = "esp-matter";
+    attribute_t *attr = attribute::create(cluster, k_custom_attribute_id, ATTRIBUTE_FLAG_NONE,
+                                          esp_matter_char_str(label, sizeof(label) - 1), 32);
+    TEST_ASSERT_NOT_NULL(attr);
+
+    esp_matter_attr_val_t val;
+    esp_err_t err = attribute::get_val(test_endpoint_id, k_custom_cluster_id, k_custom_attribute_id, &val);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+    TEST_ASSERT_EQUAL(ESP_MATTER_VAL_TYPE_CHAR_STRING, val.type);
+    TEST_ASSERT_EQUAL(sizeof(label) - 1, val.val.a.s);
+    TEST_ASSERT_EQUAL_STRING(label, val.val.a.b);
+
+    // The returned buffer must not alias the stored value
+    val.val.a.b[0] = 'E';
+    esp_matter_attr_val_t reread_val;
+    err = attribute::get_val(attr, &reread_val);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+    TEST_ASSERT_EQUAL_STRING(label, reread_val.val.a.b);
+    free(val.val.a.b);
+    free(reread_val.val.a.b);
+
+    esp_matter_attr_val_t null_val = esp_matter_char_str(nullptr, UINT8_MAX);
+    err = attribute::set_val(attr, &null_val);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+    err = attribute::get_val(attr, &val);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+    TEST_ASSERT_NULL(val.val.a.b);
+    TEST_ASSERT_EQUAL(UINT8_MAX, val.val.a.s);
+
+    teardown_for_get_val();
+}
+
 // Nullable Types - ESP Matter Managed
 
 TEST_CASE("get_val nullable uint8 - CurrentLevel", "[get_val][esp_matter_managed][nullable][uint8]")
@@ -0,0 +1,309 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+#include <lib/support/Base64.h>
+#include <nvs.h>
+
+#include "cluster_lifecycle_common.h"
+
+namespace esp_matter::attribute {
+esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                           esp_matter_attr_val_t &val);
+esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                           const esp_matter_attr_val_t &val);
+esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+esp_err_t preload_nvs_values();
+void release_preloaded_nvs_values();
+} // namespace esp_matter::attribute
+
+using namespace esp_matter;
+
+static constexpr uint16_t k_endpoint_id = 0xFFF2;
+static constexpr uint32_t k_cluster_id = 0xFFF1FC10;
+static constexpr uint32_t k_attribute_id = 0x0001;
+static constexpr uint32_t k_string_attribute_id = 0x0002;
+static constexpr uint32_t k_legacy_attribute_id = 0x0003;
+static constexpr uint32_t k_missing_attribute_id = 0x0004;
+// Legacy namespace and key of k_legacy_attribute_id
+static constexpr char k_legacy_namespace[] = "endpoint_FFF2";
+static constexpr char k_legacy_key[] = "FFF1FC10:3";
+
+// Endpoints of the failure cases, with their legacy namespace
+static constexpr uint16_t k_partial_endpoint_id = 0xFFF4;
+static constexpr char k_partial_legacy_namespace[] = "endpoint_FFF4";
+static constexpr uint16_t k_corrupt_endpoint_id = 0xFFF5;
+// Namespace of the attribute values, ESP_MATTER_KVS_NAMESPACE
+static constexpr char k_kvs_namespace[] = "esp_matter_kvs";
+
+static constexpr uint16_t k_benchmark_endpoint_id = 0xFFF3;
+static constexpr uint32_t k_benchmark_count = 100;
+
+static esp_err_t get_legacy_val(uint16_t *val)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, k_legacy_namespace, NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = nvs_get_u16(handle, k_legacy_key, val);
+    nvs_close(handle);
+    return err;
+}
+
+// Same key as the attribute values stored by attribute::store_val_in_nvs()
+static void get_attribute_key(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, char *attribute_key)
+{
+    uint8_t encode_buf[10] = {0};
+    char base64_str[17] = {0};
+    memcpy(&encode_buf[0], &endpoint_id, sizeof(endpoint_id));
+    memcpy(&encode_buf[2], &cluster_id, sizeof(cluster_id));
+    memcpy(&encode_buf[6], &attribute_id, sizeof(attribute_id));
+    chip::Base64Encode(encode_buf, sizeof(encode_buf), base64_str);
+    memcpy(attribute_key, base64_str, 14);
+    attribute_key[14] = 0;
+}
+
+static nvs_handle_t open_namespace(const char *nvs_namespace)
+{
+    nvs_handle_t handle;
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE,
+                                                      &handle));
+    return handle;
+}
+
+static void erase_namespace(const char *nvs_namespace)
+{
+    nvs_handle_t handle = open_namespace(nvs_namespace);
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_erase_all(handle));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(handle));
+    nvs_close(handle);
+}
+
+TEST_CASE("nvs preload returns the stored values and migrates the legacy namespace", "[nvs_preload]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id,
+                                                          esp_matter_uint32(7)));
+    char stored[] = "preloaded";
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_endpoint_id, k_cluster_id, k_string_attribute_id,
+                                                          esp_matter_char_str(stored, strlen(stored))));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+
+    nvs_handle_t handle;
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, k_legacy_namespace,
+                                                      NVS_READWRITE, &handle));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u16(handle, k_legacy_key, 42));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(handle));
+    nvs_close(handle);
+
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::preload_nvs_values());
+
+    esp_matter_attr_val_t val = esp_matter_uint32(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_attribute_id, val));
+    TEST_ASSERT_EQUAL(7, val.val.u32);
+
+    esp_matter_attr_val_t str_val = esp_matter_char_str(nullptr, 0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_string_attribute_id, str_val));
+    TEST_ASSERT_EQUAL(strlen("preloaded"), str_val.val.a.s);
+    TEST_ASSERT_EQUAL_MEMORY("preloaded", str_val.val.a.b, str_val.val.a.s);
+    free(str_val.val.a.b);
+
+    esp_matter_attr_val_t legacy_val = esp_matter_uint16(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_legacy_attribute_id,
+                                                          legacy_val));
+    TEST_ASSERT_EQUAL(42, legacy_val.val.u16);
+
+    esp_matter_attr_val_t missing_val = esp_matter_uint32(0);
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id,
+                                                                         k_missing_attribute_id, missing_val));
+
+    // A value changed after the preload is read from the NVS
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id,
+                                                          esp_matter_uint32(8)));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_attribute_id, val));
+    TEST_ASSERT_EQUAL(8, val.val.u32);
+
+    attribute::release_preloaded_nvs_values();
+
+    // The legacy value is moved to the current namespace
+    uint16_t raw_legacy_val = 0;
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, get_legacy_val(&raw_legacy_val));
+    legacy_val = esp_matter_uint16(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_legacy_attribute_id,
+                                                          legacy_val));
+    TEST_ASSERT_EQUAL(42, legacy_val.val.u16);
+
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_endpoint_id, k_cluster_id, k_string_attribute_id));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_endpoint_id, k_cluster_id, k_legacy_attribute_id));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+}
+
+TEST_CASE("nvs preload completes a partially migrated legacy namespace", "[nvs_preload]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    // The migration of the legacy namespace was interrupted after the first value was stored with the current key
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_partial_endpoint_id, k_cluster_id, 1,
+                                                          esp_matter_uint32(5)));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+    nvs_handle_t handle = open_namespace(k_partial_legacy_namespace);
+    // Outdated by the value of the current namespace
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u32(handle, "FFF1FC10:1", 99));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u16(handle, "FFF1FC10:2", 42));
+    // Primitive value stored as a blob of the whole value, it is read through the NVS after the migration
+    esp_matter_attr_val_t blob_val = esp_matter_uint32(0x12345678);
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_blob(handle, "FFF1FC10:3", &blob_val, sizeof(blob_val)));
+    // Not an attribute value
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u8(handle, "version", 1));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(handle));
+    nvs_close(handle);
+
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::preload_nvs_values());
+
+    esp_matter_attr_val_t val = esp_matter_uint32(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_partial_endpoint_id, k_cluster_id, 1, val));
+    TEST_ASSERT_EQUAL(5, val.val.u32);
+    esp_matter_attr_val_t u16_val = esp_matter_uint16(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_partial_endpoint_id, k_cluster_id, 2, u16_val));
+    TEST_ASSERT_EQUAL(42, u16_val.val.u16);
+    val = esp_matter_uint32(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_partial_endpoint_id, k_cluster_id, 3, val));
+    TEST_ASSERT_EQUAL(0x12345678, val.val.u32);
+    attribute::release_preloaded_nvs_values();
+
+    // The values are read from the current namespace once the preload is released
+    u16_val = esp_matter_uint16(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_partial_endpoint_id, k_cluster_id, 2, u16_val));
+    TEST_ASSERT_EQUAL(42, u16_val.val.u16);
+    handle = open_namespace(k_partial_legacy_namespace);
+    uint16_t raw_val = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, nvs_get_u16(handle, "FFF1FC10:2", &raw_val));
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+    // The whole legacy namespace is erased once its values are migrated
+    uint8_t version = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, nvs_get_u8(handle, "version", &version));
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
+    nvs_close(handle);
+
+    for (uint32_t attribute_id = 1; attribute_id <= 3; ++attribute_id) {
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_partial_endpoint_id, k_cluster_id, attribute_id));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+    erase_namespace(k_partial_legacy_namespace);
+}
+
+TEST_CASE("nvs preload skips the corrupt entries of the walk", "[nvs_preload]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_corrupt_endpoint_id, k_cluster_id, 1,
+                                                          esp_matter_uint32(11)));
+    char stored[] = "after the corrupt entries";
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_corrupt_endpoint_id, k_cluster_id, 5,
+                                                          esp_matter_char_str(stored, strlen(stored))));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+
+    // Entries with the key of an attribute but not written by the attribute storage
+    nvs_handle_t handle = open_namespace(k_kvs_namespace);
+    char attribute_key[16];
+    get_attribute_key(k_corrupt_endpoint_id, k_cluster_id, 2, attribute_key);
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_str(handle, attribute_key, "not a value"));
+    get_attribute_key(k_corrupt_endpoint_id, k_cluster_id, 3, attribute_key);
+    uint8_t float_blob[8] = {0};
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_blob(handle, attribute_key, float_blob, sizeof(float_blob)));
+    get_attribute_key(k_corrupt_endpoint_id, k_cluster_id, 4, attribute_key);
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u8(handle, attribute_key, 7));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(handle));
+    nvs_close(handle);
+
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::preload_nvs_values());
+
+    // The corrupt entries fail like without the preload, the other values are still preloaded
+    esp_matter_attr_val_t val = esp_matter_uint32(0);
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_corrupt_endpoint_id, k_cluster_id, 2, val));
+    esp_matter_attr_val_t float_val = esp_matter_float(0);
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_corrupt_endpoint_id, k_cluster_id, 3, float_val));
+    val = esp_matter_uint32(0);
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_corrupt_endpoint_id, k_cluster_id, 4, val));
+    val = esp_matter_uint32(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_corrupt_endpoint_id, k_cluster_id, 1, val));
+    TEST_ASSERT_EQUAL(11, val.val.u32);
+    esp_matter_attr_val_t str_val = esp_matter_char_str(nullptr, 0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_corrupt_endpoint_id, k_cluster_id, 5, str_val));
+    TEST_ASSERT_EQUAL(strlen(stored), str_val.val.a.s);
+    TEST_ASSERT_EQUAL_MEMORY(stored, str_val.val.a.b, str_val.val.a.s);
+    free(str_val.val.a.b);
+    attribute::release_preloaded_nvs_values();
+
+    for (uint32_t attribute_id = 1; attribute_id <= 5; ++attribute_id) {
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_corrupt_endpoint_id, k_cluster_id, attribute_id));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+}
+
+// Reads the values of k_benchmark_count stored attributes and of as many attributes which were never stored, as
+// attribute::create() does at boot for the non-volatile attributes
+static int64_t read_benchmark_values()
+{
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_benchmark_count; ++i) {
+        esp_matter_attr_val_t val = esp_matter_uint32(0);
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_benchmark_endpoint_id, k_cluster_id, i, val));
+        TEST_ASSERT_EQUAL(i * 3, val.val.u32);
+        TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, attribute::get_val_from_nvs(k_benchmark_endpoint_id, k_cluster_id,
+                                                                             k_benchmark_count + i, val));
+    }
+    return esp_timer_get_time() - start;
+}
+
+TEST_CASE("benchmark non-volatile attribute reads at boot", "[nvs_preload][benchmark]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+#ifdef CONFIG_ESP_MATTER_NVS_PRELOAD
+    printf("nvs preload: enabled\n");
+#else
+    printf("nvs preload: disabled\n");
+#endif
+
+    for (uint32_t i = 0; i < k_benchmark_count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_benchmark_endpoint_id, k_cluster_id, i,
+                                                              esp_matter_uint32(i * 3)));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+
+    attribute::release_preloaded_nvs_values();
+    int64_t per_key_time = read_benchmark_values();
+
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::preload_nvs_values());
+    int64_t preload_time = esp_timer_get_time() - start;
+    int64_t preloaded_time = read_benchmark_values();
+    attribute::release_preloaded_nvs_values();
+
+    printf("%" PRIu32 " stored and %" PRIu32 " missing attributes: per key %" PRId64 " us, preload %" PRId64
+           " us + reads %" PRId64 " us\n", k_benchmark_count, k_benchmark_count, per_key_time, preload_time,
+           preloaded_time);
+
+    for (uint32_t i = 0; i < k_benchmark_count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_benchmark_endpoint_id, k_cluster_id, i));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+}
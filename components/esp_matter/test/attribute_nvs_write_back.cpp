@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+#include <nvs.h>
+
+#include "cluster_lifecycle_common.h"
+
+namespace esp_matter::attribute {
+esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                           esp_matter_attr_val_t &val);
+esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                           const esp_matter_attr_val_t &val);
+esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+} // namespace esp_matter::attribute
+
+using namespace esp_matter;
+
+static constexpr uint16_t k_endpoint_id = 0xFFF0;
+static constexpr uint32_t k_cluster_id = 0xFFF1FC10;
+static constexpr uint32_t k_attribute_id = 0x0001;
+static constexpr uint32_t k_string_attribute_id = 0x0002;
+static constexpr uint32_t k_writes = 100;
+
+TEST_CASE("nvs reads return the latest stored value", "[nvs_cache]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    for (uint32_t i = 1; i <= 10; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id,
+                                                              esp_matter_uint32(i)));
+    }
+    esp_matter_attr_val_t val = esp_matter_uint32(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_attribute_id, val));
+    TEST_ASSERT_EQUAL(10, val.val.u32);
+
+    char stored[] = "write-back";
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_endpoint_id, k_cluster_id, k_string_attribute_id,
+                                                          esp_matter_char_str(stored, strlen(stored))));
+    // The cached value must not alias the buffer of the caller
+    memset(stored, 0, sizeof(stored));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+    esp_matter_attr_val_t str_val = esp_matter_char_str(nullptr, 0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_string_attribute_id, str_val));
+    TEST_ASSERT_EQUAL(strlen("write-back"), str_val.val.a.s);
+    TEST_ASSERT_EQUAL_MEMORY("write-back", str_val.val.a.b, str_val.val.a.s);
+    free(str_val.val.a.b);
+
+    // An erase overrides a pending value
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id,
+                                                          esp_matter_uint32(11)));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_endpoint_id, k_cluster_id, k_string_attribute_id));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND,
+                      attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_attribute_id, val));
+}
+
+TEST_CASE("benchmark non-volatile attribute stores", "[nvs_cache][benchmark]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BACK_CACHE
+    printf("nvs write-back cache: enabled\n");
+#else
+    printf("nvs write-back cache: disabled\n");
+#endif
+
+    // A light being dimmed continuously changes the same attribute at a high rate
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_writes; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::store_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id,
+                                                              esp_matter_uint32(i)));
+    }
+    int64_t store_time = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+    int64_t flush_time = esp_timer_get_time() - start;
+
+    printf("store_val_in_nvs(): %" PRId64 " us/store, flush: %" PRId64 " us\n", store_time / k_writes, flush_time);
+
+    esp_matter_attr_val_t val = esp_matter_uint32(0);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val_from_nvs(k_endpoint_id, k_cluster_id, k_attribute_id, val));
+    TEST_ASSERT_EQUAL(k_writes - 1, val.val.u32);
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::erase_val_in_nvs(k_endpoint_id, k_cluster_id, k_attribute_id));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::flush_persistent_values());
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+#include <esp_matter_data_model_provider.h>
+
+#include "cluster_lifecycle_common.h"
+
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+namespace esp_matter::attribute {
+void get_read_cache_stats(uint32_t &hits, uint32_t &misses);
+} // namespace esp_matter::attribute
+#endif // CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+
+using namespace esp_matter;
+using namespace chip::app::Clusters;
+
+static constexpr uint16_t k_root_endpoint_id = 0;
+static constexpr uint32_t k_iterations = 200;
+
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+static void read_vendor_name(const char *expected)
+{
+    esp_matter_attr_val_t val;
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val(k_root_endpoint_id, BasicInformation::Id,
+                                                 BasicInformation::Attributes::VendorName::Id, &val));
+    TEST_ASSERT_EQUAL(ESP_MATTER_VAL_TYPE_CHAR_STRING, val.type);
+    TEST_ASSERT_NOT_NULL(val.val.a.b);
+    TEST_ASSERT_EQUAL(strlen(expected), val.val.a.s);
+    TEST_ASSERT_EQUAL_MEMORY(expected, val.val.a.b, val.val.a.s);
+    // The caller owns a copy, the cached value must survive it
+    memset(val.val.a.b, 0, val.val.a.s);
+    free(val.val.a.b);
+}
+
+TEST_CASE("cached reads are dropped when the attribute is reported as changed", "[read_cache]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    attribute::invalidate_read_cache(chip::kInvalidEndpointId, chip::kInvalidClusterId, chip::kInvalidAttributeId);
+    uint32_t hits = 0, misses = 0;
+    attribute::get_read_cache_stats(hits, misses);
+
+    read_vendor_name("TEST_VENDOR");
+    read_vendor_name("TEST_VENDOR");
+    uint32_t new_hits = 0, new_misses = 0;
+    attribute::get_read_cache_stats(new_hits, new_misses);
+    TEST_ASSERT_EQUAL(hits + 1, new_hits);
+    TEST_ASSERT_EQUAL(misses + 1, new_misses);
+
+    // A reported change drops the entry
+    data_model::provider::get_instance().ReportAttributeChanged(chip::app::AttributePathParams(
+            k_root_endpoint_id, BasicInformation::Id, BasicInformation::Attributes::VendorName::Id));
+    read_vendor_name("TEST_VENDOR");
+    attribute::get_read_cache_stats(hits, misses);
+    TEST_ASSERT_EQUAL(new_hits, hits);
+    TEST_ASSERT_EQUAL(new_misses + 1, misses);
+
+    // So does a wildcard invalidation
+    read_vendor_name("TEST_VENDOR");
+    attribute::invalidate_read_cache(k_root_endpoint_id, chip::kInvalidClusterId, chip::kInvalidAttributeId);
+    read_vendor_name("TEST_VENDOR");
+    attribute::get_read_cache_stats(new_hits, new_misses);
+    TEST_ASSERT_EQUAL(hits + 1, new_hits);
+    TEST_ASSERT_EQUAL(misses + 1, new_misses);
+}
+#endif // CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+
+TEST_CASE("benchmark reads of attributes managed by connectedhomeip", "[read_cache][benchmark]")
+{
+    test::get_or_create_node();
+    test::start_matter_if_needed();
+
+#ifdef CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE
+    printf("attribute read cache: enabled, %d entries\n", CONFIG_ESP_MATTER_INTERNAL_ATTRIBUTE_READ_CACHE_SIZE);
+#else
+    printf("attribute read cache: disabled\n");
+#endif
+
+    attribute_t *attribute = attribute::get(k_root_endpoint_id, BasicInformation::Id,
+                                            BasicInformation::Attributes::SoftwareVersion::Id);
+    TEST_ASSERT_NOT_NULL(attribute);
+
+    // Application code polling the software version, the cache is dropped before every read of the second loop
+    int64_t times[2];
+    for (int uncached = 0; uncached < 2; ++uncached) {
+        int64_t start = esp_timer_get_time();
+        for (uint32_t i = 0; i < k_iterations; ++i) {
+            if (uncached) {
+                attribute::invalidate_read_cache(k_root_endpoint_id, BasicInformation::Id,
+                                                 BasicInformation::Attributes::SoftwareVersion::Id);
+            }
+            esp_matter_attr_val_t val;
+            TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val(attribute, &val));
+            TEST_ASSERT_EQUAL(ESP_MATTER_VAL_TYPE_UINT32, val.type);
+        }
+        times[uncached] = esp_timer_get_time() - start;
+    }
+
+    printf("get_val(): %" PRId64 " us/read, without cache: %" PRId64 " us/read\n", times[0] / k_iterations,
+           times[1] / k_iterations);
+}
@@ -3,7 +3,11 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <inttypes.h>
+#include <stdio.h>
 #include <unity.h>
+#include <esp_log.h>
+#include <esp_timer.h>
 #include <esp_matter.h>
 #include <esp_matter_core.h>
 #include <nvs_flash.h>
@@ -306,3 +310,188 @@ TEST_CASE("update and report both store the value correctly", "[update][report_p
 
     teardown_for_update_report();
 }
+
+// ============================================================
+// attribute::update_batch() and attribute::report_batch() tests
+// ============================================================
+
+static chip::DataVersion get_cluster_data_version(uint32_t cluster_id)
+{
+    chip::DataVersion data_version = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, cluster::get_data_version(cluster::get(test_endpoint_id, cluster_id), data_version));
+    return data_version;
+}
+
+TEST_CASE("update_batch returns ESP_ERR_INVALID_ARG without applying any value", "[update][batch][invalid]")
+{
+    setup_for_update_report();
+
+    esp_matter_attr_val_t level = esp_matter_attr_val(nullable<uint8_t>(21));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::update(test_endpoint_id, LevelControl::Id,
+                                                LevelControl::Attributes::CurrentLevel::Id, &level));
+
+    esp_matter_attr_val_t new_level = esp_matter_attr_val(nullable<uint8_t>(22));
+    esp_matter_attr_val_t invalid = esp_matter_attr_val(nullable<uint8_t>(0));
+    attribute::batch_entry_t entries[] = {
+        { test_endpoint_id, LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id, &new_level },
+        { test_endpoint_id, LevelControl::Id, 0xFFFE, &invalid },
+    };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, attribute::update_batch(entries, 2));
+
+    entries[1] = { test_endpoint_id, LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id, nullptr };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, attribute::update_batch(entries, 2));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, attribute::update_batch(nullptr, 1));
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::update_batch(nullptr, 0));
+
+    esp_matter_attr_val_t stored;
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val(test_endpoint_id, LevelControl::Id,
+                                                 LevelControl::Attributes::CurrentLevel::Id, &stored));
+    TEST_ASSERT_EQUAL(21, stored.val.u8);
+
+    teardown_for_update_report();
+}
+
+TEST_CASE("update_batch stores values and increases the data version once per cluster", "[update][batch]")
+{
+    setup_for_update_report();
+
+    esp_matter_attr_val_t current_x = esp_matter_attr_val((uint16_t)1000);
+    esp_matter_attr_val_t current_y = esp_matter_attr_val((uint16_t)2000);
+    esp_matter_attr_val_t level = esp_matter_attr_val(nullable<uint8_t>(33));
+    attribute::batch_entry_t entries[] = {
+        { test_endpoint_id, ColorControl::Id, ColorControl::Attributes::CurrentX::Id, &current_x },
+        { test_endpoint_id, ColorControl::Id, ColorControl::Attributes::CurrentY::Id, &current_y },
+        { test_endpoint_id, LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id, &level },
+    };
+
+    chip::DataVersion color_version = get_cluster_data_version(ColorControl::Id);
+    chip::DataVersion level_version = get_cluster_data_version(LevelControl::Id);
+
+    reset_callback_records();
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::update_batch(entries, 3));
+    TEST_ASSERT_TRUE(cb_pre_update.called);
+    TEST_ASSERT_TRUE(cb_post_update.called);
+    // The callbacks are called in the order of the entries
+    TEST_ASSERT_EQUAL(LevelControl::Id, cb_post_update.cluster_id);
+
+    TEST_ASSERT_EQUAL(color_version + 1, get_cluster_data_version(ColorControl::Id));
+    TEST_ASSERT_EQUAL(level_version + 1, get_cluster_data_version(LevelControl::Id));
+
+    esp_matter_attr_val_t stored;
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val(test_endpoint_id, ColorControl::Id,
+                                                 ColorControl::Attributes::CurrentY::Id, &stored));
+    TEST_ASSERT_EQUAL(2000, stored.val.u16);
+
+    // Unchanged values are not reported
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::update_batch(entries, 3));
+    TEST_ASSERT_EQUAL(color_version + 1, get_cluster_data_version(ColorControl::Id));
+    TEST_ASSERT_EQUAL(level_version + 1, get_cluster_data_version(LevelControl::Id));
+
+    teardown_for_update_report();
+}
+
+TEST_CASE("report_batch does not call attribute callbacks", "[report][batch][callback]")
+{
+    setup_for_update_report();
+    reset_callback_records();
+
+    esp_matter_attr_val_t current_x = esp_matter_attr_val((uint16_t)3000);
+    attribute::batch_entry_t entry = { test_endpoint_id, ColorControl::Id, ColorControl::Attributes::CurrentX::Id,
+                                       &current_x };
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::report_batch(&entry, 1));
+    TEST_ASSERT_FALSE(cb_pre_update.called);
+    TEST_ASSERT_FALSE(cb_post_update.called);
+
+    esp_matter_attr_val_t stored;
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val(test_endpoint_id, ColorControl::Id,
+                                                 ColorControl::Attributes::CurrentX::Id, &stored));
+    TEST_ASSERT_EQUAL(3000, stored.val.u16);
+
+    teardown_for_update_report();
+}
+
+TEST_CASE("benchmark update_batch against per attribute update", "[update][batch][benchmark]")
+{
+    setup_for_update_report();
+
+    static constexpr uint32_t k_samples = 100;
+    static const uint32_t k_attribute_ids[] = {
+        ColorControl::Attributes::CurrentX::Id,
+        ColorControl::Attributes::CurrentY::Id,
+        ColorControl::Attributes::ColorTemperatureMireds::Id,
+        ColorControl::Attributes::RemainingTime::Id,
+    };
+    static constexpr size_t k_count = sizeof(k_attribute_ids) / sizeof(k_attribute_ids[0]);
+
+    esp_matter_attr_val_t vals[k_count];
+    attribute::batch_entry_t entries[k_count];
+    for (size_t i = 0; i < k_count; ++i) {
+        entries[i] = { test_endpoint_id, ColorControl::Id, k_attribute_ids[i], &vals[i] };
+    }
+
+    // The attribute write logs would dominate the measurement
+    esp_log_level_set("esp_matter_attribute", ESP_LOG_WARN);
+
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    lock::stats_t loop_lock_stats, batch_lock_stats;
+    lock::reset_stats();
+#endif
+    chip::DataVersion start_version = get_cluster_data_version(ColorControl::Id);
+    int64_t start = esp_timer_get_time();
+    for (uint32_t sample = 0; sample < k_samples; ++sample) {
+        for (size_t i = 0; i < k_count; ++i) {
+            // Keep the color temperature in the mireds range of the cluster
+            vals[i] = esp_matter_attr_val((uint16_t)(200 + (sample % 2) * 10 + i));
+            TEST_ASSERT_EQUAL(ESP_OK, attribute::update(test_endpoint_id, ColorControl::Id, k_attribute_ids[i],
+                                                        &vals[i]));
+        }
+    }
+    int64_t loop_time = esp_timer_get_time() - start;
+    chip::DataVersion loop_reports = get_cluster_data_version(ColorControl::Id) - start_version;
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    lock::get_stats(&loop_lock_stats);
+    lock::reset_stats();
+#endif
+
+    start_version = get_cluster_data_version(ColorControl::Id);
+    start = esp_timer_get_time();
+    for (uint32_t sample = 0; sample < k_samples; ++sample) {
+        for (size_t i = 0; i < k_count; ++i) {
+            vals[i] = esp_matter_attr_val((uint16_t)(220 + (sample % 2) * 10 + i));
+        }
+        TEST_ASSERT_EQUAL(ESP_OK, attribute::update_batch(entries, k_count));
+    }
+    int64_t batch_time = esp_timer_get_time() - start;
+    chip::DataVersion batch_reports = get_cluster_data_version(ColorControl::Id) - start_version;
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    lock::get_stats(&batch_lock_stats);
+#endif
+
+    esp_log_level_set("esp_matter_attribute", ESP_LOG_INFO);
+
+    printf("%u attributes x %" PRIu32 " samples\n", (unsigned)k_count, k_samples);
+    printf("update(): %" PRId64 " us/sample, %" PRIu32 " reports\n", loop_time / k_samples, (uint32_t)loop_reports);
+    printf("update_batch(): %" PRId64 " us/sample, %" PRIu32 " reports\n", batch_time / k_samples,
+           (uint32_t)batch_reports);
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    printf("update(): %" PRIu32 " lock acquisitions, held %" PRId64 " us/sample, %" PRId64 " us max\n",
+           loop_lock_stats.acquisitions, loop_lock_stats.total_hold_time_us / k_samples,
+           loop_lock_stats.max_hold_time_us);
+    printf("update_batch(): %" PRIu32 " lock acquisitions, held %" PRId64 " us/sample, %" PRId64 " us max\n",
+           batch_lock_stats.acquisitions, batch_lock_stats.total_hold_time_us / k_samples,
+           batch_lock_stats.max_hold_time_us);
+#else
+    printf("Enable CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS for the lock acquisitions and hold times\n");
+#endif
+
+    TEST_ASSERT_EQUAL(k_count * k_samples, loop_reports);
+    TEST_ASSERT_EQUAL(k_samples, batch_reports);
+#ifdef CONFIG_ESP_MATTER_CHIP_STACK_LOCK_STATS
+    // One acquisition per attribute or per batch, the test task is the only one taking the lock with the scoped lock
+    TEST_ASSERT_EQUAL(k_count * k_samples, loop_lock_stats.acquisitions);
+    TEST_ASSERT_EQUAL(k_samples, batch_lock_stats.acquisitions);
+    TEST_ASSERT_TRUE(batch_lock_stats.max_hold_time_us <= batch_lock_stats.total_hold_time_us);
+#endif
+
+    teardown_for_update_report();
+}
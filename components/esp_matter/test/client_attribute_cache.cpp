@@ -0,0 +1,459 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter_client_cache.h>
+
+#include <app/ReadClient.h>
+#include <lib/core/TLV.h>
+
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+
+using namespace esp_matter::client;
+using chip::app::AttributePathParams;
+using chip::app::ConcreteDataAttributePath;
+using chip::app::DataVersionFilterIBs;
+using chip::app::ReadClient;
+using chip::app::StatusIB;
+using chip::TLV::TLVReader;
+using chip::TLV::TLVWriter;
+
+static constexpr uint64_t k_node_id = 0x1234;
+static constexpr uint16_t k_endpoint_id = 1;
+static constexpr uint32_t k_on_off_cluster_id = 0x0006;
+static constexpr uint32_t k_level_cluster_id = 0x0008;
+static constexpr uint32_t k_attribute_list_id = 0xFFFB;
+static constexpr uint32_t k_cluster_revision_id = 0xFFFD;
+static constexpr size_t k_attribute_count = 3;
+static constexpr size_t k_max_filters = 8;
+static constexpr uint32_t k_reads = 1000;
+
+// Clusters of the remote node, with the OnOff or CurrentLevel attribute, the AttributeList and the ClusterRevision
+struct fake_cluster_t {
+    uint32_t cluster_id;
+    chip::DataVersion data_version;
+    uint32_t value;
+};
+
+// The ReadClient::Callback of a subscription which feeds the cache, like the controller subscribe_command
+class cached_subscription : public ReadClient::Callback {
+public:
+    void OnAttributeData(const ConcreteDataAttributePath &path, TLVReader *data, const StatusIB &status) override
+    {
+        TEST_ASSERT_EQUAL(ESP_OK, cache::update_attribute(k_node_id, path, data, status));
+        m_attribute_data_count++;
+    }
+
+    void OnEventData(const chip::app::EventHeader &event_header, TLVReader *data, const StatusIB *status) override
+    {
+        cache::update_event(k_node_id, event_header);
+    }
+
+    void OnReportEnd() override
+    {
+        cache::end_report(k_node_id, m_attr_paths);
+    }
+
+    void OnDone(ReadClient *apReadClient) override {}
+
+    CHIP_ERROR OnUpdateDataVersionFilterList(DataVersionFilterIBs::Builder &aDataVersionFilterIBsBuilder,
+                                             const chip::Span<AttributePathParams> &aAttributePaths,
+                                             bool &aEncodedDataVersionList) override
+    {
+        return cache::encode_data_version_filters(k_node_id, aDataVersionFilterIBsBuilder, aAttributePaths,
+                                                  aEncodedDataVersionList);
+    }
+
+    uint32_t m_attribute_data_count = 0;
+    chip::Span<AttributePathParams> m_attr_paths;
+};
+
+// Loopback of a ReadClient and the remote node: the request asks the callback for the DataVersionFilters, and the
+// node reports the attributes of the clusters which are not filtered out.
+class loopback_read_client {
+public:
+    loopback_read_client(cached_subscription &callback, fake_cluster_t *clusters, size_t cluster_count)
+        : m_callback(callback), m_clusters(clusters), m_cluster_count(cluster_count)
+    {
+    }
+
+    // Returns the number of filters of the request
+    size_t subscribe(AttributePathParams *attr_paths, size_t attr_path_count, size_t request_size = sizeof(m_request))
+    {
+        m_callback.m_attr_paths = chip::Span<AttributePathParams>(attr_paths, attr_path_count);
+        size_t filter_count = encode_request(attr_paths, attr_path_count, request_size);
+        m_callback.OnReportBegin();
+        for (size_t i = 0; i < m_cluster_count; ++i) {
+            if (is_filtered(m_clusters[i], filter_count)) {
+                continue;
+            }
+            for (size_t p = 0; p < attr_path_count; ++p) {
+                report_cluster(m_clusters[i], attr_paths[p]);
+            }
+        }
+        m_callback.OnReportEnd();
+        return filter_count;
+    }
+
+    void report_attribute(uint32_t cluster_id, uint32_t attribute_id, uint32_t value, bool with_data_version)
+    {
+        fake_cluster_t *cluster = find_cluster(cluster_id);
+        TEST_ASSERT_NOT_NULL(cluster);
+        ConcreteDataAttributePath path(k_endpoint_id, cluster_id, attribute_id);
+        if (with_data_version) {
+            path.mDataVersion.SetValue(cluster->data_version);
+        }
+        uint8_t buffer[16];
+        TLVReader reader;
+        encode_uint(buffer, sizeof(buffer), value, reader);
+        m_callback.OnReportBegin();
+        m_callback.OnAttributeData(path, &reader, StatusIB());
+        m_callback.OnReportEnd();
+    }
+
+    void report_error(uint32_t cluster_id, uint32_t attribute_id)
+    {
+        ConcreteDataAttributePath path(k_endpoint_id, cluster_id, attribute_id);
+        m_callback.OnReportBegin();
+        m_callback.OnAttributeData(path, nullptr,
+                                   StatusIB(chip::Protocols::InteractionModel::Status::UnsupportedAttribute));
+        m_callback.OnReportEnd();
+    }
+
+    chip::DataVersion get_filter_data_version(size_t index)
+    {
+        return m_filters[index].data_version;
+    }
+
+private:
+    struct filter_t {
+        uint16_t endpoint_id;
+        uint32_t cluster_id;
+        chip::DataVersion data_version;
+    };
+
+    fake_cluster_t *find_cluster(uint32_t cluster_id)
+    {
+        for (size_t i = 0; i < m_cluster_count; ++i) {
+            if (m_clusters[i].cluster_id == cluster_id) {
+                return &m_clusters[i];
+            }
+        }
+        return nullptr;
+    }
+
+    static void encode_uint(uint8_t *buffer, size_t size, uint32_t value, TLVReader &reader)
+    {
+        TLVWriter writer;
+        writer.Init(buffer, size);
+        TEST_ASSERT_TRUE(writer.Put(chip::TLV::AnonymousTag(), value) == CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(writer.Finalize() == CHIP_NO_ERROR);
+        reader.Init(buffer, writer.GetLengthWritten());
+        TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+    }
+
+    size_t encode_request(AttributePathParams *attr_paths, size_t attr_path_count, size_t request_size)
+    {
+        TLVWriter writer;
+        writer.Init(m_request, request_size);
+        chip::TLV::TLVType outer;
+        TEST_ASSERT_TRUE(writer.StartContainer(chip::TLV::AnonymousTag(), chip::TLV::kTLVType_Structure, outer) ==
+                         CHIP_NO_ERROR);
+        DataVersionFilterIBs::Builder builder;
+        if (builder.Init(&writer, 0) != CHIP_NO_ERROR) {
+            return 0;
+        }
+        bool encoded = false;
+        TEST_ASSERT_TRUE(m_callback.OnUpdateDataVersionFilterList(
+                             builder, chip::Span<AttributePathParams>(attr_paths, attr_path_count), encoded) ==
+                         CHIP_NO_ERROR);
+        VerifyOrReturnValue(encoded, 0);
+        TEST_ASSERT_TRUE(builder.EndOfDataVersionFilterIBs() == CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(writer.EndContainer(outer) == CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(writer.Finalize() == CHIP_NO_ERROR);
+        return parse_filters(writer.GetLengthWritten());
+    }
+
+    size_t parse_filters(size_t request_len)
+    {
+        TLVReader reader;
+        reader.Init(m_request, request_len);
+        chip::TLV::TLVType outer;
+        TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(reader.EnterContainer(outer) == CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+        DataVersionFilterIBs::Parser filters;
+        TEST_ASSERT_TRUE(filters.Init(reader) == CHIP_NO_ERROR);
+        TLVReader filters_reader;
+        filters.GetReader(&filters_reader);
+        size_t count = 0;
+        while (filters_reader.Next() == CHIP_NO_ERROR) {
+            TEST_ASSERT_LESS_THAN(k_max_filters, count);
+            chip::app::DataVersionFilterIB::Parser filter;
+            TEST_ASSERT_TRUE(filter.Init(filters_reader) == CHIP_NO_ERROR);
+            chip::app::ClusterPathIB::Parser path;
+            TEST_ASSERT_TRUE(filter.GetPath(&path) == CHIP_NO_ERROR);
+            TEST_ASSERT_TRUE(path.GetEndpoint(&m_filters[count].endpoint_id) == CHIP_NO_ERROR);
+            TEST_ASSERT_TRUE(path.GetCluster(&m_filters[count].cluster_id) == CHIP_NO_ERROR);
+            TEST_ASSERT_TRUE(filter.GetDataVersion(&m_filters[count].data_version) == CHIP_NO_ERROR);
+            count++;
+        }
+        return count;
+    }
+
+    bool is_filtered(const fake_cluster_t &cluster, size_t filter_count)
+    {
+        for (size_t i = 0; i < filter_count; ++i) {
+            if (m_filters[i].endpoint_id == k_endpoint_id && m_filters[i].cluster_id == cluster.cluster_id &&
+                    m_filters[i].data_version == cluster.data_version) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void report_cluster(const fake_cluster_t &cluster, const AttributePathParams &attr_path)
+    {
+        if ((!attr_path.HasWildcardEndpointId() && attr_path.mEndpointId != k_endpoint_id) ||
+                (!attr_path.HasWildcardClusterId() && attr_path.mClusterId != cluster.cluster_id)) {
+            return;
+        }
+        const uint32_t attribute_ids[k_attribute_count] = { 0, k_attribute_list_id, k_cluster_revision_id };
+        for (uint32_t attribute_id : attribute_ids) {
+            if (!attr_path.HasWildcardAttributeId() && attr_path.mAttributeId != attribute_id) {
+                continue;
+            }
+            uint8_t buffer[32];
+            TLVReader reader;
+            if (attribute_id == k_attribute_list_id) {
+                TLVWriter writer;
+                writer.Init(buffer);
+                chip::TLV::TLVType outer;
+                TEST_ASSERT_TRUE(writer.StartContainer(chip::TLV::AnonymousTag(), chip::TLV::kTLVType_Array, outer) ==
+                                 CHIP_NO_ERROR);
+                for (uint32_t id : attribute_ids) {
+                    TEST_ASSERT_TRUE(writer.Put(chip::TLV::AnonymousTag(), id) == CHIP_NO_ERROR);
+                }
+                TEST_ASSERT_TRUE(writer.EndContainer(outer) == CHIP_NO_ERROR);
+                TEST_ASSERT_TRUE(writer.Finalize() == CHIP_NO_ERROR);
+                reader.Init(buffer, writer.GetLengthWritten());
+                TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+            } else {
+                encode_uint(buffer, sizeof(buffer), attribute_id ? 5 : cluster.value, reader);
+            }
+            ConcreteDataAttributePath path(k_endpoint_id, cluster.cluster_id, attribute_id);
+            path.mDataVersion.SetValue(cluster.data_version);
+            m_callback.OnAttributeData(path, &reader, StatusIB());
+        }
+    }
+
+    cached_subscription &m_callback;
+    fake_cluster_t *m_clusters;
+    size_t m_cluster_count;
+    uint8_t m_request[256];
+    filter_t m_filters[k_max_filters];
+};
+
+static uint32_t get_cached_uint(uint32_t cluster_id, uint32_t attribute_id)
+{
+    uint8_t buffer[16];
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, cache::get_attribute(k_node_id, k_endpoint_id, cluster_id, attribute_id, buffer,
+                                                   sizeof(buffer), &len));
+    TLVReader reader;
+    reader.Init(buffer, len);
+    TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+    uint32_t value = 0;
+    TEST_ASSERT_TRUE(reader.Get(value) == CHIP_NO_ERROR);
+    return value;
+}
+
+TEST_CASE("subscription reports are cached and resubscribed with data version filters", "[client_cache]")
+{
+    cache::remove_node(chip::kUndefinedNodeId);
+    fake_cluster_t clusters[] = {
+        { k_on_off_cluster_id, 100, 1 },
+        { k_level_cluster_id, 200, 254 },
+    };
+    cached_subscription subscription;
+    loopback_read_client client(subscription, clusters, 2);
+    AttributePathParams wildcard(k_endpoint_id, chip::kInvalidClusterId, chip::kInvalidAttributeId);
+
+    // The first subscription reports everything
+    TEST_ASSERT_EQUAL(0, client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(2 * k_attribute_count, subscription.m_attribute_data_count);
+    TEST_ASSERT_EQUAL(1, get_cached_uint(k_on_off_cluster_id, 0));
+    TEST_ASSERT_EQUAL(254, get_cached_uint(k_level_cluster_id, 0));
+    chip::DataVersion data_version = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, cache::get_data_version(k_node_id, k_endpoint_id, k_on_off_cluster_id, data_version));
+    TEST_ASSERT_EQUAL(100, data_version);
+
+    // Nothing changed, nothing is reported again
+    subscription.m_attribute_data_count = 0;
+    TEST_ASSERT_EQUAL(2, client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(0, subscription.m_attribute_data_count);
+
+    // Only the changed cluster is reported
+    clusters[1].data_version++;
+    clusters[1].value = 10;
+    TEST_ASSERT_EQUAL(2, client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(k_attribute_count, subscription.m_attribute_data_count);
+    TEST_ASSERT_EQUAL(10, get_cached_uint(k_level_cluster_id, 0));
+    TEST_ASSERT_EQUAL(ESP_OK, cache::get_data_version(k_node_id, k_endpoint_id, k_level_cluster_id, data_version));
+    TEST_ASSERT_EQUAL(201, data_version);
+
+    // A filter requires the requested attributes to be cached
+    AttributePathParams unknown_attribute(k_endpoint_id, k_on_off_cluster_id, 0x4000);
+    TEST_ASSERT_EQUAL(0, client.subscribe(&unknown_attribute, 1));
+    AttributePathParams on_off(k_endpoint_id, k_on_off_cluster_id, 0);
+    TEST_ASSERT_EQUAL(1, client.subscribe(&on_off, 1));
+    TEST_ASSERT_EQUAL(100, client.get_filter_data_version(0));
+
+    // An attribute data without data version invalidates the one of the cluster
+    client.report_attribute(k_on_off_cluster_id, 0, 0, false);
+    TEST_ASSERT_EQUAL(0, get_cached_uint(k_on_off_cluster_id, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND,
+                      cache::get_data_version(k_node_id, k_endpoint_id, k_on_off_cluster_id, data_version));
+    subscription.m_attribute_data_count = 0;
+    TEST_ASSERT_EQUAL(1, client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(k_attribute_count, subscription.m_attribute_data_count);
+    TEST_ASSERT_EQUAL(1, get_cached_uint(k_on_off_cluster_id, 0));
+
+    // An error status drops the value, and the cluster is reported again
+    client.report_error(k_level_cluster_id, k_cluster_revision_id);
+    uint8_t buffer[16];
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, cache::get_attribute(k_node_id, k_endpoint_id, k_level_cluster_id,
+                                                              k_cluster_revision_id, buffer, sizeof(buffer), &len));
+    TEST_ASSERT_EQUAL(1, client.subscribe(&wildcard, 1));
+
+    // The filters which do not fit in the request are left out
+    TEST_ASSERT_EQUAL(2, client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(1, client.subscribe(&wildcard, 1, 24));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, cache::get_attribute(k_node_id, k_endpoint_id, k_level_cluster_id,
+                                                                 k_attribute_list_id, buffer, 4, &len));
+    TEST_ASSERT_GREATER_THAN(4, len);
+
+    chip::app::EventHeader event_header;
+    event_header.mPath = chip::app::ConcreteEventPath(k_endpoint_id, k_on_off_cluster_id, 0);
+    chip::EventNumber event_number = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, cache::get_highest_event_number(k_node_id, event_number));
+    event_header.mEventNumber = 7;
+    subscription.OnEventData(event_header, nullptr, nullptr);
+    event_header.mEventNumber = 3;
+    subscription.OnEventData(event_header, nullptr, nullptr);
+    TEST_ASSERT_EQUAL(ESP_OK, cache::get_highest_event_number(k_node_id, event_number));
+    TEST_ASSERT_EQUAL(7, event_number);
+
+    cache::remove_node(k_node_id);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, cache::get_attribute(k_node_id, k_endpoint_id, k_on_off_cluster_id, 0, buffer,
+                                                              sizeof(buffer), &len));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, cache::get_highest_event_number(k_node_id, event_number));
+    TEST_ASSERT_EQUAL(0, client.subscribe(&wildcard, 1));
+    cache::remove_node(chip::kUndefinedNodeId);
+}
+
+TEST_CASE("a cluster reported to another interaction is not filtered", "[client_cache]")
+{
+    cache::remove_node(chip::kUndefinedNodeId);
+    fake_cluster_t cluster = { k_on_off_cluster_id, 100, 1 };
+    cached_subscription all_attributes;
+    loopback_read_client all_attributes_client(all_attributes, &cluster, 1);
+    cached_subscription on_off;
+    loopback_read_client on_off_client(on_off, &cluster, 1);
+    AttributePathParams wildcard(k_endpoint_id, k_on_off_cluster_id, chip::kInvalidAttributeId);
+    AttributePathParams on_off_path(k_endpoint_id, k_on_off_cluster_id, 0);
+
+    TEST_ASSERT_EQUAL(0, all_attributes_client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(1, all_attributes_client.subscribe(&wildcard, 1));
+
+    // The other interaction only sees the OnOff attribute of the new data version
+    cluster.data_version++;
+    cluster.value = 0;
+    TEST_ASSERT_EQUAL(1, on_off_client.subscribe(&on_off_path, 1));
+    TEST_ASSERT_EQUAL(1, on_off.m_attribute_data_count);
+    chip::DataVersion data_version = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, cache::get_data_version(k_node_id, k_endpoint_id, k_on_off_cluster_id, data_version));
+    TEST_ASSERT_EQUAL(101, data_version);
+    TEST_ASSERT_EQUAL(1, on_off_client.subscribe(&on_off_path, 1));
+    TEST_ASSERT_EQUAL(101, on_off_client.get_filter_data_version(0));
+
+    // The attributes of the cluster are only known at the previous data version, the wildcard is reported again
+    all_attributes.m_attribute_data_count = 0;
+    TEST_ASSERT_EQUAL(0, all_attributes_client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(k_attribute_count, all_attributes.m_attribute_data_count);
+    TEST_ASSERT_EQUAL(1, all_attributes_client.subscribe(&wildcard, 1));
+    TEST_ASSERT_EQUAL(101, all_attributes_client.get_filter_data_version(0));
+    cache::remove_node(chip::kUndefinedNodeId);
+}
+
+TEST_CASE("events do not evict the cached clusters", "[client_cache]")
+{
+    cache::remove_node(chip::kUndefinedNodeId);
+    fake_cluster_t cluster = { k_on_off_cluster_id, 100, 1 };
+    cached_subscription subscription;
+    loopback_read_client client(subscription, &cluster, 1);
+    AttributePathParams wildcard(k_endpoint_id, chip::kInvalidClusterId, chip::kInvalidAttributeId);
+    TEST_ASSERT_EQUAL(0, client.subscribe(&wildcard, 1));
+
+    chip::app::EventHeader event_header;
+    for (uint32_t i = 0; i < 2 * CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE_CLUSTER_COUNT; ++i) {
+        event_header.mPath = chip::app::ConcreteEventPath(k_endpoint_id, 0x1000 + i, 0);
+        event_header.mEventNumber = i;
+        subscription.OnEventData(event_header, nullptr, nullptr);
+    }
+    TEST_ASSERT_EQUAL(1, get_cached_uint(k_on_off_cluster_id, 0));
+    TEST_ASSERT_EQUAL(1, client.subscribe(&wildcard, 1));
+    chip::EventNumber event_number = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, cache::get_highest_event_number(k_node_id, event_number));
+    TEST_ASSERT_EQUAL(2 * CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE_CLUSTER_COUNT - 1, event_number);
+
+    // The event numbers of the least recently updated node are dropped when the table is full
+    for (uint64_t node_id = 1; node_id <= CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE_EVENT_NODE_COUNT; ++node_id) {
+        cache::update_event(k_node_id + node_id, event_header);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, cache::get_highest_event_number(k_node_id, event_number));
+    TEST_ASSERT_EQUAL(ESP_OK, cache::get_highest_event_number(k_node_id + 1, event_number));
+    TEST_ASSERT_EQUAL(1, get_cached_uint(k_on_off_cluster_id, 0));
+    cache::remove_node(chip::kUndefinedNodeId);
+}
+
+TEST_CASE("benchmark cached attribute reads and resubscriptions", "[client_cache][benchmark]")
+{
+    cache::remove_node(chip::kUndefinedNodeId);
+    fake_cluster_t clusters[] = {
+        { k_on_off_cluster_id, 100, 1 },
+        { k_level_cluster_id, 200, 254 },
+    };
+    cached_subscription subscription;
+    loopback_read_client client(subscription, clusters, 2);
+    AttributePathParams wildcard(k_endpoint_id, chip::kInvalidClusterId, chip::kInvalidAttributeId);
+    client.subscribe(&wildcard, 1);
+    uint32_t full_report = subscription.m_attribute_data_count;
+
+    // The application polling the state of the remote node, every read would be a round trip without the cache
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_reads; ++i) {
+        get_cached_uint(k_level_cluster_id, 0);
+    }
+    int64_t read_time = esp_timer_get_time() - start;
+
+    clusters[0].data_version++;
+    subscription.m_attribute_data_count = 0;
+    client.subscribe(&wildcard, 1);
+
+    printf("cached read: %" PRId64 " ns/read\n", read_time * 1000 / k_reads);
+    printf("resubscription with one changed cluster: %" PRIu32 " attribute data, %" PRIu32 " without filters\n",
+           subscription.m_attribute_data_count, full_report);
+    cache::remove_node(chip::kUndefinedNodeId);
+}
+
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
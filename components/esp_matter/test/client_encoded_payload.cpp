@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter_client.h>
+#include <json_to_tlv.h>
+
+#include <lib/core/TLV.h>
+
+using esp_matter::client::interaction::custom_encodable_type;
+using esp_matter::client::interaction::encoded_payload;
+using esp_matter::client::interaction::multiple_write_encodable_type;
+using chip::TLV::TLVReader;
+using chip::TLV::TLVWriter;
+
+static constexpr size_t k_tlv_buffer_size = 4096;
+static constexpr uint32_t k_sends = 100;
+
+static uint8_t s_expected[k_tlv_buffer_size];
+static uint8_t s_encoded[k_tlv_buffer_size];
+
+static size_t encode_json(const char *json, chip::TLV::Tag tag, uint8_t *buffer)
+{
+    TLVWriter writer;
+    writer.Init(buffer, k_tlv_buffer_size);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter::json_to_tlv(json, writer, tag));
+    TEST_ASSERT_TRUE(writer.Finalize() == CHIP_NO_ERROR);
+    return writer.GetLengthWritten();
+}
+
+static size_t encode_payload(const chip::app::DataModel::EncodableToTLV &payload, chip::TLV::Tag tag, uint8_t *buffer)
+{
+    TLVWriter writer;
+    writer.Init(buffer, k_tlv_buffer_size);
+    TEST_ASSERT_TRUE(payload.EncodeTo(writer, tag) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.Finalize() == CHIP_NO_ERROR);
+    return writer.GetLengthWritten();
+}
+
+static void expect_payload_encoding(const encoded_payload &payload, const char *json, chip::TLV::Tag tag)
+{
+    size_t expected_len = encode_json(json, tag, s_expected);
+    TEST_ASSERT_EQUAL(expected_len, encode_payload(payload, tag, s_encoded));
+    TEST_ASSERT_EQUAL_MEMORY(s_expected, s_encoded, expected_len);
+}
+
+TEST_CASE("encoded payloads are encoded again with any tag", "[encoded_payload]")
+{
+    const char *json = R"({"0:U16":300,"1:STR":"scene","2:ARR-OBJ":[{"0:U8":1,"1:BOOL":true}]})";
+    encoded_payload payload(json);
+    TEST_ASSERT_TRUE(payload.is_valid());
+    expect_payload_encoding(payload, json, chip::TLV::AnonymousTag());
+    expect_payload_encoding(payload, json, chip::TLV::ContextTag(1));
+
+    // The copies share the encoding and outlive the original
+    encoded_payload *original = new encoded_payload(payload);
+    encoded_payload copy(*original);
+    delete original;
+    expect_payload_encoding(copy, json, chip::TLV::ContextTag(1));
+    expect_payload_encoding(copy, json, chip::TLV::AnonymousTag());
+
+    // Commands without data field
+    custom_encodable_type empty(nullptr, custom_encodable_type::interaction_type::k_invoke_cmd);
+    expect_payload_encoding(empty, "{}", chip::TLV::AnonymousTag());
+    custom_encodable_type from_payload(payload);
+    expect_payload_encoding(from_payload, json, chip::TLV::AnonymousTag());
+
+    encoded_payload invalid("{\"0:U8\":256}");
+    TEST_ASSERT_FALSE(invalid.is_valid());
+    TLVWriter writer;
+    writer.Init(s_encoded, k_tlv_buffer_size);
+    TEST_ASSERT_FALSE(invalid.EncodeTo(writer, chip::TLV::AnonymousTag()) == CHIP_NO_ERROR);
+    TEST_ASSERT_FALSE(encoded_payload().is_valid());
+}
+
+TEST_CASE("multiple write values are compiled in one pass", "[encoded_payload]")
+{
+    const char *values[] = {
+        R"({"0:U8":1})",
+        R"({"0:STR":"abc"})",
+        R"({"0:ARR-U16":[1,2,3]})",
+    };
+    multiple_write_encodable_type attr_vals(R"([{"0:U8":1},{"0:STR":"abc"},{"0:ARR-U16":[1,2,3]}])");
+    TEST_ASSERT_TRUE(attr_vals.is_valid());
+    TEST_ASSERT_EQUAL(3, attr_vals.GetJsonArraySize());
+
+    multiple_write_encodable_type copy(attr_vals);
+    for (size_t i = 0; i < 3; ++i) {
+        size_t expected_len = encode_json(values[i], chip::TLV::ContextTag(2), s_expected);
+        TLVWriter writer;
+        writer.Init(s_encoded, k_tlv_buffer_size);
+        TEST_ASSERT_TRUE(copy.EncodeTo(writer, chip::TLV::ContextTag(2), i) == CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(writer.Finalize() == CHIP_NO_ERROR);
+        TEST_ASSERT_EQUAL(expected_len, writer.GetLengthWritten());
+        TEST_ASSERT_EQUAL_MEMORY(s_expected, s_encoded, expected_len);
+    }
+
+    // The value readers are on the member of each structure
+    TLVReader reader;
+    TEST_ASSERT_TRUE(attr_vals.GetValueReader(0, reader) == CHIP_NO_ERROR);
+    uint8_t u8_val = 0;
+    TEST_ASSERT_TRUE(reader.Get(u8_val) == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(1, u8_val);
+    TEST_ASSERT_TRUE(attr_vals.GetValueReader(1, reader) == CHIP_NO_ERROR);
+    chip::CharSpan str_val;
+    TEST_ASSERT_TRUE(reader.Get(str_val) == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(3, str_val.size());
+    TEST_ASSERT_EQUAL_MEMORY("abc", str_val.data(), 3);
+    TEST_ASSERT_TRUE(attr_vals.GetValueReader(2, reader) == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(chip::TLV::kTLVType_Array, reader.GetType());
+    TEST_ASSERT_FALSE(attr_vals.GetValueReader(3, reader) == CHIP_NO_ERROR);
+
+    // An object is the value of all the paths
+    multiple_write_encodable_type single(R"({"0:U8":7})");
+    TEST_ASSERT_EQUAL(1, single.GetJsonArraySize());
+    TEST_ASSERT_TRUE(single.GetValueReader(0, reader) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(reader.Get(u8_val) == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(7, u8_val);
+
+    TEST_ASSERT_FALSE(multiple_write_encodable_type(R"([{"0:U8":1},{"0:U8":256}])").is_valid());
+    TEST_ASSERT_FALSE(multiple_write_encodable_type("[").is_valid());
+}
+
+static char *build_command_payload(uint8_t field_count)
+{
+    size_t json_size = 32 + field_count * 24;
+    char *json = (char *)malloc(json_size);
+    TEST_ASSERT_NOT_NULL(json);
+    size_t len = snprintf(json, json_size, "{");
+    for (uint8_t i = 0; i < field_count; ++i) {
+        len += snprintf(json + len, json_size - len, "%s\"%u:U32\":%u", i ? "," : "", i, 1000u * i);
+    }
+    snprintf(json + len, json_size - len, "}");
+    return json;
+}
+
+TEST_CASE("benchmark repeated invokes of the same payload", "[encoded_payload][benchmark]")
+{
+    char *json = build_command_payload(60);
+
+    // Like a controller sending the same command to many nodes: the JSON is converted for every send, or once
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_sends; ++i) {
+        custom_encodable_type payload(json, custom_encodable_type::interaction_type::k_invoke_cmd);
+        encode_payload(payload, chip::TLV::ContextTag(1), s_encoded);
+    }
+    int64_t json_time = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    encoded_payload payload(json);
+    for (uint32_t i = 0; i < k_sends; ++i) {
+        encode_payload(payload, chip::TLV::ContextTag(1), s_encoded);
+    }
+    int64_t compiled_time = esp_timer_get_time() - start;
+
+    printf("%" PRIu32 " sends of %u bytes of json: converted %" PRId64 " us/send, compiled once %" PRId64
+           " us/send\n", k_sends, (unsigned)strlen(json), json_time / k_sends, compiled_time / k_sends);
+    free(json);
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+#include <data_model_provider/esp_matter_cluster_instance_pool.h>
+#include <unordered_map>
+
+using namespace esp_matter;
+
+static constexpr uint32_t k_lookup_iterations = 100;
+
+namespace {
+struct test_instance_t {
+    test_instance_t() : value(0xA5A5A5A5) { s_constructed++; }
+    ~test_instance_t() { s_destroyed++; }
+
+    uint32_t value;
+    uint8_t payload[60];
+
+    static uint32_t s_constructed;
+    static uint32_t s_destroyed;
+};
+uint32_t test_instance_t::s_constructed = 0;
+uint32_t test_instance_t::s_destroyed = 0;
+} // namespace
+
+static bool get_pool_stats(const char *name, data_model::cluster_instance_pool_stats_t *stats)
+{
+    data_model::cluster_instance_pool_stats_t all[64];
+    size_t count = data_model::get_cluster_instance_pool_stats(all, 64);
+    for (size_t i = 0; i < count && i < 64; ++i) {
+        if (strcmp(all[i].name, name) == 0) {
+            *stats = all[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE("cluster instance pool finds without inserting and keeps endpoints sorted", "[instance_pool]")
+{
+    static data_model::cluster_instance_pool<test_instance_t> pool("test pool");
+    test_instance_t::s_constructed = 0;
+    test_instance_t::s_destroyed = 0;
+
+    TEST_ASSERT_NULL(pool.find(1));
+    TEST_ASSERT_EQUAL(0, pool.size());
+
+    const chip::EndpointId endpoint_ids[] = {7, 2, 0, 5};
+    for (chip::EndpointId endpoint_id : endpoint_ids) {
+        test_instance_t *instance = pool.emplace(endpoint_id);
+        TEST_ASSERT_NOT_NULL(instance);
+        TEST_ASSERT_EQUAL_HEX32(0xA5A5A5A5, instance->value);
+        instance->value = endpoint_id;
+    }
+    TEST_ASSERT_EQUAL(4, pool.size());
+    TEST_ASSERT_EQUAL(4, test_instance_t::s_constructed);
+
+    // emplace() of an existing endpoint returns its instance
+    TEST_ASSERT_EQUAL_PTR(pool.find(5), pool.emplace(5));
+    TEST_ASSERT_EQUAL(4, test_instance_t::s_constructed);
+
+    // find() of a missing endpoint does not add it
+    TEST_ASSERT_NULL(pool.find(3));
+    TEST_ASSERT_EQUAL(4, pool.size());
+
+    chip::EndpointId previous = 0;
+    size_t visited = 0;
+    pool.for_each([&](chip::EndpointId endpoint_id, test_instance_t &instance) {
+        TEST_ASSERT_TRUE(visited == 0 || endpoint_id > previous);
+        TEST_ASSERT_EQUAL(endpoint_id, instance.value);
+        previous = endpoint_id;
+        visited++;
+    });
+    TEST_ASSERT_EQUAL(4, visited);
+
+    pool.erase(2);
+    pool.erase(3);
+    TEST_ASSERT_EQUAL(1, test_instance_t::s_destroyed);
+    TEST_ASSERT_NULL(pool.find(2));
+    TEST_ASSERT_EQUAL(7, pool.find(7)->value);
+
+    data_model::cluster_instance_pool_stats_t stats;
+    TEST_ASSERT_TRUE(get_pool_stats("test pool", &stats));
+    TEST_ASSERT_EQUAL(sizeof(test_instance_t), stats.object_size);
+    TEST_ASSERT_EQUAL(3, stats.in_use);
+    TEST_ASSERT_EQUAL(4, stats.high_water_mark);
+
+    pool.erase(0);
+    pool.erase(5);
+    pool.erase(7);
+    TEST_ASSERT_EQUAL(0, pool.size());
+    TEST_ASSERT_EQUAL(4, test_instance_t::s_destroyed);
+}
+
+TEST_CASE("cluster instance pool holds one instance per endpoint", "[instance_pool]")
+{
+    static data_model::cluster_instance_pool<uint32_t> pool("test full pool");
+    for (size_t i = 0; i < data_model::k_cluster_instance_pool_capacity; ++i) {
+        TEST_ASSERT_NOT_NULL(pool.emplace(i));
+    }
+    TEST_ASSERT_NULL(pool.emplace(data_model::k_cluster_instance_pool_capacity));
+    TEST_ASSERT_NOT_NULL(pool.emplace(0));
+    for (size_t i = 0; i < data_model::k_cluster_instance_pool_capacity; ++i) {
+        pool.erase(i);
+    }
+    TEST_ASSERT_EQUAL(0, pool.size());
+}
+
+// Compares the heap used and the lookup time of a pool with the std::unordered_map it replaces, for the bridge case
+// where a cluster is on every dynamic endpoint
+TEST_CASE("benchmark cluster instance pool against unordered_map", "[instance_pool][benchmark]")
+{
+    const size_t count = data_model::k_cluster_instance_pool_capacity;
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    auto *map = new std::unordered_map<chip::EndpointId, test_instance_t>();
+    for (size_t i = 0; i < count; ++i) {
+        (*map)[i + 1];
+    }
+    size_t map_bytes = free_before - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    int64_t start = esp_timer_get_time();
+    uint32_t sum = 0;
+    for (uint32_t n = 0; n < k_lookup_iterations; ++n) {
+        for (size_t i = 0; i < count; ++i) {
+            auto it = map->find(i + 1);
+            sum += it != map->end() ? it->second.value : 0;
+        }
+    }
+    int64_t map_time = esp_timer_get_time() - start;
+    delete map;
+
+    static data_model::cluster_instance_pool<test_instance_t> pool("test benchmark pool");
+    free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    for (size_t i = 0; i < count; ++i) {
+        TEST_ASSERT_NOT_NULL(pool.emplace(i + 1));
+    }
+    size_t pool_bytes = free_before - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    start = esp_timer_get_time();
+    uint32_t pool_sum = 0;
+    for (uint32_t n = 0; n < k_lookup_iterations; ++n) {
+        for (size_t i = 0; i < count; ++i) {
+            test_instance_t *instance = pool.find(i + 1);
+            pool_sum += instance ? instance->value : 0;
+        }
+    }
+    int64_t pool_time = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(sum, pool_sum);
+
+    printf("%u instances of %u bytes: unordered_map %u bytes %" PRId64 " us, pool %u bytes %" PRId64 " us\n",
+           (unsigned)count, (unsigned)sizeof(test_instance_t), (unsigned)map_bytes, map_time, (unsigned)pool_bytes,
+           pool_time);
+
+    for (size_t i = 0; i < count; ++i) {
+        pool.erase(i + 1);
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+
+#include <app/ConcreteCommandPath.h>
+#include <lib/core/TLV.h>
+
+#include "cluster_lifecycle_common.h"
+
+namespace esp_matter::command {
+void dispatch_single_cluster_command(const chip::app::ConcreteCommandPath &command_path, chip::TLV::TLVReader &tlv_data,
+                                     void *opaque_ptr);
+} // namespace esp_matter::command
+
+using namespace esp_matter;
+using chip::app::ConcreteCommandPath;
+using chip::TLV::TLVReader;
+
+static constexpr uint32_t k_cluster_id = 0xFFF1FC40;
+static constexpr uint32_t k_command_count = 32;
+static constexpr uint32_t k_burst = 1000;
+
+static uint32_t s_dispatch_count[k_command_count + 1];
+
+static esp_err_t command_callback(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr)
+{
+    if (command_path.mCommandId <= k_command_count) {
+        s_dispatch_count[command_path.mCommandId]++;
+    }
+    return ESP_OK;
+}
+
+// The payload of a command without fields
+class empty_command_payload {
+public:
+    empty_command_payload()
+    {
+        chip::TLV::TLVWriter writer;
+        writer.Init(m_buffer);
+        chip::TLV::TLVType outer;
+        TEST_ASSERT_TRUE(writer.StartContainer(chip::TLV::AnonymousTag(), chip::TLV::kTLVType_Structure, outer) ==
+                         CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(writer.EndContainer(outer) == CHIP_NO_ERROR);
+        TEST_ASSERT_TRUE(writer.Finalize() == CHIP_NO_ERROR);
+        m_length = writer.GetLengthWritten();
+    }
+
+    void dispatch(uint16_t endpoint_id, uint32_t command_id)
+    {
+        TLVReader reader;
+        reader.Init(m_buffer, m_length);
+        TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+        command::dispatch_single_cluster_command(ConcreteCommandPath(endpoint_id, k_cluster_id, command_id), reader,
+                                                 nullptr);
+    }
+
+private:
+    uint8_t m_buffer[8];
+    uint32_t m_length;
+};
+
+static endpoint_t *create_endpoint_with_commands(node_t *node, cluster_t **cluster_out)
+{
+    endpoint_t *endpoint = endpoint::create(node, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    TEST_ASSERT_NOT_NULL(endpoint);
+    cluster_t *cluster = cluster::create(endpoint, k_cluster_id, CLUSTER_FLAG_SERVER);
+    TEST_ASSERT_NOT_NULL(cluster);
+    for (uint32_t command_id = 0; command_id < k_command_count; ++command_id) {
+        TEST_ASSERT_NOT_NULL(command::create(cluster, command_id, COMMAND_FLAG_ACCEPTED, command_callback));
+    }
+    *cluster_out = cluster;
+    return endpoint;
+}
+
+TEST_CASE("dispatched commands reach the callbacks of the cluster", "[dispatch]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+    memset(s_dispatch_count, 0, sizeof(s_dispatch_count));
+
+    cluster_t *cluster = nullptr;
+    endpoint_t *endpoint = create_endpoint_with_commands(node, &cluster);
+    uint16_t endpoint_id = endpoint::get_id(endpoint);
+    empty_command_payload payload;
+
+    for (uint32_t command_id = 0; command_id < k_command_count; ++command_id) {
+        payload.dispatch(endpoint_id, command_id);
+        TEST_ASSERT_EQUAL(1, s_dispatch_count[command_id]);
+    }
+#ifdef CONFIG_ESP_MATTER_COMMAND_DISPATCH_TABLE
+    TEST_ASSERT_TRUE(cluster::is_frozen(cluster));
+#endif
+
+    // A command created after the first dispatch is found too
+    TEST_ASSERT_NOT_NULL(command::create(cluster, k_command_count, COMMAND_FLAG_ACCEPTED, command_callback));
+    TEST_ASSERT_FALSE(cluster::is_frozen(cluster));
+    payload.dispatch(endpoint_id, k_command_count);
+    TEST_ASSERT_EQUAL(1, s_dispatch_count[k_command_count]);
+
+    // Unknown commands and generated commands are not dispatched
+    TEST_ASSERT_NOT_NULL(command::create(cluster, k_command_count + 1, COMMAND_FLAG_GENERATED, command_callback));
+    payload.dispatch(endpoint_id, k_command_count + 1);
+    payload.dispatch(endpoint_id, k_command_count + 2);
+    for (uint32_t command_id = 0; command_id <= k_command_count; ++command_id) {
+        TEST_ASSERT_EQUAL(1, s_dispatch_count[command_id]);
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoint));
+}
+
+TEST_CASE("benchmark a burst of dispatched commands", "[dispatch][benchmark]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+    memset(s_dispatch_count, 0, sizeof(s_dispatch_count));
+
+#ifdef CONFIG_ESP_MATTER_COMMAND_DISPATCH_TABLE
+    printf("command dispatch table: enabled\n");
+#else
+    printf("command dispatch table: disabled\n");
+#endif
+#ifdef CONFIG_ESP_MATTER_LOG_RECEIVED_COMMANDS
+    printf("received command log: enabled\n");
+#else
+    printf("received command log: disabled\n");
+#endif
+
+    cluster_t *cluster = nullptr;
+    endpoint_t *endpoint = create_endpoint_with_commands(node, &cluster);
+    uint16_t endpoint_id = endpoint::get_id(endpoint);
+    empty_command_payload payload;
+
+    // The last created command is the last one of the list, like the toggle of a group of lights
+    uint32_t command_id = k_command_count - 1;
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_burst; ++i) {
+        payload.dispatch(endpoint_id, command_id);
+    }
+    int64_t dispatch_time = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(k_burst, s_dispatch_count[command_id]);
+
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_burst; ++i) {
+        command_t *command = command::get_first(cluster);
+        while (command && command::get_id(command) != command_id) {
+            command = command::get_next(command);
+        }
+        TEST_ASSERT_NOT_NULL(command);
+    }
+    int64_t walk_time = esp_timer_get_time() - start;
+
+    printf("%" PRIu32 " commands: %" PRId64 " us/dispatch, command list walk: %" PRId64 " us/lookup\n",
+           k_command_count, dispatch_time / k_burst, walk_time / k_burst);
+
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoint));
+}
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+#include <esp_matter_data_model_provider.h>
+
+#include "cluster_lifecycle_common.h"
+
+namespace esp_matter::attribute {
+esp_err_t destroy(cluster_t *cluster, attribute_t *attribute);
+} // namespace esp_matter::attribute
+
+namespace esp_matter::command {
+esp_err_t destroy(cluster_t *cluster, command_t *command);
+} // namespace esp_matter::command
+
+using namespace esp_matter;
+using chip::ReadOnlyBufferBuilder;
+using chip::app::ConcreteClusterPath;
+using chip::app::DataModel::AcceptedCommandEntry;
+using chip::app::DataModel::AttributeEntry;
+
+static constexpr uint32_t k_cluster_id = 0xFFF1FC30;
+static constexpr uint32_t k_attribute_count = 32;
+static constexpr uint32_t k_iterations = 200;
+
+static endpoint_t *create_endpoint_with_tables(node_t *node, cluster_t **cluster_out)
+{
+    endpoint_t *endpoint = endpoint::create(node, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    TEST_ASSERT_NOT_NULL(endpoint);
+    cluster_t *cluster = cluster::create(endpoint, k_cluster_id, CLUSTER_FLAG_SERVER);
+    TEST_ASSERT_NOT_NULL(cluster);
+    // Created in descending order so that freezing has to sort them
+    for (uint32_t i = 0; i < k_attribute_count; ++i) {
+        uint32_t attribute_id = k_attribute_count - 1 - i;
+        TEST_ASSERT_NOT_NULL(attribute::create(cluster, attribute_id, ATTRIBUTE_FLAG_NONE, esp_matter_uint32(i)));
+    }
+    // The command 0x00 is both accepted and generated, like a command and its response
+    TEST_ASSERT_NOT_NULL(command::create(cluster, 0x02, COMMAND_FLAG_ACCEPTED, nullptr));
+    TEST_ASSERT_NOT_NULL(command::create(cluster, 0x00, COMMAND_FLAG_GENERATED, nullptr));
+    TEST_ASSERT_NOT_NULL(command::create(cluster, 0x00, COMMAND_FLAG_ACCEPTED, nullptr));
+    TEST_ASSERT_NOT_NULL(command::create(cluster, 0x01, COMMAND_FLAG_ACCEPTED, nullptr));
+    *cluster_out = cluster;
+    return endpoint;
+}
+
+TEST_CASE("frozen clusters keep the lookups and counts of the lists", "[frozen]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    cluster_t *cluster = nullptr;
+    endpoint_t *endpoint = create_endpoint_with_tables(node, &cluster);
+    uint16_t endpoint_id = endpoint::get_id(endpoint);
+    command_t *generated = command::get(cluster, 0x00, COMMAND_FLAG_GENERATED);
+    command_t *accepted = command::get(cluster, 0x00, COMMAND_FLAG_ACCEPTED);
+    TEST_ASSERT_NOT_NULL(generated);
+    TEST_ASSERT_NOT_NULL(accepted);
+    TEST_ASSERT_NOT_EQUAL(generated, accepted);
+
+    TEST_ASSERT_EQUAL(ESP_OK, node::freeze());
+    TEST_ASSERT_TRUE(cluster::is_frozen(cluster));
+    TEST_ASSERT_EQUAL(k_attribute_count, cluster::get_attribute_count(cluster));
+    TEST_ASSERT_EQUAL(3, cluster::get_command_count(cluster, COMMAND_FLAG_ACCEPTED));
+    TEST_ASSERT_EQUAL(1, cluster::get_command_count(cluster, COMMAND_FLAG_GENERATED));
+    TEST_ASSERT_EQUAL(4, cluster::get_command_count(cluster, COMMAND_FLAG_ACCEPTED | COMMAND_FLAG_GENERATED));
+
+    for (uint32_t attribute_id = 0; attribute_id < k_attribute_count; ++attribute_id) {
+        attribute_t *attribute = attribute::get(cluster, attribute_id);
+        TEST_ASSERT_NOT_NULL(attribute);
+        TEST_ASSERT_EQUAL(attribute_id, attribute::get_id(attribute));
+    }
+    TEST_ASSERT_NULL(attribute::get(cluster, k_attribute_count));
+    TEST_ASSERT_EQUAL_PTR(generated, command::get(cluster, 0x00, COMMAND_FLAG_GENERATED));
+    TEST_ASSERT_EQUAL_PTR(accepted, command::get(cluster, 0x00, COMMAND_FLAG_ACCEPTED));
+    TEST_ASSERT_EQUAL_PTR(generated, command::get(endpoint_id, k_cluster_id, 0x00));
+    TEST_ASSERT_NULL(command::get(cluster, 0x01, COMMAND_FLAG_GENERATED));
+    TEST_ASSERT_NULL(command::get(cluster, 0x03, COMMAND_FLAG_ACCEPTED));
+
+    // The AttributeList is sorted and ends with the global attributes
+    ReadOnlyBufferBuilder<AttributeEntry> attributes;
+    ConcreteClusterPath path(endpoint_id, k_cluster_id);
+    TEST_ASSERT_TRUE(data_model::provider::get_instance().Attributes(path, attributes) == CHIP_NO_ERROR);
+    auto attribute_entries = attributes.TakeBuffer();
+    TEST_ASSERT_EQUAL(k_attribute_count + 3, attribute_entries.size());
+    for (uint32_t i = 0; i < k_attribute_count; ++i) {
+        TEST_ASSERT_EQUAL(i, attribute_entries[i].attributeId);
+    }
+    ReadOnlyBufferBuilder<AcceptedCommandEntry> accepted_commands;
+    TEST_ASSERT_TRUE(data_model::provider::get_instance().AcceptedCommands(path, accepted_commands) == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(3, accepted_commands.TakeBuffer().size());
+    ReadOnlyBufferBuilder<chip::CommandId> generated_commands;
+    TEST_ASSERT_TRUE(data_model::provider::get_instance().GeneratedCommands(path, generated_commands) ==
+                     CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(1, generated_commands.TakeBuffer().size());
+
+    // Any change to the lists thaws the cluster
+    TEST_ASSERT_NOT_NULL(attribute::create(cluster, k_attribute_count, ATTRIBUTE_FLAG_NONE, esp_matter_uint32(0)));
+    TEST_ASSERT_FALSE(cluster::is_frozen(cluster));
+    TEST_ASSERT_NOT_NULL(attribute::get(cluster, k_attribute_count));
+    TEST_ASSERT_EQUAL(k_attribute_count + 1, cluster::get_attribute_count(cluster));
+
+    TEST_ASSERT_EQUAL(ESP_OK, node::freeze());
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::destroy(cluster, attribute::get(cluster, 0)));
+    TEST_ASSERT_FALSE(cluster::is_frozen(cluster));
+    TEST_ASSERT_NULL(attribute::get(cluster, 0));
+
+    TEST_ASSERT_EQUAL(ESP_OK, node::freeze());
+    TEST_ASSERT_EQUAL(ESP_OK, command::destroy(cluster, generated));
+    TEST_ASSERT_FALSE(cluster::is_frozen(cluster));
+    TEST_ASSERT_EQUAL(0, cluster::get_command_count(cluster, COMMAND_FLAG_GENERATED));
+
+    TEST_ASSERT_EQUAL(ESP_OK, node::freeze());
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoint));
+}
+
+TEST_CASE("benchmark cluster metadata enumeration of frozen clusters", "[frozen][benchmark]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    cluster_t *cluster = nullptr;
+    endpoint_t *endpoint = create_endpoint_with_tables(node, &cluster);
+    ConcreteClusterPath path(endpoint::get_id(endpoint), k_cluster_id);
+    data_model::provider &provider = data_model::provider::get_instance();
+
+    int64_t times[2];
+    for (int frozen = 0; frozen < 2; ++frozen) {
+        if (frozen) {
+            TEST_ASSERT_EQUAL(ESP_OK, node::freeze());
+        }
+        TEST_ASSERT_EQUAL(frozen, cluster::is_frozen(cluster));
+        int64_t start = esp_timer_get_time();
+        for (uint32_t i = 0; i < k_iterations; ++i) {
+            ReadOnlyBufferBuilder<AttributeEntry> attributes;
+            TEST_ASSERT_TRUE(provider.Attributes(path, attributes) == CHIP_NO_ERROR);
+            ReadOnlyBufferBuilder<AcceptedCommandEntry> accepted_commands;
+            TEST_ASSERT_TRUE(provider.AcceptedCommands(path, accepted_commands) == CHIP_NO_ERROR);
+            ReadOnlyBufferBuilder<chip::CommandId> generated_commands;
+            TEST_ASSERT_TRUE(provider.GeneratedCommands(path, generated_commands) == CHIP_NO_ERROR);
+        }
+        times[frozen] = esp_timer_get_time() - start;
+    }
+
+    printf("%" PRIu32 " attributes, 4 commands: lists %" PRId64 " us/enumeration, frozen %" PRId64
+           " us/enumeration\n", k_attribute_count, times[0] / k_iterations, times[1] / k_iterations);
+
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoint));
+}
@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <unity.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+#include <esp_matter_mem.h>
+
+#include "cluster_lifecycle_common.h"
+
+using namespace esp_matter;
+
+static constexpr size_t k_max_pools = 8;
+static constexpr uint32_t k_pool_task_rounds = 200;
+
+TEST_CASE("memory pools hand out zeroed objects and keep their slabs until trimmed", "[mem_pool]")
+{
+    struct test_object_t {
+        uint64_t value;
+        uint8_t bytes[5];
+    };
+    esp_matter_mem_pool_t pool = ESP_MATTER_MEM_POOL_INIT("test", test_object_t, 4);
+
+    test_object_t *objects[10];
+    for (size_t i = 0; i < 10; ++i) {
+        objects[i] = (test_object_t *)esp_matter_mem_pool_calloc(&pool);
+        TEST_ASSERT_NOT_NULL(objects[i]);
+        TEST_ASSERT_EQUAL(0, ((uintptr_t)objects[i]) % alignof(uint64_t));
+        TEST_ASSERT_EQUAL_UINT64(0, objects[i]->value);
+        objects[i]->value = UINT64_MAX;
+    }
+
+    esp_matter_mem_pool_stats_t stats;
+    esp_matter_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(10, stats.in_use);
+    TEST_ASSERT_EQUAL(10, stats.alloc_count);
+#ifdef CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    TEST_ASSERT_EQUAL(12, stats.capacity);
+#endif
+
+    // A freed object is reused and zeroed again
+    esp_matter_mem_pool_free(&pool, objects[3]);
+    objects[3] = (test_object_t *)esp_matter_mem_pool_calloc(&pool);
+    TEST_ASSERT_NOT_NULL(objects[3]);
+    TEST_ASSERT_EQUAL_UINT64(0, objects[3]->value);
+
+    for (size_t i = 0; i < 10; ++i) {
+        esp_matter_mem_pool_free(&pool, objects[i]);
+    }
+    esp_matter_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(10, stats.peak);
+    void *object = nullptr;
+#ifdef CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    // The empty pool keeps its slabs for the next allocations
+    TEST_ASSERT_EQUAL(12, stats.capacity);
+    object = esp_matter_mem_pool_calloc(&pool);
+    esp_matter_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(12, stats.capacity);
+    esp_matter_mem_pool_free(&pool, object);
+#endif
+
+    // Trimming a pool which still has objects keeps its slabs
+    object = esp_matter_mem_pool_calloc(&pool);
+    esp_matter_mem_pool_trim(&pool);
+    esp_matter_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_NOT_EQUAL(0, stats.heap_bytes);
+    esp_matter_mem_pool_free(&pool, object);
+
+    esp_matter_mem_pool_trim(&pool);
+    esp_matter_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(0, stats.capacity);
+    TEST_ASSERT_EQUAL(0, stats.heap_bytes);
+}
+
+struct pool_task_args_t {
+    esp_matter_mem_pool_t *pool;
+    SemaphoreHandle_t done;
+    bool ok;
+};
+
+static void pool_task(void *arg)
+{
+    pool_task_args_t *args = (pool_task_args_t *)arg;
+    uint32_t *objects[16];
+    args->ok = true;
+    for (uint32_t round = 0; round < k_pool_task_rounds; ++round) {
+        for (size_t i = 0; i < 16; ++i) {
+            objects[i] = (uint32_t *)esp_matter_mem_pool_calloc(args->pool);
+            if (!objects[i] || *objects[i] != 0) {
+                args->ok = false;
+            }
+            if (objects[i]) {
+                *objects[i] = round + 1;
+            }
+        }
+        for (size_t i = 0; i < 16; ++i) {
+            if (objects[i] && *objects[i] != round + 1) {
+                // Another task was handed the same object
+                args->ok = false;
+            }
+            esp_matter_mem_pool_free(args->pool, objects[i]);
+        }
+    }
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("memory pools are shared by several tasks", "[mem_pool]")
+{
+    esp_matter_mem_pool_t pool = ESP_MATTER_MEM_POOL_INIT("test_tasks", uint32_t, 8);
+    pool_task_args_t args[2];
+    for (pool_task_args_t &task_args : args) {
+        task_args = { &pool, xSemaphoreCreateBinary(), false };
+        TEST_ASSERT_NOT_NULL(task_args.done);
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(pool_task, "pool_task", 2048, &task_args, 5, NULL));
+    }
+    for (pool_task_args_t &task_args : args) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(task_args.done, pdMS_TO_TICKS(10000)));
+        vSemaphoreDelete(task_args.done);
+        TEST_ASSERT_TRUE(task_args.ok);
+    }
+
+    esp_matter_mem_pool_stats_t stats;
+    esp_matter_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(2 * 16 * k_pool_task_rounds, stats.alloc_count);
+    esp_matter_mem_pool_trim(&pool);
+}
+
+TEST_CASE("report data model memory usage for a multi device type node", "[mem_pool][benchmark]")
+{
+    node_t *node = test::get_or_create_node();
+
+#ifdef CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    printf("data model pools: enabled, %d nodes per slab\n", CONFIG_ESP_MATTER_MEM_POOL_OBJECTS_PER_SLAB);
+#else
+    printf("data model pools: disabled\n");
+#endif
+
+    esp_matter_mem_pool_stats_t before[k_max_pools];
+    size_t pool_count = node::get_mem_stats(before, k_max_pools);
+    TEST_ASSERT_GREATER_THAN(0, pool_count);
+    size_t free_heap_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    // A mix of the device types of the all_device_types_app
+    endpoint_t *endpoints[8] = { nullptr };
+    size_t endpoint_count = 0;
+    {
+        endpoint::on_off_light::config_t config;
+        endpoints[endpoint_count++] = endpoint::on_off_light::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    {
+        endpoint::extended_color_light::config_t config;
+        endpoints[endpoint_count++] =
+            endpoint::extended_color_light::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    {
+        endpoint::on_off_plug_in_unit::config_t config;
+        endpoints[endpoint_count++] =
+            endpoint::on_off_plug_in_unit::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    {
+        endpoint::fan::config_t config;
+        endpoints[endpoint_count++] = endpoint::fan::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    {
+        endpoint::thermostat::config_t config;
+        endpoints[endpoint_count++] = endpoint::thermostat::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    {
+        endpoint::temperature_sensor::config_t config;
+        endpoints[endpoint_count++] =
+            endpoint::temperature_sensor::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    {
+        endpoint::occupancy_sensor::config_t config;
+        endpoints[endpoint_count++] =
+            endpoint::occupancy_sensor::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    {
+        endpoint::contact_sensor::config_t config;
+        endpoints[endpoint_count++] = endpoint::contact_sensor::create(node, &config, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    }
+    for (size_t i = 0; i < endpoint_count; ++i) {
+        TEST_ASSERT_NOT_NULL(endpoints[i]);
+    }
+
+    size_t free_heap_after = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    esp_matter_mem_pool_stats_t after[k_max_pools];
+    TEST_ASSERT_EQUAL(pool_count, node::get_mem_stats(after, k_max_pools));
+
+    printf("%-20s %8s %8s %8s %10s\n", "pool", "size", "in_use", "allocs", "heap_bytes");
+    for (size_t i = 0; i < pool_count; ++i) {
+        printf("%-20s %8u %8u %8u %10u\n", after[i].name, (unsigned)after[i].object_size,
+               (unsigned)(after[i].in_use - before[i].in_use),
+               (unsigned)(after[i].alloc_count - before[i].alloc_count),
+               (unsigned)(after[i].heap_bytes - before[i].heap_bytes));
+    }
+    printf("%u endpoints, heap used: %d bytes\n", (unsigned)endpoint_count,
+           (int)(free_heap_before - free_heap_after));
+
+    for (size_t i = 0; i < endpoint_count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoints[i]));
+    }
+    TEST_ASSERT_EQUAL(pool_count, node::get_mem_stats(after, k_max_pools));
+    for (size_t i = 0; i < pool_count; ++i) {
+        TEST_ASSERT_EQUAL(before[i].in_use, after[i].in_use);
+    }
+}
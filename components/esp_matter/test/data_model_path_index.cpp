@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+
+#include "cluster_lifecycle_common.h"
+
+namespace esp_matter::attribute {
+esp_err_t destroy(cluster_t *cluster, attribute_t *attribute);
+} // namespace esp_matter::attribute
+
+using namespace esp_matter;
+
+static constexpr uint32_t k_cluster_id_base = 0xFFF1FC00;
+static constexpr uint32_t k_clusters_per_endpoint = 8;
+static constexpr uint32_t k_attributes_per_cluster = 16;
+static constexpr uint32_t k_lookup_iterations = 1000;
+
+static endpoint_t *create_populated_endpoint(node_t *node)
+{
+    endpoint_t *endpoint = endpoint::create(node, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    TEST_ASSERT_NOT_NULL(endpoint);
+    for (uint32_t cluster_index = 0; cluster_index < k_clusters_per_endpoint; ++cluster_index) {
+        cluster_t *cluster = cluster::create(endpoint, k_cluster_id_base + cluster_index, CLUSTER_FLAG_SERVER);
+        TEST_ASSERT_NOT_NULL(cluster);
+        for (uint32_t attribute_id = 0; attribute_id < k_attributes_per_cluster; ++attribute_id) {
+            attribute_t *attribute = attribute::create(cluster, attribute_id, ATTRIBUTE_FLAG_NONE,
+                                                       esp_matter_uint32(attribute_id));
+            TEST_ASSERT_NOT_NULL(attribute);
+        }
+    }
+    return endpoint;
+}
+
+// Reference lookup which walks the endpoint, cluster and attribute lists through the public iterators
+static attribute_t *walk_lookup(node_t *node, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    for (endpoint_t *endpoint = endpoint::get_first(node); endpoint; endpoint = endpoint::get_next(endpoint)) {
+        if (endpoint::get_id(endpoint) != endpoint_id) {
+            continue;
+        }
+        for (cluster_t *cluster = cluster::get_first(endpoint); cluster; cluster = cluster::get_next(cluster)) {
+            if (cluster::get_id(cluster) != cluster_id) {
+                continue;
+            }
+            for (attribute_t *attribute = attribute::get_first(cluster); attribute;
+                    attribute = attribute::get_next(attribute)) {
+                if (attribute::get_id(attribute) == attribute_id) {
+                    return attribute;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE("path lookups follow endpoint, cluster and attribute lifecycle", "[path_index][lifecycle]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    endpoint_t *endpoint = create_populated_endpoint(node);
+    uint16_t endpoint_id = endpoint::get_id(endpoint);
+    TEST_ASSERT_EQUAL_PTR(endpoint, endpoint::get(endpoint_id));
+
+    cluster_t *cluster = cluster::get(endpoint_id, k_cluster_id_base);
+    TEST_ASSERT_NOT_NULL(cluster);
+    attribute_t *attribute = attribute::get(endpoint_id, k_cluster_id_base, 1);
+    TEST_ASSERT_NOT_NULL(attribute);
+    TEST_ASSERT_EQUAL_PTR(attribute, walk_lookup(node, endpoint_id, k_cluster_id_base, 1));
+
+    // Creating an existing attribute returns the indexed one
+    TEST_ASSERT_EQUAL_PTR(attribute, attribute::create(cluster, 1, ATTRIBUTE_FLAG_NONE, esp_matter_uint32(0)));
+
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::destroy(cluster, attribute));
+    TEST_ASSERT_NULL(attribute::get(endpoint_id, k_cluster_id_base, 1));
+    TEST_ASSERT_NOT_NULL(attribute::get(endpoint_id, k_cluster_id_base, 2));
+
+    TEST_ASSERT_EQUAL(ESP_OK, cluster::destroy(cluster));
+    TEST_ASSERT_NULL(cluster::get(endpoint_id, k_cluster_id_base));
+    TEST_ASSERT_NULL(attribute::get(endpoint_id, k_cluster_id_base, 2));
+    TEST_ASSERT_NOT_NULL(cluster::get(endpoint_id, k_cluster_id_base + 1));
+
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoint));
+    TEST_ASSERT_NULL(endpoint::get(endpoint_id));
+    TEST_ASSERT_NULL(cluster::get(endpoint_id, k_cluster_id_base + 1));
+    TEST_ASSERT_NULL(attribute::get(endpoint_id, k_cluster_id_base + 1, 0));
+
+    // A resumed endpoint is found again under the same id
+    endpoint = endpoint::resume(node, ENDPOINT_FLAG_DESTROYABLE, endpoint_id, nullptr);
+    TEST_ASSERT_NOT_NULL(endpoint);
+    TEST_ASSERT_EQUAL_PTR(endpoint, endpoint::get(endpoint_id));
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoint));
+    TEST_ASSERT_NULL(endpoint::get(endpoint_id));
+}
+
+TEST_CASE("benchmark attribute lookup against endpoint count", "[path_index][benchmark]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    endpoint_t *endpoints[CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT] = { nullptr };
+    uint16_t available = CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT - endpoint::get_count(node);
+
+#ifdef CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX
+    printf("path index: enabled\n");
+#else
+    printf("path index: disabled\n");
+#endif
+
+    uint16_t count = 0;
+    uint16_t next_report = 1;
+    while (count < available) {
+        endpoints[count++] = create_populated_endpoint(node);
+        if (count != next_report && count != available) {
+            continue;
+        }
+        next_report *= 2;
+
+        // Look up the attributes at the tail of the last endpoint, which is the worst case for a list walk
+        uint16_t endpoint_id = endpoint::get_id(endpoints[count - 1]);
+        uint32_t cluster_id = k_cluster_id_base + k_clusters_per_endpoint - 1;
+        uint32_t attribute_id = k_attributes_per_cluster - 1;
+        attribute_t *expected = walk_lookup(node, endpoint_id, cluster_id, attribute_id);
+        TEST_ASSERT_NOT_NULL(expected);
+
+        int64_t start = esp_timer_get_time();
+        for (uint32_t i = 0; i < k_lookup_iterations; ++i) {
+            TEST_ASSERT_EQUAL_PTR(expected, attribute::get(endpoint_id, cluster_id, attribute_id));
+        }
+        int64_t lookup_time = esp_timer_get_time() - start;
+
+        start = esp_timer_get_time();
+        for (uint32_t i = 0; i < k_lookup_iterations; ++i) {
+            TEST_ASSERT_EQUAL_PTR(expected, walk_lookup(node, endpoint_id, cluster_id, attribute_id));
+        }
+        int64_t walk_time = esp_timer_get_time() - start;
+
+        printf("endpoints: %u, attribute::get(): %" PRId64 " ns/lookup, list walk: %" PRId64 " ns/lookup\n",
+               endpoint::get_count(node), lookup_time * 1000 / k_lookup_iterations,
+               walk_time * 1000 / k_lookup_iterations);
+    }
+
+    for (uint16_t i = 0; i < count; ++i) {
+        uint16_t endpoint_id = endpoint::get_id(endpoints[i]);
+        TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoints[i]));
+        TEST_ASSERT_NULL(attribute::get(endpoint_id, k_cluster_id_base, 0));
+    }
+}
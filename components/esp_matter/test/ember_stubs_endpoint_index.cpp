@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+
+#include <app/util/attribute-storage.h>
+
+#include "cluster_lifecycle_common.h"
+
+using namespace esp_matter;
+
+static constexpr uint32_t k_bridged_cluster_id = 0xFFF1FC20;
+static constexpr uint32_t k_other_cluster_id = 0xFFF1FC21;
+static constexpr uint16_t k_bridge_endpoint_count = 250;
+static constexpr uint32_t k_iterations = 10;
+
+// Reference implementations which walk the endpoint list from its head for every step
+static uint16_t walk_server_endpoint_index(node_t *node, uint16_t endpoint_id, uint32_t cluster_id)
+{
+    if (!cluster::get(endpoint_id, cluster_id)) {
+        return 0xFFFF;
+    }
+    uint16_t index = 0;
+    for (endpoint_t *endpoint = endpoint::get_first(node); endpoint && endpoint::get_id(endpoint) != endpoint_id;
+            endpoint = endpoint::get_next(endpoint)) {
+        if (cluster::get(endpoint, cluster_id)) {
+            index++;
+        }
+    }
+    return index;
+}
+
+static uint16_t walk_enabled_endpoints(node_t *node, uint32_t cluster_id, uint16_t *endpoint_ids, uint16_t max_count)
+{
+    uint16_t count = 0;
+    uint16_t endpoint_count = endpoint::get_count(node);
+    for (uint16_t index = 0; index < endpoint_count; ++index) {
+        endpoint_t *endpoint = endpoint::get_first(node);
+        for (uint16_t i = 0; i < index; ++i) {
+            endpoint = endpoint::get_next(endpoint);
+        }
+        if (endpoint::is_enabled(endpoint) && cluster::get(endpoint, cluster_id) && count < max_count) {
+            endpoint_ids[count++] = endpoint::get_id(endpoint);
+        }
+    }
+    return count;
+}
+
+static void check_against_walk(node_t *node, uint32_t cluster_id)
+{
+    uint16_t expected[CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT];
+    uint16_t expected_count = walk_enabled_endpoints(node, cluster_id, expected,
+                                                     CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT);
+    uint16_t count = 0;
+    for (chip::EndpointId endpoint_id : chip::app::EnabledEndpointsWithServerCluster(cluster_id)) {
+        TEST_ASSERT_LESS_THAN(expected_count, count);
+        TEST_ASSERT_EQUAL(expected[count], endpoint_id);
+        count++;
+    }
+    TEST_ASSERT_EQUAL(expected_count, count);
+
+    for (endpoint_t *endpoint = endpoint::get_first(node); endpoint; endpoint = endpoint::get_next(endpoint)) {
+        uint16_t endpoint_id = endpoint::get_id(endpoint);
+        TEST_ASSERT_EQUAL(walk_server_endpoint_index(node, endpoint_id, cluster_id),
+                          emberAfGetClusterServerEndpointIndex(endpoint_id, cluster_id, 0));
+    }
+}
+
+static endpoint_t *create_bridged_endpoint(node_t *node, bool with_cluster)
+{
+    endpoint_t *endpoint = endpoint::create(node, ENDPOINT_FLAG_DESTROYABLE, nullptr);
+    TEST_ASSERT_NOT_NULL(endpoint);
+    TEST_ASSERT_NOT_NULL(cluster::create(endpoint, k_other_cluster_id, CLUSTER_FLAG_SERVER));
+    if (with_cluster) {
+        TEST_ASSERT_NOT_NULL(cluster::create(endpoint, k_bridged_cluster_id, CLUSTER_FLAG_SERVER));
+    }
+    return endpoint;
+}
+
+TEST_CASE("server endpoint indexes follow endpoint and cluster lifecycle", "[ember_stubs]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    constexpr uint16_t k_count = 4;
+    uint16_t available = CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT - endpoint::get_count(node);
+    TEST_ASSERT_GREATER_OR_EQUAL(k_count, available);
+
+    endpoint_t *endpoints[k_count];
+    for (uint16_t i = 0; i < k_count; ++i) {
+        endpoints[i] = create_bridged_endpoint(node, i % 2 == 0);
+    }
+    check_against_walk(node, k_bridged_cluster_id);
+    TEST_ASSERT_EQUAL(0xFFFF, emberAfGetClusterServerEndpointIndex(endpoint::get_id(endpoints[1]),
+                                                                   k_bridged_cluster_id, 0));
+
+    // Adding a cluster shifts the index of the following endpoints
+    TEST_ASSERT_NOT_NULL(cluster::create(endpoints[1], k_bridged_cluster_id, CLUSTER_FLAG_SERVER));
+    check_against_walk(node, k_bridged_cluster_id);
+
+    // Disabled endpoints are skipped by the iterator but keep their index
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::disable(endpoints[2]));
+    check_against_walk(node, k_bridged_cluster_id);
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::enable(endpoints[2]));
+
+    // Removing an endpoint shifts the index of the following endpoints
+    uint16_t removed_id = endpoint::get_id(endpoints[0]);
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoints[0]));
+    TEST_ASSERT_EQUAL(0xFFFF, emberAfGetClusterServerEndpointIndex(removed_id, k_bridged_cluster_id, 0));
+    check_against_walk(node, k_bridged_cluster_id);
+    check_against_walk(node, k_other_cluster_id);
+
+    for (uint16_t i = 1; i < k_count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoints[i]));
+    }
+    check_against_walk(node, k_bridged_cluster_id);
+}
+
+TEST_CASE("benchmark server endpoint lookups on a bridge", "[ember_stubs][benchmark]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+
+    // A bridge with 250 bridged devices needs CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT=255, smaller configurations
+    // are measured with as many endpoints as they allow.
+    endpoint_t *endpoints[CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT] = { nullptr };
+    uint16_t available = CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT - endpoint::get_count(node);
+    uint16_t count = available < k_bridge_endpoint_count ? available : k_bridge_endpoint_count;
+    for (uint16_t i = 0; i < count; ++i) {
+        endpoints[i] = create_bridged_endpoint(node, true);
+    }
+    check_against_walk(node, k_bridged_cluster_id);
+
+    int64_t start = esp_timer_get_time();
+    uint32_t iterated = 0;
+    for (uint32_t i = 0; i < k_iterations; ++i) {
+        for (chip::EndpointId endpoint_id : chip::app::EnabledEndpointsWithServerCluster(k_bridged_cluster_id)) {
+            iterated += endpoint_id != chip::kInvalidEndpointId;
+        }
+    }
+    int64_t iterator_time = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(count * k_iterations, iterated);
+
+    uint16_t endpoint_ids[CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT];
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_iterations; ++i) {
+        TEST_ASSERT_EQUAL(count, walk_enabled_endpoints(node, k_bridged_cluster_id, endpoint_ids,
+                                                        CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT));
+    }
+    int64_t iterator_walk_time = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_iterations; ++i) {
+        for (uint16_t j = 0; j < count; ++j) {
+            TEST_ASSERT_EQUAL(j, emberAfGetClusterServerEndpointIndex(endpoint::get_id(endpoints[j]),
+                                                                      k_bridged_cluster_id, 0));
+        }
+    }
+    int64_t index_time = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_iterations; ++i) {
+        for (uint16_t j = 0; j < count; ++j) {
+            TEST_ASSERT_EQUAL(j, walk_server_endpoint_index(node, endpoint::get_id(endpoints[j]),
+                                                            k_bridged_cluster_id));
+        }
+    }
+    int64_t index_walk_time = esp_timer_get_time() - start;
+
+    printf("endpoints: %u\n", endpoint::get_count(node));
+    printf("EnabledEndpointsWithServerCluster: %" PRId64 " us/iteration, list walk: %" PRId64 " us/iteration\n",
+           iterator_time / k_iterations, iterator_walk_time / k_iterations);
+    printf("emberAfGetClusterServerEndpointIndex(): %" PRId64 " us/sweep, list walk: %" PRId64 " us/sweep\n",
+           index_time / k_iterations, index_walk_time / k_iterations);
+
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(node, endpoints[i]));
+    }
+}
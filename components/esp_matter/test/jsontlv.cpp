@@ -6,8 +6,13 @@
 
 #include <cJSON.h>
 #include <esp_err.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <inttypes.h>
 #include <json_to_tlv.h>
 #include <lib/core/TLV.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <tlv_to_json.h>
 #include <unity.h>
@@ -282,3 +287,310 @@ TEST_CASE("jsontlv rejects invalid numeric boundaries", "[jsontlv][invalid]")
     expect_json_to_tlv_failure(R"({"1:U32":1.5})");
     expect_json_to_tlv_failure(R"({"1:I32":2147483648})");
 }
+
+static constexpr size_t k_benchmark_tlv_buffer_size = 16 * 1024;
+static constexpr uint32_t k_benchmark_iterations = 20;
+
+static esp_err_t encode_json_tree(const char *input_json, chip::TLV::TLVWriter &writer)
+{
+    cJSON *json = cJSON_Parse(input_json);
+    esp_err_t err = esp_matter::json_to_tlv(json, writer, chip::TLV::AnonymousTag());
+    cJSON_Delete(json);
+    return err;
+}
+
+static void expect_same_encoding(const char *input_json)
+{
+    static uint8_t stream_buffer[k_benchmark_tlv_buffer_size];
+    static uint8_t tree_buffer[k_benchmark_tlv_buffer_size];
+    chip::TLV::TLVWriter stream_writer;
+    stream_writer.Init(stream_buffer, sizeof(stream_buffer));
+    chip::TLV::TLVWriter tree_writer;
+    tree_writer.Init(tree_buffer, sizeof(tree_buffer));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter::json_to_tlv(input_json, stream_writer, chip::TLV::AnonymousTag()));
+    TEST_ASSERT_EQUAL(ESP_OK, encode_json_tree(input_json, tree_writer));
+    TEST_ASSERT_EQUAL(tree_writer.GetLengthWritten(), stream_writer.GetLengthWritten());
+    TEST_ASSERT_EQUAL_MEMORY(tree_buffer, stream_buffer, tree_writer.GetLengthWritten());
+}
+
+TEST_CASE("jsontlv streaming encoder matches the cJSON tree encoder", "[jsontlv][streaming]")
+{
+    expect_same_encoding(R"({"5:STR":"chip","2:I16":-1234,"4:BOOL":true,"1:U8":42,"3:NULL":null})");
+    expect_same_encoding(R"( { "1:ARR-OBJ" : [ { "2:U8" : 1 , "1:STR" : "a\"b\\u00e9😀" } , { } ] } )");
+    expect_same_encoding(R"({"300:U32":1,"1:I64":"-1234567890123456789","256:DFP":-2.25,"2:BYT":"AQID"})");
+    expect_same_encoding(R"({"9:OBJ":{"3:STR":"c","1:STR":"a","2:STR":"b"},"2:ARR-?":[],"1:FP":"-INF"})");
+    expect_same_encoding(R"({"1:I64":12345678901,"2:U64":4294967296,"3:I32":-2147483648,"4:U32":4294967295})");
+}
+
+TEST_CASE("jsontlv streaming encoder rejects malformed inputs", "[jsontlv][streaming][invalid]")
+{
+    expect_json_to_tlv_failure(R"({"1:U8":1,"1:U16":2})");
+    expect_json_to_tlv_failure(R"({"2:U8":1,"1:U16":2,"2:STR":"a"})");
+    expect_json_to_tlv_failure(R"({"1:U8":1,})");
+    expect_json_to_tlv_failure(R"({"1:U8":1 "2:U8":2})");
+    expect_json_to_tlv_failure(R"({"1:STR":"unterminated})");
+    expect_json_to_tlv_failure(R"({"1:STR":"\ud800"})");
+    expect_json_to_tlv_failure(R"({"1:ARR-U8":[1,2)");
+    expect_json_to_tlv_failure(R"({"1:U8":tru})");
+
+    // Objects and arrays are nested up to 16 levels
+    char nested[512] = "{";
+    for (int level = 1; level < 16; ++level) {
+        strcat(nested, R"("1:OBJ":{)");
+    }
+    strcat(nested, R"("1:U8":1)");
+    for (int level = 0; level < 16; ++level) {
+        strcat(nested, "}");
+    }
+    uint8_t buffer[k_tlv_buffer_size] = { 0 };
+    chip::TLV::TLVWriter writer;
+    writer.Init(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter::json_to_tlv(nested, writer, chip::TLV::AnonymousTag()));
+
+    char too_nested[sizeof(nested) + 16] = R"({"1:OBJ":)";
+    strcat(too_nested, nested);
+    strcat(too_nested, "}");
+    expect_json_to_tlv_failure(too_nested);
+}
+
+TEST_CASE("jsontlv reports a full TLV buffer", "[jsontlv][streaming]")
+{
+    uint8_t buffer[8] = { 0 };
+    chip::TLV::TLVWriter writer;
+    writer.Init(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE,
+                      esp_matter::json_to_tlv(R"({"1:STR":"longer than the buffer"})", writer,
+                                              chip::TLV::AnonymousTag()));
+}
+
+// A command with many fields in reverse tag order, each third field is a structure
+static char *build_command_payload(uint8_t field_count)
+{
+    size_t json_size = 64 + field_count * 48;
+    char *json = (char *)malloc(json_size);
+    TEST_ASSERT_NOT_NULL(json);
+    size_t len = snprintf(json, json_size, "{");
+    for (int tag = field_count - 1; tag >= 0; --tag) {
+        const char *separator = tag == field_count - 1 ? "" : ",";
+        if (tag % 3 == 0) {
+            len += snprintf(json + len, json_size - len, R"(%s"%d:OBJ":{"1:U16":%d,"0:BOOL":true})", separator, tag,
+                            tag);
+        } else if (tag % 3 == 1) {
+            len += snprintf(json + len, json_size - len, R"(%s"%d:STR":"field %d")", separator, tag, tag);
+        } else {
+            len += snprintf(json + len, json_size - len, R"(%s"%d:U32":%d)", separator, tag, tag * 1000);
+        }
+    }
+    snprintf(json + len, json_size - len, "}");
+    return json;
+}
+
+// A long list of structures, like the entries written to a table attribute
+static char *build_list_payload(uint16_t entry_count)
+{
+    size_t json_size = 64 + entry_count * 64;
+    char *json = (char *)malloc(json_size);
+    TEST_ASSERT_NOT_NULL(json);
+    size_t len = snprintf(json, json_size, R"({"0:ARR-OBJ":[)");
+    for (uint16_t i = 0; i < entry_count; ++i) {
+        len += snprintf(json + len, json_size - len, R"(%s{"0:U16":%u,"1:STR":"entry %u","2:ARR-U8":[1,2,3]})",
+                        i == 0 ? "" : ",", i, i);
+    }
+    snprintf(json + len, json_size - len, "]}");
+    return json;
+}
+
+struct encode_benchmark_result {
+    int64_t time_us;
+    size_t peak_heap;
+};
+
+static void benchmark_encoding(const char *input_json, bool streaming, encode_benchmark_result &result)
+{
+    static uint8_t buffer[k_benchmark_tlv_buffer_size];
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_monitor_local_minimum_free_size_start());
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_benchmark_iterations; ++i) {
+        chip::TLV::TLVWriter writer;
+        writer.Init(buffer, sizeof(buffer));
+        if (streaming) {
+            TEST_ASSERT_EQUAL(ESP_OK, esp_matter::json_to_tlv(input_json, writer, chip::TLV::AnonymousTag()));
+        } else {
+            TEST_ASSERT_EQUAL(ESP_OK, encode_json_tree(input_json, writer));
+        }
+    }
+    result.time_us = (esp_timer_get_time() - start) / k_benchmark_iterations;
+    size_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_monitor_local_minimum_free_size_stop());
+    result.peak_heap = free_before > min_free ? free_before - min_free : 0;
+}
+
+// Compares the two encoders of this tree: cJSON_Parse() followed by json_to_tlv(cJSON *), and json_to_tlv() on the
+// text. The cJSON encoder shares the rewritten scalar and children encoding, so this is not a measurement of the
+// encoder before the streaming one was added.
+static void run_encode_benchmark(const char *name, const char *input_json)
+{
+    encode_benchmark_result tree;
+    encode_benchmark_result stream;
+    benchmark_encoding(input_json, false, tree);
+    benchmark_encoding(input_json, true, stream);
+    size_t json_len = strlen(input_json);
+    printf("%s (%u bytes of json): cJSON_Parse() + json_to_tlv(cJSON *) %" PRId64 " us %u bytes of heap, "
+           "json_to_tlv(const char *) %" PRId64 " us %u bytes of heap\n", name, (unsigned)json_len, tree.time_us,
+           (unsigned)tree.peak_heap, stream.time_us, (unsigned)stream.peak_heap);
+}
+
+TEST_CASE("benchmark json to tlv encoding of large payloads", "[jsontlv][benchmark]")
+{
+    char *command = build_command_payload(120);
+    char *list = build_list_payload(150);
+    expect_same_encoding(command);
+
+    run_encode_benchmark("command with 120 fields", command);
+    run_encode_benchmark("list of 150 structures", list);
+
+    free(command);
+    free(list);
+}
+
+static uint8_t s_text_tlv[k_benchmark_tlv_buffer_size];
+static char s_text[k_benchmark_tlv_buffer_size];
+static size_t s_text_len;
+
+static esp_err_t append_text(const char *data, size_t len, void *ctx)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(128, len);
+    if (s_text_len + len >= sizeof(s_text)) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(s_text + s_text_len, data, len);
+    s_text_len += len;
+    s_text[s_text_len] = '\0';
+    return ESP_OK;
+}
+
+static size_t encode_text_tlv(const char *input_json)
+{
+    chip::TLV::TLVWriter writer;
+    writer.Init(s_text_tlv, sizeof(s_text_tlv));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter::json_to_tlv(input_json, writer, chip::TLV::AnonymousTag()));
+    return writer.GetLengthWritten();
+}
+
+static void expect_same_text(const char *input_json, const esp_matter::tlv_to_json_options &options)
+{
+    size_t tlv_len = encode_text_tlv(input_json);
+    chip::TLV::TLVReader reader;
+    reader.Init(s_text_tlv, tlv_len);
+    cJSON *json = nullptr;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter::tlv_to_json(reader, &json, options));
+    char *expected = cJSON_PrintUnformatted(json);
+    TEST_ASSERT_NOT_NULL(expected);
+    size_t expected_len = strlen(expected);
+
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter::tlv_to_json_string(reader, s_text, sizeof(s_text), &len, options));
+    TEST_ASSERT_EQUAL(expected_len, len);
+    TEST_ASSERT_EQUAL_STRING(expected, s_text);
+
+    s_text_len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter::tlv_to_json_stream(reader, append_text, nullptr, options));
+    TEST_ASSERT_EQUAL(expected_len, s_text_len);
+    TEST_ASSERT_EQUAL_STRING(expected, s_text);
+
+    // A short buffer holds the beginning of the text
+    char truncated[16] = { 0 };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE,
+                      esp_matter::tlv_to_json_string(reader, truncated, sizeof(truncated), &len, options));
+    TEST_ASSERT_EQUAL(sizeof(truncated) - 1, len);
+    TEST_ASSERT_EQUAL_STRING_LEN(expected, truncated, len);
+
+    cJSON_free(expected);
+    cJSON_Delete(json);
+}
+
+TEST_CASE("jsontlv renders the same text as the cJSON tree", "[jsontlv][tlv_to_json]")
+{
+    esp_matter::tlv_to_json_options options;
+    const char *inputs[] = {
+        R"({"5:STR":"quote \" backslash \\ tab \t newline \n é","2:I16":-1234,"4:BOOL":true,"1:U8":42,"3:NULL":null})",
+        R"({"1:I64":"-1234567890123456789","2:U64":"18446744073709551615","3:I32":-2147483648,"4:U32":4294967295})",
+        R"({"1:FP":1.5,"2:DFP":-2.25,"3:FP":0.1,"4:DFP":0.1,"5:FP":"INF","6:DFP":"-INF","7:DFP":1e300})",
+        R"({"1:BYT":"bWF0dGVyMV8y","2:BYT":"AQID","3:BYT":"","4:STR":""})",
+        R"({"1:ARR-?":[],"2:ARR-U16":[1,2,3],"3:ARR-OBJ":[{"1:U8":1},{}],"4:OBJ":{"1:ARR-STR":["a","b"]}})",
+        R"({"300:U32":1,"2:ARR-ARR":[[1,2],[]]})",
+    };
+    for (const char *input : inputs) {
+        expect_same_text(input, options);
+    }
+
+    options.human_readable_bytes = true;
+    expect_same_text(R"({"1:BYT":"bWF0dGVyMV8y","2:BYT":"AQID","3:STR":"already text"})", options);
+    options.tag_format = esp_matter::tlv_json_tag_format::hexadecimal;
+    expect_same_text(R"({"2:OBJ":{"4:BOOL":false,"1:U8":7},"1:ARR-OBJ":[{"254:U8":2}]})", options);
+
+    char *list = build_list_payload(150);
+    expect_same_text(list, esp_matter::tlv_to_json_options {});
+    free(list);
+}
+
+struct render_benchmark_result {
+    int64_t time_us;
+    size_t peak_heap;
+};
+
+enum class render_method {
+    cjson_tree,
+    text_buffer,
+    text_stream,
+};
+
+static void benchmark_rendering(size_t tlv_len, render_method method, render_benchmark_result &result)
+{
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_monitor_local_minimum_free_size_start());
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < k_benchmark_iterations; ++i) {
+        chip::TLV::TLVReader reader;
+        reader.Init(s_text_tlv, tlv_len);
+        if (method == render_method::cjson_tree) {
+            cJSON *json = nullptr;
+            TEST_ASSERT_EQUAL(ESP_OK, esp_matter::tlv_to_json(reader, &json));
+            char *text = cJSON_PrintUnformatted(json);
+            TEST_ASSERT_NOT_NULL(text);
+            cJSON_free(text);
+            cJSON_Delete(json);
+        } else if (method == render_method::text_buffer) {
+            TEST_ASSERT_EQUAL(ESP_OK, esp_matter::tlv_to_json_string(reader, s_text, sizeof(s_text), nullptr,
+                                                                     esp_matter::tlv_to_json_options {}));
+        } else {
+            s_text_len = 0;
+            TEST_ASSERT_EQUAL(ESP_OK, esp_matter::tlv_to_json_stream(reader, append_text, nullptr,
+                                                                     esp_matter::tlv_to_json_options {}));
+        }
+    }
+    result.time_us = (esp_timer_get_time() - start) / k_benchmark_iterations;
+    size_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_monitor_local_minimum_free_size_stop());
+    result.peak_heap = free_before > min_free ? free_before - min_free : 0;
+}
+
+TEST_CASE("benchmark tlv to json text rendering", "[jsontlv][benchmark]")
+{
+    char *list = build_list_payload(150);
+    size_t tlv_len = encode_text_tlv(list);
+    free(list);
+
+    render_benchmark_result tree;
+    render_benchmark_result buffer;
+    render_benchmark_result stream;
+    benchmark_rendering(tlv_len, render_method::cjson_tree, tree);
+    benchmark_rendering(tlv_len, render_method::text_buffer, buffer);
+    benchmark_rendering(tlv_len, render_method::text_stream, stream);
+    printf("list of 150 structures (%u bytes of tlv): cJSON tree and print %" PRId64 " us %u bytes of heap, "
+           "buffer %" PRId64 " us %u bytes of heap, stream %" PRId64 " us %u bytes of heap\n", (unsigned)tlv_len,
+           tree.time_us, (unsigned)tree.peak_heap, buffer.time_us, (unsigned)buffer.peak_heap, stream.time_us,
+           (unsigned)stream.peak_heap);
+}
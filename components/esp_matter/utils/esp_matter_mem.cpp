@@ -12,9 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdint.h>
+#include <string.h>
 #include "esp_attr.h"
 #include "esp_heap_caps.h"
 #include "esp_matter_mem.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "sdkconfig.h"
 
 IRAM_ATTR void *esp_matter_mem_calloc(size_t n, size_t size)
 {
@@ -46,3 +51,149 @@ IRAM_ATTR void esp_matter_mem_free(void *ptr)
 {
     free(ptr);
 }
+
+// The objects are aligned for the 64-bit members of the data model structures.
+#define ESP_MATTER_MEM_POOL_ALIGN 8
+#define ESP_MATTER_MEM_POOL_ROUND_UP(size) (((size) + ESP_MATTER_MEM_POOL_ALIGN - 1) & ~(ESP_MATTER_MEM_POOL_ALIGN - 1))
+
+// The pools share one lock, an allocation or a free only holds it for a few instructions unless a slab is allocated
+static SemaphoreHandle_t get_pool_lock()
+{
+    static StaticSemaphore_t s_pool_lock_buffer;
+    static SemaphoreHandle_t s_pool_lock = xSemaphoreCreateMutexStatic(&s_pool_lock_buffer);
+    return s_pool_lock;
+}
+
+class scoped_pool_lock {
+public:
+    scoped_pool_lock()
+    {
+        xSemaphoreTake(get_pool_lock(), portMAX_DELAY);
+    }
+    ~scoped_pool_lock()
+    {
+        xSemaphoreGive(get_pool_lock());
+    }
+};
+
+#if CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+// Slab header, the objects follow it. A free object stores the pointer to the next free object.
+typedef struct mem_pool_slab {
+    struct mem_pool_slab *next;
+} mem_pool_slab_t;
+
+static const size_t k_slab_header_size = ESP_MATTER_MEM_POOL_ROUND_UP(sizeof(mem_pool_slab_t));
+
+static size_t get_object_stride(const esp_matter_mem_pool_t *pool)
+{
+    size_t size = pool->object_size < sizeof(void *) ? sizeof(void *) : pool->object_size;
+    return ESP_MATTER_MEM_POOL_ROUND_UP(size);
+}
+
+static size_t get_slab_size(const esp_matter_mem_pool_t *pool)
+{
+    return k_slab_header_size + get_object_stride(pool) * pool->objects_per_slab;
+}
+
+static bool grow_pool(esp_matter_mem_pool_t *pool)
+{
+    mem_pool_slab_t *slab = (mem_pool_slab_t *)esp_matter_mem_calloc(1, get_slab_size(pool));
+    if (!slab) {
+        return false;
+    }
+    slab->next = (mem_pool_slab_t *)pool->slab_list;
+    pool->slab_list = slab;
+    pool->slab_count++;
+
+    // Push the objects in reverse order so that they are handed out in address order
+    size_t stride = get_object_stride(pool);
+    uint8_t *objects = (uint8_t *)slab + k_slab_header_size;
+    for (size_t i = pool->objects_per_slab; i > 0; --i) {
+        void *object = objects + (i - 1) * stride;
+        *(void **)object = pool->free_list;
+        pool->free_list = object;
+    }
+    return true;
+}
+
+static void release_slabs(esp_matter_mem_pool_t *pool)
+{
+    mem_pool_slab_t *slab = (mem_pool_slab_t *)pool->slab_list;
+    while (slab) {
+        mem_pool_slab_t *next = slab->next;
+        esp_matter_mem_free(slab);
+        slab = next;
+    }
+    pool->slab_list = NULL;
+    pool->free_list = NULL;
+    pool->slab_count = 0;
+}
+#endif // CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+
+void *esp_matter_mem_pool_calloc(esp_matter_mem_pool_t *pool)
+{
+    scoped_pool_lock lock;
+#if CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    if (!pool->free_list && !grow_pool(pool)) {
+        return NULL;
+    }
+    void *object = pool->free_list;
+    pool->free_list = *(void **)object;
+    memset(object, 0, pool->object_size);
+#else
+    void *object = esp_matter_mem_calloc(1, pool->object_size);
+    if (!object) {
+        return NULL;
+    }
+#endif // CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    pool->in_use++;
+    pool->alloc_count++;
+    if (pool->in_use > pool->peak) {
+        pool->peak = pool->in_use;
+    }
+    return object;
+}
+
+void esp_matter_mem_pool_free(esp_matter_mem_pool_t *pool, void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    scoped_pool_lock lock;
+    pool->in_use--;
+#if CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    // The slabs are kept so that objects freed and allocated again, like the nodes of a bridged device which is
+    // removed and added back, do not allocate and free the slabs every time
+    *(void **)ptr = pool->free_list;
+    pool->free_list = ptr;
+#else
+    esp_matter_mem_free(ptr);
+#endif // CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+}
+
+void esp_matter_mem_pool_trim(esp_matter_mem_pool_t *pool)
+{
+#if CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    scoped_pool_lock lock;
+    if (pool->in_use == 0) {
+        release_slabs(pool);
+    }
+#endif // CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+}
+
+void esp_matter_mem_pool_get_stats(const esp_matter_mem_pool_t *pool, esp_matter_mem_pool_stats_t *stats)
+{
+    scoped_pool_lock lock;
+    stats->name = pool->name;
+    stats->object_size = pool->object_size;
+    stats->in_use = pool->in_use;
+    stats->peak = pool->peak;
+    stats->alloc_count = pool->alloc_count;
+#if CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+    stats->capacity = pool->slab_count * pool->objects_per_slab;
+    stats->heap_bytes = pool->slab_count * get_slab_size(pool);
+#else
+    stats->capacity = pool->in_use;
+    stats->heap_bytes = pool->in_use * pool->object_size;
+#endif // CONFIG_ESP_MATTER_MEM_POOL_ENABLE
+}
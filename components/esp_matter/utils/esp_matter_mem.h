@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 /** ESP Matter Memory Allocations
  * @param[in] n number of elements to be allocated
  * @param[in] size size of elements to be allocated
@@ -30,3 +32,72 @@ void esp_matter_mem_free(void *ptr);
  * @param[in] size size to reallocate
  */
 void *esp_matter_mem_realloc(void *ptr, size_t size);
+
+/** ESP Matter memory pool
+ *
+ * Pool of fixed-size objects which are carved out of slabs allocated with `esp_matter_mem_calloc()`, so the slabs
+ * follow the CONFIG_ESP_MATTER_MEM_ALLOC_MODE choice. Allocating and freeing an object are O(1), the freed objects
+ * are kept in a free list and the slabs are kept until `esp_matter_mem_pool_trim()` is called on the empty pool.
+ *
+ * If CONFIG_ESP_MATTER_MEM_POOL_ENABLE is disabled, the objects are allocated one by one with
+ * `esp_matter_mem_calloc()` and only the counters are maintained.
+ *
+ * The pools are protected by a mutex, they can be used from several tasks but not from an ISR.
+ *
+ * Use `ESP_MATTER_MEM_POOL_INIT()` to define a pool, the other members are internal.
+ */
+typedef struct esp_matter_mem_pool {
+    const char *name;
+    size_t object_size;
+    size_t objects_per_slab;
+    void *free_list;
+    void *slab_list;
+    size_t slab_count;
+    size_t in_use;
+    size_t peak;
+    size_t alloc_count;
+} esp_matter_mem_pool_t;
+
+/** Memory pool usage */
+typedef struct {
+    /** Name of the pool */
+    const char *name;
+    /** Size of one object */
+    size_t object_size;
+    /** Number of objects currently allocated */
+    size_t in_use;
+    /** Maximum number of objects allocated at the same time */
+    size_t peak;
+    /** Number of objects the allocated slabs can hold */
+    size_t capacity;
+    /** Number of allocations since boot */
+    size_t alloc_count;
+    /** Bytes of heap currently used by the pool, including the slab headers */
+    size_t heap_bytes;
+} esp_matter_mem_pool_stats_t;
+
+#define ESP_MATTER_MEM_POOL_INIT(pool_name, type, per_slab) \
+    { (pool_name), sizeof(type), (per_slab), NULL, NULL, 0, 0, 0, 0 }
+
+/** Allocate a zero-initialized object from a memory pool
+ * @param[in] pool memory pool.
+ * @return pointer to the object, NULL if the pool cannot grow.
+ */
+void *esp_matter_mem_pool_calloc(esp_matter_mem_pool_t *pool);
+
+/** Return an object to its memory pool
+ * @param[in] pool memory pool the object was allocated from.
+ * @param[in] ptr pointer to the object, can be NULL.
+ */
+void esp_matter_mem_pool_free(esp_matter_mem_pool_t *pool, void *ptr);
+
+/** Release the slabs of a memory pool if none of its objects is allocated
+ * @param[in] pool memory pool.
+ */
+void esp_matter_mem_pool_trim(esp_matter_mem_pool_t *pool);
+
+/** Get the usage of a memory pool
+ * @param[in] pool memory pool.
+ * @param[out] stats usage of the pool.
+ */
+void esp_matter_mem_pool_get_stats(const esp_matter_mem_pool_t *pool, esp_matter_mem_pool_stats_t *stats);
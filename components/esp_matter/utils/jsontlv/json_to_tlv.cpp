@@ -21,6 +21,7 @@
 #include <lib/support/Base64.h>
 #include <lib/support/SafeInt.h>
 
+#include <limits.h>
 #include <stdlib.h>
 #include "support/CodeUtils.h"
 
@@ -33,24 +34,50 @@ constexpr uint32_t k_temporary_implicit_profile_id = 0xFF01;
 namespace esp_matter {
 
 constexpr size_t k_max_json_name_len = 64;
+// The longest number that cJSON parses, strings of 64-bit integers are limited to the same length
+constexpr size_t k_max_json_number_len = 63;
+// The streaming encoder recurses once per nested array or object, this bounds its stack usage
+constexpr uint8_t k_max_nesting_depth = 16;
 
 struct element_context {
-    element_context() : json_name{}, type(TLV::TLVElementType::NotSpecified), sub_type(TLV::TLVElementType::NotSpecified) {}
+    element_context() : type(TLV::TLVElementType::NotSpecified), sub_type(TLV::TLVElementType::NotSpecified) {}
     ~element_context() {}
-    char json_name[k_max_json_name_len];
     TLV::Tag tag = chip::TLV::AnonymousTag();
     TLV::TLVElementType type;
     TLV::TLVElementType sub_type;
+    // The value of the element, either in the cJSON tree or in the JSON text
+    const cJSON *json = nullptr;
+    const char *json_text = nullptr;
 };
 
-static int compare_by_tag(const void *a, const void *b)
+// A JSON value which is not a container, taken from a cJSON item or straight from the JSON text. The string is
+// not NUL-terminated when it points into the JSON text.
+struct json_scalar {
+    int type = cJSON_Invalid;
+    int valueint = 0;
+    double valuedouble = 0;
+    const char *valuestring = nullptr;
+    size_t valuestring_len = 0;
+};
+
+// Profile tags come before context tags, then the tags are ordered by their number
+static uint64_t get_tag_order(const TLV::Tag &tag)
+{
+    return (TLV::IsContextTag(tag) ? (1ULL << 32) : 0) | TLV::TagNumFromTag(tag);
+}
+
+static bool compare_by_tag(const element_context &element_a, const element_context &element_b)
 {
-    const element_context *element_a = (const element_context *)a;
-    const element_context *element_b = (const element_context *)b;
-    if (TLV::IsContextTag(element_a->tag) == TLV::IsContextTag(element_b->tag)) {
-        return (int)TLV::TagNumFromTag(element_a->tag) - (int)TLV::TagNumFromTag(element_b->tag);
+    return get_tag_order(element_a.tag) < get_tag_order(element_b.tag);
+}
+
+static esp_err_t check_unique_tags(const element_context *element_array, size_t element_count)
+{
+    for (size_t i = 1; i < element_count; ++i) {
+        ESP_RETURN_ON_FALSE(get_tag_order(element_array[i - 1].tag) != get_tag_order(element_array[i].tag),
+                            ESP_ERR_INVALID_ARG, TAG, "Duplicate tag in json object");
     }
-    return TLV::IsContextTag(element_a->tag);
+    return ESP_OK;
 }
 
 static size_t get_char_count(const char *str, char ch)
@@ -80,12 +107,41 @@ static bool is_unsigned_integer(const char *str, size_t len)
     return true;
 }
 
-static bool is_integral_json_number(const cJSON *val)
+static bool is_integral_json_number(const json_scalar &val)
+{
+    if (val.type != cJSON_Number) {
+        return false;
+    }
+    return static_cast<double>(val.valueint) == val.valuedouble;
+}
+
+static bool is_equal_json_string(const json_scalar &val, const char *str)
+{
+    size_t len = strlen(str);
+    return val.valuestring && val.valuestring_len == len && memcmp(val.valuestring, str, len) == 0;
+}
+
+// strtoll() and strtoull() need a NUL-terminated copy of the integer strings
+static bool copy_integer_string(const json_scalar &val, char (&buf)[k_max_json_number_len + 1])
 {
-    if (val == nullptr || val->type != cJSON_Number) {
+    if (!val.valuestring || val.valuestring_len == 0 || val.valuestring_len > k_max_json_number_len) {
         return false;
     }
-    return static_cast<double>(val->valueint) == val->valuedouble;
+    memcpy(buf, val.valuestring, val.valuestring_len);
+    buf[val.valuestring_len] = '\0';
+    return true;
+}
+
+// A full TLV buffer is reported apart from the other failures so that the callers can retry with a larger one
+static esp_err_t encode_result(CHIP_ERROR err)
+{
+    if (err == CHIP_NO_ERROR) {
+        return ESP_OK;
+    }
+    if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_FAIL;
 }
 
 static esp_err_t type_str_to_tlv_element_type(const char *type_str, size_t len, TLVElementType &type)
@@ -198,20 +254,21 @@ static esp_err_t parse_json_name(const char *name, element_context &element_ctx,
                         "Failed to parse json name");
     ESP_RETURN_ON_ERROR(internal_convert_tlv_tag(tag_number, element_ctx.tag, implicit_profile_id), TAG,
                         "Failed to convert TLV tag");
-    strlcpy(element_ctx.json_name, name, sizeof(element_ctx.json_name));
     return ESP_OK;
 }
 
-static bool is_valid_base64_str(const char *str)
+static bool is_valid_base64_str(const char *str, size_t len)
 {
     const char *base64_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     if (!str) {
         return false;
     }
-    size_t len = strlen(str);
     if (len % 4 != 0) {
         return false;
     }
+    if (len == 0) {
+        return true;
+    }
     size_t padding_len = 0;
     if (str[len - 1] == '=') {
         padding_len++;
@@ -220,7 +277,7 @@ static bool is_valid_base64_str(const char *str)
         }
     }
     for (size_t i = 0; i < len - padding_len; ++i) {
-        if (strchr(base64_chars, str[i]) == NULL) {
+        if (str[i] == '\0' || strchr(base64_chars, str[i]) == NULL) {
             return false;
         }
     }
@@ -239,108 +296,109 @@ static size_t get_object_element_count(const cJSON *json)
     return ret;
 }
 
-static esp_err_t encode_tlv_element(const cJSON *val, TLV::TLVWriter &writer, const element_context &element_ctx)
+static esp_err_t encode_tlv_scalar(const json_scalar &val, TLV::TLVWriter &writer, TLV::Tag tag,
+                                   TLV::TLVElementType type)
 {
-    TLV::Tag tag = element_ctx.tag;
-
-    switch (element_ctx.type) {
+    switch (type) {
     case TLVElementType::Int8: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= INT8_MAX && val->valueint >= INT8_MIN, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(val.valueint <= INT8_MAX && val.valueint >= INT8_MIN, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid range");
-        int8_t int8_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int8_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        int8_t int8_val = val.valueint;
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, int8_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::Int16: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= INT16_MAX && val->valueint >= INT16_MIN, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(val.valueint <= INT16_MAX && val.valueint >= INT16_MIN, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid range");
-        int16_t int16_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int16_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        int16_t int16_val = val.valueint;
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, int16_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::Int32: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
         ESP_RETURN_ON_FALSE(is_integral_json_number(val), ESP_ERR_INVALID_ARG, TAG, "Invalid value");
-        ESP_RETURN_ON_FALSE(val->valuedouble <= INT32_MAX && val->valuedouble >= INT32_MIN, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.valuedouble <= INT32_MAX && val.valuedouble >= INT32_MIN, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid range");
-        int32_t int32_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int32_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        int32_t int32_val = val.valueint;
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, int32_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::Int64: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number || val->type == cJSON_String, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number || val.type == cJSON_String, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid type");
         int64_t int64_val = 0;
-        if (val->type == cJSON_Number) {
+        if (val.type == cJSON_Number) {
             int64_val =
-                (val->valueint < INT32_MAX && val->valueint > INT32_MIN) ? val->valueint : (int64_t)val->valuedouble;
+                (val.valueint < INT32_MAX && val.valueint > INT32_MIN) ? val.valueint : (int64_t)val.valuedouble;
         } else {
-            ESP_RETURN_ON_FALSE(val->valuestring && val->valuestring[0] != '\0', ESP_ERR_INVALID_ARG, TAG,
+            char int64_str[k_max_json_number_len + 1];
+            ESP_RETURN_ON_FALSE(copy_integer_string(val, int64_str), ESP_ERR_INVALID_ARG, TAG,
                                 "Invalid int64 string");
             char *end = nullptr;
-            int64_val = strtoll(val->valuestring, &end, 10);
-            ESP_RETURN_ON_FALSE(end != val->valuestring && end && *end == '\0', ESP_ERR_INVALID_ARG, TAG,
+            int64_val = strtoll(int64_str, &end, 10);
+            ESP_RETURN_ON_FALSE(end != int64_str && end && *end == '\0', ESP_ERR_INVALID_ARG, TAG,
                                 "Invalid int64 string");
         }
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int64_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, int64_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::UInt8: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= UINT8_MAX && val->valueint >= 0, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(val.valueint <= UINT8_MAX && val.valueint >= 0, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid range");
-        uint8_t uint8_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint8_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        uint8_t uint8_val = val.valueint;
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, uint8_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::UInt16: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= UINT16_MAX && val->valueint >= 0, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(val.valueint <= UINT16_MAX && val.valueint >= 0, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid range");
-        uint16_t uint16_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint16_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        uint16_t uint16_val = val.valueint;
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, uint16_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::UInt32: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
         ESP_RETURN_ON_FALSE(is_integral_json_number(val), ESP_ERR_INVALID_ARG, TAG, "Invalid value");
-        ESP_RETURN_ON_FALSE(val->valuedouble >= 0 && val->valuedouble <= UINT32_MAX, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.valuedouble >= 0 && val.valuedouble <= UINT32_MAX, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid range");
-        uint32_t uint32_val = static_cast<uint32_t>(val->valuedouble);
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint32_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        uint32_t uint32_val = static_cast<uint32_t>(val.valuedouble);
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, uint32_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::UInt64: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number || val->type == cJSON_String, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.type == cJSON_Number || val.type == cJSON_String, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid type");
         uint64_t uint64_val = 0;
-        if (val->type == cJSON_Number) {
-            ESP_RETURN_ON_FALSE(val->valueint >= 0, ESP_ERR_INVALID_ARG, TAG, "Invalid range");
-            uint64_val = val->valueint < INT32_MAX ? val->valueint : (uint64_t)val->valuedouble;
+        if (val.type == cJSON_Number) {
+            ESP_RETURN_ON_FALSE(val.valueint >= 0, ESP_ERR_INVALID_ARG, TAG, "Invalid range");
+            uint64_val = val.valueint < INT32_MAX ? val.valueint : (uint64_t)val.valuedouble;
         } else {
-            ESP_RETURN_ON_FALSE(val->valuestring && val->valuestring[0] != '\0', ESP_ERR_INVALID_ARG, TAG,
+            char uint64_str[k_max_json_number_len + 1];
+            ESP_RETURN_ON_FALSE(copy_integer_string(val, uint64_str), ESP_ERR_INVALID_ARG, TAG,
                                 "Invalid uint64 string");
             char *end = nullptr;
-            uint64_val = strtoull(val->valuestring, &end, 10);
-            ESP_RETURN_ON_FALSE(end != val->valuestring && end && *end == '\0', ESP_ERR_INVALID_ARG, TAG,
+            uint64_val = strtoull(uint64_str, &end, 10);
+            ESP_RETURN_ON_FALSE(end != uint64_str && end && *end == '\0', ESP_ERR_INVALID_ARG, TAG,
                                 "Invalid uint64 string");
         }
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint64_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, uint64_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::FloatingPointNumber32: {
-        if (val->type == cJSON_Number) {
-            float float_val = val->valuedouble;
-            ESP_RETURN_ON_FALSE(writer.Put(tag, float_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        } else if (val->type == cJSON_String) {
-            if (strcmp(val->valuestring, element_type::k_floating_point_positive_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, std::numeric_limits<float>::infinity()) == CHIP_NO_ERROR, ESP_FAIL,
-                                    TAG, "Failed to encode");
-            } else if (strcmp(val->valuestring, element_type::k_floating_point_negative_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, -std::numeric_limits<float>::infinity()) == CHIP_NO_ERROR, ESP_FAIL,
-                                    TAG, "Failed to encode");
+        if (val.type == cJSON_Number) {
+            float float_val = val.valuedouble;
+            ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, float_val)), TAG, "Failed to encode");
+        } else if (val.type == cJSON_String) {
+            if (is_equal_json_string(val, element_type::k_floating_point_positive_infinity)) {
+                ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, std::numeric_limits<float>::infinity())), TAG,
+                                    "Failed to encode");
+            } else if (is_equal_json_string(val, element_type::k_floating_point_negative_infinity)) {
+                ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, -std::numeric_limits<float>::infinity())), TAG,
+                                    "Failed to encode");
             } else {
                 return ESP_ERR_INVALID_ARG;
             }
@@ -351,16 +409,16 @@ static esp_err_t encode_tlv_element(const cJSON *val, TLV::TLVWriter &writer, co
         break;
     }
     case TLVElementType::FloatingPointNumber64: {
-        if (val->type == cJSON_Number) {
-            double double_val = val->valuedouble;
-            ESP_RETURN_ON_FALSE(writer.Put(tag, double_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        } else if (val->type == cJSON_String) {
-            if (strcmp(val->valuestring, element_type::k_floating_point_positive_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, std::numeric_limits<double>::infinity()) == CHIP_NO_ERROR, ESP_FAIL,
-                                    TAG, "Failed to encode");
-            } else if (strcmp(val->valuestring, element_type::k_floating_point_negative_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, -std::numeric_limits<double>::infinity()) == CHIP_NO_ERROR,
-                                    ESP_FAIL, TAG, "Failed to encode");
+        if (val.type == cJSON_Number) {
+            double double_val = val.valuedouble;
+            ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, double_val)), TAG, "Failed to encode");
+        } else if (val.type == cJSON_String) {
+            if (is_equal_json_string(val, element_type::k_floating_point_positive_infinity)) {
+                ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, std::numeric_limits<double>::infinity())), TAG,
+                                    "Failed to encode");
+            } else if (is_equal_json_string(val, element_type::k_floating_point_negative_infinity)) {
+                ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, -std::numeric_limits<double>::infinity())), TAG,
+                                    "Failed to encode");
             } else {
                 return ESP_ERR_INVALID_ARG;
             }
@@ -372,57 +430,86 @@ static esp_err_t encode_tlv_element(const cJSON *val, TLV::TLVWriter &writer, co
     }
     case TLVElementType::BooleanTrue:
     case TLVElementType::BooleanFalse: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_False || val->type == cJSON_True, ESP_ERR_INVALID_ARG, TAG,
+        ESP_RETURN_ON_FALSE(val.type == cJSON_False || val.type == cJSON_True, ESP_ERR_INVALID_ARG, TAG,
                             "Invalid type");
-        bool bool_val = (val->type == cJSON_True);
-        ESP_RETURN_ON_FALSE(writer.Put(tag, bool_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        bool bool_val = (val.type == cJSON_True);
+        ESP_RETURN_ON_ERROR(encode_result(writer.Put(tag, bool_val)), TAG, "Failed to encode");
         break;
     }
     case TLVElementType::ByteString_1ByteLength: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_String && val->valuestring, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        size_t encoded_len = strlen(val->valuestring);
+        ESP_RETURN_ON_FALSE(val.type == cJSON_String && val.valuestring, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        size_t encoded_len = val.valuestring_len;
         ESP_RETURN_ON_FALSE(chip::CanCastTo<uint16_t>(encoded_len), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(is_valid_base64_str(val->valuestring), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(is_valid_base64_str(val.valuestring, encoded_len), ESP_ERR_INVALID_ARG, TAG,
+                            "Invalid type");
+        if (encoded_len == 0) {
+            ESP_RETURN_ON_ERROR(encode_result(writer.PutBytes(tag, nullptr, 0)), TAG, "Failed to encode");
+            break;
+        }
         Platform::ScopedMemoryBuffer<uint8_t> byte_str;
         byte_str.Alloc(BASE64_MAX_DECODED_LEN(static_cast<uint16_t>(encoded_len)));
         ESP_RETURN_ON_FALSE(byte_str.Get(), ESP_ERR_NO_MEM, TAG, "No memory");
-        auto decoded_len = Base64Decode(val->valuestring, static_cast<uint16_t>(encoded_len), byte_str.Get());
-        ESP_RETURN_ON_FALSE(writer.PutBytes(tag, byte_str.Get(), decoded_len) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+        auto decoded_len = Base64Decode(val.valuestring, static_cast<uint16_t>(encoded_len), byte_str.Get());
+        ESP_RETURN_ON_ERROR(encode_result(writer.PutBytes(tag, byte_str.Get(), decoded_len)), TAG,
                             "Failed to encode");
         break;
     }
     case TLVElementType::UTF8String_1ByteLength: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_String, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(writer.PutString(tag, val->valuestring) == CHIP_NO_ERROR, ESP_FAIL, TAG,
-                            "Failed to encode");
+        ESP_RETURN_ON_FALSE(val.type == cJSON_String && val.valuestring, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(chip::CanCastTo<uint32_t>(val.valuestring_len), ESP_ERR_INVALID_ARG, TAG,
+                            "Invalid size");
+        ESP_RETURN_ON_ERROR(encode_result(writer.PutString(tag, val.valuestring,
+                                                           static_cast<uint32_t>(val.valuestring_len))),
+                            TAG, "Failed to encode");
         break;
     }
     case TLVElementType::Null: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(writer.PutNull(tag) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+        ESP_RETURN_ON_FALSE(val.type == cJSON_NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_ERROR(encode_result(writer.PutNull(tag)), TAG, "Failed to encode");
         break;
     }
+    default:
+        break;
+    }
+    return ESP_OK;
+}
+
+/* cJSON tree encoder */
+
+static void get_json_scalar(const cJSON *json, json_scalar &val)
+{
+    val.type = json->type;
+    val.valueint = json->valueint;
+    val.valuedouble = json->valuedouble;
+    val.valuestring = json->valuestring;
+    val.valuestring_len = json->valuestring ? strlen(json->valuestring) : 0;
+}
+
+static esp_err_t encode_tlv_element(const cJSON *val, TLV::TLVWriter &writer, const element_context &element_ctx)
+{
+    TLV::Tag tag = element_ctx.tag;
+
+    switch (element_ctx.type) {
     case TLVElementType::Array: {
         TLV::TLVType container_type;
         esp_err_t err = ESP_OK;
-        size_t array_size = cJSON_GetArraySize(val);
         ESP_RETURN_ON_FALSE(val->type == cJSON_Array, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
         if (element_ctx.sub_type == TLV::TLVElementType::NotSpecified) {
-            ESP_RETURN_ON_FALSE(array_size == 0, ESP_ERR_INVALID_ARG, TAG, "Invalid array size");
+            ESP_RETURN_ON_FALSE(val->child == nullptr, ESP_ERR_INVALID_ARG, TAG, "Invalid array size");
         }
-        ESP_RETURN_ON_FALSE(writer.StartContainer(tag, TLV::kTLVType_Array, container_type) == CHIP_NO_ERROR, ESP_FAIL,
-                            TAG, "Failed to start container");
+        ESP_RETURN_ON_ERROR(encode_result(writer.StartContainer(tag, TLV::kTLVType_Array, container_type)), TAG,
+                            "Failed to start container");
         element_context nested_element_ctx;
         nested_element_ctx.tag = TLV::AnonymousTag();
         nested_element_ctx.type = element_ctx.sub_type;
-        for (size_t i = 0; i < array_size; ++i) {
-            if ((err = encode_tlv_element(cJSON_GetArrayItem(val, i), writer, nested_element_ctx)) != ESP_OK) {
+        for (const cJSON *item = val->child; item; item = item->next) {
+            if ((err = encode_tlv_element(item, writer, nested_element_ctx)) != ESP_OK) {
                 ESP_LOGE(TAG, "Failed to encode");
                 ReturnValueOnFailure(writer.EndContainer(container_type), ESP_FAIL);
                 return err;
             }
         }
-        ESP_RETURN_ON_FALSE(writer.EndContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to end container");
+        ESP_RETURN_ON_ERROR(encode_result(writer.EndContainer(container_type)), TAG, "Failed to end container");
         break;
     }
     case TLVElementType::Structure: {
@@ -437,35 +524,466 @@ static esp_err_t encode_tlv_element(const cJSON *val, TLV::TLVWriter &writer, co
         while (element && element_idx < element_count) {
             ESP_RETURN_ON_ERROR(parse_json_name(element->string, element_array[element_idx], writer.ImplicitProfileId),
                                 TAG, "Failed to parse json name");
+            element_array[element_idx].json = element;
             element = element->next;
             element_idx++;
         }
-        qsort(element_array.get(), element_count, sizeof(element_context), compare_by_tag);
-        ESP_RETURN_ON_FALSE(writer.StartContainer(tag, TLV::kTLVType_Structure, container_type) == CHIP_NO_ERROR,
-                            ESP_FAIL, TAG, "Failed to start container");
+        std::sort(element_array.get(), element_array.get() + element_count, compare_by_tag);
+        ESP_RETURN_ON_ERROR(check_unique_tags(element_array.get(), element_count), TAG, "Invalid json object");
+        ESP_RETURN_ON_ERROR(encode_result(writer.StartContainer(tag, TLV::kTLVType_Structure, container_type)), TAG,
+                            "Failed to start container");
         for (element_idx = 0; element_idx < element_count; ++element_idx) {
-            if ((err = encode_tlv_element(cJSON_GetObjectItem(val, element_array[element_idx].json_name), writer,
-                                          element_array[element_idx])) != ESP_OK) {
+            if ((err = encode_tlv_element(element_array[element_idx].json, writer, element_array[element_idx])) !=
+                    ESP_OK) {
                 ESP_LOGE(TAG, "Failed to encode");
                 // Ignore the return value of EndContainer()
                 (void)writer.EndContainer(container_type);
                 return err;
             }
         }
-        ESP_RETURN_ON_FALSE(writer.EndContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to end container");
+        ESP_RETURN_ON_ERROR(encode_result(writer.EndContainer(container_type)), TAG, "Failed to end container");
         break;
     }
-    default:
-        break;
+    default: {
+        json_scalar scalar;
+        get_json_scalar(val, scalar);
+        return encode_tlv_scalar(scalar, writer, tag, element_ctx.type);
+    }
+    }
+    return ESP_OK;
+}
+
+/* Streaming encoder
+ *
+ * The JSON text is tokenized in place and each value is written to the TLVWriter as soon as it is parsed, no cJSON
+ * tree is built. The members of an object are encoded in their order in the text when their tags are already sorted,
+ * which is what the JSON produced by tlv_to_json() and by most clients looks like. Otherwise a first pass indexes the
+ * members of that object, sorts the index and encodes the values from there.
+ */
+
+static void skip_whitespace(const char *&json)
+{
+    // Like cJSON, all the control characters are whitespaces
+    while (*json != '\0' && static_cast<unsigned char>(*json) <= ' ') {
+        json++;
+    }
+}
+
+// Find the bounds of the string at json, json is moved after the closing quote
+static esp_err_t scan_string(const char *&json, const char *&str, size_t &len, bool &escaped)
+{
+    ESP_RETURN_ON_FALSE(*json == '"', ESP_ERR_INVALID_ARG, TAG, "Expected a string");
+    const char *end = json + 1;
+    escaped = false;
+    while (*end != '"') {
+        ESP_RETURN_ON_FALSE(*end != '\0', ESP_ERR_INVALID_ARG, TAG, "Unterminated string");
+        if (*end == '\\') {
+            escaped = true;
+            end++;
+            ESP_RETURN_ON_FALSE(*end != '\0', ESP_ERR_INVALID_ARG, TAG, "Unterminated string");
+        }
+        end++;
+    }
+    str = json + 1;
+    len = end - str;
+    json = end + 1;
+    return ESP_OK;
+}
+
+static bool parse_hex4(const char *str, uint32_t &value)
+{
+    value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        char ch = str[i];
+        value <<= 4;
+        if (ch >= '0' && ch <= '9') {
+            value |= ch - '0';
+        } else if (ch >= 'a' && ch <= 'f') {
+            value |= ch - 'a' + 10;
+        } else if (ch >= 'A' && ch <= 'F') {
+            value |= ch - 'A' + 10;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t encode_utf8(uint32_t code_point, char *out)
+{
+    if (code_point < 0x80) {
+        out[0] = static_cast<char>(code_point);
+        return 1;
+    } else if (code_point < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (code_point >> 6));
+        out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 2;
+    } else if (code_point < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (code_point >> 12));
+        out[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (code_point >> 18));
+    out[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+// Unescape a string found by scan_string(), the output is never longer than the input
+static esp_err_t unescape_string(const char *str, size_t len, char *out, size_t &out_len)
+{
+    const char *end = str + len;
+    out_len = 0;
+    while (str < end) {
+        if (*str != '\\') {
+            out[out_len++] = *str++;
+            continue;
+        }
+        // scan_string() ensures that a backslash is followed by another character
+        str++;
+        switch (*str) {
+        case '"':
+        case '\\':
+        case '/':
+            out[out_len++] = *str;
+            break;
+        case 'b':
+            out[out_len++] = '\b';
+            break;
+        case 'f':
+            out[out_len++] = '\f';
+            break;
+        case 'n':
+            out[out_len++] = '\n';
+            break;
+        case 'r':
+            out[out_len++] = '\r';
+            break;
+        case 't':
+            out[out_len++] = '\t';
+            break;
+        case 'u': {
+            uint32_t code_point = 0;
+            ESP_RETURN_ON_FALSE(end - str > 4 && parse_hex4(str + 1, code_point), ESP_ERR_INVALID_ARG, TAG,
+                                "Invalid unicode escape");
+            str += 4;
+            if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+                uint32_t low_surrogate = 0;
+                ESP_RETURN_ON_FALSE(end - str > 6 && str[1] == '\\' && str[2] == 'u' &&
+                                    parse_hex4(str + 3, low_surrogate) && low_surrogate >= 0xDC00 &&
+                                    low_surrogate <= 0xDFFF, ESP_ERR_INVALID_ARG, TAG, "Invalid surrogate pair");
+                code_point = 0x10000 + (((code_point & 0x3FF) << 10) | (low_surrogate & 0x3FF));
+                str += 6;
+            } else {
+                ESP_RETURN_ON_FALSE(code_point < 0xDC00 || code_point > 0xDFFF, ESP_ERR_INVALID_ARG, TAG,
+                                    "Invalid surrogate pair");
+            }
+            out_len += encode_utf8(code_point, out + out_len);
+            break;
+        }
+        default:
+            ESP_LOGE(TAG, "Invalid escape sequence");
+            return ESP_ERR_INVALID_ARG;
+        }
+        str++;
+    }
+    return ESP_OK;
+}
+
+// Move json to the end of the value at json, without validating the value. The value is validated when it is encoded.
+static esp_err_t skip_json_value(const char *&json)
+{
+    size_t nesting = 0;
+    do {
+        skip_whitespace(json);
+        switch (*json) {
+        case '\0':
+            ESP_LOGE(TAG, "Unexpected end of json");
+            return ESP_ERR_INVALID_ARG;
+        case '"': {
+            const char *str = nullptr;
+            size_t len = 0;
+            bool escaped = false;
+            ESP_RETURN_ON_ERROR(scan_string(json, str, len, escaped), TAG, "Failed to skip string");
+            break;
+        }
+        case '{':
+        case '[':
+            nesting++;
+            json++;
+            break;
+        case '}':
+        case ']':
+            ESP_RETURN_ON_FALSE(nesting > 0, ESP_ERR_INVALID_ARG, TAG, "Unexpected end of container");
+            nesting--;
+            json++;
+            break;
+        case ',':
+        case ':':
+            ESP_RETURN_ON_FALSE(nesting > 0, ESP_ERR_INVALID_ARG, TAG, "Unexpected separator");
+            json++;
+            break;
+        default:
+            // Numbers and literals
+            while (*json != '\0' && static_cast<unsigned char>(*json) > ' ' && !strchr("\"{}[],:", *json)) {
+                json++;
+            }
+            break;
+        }
+    } while (nesting > 0);
+    return ESP_OK;
+}
+
+static esp_err_t parse_number(const char *&json, json_scalar &val)
+{
+    // Same characters and length as the cJSON parser, so that both encoders accept the same numbers
+    char number_str[k_max_json_number_len + 1];
+    size_t len = 0;
+    while (len < k_max_json_number_len && json[len] != '\0' && strchr("0123456789+-eE.", json[len])) {
+        number_str[len] = json[len];
+        len++;
+    }
+    number_str[len] = '\0';
+    char *end = nullptr;
+    double number = strtod(number_str, &end);
+    ESP_RETURN_ON_FALSE(end && end != number_str, ESP_ERR_INVALID_ARG, TAG, "Invalid number");
+    json += end - number_str;
+    val.type = cJSON_Number;
+    val.valuedouble = number;
+    if (number >= INT_MAX) {
+        val.valueint = INT_MAX;
+    } else if (number <= (double)INT_MIN) {
+        val.valueint = INT_MIN;
+    } else {
+        val.valueint = (int)number;
+    }
+    return ESP_OK;
+}
+
+// Strings without escape sequences are used in place, the others are unescaped to the unescaped buffer
+static esp_err_t parse_json_scalar(const char *&json, json_scalar &val, Platform::ScopedMemoryBuffer<char> &unescaped)
+{
+    if (*json == '"') {
+        const char *str = nullptr;
+        size_t len = 0;
+        bool escaped = false;
+        ESP_RETURN_ON_ERROR(scan_string(json, str, len, escaped), TAG, "Failed to parse string");
+        val.type = cJSON_String;
+        if (!escaped) {
+            val.valuestring = str;
+            val.valuestring_len = len;
+            return ESP_OK;
+        }
+        unescaped.Alloc(len);
+        ESP_RETURN_ON_FALSE(unescaped.Get(), ESP_ERR_NO_MEM, TAG, "No memory");
+        ESP_RETURN_ON_ERROR(unescape_string(str, len, unescaped.Get(), val.valuestring_len), TAG,
+                            "Failed to parse string");
+        val.valuestring = unescaped.Get();
+        return ESP_OK;
+    }
+    if (*json == '-' || (*json >= '0' && *json <= '9')) {
+        return parse_number(json, val);
+    }
+    if (strncmp(json, "null", 4) == 0) {
+        val.type = cJSON_NULL;
+        json += 4;
+    } else if (strncmp(json, "false", 5) == 0) {
+        val.type = cJSON_False;
+        json += 5;
+    } else if (strncmp(json, "true", 4) == 0) {
+        val.type = cJSON_True;
+        val.valueint = 1;
+        json += 4;
+    } else {
+        ESP_LOGE(TAG, "Invalid type");
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+// Parse the name of the next member of an object and move json to its value
+static esp_err_t parse_next_member(const char *&json, bool first, element_context &element_ctx,
+                                   uint32_t implicit_profile_id)
+{
+    skip_whitespace(json);
+    if (!first) {
+        ESP_RETURN_ON_FALSE(*json == ',', ESP_ERR_INVALID_ARG, TAG, "Expected ',' or '}'");
+        json++;
+        skip_whitespace(json);
+    }
+    const char *name = nullptr;
+    size_t name_len = 0;
+    bool escaped = false;
+    char name_buf[k_max_json_name_len];
+    ESP_RETURN_ON_ERROR(scan_string(json, name, name_len, escaped), TAG, "Failed to parse json name");
+    ESP_RETURN_ON_FALSE(name_len < sizeof(name_buf), ESP_ERR_INVALID_ARG, TAG, "Too long json name");
+    if (escaped) {
+        size_t unescaped_len = 0;
+        ESP_RETURN_ON_ERROR(unescape_string(name, name_len, name_buf, unescaped_len), TAG,
+                            "Failed to parse json name");
+        name_len = unescaped_len;
+    } else {
+        memcpy(name_buf, name, name_len);
+    }
+    name_buf[name_len] = '\0';
+    skip_whitespace(json);
+    ESP_RETURN_ON_FALSE(*json == ':', ESP_ERR_INVALID_ARG, TAG, "Expected ':'");
+    json++;
+    skip_whitespace(json);
+    element_ctx.json_text = json;
+    return parse_json_name(name_buf, element_ctx, implicit_profile_id);
+}
+
+static esp_err_t encode_json_value(const char *&json, TLV::TLVWriter &writer, const element_context &element_ctx,
+                                   uint8_t depth);
+
+static esp_err_t encode_json_object(const char *&json, TLV::TLVWriter &writer, TLV::Tag tag, uint8_t depth)
+{
+    ESP_RETURN_ON_FALSE(*json == '{', ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+    ESP_RETURN_ON_FALSE(depth < k_max_nesting_depth, ESP_ERR_INVALID_ARG, TAG, "Too deeply nested json");
+    const char *members = json + 1;
+
+    // Find the end of the object and check whether the tags of its members are sorted
+    size_t element_count = 0;
+    bool sorted = true;
+    element_context element_ctx;
+    uint64_t prev_tag_order = 0;
+    json = members;
+    skip_whitespace(json);
+    while (*json != '}') {
+        ESP_RETURN_ON_ERROR(parse_next_member(json, element_count == 0, element_ctx, writer.ImplicitProfileId), TAG,
+                            "Failed to parse json name");
+        ESP_RETURN_ON_ERROR(skip_json_value(json), TAG, "Failed to parse json value");
+        skip_whitespace(json);
+        uint64_t tag_order = get_tag_order(element_ctx.tag);
+        if (element_count > 0) {
+            ESP_RETURN_ON_FALSE(tag_order != prev_tag_order, ESP_ERR_INVALID_ARG, TAG, "Duplicate tag in json object");
+            sorted = sorted && tag_order > prev_tag_order;
+        }
+        prev_tag_order = tag_order;
+        element_count++;
+    }
+    const char *object_end = json + 1;
+
+    std::unique_ptr<element_context[]> element_array;
+    if (!sorted) {
+        element_array = std::make_unique<element_context[]>(element_count);
+        ESP_RETURN_ON_FALSE(element_array.get(), ESP_ERR_NO_MEM, TAG, "No memory for element_array");
+        json = members;
+        for (size_t element_idx = 0; element_idx < element_count; ++element_idx) {
+            ESP_RETURN_ON_ERROR(parse_next_member(json, element_idx == 0, element_array[element_idx],
+                                                  writer.ImplicitProfileId), TAG, "Failed to parse json name");
+            ESP_RETURN_ON_ERROR(skip_json_value(json), TAG, "Failed to parse json value");
+        }
+        std::sort(element_array.get(), element_array.get() + element_count, compare_by_tag);
+        ESP_RETURN_ON_ERROR(check_unique_tags(element_array.get(), element_count), TAG, "Invalid json object");
+    }
+
+    TLV::TLVType container_type;
+    esp_err_t err = ESP_OK;
+    ESP_RETURN_ON_ERROR(encode_result(writer.StartContainer(tag, TLV::kTLVType_Structure, container_type)), TAG,
+                        "Failed to start container");
+    json = members;
+    for (size_t element_idx = 0; element_idx < element_count && err == ESP_OK; ++element_idx) {
+        if (sorted) {
+            err = parse_next_member(json, element_idx == 0, element_ctx, writer.ImplicitProfileId);
+            if (err == ESP_OK) {
+                err = encode_json_value(json, writer, element_ctx, depth + 1);
+            }
+        } else {
+            const char *value = element_array[element_idx].json_text;
+            err = encode_json_value(value, writer, element_array[element_idx], depth + 1);
+        }
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to encode");
+        // Ignore the return value of EndContainer()
+        (void)writer.EndContainer(container_type);
+        return err;
+    }
+    ESP_RETURN_ON_ERROR(encode_result(writer.EndContainer(container_type)), TAG, "Failed to end container");
+    json = object_end;
+    return ESP_OK;
+}
+
+static esp_err_t encode_json_array(const char *&json, TLV::TLVWriter &writer, const element_context &element_ctx,
+                                   uint8_t depth)
+{
+    ESP_RETURN_ON_FALSE(*json == '[', ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+    ESP_RETURN_ON_FALSE(depth < k_max_nesting_depth, ESP_ERR_INVALID_ARG, TAG, "Too deeply nested json");
+    json++;
+    skip_whitespace(json);
+    if (element_ctx.sub_type == TLV::TLVElementType::NotSpecified) {
+        ESP_RETURN_ON_FALSE(*json == ']', ESP_ERR_INVALID_ARG, TAG, "Invalid array size");
+    }
+    TLV::TLVType container_type;
+    esp_err_t err = ESP_OK;
+    ESP_RETURN_ON_ERROR(encode_result(writer.StartContainer(element_ctx.tag, TLV::kTLVType_Array, container_type)),
+                        TAG, "Failed to start container");
+    element_context nested_element_ctx;
+    nested_element_ctx.tag = TLV::AnonymousTag();
+    nested_element_ctx.type = element_ctx.sub_type;
+    for (bool first = true; *json != ']'; first = false) {
+        if (!first) {
+            if (*json != ',') {
+                err = ESP_ERR_INVALID_ARG;
+                break;
+            }
+            json++;
+            skip_whitespace(json);
+        }
+        if ((err = encode_json_value(json, writer, nested_element_ctx, depth + 1)) != ESP_OK) {
+            break;
+        }
+        skip_whitespace(json);
     }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to encode");
+        ReturnValueOnFailure(writer.EndContainer(container_type), ESP_FAIL);
+        return err;
+    }
+    json++;
+    ESP_RETURN_ON_ERROR(encode_result(writer.EndContainer(container_type)), TAG, "Failed to end container");
     return ESP_OK;
 }
 
+static esp_err_t encode_json_scalar(const char *&json, TLV::TLVWriter &writer, const element_context &element_ctx)
+{
+    json_scalar scalar;
+    Platform::ScopedMemoryBuffer<char> unescaped;
+    ESP_RETURN_ON_ERROR(parse_json_scalar(json, scalar, unescaped), TAG, "Failed to parse json value");
+    return encode_tlv_scalar(scalar, writer, element_ctx.tag, element_ctx.type);
+}
+
+static esp_err_t encode_json_value(const char *&json, TLV::TLVWriter &writer, const element_context &element_ctx,
+                                   uint8_t depth)
+{
+    switch (element_ctx.type) {
+    case TLVElementType::Array:
+        return encode_json_array(json, writer, element_ctx, depth);
+    case TLVElementType::Structure:
+        return encode_json_object(json, writer, element_ctx.tag, depth);
+    default:
+        return encode_json_scalar(json, writer, element_ctx);
+    }
+}
+
 esp_err_t json_to_tlv(const char *json_str, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag)
 {
-    cJSON *json = cJSON_Parse(json_str);
-    esp_err_t err =  json_to_tlv(json, writer, tag);
-    cJSON_Delete(json);
+    if (!json_str) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const char *json = json_str;
+    skip_whitespace(json);
+    if (*json != '{') {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = encode_json_object(json, writer, tag, 0);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to encode tlv element");
+    }
     return err;
 }
 
@@ -21,12 +21,16 @@
 namespace esp_matter {
 
 /** Convert a JSON object to the given TLVWriter
+ *
+ * The JSON string is encoded while it is parsed, without building a cJSON tree. Objects and arrays can be nested
+ * up to 16 levels. On failure, the writer may hold a partially encoded structure.
  *
  * @param[in]   json_str The JSON string that represents a TLV structure
  * @param[out]  writer   The TLV output from the JSON object
  * @param[in]   tag      The TLV tag of the TLV structure
  *
  * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_SIZE if the writer has no room left for the TLV structure
  * @return error in case of failure
  */
 esp_err_t json_to_tlv(const char *json_str, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag);
@@ -38,6 +42,7 @@ esp_err_t json_to_tlv(const char *json_str, chip::TLV::TLVWriter &writer, chip::
  * @param[in]   tag      The TLV tag of the TLV structure
  *
  * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_SIZE if the writer has no room left for the TLV structure
  * @return error in case of failure
  */
 esp_err_t json_to_tlv(cJSON *json, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag);
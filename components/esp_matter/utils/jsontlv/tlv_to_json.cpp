@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cJSON.h>
+#include <cfloat>
+#include <climits>
 #include <cmath>
 #include <element_types.h>
 #include <esp_check.h>
@@ -460,4 +463,358 @@ esp_err_t tlv_to_json(TLV::TLVReader &reader, cJSON **json, const tlv_to_json_op
     return ESP_OK;
 }
 
+/* JSON text renderer
+ *
+ * The functions below write the JSON text that cJSON_PrintUnformatted() prints for the tree built by tlv_to_json(),
+ * straight from the TLV reader, so that responses and reports can be logged or forwarded without a cJSON tree.
+ */
+
+namespace {
+
+constexpr size_t k_json_chunk_size = 128;
+// A multiple of 3 bytes, so that the Base64 encoding of a byte string can be written block by block
+constexpr size_t k_base64_block_size = 48;
+
+class json_text_writer {
+public:
+    json_text_writer(char *buf, size_t buf_size) : m_buf(buf), m_capacity(buf_size - 1) {}
+
+    json_text_writer(tlv_json_sink_t sink, void *ctx)
+        : m_buf(m_chunk), m_capacity(sizeof(m_chunk)), m_sink(sink), m_ctx(ctx) {}
+
+    // The first error is kept and the following writes are ignored
+    esp_err_t status() const { return m_err; }
+
+    void put(const char *data, size_t len)
+    {
+        while (len > 0 && m_err == ESP_OK) {
+            if (m_len == m_capacity) {
+                flush();
+                continue;
+            }
+            size_t count = std::min(len, m_capacity - m_len);
+            memcpy(m_buf + m_len, data, count);
+            m_len += count;
+            data += count;
+            len -= count;
+        }
+    }
+
+    void put(const char *str) { put(str, strlen(str)); }
+
+    void put(char c) { put(&c, 1); }
+
+    // Quoted and escaped like cJSON does
+    void put_string(const char *str, size_t len)
+    {
+        put('"');
+        size_t run_start = 0;
+        for (size_t i = 0; i < len; ++i) {
+            unsigned char c = static_cast<unsigned char>(str[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            put(str + run_start, i - run_start);
+            run_start = i + 1;
+            put_escaped(c);
+        }
+        put(str + run_start, len - run_start);
+        put('"');
+    }
+
+    void put_number(double value)
+    {
+        // Same as print_number() of cJSON for a number created with cJSON_CreateNumber()
+        char number[26] = { 0 };
+        if (std::isnan(value) || std::isinf(value)) {
+            put("null");
+            return;
+        }
+        if (value >= INT_MIN && value <= INT_MAX && value == static_cast<double>(static_cast<int>(value))) {
+            snprintf(number, sizeof(number), "%d", static_cast<int>(value));
+        } else {
+            snprintf(number, sizeof(number), "%1.15g", value);
+            double parsed = strtod(number, nullptr);
+            double max_value = std::max(std::fabs(parsed), std::fabs(value));
+            if (!(std::fabs(parsed - value) <= max_value * DBL_EPSILON)) {
+                snprintf(number, sizeof(number), "%1.17g", value);
+            }
+        }
+        put(number);
+    }
+
+    esp_err_t finish(size_t *len)
+    {
+        if (m_sink) {
+            if (m_len > 0) {
+                flush();
+            }
+        } else {
+            m_buf[m_len] = '\0';
+        }
+        if (len) {
+            *len = m_flushed_len + m_len;
+        }
+        return m_err;
+    }
+
+private:
+    void put_escaped(unsigned char c)
+    {
+        switch (c) {
+        case '"':
+            put("\\\"", 2);
+            break;
+        case '\\':
+            put("\\\\", 2);
+            break;
+        case '\b':
+            put("\\b", 2);
+            break;
+        case '\f':
+            put("\\f", 2);
+            break;
+        case '\n':
+            put("\\n", 2);
+            break;
+        case '\r':
+            put("\\r", 2);
+            break;
+        case '\t':
+            put("\\t", 2);
+            break;
+        default: {
+            char escaped[7] = { 0 };
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            put(escaped, 6);
+            break;
+        }
+        }
+    }
+
+    void flush()
+    {
+        if (!m_sink) {
+            m_err = ESP_ERR_INVALID_SIZE;
+            return;
+        }
+        m_err = m_sink(m_buf, m_len, m_ctx);
+        m_flushed_len += m_len;
+        m_len = 0;
+    }
+
+    char m_chunk[k_json_chunk_size];
+    char *m_buf;
+    size_t m_capacity;
+    size_t m_len = 0;
+    size_t m_flushed_len = 0;
+    tlv_json_sink_t m_sink = nullptr;
+    void *m_ctx = nullptr;
+    esp_err_t m_err = ESP_OK;
+};
+
+} // namespace
+
+static esp_err_t render_byte_string(TLV::TLVReader &reader, json_text_writer &writer,
+                                    const tlv_to_json_options &options)
+{
+    ByteSpan value;
+    ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read byte string");
+
+    if (options.human_readable_bytes && is_human_readable_utf8(value)) {
+        writer.put_string(reinterpret_cast<const char *>(value.data()), value.size());
+        return ESP_OK;
+    }
+
+    char encoded[BASE64_ENCODED_LEN(k_base64_block_size) + 1] = { 0 };
+    writer.put('"');
+    for (size_t offset = 0; offset < value.size(); offset += k_base64_block_size) {
+        size_t block_size = std::min(k_base64_block_size, value.size() - offset);
+        uint16_t encoded_len = Base64Encode(value.data() + offset, static_cast<uint16_t>(block_size), encoded);
+        writer.put(encoded, encoded_len);
+    }
+    writer.put('"');
+    return ESP_OK;
+}
+
+static esp_err_t render_tlv_node(TLV::TLVReader &reader, json_text_writer &writer, const tlv_to_json_options &options);
+
+static esp_err_t render_json_name(const TLV::TLVReader &reader, json_text_writer &writer,
+                                  const tlv_to_json_options &options)
+{
+    TLVElementType type = get_tlv_element_type(reader);
+    TLVElementType sub_type = TLVElementType::NotSpecified;
+    if (options.tag_format == tlv_json_tag_format::type_qualified && type == TLVElementType::Array) {
+        // The key is written before the array, so the type of its first element is read ahead
+        TLV::TLVReader array_reader;
+        array_reader.Init(reader);
+        TLV::TLVType container_type;
+        if (array_reader.EnterContainer(container_type) == CHIP_NO_ERROR && array_reader.Next() == CHIP_NO_ERROR) {
+            sub_type = get_tlv_element_type(array_reader);
+        }
+    }
+
+    char json_name[64] = { 0 };
+    ESP_RETURN_ON_ERROR(create_json_name(reader.GetTag(), type, sub_type, json_name, sizeof(json_name), options), TAG,
+                        "Failed to create json name");
+    writer.put_string(json_name, strlen(json_name));
+    writer.put(':');
+    return ESP_OK;
+}
+
+static esp_err_t render_tlv_container(TLV::TLVReader &reader, json_text_writer &writer, bool is_object,
+                                      const tlv_to_json_options &options)
+{
+    esp_err_t ret = ESP_OK;
+    TLV::TLVType container_type;
+    CHIP_ERROR err = reader.EnterContainer(container_type);
+    ESP_RETURN_ON_FALSE(err == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to enter container: %" CHIP_ERROR_FORMAT,
+                        err.Format());
+
+    writer.put(is_object ? '{' : '[');
+    bool first = true;
+    while (writer.status() == ESP_OK && (err = reader.Next()) == CHIP_NO_ERROR) {
+        if (!first) {
+            writer.put(',');
+        }
+        first = false;
+        if (is_object) {
+            ESP_GOTO_ON_ERROR(render_json_name(reader, writer, options), exit, TAG, "Failed to render json name");
+        }
+        ESP_GOTO_ON_ERROR(render_tlv_node(reader, writer, options), exit, TAG, "Failed to render tlv node");
+    }
+    ESP_GOTO_ON_FALSE(writer.status() != ESP_OK || err == CHIP_END_OF_TLV, ESP_FAIL, exit, TAG,
+                      "Failed to iterate container: %" CHIP_ERROR_FORMAT, err.Format());
+    writer.put(is_object ? '}' : ']');
+
+exit:
+    err = reader.ExitContainer(container_type);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to exit container: %" CHIP_ERROR_FORMAT, err.Format());
+        ret = ret == ESP_OK ? ESP_FAIL : ret;
+    }
+    return ret;
+}
+
+static esp_err_t render_tlv_node(TLV::TLVReader &reader, json_text_writer &writer, const tlv_to_json_options &options)
+{
+    switch (get_tlv_element_type(reader)) {
+    case TLVElementType::Int8:
+    case TLVElementType::Int16:
+    case TLVElementType::Int32: {
+        int32_t value = 0;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read int");
+        writer.put_number(value);
+        return ESP_OK;
+    }
+    case TLVElementType::Int64: {
+        int64_t value = 0;
+        char value_str[32] = { 0 };
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read int64");
+        size_t len = snprintf(value_str, sizeof(value_str), "%" PRId64, value);
+        writer.put_string(value_str, len);
+        return ESP_OK;
+    }
+    case TLVElementType::UInt8:
+    case TLVElementType::UInt16:
+    case TLVElementType::UInt32: {
+        uint32_t value = 0;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read uint");
+        writer.put_number(value);
+        return ESP_OK;
+    }
+    case TLVElementType::UInt64: {
+        uint64_t value = 0;
+        char value_str[32] = { 0 };
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read uint64");
+        size_t len = snprintf(value_str, sizeof(value_str), "%" PRIu64, value);
+        writer.put_string(value_str, len);
+        return ESP_OK;
+    }
+    case TLVElementType::BooleanFalse:
+    case TLVElementType::BooleanTrue: {
+        bool value = false;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read bool");
+        writer.put(value ? "true" : "false");
+        return ESP_OK;
+    }
+    case TLVElementType::FloatingPointNumber32:
+    case TLVElementType::FloatingPointNumber64: {
+        // A float is read as the double it is converted to by tlv_to_json()
+        double value = 0;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read floating point");
+        if (std::isinf(value)) {
+            writer.put_string(value > 0 ? element_type::k_floating_point_positive_infinity
+                              : element_type::k_floating_point_negative_infinity,
+                              value > 0 ? sizeof(element_type::k_floating_point_positive_infinity) - 1
+                              : sizeof(element_type::k_floating_point_negative_infinity) - 1);
+        } else {
+            writer.put_number(value);
+        }
+        return ESP_OK;
+    }
+    case TLVElementType::UTF8String_1ByteLength:
+    case TLVElementType::UTF8String_2ByteLength:
+    case TLVElementType::UTF8String_4ByteLength:
+    case TLVElementType::UTF8String_8ByteLength: {
+        CharSpan value;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to read utf8 string");
+        writer.put_string(value.data(), value.size());
+        return ESP_OK;
+    }
+    case TLVElementType::ByteString_1ByteLength:
+    case TLVElementType::ByteString_2ByteLength:
+    case TLVElementType::ByteString_4ByteLength:
+    case TLVElementType::ByteString_8ByteLength:
+        return render_byte_string(reader, writer, options);
+    case TLVElementType::Null:
+        writer.put("null");
+        return ESP_OK;
+    case TLVElementType::Structure:
+        return render_tlv_container(reader, writer, true, options);
+    case TLVElementType::Array:
+    case TLVElementType::List:
+        return render_tlv_container(reader, writer, false, options);
+    default:
+        ESP_LOGE(TAG, "Unsupported tlv element type: %d", static_cast<int>(get_tlv_element_type(reader)));
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+}
+
+static esp_err_t render_tlv(TLV::TLVReader &reader, json_text_writer &writer, size_t *len,
+                            const tlv_to_json_options &options)
+{
+    TLV::TLVReader reader_copy;
+    reader_copy.Init(reader);
+
+    if (reader_copy.GetType() == TLV::kTLVType_NotSpecified) {
+        CHIP_ERROR chip_err = reader_copy.Next();
+        if (chip_err != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to move tlv reader: %" CHIP_ERROR_FORMAT, chip_err.Format());
+            writer.finish(len);
+            return ESP_FAIL;
+        }
+    }
+
+    esp_err_t err = render_tlv_node(reader_copy, writer, options);
+    esp_err_t finish_err = writer.finish(len);
+    return err != ESP_OK ? err : finish_err;
+}
+
+esp_err_t tlv_to_json_string(TLV::TLVReader &reader, char *buf, size_t buf_size, size_t *len,
+                             const tlv_to_json_options &options)
+{
+    ESP_RETURN_ON_FALSE(buf && buf_size > 0, ESP_ERR_INVALID_ARG, TAG, "buf cannot be NULL or empty");
+    json_text_writer writer(buf, buf_size);
+    return render_tlv(reader, writer, len, options);
+}
+
+esp_err_t tlv_to_json_stream(TLV::TLVReader &reader, tlv_json_sink_t sink, void *ctx,
+                             const tlv_to_json_options &options)
+{
+    ESP_RETURN_ON_FALSE(sink, ESP_ERR_INVALID_ARG, TAG, "sink cannot be NULL");
+    json_text_writer writer(sink, ctx);
+    return render_tlv(reader, writer, nullptr, options);
+}
+
 } // namespace esp_matter
@@ -55,4 +55,49 @@ esp_err_t tlv_to_json(chip::TLV::TLVReader &reader, cJSON **json);
  */
 esp_err_t tlv_to_json(chip::TLV::TLVReader &reader, cJSON **json, const tlv_to_json_options &options);
 
+/** Sink receiving the JSON text rendered by tlv_to_json_stream().
+ *
+ * @param[in] data Chunk of JSON text, not NULL-terminated.
+ * @param[in] len  Length of the chunk.
+ * @param[in] ctx  Context given to tlv_to_json_stream().
+ *
+ * @return ESP_OK to continue, any other error stops the conversion and is returned by tlv_to_json_stream().
+ */
+typedef esp_err_t (*tlv_json_sink_t)(const char *data, size_t len, void *ctx);
+
+/** Convert TLV data model payload to JSON text in a buffer.
+ *
+ * The text is the same as cJSON_PrintUnformatted() of the tlv_to_json() output, but it is written directly from the
+ * TLV without building a cJSON tree.
+ *
+ * @param[in]   reader   The TLV reader positioned at the payload.
+ * @param[out]  buf      The buffer for the NULL-terminated JSON text.
+ * @param[in]   buf_size The size of buf.
+ * @param[out]  len      (Optional) The length of the JSON text.
+ * @param[in]   options  Options controlling non-canonical display behavior.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_SIZE if the JSON text does not fit in buf, buf then holds the truncated text.
+ * @return error in case of failure.
+ */
+esp_err_t tlv_to_json_string(chip::TLV::TLVReader &reader, char *buf, size_t buf_size, size_t *len,
+                             const tlv_to_json_options &options);
+
+/** Convert TLV data model payload to JSON text passed to a sink in chunks.
+ *
+ * The text is the same as tlv_to_json_string() renders. It is passed to the sink in chunks of up to 128 bytes, so
+ * payloads of any size are converted with a small and fixed amount of stack and no heap. The chunks given to the sink
+ * before a failure are not taken back.
+ *
+ * @param[in]   reader  The TLV reader positioned at the payload.
+ * @param[in]   sink    The sink receiving the chunks of JSON text.
+ * @param[in]   ctx     (Optional) Context passed to the sink.
+ * @param[in]   options Options controlling non-canonical display behavior.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t tlv_to_json_stream(chip::TLV::TLVReader &reader, tlv_json_sink_t sink, void *ctx,
+                             const tlv_to_json_options &options);
+
 } // namespace esp_matter
@@ -33,37 +33,105 @@ namespace esp_matter_bridge {
 
 static uint16_t bridged_endpoint_id_array[MAX_BRIDGED_DEVICE_COUNT];
 
-/** Persistent Bridged Device Info **/
-static esp_err_t store_device_persistent_info(device_persistent_info_t *persistent_info)
+// A set bit marks a free slot in bridged_endpoint_id_array
+static uint32_t free_slot_bitmap[(MAX_BRIDGED_DEVICE_COUNT + 31) / 32];
+
+static void rebuild_free_slot_bitmap()
 {
-    esp_err_t err = ESP_OK;
-    if (!persistent_info) {
-        ESP_LOGE(TAG, "persistent_info cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    memset(free_slot_bitmap, 0, sizeof(free_slot_bitmap));
+    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
+        if (bridged_endpoint_id_array[idx] == chip::kInvalidEndpointId) {
+            free_slot_bitmap[idx / 32] |= 1UL << (idx % 32);
+        }
     }
+}
 
-    nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE, NVS_READWRITE,
-                                  &handle);
+static size_t get_free_slot_count()
+{
+    size_t count = 0;
+    for (size_t word = 0; word < sizeof(free_slot_bitmap) / sizeof(free_slot_bitmap[0]); ++word) {
+        count += __builtin_popcount(free_slot_bitmap[word]);
+    }
+    return count;
+}
+
+static bool alloc_slot(uint16_t endpoint_id)
+{
+    for (size_t word = 0; word < sizeof(free_slot_bitmap) / sizeof(free_slot_bitmap[0]); ++word) {
+        if (free_slot_bitmap[word]) {
+            size_t bit = __builtin_ctz(free_slot_bitmap[word]);
+            free_slot_bitmap[word] &= ~(1UL << bit);
+            bridged_endpoint_id_array[word * 32 + bit] = endpoint_id;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void release_slot(size_t idx)
+{
+    bridged_endpoint_id_array[idx] = chip::kInvalidEndpointId;
+    free_slot_bitmap[idx / 32] |= 1UL << (idx % 32);
+}
+
+static void release_slots_of(uint16_t endpoint_id)
+{
+    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
+        if (bridged_endpoint_id_array[idx] == endpoint_id) {
+            release_slot(idx);
+        }
+    }
+}
+
+static esp_err_t open_bridge_namespace(nvs_open_mode_t open_mode, nvs_handle_t *handle)
+{
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE,
+                                            open_mode, handle);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
                  ESP_MATTER_BRIDGE_NAMESPACE, err);
-        return err;
     }
+    return err;
+}
+
+// Commit the changes made with the handle if all of them succeeded, then close it
+static esp_err_t commit_and_close(nvs_handle_t handle, esp_err_t err)
+{
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed on nvs_commit of the bridge namespace");
+        }
+    }
+    nvs_close(handle);
+    return err;
+}
+
+/** Persistent Bridged Device Info **/
+static esp_err_t set_device_persistent_info(nvs_handle_t handle, const device_persistent_info_t *persistent_info)
+{
     uint16_t endpoint_id = persistent_info->device_endpoint_id;
-    err = nvs_set_blob(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
-                       persistent_info, sizeof(device_persistent_info_t));
+    esp_err_t err = nvs_set_blob(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
+                                 persistent_info, sizeof(device_persistent_info_t));
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed on nvs_set_blob when storing device_persistent_info");
-        nvs_close(handle);
-        return err;
     }
-    err = nvs_commit(handle);
+    return err;
+}
+
+static esp_err_t store_device_persistent_info(device_persistent_info_t *persistent_info)
+{
+    if (!persistent_info) {
+        ESP_LOGE(TAG, "persistent_info cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t err = open_bridge_namespace(NVS_READWRITE, &handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed on nvs_commit when storing device_persistent_info");
+        return err;
     }
-    nvs_close(handle);
-    return err;
+    return commit_and_close(handle, set_device_persistent_info(handle, persistent_info));
 }
 
 static esp_err_t nvs_get_device_persistent_info(const char *nvs_namespace, const char *nvs_key,
@@ -82,16 +150,19 @@ static esp_err_t nvs_get_device_persistent_info(const char *nvs_namespace, const
     nvs_close(handle);
     return err;
 }
-static esp_err_t read_device_persistent_info(device_persistent_info_t *persistent_info, uint16_t endpoint_id)
+
+// The handle is opened on the bridge namespace, which lets the bulk resume read all the devices with one handle
+static esp_err_t read_device_persistent_info(nvs_handle_t handle, device_persistent_info_t *persistent_info,
+                                             uint16_t endpoint_id)
 {
     if (!persistent_info) {
         ESP_LOGE(TAG, "persistent_info cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
 
-    esp_err_t err = nvs_get_device_persistent_info(ESP_MATTER_BRIDGE_NAMESPACE,
-                                                   nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
-                                                   persistent_info);
+    size_t len = sizeof(device_persistent_info_t);
+    esp_err_t err = nvs_get_blob(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
+                                 persistent_info, &len);
     if (err == ESP_ERR_NVS_NOT_FOUND) {
         // If we don't find persistent_info key in the bridge namespace, we will try to get the persistent_info
         // with the previous key from the previous namespace.
@@ -99,19 +170,19 @@ static esp_err_t read_device_persistent_info(device_persistent_info_t *persisten
         snprintf(nvs_namespace, 16, "bridge_ep_%X", endpoint_id);
         err = nvs_get_device_persistent_info(nvs_namespace, "persistent_info", persistent_info);
         if (err == ESP_OK) {
-            nvs_handle_t handle;
+            nvs_handle_t legacy_handle;
             // If we get the persistent_info with the previous key, we will erase it and store it in current namespace
             // with the new persistent_info key.
             if (nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, nvs_namespace, NVS_READWRITE,
-                                        &handle) != ESP_OK) {
+                                        &legacy_handle) != ESP_OK) {
                 ESP_LOGE(TAG, "Failed to open %s namespace", nvs_namespace);
             } else {
-                if (nvs_erase_key(handle, "persistent_info") != ESP_OK) {
+                if (nvs_erase_key(legacy_handle, "persistent_info") != ESP_OK) {
                     ESP_LOGE(TAG, "Failed to erase persistent_info");
                 } else {
-                    nvs_commit(handle);
+                    nvs_commit(legacy_handle);
                 }
-                nvs_close(handle);
+                nvs_close(legacy_handle);
             }
             store_device_persistent_info(persistent_info);
         }
@@ -119,28 +190,24 @@ static esp_err_t read_device_persistent_info(device_persistent_info_t *persisten
     return err;
 }
 
-static esp_err_t store_bridged_endpoint_ids()
+static esp_err_t set_bridged_endpoint_ids(nvs_handle_t handle)
 {
-    esp_err_t err = ESP_OK;
-    nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE, NVS_READWRITE,
-                                  &handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
-                 ESP_MATTER_BRIDGE_NAMESPACE, err);
-        return err;
-    }
-    err = nvs_set_blob(handle, nvs_key_allocator::endpoint_ids_array().KeyName(), bridged_endpoint_id_array,
-                       sizeof(bridged_endpoint_id_array));
+    esp_err_t err = nvs_set_blob(handle, nvs_key_allocator::endpoint_ids_array().KeyName(), bridged_endpoint_id_array,
+                                 sizeof(bridged_endpoint_id_array));
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed on nvs_set_blob when storing bridged_endpoint_ids");
     }
-    err = nvs_commit(handle);
+    return err;
+}
+
+static esp_err_t store_bridged_endpoint_ids()
+{
+    nvs_handle_t handle;
+    esp_err_t err = open_bridge_namespace(NVS_READWRITE, &handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed on nvs_commit when storing bridged_endpoint_ids");
+        return err;
     }
-    nvs_close(handle);
-    return err;
+    return commit_and_close(handle, set_bridged_endpoint_ids(handle));
 }
 
 static esp_err_t nvs_get_bridged_endpoint_ids(const char *nvs_namespace, const char *nvs_key)
@@ -201,30 +268,22 @@ esp_err_t get_bridged_endpoint_ids(uint16_t *matter_endpoint_id_array)
 esp_err_t erase_bridged_device_info(uint16_t endpoint_id)
 {
     // Remove endpoint id from the endpoint id array
-    esp_err_t err = ESP_OK;
-    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
-        if (bridged_endpoint_id_array[idx] == endpoint_id) {
-            bridged_endpoint_id_array[idx] = chip::kInvalidEndpointId;
-        }
-    }
-    err = store_bridged_endpoint_ids();
+    release_slots_of(endpoint_id);
+    nvs_handle_t handle;
+    esp_err_t err = open_bridge_namespace(NVS_READWRITE, &handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "failed to store the endpoint_id array");
         return err;
     }
-    // Clear the persistent information of the removed endpoint
-    nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE, NVS_READWRITE,
-                                  &handle);
+    err = set_bridged_endpoint_ids(handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
-                 ESP_MATTER_BRIDGE_NAMESPACE, err);
+        ESP_LOGE(TAG, "failed to store the endpoint_id array");
+        nvs_close(handle);
         return err;
     }
-    err = nvs_erase_key(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName());
-    nvs_commit(handle);
-    nvs_close(handle);
-    return err;
+    // Clear the persistent information of the removed endpoint, both changes are committed together
+    esp_err_t erase_err = nvs_erase_key(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName());
+    err = commit_and_close(handle, ESP_OK);
+    return err != ESP_OK ? err : erase_err;
 }
 
 static esp_err_t plugin_init_callback_endpoint(endpoint_t *endpoint)
@@ -292,7 +351,41 @@ static bool parent_endpoint_is_valid(node_t *node, uint16_t parent_endpoint_id)
     return false;
 }
 
-device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t device_type_id, void *priv_data)
+// Destroy a device which is not in the persistent registry
+static void destroy_device(device_t *bridged_device)
+{
+    if (endpoint::destroy(bridged_device->node, bridged_device->endpoint) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to delete bridged endpoint");
+    }
+    esp_matter_mem_free(bridged_device);
+}
+
+// nvs_set_blob() writes are durable before nvs_commit(), so a failed store can leave the persistent information of
+// devices which are then destroyed. Erase it and store the endpoint_id array again, the slots of the devices must
+// have been released.
+static void discard_persistent_info(device_t **devices, size_t count)
+{
+    nvs_handle_t handle;
+    if (open_bridge_namespace(NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    esp_err_t err = ESP_OK;
+    for (size_t idx = 0; idx < count; ++idx) {
+        uint16_t endpoint_id = devices[idx]->persistent_info.device_endpoint_id;
+        esp_err_t erase_err = nvs_erase_key(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName());
+        if (erase_err != ESP_OK && erase_err != ESP_ERR_NVS_NOT_FOUND) {
+            err = erase_err;
+        }
+    }
+    esp_err_t ids_err = set_bridged_endpoint_ids(handle);
+    err = commit_and_close(handle, err != ESP_OK ? err : ids_err);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to discard the persistent info of the bridged devices, err: %d", err);
+    }
+}
+
+static device_t *create_device_endpoint(node_t *node, uint16_t parent_endpoint_id, uint32_t device_type_id,
+                                        void *priv_data)
 {
     // Check whether the parent endpoint is valid
     if (!parent_endpoint_is_valid(node, parent_endpoint_id)) {
@@ -319,57 +412,114 @@ device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t devi
     }
     if (set_device_type(dev, device_type_id, priv_data) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to add the device type for the bridged device");
-        remove_device(dev);
+        destroy_device(dev);
         return NULL;
     }
     endpoint_t *parent_endpoint = endpoint::get(node, parent_endpoint_id);
     if (set_parent_endpoint(dev->endpoint, parent_endpoint) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to set parent endpoint for the bridged device");
-        remove_device(dev);
+        destroy_device(dev);
         return NULL;
     }
-
-    // Store the persistent information
     dev->persistent_info.device_endpoint_id = esp_matter::endpoint::get_id(dev->endpoint);
     dev->persistent_info.device_type_id = device_type_id;
-    if (store_device_persistent_info(&dev->persistent_info) != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to store the persistent info for the bridged device");
-        remove_device(dev);
+    return dev;
+}
+
+device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t device_type_id, void *priv_data)
+{
+    device_t *dev = create_device_endpoint(node, parent_endpoint_id, device_type_id, priv_data);
+    if (!dev) {
         return NULL;
     }
 
     // Store the endpoint_id in endpoint_id_array
-    size_t idx;
-    for (idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
-        if (bridged_endpoint_id_array[idx] == chip::kInvalidEndpointId) {
-            bridged_endpoint_id_array[idx] = dev->persistent_info.device_endpoint_id;
-            break;
-        }
-    }
-    if (idx == MAX_BRIDGED_DEVICE_COUNT) {
+    if (!alloc_slot(dev->persistent_info.device_endpoint_id)) {
         ESP_LOGE(TAG, "Endpoints are used up");
-        remove_device(dev);
+        destroy_device(dev);
         return NULL;
     }
-    if (store_bridged_endpoint_ids() != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to persist bridged endpoint IDs");
+
+    // Store the persistent information and the endpoint_id array with a single commit
+    nvs_handle_t handle;
+    esp_err_t err = open_bridge_namespace(NVS_READWRITE, &handle);
+    if (err == ESP_OK) {
+        err = set_device_persistent_info(handle, &dev->persistent_info);
+        if (err == ESP_OK) {
+            err = set_bridged_endpoint_ids(handle);
+        }
+        err = commit_and_close(handle, err);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the persistent info for the bridged device");
+        release_slots_of(dev->persistent_info.device_endpoint_id);
+        discard_persistent_info(&dev, 1);
+        destroy_device(dev);
+        return NULL;
     }
     return dev;
 }
 
-device_t *resume_device(node_t *node, uint16_t device_endpoint_id, void *priv_data)
+esp_err_t create_devices(node_t *node, const device_config_t *configs, size_t count, device_t **devices)
 {
+    if (!node || !configs || !devices || count == 0) {
+        ESP_LOGE(TAG, "node, configs and devices cannot be NULL and count cannot be 0");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (count > get_free_slot_count()) {
+        ESP_LOGE(TAG, "Endpoints are used up, %u free for %u devices", (unsigned)get_free_slot_count(),
+                 (unsigned)count);
+        return ESP_ERR_NO_MEM;
+    }
+
     esp_err_t err = ESP_OK;
-    device_persistent_info_t persistent_info;
-    err = read_device_persistent_info(&persistent_info, device_endpoint_id);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to read the persistent info for the resumed device");
-        return NULL;
+    size_t created = 0;
+    for (; created < count; ++created) {
+        devices[created] = create_device_endpoint(node, configs[created].parent_endpoint_id,
+                                                  configs[created].device_type_id, configs[created].priv_data);
+        if (!devices[created]) {
+            err = ESP_FAIL;
+            break;
+        }
+        alloc_slot(devices[created]->persistent_info.device_endpoint_id);
     }
-    if (!parent_endpoint_is_valid(node, persistent_info.parent_endpoint_id)) {
-        ESP_LOGE(TAG, "Parent endpoint is invalid");
-        return NULL;
+
+    // Store the persistent information of all the devices and the endpoint_id array with a single commit
+    bool stored = false;
+    if (err == ESP_OK) {
+        nvs_handle_t handle;
+        err = open_bridge_namespace(NVS_READWRITE, &handle);
+        if (err == ESP_OK) {
+            stored = true;
+            for (size_t idx = 0; idx < count && err == ESP_OK; ++idx) {
+                err = set_device_persistent_info(handle, &devices[idx]->persistent_info);
+            }
+            if (err == ESP_OK) {
+                err = set_bridged_endpoint_ids(handle);
+            }
+            err = commit_and_close(handle, err);
+        }
     }
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create the bridged devices");
+        for (size_t idx = 0; idx < created; ++idx) {
+            release_slots_of(devices[idx]->persistent_info.device_endpoint_id);
+        }
+        if (stored) {
+            discard_persistent_info(devices, created);
+        }
+        for (size_t idx = 0; idx < created; ++idx) {
+            destroy_device(devices[idx]);
+            devices[idx] = NULL;
+        }
+    }
+    return err;
+}
+
+static device_t *resume_device_endpoint(node_t *node, const device_persistent_info_t &persistent_info,
+                                        uint16_t device_endpoint_id, void *priv_data)
+{
     device_t *dev = (device_t *)esp_matter_mem_calloc(1, sizeof(device_t));
     if (!dev) {
         ESP_LOGE(TAG, "Failed to allocate memory for bridged device");
@@ -384,23 +534,103 @@ device_t *resume_device(node_t *node, uint16_t device_endpoint_id, void *priv_da
     if (!(dev->endpoint)) {
         ESP_LOGE(TAG, "Could not resume esp_matter endpoint for bridged device");
         esp_matter_mem_free(dev);
-        erase_bridged_device_info(device_endpoint_id);
         return NULL;
     }
     if (set_device_type(dev, persistent_info.device_type_id, priv_data) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to add the device type for the bridged device");
-        remove_device(dev);
+        destroy_device(dev);
         return NULL;
     }
     endpoint_t *parent_endpoint = endpoint::get(node, persistent_info.parent_endpoint_id);
     if (set_parent_endpoint(dev->endpoint, parent_endpoint) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to set parent endpoint for the bridged device");
-        remove_device(dev);
+        destroy_device(dev);
         return NULL;
     }
     return dev;
 }
 
+device_t *resume_device(node_t *node, uint16_t device_endpoint_id, void *priv_data)
+{
+    nvs_handle_t handle;
+    esp_err_t err = open_bridge_namespace(NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        return NULL;
+    }
+    device_persistent_info_t persistent_info;
+    err = read_device_persistent_info(handle, &persistent_info, device_endpoint_id);
+    nvs_close(handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read the persistent info for the resumed device");
+        return NULL;
+    }
+    if (!parent_endpoint_is_valid(node, persistent_info.parent_endpoint_id)) {
+        ESP_LOGE(TAG, "Parent endpoint is invalid");
+        return NULL;
+    }
+    device_t *dev = resume_device_endpoint(node, persistent_info, device_endpoint_id, priv_data);
+    if (!dev) {
+        erase_bridged_device_info(device_endpoint_id);
+    }
+    return dev;
+}
+
+esp_err_t resume_all_devices(node_t *node, resume_priv_data_callback_t priv_data_cb, void *context,
+                             device_t **devices, size_t *count)
+{
+    if (!node || !devices || !count) {
+        ESP_LOGE(TAG, "node, devices and count cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    *count = 0;
+
+    nvs_handle_t handle;
+    esp_err_t err = open_bridge_namespace(NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // The devices which fail to resume are removed from the registry with a single commit at the end
+    uint16_t failed_endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    size_t failed_count = 0;
+    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
+        uint16_t endpoint_id = bridged_endpoint_id_array[idx];
+        if (endpoint_id == chip::kInvalidEndpointId) {
+            continue;
+        }
+        device_persistent_info_t persistent_info;
+        if (read_device_persistent_info(handle, &persistent_info, endpoint_id) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to read the persistent info of the bridged device on endpoint %u", endpoint_id);
+            continue;
+        }
+        if (!parent_endpoint_is_valid(node, persistent_info.parent_endpoint_id)) {
+            ESP_LOGE(TAG, "Parent endpoint of the bridged device on endpoint %u is invalid", endpoint_id);
+            continue;
+        }
+        void *priv_data = priv_data_cb ? priv_data_cb(endpoint_id, context) : NULL;
+        device_t *dev = resume_device_endpoint(node, persistent_info, endpoint_id, priv_data);
+        if (!dev) {
+            release_slot(idx);
+            failed_endpoint_ids[failed_count++] = endpoint_id;
+            continue;
+        }
+        devices[(*count)++] = dev;
+    }
+    nvs_close(handle);
+
+    if (failed_count > 0) {
+        err = open_bridge_namespace(NVS_READWRITE, &handle);
+        if (err != ESP_OK) {
+            return err;
+        }
+        err = set_bridged_endpoint_ids(handle);
+        for (size_t idx = 0; idx < failed_count; ++idx) {
+            nvs_erase_key(handle, nvs_key_allocator::endpoint_pesistent_info(failed_endpoint_ids[idx]).KeyName());
+        }
+        err = commit_and_close(handle, err);
+    }
+    return err;
+}
+
 esp_err_t remove_device(device_t *bridged_device)
 {
     if (!bridged_device) {
@@ -441,6 +671,7 @@ esp_err_t initialize(node_t *node, bridge_device_type_callback_t device_type_cb)
         for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
             bridged_endpoint_id_array[idx] = chip::kInvalidEndpointId;
         }
+        rebuild_free_slot_bitmap();
         if (store_bridged_endpoint_ids() != ESP_OK) {
             ESP_LOGE(TAG, "Failed to store the initialized endpoint id array");
             return err;
@@ -449,6 +680,7 @@ esp_err_t initialize(node_t *node, bridge_device_type_callback_t device_type_cb)
     } else if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to read the bridged endpoint id array");
     }
+    rebuild_free_slot_bitmap();
     return err;
 }
 
@@ -470,6 +702,7 @@ esp_err_t factory_reset()
     for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
         bridged_endpoint_id_array[idx] = chip::kInvalidEndpointId;
     }
+    rebuild_free_slot_bitmap();
     return err;
 }
 
@@ -38,6 +38,15 @@ typedef struct device {
 
 typedef esp_err_t (*bridge_device_type_callback_t)(esp_matter::endpoint_t *ep, uint32_t device_type_id, void *priv_data);
 
+typedef struct device_config {
+    uint16_t parent_endpoint_id;
+    uint32_t device_type_id;
+    void *priv_data;
+} device_config_t;
+
+// Returns the priv_data of the bridged device resumed on device_endpoint_id
+typedef void *(*resume_priv_data_callback_t)(uint16_t device_endpoint_id, void *context);
+
 esp_err_t get_bridged_endpoint_ids(uint16_t *matter_endpoint_id_array);
 
 esp_err_t erase_bridged_device_info(uint16_t matter_endpoint_id);
@@ -47,6 +56,16 @@ device_t *create_device(esp_matter::node_t *node, uint16_t parent_endpoint_id, u
 
 device_t *resume_device(esp_matter::node_t *node, uint16_t device_endpoint_id, void *priv_data);
 
+// Create count bridged devices and persist them with a single NVS commit. Either all the devices are created and
+// stored in devices, or none of them is: on failure the persistent info written for the devices is erased and the
+// previous endpoint_id array is stored again.
+esp_err_t create_devices(esp_matter::node_t *node, const device_config_t *configs, size_t count, device_t **devices);
+
+// Resume all the bridged devices of the registry read in initialize(). devices must have room for
+// MAX_BRIDGED_DEVICE_COUNT entries, the devices which fail to resume are removed from the registry.
+esp_err_t resume_all_devices(esp_matter::node_t *node, resume_priv_data_callback_t priv_data_cb, void *context,
+                             device_t **devices, size_t *count);
+
 esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, void *priv_data);
 
 esp_err_t remove_device(device_t *bridged_device);
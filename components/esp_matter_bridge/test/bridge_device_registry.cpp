@@ -0,0 +1,246 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_bridge.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+#include <esp_matter_mem.h>
+#include <nvs.h>
+#include <nvs_key_allocator.h>
+
+#include "cluster_lifecycle_common.h"
+
+#if MAX_BRIDGED_DEVICE_COUNT > 0
+
+using namespace esp_matter;
+
+static constexpr uint32_t k_device_type_id = 0x0100;
+static constexpr uint8_t k_device_type_version = 3;
+static constexpr uint16_t k_bridge_device_count = 100;
+
+static esp_err_t device_type_callback(endpoint_t *endpoint, uint32_t device_type_id, void *priv_data)
+{
+    return endpoint::add_device_type(endpoint, device_type_id, k_device_type_version);
+}
+
+static uint16_t get_aggregator_endpoint_id(node_t *node)
+{
+    static endpoint_t *aggregator = nullptr;
+    if (!aggregator) {
+        endpoint::aggregator::config_t config;
+        aggregator = endpoint::aggregator::create(node, &config, ENDPOINT_FLAG_NONE, nullptr);
+        TEST_ASSERT_NOT_NULL(aggregator);
+    }
+    return endpoint::get_id(aggregator);
+}
+
+// Like a reboot for the bridge: the endpoints are gone but the registry is kept in the NVS
+static void release_devices(esp_matter_bridge::device_t **devices, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(devices[i]->node, devices[i]->endpoint));
+        esp_matter_mem_free(devices[i]);
+        devices[i] = nullptr;
+    }
+}
+
+static uint16_t get_device_count(node_t *node)
+{
+    uint16_t available = CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT - endpoint::get_count(node);
+    uint16_t count = available < k_bridge_device_count ? available : k_bridge_device_count;
+    return count < MAX_BRIDGED_DEVICE_COUNT ? count : MAX_BRIDGED_DEVICE_COUNT;
+}
+
+static void *get_resume_priv_data(uint16_t device_endpoint_id, void *context)
+{
+    (*(uint16_t *)context)++;
+    return nullptr;
+}
+
+TEST_CASE("bulk created bridged devices are resumed from the registry", "[bridge]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+    uint16_t parent_endpoint_id = get_aggregator_endpoint_id(node);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::factory_reset());
+
+    uint16_t count = get_device_count(node);
+    TEST_ASSERT_GREATER_THAN(1, count);
+    esp_matter_bridge::device_config_t configs[MAX_BRIDGED_DEVICE_COUNT];
+    for (uint16_t i = 0; i < count; ++i) {
+        configs[i] = { parent_endpoint_id, k_device_type_id + i % 2, nullptr };
+    }
+    esp_matter_bridge::device_t *devices[MAX_BRIDGED_DEVICE_COUNT] = { nullptr };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::create_devices(node, configs, count, devices));
+
+    uint16_t endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::get_bridged_endpoint_ids(endpoint_ids));
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_NOT_NULL(devices[i]);
+        TEST_ASSERT_EQUAL(endpoint::get_id(devices[i]->endpoint), endpoint_ids[i]);
+    }
+
+    release_devices(devices, count);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    size_t resumed = 0;
+    uint16_t priv_data_calls = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::resume_all_devices(node, get_resume_priv_data, &priv_data_calls,
+                                                                    devices, &resumed));
+    TEST_ASSERT_EQUAL(count, resumed);
+    TEST_ASSERT_EQUAL(count, priv_data_calls);
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL(endpoint_ids[i], devices[i]->persistent_info.device_endpoint_id);
+        TEST_ASSERT_EQUAL(k_device_type_id + i % 2, devices[i]->persistent_info.device_type_id);
+        TEST_ASSERT_EQUAL(parent_endpoint_id, devices[i]->persistent_info.parent_endpoint_id);
+    }
+
+    // A removed device frees its slot for the next one
+    uint16_t removed_id = devices[0]->persistent_info.device_endpoint_id;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::remove_device(devices[0]));
+    devices[0] = esp_matter_bridge::create_device(node, parent_endpoint_id, k_device_type_id, nullptr);
+    TEST_ASSERT_NOT_NULL(devices[0]);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::get_bridged_endpoint_ids(endpoint_ids));
+    TEST_ASSERT_NOT_EQUAL(removed_id, endpoint_ids[0]);
+    TEST_ASSERT_EQUAL(endpoint::get_id(devices[0]->endpoint), endpoint_ids[0]);
+
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::remove_device(devices[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::get_bridged_endpoint_ids(endpoint_ids));
+    for (uint16_t i = 0; i < MAX_BRIDGED_DEVICE_COUNT; ++i) {
+        TEST_ASSERT_EQUAL(chip::kInvalidEndpointId, endpoint_ids[i]);
+    }
+}
+
+static bool has_persistent_info(uint16_t endpoint_id)
+{
+    nvs_handle_t handle;
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
+                                                      ESP_MATTER_BRIDGE_NAMESPACE, NVS_READONLY, &handle));
+    esp_matter_bridge::device_persistent_info_t persistent_info;
+    size_t len = sizeof(persistent_info);
+    esp_err_t err = nvs_get_blob(handle,
+                                 esp_matter_bridge::nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
+                                 &persistent_info, &len);
+    nvs_close(handle);
+    return err == ESP_OK;
+}
+
+TEST_CASE("a failed bulk creation leaves the registry unchanged", "[bridge]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+    uint16_t parent_endpoint_id = get_aggregator_endpoint_id(node);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::factory_reset());
+
+    esp_matter_bridge::device_t *existing = esp_matter_bridge::create_device(node, parent_endpoint_id,
+                                                                             k_device_type_id, nullptr);
+    TEST_ASSERT_NOT_NULL(existing);
+    uint16_t endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::get_bridged_endpoint_ids(endpoint_ids));
+
+    // The last device has a parent endpoint which is not an aggregator, the devices before it are rolled back
+    uint16_t count = get_device_count(node);
+    TEST_ASSERT_GREATER_THAN(1, count);
+    esp_matter_bridge::device_config_t configs[MAX_BRIDGED_DEVICE_COUNT];
+    for (uint16_t i = 0; i < count; ++i) {
+        configs[i] = { parent_endpoint_id, k_device_type_id, nullptr };
+    }
+    configs[count - 1].parent_endpoint_id = 0;
+    uint16_t endpoint_count = endpoint::get_count(node);
+    esp_matter_bridge::device_t *devices[MAX_BRIDGED_DEVICE_COUNT] = { nullptr };
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, esp_matter_bridge::create_devices(node, configs, count, devices));
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_NULL(devices[i]);
+    }
+    TEST_ASSERT_EQUAL(endpoint_count, endpoint::get_count(node));
+
+    // Neither the registry in memory nor the one stored in the NVS lists the rolled back devices
+    uint16_t new_endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::get_bridged_endpoint_ids(new_endpoint_ids));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(endpoint_ids, new_endpoint_ids, MAX_BRIDGED_DEVICE_COUNT);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::get_bridged_endpoint_ids(new_endpoint_ids));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(endpoint_ids, new_endpoint_ids, MAX_BRIDGED_DEVICE_COUNT);
+
+    uint16_t existing_id = existing->persistent_info.device_endpoint_id;
+    TEST_ASSERT_TRUE(has_persistent_info(existing_id));
+    // The rolled back devices took the endpoint ids after the existing device
+    for (uint16_t i = 1; i < count; ++i) {
+        TEST_ASSERT_FALSE(has_persistent_info(existing_id + i));
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::remove_device(existing));
+    TEST_ASSERT_FALSE(has_persistent_info(existing_id));
+}
+
+TEST_CASE("benchmark restoring bridged devices", "[bridge][benchmark]")
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+    uint16_t parent_endpoint_id = get_aggregator_endpoint_id(node);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::factory_reset());
+
+    // 100 bridged devices need CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT >= 103, smaller configurations are
+    // measured with as many devices as they allow.
+    uint16_t count = get_device_count(node);
+    esp_matter_bridge::device_t *devices[MAX_BRIDGED_DEVICE_COUNT] = { nullptr };
+
+    int64_t start = esp_timer_get_time();
+    for (uint16_t i = 0; i < count; ++i) {
+        devices[i] = esp_matter_bridge::create_device(node, parent_endpoint_id, k_device_type_id, nullptr);
+        TEST_ASSERT_NOT_NULL(devices[i]);
+    }
+    int64_t create_time = esp_timer_get_time() - start;
+
+    release_devices(devices, count);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    uint16_t endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::get_bridged_endpoint_ids(endpoint_ids));
+    start = esp_timer_get_time();
+    for (uint16_t i = 0; i < count; ++i) {
+        devices[i] = esp_matter_bridge::resume_device(node, endpoint_ids[i], nullptr);
+        TEST_ASSERT_NOT_NULL(devices[i]);
+    }
+    int64_t resume_time = esp_timer_get_time() - start;
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::remove_device(devices[i]));
+    }
+
+    esp_matter_bridge::device_config_t configs[MAX_BRIDGED_DEVICE_COUNT];
+    for (uint16_t i = 0; i < count; ++i) {
+        configs[i] = { parent_endpoint_id, k_device_type_id, nullptr };
+    }
+    start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::create_devices(node, configs, count, devices));
+    int64_t bulk_create_time = esp_timer_get_time() - start;
+
+    release_devices(devices, count);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    size_t resumed = 0;
+    start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::resume_all_devices(node, nullptr, nullptr, devices, &resumed));
+    int64_t bulk_resume_time = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(count, resumed);
+
+    printf("%u bridged devices\n", count);
+    printf("create_device(): %" PRId64 " us, create_devices(): %" PRId64 " us\n", create_time, bulk_create_time);
+    printf("resume_device(): %" PRId64 " us, resume_all_devices(): %" PRId64 " us\n", resume_time, bulk_resume_time);
+
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::remove_device(devices[i]));
+    }
+}
+
+#endif // MAX_BRIDGED_DEVICE_COUNT > 0
@@ -21,7 +21,13 @@
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 #include <esp_spiffs.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include <mbedtls/base64.h>
+#include <sys/stat.h>
+
+#include <algorithm>
 
 #include <attestation_verification_utils.h>
 #include <credentials/attestation_verifier/DefaultDeviceAttestationVerifier.h>
@@ -34,6 +40,29 @@ using namespace esp_matter::controller::attestation_verification;
 namespace chip {
 namespace Credentials {
 
+#if defined(CONFIG_SPIFFS_ATTESTATION_TRUST_STORE) || defined(CONFIG_DCL_ATTESTATION_TRUST_STORE)
+// The lookups of the trust store are const but update its index or its cache, and they may be called by several
+// commissioning tasks at once
+static SemaphoreHandle_t get_trust_store_lock()
+{
+    static StaticSemaphore_t s_trust_store_lock_buffer;
+    static SemaphoreHandle_t s_trust_store_lock = xSemaphoreCreateMutexStatic(&s_trust_store_lock_buffer);
+    return s_trust_store_lock;
+}
+
+class scoped_trust_store_lock {
+public:
+    scoped_trust_store_lock()
+    {
+        xSemaphoreTake(get_trust_store_lock(), portMAX_DELAY);
+    }
+    ~scoped_trust_store_lock()
+    {
+        xSemaphoreGive(get_trust_store_lock());
+    }
+};
+#endif // CONFIG_SPIFFS_ATTESTATION_TRUST_STORE || CONFIG_DCL_ATTESTATION_TRUST_STORE
+
 #ifdef CONFIG_SPIFFS_ATTESTATION_TRUST_STORE
 static const char *get_filename_extension(const char *filename)
 {
@@ -90,6 +119,7 @@ bool paa_der_cert_iterator::next(paa_der_cert_t &item)
         return false;
     }
     m_index++;
+    strlcpy(m_name, entry->d_name, sizeof(m_name));
     char filename[280] = {0};
     snprintf(filename, sizeof(filename), "%s/%s", m_path, entry->d_name);
     FILE *file = fopen(filename, "rb");
@@ -109,9 +139,66 @@ void paa_der_cert_iterator::release()
     }
 }
 
+#define PAA_INDEX_MAGIC 0x49414150 /* "PAAI" */
+#define PAA_INDEX_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t dir_signature;
+    uint32_t count;
+} paa_index_header_t;
+
+static constexpr char k_paa_base_path[] = "/paa";
+// The index file does not have the der extension, so it is skipped by paa_der_cert_iterator
+static constexpr char k_paa_index_path[] = "/paa/paa_skid.idx";
+
+static uint32_t hash_bytes(uint32_t hash, const void *data, size_t len)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Signature of the names, sizes and modification times of the DER files in the directory. It only walks the
+// directory entries, so it is much cheaper than parsing the certificates.
+static uint32_t get_dir_signature(const char *path)
+{
+    uint32_t signature = 2166136261u;
+    DIR *dir = opendir(path);
+    if (!dir) {
+        return signature;
+    }
+    dirent *entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(get_filename_extension(entry->d_name), "der", strlen("der")) != 0) {
+            continue;
+        }
+        char filename[280] = {0};
+        snprintf(filename, sizeof(filename), "%s/%s", path, entry->d_name);
+        struct stat st = {};
+        stat(filename, &st);
+        // The order of the directory entries changes with the files written to the partition, so the file
+        // signatures are combined in an order independent way.
+        uint32_t file_signature = hash_bytes(2166136261u, entry->d_name, strlen(entry->d_name));
+        file_signature = hash_bytes(file_signature, &st.st_size, sizeof(st.st_size));
+        file_signature = hash_bytes(file_signature, &st.st_mtime, sizeof(st.st_mtime));
+        signature += file_signature;
+    }
+    closedir(dir);
+    return signature;
+}
+
 esp_err_t spiffs_attestation_trust_store::init()
 {
-    esp_vfs_spiffs_conf_t conf = {.base_path = "/paa",
+    scoped_trust_store_lock lock;
+    if (m_is_initialized) {
+        return ESP_OK;
+    }
+    esp_vfs_spiffs_conf_t conf = {.base_path = k_paa_base_path,
 #ifdef CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_PARTITION_LABEL
                                   .partition_label = CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_PARTITION_LABEL,
 #else
@@ -124,34 +211,190 @@ esp_err_t spiffs_attestation_trust_store::init()
     size_t total = 0, used = 0;
     ESP_RETURN_ON_ERROR(esp_spiffs_info(conf.partition_label, &total, &used), TAG, "Failed to get SPIFFS info");
     ESP_LOGI(TAG, "Partition size: total: %d, used: %d", total, used);
+    uint32_t dir_signature = get_dir_signature(k_paa_base_path);
+    m_dir_scan_time_us = esp_timer_get_time();
+    if (load_index(dir_signature) != ESP_OK) {
+        ESP_RETURN_ON_ERROR(build_index(dir_signature), TAG, "Failed to build the PAA index");
+        if (store_index() != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to store the PAA index, it will be rebuilt on the next boot");
+        }
+    }
     m_is_initialized = true;
     return ESP_OK;
 }
 
+void spiffs_attestation_trust_store::deinit()
+{
+    scoped_trust_store_lock lock;
+    VerifyOrReturn(m_is_initialized);
+    esp_matter_mem_free(m_index);
+    m_index = nullptr;
+    m_index_count = 0;
+    m_dir_signature = 0;
+#ifdef CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_PARTITION_LABEL
+    esp_vfs_spiffs_unregister(CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_PARTITION_LABEL);
+#else
+    esp_vfs_spiffs_unregister(nullptr);
+#endif
+    m_is_initialized = false;
+}
+
+esp_err_t spiffs_attestation_trust_store::load_index(uint32_t dir_signature) const
+{
+    FILE *file = fopen(k_paa_index_path, "rb");
+    if (!file) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    esp_err_t ret = ESP_OK;
+    paa_index_header_t header;
+    paa_index_entry_t *index = nullptr;
+    ESP_GOTO_ON_FALSE(fread(&header, sizeof(header), 1, file) == 1, ESP_ERR_INVALID_SIZE, exit, TAG,
+                      "Failed to read the PAA index header");
+    ESP_GOTO_ON_FALSE(header.magic == PAA_INDEX_MAGIC && header.version == PAA_INDEX_VERSION &&
+                      header.entry_size == sizeof(paa_index_entry_t), ESP_ERR_INVALID_VERSION, exit, TAG,
+                      "Invalid PAA index");
+    if (header.dir_signature != dir_signature) {
+        ESP_LOGI(TAG, "The PAA certificates changed, rebuilding the PAA index");
+        ret = ESP_ERR_INVALID_STATE;
+        goto exit;
+    }
+    if (header.count > 0) {
+        index = (paa_index_entry_t *)esp_matter_mem_calloc(header.count, sizeof(paa_index_entry_t));
+        ESP_GOTO_ON_FALSE(index, ESP_ERR_NO_MEM, exit, TAG, "Failed to allocate the PAA index");
+        ESP_GOTO_ON_FALSE(fread(index, sizeof(paa_index_entry_t), header.count, file) == header.count,
+                          ESP_ERR_INVALID_SIZE, exit, TAG, "Failed to read the PAA index");
+    }
+    esp_matter_mem_free(m_index);
+    m_index = index;
+    index = nullptr;
+    m_index_count = header.count;
+    m_dir_signature = dir_signature;
+    ESP_LOGI(TAG, "Loaded the PAA index of %u certificates", (unsigned)m_index_count);
+exit:
+    esp_matter_mem_free(index);
+    fclose(file);
+    return ret;
+}
+
+esp_err_t spiffs_attestation_trust_store::build_index(uint32_t dir_signature) const
+{
+    paa_der_cert_iterator iter(k_paa_base_path);
+    paa_index_entry_t *index = nullptr;
+    size_t count = 0;
+    if (iter.count() > 0) {
+        index = (paa_index_entry_t *)esp_matter_mem_calloc(iter.count(), sizeof(paa_index_entry_t));
+        ESP_RETURN_ON_FALSE(index, ESP_ERR_NO_MEM, TAG, "Failed to allocate the PAA index");
+    }
+    paa_der_cert_t *paa_cert = (paa_der_cert_t *)esp_matter_mem_calloc(1, sizeof(paa_der_cert_t));
+    if (!paa_cert) {
+        esp_matter_mem_free(index);
+        ESP_LOGE(TAG, "Failed to allocate the PAA certificate buffer");
+        return ESP_ERR_NO_MEM;
+    }
+    while (count < iter.count() && iter.next(*paa_cert)) {
+        if (paa_cert->m_len == 0) {
+            continue;
+        }
+        MutableByteSpan skid_span{index[count].skid};
+        ByteSpan paa_der{paa_cert->m_buffer, paa_cert->m_len};
+        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(paa_der, skid_span) ||
+                skid_span.size() != Crypto::kSubjectKeyIdentifierLength) {
+            ESP_LOGW(TAG, "Failed to extract the SKID of %s", iter.name());
+            continue;
+        }
+        strlcpy(index[count].name, iter.name(), sizeof(index[count].name));
+        count++;
+    }
+    esp_matter_mem_free(paa_cert);
+    std::sort(index, index + count, [](const paa_index_entry_t &a, const paa_index_entry_t &b) {
+        return memcmp(a.skid, b.skid, sizeof(a.skid)) < 0;
+    });
+    esp_matter_mem_free(m_index);
+    m_index = index;
+    m_index_count = count;
+    m_dir_signature = dir_signature;
+    ESP_LOGI(TAG, "Built the PAA index of %u certificates", (unsigned)m_index_count);
+    return ESP_OK;
+}
+
+esp_err_t spiffs_attestation_trust_store::store_index() const
+{
+    FILE *file = fopen(k_paa_index_path, "wb");
+    ESP_RETURN_ON_FALSE(file, ESP_FAIL, TAG, "Failed to open the PAA index file");
+    paa_index_header_t header = {
+        .magic = PAA_INDEX_MAGIC,
+        .version = PAA_INDEX_VERSION,
+        .entry_size = sizeof(paa_index_entry_t),
+        .dir_signature = m_dir_signature,
+        .count = static_cast<uint32_t>(m_index_count),
+    };
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(m_index, sizeof(paa_index_entry_t), m_index_count, file) == m_index_count;
+    fclose(file);
+    if (!written) {
+        // Do not leave a truncated index in the partition
+        remove(k_paa_index_path);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+CHIP_ERROR spiffs_attestation_trust_store::read_indexed_cert(const ByteSpan &skid,
+                                                             MutableByteSpan &outPaaDerBuffer) const
+{
+    const paa_index_entry_t *end = m_index + m_index_count;
+    const paa_index_entry_t *entry = std::lower_bound(m_index, end, skid, [](const paa_index_entry_t &e,
+                                                                             const ByteSpan &key) {
+        return memcmp(e.skid, key.data(), sizeof(e.skid)) < 0;
+    });
+    VerifyOrReturnError(entry != end && memcmp(entry->skid, skid.data(), sizeof(entry->skid)) == 0,
+                        CHIP_ERROR_CA_CERT_NOT_FOUND);
+
+    VerifyOrReturnError(outPaaDerBuffer.size() > 0, CHIP_ERROR_BUFFER_TOO_SMALL);
+    char filename[280] = {0};
+    snprintf(filename, sizeof(filename), "%s/%s", k_paa_base_path, entry->name);
+    FILE *file = fopen(filename, "rb");
+    VerifyOrReturnError(file, CHIP_ERROR_CA_CERT_NOT_FOUND);
+    size_t len = fread(outPaaDerBuffer.data(), sizeof(uint8_t), outPaaDerBuffer.size(), file);
+    // The certificate must fit in the buffer
+    bool truncated = len == outPaaDerBuffer.size() && fgetc(file) != EOF;
+    fclose(file);
+    VerifyOrReturnError(!truncated, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // Check the SKID of the file, which might have been replaced after the index was built
+    uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
+    MutableByteSpan skid_span{skid_buf};
+    VerifyOrReturnError(CHIP_NO_ERROR == Crypto::ExtractSKIDFromX509Cert(ByteSpan{outPaaDerBuffer.data(), len},
+                                                                         skid_span) && skid.data_equal(skid_span),
+                        CHIP_ERROR_CA_CERT_NOT_FOUND);
+    outPaaDerBuffer.reduce_size(len);
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR spiffs_attestation_trust_store::GetProductAttestationAuthorityCert(const ByteSpan &skid,
                                                                               MutableByteSpan &outPaaDerBuffer) const
 {
-    if (m_is_initialized) {
-        paa_der_cert_iterator iter("/paa");
-        paa_der_cert_t paa_cert;
-        while (iter.next(paa_cert)) {
-            if (paa_cert.m_len == 0) {
-                continue;
-            }
-            uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
-            MutableByteSpan skid_span{skid_buf};
-            if (CHIP_NO_ERROR !=
-                    Crypto::ExtractSKIDFromX509Cert(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, skid_span)) {
-                continue;
-            }
-
-            if (skid.data_equal(skid_span)) {
-                return CopySpanToMutableSpan(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, outPaaDerBuffer);
+    VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
+    scoped_trust_store_lock lock;
+    VerifyOrReturnError(m_is_initialized, CHIP_ERROR_INCORRECT_STATE);
+    CHIP_ERROR err = read_indexed_cert(skid, outPaaDerBuffer);
+    int64_t now = esp_timer_get_time();
+    if (err == CHIP_ERROR_CA_CERT_NOT_FOUND &&
+            now - m_dir_scan_time_us >= CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_RESCAN_INTERVAL * 1000000LL) {
+        // The DER files may have changed since the index was built. The scans are rate limited, so that the lookups
+        // of unknown SKIDs do not walk the partition every time.
+        m_dir_scan_time_us = now;
+        uint32_t dir_signature = get_dir_signature(k_paa_base_path);
+        if (dir_signature != m_dir_signature) {
+            ESP_LOGI(TAG, "The PAA certificates changed, rebuilding the PAA index");
+            VerifyOrReturnError(build_index(dir_signature) == ESP_OK, CHIP_ERROR_NO_MEMORY);
+            if (store_index() != ESP_OK) {
+                ESP_LOGW(TAG, "Failed to store the PAA index");
             }
+            err = read_indexed_cert(skid, outPaaDerBuffer);
         }
-        return CHIP_ERROR_CA_CERT_NOT_FOUND;
     }
-    return CHIP_ERROR_INCORRECT_STATE;
+    return err;
 }
 #endif // CONFIG_SPIFFS_ATTESTATION_TRUST_STORE
 
@@ -208,14 +451,112 @@ static void parse_paa_response(http_resp_t *resp, void *ctx)
     cJSON_Delete(root);
 }
 
+void dcl_attestation_trust_store::SetDCLNetType(dcl_net_type_t type)
+{
+    const char *base_url = (type == DCL_MAIN_NET) ? k_main_net_base_url : k_test_net_base_url;
+    scoped_trust_store_lock lock;
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+    if (base_url != m_dcl_net_base_url) {
+        clear_paa_cache();
+    }
+#endif
+    m_dcl_net_base_url = base_url;
+}
+
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+bool dcl_attestation_trust_store::get_cached_paa(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const
+{
+    scoped_trust_store_lock lock;
+    if (!m_paa_cache) {
+        return false;
+    }
+    int64_t now = esp_timer_get_time();
+    for (size_t i = 0; i < CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE; ++i) {
+        paa_cache_entry_t &entry = m_paa_cache[i];
+        if (!entry.in_use || memcmp(entry.skid, skid.data(), sizeof(entry.skid)) != 0) {
+            continue;
+        }
+        if (now - entry.fetched_time_us >= m_paa_cache_expiry_s * 1000000LL) {
+            // Expired, fetch it again from the DCL
+            entry.in_use = false;
+            return false;
+        }
+        if (CopySpanToMutableSpan(ByteSpan{entry.paa_der, entry.paa_der_len}, outPaaDerBuffer) != CHIP_NO_ERROR) {
+            return false;
+        }
+        entry.last_used = ++m_paa_cache_use_count;
+        return true;
+    }
+    return false;
+}
+
+void dcl_attestation_trust_store::cache_paa(const ByteSpan &skid, const ByteSpan &paa_der) const
+{
+    VerifyOrReturn(paa_der.size() <= kMaxDERCertLength);
+    scoped_trust_store_lock lock;
+    if (!m_paa_cache) {
+        m_paa_cache = (paa_cache_entry_t *)esp_matter_mem_calloc(CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE,
+                                                                 sizeof(paa_cache_entry_t));
+        VerifyOrReturn(m_paa_cache, ESP_LOGW(TAG, "Failed to allocate the PAA cache"));
+    }
+    // Replace a free entry or else the least recently used one
+    paa_cache_entry_t *victim = &m_paa_cache[0];
+    for (size_t i = 0; i < CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE; ++i) {
+        paa_cache_entry_t &entry = m_paa_cache[i];
+        if (!entry.in_use) {
+            victim = &entry;
+            break;
+        }
+        if (entry.last_used < victim->last_used) {
+            victim = &entry;
+        }
+    }
+    memcpy(victim->skid, skid.data(), sizeof(victim->skid));
+    memcpy(victim->paa_der, paa_der.data(), paa_der.size());
+    victim->paa_der_len = paa_der.size();
+    victim->fetched_time_us = esp_timer_get_time();
+    victim->last_used = ++m_paa_cache_use_count;
+    victim->in_use = true;
+}
+
+// Called with the lock of the trust store
+void dcl_attestation_trust_store::clear_paa_cache()
+{
+    esp_matter_mem_free(m_paa_cache);
+    m_paa_cache = nullptr;
+}
+
+void dcl_attestation_trust_store::ClearPAACache()
+{
+    scoped_trust_store_lock lock;
+    clear_paa_cache();
+}
+
+void dcl_attestation_trust_store::SetPAACacheExpiry(uint32_t expiry_s)
+{
+    scoped_trust_store_lock lock;
+    m_paa_cache_expiry_s = expiry_s;
+}
+#endif // CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+
 CHIP_ERROR dcl_attestation_trust_store::GetProductAttestationAuthorityCert(const ByteSpan &skid,
                                                                            MutableByteSpan &outPaaDerBuffer) const
 {
     VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(outPaaDerBuffer.size() > 0 && outPaaDerBuffer.size() <= kMaxDERCertLength,
                         CHIP_ERROR_INVALID_ARGUMENT);
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+    if (get_cached_paa(skid, outPaaDerBuffer)) {
+        return CHIP_NO_ERROR;
+    }
+#endif
+    const char *base_url = nullptr;
+    {
+        scoped_trust_store_lock lock;
+        base_url = m_dcl_net_base_url;
+    }
     char url[200];
-    int offset = snprintf(url, sizeof(url), "%s/dcl/pki/certificates?subjectKeyId=", m_dcl_net_base_url);
+    int offset = snprintf(url, sizeof(url), "%s/dcl/pki/certificates?subjectKeyId=", base_url);
     for (size_t i = 0; i < skid.size(); ++i) {
         offset += snprintf(url + offset, sizeof(url) - offset, "%02X", skid[i]);
         if (i < skid.size() - 1) {
@@ -238,6 +579,11 @@ CHIP_ERROR dcl_attestation_trust_store::GetProductAttestationAuthorityCert(const
     if (err != ESP_OK) {
         return CHIP_ERROR_INTERNAL;
     }
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+    if (ctx.err == CHIP_NO_ERROR) {
+        cache_paa(skid, outPaaDerBuffer);
+    }
+#endif
     return ctx.err;
 }
 #endif // CONFIG_DCL_ATTESTATION_TRUST_STORE
@@ -42,10 +42,16 @@ public:
     }
     bool next(paa_der_cert_t &item);
     void release();
+    // Name of the DER file of the last item returned by next()
+    const char *name() const
+    {
+        return m_name;
+    }
 
 private:
     DIR *m_dir = NULL;
     char m_path[16] = {0};
+    char m_name[CONFIG_SPIFFS_OBJ_NAME_LEN] = {0};
     size_t m_count = 0;
     size_t m_index = 0;
 };
@@ -66,8 +72,34 @@ public:
 
     esp_err_t init();
 
+    /** Release the PAA index and unmount the partition of the trust store
+     *
+     *  The next init() mounts the partition again and loads the stored PAA index if the DER files did not change.
+     */
+    void deinit();
+
 private:
+    // The PAA certificates are looked up by SKID in an index which is sorted by SKID. The index is stored in the
+    // partition with the signature of the DER files it was built from, and it is only rebuilt when the DER files
+    // change.
+    typedef struct {
+        uint8_t skid[Crypto::kSubjectKeyIdentifierLength];
+        char name[CONFIG_SPIFFS_OBJ_NAME_LEN];
+    } paa_index_entry_t;
+
+    esp_err_t load_index(uint32_t dir_signature) const;
+    esp_err_t build_index(uint32_t dir_signature) const;
+    esp_err_t store_index() const;
+    CHIP_ERROR read_indexed_cert(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const;
+
     bool m_is_initialized = false;
+    // The index is rebuilt by the const lookups, it is guarded by the lock of the trust store
+    mutable paa_index_entry_t *m_index = nullptr;
+    mutable size_t m_index_count = 0;
+    mutable uint32_t m_dir_signature = 0;
+    // Time of the last scan of the DER files, they are scanned at most once per
+    // CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_RESCAN_INTERVAL
+    mutable int64_t m_dir_scan_time_us = 0;
     spiffs_attestation_trust_store() {}
 };
 #endif // CONFIG_SPIFFS_ATTESTATION_TRUST_STORE
@@ -92,15 +124,50 @@ public:
     CHIP_ERROR GetProductAttestationAuthorityCert(const ByteSpan &skid,
                                                   MutableByteSpan &outPaaDerBuffer) const override;
 
-    void SetDCLNetType(dcl_net_type_t type)
-    {
-        m_dcl_net_base_url = (type == DCL_MAIN_NET) ? k_main_net_base_url : k_test_net_base_url;
-    }
+    void SetDCLNetType(dcl_net_type_t type);
+
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+    /** Drop the PAA certificates of the cache, the next lookups fetch them from the DCL */
+    void ClearPAACache();
+
+    /** Set the expiry of the cached PAA certificates, CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_EXPIRY by default
+     *
+     * @param[in] expiry_s expiry in seconds, it applies to the certificates already in the cache
+     */
+    void SetPAACacheExpiry(uint32_t expiry_s);
+#endif // CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
 
 private:
     static constexpr char *k_test_net_base_url = "https://on.test-net.dcl.csa-iot.org";
     static constexpr char *k_main_net_base_url = "https://on.dcl.csa-iot.org";
+#ifdef CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL
+    // The custom DCL is used until SetDCLNetType() is called
+    const char *m_dcl_net_base_url = sizeof(CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL) > 1
+                                     ? CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL : k_main_net_base_url;
+#else
     const char *m_dcl_net_base_url = k_main_net_base_url;
+#endif
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+    // The PAA certificates fetched from the DCL are kept in a small LRU cache, so that the devices of the same vendor
+    // are attested without a request to the DCL until the cached certificate expires. The cache is updated by the
+    // const lookups, it is guarded by the lock of the trust store.
+    typedef struct {
+        uint8_t skid[Crypto::kSubjectKeyIdentifierLength];
+        uint8_t paa_der[kMaxDERCertLength];
+        size_t paa_der_len;
+        int64_t fetched_time_us;
+        uint32_t last_used;
+        bool in_use;
+    } paa_cache_entry_t;
+
+    bool get_cached_paa(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const;
+    void cache_paa(const ByteSpan &skid, const ByteSpan &paa_der) const;
+    void clear_paa_cache();
+
+    mutable paa_cache_entry_t *m_paa_cache = nullptr;
+    mutable uint32_t m_paa_cache_use_count = 0;
+    uint32_t m_paa_cache_expiry_s = CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_EXPIRY;
+#endif // CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
     dcl_attestation_trust_store() {}
 };
 #endif // CONFIG_DCL_ATTESTATION_TRUST_STORE
@@ -0,0 +1,455 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <esp_check.h>
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <nvs.h>
+#include <nvs_flash.h>
+
+#include <esp_matter_da_revocation_cache.h>
+#include <esp_matter_da_revocation_check.h>
+
+#include <algorithm>
+
+constexpr char *TAG = "da_revocation_cache";
+
+using namespace chip;
+
+namespace esp_matter {
+namespace controller {
+namespace attestation_verification {
+
+uint64_t encode_x509_time(const mbedtls_x509_time &time)
+{
+    uint64_t encoded = static_cast<uint64_t>(time.year);
+    encoded = encoded * 12 + (time.mon - 1);
+    encoded = encoded * 31 + (time.day - 1);
+    encoded = encoded * 24 + time.hour;
+    encoded = encoded * 60 + time.min;
+    encoded = encoded * 60 + time.sec;
+    return encoded;
+}
+
+static int compare_serial_number(const revoked_serial_number_t &entry, const ByteSpan &serial_number)
+{
+    if (entry.len != serial_number.size()) {
+        return entry.len < serial_number.size() ? -1 : 1;
+    }
+    return memcmp(entry.value, serial_number.data(), entry.len);
+}
+
+const revoked_serial_number_t *find_revoked_serial_number(const revocation_set_t &set, const ByteSpan &serial_number)
+{
+    const revoked_serial_number_t *end = set.serial_numbers + set.serial_number_count;
+    const revoked_serial_number_t *entry =
+        std::lower_bound(set.serial_numbers, end, serial_number,
+                         [](const revoked_serial_number_t &e, const ByteSpan &key) {
+                             return compare_serial_number(e, key) < 0;
+                         });
+    if (entry != end && compare_serial_number(*entry, serial_number) == 0) {
+        return entry;
+    }
+    return nullptr;
+}
+
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+#define REVOCATION_SET_BLOB_VERSION 2
+
+static constexpr char k_nvs_namespace[] = "da_crl_cache";
+
+// Header of the blob of a revocation set, which is followed by the CRLSignerCertificate, the CRLSignerDelegator and
+// the revoked serial numbers. A serial number is encoded as its length, its value and its revocation date.
+typedef struct {
+    uint16_t version;
+    uint16_t crl_signer_cert_len;
+    uint16_t crl_signer_delegator_len;
+    uint8_t issuer_skid[Crypto::kSubjectKeyIdentifierLength];
+    uint32_t serial_number_count;
+    uint32_t serial_numbers_size;
+    uint64_t next_update;
+} revocation_set_blob_header_t;
+
+static constexpr size_t k_serial_number_overhead = sizeof(uint8_t) + sizeof(uint64_t);
+
+// The blob of a slot is split in chunks of at most CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_MAX_BLOB_SIZE bytes
+static void get_nvs_key(size_t slot, size_t chunk, char *key, size_t key_size)
+{
+    snprintf(key, key_size, "crl_%u_%u", (unsigned)slot, (unsigned)chunk);
+}
+
+// Erase the chunks of a slot, which are stored under consecutive keys
+static void erase_nvs_chunks(nvs_handle_t handle, size_t slot)
+{
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    for (size_t chunk = 0;; ++chunk) {
+        get_nvs_key(slot, chunk, key, sizeof(key));
+        if (nvs_erase_key(handle, key) != ESP_OK) {
+            break;
+        }
+    }
+}
+
+void free_revocation_set(revocation_set_t *set)
+{
+    if (set) {
+        esp_matter_mem_free(set->serial_numbers);
+        esp_matter_mem_free(set);
+    }
+}
+
+static revocation_set_t *alloc_revocation_set(size_t serial_number_count)
+{
+    revocation_set_t *set = (revocation_set_t *)esp_matter_mem_calloc(1, sizeof(revocation_set_t));
+    if (set && serial_number_count > 0) {
+        set->serial_numbers =
+            (revoked_serial_number_t *)esp_matter_mem_calloc(serial_number_count, sizeof(revoked_serial_number_t));
+        if (!set->serial_numbers) {
+            esp_matter_mem_free(set);
+            return nullptr;
+        }
+    }
+    return set;
+}
+
+static esp_err_t get_current_encoded_time(uint64_t &now)
+{
+    mbedtls_x509_time current_time = {};
+    ESP_RETURN_ON_ERROR(get_current_time(current_time), TAG, "The current time is unknown");
+    now = encode_x509_time(current_time);
+    return ESP_OK;
+}
+
+static size_t get_serial_numbers_size(const revocation_set_t &set)
+{
+    size_t size = 0;
+    for (size_t i = 0; i < set.serial_number_count; ++i) {
+        size += k_serial_number_overhead + set.serial_numbers[i].len;
+    }
+    return size;
+}
+
+size_t get_revocation_set_blob_size(const revocation_set_t &set)
+{
+    return sizeof(revocation_set_blob_header_t) + set.crl_signer_cert_len + set.crl_signer_delegator_len +
+           get_serial_numbers_size(set);
+}
+
+esp_err_t encode_revocation_set(const revocation_set_t &set, uint8_t *blob, size_t blob_size)
+{
+    ESP_RETURN_ON_FALSE(blob && blob_size == get_revocation_set_blob_size(set), ESP_ERR_INVALID_SIZE, TAG,
+                        "Invalid blob size");
+    revocation_set_blob_header_t header = {
+        .version = REVOCATION_SET_BLOB_VERSION,
+        .crl_signer_cert_len = static_cast<uint16_t>(set.crl_signer_cert_len),
+        .crl_signer_delegator_len = static_cast<uint16_t>(set.crl_signer_delegator_len),
+        .serial_number_count = static_cast<uint32_t>(set.serial_number_count),
+        .serial_numbers_size = static_cast<uint32_t>(get_serial_numbers_size(set)),
+        .next_update = set.next_update,
+    };
+    memcpy(header.issuer_skid, set.issuer_skid, sizeof(header.issuer_skid));
+    uint8_t *p = blob;
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    memcpy(p, set.crl_signer_cert, set.crl_signer_cert_len);
+    p += set.crl_signer_cert_len;
+    memcpy(p, set.crl_signer_delegator, set.crl_signer_delegator_len);
+    p += set.crl_signer_delegator_len;
+    for (size_t i = 0; i < set.serial_number_count; ++i) {
+        const revoked_serial_number_t &serial_number = set.serial_numbers[i];
+        *p++ = serial_number.len;
+        memcpy(p, serial_number.value, serial_number.len);
+        p += serial_number.len;
+        memcpy(p, &serial_number.revocation_date, sizeof(serial_number.revocation_date));
+        p += sizeof(serial_number.revocation_date);
+    }
+    return ESP_OK;
+}
+
+revocation_set_t *decode_revocation_set(const uint8_t *blob, size_t blob_size)
+{
+    revocation_set_blob_header_t header;
+    VerifyOrReturnValue(blob && blob_size >= sizeof(header), nullptr);
+    memcpy(&header, blob, sizeof(header));
+    size_t expected_size = sizeof(header) + header.crl_signer_cert_len + header.crl_signer_delegator_len +
+                           header.serial_numbers_size;
+    if (header.version != REVOCATION_SET_BLOB_VERSION || header.serial_numbers_size > blob_size ||
+            blob_size != expected_size ||
+            header.serial_number_count > header.serial_numbers_size / (k_serial_number_overhead + 1) ||
+            header.crl_signer_cert_len > Crypto::kMax_x509_Certificate_Length ||
+            header.crl_signer_delegator_len > Crypto::kMax_x509_Certificate_Length) {
+        ESP_LOGW(TAG, "Invalid revocation set blob");
+        return nullptr;
+    }
+    revocation_set_t *set = alloc_revocation_set(header.serial_number_count);
+    VerifyOrReturnValue(set, nullptr);
+    const uint8_t *p = blob + sizeof(header);
+    const uint8_t *end = blob + blob_size;
+    memcpy(set->issuer_skid, header.issuer_skid, sizeof(set->issuer_skid));
+    set->next_update = header.next_update;
+    set->crl_signer_cert_len = header.crl_signer_cert_len;
+    memcpy(set->crl_signer_cert, p, set->crl_signer_cert_len);
+    p += set->crl_signer_cert_len;
+    set->crl_signer_delegator_len = header.crl_signer_delegator_len;
+    memcpy(set->crl_signer_delegator, p, set->crl_signer_delegator_len);
+    p += set->crl_signer_delegator_len;
+    for (; set->serial_number_count < header.serial_number_count; ++set->serial_number_count) {
+        revoked_serial_number_t &serial_number = set->serial_numbers[set->serial_number_count];
+        if (end - p < static_cast<ptrdiff_t>(k_serial_number_overhead) || p[0] == 0 ||
+                p[0] > Crypto::kMaxCertificateSerialNumberLength ||
+                end - p < static_cast<ptrdiff_t>(k_serial_number_overhead + p[0])) {
+            break;
+        }
+        serial_number.len = *p++;
+        memcpy(serial_number.value, p, serial_number.len);
+        p += serial_number.len;
+        memcpy(&serial_number.revocation_date, p, sizeof(serial_number.revocation_date));
+        p += sizeof(serial_number.revocation_date);
+    }
+    if (set->serial_number_count != header.serial_number_count || p != end) {
+        ESP_LOGW(TAG, "Invalid serial numbers in the revocation set blob");
+        free_revocation_set(set);
+        return nullptr;
+    }
+    return set;
+}
+
+const revocation_set_t *crl_revocation_cache::find(const ByteSpan &issuer_skid)
+{
+    VerifyOrReturnValue(issuer_skid.size() == Crypto::kSubjectKeyIdentifierLength, nullptr);
+    load();
+    for (size_t slot = 0; slot < CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_SIZE; ++slot) {
+        revocation_set_t *set = m_sets[slot];
+        if (!set || !issuer_skid.data_equal(ByteSpan(set->issuer_skid))) {
+            continue;
+        }
+        // Without the current time the nextUpdate of the CRL cannot be checked, fetch the CRL again
+        uint64_t now = 0;
+        if (get_current_encoded_time(now) != ESP_OK) {
+            return nullptr;
+        }
+        if (now >= set->next_update) {
+            ESP_LOGI(TAG, "The cached CRL has reached its nextUpdate");
+            remove(slot);
+            return nullptr;
+        }
+        set->last_used = ++m_use_count;
+        return set;
+    }
+    return nullptr;
+}
+
+esp_err_t crl_revocation_cache::add(const ByteSpan &issuer_skid, const mbedtls_x509_crl *crl,
+                                    const ByteSpan &crl_signer_cert, const ByteSpan &crl_signer_delegator)
+{
+    ESP_RETURN_ON_FALSE(issuer_skid.size() == Crypto::kSubjectKeyIdentifierLength && crl, ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid argument");
+    ESP_RETURN_ON_FALSE(crl_signer_cert.size() <= Crypto::kMax_x509_Certificate_Length &&
+                        crl_signer_delegator.size() <= Crypto::kMax_x509_Certificate_Length, ESP_ERR_INVALID_SIZE,
+                        TAG, "Invalid CRL signer certificate");
+    ESP_RETURN_ON_FALSE(crl->next_update.year != 0, ESP_ERR_INVALID_STATE, TAG, "The CRL has no nextUpdate");
+    uint64_t now = 0;
+    ESP_RETURN_ON_ERROR(get_current_encoded_time(now), TAG, "Failed to get the current time");
+    uint64_t next_update = encode_x509_time(crl->next_update);
+    ESP_RETURN_ON_FALSE(now < next_update, ESP_ERR_INVALID_STATE, TAG, "The CRL has reached its nextUpdate");
+
+    size_t serial_number_count = 0;
+    for (const mbedtls_x509_crl_entry *entry = &crl->entry; entry != NULL; entry = entry->next) {
+        if (entry->serial.len > 0 && entry->serial.len <= Crypto::kMaxCertificateSerialNumberLength) {
+            serial_number_count++;
+        }
+    }
+    revocation_set_t *set = alloc_revocation_set(serial_number_count);
+    ESP_RETURN_ON_FALSE(set, ESP_ERR_NO_MEM, TAG, "Failed to allocate the revocation set");
+    memcpy(set->issuer_skid, issuer_skid.data(), sizeof(set->issuer_skid));
+    set->next_update = next_update;
+    set->crl_signer_cert_len = crl_signer_cert.size();
+    memcpy(set->crl_signer_cert, crl_signer_cert.data(), crl_signer_cert.size());
+    set->crl_signer_delegator_len = crl_signer_delegator.size();
+    memcpy(set->crl_signer_delegator, crl_signer_delegator.data(), crl_signer_delegator.size());
+    for (const mbedtls_x509_crl_entry *entry = &crl->entry; entry != NULL; entry = entry->next) {
+        if (entry->serial.len > 0 && entry->serial.len <= Crypto::kMaxCertificateSerialNumberLength) {
+            revoked_serial_number_t &serial_number = set->serial_numbers[set->serial_number_count++];
+            serial_number.len = entry->serial.len;
+            memcpy(serial_number.value, entry->serial.p, entry->serial.len);
+            serial_number.revocation_date = encode_x509_time(entry->revocation_date);
+        }
+    }
+    std::sort(set->serial_numbers, set->serial_numbers + set->serial_number_count,
+              [](const revoked_serial_number_t &a, const revoked_serial_number_t &b) {
+                  return compare_serial_number(a, ByteSpan(b.value, b.len)) < 0;
+              });
+    return add(set);
+}
+
+esp_err_t crl_revocation_cache::add(revocation_set_t *set)
+{
+    ESP_RETURN_ON_FALSE(set, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ByteSpan issuer_skid(set->issuer_skid);
+    load();
+
+    // Replace the set of the same issuer, or else a free slot, or else the least recently used set
+    size_t victim = 0;
+    for (size_t slot = 0; slot < CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_SIZE; ++slot) {
+        if (m_sets[slot] && issuer_skid.data_equal(ByteSpan(m_sets[slot]->issuer_skid))) {
+            victim = slot;
+            break;
+        }
+        if (!m_sets[slot]) {
+            if (m_sets[victim]) {
+                victim = slot;
+            }
+        } else if (m_sets[victim] && m_sets[slot]->last_used < m_sets[victim]->last_used) {
+            victim = slot;
+        }
+    }
+    free_revocation_set(m_sets[victim]);
+    set->last_used = ++m_use_count;
+    m_sets[victim] = set;
+    if (store(victim) != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to store the revocation set, it is only cached until reboot");
+    }
+    ESP_LOGI(TAG, "Cached the revocation set of %u serial numbers", (unsigned)set->serial_number_count);
+    return ESP_OK;
+}
+
+void crl_revocation_cache::clear()
+{
+    load();
+    for (size_t slot = 0; slot < CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_SIZE; ++slot) {
+        if (m_sets[slot]) {
+            remove(slot);
+        }
+    }
+}
+
+esp_err_t crl_revocation_cache::open_nvs(nvs_open_mode_t open_mode, nvs_handle_t *handle)
+{
+    const char *partition = CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_NVS_PARTITION;
+    if (!m_nvs_ready && strcmp(partition, NVS_DEFAULT_PART_NAME) != 0) {
+        // The dedicated partition only holds the cache, which is fetched again if the partition is erased
+        esp_err_t err = nvs_flash_init_partition(partition);
+        if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+            ESP_LOGW(TAG, "Erasing the NVS partition %s of the cache", partition);
+            ESP_RETURN_ON_ERROR(nvs_flash_erase_partition(partition), TAG, "Failed to erase the NVS partition");
+            err = nvs_flash_init_partition(partition);
+        }
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to initialize the NVS partition %s", partition);
+    }
+    m_nvs_ready = true;
+    return nvs_open_from_partition(partition, k_nvs_namespace, open_mode, handle);
+}
+
+void crl_revocation_cache::load()
+{
+    if (m_loaded) {
+        return;
+    }
+    m_loaded = true;
+    nvs_handle_t handle;
+    if (open_nvs(NVS_READONLY, &handle) != ESP_OK) {
+        return;
+    }
+    for (size_t slot = 0; slot < CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_SIZE; ++slot) {
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        size_t blob_size = 0;
+        size_t chunk_count = 0;
+        for (;; ++chunk_count) {
+            size_t chunk_size = 0;
+            get_nvs_key(slot, chunk_count, key, sizeof(key));
+            if (nvs_get_blob(handle, key, nullptr, &chunk_size) != ESP_OK) {
+                break;
+            }
+            blob_size += chunk_size;
+        }
+        if (blob_size < sizeof(revocation_set_blob_header_t)) {
+            continue;
+        }
+        uint8_t *blob = (uint8_t *)esp_matter_mem_calloc(1, blob_size);
+        if (!blob) {
+            break;
+        }
+        size_t offset = 0;
+        esp_err_t err = ESP_OK;
+        for (size_t chunk = 0; chunk < chunk_count && err == ESP_OK; ++chunk) {
+            size_t chunk_size = blob_size - offset;
+            get_nvs_key(slot, chunk, key, sizeof(key));
+            err = nvs_get_blob(handle, key, blob + offset, &chunk_size);
+            offset += chunk_size;
+        }
+        if (err == ESP_OK && offset == blob_size) {
+            m_sets[slot] = decode_revocation_set(blob, blob_size);
+        }
+        esp_matter_mem_free(blob);
+    }
+    nvs_close(handle);
+}
+
+void crl_revocation_cache::reload()
+{
+    for (size_t slot = 0; slot < CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_SIZE; ++slot) {
+        free_revocation_set(m_sets[slot]);
+        m_sets[slot] = nullptr;
+    }
+    m_loaded = false;
+    load();
+}
+
+esp_err_t crl_revocation_cache::store(size_t slot)
+{
+    const revocation_set_t *set = m_sets[slot];
+    ESP_RETURN_ON_FALSE(set, ESP_ERR_INVALID_STATE, TAG, "No revocation set in the slot");
+    nvs_handle_t handle;
+    ESP_RETURN_ON_ERROR(open_nvs(NVS_READWRITE, &handle), TAG, "Failed to open the NVS namespace");
+    // The set previously stored in the slot could have more chunks than the new one
+    erase_nvs_chunks(handle, slot);
+    size_t blob_size = get_revocation_set_blob_size(*set);
+    uint8_t *blob = (uint8_t *)esp_matter_mem_calloc(1, blob_size);
+    esp_err_t err = blob ? encode_revocation_set(*set, blob, blob_size) : ESP_ERR_NO_MEM;
+    size_t offset = 0;
+    for (size_t chunk = 0; err == ESP_OK && offset < blob_size; ++chunk) {
+        size_t chunk_size = std::min(blob_size - offset, (size_t)CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_MAX_BLOB_SIZE);
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        get_nvs_key(slot, chunk, key, sizeof(key));
+        err = nvs_set_blob(handle, key, blob + offset, chunk_size);
+        offset += chunk_size;
+    }
+    if (err != ESP_OK) {
+        // Do not load a partially stored set after a reboot
+        erase_nvs_chunks(handle, slot);
+    }
+    nvs_commit(handle);
+    nvs_close(handle);
+    esp_matter_mem_free(blob);
+    return err;
+}
+
+void crl_revocation_cache::remove(size_t slot)
+{
+    free_revocation_set(m_sets[slot]);
+    m_sets[slot] = nullptr;
+    nvs_handle_t handle;
+    if (open_nvs(NVS_READWRITE, &handle) == ESP_OK) {
+        erase_nvs_chunks(handle, slot);
+        nvs_commit(handle);
+        nvs_close(handle);
+    }
+}
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+
+} // namespace attestation_verification
+} // namespace controller
+} // namespace esp_matter
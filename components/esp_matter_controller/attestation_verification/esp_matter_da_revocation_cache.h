@@ -0,0 +1,172 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <esp_err.h>
+#include <lib/support/Span.h>
+#include <mbedtls/x509_crl.h>
+#include <nvs.h>
+
+using chip::ByteSpan;
+
+namespace esp_matter {
+namespace controller {
+namespace attestation_verification {
+
+typedef struct {
+    uint8_t len;
+    uint8_t value[chip::Crypto::kMaxCertificateSerialNumberLength];
+    uint64_t revocation_date;
+} revoked_serial_number_t;
+
+/** Revocation set of an issuer, built from a CRL whose issuer has been checked against the CRLSignerCertificate */
+typedef struct {
+    uint8_t issuer_skid[chip::Crypto::kSubjectKeyIdentifierLength];
+    /** nextUpdate of the CRL, encoded with encode_x509_time() */
+    uint64_t next_update;
+    uint32_t last_used;
+    size_t crl_signer_cert_len;
+    uint8_t crl_signer_cert[chip::Crypto::kMax_x509_Certificate_Length];
+    size_t crl_signer_delegator_len;
+    uint8_t crl_signer_delegator[chip::Crypto::kMax_x509_Certificate_Length];
+    size_t serial_number_count;
+    /** Revoked serial numbers sorted by length and value */
+    revoked_serial_number_t *serial_numbers;
+} revocation_set_t;
+
+/** Encode a X.509 time in an integer, the encoded times have the same order as the times.
+ *
+ * @param[in] time The X.509 time
+ *
+ * @return The encoded time
+ */
+uint64_t encode_x509_time(const mbedtls_x509_time &time);
+
+/** Find a serial number in a revocation set.
+ *
+ * @param[in] set The revocation set
+ * @param[in] serial_number The serial number
+ *
+ * @return The revoked serial number, nullptr if the serial number is not in the revocation set
+ */
+const revoked_serial_number_t *find_revoked_serial_number(const revocation_set_t &set, const ByteSpan &serial_number);
+
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+/** Get the size of the blob of a revocation set, where each serial number takes its length and 9 bytes.
+ *
+ * @param[in] set The revocation set
+ *
+ * @return The size of the blob
+ */
+size_t get_revocation_set_blob_size(const revocation_set_t &set);
+
+/** Encode a revocation set in a blob, which is stored in NVS chunks of at most
+ *  CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_MAX_BLOB_SIZE bytes.
+ *
+ * @param[in] set The revocation set
+ * @param[out] blob The blob
+ * @param[in] blob_size The size of the blob, which is get_revocation_set_blob_size()
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_SIZE if the blob size is not the one of the set
+ */
+esp_err_t encode_revocation_set(const revocation_set_t &set, uint8_t *blob, size_t blob_size);
+
+/** Decode a revocation set from a blob.
+ *
+ * @param[in] blob The blob
+ * @param[in] blob_size The size of the blob
+ *
+ * @return The revocation set to be freed with free_revocation_set(), nullptr if the blob is invalid
+ */
+revocation_set_t *decode_revocation_set(const uint8_t *blob, size_t blob_size);
+
+/** Free a revocation set returned by decode_revocation_set().
+ *
+ * @param[in] set The revocation set, could be nullptr
+ */
+void free_revocation_set(revocation_set_t *set);
+
+/** Cache of the revocation sets of the CRLs fetched from the DCL revocation points, keyed by the SKID of the issuer
+ *  of the DA certificates. A revocation set is used until the nextUpdate of its CRL, and the cache is stored in the
+ *  CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_NVS_PARTITION partition so that it is kept across reboots. The blob of a
+ *  set is split in NVS blobs of at most CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_MAX_BLOB_SIZE bytes, a set that does
+ *  not fit in the partition is only kept in RAM.
+ */
+class crl_revocation_cache {
+public:
+    crl_revocation_cache(crl_revocation_cache &other) = delete;
+    void operator=(const crl_revocation_cache &) = delete;
+
+    static crl_revocation_cache &get_instance()
+    {
+        static crl_revocation_cache instance;
+        return instance;
+    }
+
+    /** Get the cached revocation set of an issuer.
+     *
+     * @param[in] issuer_skid The SKID of the issuer, which is the AKID of the DA certificate
+     *
+     * @return The revocation set, nullptr if it is not cached or if its CRL has reached nextUpdate
+     */
+    const revocation_set_t *find(const ByteSpan &issuer_skid);
+
+    /** Add the revocation set of a CRL to the cache, the least recently used set is evicted if the cache is full.
+     *
+     * @param[in] issuer_skid The SKID of the issuer, which is the AKID of the DA certificate
+     * @param[in] crl The MbedTLS parsed CRL, which is issued by the CRLSignerCertificate
+     * @param[in] crl_signer_cert The CRLSignerCertificate in DER format
+     * @param[in] crl_signer_delegator The CRLSignerDelegator in DER format, could be empty.
+     *
+     * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the current time or the nextUpdate of the CRL is unknown
+     */
+    esp_err_t add(const ByteSpan &issuer_skid, const mbedtls_x509_crl *crl, const ByteSpan &crl_signer_cert,
+                  const ByteSpan &crl_signer_delegator);
+
+    /** Add a revocation set to the cache, the least recently used set is evicted if the cache is full.
+     *
+     * @param[in] set The revocation set, whose serial numbers are sorted. It is allocated by decode_revocation_set()
+     *                and the cache takes its ownership.
+     *
+     * @return ESP_OK on success
+     */
+    esp_err_t add(revocation_set_t *set);
+
+    /** Drop the revocation sets cached in RAM and load the ones stored in NVS again. */
+    void reload();
+
+    /** Remove all the revocation sets from the cache and from NVS, it is called when the DCL net is changed and by
+     *  the `matter esp controller crl-cache clear` console command.
+     */
+    void clear();
+
+private:
+    void load();
+    esp_err_t open_nvs(nvs_open_mode_t open_mode, nvs_handle_t *handle);
+    esp_err_t store(size_t slot);
+    void remove(size_t slot);
+
+    revocation_set_t *m_sets[CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_SIZE] = {nullptr};
+    uint32_t m_use_count = 0;
+    bool m_loaded = false;
+    bool m_nvs_ready = false;
+    crl_revocation_cache() = default;
+};
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+
+} // namespace attestation_verification
+} // namespace controller
+} // namespace esp_matter
@@ -20,6 +20,7 @@
 #include <mbedtls/x509.h>
 #include <mbedtls/x509_crl.h>
 #include <mbedtls/x509_crt.h>
+#include <string.h>
 #include <sys/time.h>
 
 #include <crypto/CHIPCryptoPAL.h>
@@ -32,13 +33,12 @@ namespace esp_matter {
 namespace controller {
 namespace attestation_verification {
 
-// This function will get the current time. If the commissioner doesn't synchronize the time with the NTP server.
-// it will use 2025-1-1 as the current time.
-static esp_err_t get_current_time(mbedtls_x509_time &time)
+esp_err_t get_current_time(mbedtls_x509_time &time)
 {
     struct timeval tv;
-    if (gettimeofday(&tv, nullptr) == 0) {
+    if (gettimeofday(&tv, nullptr) != 0) {
         ESP_LOGW(TAG, "Failed to get current time, using 2025-1-1 as the current time");
+        memset(&time, 0, sizeof(time));
         time.year = 2025;
         time.mon = 1;
         time.day = 1;
@@ -49,6 +49,7 @@ static esp_err_t get_current_time(mbedtls_x509_time &time)
     localtime_r(&timep, &calendar);
     if (calendar.tm_year + 1900 < 2025) {
         ESP_LOGW(TAG, "Invalid UNIX time, using 2025-1-1 as the current time");
+        memset(&time, 0, sizeof(time));
         time.year = 2025;
         time.mon = 1;
         time.day = 1;
@@ -205,6 +206,20 @@ bool is_da_cert_serial_number_revoked(const ByteSpan &da_cert, const mbedtls_x50
     }
     return false;
 }
+
+bool is_da_cert_serial_number_revoked(const ByteSpan &da_cert, const revocation_set_t &revocation_set)
+{
+    uint8_t serialNumberBuf[Crypto::kMaxCertificateSerialNumberLength] = {0};
+    MutableByteSpan serialNumber(serialNumberBuf);
+    Crypto::ExtractSerialNumberFromX509Cert(da_cert, serialNumber);
+    const revoked_serial_number_t *entry = find_revoked_serial_number(revocation_set, serialNumber);
+    if (entry) {
+        mbedtls_x509_time current_time;
+        get_current_time(current_time);
+        return encode_x509_time(current_time) >= entry->revocation_date;
+    }
+    return false;
+}
 } // namespace attestation_verification
 } // namespace controller
 } // namespace esp_matter
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <esp_err.h>
+#include <esp_matter_da_revocation_cache.h>
 #include <lib/support/Span.h>
 #include <mbedtls/x509_crl.h>
 
@@ -23,6 +25,15 @@ namespace esp_matter {
 namespace controller {
 namespace attestation_verification {
 
+/** This function will get the current time. If the commissioner doesn't synchronize the time with the NTP server,
+ *  it will use 2025-1-1 as the current time.
+ *
+ * @param[out] time The current time
+ *
+ * @return ESP_OK if the current time is synchronized, ESP_FAIL if 2025-1-1 is used
+ */
+esp_err_t get_current_time(mbedtls_x509_time &time);
+
 /** This function will do the following validation for the DA Certificate.
  *
  *  If DA certificate is PAI, the subject and SKID of its issuer should match the subject of the CRLSignerCertificate
@@ -57,6 +68,15 @@ bool check_crl_signer_cert(const mbedtls_x509_crl *crl, const ByteSpan &crl_sign
  * @return whether the serialNumber of the DA certificate is in the CRL revocation sets
  */
 bool is_da_cert_serial_number_revoked(const ByteSpan &da_cert, const mbedtls_x509_crl *crl);
+
+/** This function will check the serialNumber of the DA certificate is in a revocation set.
+ *
+ * @param[in] da_cert The DA certificate in DER format
+ * @param[in] revocation_set The revocation set built from the CRL
+ *
+ * @return whether the serialNumber of the DA certificate is in the revocation set
+ */
+bool is_da_cert_serial_number_revoked(const ByteSpan &da_cert, const revocation_set_t &revocation_set);
 } // namespace attestation_verification
 } // namespace controller
 } // namespace esp_matter
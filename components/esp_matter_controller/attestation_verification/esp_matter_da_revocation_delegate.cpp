@@ -22,6 +22,7 @@
 #include <esp_spiffs.h>
 
 #include <attestation_verification_utils.h>
+#include <esp_matter_da_revocation_cache.h>
 #include <esp_matter_da_revocation_check.h>
 #include <esp_matter_da_revocation_delegate.h>
 #include <http_client_get.h>
@@ -126,25 +127,43 @@ static void parse_revocation_points_response(http_resp_t *resp, void *ctx)
 }
 
 typedef struct download_crl_ctx {
-    esp_err_t err = ESP_OK;
-    MutableByteSpan &out_crl;
+    esp_err_t err = ESP_FAIL;
+    mbedtls_x509_crl &out_crl;
 } download_crl_ctx_t;
 
+// The CRL is parsed from the buffer of the HTTP response rather than copied to a buffer of a fixed size
 static void download_crl(http_resp_t *resp, void *ctx)
 {
     download_crl_ctx_t *resp_ctx = (download_crl_ctx_t *)ctx;
     if (!resp_ctx) {
         return;
     }
-    if (resp_ctx->out_crl.size() < resp->size) {
-        resp_ctx->err = ESP_ERR_NO_MEM;
+    if (resp->size <= 0 || resp->size > CONFIG_DCL_REVOCATION_POINTS_CRL_MAX_SIZE) {
+        ESP_LOGE(TAG, "Invalid CRL size %d, the maximum is %d", resp->size, CONFIG_DCL_REVOCATION_POINTS_CRL_MAX_SIZE);
+        resp_ctx->err = ESP_ERR_INVALID_SIZE;
+        return;
+    }
+    int ret = mbedtls_x509_crl_parse(&resp_ctx->out_crl, resp->data, resp->size);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "Failed to parse the downloaded CRL, ret: -0x%x", -ret);
+        resp_ctx->err = ESP_FAIL;
         return;
     }
-    memcpy(resp_ctx->out_crl.data(), resp->data, resp->size);
-    resp_ctx->out_crl.reduce_size(resp->size);
     resp_ctx->err = ESP_OK;
 }
 
+void dcl_revocation_point_da_revocation_delegate::set_dcl_net_type(dcl_net_type_t net_type)
+{
+    const char *base_url = (net_type == DCL_MAIN_NET) ? k_main_net_base_url : k_test_net_base_url;
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+    // The revocation points of a net are not valid in the other one
+    if (strcmp(base_url, m_dcl_net_base_url) != 0) {
+        crl_revocation_cache::get_instance().clear();
+    }
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+    m_dcl_net_base_url = base_url;
+}
+
 void dcl_revocation_point_da_revocation_delegate::CheckForRevokedDACChain(
     const DeviceAttestationVerifier::AttestationInfo &info,
     Callback::Callback<DeviceAttestationVerifier::OnAttestationInformationVerification> *onCompletion)
@@ -168,38 +187,49 @@ bool dcl_revocation_point_da_revocation_delegate::IsCertRevoked(const ByteSpan &
     uint8_t da_cert_akid_buf[Crypto::kAuthorityKeyIdentifierLength];
     MutableByteSpan da_cert_akid(da_cert_akid_buf);
     Crypto::ExtractAKIDFromX509Cert(certDer, da_cert_akid);
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+    const revocation_set_t *revocation_set = crl_revocation_cache::get_instance().find(da_cert_akid);
+    if (revocation_set) {
+        ByteSpan cached_crl_signer_cert(revocation_set->crl_signer_cert, revocation_set->crl_signer_cert_len);
+        ByteSpan cached_crl_signer_delegator(revocation_set->crl_signer_delegator,
+                                             revocation_set->crl_signer_delegator_len);
+        return cross_validate_cert(isPAI, certDer, cached_crl_signer_cert, cached_crl_signer_delegator) &&
+               is_da_cert_serial_number_revoked(certDer, *revocation_set);
+    }
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
     uint8_t crl_signer_cert_buf[Crypto::kMax_x509_Certificate_Length];
     MutableByteSpan crl_signer_cert(crl_signer_cert_buf);
     uint8_t crl_signer_delegator_buf[Crypto::kMax_x509_Certificate_Length];
     MutableByteSpan crl_signer_delegator(crl_signer_delegator_buf);
     char crl_url_buf[k_crl_url_max_len];
     MutableCharSpan crl_url(crl_url_buf);
-    uint8_t crl_der_buf[k_crl_max_len];
-    MutableByteSpan crl_der(crl_der_buf);
     if (fetch_revocation_set_from_dcl(da_cert_akid, crl_signer_cert, crl_signer_delegator, crl_url) != ESP_OK) {
         ESP_LOGI(TAG, "Cannot fetch revocation set from DCL with the issuer SKID");
         return false;
     }
-    if (fetch_crl(crl_url, crl_der) != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to fetch CRL with the URL in DCL");
-        return false;
-    }
+    bool revoked = false;
     mbedtls_x509_crl crl;
     mbedtls_x509_crl_init(&crl);
-    int ret = mbedtls_x509_crl_parse(&crl, crl_der.data(), crl_der.size());
-    if (ret == 0) {
+    if (fetch_crl(crl_url, crl) == ESP_OK) {
         // Ensure that the CRL Signer Certificate is the issuer of the CRL.
         if (check_crl_signer_cert(&crl, crl_signer_cert)) {
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+            if (crl_revocation_cache::get_instance().add(da_cert_akid, &crl, crl_signer_cert, crl_signer_delegator) !=
+                    ESP_OK) {
+                ESP_LOGW(TAG, "Failed to cache the revocation set of the CRL");
+            }
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
             // Check the CRL Signer Certificate or CRL Signer Delegator with the DA certificate
             if (cross_validate_cert(isPAI, certDer, crl_signer_cert, crl_signer_delegator)) {
                 // Check whether the serial number of the DA certificate is revoked in the CRL
-                return is_da_cert_serial_number_revoked(certDer, &crl);
+                revoked = is_da_cert_serial_number_revoked(certDer, &crl);
             }
         }
     } else {
-        ESP_LOGE(TAG, "Failed to parse the downloaded CRL");
+        ESP_LOGE(TAG, "Failed to fetch CRL with the URL in DCL");
     }
-    return false;
+    mbedtls_x509_crl_free(&crl);
+    return revoked;
 }
 
 esp_err_t dcl_revocation_point_da_revocation_delegate::fetch_revocation_set_from_dcl(
@@ -232,7 +262,7 @@ esp_err_t dcl_revocation_point_da_revocation_delegate::fetch_revocation_set_from
     return ctx.err;
 }
 
-esp_err_t dcl_revocation_point_da_revocation_delegate::fetch_crl(const CharSpan &crl_url, MutableByteSpan &crl)
+esp_err_t dcl_revocation_point_da_revocation_delegate::fetch_crl(const CharSpan &crl_url, mbedtls_x509_crl &crl)
 {
     ESP_RETURN_ON_FALSE(crl_url.size() > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid CRL URL");
     download_crl_ctx_t ctx = {
@@ -15,6 +15,7 @@
 #include <credentials/CHIPCert.h>
 #include <credentials/attestation_verifier/DeviceAttestationVerifier.h>
 #include <lib/support/Span.h>
+#include <mbedtls/x509_crl.h>
 
 namespace chip {
 namespace Credentials {
@@ -27,7 +28,6 @@ public:
         DCL_TEST_NET,
     } dcl_net_type_t;
     static constexpr size_t k_crl_url_max_len = 256;
-    static constexpr size_t k_crl_max_len = 1200;
 
     dcl_revocation_point_da_revocation_delegate(dcl_revocation_point_da_revocation_delegate &other) = delete;
     void operator=(const dcl_revocation_point_da_revocation_delegate &) = delete;
@@ -38,16 +38,23 @@ public:
         return instance;
     }
 
-    void set_dcl_net_type(dcl_net_type_t net_type)
-    {
-        m_dcl_net_base_url = (net_type == DCL_MAIN_NET) ? k_main_net_base_url : k_test_net_base_url;
-    }
+    /** Set the DCL net of the revocation points, the cached CRLs of the previous net are removed */
+    void set_dcl_net_type(dcl_net_type_t net_type);
 
     bool IsCertRevoked(const ByteSpan &certDer, bool isPAI);
 
     esp_err_t fetch_revocation_set_from_dcl(const ByteSpan &issuer_skid, MutableByteSpan &crl_signer_cert,
                                             MutableByteSpan &crl_signer_delegator, MutableCharSpan &crl_url);
-    esp_err_t fetch_crl(const CharSpan &crl_url, MutableByteSpan &crl);
+
+    /** Download a CRL and parse it from the received data
+     *
+     * @param[in] crl_url The URL of the CRL
+     * @param[out] crl The initialized MbedTLS CRL, the caller frees it with mbedtls_x509_crl_free()
+     *
+     * @return ESP_OK on success, ESP_ERR_INVALID_SIZE if the CRL is larger than
+     *         CONFIG_DCL_REVOCATION_POINTS_CRL_MAX_SIZE
+     */
+    esp_err_t fetch_crl(const CharSpan &crl_url, mbedtls_x509_crl &crl);
 
     void CheckForRevokedDACChain(
         const DeviceAttestationVerifier::AttestationInfo &info,
@@ -56,7 +63,13 @@ public:
 private:
     static constexpr char *k_test_net_base_url = "https://on.test-net.dcl.csa-iot.org";
     static constexpr char *k_main_net_base_url = "https://on.dcl.csa-iot.org";
+#ifdef CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL
+    // The custom DCL is used until set_dcl_net_type() is called
+    const char *m_dcl_net_base_url = sizeof(CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL) > 1
+                                     ? CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL : k_main_net_base_url;
+#else
     const char *m_dcl_net_base_url = k_main_net_base_url;
+#endif
     dcl_revocation_point_da_revocation_delegate() = default;
 };
 #endif // CONFIG_DCL_REVOCATION_POINTS_REVOKED_DAC_CHAIN_CHECK
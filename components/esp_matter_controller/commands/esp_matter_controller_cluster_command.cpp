@@ -13,7 +13,6 @@
 // limitations under the License.
 
 #include <controller/CommissioneeDeviceProxy.h>
-#include <cJSON.h>
 #include <esp_check.h>
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_cluster_command.h>
@@ -62,6 +61,32 @@ void cluster_command::on_device_connection_failure_fcn(void *context, const Scop
     return;
 }
 
+// Render the response in a buffer which is grown for the large responses, like scan results
+static constexpr size_t k_min_response_json_len = 128;
+static constexpr uint8_t k_max_response_json_attempts = 4;
+
+static char *response_to_json(const TLVReader &response_data, esp_err_t &err)
+{
+    size_t buf_size = response_data.GetRemainingLength() * 3 + k_min_response_json_len;
+    char *buf = nullptr;
+    err = ESP_ERR_NO_MEM;
+    for (uint8_t attempt = 0; attempt < k_max_response_json_attempts; ++attempt, buf_size *= 2) {
+        esp_matter_mem_free(buf);
+        buf = (char *)esp_matter_mem_calloc(1, buf_size);
+        if (!buf) {
+            err = ESP_ERR_NO_MEM;
+            break;
+        }
+        TLVReader reader;
+        reader.Init(response_data);
+        err = tlv_to_json_string(reader, buf, buf_size, nullptr, tlv_to_json_options { .human_readable_bytes = true });
+        if (err != ESP_ERR_INVALID_SIZE) {
+            break;
+        }
+    }
+    return buf;
+}
+
 void cluster_command::default_success_fcn(void *ctx, const ConcreteCommandPath &command_path, const StatusIB &status,
                                           TLVReader *response_data)
 {
@@ -75,20 +100,16 @@ void cluster_command::default_success_fcn(void *ctx, const ConcreteCommandPath &
         return;
     }
 
-    cJSON *decoded_json = nullptr;
-    if (tlv_to_json(*response_data, &decoded_json, tlv_to_json_options { .human_readable_bytes = true }) != ESP_OK) {
+    esp_err_t err = ESP_OK;
+    char *response_json = response_to_json(*response_data, err);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Response JSON:\n%s", response_json);
+    } else if (err == ESP_ERR_INVALID_SIZE) {
+        ESP_LOGW(TAG, "Response JSON (truncated):\n%s", response_json);
+    } else {
         ESP_LOGW(TAG, "Failed to convert response payload to JSON");
-        cJSON_Delete(decoded_json);
-        return;
-    }
-
-    char *formatted_response = cJSON_Print(decoded_json);
-    if (formatted_response) {
-        ESP_LOGI(TAG, "Response JSON:\n%s", formatted_response);
     }
-
-    cJSON_free(formatted_response);
-    cJSON_Delete(decoded_json);
+    esp_matter_mem_free(response_json);
 }
 
 void cluster_command::default_error_fcn(void *ctx, CHIP_ERROR error)
@@ -158,5 +179,23 @@ esp_err_t send_invoke_cluster_command(uint64_t destination_id, uint16_t endpoint
     return cmd->send_command();
 }
 
+esp_err_t send_invoke_cluster_command(uint64_t destination_id, uint16_t endpoint_id, uint32_t cluster_id,
+                                      uint32_t command_id, const encoded_payload &command_data,
+                                      chip::Optional<uint16_t> timed_invoke_timeout_ms)
+{
+    if (!command_data.is_valid()) {
+        ESP_LOGE(TAG, "The command data field is not a valid encoding");
+        return ESP_ERR_INVALID_ARG;
+    }
+    cluster_command *cmd = chip::Platform::New<cluster_command>(destination_id, endpoint_id, cluster_id, command_id,
+                                                                command_data, timed_invoke_timeout_ms);
+    if (!cmd) {
+        ESP_LOGE(TAG, "Failed to alloc memory for cluster_command");
+        return ESP_ERR_NO_MEM;
+    }
+
+    return cmd->send_command();
+}
+
 } // namespace controller
 } // namespace esp_matter
@@ -34,6 +34,7 @@ using chip::TLV::TLVReader;
 using esp_matter::client::peer_device_t;
 using esp_matter::client::interaction::invoke::custom_command_callback;
 using esp_matter::client::interaction::custom_encodable_type;
+using esp_matter::client::interaction::encoded_payload;
 
 /** Cluster command class to send an invoke interaction command to a server **/
 class cluster_command {
@@ -44,11 +45,24 @@ public:
                     custom_command_callback::on_success_callback_t on_success = default_success_fcn,
                     custom_command_callback::on_error_callback_t on_error = default_error_fcn,
                     on_connect_failure_cb_t connect_fail_cb = nullptr)
+        : cluster_command(destination_id, endpoint_id, cluster_id, command_id,
+                          custom_encodable_type(command_data_field, custom_encodable_type::interaction_type::k_invoke_cmd),
+                          timed_invoke_timeout_ms, on_success, on_error, connect_fail_cb)
+    {
+    }
+
+    /** Constructor for command with a command data field compiled from JSON, see encoded_payload **/
+    cluster_command(uint64_t destination_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                    const encoded_payload &command_data,
+                    const chip::Optional<uint16_t> timed_invoke_timeout_ms = chip::NullOptional,
+                    custom_command_callback::on_success_callback_t on_success = default_success_fcn,
+                    custom_command_callback::on_error_callback_t on_error = default_error_fcn,
+                    on_connect_failure_cb_t connect_fail_cb = nullptr)
         : m_destination_id(destination_id)
         , m_endpoint_id(endpoint_id)
         , m_cluster_id(cluster_id)
         , m_command_id(command_id)
-        , m_command_data_field(command_data_field, custom_encodable_type::interaction_type::k_invoke_cmd)
+        , m_command_data_field(command_data)
         , m_timed_invoke_timeout_ms(timed_invoke_timeout_ms)
         , on_device_connected_cb(on_device_connected_fcn, this)
         , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
@@ -115,5 +129,24 @@ esp_err_t send_invoke_cluster_command(uint64_t destination_id, uint16_t endpoint
                                       uint32_t command_id, const char *command_data_field,
                                       chip::Optional<uint16_t> timed_invoke_timeout_ms = chip::NullOptional);
 
+/** Send cluster invoke command with a command data field compiled from JSON
+ *
+ * The command data field is not converted again, so the same encoded_payload can be sent to many destinations and
+ * on every retry.
+ *
+ * @param[in] destination_id NodeId or GroupId
+ * @param[in] endpoint_id EndpointId
+ * @param[in] cluster_id ClusterId
+ * @param[in] command_id CommandId
+ * @param[in] command_data Command data field compiled from a JSON string
+ * @param[in] timed_invoke_timeout_ms Timeout in millisecond for timed-invoke command
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t send_invoke_cluster_command(uint64_t destination_id, uint16_t endpoint_id, uint32_t cluster_id,
+                                      uint32_t command_id, const encoded_payload &command_data,
+                                      chip::Optional<uint16_t> timed_invoke_timeout_ms = chip::NullOptional);
+
 } // namespace controller
 } // namespace esp_matter
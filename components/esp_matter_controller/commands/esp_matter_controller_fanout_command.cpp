@@ -0,0 +1,328 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <inttypes.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_fanout_command.h>
+#include <esp_timer.h>
+#include <memory>
+#include <string.h>
+
+static const char *TAG = "fanout_command";
+
+namespace esp_matter {
+namespace controller {
+namespace fanout {
+
+namespace {
+
+node_sender_t s_node_sender = nullptr;
+
+enum class node_state_t : uint8_t {
+    k_pending = 0,
+    k_in_flight,
+    k_finished,
+};
+
+// Lives as long as a callback of one of its commands may be called, i.e. until the last read is done or the last
+// subscription is terminated.
+class fanout_engine : public std::enable_shared_from_this<fanout_engine> {
+public:
+    fanout_engine(bool subscribe, uint16_t min_interval, uint16_t max_interval, const config_t &config)
+        : m_subscribe(subscribe)
+        , m_min_interval(min_interval)
+        , m_max_interval(max_interval)
+        , m_config(config)
+    {
+    }
+
+    esp_err_t init(const uint64_t *node_ids, size_t node_count,
+                   const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                   const ScopedMemoryBufferWithSize<EventPathParams> &event_paths)
+    {
+        m_results.Calloc(node_count);
+        m_states.Calloc(node_count);
+        ESP_RETURN_ON_FALSE(m_results.Get() && m_states.Get(), ESP_ERR_NO_MEM, TAG, "No memory for %u nodes",
+                            (unsigned)node_count);
+        for (size_t i = 0; i < node_count; ++i) {
+            m_results[i].node_id = node_ids[i];
+            m_results[i].chip_err = CHIP_NO_ERROR;
+        }
+        ESP_RETURN_ON_ERROR(copy_paths(attr_paths, m_attr_paths), TAG, "No memory for the attribute paths");
+        ESP_RETURN_ON_ERROR(copy_paths(event_paths, m_event_paths), TAG, "No memory for the event paths");
+        return ESP_OK;
+    }
+
+    void start()
+    {
+        m_start_time = esp_timer_get_time();
+        launch();
+    }
+
+private:
+    template <typename T>
+    static esp_err_t copy_paths(const ScopedMemoryBufferWithSize<T> &paths, ScopedMemoryBufferWithSize<T> &copy)
+    {
+        if (!paths.Get() || paths.AllocatedSize() == 0) {
+            copy.Free();
+            return ESP_OK;
+        }
+        copy.Alloc(paths.AllocatedSize());
+        VerifyOrReturnError(copy.Get(), ESP_ERR_NO_MEM);
+        memcpy(copy.Get(), paths.Get(), paths.AllocatedSize() * sizeof(T));
+        return ESP_OK;
+    }
+
+    // Fill the window, the commands may finish synchronously, e.g. when the session cannot be looked up
+    void launch()
+    {
+        if (m_launching) {
+            return;
+        }
+        m_launching = true;
+        while (m_in_flight < m_config.max_in_flight && m_next < m_results.AllocatedSize()) {
+            size_t index = m_next++;
+            m_states[index] = node_state_t::k_in_flight;
+            m_results[index].start_time_us = esp_timer_get_time() - m_start_time;
+            m_in_flight++;
+            if (m_in_flight > m_max_in_flight) {
+                m_max_in_flight = m_in_flight;
+            }
+            esp_err_t err = start_node(index);
+            if (err != ESP_OK) {
+                finish_node(index, err, CHIP_NO_ERROR);
+            }
+        }
+        m_launching = false;
+        if (m_finished == m_results.AllocatedSize() && !m_reported) {
+            m_reported = true;
+            report();
+        }
+    }
+
+    void finish_node(size_t index, esp_err_t err, CHIP_ERROR chip_err)
+    {
+        if (m_states[index] != node_state_t::k_in_flight) {
+            return;
+        }
+        m_states[index] = node_state_t::k_finished;
+        node_result_t &result = m_results[index];
+        result.err = err;
+        if (chip_err != CHIP_NO_ERROR) {
+            result.chip_err = chip_err;
+        }
+        result.time_us = esp_timer_get_time() - m_start_time - result.start_time_us;
+        m_in_flight--;
+        m_finished++;
+        launch();
+    }
+
+    void report()
+    {
+        stats_t stats = {};
+        stats.node_count = m_results.AllocatedSize();
+        stats.max_in_flight = m_max_in_flight;
+        stats.total_time_us = esp_timer_get_time() - m_start_time;
+        int64_t node_time_sum = 0;
+        for (size_t i = 0; i < m_results.AllocatedSize(); ++i) {
+            const node_result_t &result = m_results[i];
+            if (result.err == ESP_OK) {
+                stats.succeeded++;
+            } else {
+                stats.failed++;
+            }
+            if (i == 0 || result.time_us < stats.min_node_time_us) {
+                stats.min_node_time_us = result.time_us;
+            }
+            if (result.time_us > stats.max_node_time_us) {
+                stats.max_node_time_us = result.time_us;
+            }
+            node_time_sum += result.time_us;
+        }
+        if (stats.node_count > 0) {
+            stats.avg_node_time_us = node_time_sum / (int64_t)stats.node_count;
+        }
+        ESP_LOGI(TAG, "%u nodes in %" PRId64 " ms: %u succeeded, %u failed, at most %u in flight, "
+                 "%" PRId64 "/%" PRId64 "/%" PRId64 " ms min/avg/max per node", (unsigned)stats.node_count,
+                 stats.total_time_us / 1000, (unsigned)stats.succeeded, (unsigned)stats.failed,
+                 (unsigned)stats.max_in_flight, stats.min_node_time_us / 1000, stats.avg_node_time_us / 1000,
+                 stats.max_node_time_us / 1000);
+        if (m_config.done_cb) {
+            m_config.done_cb(m_results.Get(), m_results.AllocatedSize(), stats);
+        }
+    }
+
+    esp_err_t alloc_node_paths(ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                               ScopedMemoryBufferWithSize<EventPathParams> &event_paths)
+    {
+        ESP_RETURN_ON_ERROR(copy_paths(m_attr_paths, attr_paths), TAG, "No memory for the attribute paths");
+        ESP_RETURN_ON_ERROR(copy_paths(m_event_paths, event_paths), TAG, "No memory for the event paths");
+        return ESP_OK;
+    }
+
+    attribute_report_cb_t get_attribute_cb(size_t index)
+    {
+        std::shared_ptr<fanout_engine> self = shared_from_this();
+        return [self, index](uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+        chip::TLV::TLVReader *data, const chip::app::StatusIB &status) {
+            self->m_results[index].attribute_count++;
+            if (self->m_config.attribute_cb) {
+                self->m_config.attribute_cb(node_id, path, data, status);
+            }
+        };
+    }
+
+    event_report_cb_t get_event_cb(size_t index)
+    {
+        std::shared_ptr<fanout_engine> self = shared_from_this();
+        return [self, index](uint64_t node_id, const chip::app::EventHeader &header, chip::TLV::TLVReader *data,
+        const chip::app::StatusIB *status) {
+            self->m_results[index].event_count++;
+            if (self->m_config.event_cb) {
+                self->m_config.event_cb(node_id, header, data, status);
+            }
+        };
+    }
+
+    on_connect_failure_cb_t get_connect_failure_cb(size_t index)
+    {
+        std::shared_ptr<fanout_engine> self = shared_from_this();
+        return [self, index](void *ctx, const chip::ScopedNodeId &peer_id, CHIP_ERROR error) {
+            ESP_LOGE(TAG, "Failed to connect to node 0x%" PRIx64 ": %s", peer_id.GetNodeId(), chip::ErrorStr(error));
+            self->finish_node(index, ESP_FAIL, error);
+        };
+    }
+
+    node_callbacks_t get_node_callbacks(size_t index)
+    {
+        std::shared_ptr<fanout_engine> self = shared_from_this();
+        node_callbacks_t callbacks;
+        callbacks.attribute_cb = get_attribute_cb(index);
+        callbacks.event_cb = get_event_cb(index);
+        callbacks.connect_failure_cb = get_connect_failure_cb(index);
+        callbacks.read_done_cb = [self, index](uint64_t node_id,
+                                               const ScopedMemoryBufferWithSize<AttributePathParams> &,
+        const ScopedMemoryBufferWithSize<EventPathParams> &) {
+            CHIP_ERROR error = self->m_results[index].chip_err;
+            self->finish_node(index, error == CHIP_NO_ERROR ? ESP_OK : ESP_FAIL, error);
+        };
+        callbacks.error_cb = [self, index](uint64_t node_id, CHIP_ERROR error) {
+            self->m_results[index].chip_err = error;
+        };
+        callbacks.established_cb = [self, index](uint64_t node_id, uint32_t subscription_id) {
+            self->m_results[index].subscription_id = subscription_id;
+            self->finish_node(index, ESP_OK, CHIP_NO_ERROR);
+        };
+        // Only a subscription which ends before being established is a failure
+        callbacks.terminated_cb = [self, index](uint64_t node_id, uint32_t subscription_id) {
+            self->finish_node(index, ESP_FAIL, CHIP_NO_ERROR);
+        };
+        return callbacks;
+    }
+
+    esp_err_t start_node(size_t index)
+    {
+        node_callbacks_t callbacks = get_node_callbacks(index);
+        if (s_node_sender) {
+            return s_node_sender(m_results[index].node_id, m_subscribe, callbacks);
+        }
+        return m_subscribe ? start_subscribe(index, callbacks) : start_read(index, callbacks);
+    }
+
+    esp_err_t start_read(size_t index, const node_callbacks_t &callbacks)
+    {
+        ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+        ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+        ESP_RETURN_ON_ERROR(alloc_node_paths(attr_paths, event_paths), TAG, "Failed to copy the paths");
+        read_command *cmd = chip::Platform::New<read_command>(
+                                m_results[index].node_id, std::move(attr_paths), std::move(event_paths), callbacks.attribute_cb,
+                                callbacks.read_done_cb, callbacks.event_cb, callbacks.connect_failure_cb, callbacks.error_cb);
+        ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for read_command");
+        return cmd->send_command();
+    }
+
+    esp_err_t start_subscribe(size_t index, const node_callbacks_t &callbacks)
+    {
+        ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+        ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+        ESP_RETURN_ON_ERROR(alloc_node_paths(attr_paths, event_paths), TAG, "Failed to copy the paths");
+        subscribe_command *cmd = chip::Platform::New<subscribe_command>(
+                                     m_results[index].node_id, std::move(attr_paths), std::move(event_paths), m_min_interval, m_max_interval,
+                                     true, callbacks.attribute_cb, callbacks.event_cb, callbacks.established_cb, callbacks.terminated_cb,
+                                     callbacks.connect_failure_cb, true);
+        ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for subscribe_command");
+        return cmd->send_command();
+    }
+
+    bool m_subscribe;
+    uint16_t m_min_interval;
+    uint16_t m_max_interval;
+    config_t m_config;
+    ScopedMemoryBufferWithSize<node_result_t> m_results;
+    ScopedMemoryBufferWithSize<node_state_t> m_states;
+    ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
+    ScopedMemoryBufferWithSize<EventPathParams> m_event_paths;
+    size_t m_next = 0;
+    size_t m_in_flight = 0;
+    size_t m_max_in_flight = 0;
+    size_t m_finished = 0;
+    bool m_launching = false;
+    bool m_reported = false;
+    int64_t m_start_time = 0;
+};
+
+esp_err_t send_command(bool subscribe, const uint64_t *node_ids, size_t node_count,
+                       const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                       const ScopedMemoryBufferWithSize<EventPathParams> &event_paths, uint16_t min_interval,
+                       uint16_t max_interval, const config_t &config)
+{
+    ESP_RETURN_ON_FALSE(node_ids && node_count > 0, ESP_ERR_INVALID_ARG, TAG, "No node to send the command to");
+    ESP_RETURN_ON_FALSE(attr_paths.AllocatedSize() > 0 || event_paths.AllocatedSize() > 0, ESP_ERR_INVALID_ARG, TAG,
+                        "No attribute or event path");
+    ESP_RETURN_ON_FALSE(config.max_in_flight > 0, ESP_ERR_INVALID_ARG, TAG, "max_in_flight cannot be 0");
+    std::shared_ptr<fanout_engine> engine =
+        std::make_shared<fanout_engine>(subscribe, min_interval, max_interval, config);
+    ESP_RETURN_ON_FALSE(engine, ESP_ERR_NO_MEM, TAG, "No memory for the fan-out command");
+    ESP_RETURN_ON_ERROR(engine->init(node_ids, node_count, attr_paths, event_paths), TAG,
+                        "Failed to initialize the fan-out command");
+    engine->start();
+    return ESP_OK;
+}
+
+} // namespace
+
+void set_node_sender(node_sender_t sender)
+{
+    s_node_sender = sender;
+}
+
+esp_err_t send_read_command(const uint64_t *node_ids, size_t node_count,
+                            const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                            const ScopedMemoryBufferWithSize<EventPathParams> &event_paths, const config_t &config)
+{
+    return send_command(false, node_ids, node_count, attr_paths, event_paths, 0, 0, config);
+}
+
+esp_err_t send_subscribe_command(const uint64_t *node_ids, size_t node_count,
+                                 const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                                 const ScopedMemoryBufferWithSize<EventPathParams> &event_paths,
+                                 uint16_t min_interval, uint16_t max_interval, const config_t &config)
+{
+    return send_command(true, node_ids, node_count, attr_paths, event_paths, min_interval, max_interval, config);
+}
+
+} // namespace fanout
+} // namespace controller
+} // namespace esp_matter
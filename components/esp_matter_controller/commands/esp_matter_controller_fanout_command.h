@@ -0,0 +1,140 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_controller_read_command.h>
+#include <esp_matter_controller_subscribe_command.h>
+#include <esp_matter_controller_utils.h>
+#include <functional>
+#include <lib/support/ScopedBuffer.h>
+
+namespace esp_matter {
+namespace controller {
+/** Read and subscribe interactions sent to a set of nodes
+ *
+ * The nodes are handled through a window of at most max_in_flight nodes at a time: a node enters the window when its
+ * CASE session is requested and leaves it when its read is done, when its subscription is established, or when it
+ * fails. The sessions already established with a node are reused by the CASE session manager. So the time of a fleet
+ * refresh depends on the size of the window instead of the number of nodes, without opening hundreds of sessions at
+ * once.
+ */
+namespace fanout {
+
+/** Result of a node */
+typedef struct {
+    uint64_t node_id;
+    /* ESP_OK when the read is done or the subscription established */
+    esp_err_t err;
+    CHIP_ERROR chip_err;
+    uint32_t subscription_id;
+    uint32_t attribute_count;
+    uint32_t event_count;
+    /* Time from the start of the fan-out to the start of the node */
+    int64_t start_time_us;
+    /* Time from the start of the node to its result */
+    int64_t time_us;
+} node_result_t;
+
+/** Statistics of a fan-out */
+typedef struct {
+    size_t node_count;
+    size_t succeeded;
+    size_t failed;
+    /* Largest number of nodes in flight at the same time */
+    size_t max_in_flight;
+    int64_t total_time_us;
+    int64_t min_node_time_us;
+    int64_t max_node_time_us;
+    int64_t avg_node_time_us;
+} stats_t;
+
+/** Called once all the nodes have a result, the results are in the order of the node IDs */
+using done_cb_t = std::function<void(const node_result_t *results, size_t result_count, const stats_t &stats)>;
+
+typedef struct config {
+    /* Maximum number of nodes in flight */
+    size_t max_in_flight;
+    /* Called for every attribute report of every node */
+    attribute_report_cb_t attribute_cb;
+    /* Called for every event report of every node */
+    event_report_cb_t event_cb;
+    done_cb_t done_cb;
+    config() : max_in_flight(CONFIG_ESP_MATTER_CONTROLLER_FANOUT_MAX_IN_FLIGHT) {}
+} config_t;
+
+/** Callbacks of the read or of the subscription of a node */
+typedef struct {
+    attribute_report_cb_t attribute_cb;
+    event_report_cb_t event_cb;
+    on_connect_failure_cb_t connect_failure_cb;
+    /* Read, error_cb is called before read_done_cb when the read fails */
+    read_command::on_error_callback error_cb;
+    read_command::read_done_cb_t read_done_cb;
+    /* Subscription */
+    subscribe_command::subscription_established_cb_t established_cb;
+    subscribe_command::subscription_terminated_cb_t terminated_cb;
+} node_callbacks_t;
+
+/** Sends the read or the subscription of a node, the callbacks may be called before it returns. None of them is
+ *  called when it returns an error.
+ */
+using node_sender_t = std::function<esp_err_t(uint64_t node_id, bool subscribe, const node_callbacks_t &callbacks)>;
+
+/** Replace the sending of the commands of the nodes, e.g. with a fake session path in the tests
+ *
+ * @param[in] sender The sender, nullptr to send a read_command or a subscribe_command to every node
+ */
+void set_node_sender(node_sender_t sender);
+
+/** Read the same paths on a set of nodes
+ *
+ * @param[in] node_ids Remote NodeIds, the array is copied
+ * @param[in] node_count Number of nodes
+ * @param[in] attr_paths Attribute paths to read on every node, the paths are copied
+ * @param[in] event_paths Event paths to read on every node, the paths are copied
+ * @param[in] config Window size and callbacks
+ *
+ * @return ESP_OK on success, the result of every node is given to config.done_cb.
+ * @return error in case of failure.
+ */
+esp_err_t send_read_command(const uint64_t *node_ids, size_t node_count,
+                            const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                            const ScopedMemoryBufferWithSize<EventPathParams> &event_paths, const config_t &config);
+
+/** Subscribe the same paths on a set of nodes
+ *
+ * The subscriptions stay alive after config.done_cb is called, the attribute and event callbacks keep receiving their
+ * reports.
+ *
+ * @param[in] node_ids Remote NodeIds, the array is copied
+ * @param[in] node_count Number of nodes
+ * @param[in] attr_paths Attribute paths to subscribe on every node, the paths are copied
+ * @param[in] event_paths Event paths to subscribe on every node, the paths are copied
+ * @param[in] min_interval Minimum interval of the subscriptions
+ * @param[in] max_interval Maximum interval of the subscriptions
+ * @param[in] config Window size and callbacks
+ *
+ * @return ESP_OK on success, the result of every node is given to config.done_cb.
+ * @return error in case of failure.
+ */
+esp_err_t send_subscribe_command(const uint64_t *node_ids, size_t node_count,
+                                 const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                                 const ScopedMemoryBufferWithSize<EventPathParams> &event_paths,
+                                 uint16_t min_interval, uint16_t max_interval, const config_t &config);
+
+} // namespace fanout
+} // namespace controller
+} // namespace esp_matter
@@ -15,13 +15,13 @@
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_log.h>
 #include <esp_matter_client.h>
+#include <esp_matter_client_cache.h>
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_read_command.h>
+#include <esp_matter_controller_report_log.h>
 
 #include <app/server/Server.h>
 
-#include <commands/clusters/DataModelLogger.h>
-
 using namespace chip::app::Clusters;
 using namespace esp_matter::client;
 using chip::DeviceProxy;
@@ -43,6 +43,13 @@ void read_command::on_device_connected_fcn(void *context, ExchangeManager &excha
                                                     cmd->m_attr_paths.AllocatedSize(), cmd->m_event_paths.Get(),
                                                     cmd->m_event_paths.AllocatedSize(), cmd->m_buffered_read_cb);
     if (err != ESP_OK) {
+        // The read is done without any report
+        if (cmd->m_on_error_cb) {
+            cmd->m_on_error_cb(cmd->m_node_id, CHIP_ERROR_INTERNAL);
+        }
+        if (cmd->read_done_cb) {
+            cmd->read_done_cb(cmd->m_node_id, cmd->m_attr_paths, cmd->m_event_paths);
+        }
         chip::Platform::Delete(cmd);
     }
     return;
@@ -90,6 +97,9 @@ esp_err_t read_command::send_command()
 void read_command::OnAttributeData(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
                                    const chip::app::StatusIB &status)
 {
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+    cache::update_attribute(m_node_id, path, data, status);
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
     if (attribute_data_cb) {
         chip::TLV::TLVReader data_cpy;
         if (data == nullptr) {
@@ -100,20 +110,17 @@ void read_command::OnAttributeData(const chip::app::ConcreteDataAttributePath &p
         }
     }
 
-    CHIP_ERROR error = status.ToChipError();
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
-        return;
-    }
-    error = DataModelLogger::LogAttribute(path, data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
-    }
+    report_log::log_attribute(m_node_id, path, data, status);
 }
 
 void read_command::OnEventData(const chip::app::EventHeader &event_header, chip::TLV::TLVReader *data,
                                const chip::app::StatusIB *status)
 {
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+    if (status == nullptr || status->IsSuccess()) {
+        cache::update_event(m_node_id, event_header);
+    }
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
     if (event_data_cb) {
         chip::TLV::TLVReader data_cpy;
         if (data == nullptr) {
@@ -124,20 +131,14 @@ void read_command::OnEventData(const chip::app::EventHeader &event_header, chip:
         }
     }
 
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    if (status != nullptr) {
-        error = status->ToChipError();
-        if (CHIP_NO_ERROR != error) {
-            ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
-            return;
-        }
-    }
-    if (data) {
-        error = DataModelLogger::LogEvent(event_header, data);
-    }
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
-    }
+    report_log::log_event(m_node_id, event_header, data, status);
+}
+
+void read_command::OnReportEnd()
+{
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+    cache::end_report(m_node_id, chip::Span<AttributePathParams>(m_attr_paths.Get(), m_attr_paths.AllocatedSize()));
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
 }
 
 void read_command::OnError(CHIP_ERROR error)
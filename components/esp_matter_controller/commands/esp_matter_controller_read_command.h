@@ -109,6 +109,8 @@ public:
     void OnEventData(const chip::app::EventHeader &event_header, chip::TLV::TLVReader *data,
                      const chip::app::StatusIB *status) override;
 
+    void OnReportEnd() override;
+
     void OnError(CHIP_ERROR error) override;
 
     void OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepareParams) override;
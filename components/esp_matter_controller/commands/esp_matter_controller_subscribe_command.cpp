@@ -16,10 +16,11 @@
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_log.h>
 #include <esp_matter_client.h>
+#include <esp_matter_client_cache.h>
 #include <esp_matter_controller_client.h>
+#include <esp_matter_controller_report_log.h>
 #include <esp_matter_controller_subscribe_command.h>
-
-#include <commands/clusters/DataModelLogger.h>
+#include <esp_timer.h>
 
 using namespace chip::app::Clusters;
 using namespace esp_matter::client;
@@ -35,16 +36,40 @@ static const uint8_t k_max_resubscribe_retries = 2;
 namespace esp_matter {
 namespace controller {
 
+subscribe_command *subscribe_command::s_first = nullptr;
+
+subscribe_command::~subscribe_command()
+{
+    if (!m_registered) {
+        return;
+    }
+    for (subscribe_command **cur = &s_first; *cur; cur = &(*cur)->m_next) {
+        if (*cur == this) {
+            *cur = m_next;
+            break;
+        }
+    }
+}
+
 void subscribe_command::on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                                 const SessionHandle &sessionHandle)
 {
     subscribe_command *cmd = (subscribe_command *)context;
+    if (!cmd->m_registered) {
+        cmd->m_next = s_first;
+        s_first = cmd;
+        cmd->m_registered = true;
+    }
     chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
     esp_err_t err = interaction::subscribe::send_request(
                         &device_proxy, cmd->m_attr_paths.Get(), cmd->m_attr_paths.AllocatedSize(), cmd->m_event_paths.Get(),
                         cmd->m_event_paths.AllocatedSize(), cmd->m_min_interval, cmd->m_max_interval, cmd->m_keep_subscription,
                         cmd->m_auto_resubscribe, cmd->m_buffered_read_cb);
     if (err != ESP_OK) {
+        // The subscription ends before being established
+        if (cmd->subscription_terminated_cb) {
+            cmd->subscription_terminated_cb(cmd->m_node_id, 0);
+        }
         chip::Platform::Delete(cmd);
     }
     return;
@@ -64,6 +89,7 @@ void subscribe_command::on_device_connection_failure_fcn(void *context, const Sc
 
 esp_err_t subscribe_command::send_command()
 {
+    m_stats.start_time_us = esp_timer_get_time();
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
     chip::Server *server = &(chip::Server::GetInstance());
     server->GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(m_node_id, get_fabric_index()),
@@ -93,6 +119,14 @@ esp_err_t subscribe_command::send_command()
 void subscribe_command::OnAttributeData(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
                                         const chip::app::StatusIB &status)
 {
+    int64_t start_time_us = esp_timer_get_time();
+    m_stats.attribute_count++;
+    if (data) {
+        m_stats.byte_count += report_log::get_encoded_size(*data);
+    }
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+    cache::update_attribute(m_node_id, path, data, status);
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
     if (attribute_data_cb) {
         chip::TLV::TLVReader data_cpy;
         if (data == nullptr) {
@@ -103,20 +137,23 @@ void subscribe_command::OnAttributeData(const chip::app::ConcreteDataAttributePa
         }
     }
 
-    CHIP_ERROR error = status.ToChipError();
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
-        return;
-    }
-    error = DataModelLogger::LogAttribute(path, data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
-    }
+    report_log::log_attribute(m_node_id, path, data, status);
+    add_callback_time(start_time_us);
 }
 
 void subscribe_command::OnEventData(const chip::app::EventHeader &event_header, chip::TLV::TLVReader *data,
                                     const chip::app::StatusIB *status)
 {
+    int64_t start_time_us = esp_timer_get_time();
+    m_stats.event_count++;
+    if (data) {
+        m_stats.byte_count += report_log::get_encoded_size(*data);
+    }
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+    if (status == nullptr || status->IsSuccess()) {
+        cache::update_event(m_node_id, event_header);
+    }
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
     if (event_data_cb) {
         chip::TLV::TLVReader data_cpy;
         if (data == nullptr) {
@@ -127,19 +164,16 @@ void subscribe_command::OnEventData(const chip::app::EventHeader &event_header,
         }
     }
 
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    if (status != nullptr) {
-        error = status->ToChipError();
-        if (CHIP_NO_ERROR != error) {
-            ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
-            return;
-        }
-    }
-    if (data) {
-        error = DataModelLogger::LogEvent(event_header, data);
-    }
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+    report_log::log_event(m_node_id, event_header, data, status);
+    add_callback_time(start_time_us);
+}
+
+void subscribe_command::add_callback_time(int64_t start_time_us)
+{
+    int64_t time_us = esp_timer_get_time() - start_time_us;
+    m_stats.callback_time_us += time_us;
+    if (time_us > m_stats.max_callback_time_us) {
+        m_stats.max_callback_time_us = time_us;
     }
 }
 
@@ -177,6 +211,37 @@ CHIP_ERROR subscribe_command::OnResubscriptionNeeded(ReadClient *apReadClient, C
     return apReadClient->DefaultResubscribePolicy(aTerminationCause);
 }
 
+void subscribe_command::OnReportEnd()
+{
+    m_stats.report_count++;
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+    cache::end_report(m_node_id, chip::Span<AttributePathParams>(m_attr_paths.Get(), m_attr_paths.AllocatedSize()));
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+}
+
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+
+CHIP_ERROR subscribe_command::OnUpdateDataVersionFilterList(
+    chip::app::DataVersionFilterIBs::Builder &aDataVersionFilterIBsBuilder,
+    const chip::Span<AttributePathParams> &aAttributePaths, bool &aEncodedDataVersionList)
+{
+    // The clusters unchanged since the last report are not reported again when re-subscribing
+    return cache::encode_data_version_filters(m_node_id, aDataVersionFilterIBsBuilder, aAttributePaths,
+                                              aEncodedDataVersionList);
+}
+
+CHIP_ERROR subscribe_command::GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &aEventNumber)
+{
+    chip::EventNumber event_number;
+    if (cache::get_highest_event_number(m_node_id, event_number) == ESP_OK) {
+        aEventNumber.SetValue(event_number);
+    } else {
+        aEventNumber.ClearValue();
+    }
+    return CHIP_NO_ERROR;
+}
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+
 void subscribe_command::OnDone(ReadClient *apReadClient)
 {
     ESP_LOGI(TAG, "Subscription 0x%" PRIx32 " Done for remote node 0x%" PRIx64, m_subscription_id, m_node_id);
@@ -187,6 +252,21 @@ void subscribe_command::OnDone(ReadClient *apReadClient)
     chip::Platform::Delete(this);
 }
 
+size_t for_each_subscription_stats(uint64_t node_id, const subscription_stats_cb_t &cb)
+{
+    size_t count = 0;
+    for (subscribe_command *cmd = subscribe_command::s_first; cmd; cmd = cmd->m_next) {
+        if (node_id != chip::kUndefinedNodeId && cmd->m_node_id != node_id) {
+            continue;
+        }
+        if (cb) {
+            cb(cmd->m_node_id, cmd->m_subscription_id, cmd->m_stats);
+        }
+        count++;
+    }
+    return count;
+}
+
 esp_err_t send_subscribe_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
                                       ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
                                       ScopedMemoryBufferWithSize<uint32_t> &attribute_ids, uint16_t min_interval,
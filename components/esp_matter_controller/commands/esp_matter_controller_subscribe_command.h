@@ -19,6 +19,7 @@
 #include <esp_matter.h>
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
+#include <functional>
 
 namespace esp_matter {
 namespace controller {
@@ -38,11 +39,25 @@ typedef enum {
     SUBSCRIBE_EVENT,
 } subscribe_command_type_t;
 
+/** Counters of the reports received by a subscription */
+typedef struct {
+    uint32_t report_count;
+    uint32_t attribute_count;
+    uint32_t event_count;
+    /* Encoded size of the attribute and event data */
+    uint64_t byte_count;
+    /* Time spent in the report callbacks and in the logging of the reports */
+    int64_t callback_time_us;
+    int64_t max_callback_time_us;
+    /* Time at which the subscription was requested */
+    int64_t start_time_us;
+} subscription_stats_t;
+
 /** Subscribe command class to send a subscribe interaction command to a server **/
 class subscribe_command : public ReadClient::Callback {
 public:
-    using subscription_established_cb_t = void (*)(uint64_t remote_node_id, uint32_t subscription_id);
-    using subscription_terminated_cb_t = void (*)(uint64_t remote_node_id, uint32_t subscription_id);
+    using subscription_established_cb_t = std::function<void(uint64_t remote_node_id, uint32_t subscription_id)>;
+    using subscription_terminated_cb_t = std::function<void(uint64_t remote_node_id, uint32_t subscription_id)>;
     /** Constructor for command with multiple paths**/
     subscribe_command(uint64_t node_id, ScopedMemoryBufferWithSize<AttributePathParams> &&attr_paths,
                       ScopedMemoryBufferWithSize<EventPathParams> &&event_paths, uint16_t min_interval,
@@ -162,7 +177,7 @@ public:
         }
     }
 
-    ~subscribe_command() {}
+    ~subscribe_command();
 
     esp_err_t send_command();
 
@@ -183,6 +198,16 @@ public:
 
     CHIP_ERROR OnResubscriptionNeeded(ReadClient *apReadClient, CHIP_ERROR aTerminationCause) override;
 
+    void OnReportEnd() override;
+
+#ifdef CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+    CHIP_ERROR OnUpdateDataVersionFilterList(chip::app::DataVersionFilterIBs::Builder &aDataVersionFilterIBsBuilder,
+                                             const chip::Span<AttributePathParams> &aAttributePaths,
+                                             bool &aEncodedDataVersionList) override;
+
+    CHIP_ERROR GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &aEventNumber) override;
+#endif // CONFIG_ESP_MATTER_CLIENT_ATTRIBUTE_CACHE
+
     uint32_t get_subscription_id()
     {
         return m_subscription_id;
@@ -193,6 +218,11 @@ public:
         return m_node_id;
     }
 
+    const subscription_stats_t &get_stats()
+    {
+        return m_stats;
+    }
+
 private:
     uint64_t m_node_id;
     uint16_t m_min_interval;
@@ -204,6 +234,15 @@ private:
     uint8_t m_resubscribe_retries = 0;
     ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
     ScopedMemoryBufferWithSize<EventPathParams> m_event_paths;
+    subscription_stats_t m_stats = {};
+    bool m_registered = false;
+    subscribe_command *m_next = nullptr;
+    /* The subscribe commands connected to their node */
+    static subscribe_command *s_first;
+    friend size_t for_each_subscription_stats(uint64_t node_id, const std::function<void(uint64_t, uint32_t,
+                                              const subscription_stats_t &)> &cb);
+
+    void add_callback_time(int64_t start_time_us);
 
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
@@ -218,6 +257,21 @@ private:
     on_connect_failure_cb_t on_connect_failure_cb;
 };
 
+/** Called for every subscription by for_each_subscription_stats() */
+using subscription_stats_cb_t =
+    std::function<void(uint64_t node_id, uint32_t subscription_id, const subscription_stats_t &stats)>;
+
+/** Get the counters of the subscriptions
+ *
+ * @note This function has to be called with the Matter stack locked.
+ *
+ * @param[in] node_id Remote NodeId, chip::kUndefinedNodeId for the subscriptions of all the nodes
+ * @param[in] cb Called for every subscription
+ *
+ * @return Number of subscriptions given to the callback.
+ */
+size_t for_each_subscription_stats(uint64_t node_id, const subscription_stats_cb_t &cb);
+
 /** Send subscribe command with multiple attribute paths
  *
  * @note The three arrays should has the same size and the order of the three arrays should be the same as
@@ -113,6 +113,20 @@ esp_err_t send_write_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<u
                                   ScopedMemoryBufferWithSize<uint32_t> &attribute_ids, const char *attr_val_json_str,
                                   chip::Optional<uint16_t> timed_write_timeout_ms)
 {
+    return send_write_attr_command(node_id, endpoint_ids, cluster_ids, attribute_ids,
+                                   multiple_write_encodable_type(attr_val_json_str), timed_write_timeout_ms);
+}
+
+esp_err_t send_write_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
+                                  ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
+                                  ScopedMemoryBufferWithSize<uint32_t> &attribute_ids,
+                                  const multiple_write_encodable_type &attr_vals,
+                                  chip::Optional<uint16_t> timed_write_timeout_ms)
+{
+    if (!attr_vals.is_valid()) {
+        ESP_LOGE(TAG, "The attribute values are not a valid encoding");
+        return ESP_ERR_INVALID_ARG;
+    }
     if (endpoint_ids.AllocatedSize() != cluster_ids.AllocatedSize() ||
             endpoint_ids.AllocatedSize() != attribute_ids.AllocatedSize()) {
         ESP_LOGE(TAG,
@@ -132,7 +146,7 @@ esp_err_t send_write_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<u
     }
 
     write_command *cmd =
-        chip::Platform::New<write_command>(node_id, std::move(attr_paths), attr_val_json_str, timed_write_timeout_ms);
+        chip::Platform::New<write_command>(node_id, std::move(attr_paths), attr_vals, timed_write_timeout_ms);
     if (!cmd) {
         ESP_LOGE(TAG, "Failed to alloc memory for read_command");
         return ESP_ERR_NO_MEM;
@@ -51,10 +51,23 @@ public:
                   on_success_callback write_success_cb = nullptr,
                   on_error_callback write_fail_cb = nullptr,
                   on_write_done_callback write_done_cb = nullptr)
+        : write_command(node_id, std::move(attr_paths), multiple_write_encodable_type(attribute_val_str),
+                        timed_write_timeout_ms, connect_fail_cb, write_success_cb, write_fail_cb, write_done_cb)
+    {
+    }
+
+    /** Constructor for command with multiple paths and attribute values compiled from JSON**/
+    write_command(uint64_t node_id, ScopedMemoryBufferWithSize<AttributePathParams> &&attr_paths,
+                  const multiple_write_encodable_type &attr_vals,
+                  const chip::Optional<uint16_t> timed_write_timeout_ms = chip::NullOptional,
+                  on_connect_failure_cb_t connect_fail_cb = nullptr,
+                  on_success_callback write_success_cb = nullptr,
+                  on_error_callback write_fail_cb = nullptr,
+                  on_write_done_callback write_done_cb = nullptr)
         : m_node_id(node_id)
         , m_attr_paths(std::move(attr_paths))
         , m_chunked_callback(this)
-        , m_attr_vals(attribute_val_str)
+        , m_attr_vals(attr_vals)
         , m_timed_write_timeout_ms(timed_write_timeout_ms)
         , on_device_connected_cb(on_device_connected_fcn, this)
         , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
@@ -73,9 +86,22 @@ public:
                   on_success_callback write_success_cb = nullptr,
                   on_error_callback write_fail_cb = nullptr,
                   on_write_done_callback write_done_cb = nullptr)
+        : write_command(node_id, endpoint_id, cluster_id, attribute_id, multiple_write_encodable_type(attribute_val_str),
+                        timed_write_timeout_ms, connect_fail_cb, write_success_cb, write_fail_cb, write_done_cb)
+    {
+    }
+
+    /** Constructor for command with an attribute path and an attribute value compiled from JSON**/
+    write_command(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                  const multiple_write_encodable_type &attr_vals,
+                  const chip::Optional<uint16_t> timed_write_timeout_ms = chip::NullOptional,
+                  on_connect_failure_cb_t connect_fail_cb = nullptr,
+                  on_success_callback write_success_cb = nullptr,
+                  on_error_callback write_fail_cb = nullptr,
+                  on_write_done_callback write_done_cb = nullptr)
         : m_node_id(node_id)
         , m_chunked_callback(this)
-        , m_attr_vals(attribute_val_str)
+        , m_attr_vals(attr_vals)
         , m_timed_write_timeout_ms(timed_write_timeout_ms)
         , on_device_connected_cb(on_device_connected_fcn, this)
         , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
@@ -181,5 +207,26 @@ esp_err_t send_write_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<u
                                   ScopedMemoryBufferWithSize<uint32_t> &attribute_ids, const char *attr_val_json_str,
                                   chip::Optional<uint16_t> timed_write_timeout_ms = chip::NullOptional);
 
+/** Send write attribute command with attribute values compiled from JSON
+ *
+ * The attribute values are not converted again, so the same multiple_write_encodable_type can be written to many
+ * nodes and on every retry.
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] endpoint_ids EndpointIds
+ * @param[in] cluster_ids ClusterIds
+ * @param[in] attribute_ids AttributeIds
+ * @param[in] attr_vals Attribute values compiled from a JSON string, one for each attribute path
+ * @param[in] timed_write_timeout_ms Timeout in millisecond for timed-write attributes
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t send_write_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
+                                  ScopedMemoryBufferWithSize<uint32_t> &cluster_ids,
+                                  ScopedMemoryBufferWithSize<uint32_t> &attribute_ids,
+                                  const multiple_write_encodable_type &attr_vals,
+                                  chip::Optional<uint16_t> timed_write_timeout_ms = chip::NullOptional);
+
 } // namespace controller
 } // namespace esp_matter
@@ -17,17 +17,23 @@
 
 #include <inttypes.h>
 #include <esp_check.h>
+#include <esp_timer.h>
 #include <esp_matter_controller_client.h>
 #include <esp_matter_controller_cluster_command.h>
 #include <esp_matter_controller_commissioning_window_opener.h>
 #include <esp_matter_controller_console.h>
+#include <esp_matter_controller_fanout_command.h>
 #include <esp_matter_controller_group_settings.h>
 #include <esp_matter_controller_icd_client.h>
 #include <esp_matter_controller_pairing_command.h>
 #include <esp_matter_controller_read_command.h>
+#include <esp_matter_controller_report_log.h>
 #include <esp_matter_controller_subscribe_command.h>
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_controller_write_command.h>
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+#include <esp_matter_da_revocation_cache.h>
+#endif
 #include <lib/core/CHIPCore.h>
 #include <lib/shell/Commands.h>
 #include <lib/shell/Engine.h>
@@ -96,6 +102,39 @@ static esp_err_t string_to_uint32_array(const char *str, ScopedMemoryBufferWithS
     return ESP_OK;
 }
 
+static esp_err_t string_to_uint64_array(const char *str, ScopedMemoryBufferWithSize<uint64_t> &uint64_array)
+{
+    size_t array_len = get_array_size(str);
+    if (array_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint64_array.Calloc(array_len);
+    if (!uint64_array.Get()) {
+        return ESP_ERR_NO_MEM;
+    }
+    char number[21]; // max(strlen("0xFFFFFFFFFFFFFFFF"), strlen("18446744073709551615")) + 1
+    const char *next_number_start = str;
+    char *next_number_end = NULL;
+    size_t next_number_len = 0;
+    for (size_t i = 0; i < array_len; ++i) {
+        next_number_end = strchr(next_number_start, ',');
+        if (next_number_end > next_number_start) {
+            next_number_len = std::min((size_t)(next_number_end - next_number_start), sizeof(number) - 1);
+        } else if (i == array_len - 1) {
+            next_number_len = strnlen(next_number_start, sizeof(number) - 1);
+        } else {
+            return ESP_ERR_INVALID_ARG;
+        }
+        strncpy(number, next_number_start, next_number_len);
+        number[next_number_len] = 0;
+        uint64_array[i] = string_to_uint64(number);
+        if (next_number_end > next_number_start) {
+            next_number_start = next_number_end + 1;
+        }
+    }
+    return ESP_OK;
+}
+
 esp_err_t string_to_uint16_array(const char *str, ScopedMemoryBufferWithSize<uint16_t> &uint16_array)
 {
     size_t array_len = get_array_size(str);
@@ -324,6 +363,21 @@ static esp_err_t controller_udc_handler(int argc, char **argv)
     return ESP_OK;
 }
 #endif // CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY
+
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+static esp_err_t controller_crl_cache_handler(int argc, char **argv)
+{
+    if (argc != 1 || strncmp(argv[0], "clear", sizeof("clear")) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // The cache is used by the revocation check of the commissioning, in the CHIP task
+    chip::DeviceLayer::PlatformMgr().LockChipStack();
+    controller::attestation_verification::crl_revocation_cache::get_instance().clear();
+    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+    ESP_LOGI(TAG, "Cleared the CRL cache");
+    return ESP_OK;
+}
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
 #endif // CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 
 #ifndef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
@@ -457,6 +511,42 @@ static esp_err_t controller_read_attr_handler(int argc, char **argv)
     return controller::send_read_attr_command(node_id, endpoint_ids, cluster_ids, attribute_ids);
 }
 
+static esp_err_t controller_fanout_read_attr_handler(int argc, char **argv)
+{
+    if (argc < 4) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ScopedMemoryBufferWithSize<uint64_t> node_ids;
+    ScopedMemoryBufferWithSize<uint16_t> endpoint_ids;
+    ScopedMemoryBufferWithSize<uint32_t> cluster_ids;
+    ScopedMemoryBufferWithSize<uint32_t> attribute_ids;
+    ESP_RETURN_ON_ERROR(string_to_uint64_array(argv[0], node_ids), TAG, "Failed to parse node IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint16_array(argv[1], endpoint_ids), TAG, "Failed to parse endpoint IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint32_array(argv[2], cluster_ids), TAG, "Failed to parse cluster IDs");
+    ESP_RETURN_ON_ERROR(string_to_uint32_array(argv[3], attribute_ids), TAG, "Failed to parse attribute IDs");
+    if (endpoint_ids.AllocatedSize() != cluster_ids.AllocatedSize() ||
+            endpoint_ids.AllocatedSize() != attribute_ids.AllocatedSize()) {
+        ESP_LOGE(TAG, "The endpoint-ids, cluster-ids and attr-ids should have the same length");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+    attr_paths.Alloc(endpoint_ids.AllocatedSize());
+    ESP_RETURN_ON_FALSE(attr_paths.Get(), ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for attribute paths");
+    for (size_t i = 0; i < attr_paths.AllocatedSize(); ++i) {
+        attr_paths[i] = AttributePathParams(endpoint_ids[i], cluster_ids[i], attribute_ids[i]);
+    }
+
+    controller::fanout::config_t config;
+    if (argc > 4) {
+        config.max_in_flight = string_to_uint16(argv[4]);
+    }
+    return controller::fanout::send_read_command(node_ids.Get(), node_ids.AllocatedSize(), attr_paths, event_paths,
+                                                 config);
+}
+
 static esp_err_t controller_write_attr_handler(int argc, char **argv)
 {
     if (argc < 5) {
@@ -589,6 +679,45 @@ static esp_err_t controller_shutdown_all_subscriptions_handler(int argc, char **
     return ESP_OK;
 }
 
+static esp_err_t controller_report_log_handler(int argc, char **argv)
+{
+    if (argc > 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (argc == 1) {
+        controller::report_log::log_mode_t mode;
+        ESP_RETURN_ON_ERROR(controller::report_log::mode_from_name(argv[0], mode), TAG, "Unknown mode %s", argv[0]);
+        ESP_RETURN_ON_ERROR(controller::report_log::set_mode(mode), TAG, "Failed to set the mode");
+    }
+    ESP_LOGI(TAG, "Report logging mode: %s", controller::report_log::mode_to_name(controller::report_log::get_mode()));
+    return ESP_OK;
+}
+
+static esp_err_t controller_subscription_stats_handler(int argc, char **argv)
+{
+    if (argc > 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint64_t node_id = argc == 1 ? string_to_uint64(argv[0]) : chip::kUndefinedNodeId;
+    int64_t now = esp_timer_get_time();
+    ESP_LOGI(TAG, "%-18s %-10s %8s %8s %8s %8s %10s %8s %10s %10s", "node", "subs-id", "reports", "rep/s", "attrs",
+             "events", "bytes", "B/s", "avg-cb-us", "max-cb-us");
+    chip::DeviceLayer::PlatformMgr().LockChipStack();
+    size_t count = controller::for_each_subscription_stats(
+    node_id, [now](uint64_t node, uint32_t subscription_id, const controller::subscription_stats_t & stats) {
+        int64_t elapsed_us = std::max<int64_t>(now - stats.start_time_us, 1);
+        uint32_t data_count = stats.attribute_count + stats.event_count;
+        ESP_LOGI(TAG, "0x%016" PRIx64 " 0x%08" PRIx32 " %8" PRIu32 " %8.2f %8" PRIu32 " %8" PRIu32 " %10" PRIu64
+                 " %8.1f %10" PRId64 " %10" PRId64, node, subscription_id, stats.report_count,
+                 stats.report_count * 1e6 / elapsed_us, stats.attribute_count, stats.event_count, stats.byte_count,
+                 stats.byte_count * 1e6 / elapsed_us, data_count ? stats.callback_time_us / data_count : 0,
+                 stats.max_callback_time_us);
+    });
+    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+    ESP_LOGI(TAG, "%u subscription(s)", static_cast<unsigned>(count));
+    return ESP_OK;
+}
+
 static esp_err_t controller_icd_list_handler(int argc, char **argv)
 {
     if (argc != 1 || strncmp(argv[0], "list", sizeof("list")) != 0) {
@@ -646,6 +775,14 @@ esp_err_t controller_register_commands()
             .handler = controller_udc_handler,
         },
 #endif
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+        {
+            .name = "crl-cache",
+            .description = "Remove the CRLs cached for the DA revocation check from RAM and NVS.\n"
+            "\tUsage: controller crl-cache clear",
+            .handler = controller_crl_cache_handler,
+        },
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
 #endif // CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 #ifndef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
         {
@@ -690,6 +827,14 @@ esp_err_t controller_register_commands()
             "And the same applies to cluster-ids, attr-ids, and event-ids.",
             .handler = controller_read_attr_handler,
         },
+        {
+            .name = "fanout-read-attr",
+            .description = "Read attributes of a set of nodes, with a bounded number of nodes in flight.\n"
+            "\tUsage: controller fanout-read-attr <node-ids> <endpoint-ids> <cluster-ids> <attr-ids> [max-in-flight]\n"
+            "\tNotes: node-ids can represent a single or multiple nodes, e.g. '0x1' or '0x1,0x2'. The paths are read "
+            "on every node. max-in-flight defaults to CONFIG_ESP_MATTER_CONTROLLER_FANOUT_MAX_IN_FLIGHT.",
+            .handler = controller_fanout_read_attr_handler,
+        },
         {
             .name = "write-attr",
             .description =
@@ -742,6 +887,20 @@ esp_err_t controller_register_commands()
             "\tUsage: controller shutdown-all-subss",
             .handler = controller_shutdown_all_subscriptions_handler,
         },
+        {
+            .name = "subs-stats",
+            .description = "Print the counters of the subscriptions.\n"
+            "\tUsage: controller subs-stats [node-id]\n"
+            "\tNotes: The rates are averaged since the subscriptions were requested, the callback latency includes "
+            "the logging of the reports",
+            .handler = controller_subscription_stats_handler,
+        },
+        {
+            .name = "report-log",
+            .description = "Get or set the logging mode of the attribute and event reports.\n"
+            "\tUsage: controller report-log [off|compact|json|pretty]",
+            .handler = controller_report_log_handler,
+        },
     };
 
     const static command_t controller_command = {
@@ -0,0 +1,272 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <esp_log.h>
+#include <esp_matter_controller_report_log.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <tlv_to_json.h>
+
+#include <commands/clusters/DataModelLogger.h>
+
+using chip::TLV::TLVReader;
+
+static const char *TAG = "report_log";
+
+namespace esp_matter {
+namespace controller {
+namespace report_log {
+
+/* Number of TLV bytes printed by the compact mode */
+static constexpr size_t k_compact_max_bytes = 16;
+/* Size of the JSON text of a value printed by the json mode, the longer values are truncated */
+static constexpr size_t k_json_max_len = 256;
+
+/* Set from the console task and read from the Matter task */
+#if defined(CONFIG_ESP_MATTER_CONTROLLER_REPORT_LOG_DEFAULT_OFF)
+static std::atomic<log_mode_t> s_mode(MODE_OFF);
+#elif defined(CONFIG_ESP_MATTER_CONTROLLER_REPORT_LOG_DEFAULT_COMPACT)
+static std::atomic<log_mode_t> s_mode(MODE_COMPACT);
+#elif defined(CONFIG_ESP_MATTER_CONTROLLER_REPORT_LOG_DEFAULT_JSON)
+static std::atomic<log_mode_t> s_mode(MODE_JSON);
+#else
+static std::atomic<log_mode_t> s_mode(MODE_PRETTY);
+#endif
+
+static const char *const k_mode_names[] = {"off", "compact", "json", "pretty"};
+
+esp_err_t set_mode(log_mode_t mode)
+{
+    if (mode > MODE_PRETTY) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_mode.store(mode, std::memory_order_relaxed);
+    return ESP_OK;
+}
+
+log_mode_t get_mode()
+{
+    return s_mode.load(std::memory_order_relaxed);
+}
+
+esp_err_t mode_from_name(const char *name, log_mode_t &mode)
+{
+    if (!name) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < sizeof(k_mode_names) / sizeof(k_mode_names[0]); ++i) {
+        if (strcmp(name, k_mode_names[i]) == 0) {
+            mode = static_cast<log_mode_t>(i);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+const char *mode_to_name(log_mode_t mode)
+{
+    return mode <= MODE_PRETTY ? k_mode_names[mode] : "unknown";
+}
+
+/* Size of the control byte, the tag and the length or value field of an element */
+static uint32_t get_element_head_size(uint8_t control_byte)
+{
+    static const uint8_t k_tag_sizes[] = {0, 1, 2, 4, 2, 4, 6, 8};
+    uint32_t size = 1 + k_tag_sizes[control_byte >> 5];
+    uint8_t element_type = control_byte & 0x1F;
+    if (element_type <= 0x07 || (element_type >= 0x0C && element_type <= 0x13)) {
+        /* Integers, and the length field of the strings */
+        size += 1u << (element_type & 0x03);
+    } else if (element_type == 0x0A) {
+        size += 4;
+    } else if (element_type == 0x0B) {
+        size += 8;
+    }
+    return size;
+}
+
+uint32_t get_encoded_size(const TLVReader &data)
+{
+    if (data.GetType() == chip::TLV::kTLVType_NotSpecified) {
+        return 0;
+    }
+    /* The head of the element has been read by the reader, skipping the element reads its data without decoding it */
+    TLVReader reader;
+    reader.Init(data);
+    uint32_t head_size = get_element_head_size(reader.GetControlByte());
+    uint32_t head_end = reader.GetLengthRead();
+    if (reader.Skip() != CHIP_NO_ERROR) {
+        return 0;
+    }
+    return head_size + reader.GetLengthRead() - head_end;
+}
+
+void format_compact_value(const TLVReader &data, char *out, size_t out_size)
+{
+    TLVReader reader;
+    reader.Init(data);
+    switch (reader.GetType()) {
+    case chip::TLV::kTLVType_SignedInteger: {
+        int64_t value = 0;
+        reader.Get(value);
+        snprintf(out, out_size, "%" PRId64, value);
+        break;
+    }
+    case chip::TLV::kTLVType_UnsignedInteger: {
+        uint64_t value = 0;
+        reader.Get(value);
+        snprintf(out, out_size, "%" PRIu64, value);
+        break;
+    }
+    case chip::TLV::kTLVType_Boolean: {
+        bool value = false;
+        reader.Get(value);
+        snprintf(out, out_size, "%s", value ? "true" : "false");
+        break;
+    }
+    case chip::TLV::kTLVType_FloatingPointNumber: {
+        double value = 0;
+        reader.Get(value);
+        snprintf(out, out_size, "%g", value);
+        break;
+    }
+    case chip::TLV::kTLVType_Null:
+        snprintf(out, out_size, "null");
+        break;
+    case chip::TLV::kTLVType_UTF8String:
+    case chip::TLV::kTLVType_ByteString: {
+        uint32_t len = reader.GetLength();
+        const uint8_t *bytes = nullptr;
+        int pos = snprintf(out, out_size, "%s[%" PRIu32 "]", reader.GetType() == chip::TLV::kTLVType_ByteString ? "bytes" :
+                           "str", len);
+        // The bytes are only printed when they are in a contiguous buffer
+        if (reader.GetDataPtr(bytes) == CHIP_NO_ERROR && bytes && pos > 0 && static_cast<size_t>(pos) < out_size) {
+            size_t off = static_cast<size_t>(pos);
+            off += snprintf(out + off, out_size - off, " ");
+            for (uint32_t i = 0; i < len && i < k_compact_max_bytes && off + 3 <= out_size; ++i) {
+                off += snprintf(out + off, out_size - off, "%02x", bytes[i]);
+            }
+            if (len > k_compact_max_bytes && off + 4 <= out_size) {
+                snprintf(out + off, out_size - off, "...");
+            }
+        }
+        break;
+    }
+    case chip::TLV::kTLVType_Structure:
+        snprintf(out, out_size, "struct(%" PRIu32 " bytes)", get_encoded_size(reader));
+        break;
+    case chip::TLV::kTLVType_Array:
+        snprintf(out, out_size, "array(%" PRIu32 " bytes)", get_encoded_size(reader));
+        break;
+    case chip::TLV::kTLVType_List:
+        snprintf(out, out_size, "list(%" PRIu32 " bytes)", get_encoded_size(reader));
+        break;
+    default:
+        snprintf(out, out_size, "?");
+        break;
+    }
+}
+
+/* JSON text of a value, returns false if it is truncated */
+static bool format_json_value(const TLVReader &data, char *out, size_t out_size)
+{
+    TLVReader reader;
+    reader.Init(data);
+    esp_err_t err =
+        tlv_to_json_string(reader, out, out_size, nullptr, tlv_to_json_options { .human_readable_bytes = true });
+    if (err != ESP_OK && err != ESP_ERR_INVALID_SIZE) {
+        snprintf(out, out_size, "null");
+    }
+    return err != ESP_ERR_INVALID_SIZE;
+}
+
+void log_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path, const TLVReader *data,
+                   const chip::app::StatusIB &status)
+{
+    CHIP_ERROR error = status.ToChipError();
+    if (CHIP_NO_ERROR != error) {
+        ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
+        return;
+    }
+    log_mode_t mode = get_mode();
+    if (mode == MODE_OFF || !data) {
+        return;
+    }
+    if (mode == MODE_COMPACT) {
+        char value[2 * k_compact_max_bytes + 32];
+        format_compact_value(*data, value, sizeof(value));
+        ESP_LOGI(TAG, "0x%" PRIx64 " %u/0x%08" PRIx32 "/0x%08" PRIx32 " v%" PRIu32 " %s", node_id, path.mEndpointId,
+                 path.mClusterId, path.mAttributeId, path.mDataVersion.ValueOr(0), value);
+    } else if (mode == MODE_JSON) {
+        char value[k_json_max_len];
+        if (format_json_value(*data, value, sizeof(value))) {
+            ESP_LOGI(TAG, "{\"node\":%" PRIu64 ",\"endpoint\":%u,\"cluster\":%" PRIu32 ",\"attribute\":%" PRIu32
+                     ",\"value\":%s}", node_id, path.mEndpointId, path.mClusterId, path.mAttributeId, value);
+        } else {
+            ESP_LOGW(TAG, "{\"node\":%" PRIu64 ",\"endpoint\":%u,\"cluster\":%" PRIu32 ",\"attribute\":%" PRIu32
+                     ",\"value\":%s (truncated)", node_id, path.mEndpointId, path.mClusterId, path.mAttributeId, value);
+        }
+    } else {
+        TLVReader reader;
+        reader.Init(*data);
+        if (CHIP_NO_ERROR != DataModelLogger::LogAttribute(path, &reader)) {
+            ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+        }
+    }
+}
+
+void log_event(uint64_t node_id, const chip::app::EventHeader &header, const TLVReader *data,
+               const chip::app::StatusIB *status)
+{
+    if (status != nullptr) {
+        CHIP_ERROR error = status->ToChipError();
+        if (CHIP_NO_ERROR != error) {
+            ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
+            return;
+        }
+    }
+    log_mode_t mode = get_mode();
+    if (mode == MODE_OFF || !data) {
+        return;
+    }
+    if (mode == MODE_COMPACT) {
+        char value[2 * k_compact_max_bytes + 32];
+        format_compact_value(*data, value, sizeof(value));
+        ESP_LOGI(TAG, "0x%" PRIx64 " %u/0x%08" PRIx32 "/0x%08" PRIx32 " #%" PRIu64 " %s", node_id,
+                 header.mPath.mEndpointId, header.mPath.mClusterId, header.mPath.mEventId, header.mEventNumber, value);
+    } else if (mode == MODE_JSON) {
+        char value[k_json_max_len];
+        if (format_json_value(*data, value, sizeof(value))) {
+            ESP_LOGI(TAG, "{\"node\":%" PRIu64 ",\"endpoint\":%u,\"cluster\":%" PRIu32 ",\"event\":%" PRIu32
+                     ",\"number\":%" PRIu64 ",\"value\":%s}", node_id, header.mPath.mEndpointId,
+                     header.mPath.mClusterId, header.mPath.mEventId, header.mEventNumber, value);
+        } else {
+            ESP_LOGW(TAG, "{\"node\":%" PRIu64 ",\"endpoint\":%u,\"cluster\":%" PRIu32 ",\"event\":%" PRIu32
+                     ",\"number\":%" PRIu64 ",\"value\":%s (truncated)", node_id, header.mPath.mEndpointId,
+                     header.mPath.mClusterId, header.mPath.mEventId, header.mEventNumber, value);
+        }
+    } else {
+        TLVReader reader;
+        reader.Init(*data);
+        if (CHIP_NO_ERROR != DataModelLogger::LogEvent(header, &reader)) {
+            ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+        }
+    }
+}
+
+} // namespace report_log
+} // namespace controller
+} // namespace esp_matter
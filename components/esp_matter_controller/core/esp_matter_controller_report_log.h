@@ -0,0 +1,111 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/EventHeader.h>
+#include <app/MessageDef/StatusIB.h>
+#include <esp_err.h>
+#include <lib/core/TLVReader.h>
+
+namespace esp_matter {
+namespace controller {
+/** Logging of the attribute and event reports received by the read and subscribe commands
+ *
+ * Decoding and pretty-printing every report with the DataModelLogger costs more than receiving it, and printing it on
+ * the UART costs even more. So the reports can be logged in a lighter format, or not logged at all, when the controller
+ * handles a high rate of reports.
+ */
+namespace report_log {
+
+typedef enum {
+    /* The reports are not logged, only the failures are */
+    MODE_OFF = 0,
+    /* One text line per report with the path and the short form of the data given by format_compact_value(). It is
+     * logged like the other modes, there is no binary output. */
+    MODE_COMPACT,
+    /* One log line per report with the path and the data as JSON, the values longer than 256 characters are cut */
+    MODE_JSON,
+    /* The reports are decoded and printed by the DataModelLogger */
+    MODE_PRETTY,
+} log_mode_t;
+
+/** Set the logging mode of the reports
+ *
+ * @param[in] mode Logging mode
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the mode is unknown.
+ */
+esp_err_t set_mode(log_mode_t mode);
+
+/** Get the logging mode of the reports */
+log_mode_t get_mode();
+
+/** Parse the name of a logging mode: "off", "compact", "json" or "pretty"
+ *
+ * @param[in] name Name of the mode
+ * @param[out] mode Logging mode
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the name is unknown.
+ */
+esp_err_t mode_from_name(const char *name, log_mode_t &mode);
+
+/** Get the name of a logging mode */
+const char *mode_to_name(log_mode_t mode);
+
+/** Get the encoded size of the TLV element a reader is positioned on
+ *
+ * The size is given by the offsets of the element in the received data, the element is skipped but not decoded.
+ *
+ * @param[in] data Reader positioned on the element, the reader is not moved
+ *
+ * @return Size of the element in bytes, including its control byte and its tag.
+ */
+uint32_t get_encoded_size(const chip::TLV::TLVReader &data);
+
+/** Format the short form of a TLV element logged by the compact mode: the value of a scalar, the length and the first
+ *  bytes of a string, or the encoded size of a container
+ *
+ * @param[in] data Reader positioned on the element, the reader is not moved
+ * @param[out] out Buffer of the text, which is truncated to its size
+ * @param[in] out_size Size of the buffer
+ */
+void format_compact_value(const chip::TLV::TLVReader &data, char *out, size_t out_size);
+
+/** Log an attribute report according to the logging mode
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] path Path of the attribute
+ * @param[in] data Data of the attribute, the reader is not moved
+ * @param[in] status Status of the attribute
+ */
+void log_attribute(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path, const chip::TLV::TLVReader *data,
+                   const chip::app::StatusIB &status);
+
+/** Log an event report according to the logging mode
+ *
+ * @param[in] node_id Remote NodeId
+ * @param[in] header Header of the event
+ * @param[in] data Data of the event, the reader is not moved
+ * @param[in] status Status of the event, nullptr for a successful event
+ */
+void log_event(uint64_t node_id, const chip::app::EventHeader &header, const chip::TLV::TLVReader *data,
+               const chip::app::StatusIB *status);
+
+} // namespace report_log
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,288 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unity.h>
+
+#if defined(CONFIG_SPIFFS_ATTESTATION_TRUST_STORE) || defined(CONFIG_DCL_ATTESTATION_TRUST_STORE)
+#include <atomic>
+#include <esp_matter_attestation_trust_store.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <stdio.h>
+#include <string.h>
+#include <test_certs.h>
+
+#ifdef CONFIG_SPIFFS_ATTESTATION_TRUST_STORE
+#include <esp_spiffs.h>
+#endif
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE
+#include <dcl_pki_stand_in.h>
+#endif
+
+using namespace chip;
+using namespace chip::Credentials;
+using namespace esp_matter::test;
+
+static constexpr size_t k_lookup_task_count = 4;
+static constexpr size_t k_lookups_per_task = 10;
+static constexpr size_t k_paa_cert_count = 3;
+
+static test_cert_t s_paa_certs[k_paa_cert_count];
+
+static void generate_paa_certs()
+{
+    static bool s_generated = false;
+    if (!s_generated) {
+        TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test PAA A", s_paa_certs[0]));
+        TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test PAA B", s_paa_certs[1]));
+        TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test PAA C", s_paa_certs[2]));
+        s_generated = true;
+    }
+}
+
+static CHIP_ERROR get_paa(const uint8_t *skid, MutableByteSpan &paa_der)
+{
+    return get_attestation_trust_store()->GetProductAttestationAuthorityCert(
+               ByteSpan(skid, Crypto::kSubjectKeyIdentifierLength), paa_der);
+}
+
+static bool is_paa(const test_cert_t &cert)
+{
+    static uint8_t buf[kMaxDERCertLength];
+    MutableByteSpan paa_der(buf);
+    return get_paa(cert.skid, paa_der) == CHIP_NO_ERROR && paa_der.data_equal(ByteSpan(cert.der, cert.der_len));
+}
+
+struct lookup_ctx_t {
+    std::atomic<uint32_t> failures;
+    SemaphoreHandle_t done;
+};
+
+static void lookup_task(void *arg)
+{
+    lookup_ctx_t *ctx = static_cast<lookup_ctx_t *>(arg);
+    uint8_t buf[kMaxDERCertLength];
+    for (size_t i = 0; i < k_lookups_per_task; ++i) {
+        const test_cert_t &cert = s_paa_certs[i % k_paa_cert_count];
+        MutableByteSpan paa_der(buf);
+        if (get_paa(cert.skid, paa_der) != CHIP_NO_ERROR || !paa_der.data_equal(ByteSpan(cert.der, cert.der_len))) {
+            ctx->failures++;
+        }
+    }
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(nullptr);
+}
+
+// Look up the PAA certificates from several tasks at once, like concurrent commissioning sessions
+static void check_concurrent_lookups()
+{
+    lookup_ctx_t ctx;
+    ctx.failures = 0;
+    ctx.done = xSemaphoreCreateCounting(k_lookup_task_count, 0);
+    TEST_ASSERT_NOT_NULL(ctx.done);
+    for (size_t i = 0; i < k_lookup_task_count; ++i) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(lookup_task, "paa_lookup", 8192, &ctx, 5, nullptr));
+    }
+    for (size_t i = 0; i < k_lookup_task_count; ++i) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(ctx.done, pdMS_TO_TICKS(60000)));
+    }
+    vSemaphoreDelete(ctx.done);
+    TEST_ASSERT_EQUAL(0, ctx.failures.load());
+}
+
+#ifdef CONFIG_SPIFFS_ATTESTATION_TRUST_STORE
+static constexpr TickType_t k_rescan_ticks =
+    pdMS_TO_TICKS(CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_RESCAN_INTERVAL * 1000 + 100);
+
+static void init_spiffs_trust_store()
+{
+    if (!esp_spiffs_mounted(CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_PARTITION_LABEL)) {
+        // The trust store does not format its partition, start from an empty directory
+        TEST_ASSERT_EQUAL(ESP_OK, esp_spiffs_format(CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_PARTITION_LABEL));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, spiffs_attestation_trust_store::get_instance().init());
+}
+
+static void write_paa(const char *name, const test_cert_t &cert)
+{
+    char path[32];
+    snprintf(path, sizeof(path), "/paa/%s.der", name);
+    FILE *file = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(cert.der_len, fwrite(cert.der, 1, cert.der_len, file));
+    fclose(file);
+}
+
+TEST_CASE("the spiffs trust store finds the PAA certificates added to its directory", "[trust_store]")
+{
+    generate_paa_certs();
+    init_spiffs_trust_store();
+    write_paa("paa_a", s_paa_certs[0]);
+    vTaskDelay(k_rescan_ticks);
+    TEST_ASSERT_TRUE(is_paa(s_paa_certs[0]));
+
+    // The directory was just scanned, the new certificate is found by the next scan
+    write_paa("paa_b", s_paa_certs[1]);
+    if (CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_RESCAN_INTERVAL > 0) {
+        TEST_ASSERT_FALSE(is_paa(s_paa_certs[1]));
+    }
+    vTaskDelay(k_rescan_ticks);
+    TEST_ASSERT_TRUE(is_paa(s_paa_certs[1]));
+    TEST_ASSERT_TRUE(is_paa(s_paa_certs[0]));
+
+    // The index is stored next to the certificates
+    FILE *file = fopen("/paa/paa_skid.idx", "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    fclose(file);
+}
+
+TEST_CASE("the spiffs trust store is looked up by concurrent tasks", "[trust_store]")
+{
+    generate_paa_certs();
+    init_spiffs_trust_store();
+    write_paa("paa_a", s_paa_certs[0]);
+    write_paa("paa_b", s_paa_certs[1]);
+    write_paa("paa_c", s_paa_certs[2]);
+    vTaskDelay(k_rescan_ticks);
+    for (size_t i = 0; i < k_paa_cert_count; ++i) {
+        TEST_ASSERT_TRUE(is_paa(s_paa_certs[i]));
+    }
+    check_concurrent_lookups();
+}
+
+// Offset of the count of entries in the header of the stored PAA index: magic, version, entry size, signature
+static constexpr long k_paa_index_count_offset = 12;
+
+static void set_stored_paa_index_count(uint32_t count)
+{
+    FILE *file = fopen("/paa/paa_skid.idx", "r+b");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(0, fseek(file, k_paa_index_count_offset, SEEK_SET));
+    TEST_ASSERT_EQUAL(1, fwrite(&count, sizeof(count), 1, file));
+    fclose(file);
+}
+
+TEST_CASE("the spiffs trust store reuses the stored PAA index when the certificates did not change", "[trust_store]")
+{
+    generate_paa_certs();
+    init_spiffs_trust_store();
+    remove("/paa/paa_c.der");
+    write_paa("paa_a", s_paa_certs[0]);
+    write_paa("paa_b", s_paa_certs[1]);
+    vTaskDelay(k_rescan_ticks);
+    TEST_ASSERT_TRUE(is_paa(s_paa_certs[0]));
+    TEST_ASSERT_TRUE(is_paa(s_paa_certs[1]));
+
+    // Keep only the first entry of the stored index. It is loaded on the next init since the signature of the DER
+    // files still matches, so the other certificate is not found even after a rescan.
+    spiffs_attestation_trust_store::get_instance().deinit();
+    TEST_ASSERT_EQUAL(ESP_OK, spiffs_attestation_trust_store::get_instance().init());
+    set_stored_paa_index_count(1);
+    spiffs_attestation_trust_store::get_instance().deinit();
+    TEST_ASSERT_EQUAL(ESP_OK, spiffs_attestation_trust_store::get_instance().init());
+    // The entries of the index are sorted by SKID
+    bool a_first = memcmp(s_paa_certs[0].skid, s_paa_certs[1].skid, sizeof(s_paa_certs[0].skid)) < 0;
+    const test_cert_t &indexed = s_paa_certs[a_first ? 0 : 1];
+    const test_cert_t &dropped = s_paa_certs[a_first ? 1 : 0];
+    TEST_ASSERT_TRUE(is_paa(indexed));
+    vTaskDelay(k_rescan_ticks);
+    TEST_ASSERT_FALSE(is_paa(dropped));
+
+    // A new DER file changes the signature, the index is rebuilt on the next init
+    spiffs_attestation_trust_store::get_instance().deinit();
+    TEST_ASSERT_EQUAL(ESP_OK, spiffs_attestation_trust_store::get_instance().init());
+    write_paa("paa_c", s_paa_certs[2]);
+    spiffs_attestation_trust_store::get_instance().deinit();
+    TEST_ASSERT_EQUAL(ESP_OK, spiffs_attestation_trust_store::get_instance().init());
+    for (size_t i = 0; i < k_paa_cert_count; ++i) {
+        TEST_ASSERT_TRUE(is_paa(s_paa_certs[i]));
+    }
+}
+#endif // CONFIG_SPIFFS_ATTESTATION_TRUST_STORE
+
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE
+TEST_CASE("the DCL trust store fetches the PAA certificates from a local DCL", "[trust_store]")
+{
+    generate_paa_certs();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_pki_stand_in_start(s_paa_certs, k_paa_cert_count));
+    TEST_ASSERT_TRUE(is_paa(s_paa_certs[0]));
+    uint32_t request_count = dcl_pki_stand_in_get_request_count();
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+    // Served from the cache
+    TEST_ASSERT_TRUE(is_paa(s_paa_certs[0]));
+    TEST_ASSERT_EQUAL(request_count, dcl_pki_stand_in_get_request_count());
+#endif
+
+    uint8_t unknown_skid[Crypto::kSubjectKeyIdentifierLength];
+    memset(unknown_skid, 0x5A, sizeof(unknown_skid));
+    uint8_t buf[kMaxDERCertLength];
+    MutableByteSpan paa_der(buf);
+    TEST_ASSERT_TRUE(get_paa(unknown_skid, paa_der) != CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(request_count + 1, dcl_pki_stand_in_get_request_count());
+    dcl_pki_stand_in_stop();
+}
+
+TEST_CASE("the DCL trust store is looked up by concurrent tasks", "[trust_store]")
+{
+    generate_paa_certs();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_pki_stand_in_start(s_paa_certs, k_paa_cert_count));
+    check_concurrent_lookups();
+    dcl_pki_stand_in_stop();
+}
+
+#ifdef CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+// Look up a certificate and check whether it was fetched from the DCL or served from the cache
+static void check_paa_fetched(const test_cert_t &cert, bool fetched)
+{
+    uint32_t request_count = dcl_pki_stand_in_get_request_count();
+    TEST_ASSERT_TRUE(is_paa(cert));
+    TEST_ASSERT_EQUAL(request_count + (fetched ? 1 : 0), dcl_pki_stand_in_get_request_count());
+}
+
+TEST_CASE("the DCL trust store evicts the least recently used PAA certificate", "[trust_store]")
+{
+    // The certificates are evicted by the third one
+    TEST_ASSERT_EQUAL(k_paa_cert_count - 1, CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_SIZE);
+    generate_paa_certs();
+    dcl_attestation_trust_store::get_instance().ClearPAACache();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_pki_stand_in_start(s_paa_certs, k_paa_cert_count));
+    check_paa_fetched(s_paa_certs[0], true);
+    check_paa_fetched(s_paa_certs[1], true);
+    // A is now used more recently than B, so C evicts B
+    check_paa_fetched(s_paa_certs[0], false);
+    check_paa_fetched(s_paa_certs[2], true);
+    check_paa_fetched(s_paa_certs[0], false);
+    check_paa_fetched(s_paa_certs[1], true);
+    // B evicted C, which was used before A
+    check_paa_fetched(s_paa_certs[0], false);
+    check_paa_fetched(s_paa_certs[1], false);
+    check_paa_fetched(s_paa_certs[2], true);
+    dcl_pki_stand_in_stop();
+}
+
+TEST_CASE("the DCL trust store fetches the expired PAA certificates again", "[trust_store]")
+{
+    generate_paa_certs();
+    dcl_attestation_trust_store::get_instance().ClearPAACache();
+    dcl_attestation_trust_store::get_instance().SetPAACacheExpiry(1);
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_pki_stand_in_start(s_paa_certs, k_paa_cert_count));
+    check_paa_fetched(s_paa_certs[0], true);
+    check_paa_fetched(s_paa_certs[0], false);
+    vTaskDelay(pdMS_TO_TICKS(1100));
+    check_paa_fetched(s_paa_certs[0], true);
+    // The lookups do not extend the expiry of the entry
+    vTaskDelay(pdMS_TO_TICKS(600));
+    check_paa_fetched(s_paa_certs[0], false);
+    vTaskDelay(pdMS_TO_TICKS(500));
+    check_paa_fetched(s_paa_certs[0], true);
+    dcl_pki_stand_in_stop();
+    dcl_attestation_trust_store::get_instance().SetPAACacheExpiry(CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE_EXPIRY);
+}
+#endif // CONFIG_DCL_ATTESTATION_TRUST_STORE_CACHE
+#endif // CONFIG_DCL_ATTESTATION_TRUST_STORE
+
+#endif // CONFIG_SPIFFS_ATTESTATION_TRUST_STORE || CONFIG_DCL_ATTESTATION_TRUST_STORE
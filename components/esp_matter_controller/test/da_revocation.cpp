@@ -0,0 +1,437 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unity.h>
+
+#ifdef CONFIG_DCL_REVOCATION_POINTS_REVOKED_DAC_CHAIN_CHECK
+#include <algorithm>
+#include <esp_matter_da_revocation_cache.h>
+#include <esp_matter_da_revocation_delegate.h>
+#include <mbedtls/x509_crl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <test_certs.h>
+
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+#include <nvs.h>
+#endif
+#ifdef CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL
+#include <dcl_pki_stand_in.h>
+#endif
+
+using namespace chip;
+using namespace esp_matter::controller::attestation_verification;
+using namespace esp_matter::test;
+
+// Revocation sets of thousands of serial numbers, which are built directly as MbedTLS takes about 100 bytes of heap
+// per serial number of a parsed CRL
+static constexpr size_t k_large_set_serial_count = 2000;
+// CRLs larger than the 1200 bytes the CRLs were limited to
+static constexpr size_t k_crl_serial_count = 300;
+static constexpr size_t k_crl_too_large_serial_count = CONFIG_DCL_REVOCATION_POINTS_CRL_MAX_SIZE / 27 + 1;
+
+static int compare_serial_numbers(const revoked_serial_number_t &a, const revoked_serial_number_t &b)
+{
+    if (a.len != b.len) {
+        return a.len < b.len ? -1 : 1;
+    }
+    return memcmp(a.value, b.value, a.len);
+}
+
+// Serial numbers of 1 to 20 bytes, whose last byte is even so that the odd ones are not in the set
+static void get_serial_number(size_t index, revoked_serial_number_t &serial_number)
+{
+    serial_number.len = 1 + index % Crypto::kMaxCertificateSerialNumberLength;
+    memset(serial_number.value, 0, sizeof(serial_number.value));
+    serial_number.value[0] = 0x40;
+    size_t value = index / Crypto::kMaxCertificateSerialNumberLength;
+    serial_number.value[serial_number.len - 1] = static_cast<uint8_t>(value << 1);
+    if (serial_number.len > 1) {
+        serial_number.value[serial_number.len - 2] = static_cast<uint8_t>(value >> 7);
+    }
+    serial_number.revocation_date = index;
+}
+
+static revocation_set_t *make_large_set()
+{
+    revocation_set_t *set = static_cast<revocation_set_t *>(calloc(1, sizeof(revocation_set_t)));
+    TEST_ASSERT_NOT_NULL(set);
+    set->serial_numbers =
+        static_cast<revoked_serial_number_t *>(calloc(k_large_set_serial_count, sizeof(revoked_serial_number_t)));
+    TEST_ASSERT_NOT_NULL(set->serial_numbers);
+    memset(set->issuer_skid, 0xA5, sizeof(set->issuer_skid));
+    set->next_update = 0x123456789ULL;
+    set->crl_signer_cert_len = 400;
+    memset(set->crl_signer_cert, 0xC3, set->crl_signer_cert_len);
+    set->crl_signer_delegator_len = 300;
+    memset(set->crl_signer_delegator, 0xD4, set->crl_signer_delegator_len);
+    set->serial_number_count = k_large_set_serial_count;
+    for (size_t i = 0; i < k_large_set_serial_count; ++i) {
+        get_serial_number(i, set->serial_numbers[i]);
+    }
+    std::sort(set->serial_numbers, set->serial_numbers + set->serial_number_count,
+              [](const revoked_serial_number_t &a, const revoked_serial_number_t &b) {
+                  return compare_serial_numbers(a, b) < 0;
+              });
+    return set;
+}
+
+static void free_large_set(revocation_set_t *set)
+{
+    free(set->serial_numbers);
+    free(set);
+}
+
+static mbedtls_x509_time make_time(int year, int mon, int day, int hour, int min, int sec)
+{
+    mbedtls_x509_time time = {};
+    time.year = year;
+    time.mon = mon;
+    time.day = day;
+    time.hour = hour;
+    time.min = min;
+    time.sec = sec;
+    return time;
+}
+
+TEST_CASE("encode_x509_time keeps the order of the X.509 times", "[da_revocation]")
+{
+    // Increasing times, each one carries into a coarser field of the previous one
+    const mbedtls_x509_time times[] = {
+        make_time(2024, 12, 31, 23, 59, 58), make_time(2024, 12, 31, 23, 59, 59), make_time(2025, 1, 1, 0, 0, 0),
+        make_time(2025, 1, 1, 0, 0, 59), make_time(2025, 1, 1, 0, 1, 0), make_time(2025, 1, 1, 0, 59, 59),
+        make_time(2025, 1, 1, 1, 0, 0), make_time(2025, 1, 31, 23, 59, 59), make_time(2025, 2, 1, 0, 0, 0),
+        make_time(2025, 2, 28, 0, 0, 0), make_time(2025, 3, 1, 0, 0, 0), make_time(2049, 12, 31, 23, 59, 59),
+        make_time(2050, 1, 1, 0, 0, 0), make_time(9999, 12, 31, 23, 59, 59),
+    };
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); ++i) {
+        TEST_ASSERT_EQUAL_UINT64(encode_x509_time(times[i]), encode_x509_time(times[i]));
+        if (i > 0) {
+            TEST_ASSERT_TRUE(encode_x509_time(times[i - 1]) < encode_x509_time(times[i]));
+        }
+    }
+}
+
+TEST_CASE("find_revoked_serial_number finds the serial numbers of a large revocation set", "[da_revocation]")
+{
+    revocation_set_t *set = make_large_set();
+    for (size_t i = 0; i < k_large_set_serial_count; ++i) {
+        revoked_serial_number_t serial_number;
+        get_serial_number(i, serial_number);
+        const revoked_serial_number_t *found =
+            find_revoked_serial_number(*set, ByteSpan(serial_number.value, serial_number.len));
+        TEST_ASSERT_NOT_NULL(found);
+        TEST_ASSERT_EQUAL_UINT64(i, found->revocation_date);
+
+        // The same value with an odd last byte, or with a leading byte, is not revoked
+        serial_number.value[serial_number.len - 1] |= 1;
+        TEST_ASSERT_NULL(find_revoked_serial_number(*set, ByteSpan(serial_number.value, serial_number.len)));
+        get_serial_number(i, serial_number);
+        if (serial_number.len < Crypto::kMaxCertificateSerialNumberLength) {
+            uint8_t longer[Crypto::kMaxCertificateSerialNumberLength] = {0x7F};
+            memcpy(longer + 1, serial_number.value, serial_number.len);
+            TEST_ASSERT_NULL(find_revoked_serial_number(*set, ByteSpan(longer, serial_number.len + 1)));
+        }
+    }
+    const uint8_t empty_serial_number[] = {0x40};
+    revocation_set_t empty_set = {};
+    TEST_ASSERT_NULL(find_revoked_serial_number(empty_set, ByteSpan(empty_serial_number)));
+    free_large_set(set);
+}
+
+static void check_crl_entries(const mbedtls_x509_crl &crl, size_t serial_count)
+{
+    size_t count = 0;
+    for (const mbedtls_x509_crl_entry *entry = &crl.entry; entry != NULL && entry->serial.len > 0;
+            entry = entry->next) {
+        uint8_t serial[k_test_crl_serial_number_len];
+        test_crl_get_serial_number(count++, serial, sizeof(serial));
+        TEST_ASSERT_EQUAL(sizeof(serial), entry->serial.len);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(serial, entry->serial.p, sizeof(serial));
+    }
+    TEST_ASSERT_EQUAL(serial_count, count);
+}
+
+#ifdef CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+TEST_CASE("a large revocation set round-trips through its NVS blob", "[da_revocation]")
+{
+    revocation_set_t *set = make_large_set();
+    size_t blob_size = get_revocation_set_blob_size(*set);
+    uint8_t *blob = static_cast<uint8_t *>(malloc(blob_size));
+    TEST_ASSERT_NOT_NULL(blob);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, encode_revocation_set(*set, blob, blob_size - 1));
+    TEST_ASSERT_EQUAL(ESP_OK, encode_revocation_set(*set, blob, blob_size));
+    // The serial numbers are stored with their length rather than in revoked_serial_number_t
+    TEST_ASSERT_TRUE(blob_size < set->serial_number_count * sizeof(revoked_serial_number_t));
+
+    revocation_set_t *decoded = decode_revocation_set(blob, blob_size);
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(set->issuer_skid, decoded->issuer_skid, sizeof(set->issuer_skid));
+    TEST_ASSERT_EQUAL_UINT64(set->next_update, decoded->next_update);
+    TEST_ASSERT_EQUAL(set->crl_signer_cert_len, decoded->crl_signer_cert_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(set->crl_signer_cert, decoded->crl_signer_cert, set->crl_signer_cert_len);
+    TEST_ASSERT_EQUAL(set->crl_signer_delegator_len, decoded->crl_signer_delegator_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(set->crl_signer_delegator, decoded->crl_signer_delegator,
+                                 set->crl_signer_delegator_len);
+    TEST_ASSERT_EQUAL(set->serial_number_count, decoded->serial_number_count);
+    for (size_t i = 0; i < set->serial_number_count; ++i) {
+        TEST_ASSERT_EQUAL(0, compare_serial_numbers(set->serial_numbers[i], decoded->serial_numbers[i]));
+        TEST_ASSERT_EQUAL_UINT64(set->serial_numbers[i].revocation_date, decoded->serial_numbers[i].revocation_date);
+    }
+    free_revocation_set(decoded);
+
+    // Truncated or corrupted blobs are rejected
+    TEST_ASSERT_NULL(decode_revocation_set(blob, blob_size - 1));
+    TEST_ASSERT_NULL(decode_revocation_set(blob, 4));
+    blob[0] ^= 0xFF;
+    TEST_ASSERT_NULL(decode_revocation_set(blob, blob_size));
+    free(blob);
+    free_large_set(set);
+}
+
+// The cache needs the current time to check the nextUpdate of the CRLs
+static void set_current_time()
+{
+    // 2026-01-01
+    struct timeval tv = {.tv_sec = 1767225600, .tv_usec = 0};
+    TEST_ASSERT_EQUAL(0, settimeofday(&tv, nullptr));
+}
+
+static void add_crl(const test_cert_t &issuer, const test_cert_t &crl_signer, size_t serial_count)
+{
+    uint8_t *der = nullptr;
+    size_t der_len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, test_crl_generate("Test CRL Signer", serial_count, &der, &der_len));
+    mbedtls_x509_crl crl;
+    mbedtls_x509_crl_init(&crl);
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crl_parse(&crl, der, der_len));
+    free(der);
+    check_crl_entries(crl, serial_count);
+    esp_err_t err = crl_revocation_cache::get_instance().add(ByteSpan(issuer.skid), &crl,
+                                                               ByteSpan(crl_signer.der, crl_signer.der_len),
+                                                               ByteSpan());
+    mbedtls_x509_crl_free(&crl);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+}
+
+static void check_cached_set(const test_cert_t &issuer, size_t serial_count)
+{
+    const revocation_set_t *set = crl_revocation_cache::get_instance().find(ByteSpan(issuer.skid));
+    TEST_ASSERT_NOT_NULL(set);
+    TEST_ASSERT_EQUAL(serial_count, set->serial_number_count);
+    for (size_t i = 0; i < serial_count; ++i) {
+        uint8_t serial[k_test_crl_serial_number_len];
+        test_crl_get_serial_number(i, serial, sizeof(serial));
+        TEST_ASSERT_NOT_NULL(find_revoked_serial_number(*set, ByteSpan(serial)));
+    }
+    uint8_t serial[k_test_crl_serial_number_len];
+    test_crl_get_serial_number(serial_count, serial, sizeof(serial));
+    TEST_ASSERT_NULL(find_revoked_serial_number(*set, ByteSpan(serial)));
+}
+
+// Read the chunks of the revocation set stored in a slot of the cache, nullptr if the slot is empty
+static revocation_set_t *read_stored_set(nvs_handle_t handle, size_t slot, size_t &chunk_count)
+{
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    size_t blob_size = 0;
+    for (chunk_count = 0;; ++chunk_count) {
+        size_t chunk_size = 0;
+        snprintf(key, sizeof(key), "crl_%u_%u", (unsigned)slot, (unsigned)chunk_count);
+        if (nvs_get_blob(handle, key, nullptr, &chunk_size) != ESP_OK) {
+            break;
+        }
+        TEST_ASSERT_TRUE(chunk_size <= CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_MAX_BLOB_SIZE);
+        blob_size += chunk_size;
+    }
+    if (chunk_count == 0) {
+        return nullptr;
+    }
+    uint8_t *blob = static_cast<uint8_t *>(malloc(blob_size));
+    TEST_ASSERT_NOT_NULL(blob);
+    size_t offset = 0;
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        size_t chunk_size = blob_size - offset;
+        snprintf(key, sizeof(key), "crl_%u_%u", (unsigned)slot, (unsigned)chunk);
+        TEST_ASSERT_EQUAL(ESP_OK, nvs_get_blob(handle, key, blob + offset, &chunk_size));
+        offset += chunk_size;
+    }
+    TEST_ASSERT_EQUAL(blob_size, offset);
+    revocation_set_t *set = decode_revocation_set(blob, blob_size);
+    free(blob);
+    TEST_ASSERT_NOT_NULL(set);
+    return set;
+}
+
+// Number of NVS chunks of the revocation set of the issuer stored in the partition of the cache, 0 if it is not stored
+static size_t get_stored_chunk_count(const uint8_t *issuer_skid)
+{
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_NVS_PARTITION, "da_crl_cache", NVS_READONLY,
+                                &handle) != ESP_OK) {
+        return 0;
+    }
+    size_t stored_chunk_count = 0;
+    for (size_t slot = 0; slot < CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_SIZE && stored_chunk_count == 0; ++slot) {
+        size_t chunk_count = 0;
+        revocation_set_t *set = read_stored_set(handle, slot, chunk_count);
+        if (set && memcmp(set->issuer_skid, issuer_skid, sizeof(set->issuer_skid)) == 0) {
+            stored_chunk_count = chunk_count;
+        }
+        free_revocation_set(set);
+    }
+    nvs_close(handle);
+    return stored_chunk_count;
+}
+
+static bool is_stored(const test_cert_t &issuer)
+{
+    return get_stored_chunk_count(issuer.skid) > 0;
+}
+
+TEST_CASE("the CRL cache stores the revocation sets in chunks within the blob size cap", "[da_revocation]")
+{
+    static test_cert_t s_issuers[2];
+    static test_cert_t s_crl_signer;
+    TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test PAI A", s_issuers[0]));
+    TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test PAI B", s_issuers[1]));
+    TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test CRL Signer", s_crl_signer));
+    set_current_time();
+    crl_revocation_cache::get_instance().clear();
+
+    add_crl(s_issuers[0], s_crl_signer, k_crl_serial_count);
+    check_cached_set(s_issuers[0], k_crl_serial_count);
+    TEST_ASSERT_TRUE(is_stored(s_issuers[0]));
+
+    // The blob of a set of twice the serial numbers is split in more chunks
+    add_crl(s_issuers[1], s_crl_signer, 2 * k_crl_serial_count);
+    check_cached_set(s_issuers[1], 2 * k_crl_serial_count);
+    TEST_ASSERT_TRUE(get_stored_chunk_count(s_issuers[1].skid) > get_stored_chunk_count(s_issuers[0].skid));
+    TEST_ASSERT_TRUE(is_stored(s_issuers[0]));
+
+    // Both sets are loaded again from NVS
+    crl_revocation_cache::get_instance().reload();
+    check_cached_set(s_issuers[0], k_crl_serial_count);
+    check_cached_set(s_issuers[1], 2 * k_crl_serial_count);
+
+    crl_revocation_cache::get_instance().clear();
+    TEST_ASSERT_NULL(crl_revocation_cache::get_instance().find(ByteSpan(s_issuers[0].skid)));
+    TEST_ASSERT_NULL(crl_revocation_cache::get_instance().find(ByteSpan(s_issuers[1].skid)));
+    TEST_ASSERT_FALSE(is_stored(s_issuers[0]));
+}
+
+TEST_CASE("a revocation set of thousands of serial numbers is reloaded from the CRL cache", "[da_revocation]")
+{
+    set_current_time();
+    crl_revocation_cache::get_instance().clear();
+
+    // The cache takes the ownership of a set allocated by decode_revocation_set()
+    revocation_set_t *set = make_large_set();
+    set->next_update = encode_x509_time(make_time(2099, 12, 31, 0, 0, 0));
+    size_t blob_size = get_revocation_set_blob_size(*set);
+    uint8_t *blob = static_cast<uint8_t *>(malloc(blob_size));
+    TEST_ASSERT_NOT_NULL(blob);
+    TEST_ASSERT_EQUAL(ESP_OK, encode_revocation_set(*set, blob, blob_size));
+    uint8_t issuer_skid[Crypto::kSubjectKeyIdentifierLength];
+    memcpy(issuer_skid, set->issuer_skid, sizeof(issuer_skid));
+    free_large_set(set);
+    set = decode_revocation_set(blob, blob_size);
+    free(blob);
+    TEST_ASSERT_NOT_NULL(set);
+    TEST_ASSERT_EQUAL(ESP_OK, crl_revocation_cache::get_instance().add(set));
+    size_t chunk_count = get_stored_chunk_count(issuer_skid);
+    TEST_ASSERT_EQUAL((blob_size + CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_MAX_BLOB_SIZE - 1) /
+                      CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE_MAX_BLOB_SIZE, chunk_count);
+
+    crl_revocation_cache::get_instance().reload();
+    const revocation_set_t *cached = crl_revocation_cache::get_instance().find(ByteSpan(issuer_skid));
+    TEST_ASSERT_NOT_NULL(cached);
+    TEST_ASSERT_EQUAL(k_large_set_serial_count, cached->serial_number_count);
+    TEST_ASSERT_EQUAL(400, cached->crl_signer_cert_len);
+    TEST_ASSERT_EQUAL(300, cached->crl_signer_delegator_len);
+    for (size_t i = 0; i < k_large_set_serial_count; ++i) {
+        revoked_serial_number_t serial_number;
+        get_serial_number(i, serial_number);
+        const revoked_serial_number_t *found =
+            find_revoked_serial_number(*cached, ByteSpan(serial_number.value, serial_number.len));
+        TEST_ASSERT_NOT_NULL(found);
+        TEST_ASSERT_EQUAL_UINT64(i, found->revocation_date);
+    }
+
+    // The chunks are erased with the set
+    crl_revocation_cache::get_instance().clear();
+    TEST_ASSERT_EQUAL(0, get_stored_chunk_count(issuer_skid));
+    crl_revocation_cache::get_instance().reload();
+    TEST_ASSERT_NULL(crl_revocation_cache::get_instance().find(ByteSpan(issuer_skid)));
+}
+#endif // CONFIG_DCL_REVOCATION_POINTS_CRL_CACHE
+
+#ifdef CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL
+using chip::Credentials::dcl_revocation_point_da_revocation_delegate;
+
+TEST_CASE("a CRL larger than the former fixed buffer is downloaded from a local DCL", "[da_revocation]")
+{
+    static test_cert_t s_issuer;
+    static test_cert_t s_crl_signer;
+    TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test PAI", s_issuer));
+    TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test CRL Signer", s_crl_signer));
+    uint8_t *der = nullptr;
+    size_t der_len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, test_crl_generate("Test CRL Signer", k_crl_serial_count, &der, &der_len));
+    TEST_ASSERT_TRUE(der_len > 1200);
+    dcl_pki_stand_in_set_revocation_point(s_issuer.skid, s_crl_signer, der, der_len);
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_pki_stand_in_start(nullptr, 0));
+
+    dcl_revocation_point_da_revocation_delegate &delegate = dcl_revocation_point_da_revocation_delegate::get_instance();
+    uint8_t crl_signer_cert_buf[Crypto::kMax_x509_Certificate_Length];
+    MutableByteSpan crl_signer_cert(crl_signer_cert_buf);
+    uint8_t crl_signer_delegator_buf[Crypto::kMax_x509_Certificate_Length];
+    MutableByteSpan crl_signer_delegator(crl_signer_delegator_buf);
+    char crl_url_buf[dcl_revocation_point_da_revocation_delegate::k_crl_url_max_len];
+    MutableCharSpan crl_url(crl_url_buf);
+    TEST_ASSERT_EQUAL(ESP_OK, delegate.fetch_revocation_set_from_dcl(ByteSpan(s_issuer.skid), crl_signer_cert,
+                                                                     crl_signer_delegator, crl_url));
+    TEST_ASSERT_TRUE(crl_signer_cert.data_equal(ByteSpan(s_crl_signer.der, s_crl_signer.der_len)));
+
+    mbedtls_x509_crl crl;
+    mbedtls_x509_crl_init(&crl);
+    esp_err_t err = delegate.fetch_crl(CharSpan::fromCharString(crl_url_buf), crl);
+    if (err == ESP_OK) {
+        check_crl_entries(crl, k_crl_serial_count);
+    }
+    mbedtls_x509_crl_free(&crl);
+    dcl_pki_stand_in_stop();
+    free(der);
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+}
+
+TEST_CASE("a CRL larger than the maximum size is rejected", "[da_revocation]")
+{
+    static test_cert_t s_issuer;
+    static test_cert_t s_crl_signer;
+    TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test PAI", s_issuer));
+    TEST_ASSERT_EQUAL(ESP_OK, test_cert_generate("Test CRL Signer", s_crl_signer));
+    uint8_t *der = nullptr;
+    size_t der_len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, test_crl_generate("Test CRL Signer", k_crl_too_large_serial_count, &der, &der_len));
+    TEST_ASSERT_TRUE(der_len > CONFIG_DCL_REVOCATION_POINTS_CRL_MAX_SIZE);
+    dcl_pki_stand_in_set_revocation_point(s_issuer.skid, s_crl_signer, der, der_len);
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_pki_stand_in_start(nullptr, 0));
+
+    mbedtls_x509_crl crl;
+    mbedtls_x509_crl_init(&crl);
+    char crl_url[64];
+    snprintf(crl_url, sizeof(crl_url), "http://127.0.0.1:%u/crl/revoked.crl", k_dcl_pki_stand_in_port);
+    esp_err_t err = dcl_revocation_point_da_revocation_delegate::get_instance().fetch_crl(
+                        CharSpan::fromCharString(crl_url), crl);
+    mbedtls_x509_crl_free(&crl);
+    dcl_pki_stand_in_stop();
+    free(der);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, err);
+}
+#endif // CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL
+
+#endif // CONFIG_DCL_REVOCATION_POINTS_REVOKED_DAC_CHAIN_CHECK
@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <dcl_pki_stand_in.h>
+
+#include <atomic>
+#include <esp_event.h>
+#include <esp_http_server.h>
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace esp_matter::test {
+
+static const char *TAG = "dcl_pki_stand_in";
+
+static httpd_handle_t s_server = nullptr;
+static const test_cert_t *s_paa_certs = nullptr;
+static size_t s_paa_count = 0;
+static std::atomic<uint32_t> s_request_count(0);
+static uint8_t s_issuer_skid[chip::Crypto::kSubjectKeyIdentifierLength];
+static const test_cert_t *s_crl_signer_cert = nullptr;
+static const uint8_t *s_crl = nullptr;
+static size_t s_crl_len = 0;
+// The handlers run in the task of the server, one at a time
+static char s_pem[1024];
+static char s_response[2048];
+
+// The SKID in hex, the subjectKeyId queries of the trust store separate the bytes with an encoded ':'
+static void format_skid(const uint8_t *skid, size_t skid_len, const char *separator, char *out, size_t out_size)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < skid_len && offset < out_size; ++i) {
+        offset += snprintf(out + offset, out_size - offset, "%s%02X", i ? separator : "", skid[i]);
+    }
+}
+
+// Append the PEM certificate as a JSON string value, with the new lines escaped
+static int append_json_pem(int len, const char *pem)
+{
+    for (; *pem && len + 2 < (int)sizeof(s_response); ++pem) {
+        if (*pem == '\n') {
+            s_response[len++] = '\\';
+            s_response[len++] = 'n';
+        } else {
+            s_response[len++] = *pem;
+        }
+    }
+    return *pem ? (int)sizeof(s_response) : len;
+}
+
+static esp_err_t certificates_handler(httpd_req_t *req)
+{
+    s_request_count++;
+    char query[128];
+    char skid_query[96];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK ||
+            httpd_query_key_value(query, "subjectKeyId", skid_query, sizeof(skid_query)) != ESP_OK) {
+        return httpd_resp_send_404(req);
+    }
+    for (size_t i = 0; i < s_paa_count; ++i) {
+        char skid[96];
+        format_skid(s_paa_certs[i].skid, sizeof(s_paa_certs[i].skid), "%3A", skid, sizeof(skid));
+        if (strcmp(skid, skid_query) != 0) {
+            continue;
+        }
+        if (test_cert_to_pem(s_paa_certs[i], s_pem, sizeof(s_pem)) != ESP_OK) {
+            return httpd_resp_send_500(req);
+        }
+        int len = snprintf(s_response, sizeof(s_response),
+                           "{\"approvedCertificates\":[{\"subjectKeyId\":\"%s\",\"certs\":[{\"pemCert\":\"", skid);
+        len = append_json_pem(len, s_pem);
+        if (len < (int)sizeof(s_response)) {
+            len += snprintf(s_response + len, sizeof(s_response) - len, "\"}]}]}");
+        }
+        if (len >= (int)sizeof(s_response)) {
+            ESP_LOGE(TAG, "The certificate does not fit in the response");
+            return httpd_resp_send_500(req);
+        }
+        httpd_resp_set_type(req, "application/json");
+        return httpd_resp_send(req, s_response, len);
+    }
+    return httpd_resp_send_404(req);
+}
+
+static esp_err_t revocation_points_handler(httpd_req_t *req)
+{
+    s_request_count++;
+    char skid[64];
+    format_skid(s_issuer_skid, sizeof(s_issuer_skid), "", skid, sizeof(skid));
+    const char *requested_skid = strrchr(req->uri, '/') + 1;
+    if (!s_crl_signer_cert || strcmp(skid, requested_skid) != 0) {
+        return httpd_resp_send_404(req);
+    }
+    if (test_cert_to_pem(*s_crl_signer_cert, s_pem, sizeof(s_pem)) != ESP_OK) {
+        return httpd_resp_send_500(req);
+    }
+    int len = snprintf(s_response, sizeof(s_response),
+                       "{\"pkiRevocationDistributionPointsByIssuerSubjectKeyID\":{\"issuerSubjectKeyID\":\"%s\","
+                       "\"points\":[{\"crlSignerCertificate\":\"", skid);
+    len = append_json_pem(len, s_pem);
+    if (len < (int)sizeof(s_response)) {
+        len += snprintf(s_response + len, sizeof(s_response) - len,
+                        "\",\"crlSignerDelegator\":\"\",\"dataURL\":\"http://127.0.0.1:%u/crl/revoked.crl\"}]}}",
+                        k_dcl_pki_stand_in_port);
+    }
+    if (len >= (int)sizeof(s_response)) {
+        ESP_LOGE(TAG, "The revocation point does not fit in the response");
+        return httpd_resp_send_500(req);
+    }
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, s_response, len);
+}
+
+static esp_err_t crl_handler(httpd_req_t *req)
+{
+    s_request_count++;
+    if (!s_crl) {
+        return httpd_resp_send_404(req);
+    }
+    httpd_resp_set_type(req, "application/pkix-crl");
+    return httpd_resp_send(req, reinterpret_cast<const char *>(s_crl), s_crl_len);
+}
+
+void dcl_pki_stand_in_set_revocation_point(const uint8_t *issuer_skid, const test_cert_t &crl_signer_cert,
+                                           const uint8_t *crl, size_t crl_len)
+{
+    memcpy(s_issuer_skid, issuer_skid, sizeof(s_issuer_skid));
+    s_crl_signer_cert = &crl_signer_cert;
+    s_crl = crl;
+    s_crl_len = crl_len;
+}
+
+esp_err_t dcl_pki_stand_in_start(const test_cert_t *paa_certs, size_t paa_count)
+{
+    // The network stack may already be up if another test started it
+    esp_err_t err = esp_netif_init();
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    err = esp_event_loop_create_default();
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    s_paa_certs = paa_certs;
+    s_paa_count = paa_count;
+    s_request_count = 0;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.server_port = k_dcl_pki_stand_in_port;
+    config.uri_match_fn = httpd_uri_match_wildcard;
+    config.lru_purge_enable = true;
+    err = httpd_start(&s_server, &config);
+    if (err != ESP_OK) {
+        return err;
+    }
+    const httpd_uri_t certificates = {
+        .uri = "/dcl/pki/certificates",
+        .method = HTTP_GET,
+        .handler = certificates_handler,
+        .user_ctx = nullptr,
+    };
+    const httpd_uri_t revocation_points = {
+        .uri = "/dcl/pki/revocation-points/*",
+        .method = HTTP_GET,
+        .handler = revocation_points_handler,
+        .user_ctx = nullptr,
+    };
+    const httpd_uri_t crl = {
+        .uri = "/crl/*",
+        .method = HTTP_GET,
+        .handler = crl_handler,
+        .user_ctx = nullptr,
+    };
+    err = httpd_register_uri_handler(s_server, &certificates);
+    if (err == ESP_OK) {
+        err = httpd_register_uri_handler(s_server, &revocation_points);
+    }
+    if (err == ESP_OK) {
+        err = httpd_register_uri_handler(s_server, &crl);
+    }
+    return err;
+}
+
+uint32_t dcl_pki_stand_in_get_request_count()
+{
+    return s_request_count;
+}
+
+void dcl_pki_stand_in_stop()
+{
+    if (s_server) {
+        httpd_stop(s_server);
+        s_server = nullptr;
+    }
+    s_paa_certs = nullptr;
+    s_paa_count = 0;
+    s_crl_signer_cert = nullptr;
+    s_crl = nullptr;
+    s_crl_len = 0;
+}
+
+} // namespace esp_matter::test
@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <test_certs.h>
+
+namespace esp_matter::test {
+
+// Port of the loopback HTTP server, CONFIG_ESP_MATTER_COMMISSIONER_DCL_CUSTOM_URL is http://127.0.0.1:8080
+constexpr uint16_t k_dcl_pki_stand_in_port = 8080;
+
+/** Start a loopback HTTP server which answers the PKI requests of the DCL REST API
+ *
+ * /dcl/pki/certificates?subjectKeyId=<skid> gives the PAA certificate of the SKID in PEM format, or 404 if there is
+ * no such certificate. The certificates are not copied and must outlive the server.
+ */
+esp_err_t dcl_pki_stand_in_start(const test_cert_t *paa_certs, size_t paa_count);
+
+/** Serve a revocation point of the DCL REST API, the server may be started or not
+ *
+ * /dcl/pki/revocation-points/<issuer_skid> gives the revocation point of the issuer, with the CRL signer certificate
+ * and the URL of the CRL on the server, /crl/revoked.crl, which serves the CRL. The certificate and the CRL are not
+ * copied and must outlive the server.
+ */
+void dcl_pki_stand_in_set_revocation_point(const uint8_t *issuer_skid, const test_cert_t &crl_signer_cert,
+                                           const uint8_t *crl, size_t crl_len);
+
+/** Number of requests received since the server was started */
+uint32_t dcl_pki_stand_in_get_request_count();
+
+void dcl_pki_stand_in_stop();
+
+} // namespace esp_matter::test
@@ -0,0 +1,307 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unity.h>
+
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ENABLE
+#include <esp_matter_controller_fanout_command.h>
+#include <lib/support/CHIPMem.h>
+#include <vector>
+
+using namespace esp_matter::controller;
+using chip::app::AttributePathParams;
+using chip::app::EventPathParams;
+using chip::Platform::ScopedMemoryBufferWithSize;
+
+static constexpr size_t k_max_node_count = 10;
+
+// Node whose command was given to the fake sender and whose callbacks have not been called yet
+typedef struct {
+    uint64_t node_id;
+    bool subscribe;
+    fanout::node_callbacks_t callbacks;
+} sent_node_t;
+
+typedef struct {
+    size_t call_count;
+    size_t result_count;
+    fanout::node_result_t results[k_max_node_count];
+    fanout::stats_t stats;
+} done_result_t;
+
+static std::vector<sent_node_t> s_sent_nodes;
+static size_t s_send_count;
+static size_t s_send_depth;
+static size_t s_max_send_depth;
+static size_t s_attribute_cb_count;
+static done_result_t s_done;
+static ScopedMemoryBufferWithSize<AttributePathParams> s_attr_paths;
+static ScopedMemoryBufferWithSize<EventPathParams> s_event_paths;
+
+// The buffers of the fan-out are allocated by the CHIP allocator, which is initialized when the Matter stack starts
+static void init_chip_memory()
+{
+    static bool s_initialized = false;
+    if (!s_initialized) {
+        TEST_ASSERT_TRUE(chip::Platform::MemoryInit() == CHIP_NO_ERROR);
+        s_initialized = true;
+    }
+}
+
+static void reset_fanout_test()
+{
+    init_chip_memory();
+    s_sent_nodes.clear();
+    s_send_count = 0;
+    s_send_depth = 0;
+    s_max_send_depth = 0;
+    s_attribute_cb_count = 0;
+    s_done.call_count = 0;
+    s_done.result_count = 0;
+    s_attr_paths.Alloc(1);
+    TEST_ASSERT_NOT_NULL(s_attr_paths.Get());
+    s_attr_paths[0] = AttributePathParams(1, 0x0006, 0x0000);
+}
+
+// The callbacks of the sent nodes keep the fan-out alive
+static void end_fanout_test()
+{
+    fanout::set_node_sender(nullptr);
+    s_sent_nodes.clear();
+    s_attr_paths.Free();
+}
+
+static fanout::config_t make_config(size_t max_in_flight)
+{
+    fanout::config_t config;
+    config.max_in_flight = max_in_flight;
+    config.attribute_cb = [](uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+    chip::TLV::TLVReader *data, const chip::app::StatusIB &status) {
+        s_attribute_cb_count++;
+    };
+    config.done_cb = [](const fanout::node_result_t *results, size_t result_count, const fanout::stats_t &stats) {
+        TEST_ASSERT_TRUE(result_count <= k_max_node_count);
+        s_done.call_count++;
+        s_done.result_count = result_count;
+        for (size_t i = 0; i < result_count; ++i) {
+            s_done.results[i] = results[i];
+        }
+        s_done.stats = stats;
+    };
+    return config;
+}
+
+// Keep the callbacks of every node, which are called by the test
+static esp_err_t record_node(uint64_t node_id, bool subscribe, const fanout::node_callbacks_t &callbacks)
+{
+    s_send_count++;
+    s_sent_nodes.push_back({node_id, subscribe, callbacks});
+    return ESP_OK;
+}
+
+static void report_attribute(const sent_node_t &node)
+{
+    chip::app::ConcreteDataAttributePath path(1, 0x0006, 0x0000);
+    chip::app::StatusIB status;
+    node.callbacks.attribute_cb(node.node_id, path, nullptr, status);
+}
+
+static void check_stats(size_t node_count, size_t succeeded, size_t max_in_flight)
+{
+    TEST_ASSERT_EQUAL(1, s_done.call_count);
+    TEST_ASSERT_EQUAL(node_count, s_done.result_count);
+    TEST_ASSERT_EQUAL(node_count, s_done.stats.node_count);
+    TEST_ASSERT_EQUAL(succeeded, s_done.stats.succeeded);
+    TEST_ASSERT_EQUAL(node_count - succeeded, s_done.stats.failed);
+    TEST_ASSERT_EQUAL(max_in_flight, s_done.stats.max_in_flight);
+    TEST_ASSERT_TRUE(s_done.stats.min_node_time_us <= s_done.stats.avg_node_time_us);
+    TEST_ASSERT_TRUE(s_done.stats.avg_node_time_us <= s_done.stats.max_node_time_us);
+    TEST_ASSERT_TRUE(s_done.stats.max_node_time_us <= s_done.stats.total_time_us);
+}
+
+TEST_CASE("the fan-out rejects no node, no path and an empty window", "[fanout]")
+{
+    reset_fanout_test();
+    fanout::set_node_sender(record_node);
+    const uint64_t node_ids[] = {0x100};
+    ScopedMemoryBufferWithSize<AttributePathParams> no_attr_paths;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, fanout::send_read_command(nullptr, 1, s_attr_paths, s_event_paths,
+                                                                     make_config(1)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, fanout::send_read_command(node_ids, 0, s_attr_paths, s_event_paths,
+                                                                     make_config(1)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, fanout::send_read_command(node_ids, 1, no_attr_paths, s_event_paths,
+                                                                     make_config(1)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, fanout::send_read_command(node_ids, 1, s_attr_paths, s_event_paths,
+                                                                     make_config(0)));
+    TEST_ASSERT_EQUAL(0, s_send_count);
+    TEST_ASSERT_EQUAL(0, s_done.call_count);
+    end_fanout_test();
+}
+
+TEST_CASE("the fan-out keeps at most max_in_flight nodes in flight", "[fanout]")
+{
+    reset_fanout_test();
+    fanout::set_node_sender(record_node);
+    constexpr size_t k_node_count = k_max_node_count;
+    constexpr size_t k_window = 3;
+    uint64_t node_ids[k_node_count];
+    for (size_t i = 0; i < k_node_count; ++i) {
+        node_ids[i] = 0x100 + i;
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, fanout::send_read_command(node_ids, k_node_count, s_attr_paths, s_event_paths,
+                                                        make_config(k_window)));
+    TEST_ASSERT_EQUAL(k_window, s_sent_nodes.size());
+
+    // Finish the nodes in order, each one lets the next pending node in
+    size_t attribute_count = 0;
+    for (size_t next = 0; next < s_sent_nodes.size(); ++next) {
+        TEST_ASSERT_TRUE(s_sent_nodes.size() - next <= k_window);
+        TEST_ASSERT_EQUAL(0, s_done.call_count);
+        // The callbacks add nodes to s_sent_nodes
+        sent_node_t node = s_sent_nodes[next];
+        TEST_ASSERT_FALSE(node.subscribe);
+        TEST_ASSERT_EQUAL_UINT64(node_ids[next], node.node_id);
+        for (size_t i = 0; i <= next % 3; ++i) {
+            report_attribute(node);
+            attribute_count++;
+        }
+        node.callbacks.read_done_cb(node.node_id, s_attr_paths, s_event_paths);
+    }
+    TEST_ASSERT_EQUAL(k_node_count, s_send_count);
+    TEST_ASSERT_EQUAL(attribute_count, s_attribute_cb_count);
+
+    check_stats(k_node_count, k_node_count, k_window);
+    for (size_t i = 0; i < k_node_count; ++i) {
+        const fanout::node_result_t &result = s_done.results[i];
+        TEST_ASSERT_EQUAL_UINT64(node_ids[i], result.node_id);
+        TEST_ASSERT_EQUAL(ESP_OK, result.err);
+        TEST_ASSERT_TRUE(result.chip_err == CHIP_NO_ERROR);
+        TEST_ASSERT_EQUAL(i % 3 + 1, result.attribute_count);
+        TEST_ASSERT_EQUAL(0, result.event_count);
+        if (i > 0) {
+            TEST_ASSERT_TRUE(s_done.results[i - 1].start_time_us <= result.start_time_us);
+        }
+    }
+    end_fanout_test();
+}
+
+// Like a read_command whose request cannot be sent once the session is established
+static esp_err_t fail_read_synchronously(uint64_t node_id, bool subscribe, const fanout::node_callbacks_t &callbacks)
+{
+    s_send_count++;
+    s_send_depth++;
+    if (s_send_depth > s_max_send_depth) {
+        s_max_send_depth = s_send_depth;
+    }
+    callbacks.error_cb(node_id, CHIP_ERROR_INTERNAL);
+    callbacks.read_done_cb(node_id, s_attr_paths, s_event_paths);
+    s_send_depth--;
+    return ESP_OK;
+}
+
+TEST_CASE("the nodes which finish while they are sent do not reenter the window", "[fanout]")
+{
+    reset_fanout_test();
+    fanout::set_node_sender(fail_read_synchronously);
+    constexpr size_t k_node_count = 6;
+    uint64_t node_ids[k_node_count];
+    for (size_t i = 0; i < k_node_count; ++i) {
+        node_ids[i] = 0x200 + i;
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, fanout::send_read_command(node_ids, k_node_count, s_attr_paths, s_event_paths,
+                                                        make_config(4)));
+
+    // The nodes are sent one after the other by the loop of the window, not from the callbacks of the previous node
+    TEST_ASSERT_EQUAL(k_node_count, s_send_count);
+    TEST_ASSERT_EQUAL(1, s_max_send_depth);
+    check_stats(k_node_count, 0, 1);
+    for (size_t i = 0; i < k_node_count; ++i) {
+        TEST_ASSERT_EQUAL_UINT64(node_ids[i], s_done.results[i].node_id);
+        TEST_ASSERT_EQUAL(ESP_FAIL, s_done.results[i].err);
+        TEST_ASSERT_TRUE(s_done.results[i].chip_err == CHIP_ERROR_INTERNAL);
+    }
+    end_fanout_test();
+}
+
+static esp_err_t fail_first_node(uint64_t node_id, bool subscribe, const fanout::node_callbacks_t &callbacks)
+{
+    if (node_id == 0x300) {
+        s_send_count++;
+        return ESP_FAIL;
+    }
+    return record_node(node_id, subscribe, callbacks);
+}
+
+TEST_CASE("the fan-out gives the result of every node and the stats of the failures", "[fanout]")
+{
+    reset_fanout_test();
+    fanout::set_node_sender(fail_first_node);
+    const uint64_t node_ids[] = {0x300, 0x301, 0x302, 0x303};
+    TEST_ASSERT_EQUAL(ESP_OK, fanout::send_read_command(node_ids, 4, s_attr_paths, s_event_paths, make_config(4)));
+    TEST_ASSERT_EQUAL(3, s_sent_nodes.size());
+
+    // A late callback of a failed node does not change its result
+    sent_node_t node = s_sent_nodes[0];
+    node.callbacks.connect_failure_cb(nullptr, chip::ScopedNodeId(node.node_id, 1), CHIP_ERROR_TIMEOUT);
+    node.callbacks.read_done_cb(node.node_id, s_attr_paths, s_event_paths);
+    node = s_sent_nodes[1];
+    node.callbacks.error_cb(node.node_id, CHIP_ERROR_INTERNAL);
+    node.callbacks.read_done_cb(node.node_id, s_attr_paths, s_event_paths);
+    node = s_sent_nodes[2];
+    chip::app::EventHeader header;
+    for (size_t i = 0; i < 2; ++i) {
+        node.callbacks.event_cb(node.node_id, header, nullptr, nullptr);
+    }
+    TEST_ASSERT_EQUAL(0, s_done.call_count);
+    node.callbacks.read_done_cb(node.node_id, s_attr_paths, s_event_paths);
+
+    // The first node failed before the others were sent
+    check_stats(4, 1, 3);
+    TEST_ASSERT_EQUAL(ESP_FAIL, s_done.results[0].err);
+    TEST_ASSERT_TRUE(s_done.results[0].chip_err == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL(ESP_FAIL, s_done.results[1].err);
+    TEST_ASSERT_TRUE(s_done.results[1].chip_err == CHIP_ERROR_TIMEOUT);
+    TEST_ASSERT_EQUAL(ESP_FAIL, s_done.results[2].err);
+    TEST_ASSERT_TRUE(s_done.results[2].chip_err == CHIP_ERROR_INTERNAL);
+    TEST_ASSERT_EQUAL(ESP_OK, s_done.results[3].err);
+    TEST_ASSERT_EQUAL(2, s_done.results[3].event_count);
+    for (size_t i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL_UINT64(node_ids[i], s_done.results[i].node_id);
+    }
+    end_fanout_test();
+}
+
+TEST_CASE("a fan-out subscription fails only when it ends before being established", "[fanout]")
+{
+    reset_fanout_test();
+    fanout::set_node_sender(record_node);
+    const uint64_t node_ids[] = {0x400, 0x401, 0x402};
+    TEST_ASSERT_EQUAL(ESP_OK, fanout::send_subscribe_command(node_ids, 3, s_attr_paths, s_event_paths, 1, 10,
+                                                             make_config(3)));
+    TEST_ASSERT_EQUAL(3, s_sent_nodes.size());
+    for (const sent_node_t &node : s_sent_nodes) {
+        TEST_ASSERT_TRUE(node.subscribe);
+    }
+
+    s_sent_nodes[0].callbacks.established_cb(node_ids[0], 7);
+    s_sent_nodes[0].callbacks.terminated_cb(node_ids[0], 7);
+    s_sent_nodes[1].callbacks.terminated_cb(node_ids[1], 0);
+    report_attribute(s_sent_nodes[2]);
+    s_sent_nodes[2].callbacks.established_cb(node_ids[2], 9);
+    // The reports of an established subscription are still counted
+    report_attribute(s_sent_nodes[2]);
+
+    check_stats(3, 2, 3);
+    TEST_ASSERT_EQUAL(ESP_OK, s_done.results[0].err);
+    TEST_ASSERT_EQUAL(7, s_done.results[0].subscription_id);
+    TEST_ASSERT_EQUAL(ESP_FAIL, s_done.results[1].err);
+    TEST_ASSERT_EQUAL(ESP_OK, s_done.results[2].err);
+    TEST_ASSERT_EQUAL(9, s_done.results[2].subscription_id);
+    TEST_ASSERT_EQUAL(1, s_done.results[2].attribute_count);
+    TEST_ASSERT_EQUAL(2, s_attribute_cb_count);
+    end_fanout_test();
+}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_ENABLE
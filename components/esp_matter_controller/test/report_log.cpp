@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unity.h>
+
+#ifdef CONFIG_ESP_MATTER_CONTROLLER_ENABLE
+#include <esp_matter_controller_report_log.h>
+#include <lib/core/TLV.h>
+#include <string.h>
+
+using namespace esp_matter::controller;
+using chip::TLV::ContextTag;
+using chip::TLV::TLVReader;
+using chip::TLV::TLVType;
+using chip::TLV::TLVWriter;
+
+static constexpr size_t k_tlv_buffer_size = 512;
+
+// Position a reader on the single element written in the buffer
+static void init_reader(TLVReader &reader, const uint8_t *buffer, const TLVWriter &writer)
+{
+    reader.Init(buffer, writer.GetLengthWritten());
+    TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+}
+
+static void check_compact_value(const uint8_t *buffer, const TLVWriter &writer, const char *expected)
+{
+    TLVReader reader;
+    init_reader(reader, buffer, writer);
+    char value[64];
+    report_log::format_compact_value(reader, value, sizeof(value));
+    TEST_ASSERT_EQUAL_STRING(expected, value);
+}
+
+TEST_CASE("report log modes are parsed from their names", "[report_log]")
+{
+    static const char *const k_names[] = {"off", "compact", "json", "pretty"};
+    report_log::log_mode_t saved_mode = report_log::get_mode();
+    for (size_t i = 0; i < sizeof(k_names) / sizeof(k_names[0]); ++i) {
+        report_log::log_mode_t mode = report_log::MODE_OFF;
+        TEST_ASSERT_EQUAL(ESP_OK, report_log::mode_from_name(k_names[i], mode));
+        TEST_ASSERT_EQUAL(i, mode);
+        TEST_ASSERT_EQUAL_STRING(k_names[i], report_log::mode_to_name(mode));
+        TEST_ASSERT_EQUAL(ESP_OK, report_log::set_mode(mode));
+        TEST_ASSERT_EQUAL(mode, report_log::get_mode());
+    }
+
+    report_log::log_mode_t mode = report_log::MODE_JSON;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, report_log::mode_from_name("Pretty", mode));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, report_log::mode_from_name("", mode));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, report_log::mode_from_name(nullptr, mode));
+    TEST_ASSERT_EQUAL(report_log::MODE_JSON, mode);
+    TEST_ASSERT_EQUAL_STRING("unknown", report_log::mode_to_name(static_cast<report_log::log_mode_t>(4)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, report_log::set_mode(static_cast<report_log::log_mode_t>(4)));
+    TEST_ASSERT_EQUAL(ESP_OK, report_log::set_mode(saved_mode));
+}
+
+TEST_CASE("report log gives the encoded size of the elements", "[report_log]")
+{
+    uint8_t buffer[k_tlv_buffer_size];
+    uint8_t bytes[300];
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+    TLVWriter writer;
+    TLVReader reader;
+
+    // Scalars with the different tag and value sizes
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.Put(ContextTag(2), static_cast<uint8_t>(5)) == CHIP_NO_ERROR);
+    init_reader(reader, buffer, writer);
+    TEST_ASSERT_EQUAL_UINT32(3, report_log::get_encoded_size(reader));
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.Put(chip::TLV::ProfileTag(0x12345678, 1), static_cast<int64_t>(INT64_MIN)) ==
+                     CHIP_NO_ERROR);
+    init_reader(reader, buffer, writer);
+    TEST_ASSERT_EQUAL_UINT32(writer.GetLengthWritten(), report_log::get_encoded_size(reader));
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.Put(chip::TLV::AnonymousTag(), 1.5) == CHIP_NO_ERROR);
+    init_reader(reader, buffer, writer);
+    TEST_ASSERT_EQUAL_UINT32(9, report_log::get_encoded_size(reader));
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.PutNull(ContextTag(1)) == CHIP_NO_ERROR);
+    init_reader(reader, buffer, writer);
+    TEST_ASSERT_EQUAL_UINT32(2, report_log::get_encoded_size(reader));
+
+    // A string with a length field of two bytes
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.PutBytes(ContextTag(2), bytes, sizeof(bytes)) == CHIP_NO_ERROR);
+    init_reader(reader, buffer, writer);
+    TEST_ASSERT_EQUAL_UINT32(1 + 1 + 2 + sizeof(bytes), report_log::get_encoded_size(reader));
+
+    // Nested containers, then each member of the structure
+    writer.Init(buffer);
+    TLVType outer, inner;
+    TEST_ASSERT_TRUE(writer.StartContainer(ContextTag(2), chip::TLV::kTLVType_Structure, outer) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.Put(ContextTag(0), static_cast<uint32_t>(70000)) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.PutString(ContextTag(1), "abc") == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.StartContainer(ContextTag(2), chip::TLV::kTLVType_Array, inner) == CHIP_NO_ERROR);
+    for (uint8_t i = 0; i < 10; ++i) {
+        TEST_ASSERT_TRUE(writer.Put(chip::TLV::AnonymousTag(), i) == CHIP_NO_ERROR);
+    }
+    TEST_ASSERT_TRUE(writer.EndContainer(inner) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.EndContainer(outer) == CHIP_NO_ERROR);
+    init_reader(reader, buffer, writer);
+    TEST_ASSERT_EQUAL_UINT32(writer.GetLengthWritten(), report_log::get_encoded_size(reader));
+
+    // The reader is not moved
+    TEST_ASSERT_EQUAL(chip::TLV::kTLVType_Structure, reader.GetType());
+    TEST_ASSERT_TRUE(reader.EnterContainer(outer) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL_UINT32(1 + 1 + 4, report_log::get_encoded_size(reader));
+    TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL_UINT32(1 + 1 + 1 + 3, report_log::get_encoded_size(reader));
+    TEST_ASSERT_TRUE(reader.Next() == CHIP_NO_ERROR);
+    TEST_ASSERT_EQUAL_UINT32(1 + 1 + 10 * 2 + 1, report_log::get_encoded_size(reader));
+
+    // No element
+    reader.Init(buffer, writer.GetLengthWritten());
+    TEST_ASSERT_EQUAL_UINT32(0, report_log::get_encoded_size(reader));
+}
+
+TEST_CASE("report log formats the compact values", "[report_log]")
+{
+    uint8_t buffer[k_tlv_buffer_size];
+    TLVWriter writer;
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.Put(ContextTag(2), static_cast<int32_t>(-5)) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "-5");
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.Put(ContextTag(2), static_cast<uint64_t>(UINT64_MAX)) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "18446744073709551615");
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.PutBoolean(ContextTag(2), true) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "true");
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.Put(ContextTag(2), 1.5f) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "1.5");
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.PutNull(ContextTag(2)) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "null");
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.PutString(ContextTag(2), "abc") == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "str[3] 616263");
+
+    // Only the first 16 bytes of a string are printed
+    uint8_t bytes[20];
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.PutBytes(ContextTag(2), bytes, sizeof(bytes)) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "bytes[20] 000102030405060708090a0b0c0d0e0f...");
+
+    // The containers are given with their encoded size
+    TLVType outer;
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.StartContainer(ContextTag(2), chip::TLV::kTLVType_Structure, outer) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.Put(ContextTag(0), static_cast<uint8_t>(1)) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.EndContainer(outer) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "struct(6 bytes)");
+
+    writer.Init(buffer);
+    TEST_ASSERT_TRUE(writer.StartContainer(ContextTag(2), chip::TLV::kTLVType_Array, outer) == CHIP_NO_ERROR);
+    TEST_ASSERT_TRUE(writer.EndContainer(outer) == CHIP_NO_ERROR);
+    check_compact_value(buffer, writer, "array(3 bytes)");
+
+    // The text is truncated to the buffer
+    TLVReader reader;
+    init_reader(reader, buffer, writer);
+    char value[6];
+    report_log::format_compact_value(reader, value, sizeof(value));
+    TEST_ASSERT_EQUAL_STRING("array", value);
+}
+
+#endif // CONFIG_ESP_MATTER_CONTROLLER_ENABLE
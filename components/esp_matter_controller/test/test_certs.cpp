@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <test_certs.h>
+
+#include <esp_random.h>
+#include <mbedtls/bignum.h>
+#include <mbedtls/pem.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/x509_crt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace esp_matter::test {
+
+static int fill_random(void *ctx, unsigned char *buf, size_t len)
+{
+    esp_fill_random(buf, len);
+    return 0;
+}
+
+esp_err_t test_cert_generate(const char *common_name, test_cert_t &cert)
+{
+    static uint32_t s_serial_number = 1;
+    char name[64];
+    snprintf(name, sizeof(name), "CN=%s", common_name);
+    // mbedtls writes the DER certificate at the end of the buffer
+    static uint8_t buf[1024];
+
+    mbedtls_pk_context key;
+    mbedtls_x509write_cert crt;
+    mbedtls_mpi serial;
+    mbedtls_pk_init(&key);
+    mbedtls_x509write_crt_init(&crt);
+    mbedtls_mpi_init(&serial);
+    int len = mbedtls_pk_setup(&key, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY));
+    if (len == 0) {
+        len = mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, mbedtls_pk_ec(key), fill_random, nullptr);
+    }
+    if (len == 0) {
+        len = mbedtls_mpi_lset(&serial, s_serial_number++);
+    }
+    if (len == 0) {
+        mbedtls_x509write_crt_set_version(&crt, MBEDTLS_X509_CRT_VERSION_3);
+        mbedtls_x509write_crt_set_md_alg(&crt, MBEDTLS_MD_SHA256);
+        mbedtls_x509write_crt_set_subject_key(&crt, &key);
+        mbedtls_x509write_crt_set_issuer_key(&crt, &key);
+        len = mbedtls_x509write_crt_set_subject_name(&crt, name);
+    }
+    if (len == 0) {
+        len = mbedtls_x509write_crt_set_issuer_name(&crt, name);
+    }
+    if (len == 0) {
+        len = mbedtls_x509write_crt_set_serial(&crt, &serial);
+    }
+    if (len == 0) {
+        len = mbedtls_x509write_crt_set_validity(&crt, "20240101000000", "20991231235959");
+    }
+    if (len == 0) {
+        len = mbedtls_x509write_crt_set_basic_constraints(&crt, 1, 1);
+    }
+    if (len == 0) {
+        len = mbedtls_x509write_crt_set_subject_key_identifier(&crt);
+    }
+    if (len == 0) {
+        len = mbedtls_x509write_crt_der(&crt, buf, sizeof(buf), fill_random, nullptr);
+    }
+    mbedtls_mpi_free(&serial);
+    mbedtls_x509write_crt_free(&crt);
+    mbedtls_pk_free(&key);
+    if (len <= 0 || static_cast<size_t>(len) > sizeof(cert.der)) {
+        return ESP_FAIL;
+    }
+    memcpy(cert.der, buf + sizeof(buf) - len, len);
+    cert.der_len = static_cast<size_t>(len);
+
+    chip::MutableByteSpan skid(cert.skid);
+    if (chip::Crypto::ExtractSKIDFromX509Cert(chip::ByteSpan(cert.der, cert.der_len), skid) != CHIP_NO_ERROR ||
+            skid.size() != sizeof(cert.skid)) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t test_cert_to_pem(const test_cert_t &cert, char *pem, size_t pem_size)
+{
+    size_t len = 0;
+    int ret = mbedtls_pem_write_buffer("-----BEGIN CERTIFICATE-----\n", "-----END CERTIFICATE-----\n", cert.der,
+                                       cert.der_len, reinterpret_cast<unsigned char *>(pem), pem_size, &len);
+    return ret == 0 ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+// ecdsa-with-SHA256 AlgorithmIdentifier
+static const uint8_t k_ecdsa_with_sha256[] = {0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02};
+// BIT STRING of an ECDSA-Sig-Value of r = s = 1
+static const uint8_t k_placeholder_signature[] = {0x03, 0x09, 0x00, 0x30, 0x06, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01};
+static const char k_this_update[] = "250101000000Z";
+static const char k_next_update[] = "20991231235959Z";
+static const char k_revocation_date[] = "250101000000Z";
+
+static size_t get_der_header_len(size_t len)
+{
+    return len < 0x80 ? 2 : len < 0x100 ? 3 : len < 0x10000 ? 4 : 5;
+}
+
+// Write a DER tag and length, the content is written after it
+static uint8_t *write_der_header(uint8_t *p, uint8_t tag, size_t len)
+{
+    *p++ = tag;
+    if (len < 0x80) {
+        *p++ = static_cast<uint8_t>(len);
+        return p;
+    }
+    size_t len_bytes = get_der_header_len(len) - 2;
+    *p++ = static_cast<uint8_t>(0x80 | len_bytes);
+    for (size_t i = len_bytes; i > 0; --i) {
+        *p++ = static_cast<uint8_t>(len >> (8 * (i - 1)));
+    }
+    return p;
+}
+
+static uint8_t *write_der(uint8_t *p, uint8_t tag, const void *content, size_t len)
+{
+    p = write_der_header(p, tag, len);
+    memcpy(p, content, len);
+    return p + len;
+}
+
+size_t test_crl_get_serial_number(size_t index, uint8_t *serial, size_t serial_size)
+{
+    if (serial_size < k_test_crl_serial_number_len) {
+        return 0;
+    }
+    // A positive INTEGER whose first byte is not 0
+    const uint8_t prefix[] = {0x4D, 0x41, 0x54, 0x54};
+    memcpy(serial, prefix, sizeof(prefix));
+    for (size_t i = 0; i < 4; ++i) {
+        serial[sizeof(prefix) + i] = static_cast<uint8_t>(index >> (8 * (3 - i)));
+    }
+    return k_test_crl_serial_number_len;
+}
+
+esp_err_t test_crl_generate(const char *issuer_common_name, size_t serial_count, uint8_t **crl, size_t *crl_len)
+{
+    const uint8_t common_name_oid[] = {0x55, 0x04, 0x03};
+    size_t cn_len = strlen(issuer_common_name);
+    size_t attribute_len = 2 + sizeof(common_name_oid) + get_der_header_len(cn_len) + cn_len;
+    size_t rdn_len = get_der_header_len(attribute_len) + attribute_len;
+    size_t name_len = get_der_header_len(rdn_len) + rdn_len;
+    size_t entry_len = 2 + k_test_crl_serial_number_len + 2 + strlen(k_revocation_date);
+    size_t revoked_len = serial_count * (get_der_header_len(entry_len) + entry_len);
+    size_t tbs_len = 3 + sizeof(k_ecdsa_with_sha256) + get_der_header_len(name_len) + name_len + 2 +
+                     strlen(k_this_update) + 2 + strlen(k_next_update) +
+                     (serial_count ? get_der_header_len(revoked_len) + revoked_len : 0);
+    size_t cert_list_len = get_der_header_len(tbs_len) + tbs_len + sizeof(k_ecdsa_with_sha256) +
+                           sizeof(k_placeholder_signature);
+    size_t len = get_der_header_len(cert_list_len) + cert_list_len;
+    uint8_t *buf = static_cast<uint8_t *>(malloc(len));
+    if (!buf) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // CertificateList ::= SEQUENCE { tbsCertList, signatureAlgorithm, signatureValue }
+    uint8_t *p = write_der_header(buf, 0x30, cert_list_len);
+    p = write_der_header(p, 0x30, tbs_len);
+    // version v2
+    const uint8_t version = 1;
+    p = write_der(p, 0x02, &version, sizeof(version));
+    memcpy(p, k_ecdsa_with_sha256, sizeof(k_ecdsa_with_sha256));
+    p += sizeof(k_ecdsa_with_sha256);
+    // issuer ::= SEQUENCE { SET { SEQUENCE { commonName, UTF8String } } }
+    p = write_der_header(p, 0x30, name_len);
+    p = write_der_header(p, 0x31, rdn_len);
+    p = write_der_header(p, 0x30, attribute_len);
+    p = write_der(p, 0x06, common_name_oid, sizeof(common_name_oid));
+    p = write_der(p, 0x0C, issuer_common_name, cn_len);
+    p = write_der(p, 0x17, k_this_update, strlen(k_this_update));
+    p = write_der(p, 0x18, k_next_update, strlen(k_next_update));
+    if (serial_count) {
+        p = write_der_header(p, 0x30, revoked_len);
+        for (size_t i = 0; i < serial_count; ++i) {
+            uint8_t serial[k_test_crl_serial_number_len];
+            test_crl_get_serial_number(i, serial, sizeof(serial));
+            p = write_der_header(p, 0x30, entry_len);
+            p = write_der(p, 0x02, serial, sizeof(serial));
+            p = write_der(p, 0x17, k_revocation_date, strlen(k_revocation_date));
+        }
+    }
+    memcpy(p, k_ecdsa_with_sha256, sizeof(k_ecdsa_with_sha256));
+    p += sizeof(k_ecdsa_with_sha256);
+    memcpy(p, k_placeholder_signature, sizeof(k_placeholder_signature));
+    p += sizeof(k_placeholder_signature);
+    if (static_cast<size_t>(p - buf) != len) {
+        free(buf);
+        return ESP_FAIL;
+    }
+    *crl = buf;
+    *crl_len = len;
+    return ESP_OK;
+}
+
+} // namespace esp_matter::test
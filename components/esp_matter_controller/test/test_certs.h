@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <credentials/CHIPCert.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter::test {
+
+struct test_cert_t {
+    uint8_t der[chip::Credentials::kMaxDERCertLength];
+    size_t der_len;
+    uint8_t skid[chip::Crypto::kSubjectKeyIdentifierLength];
+};
+
+/** Generate a self-signed P-256 CA certificate, like a PAA certificate
+ *
+ * @param[in] common_name Common name of the subject
+ * @param[out] cert The certificate and its SKID
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t test_cert_generate(const char *common_name, test_cert_t &cert);
+
+/** Encode a certificate in PEM format
+ *
+ * @param[in] cert The certificate
+ * @param[out] pem The NULL-terminated PEM certificate
+ * @param[in] pem_size Size of the pem buffer
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t test_cert_to_pem(const test_cert_t &cert, char *pem, size_t pem_size);
+
+// Length of the serial numbers of the CRLs of test_crl_generate()
+constexpr size_t k_test_crl_serial_number_len = 8;
+
+/** Get the serial number of a revoked certificate of the CRLs of test_crl_generate()
+ *
+ * @param[in] index Index of the revoked certificate in the CRL
+ * @param[out] serial The serial number
+ * @param[in] serial_size Size of the serial buffer, at least k_test_crl_serial_number_len
+ *
+ * @return The length of the serial number, 0 if the buffer is too small
+ */
+size_t test_crl_get_serial_number(size_t index, uint8_t *serial, size_t serial_size);
+
+/** Generate a DER CRL revoking the serial numbers of test_crl_get_serial_number() for the indexes below serial_count
+ *
+ * MbedTLS has no CRL writer, the CRL is encoded by hand with a placeholder signature, which MbedTLS does not verify
+ * when parsing the CRL. The nextUpdate of the CRL is 2099-12-31.
+ *
+ * @param[in] issuer_common_name Common name of the issuer
+ * @param[in] serial_count Number of revoked serial numbers
+ * @param[out] crl The CRL, to be freed with free()
+ * @param[out] crl_len Length of the CRL
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t test_crl_generate(const char *issuer_common_name, size_t serial_count, uint8_t **crl, size_t *crl_len);
+
+} // namespace esp_matter::test
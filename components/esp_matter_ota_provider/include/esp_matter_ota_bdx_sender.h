@@ -24,6 +24,8 @@
 namespace esp_matter {
 namespace ota_provider {
 
+struct ota_prefetcher;
+
 class OtaBdxSender : public chip::bdx::Responder {
 public:
     enum BdxSenderErr {
@@ -56,6 +58,21 @@ public:
         return mOtaImageUrl;
     }
 
+    // Identify the image of the transfer in the OTA image cache, checksum is the SHA-256 of the image published in the
+    // DCL or nullptr if there is none, in which case the image is not cached.
+    void SetOtaImageInfo(uint16_t vendorId, uint16_t productId, uint32_t softwareVersion, size_t size,
+                         const uint8_t *checksum)
+    {
+        mVendorId = vendorId;
+        mProductId = productId;
+        mSoftwareVersion = softwareVersion;
+        mOtaImageDclSize = size;
+        mOtaImageChecksumValid = checksum != nullptr;
+        if (checksum) {
+            memcpy(mOtaImageChecksum, checksum, sizeof(mOtaImageChecksum));
+        }
+    }
+
 private:
     void HandleTransferSessionOutput(chip::bdx::TransferSession::OutputEvent &event) override;
 
@@ -63,8 +80,22 @@ private:
 
     void Reset();
 
+    // Start reading the image from the OTA image cache, or downloading it
+    esp_err_t StartImageSource();
+
+    // Answer the pending BlockQuery if its block has been downloaded
+    void SendPendingBlock();
+
+    void LogTransferStats();
+
     uint64_t mNumBytesSent = 0;
 
+    // A BlockQuery is waiting for its block to be downloaded
+    bool mBlockQueryPending = false;
+
+    // Number of BlockQuery received before their block was downloaded
+    uint32_t mStalledQueries = 0;
+
     bool mInitialized = false;
 
     chip::Optional<chip::FabricIndex> mFabricIndex;
@@ -72,7 +103,14 @@ private:
 
     char mOtaImageUrl[OTA_URL_MAX_LEN];
     uint64_t mOtaImageSize;
-    esp_http_client_handle_t mHttpDownloader = nullptr;
+    ota_prefetcher *mPrefetcher = nullptr;
+
+    uint16_t mVendorId = 0;
+    uint16_t mProductId = 0;
+    uint32_t mSoftwareVersion = 0;
+    size_t mOtaImageDclSize = 0;
+    uint8_t mOtaImageChecksum[32];
+    bool mOtaImageChecksumValid = false;
 };
 
 } // namespace ota_provider
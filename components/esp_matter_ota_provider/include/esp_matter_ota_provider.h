@@ -30,6 +30,20 @@
 namespace esp_matter {
 namespace ota_provider {
 
+/** Statistics of the OTA image cache */
+typedef struct {
+    /* Transfers served from the cache */
+    uint32_t hits;
+    /* Transfers downloading the image */
+    uint32_t misses;
+    /* Images added to the cache */
+    uint32_t stored;
+    /* Images evicted from the cache */
+    uint32_t evicted;
+    /* Downloaded images not cached because they did not match the DCL size or checksum */
+    uint32_t rejected;
+} ota_image_cache_stats_t;
+
 class EspOtaProvider : public chip::app::Clusters::OTAProviderDelegate {
 public:
     using OTAQueryStatus = chip::app::Clusters::OtaSoftwareUpdateProvider::OTAQueryStatus;
@@ -38,6 +52,7 @@ public:
     static constexpr size_t kUriMaxLen = 256;
     static constexpr uint8_t kUpdateTokenLen = 32;
     static constexpr uint8_t kUpdateTokenStrLen = kUpdateTokenLen * 2 + 1;
+    static constexpr size_t kOtaImageChecksumLen = 32;
     struct EspOtaRequestorEntry {
         chip::ScopedNodeId mNodeId;
         bool mOtaAllowed;
@@ -47,6 +62,10 @@ public:
         char mImageUri[kUriMaxLen];
         char mOtaImageUrl[OTA_URL_MAX_LEN];
         size_t mOtaImageSize;
+        uint8_t mOtaImageChecksum[kOtaImageChecksumLen];
+        bool mOtaImageChecksumValid;
+        uint16_t mVendorId;
+        uint16_t mProductId;
         uint32_t mSoftwareVersion;
         char mSoftwareVersionString[SOFTWARE_VERSION_STR_MAX_LEN];
         EspOtaRequestorEntry *mNext;
@@ -93,7 +112,12 @@ public:
     }
 
     static void FetchImageDoneCallback(OTAQueryStatus status, const char *imageUrl, size_t imageSize,
-                                       uint32_t softwareVersion, const char *softwareVersionStr, void *arg);
+                                       const uint8_t *imageChecksum, uint32_t softwareVersion,
+                                       const char *softwareVersionStr, void *arg);
+
+    // Get the statistics of the OTA image cache, ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    // is disabled.
+    esp_err_t GetImageCacheStats(ota_image_cache_stats_t &stats);
 
     // When the OTA Provider receives a QueryImage command from an OTA Requestor and there is no existing entry for the
     // Requestor node, the Provider will create an OTA Requestor Entry for the requestor, and set the entry's
@@ -30,17 +30,24 @@ typedef struct {
     uint32_t max_applicable_software_version;
     char ota_url[OTA_URL_MAX_LEN];
     uint32_t ota_file_size;
-    uint32_t lifetime;
+    /* SHA-256 of the image published in the DCL, valid if ota_checksum_valid is set */
+    uint8_t ota_checksum[32];
+    bool ota_checksum_valid;
 } model_version_t;
 
 typedef void (*fetch_ota_image_done_callback_t)(EspOtaProvider::OTAQueryStatus status, const char *imageUrl,
-                                                size_t imageSize, uint32_t softwareVersion,
-                                                const char *softwareVersionStr, void *ctx);
+                                                size_t imageSize, const uint8_t *imageChecksum,
+                                                uint32_t softwareVersion, const char *softwareVersionStr, void *ctx);
 
 esp_err_t fetch_ota_candidate(const uint16_t vendor_id, const uint16_t product_id, const uint32_t software_version,
                               fetch_ota_image_done_callback_t callback, void *callback_args);
 
 esp_err_t init_ota_candidates();
 
+/** Stop the task of the OTA candidates once the queued fetches are done, the cache is loaded again from the NVS by the
+ *  next init_ota_candidates() if CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT is enabled
+ */
+esp_err_t deinit_ota_candidates();
+
 } // namespace ota_provider
 } // namespace esp_matter
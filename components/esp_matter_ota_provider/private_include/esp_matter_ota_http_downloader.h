@@ -30,6 +30,18 @@ typedef struct ota_image_header_prefix ota_image_header_prefix_t;
 
 constexpr uint32_t k_ota_image_file_identifier = 0x1BEEF11E;
 
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP
+// The transport is given by the scheme of the URL
+constexpr esp_http_client_transport_t k_http_downloader_transport_type = HTTP_TRANSPORT_UNKNOWN;
+#else
+constexpr esp_http_client_transport_t k_http_downloader_transport_type = HTTP_TRANSPORT_OVER_SSL;
+#endif
+
+/** Whether a URL can be used by the OTA provider: https://, or also http:// with
+ *  CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP
+ */
+bool http_downloader_is_url_allowed(const char *url);
+
 int http_downloader_read(esp_http_client_handle_t http_client, char *buf, size_t size);
 
 void http_downloader_abort(esp_http_client_handle_t http_client);
@@ -0,0 +1,89 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_ota_provider.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace ota_provider {
+
+/** Cache of the OTA images downloaded by the BDX sender
+ *
+ * The images are stored in a SPIFFS partition, one file per VendorID, ProductID and software version. An image is
+ * written while it is downloaded for a requestor and it is only kept if its SHA-256 matches the checksum published in
+ * the DCL, so the next requestors of the same image are served from the flash.
+ *
+ * An image is staged in a temporary file and the cached images are only evicted once its checksum has been verified:
+ * the least recently used image is replaced when the cache is full, and the least recently used images are evicted
+ * until the partition has room to stage the largest image requested so far. A failed or corrupted transfer never
+ * evicts a cached image.
+ */
+
+constexpr size_t k_ota_image_checksum_len = 32;
+
+/** Mount the cache partition and index the images it contains */
+esp_err_t ota_image_cache_init();
+
+/** Get the file of a cached image
+ *
+ * @param[in] vendor_id VendorID of the image
+ * @param[in] product_id ProductID of the image
+ * @param[in] software_version Software version of the image
+ * @param[out] path Path of the file
+ * @param[in] path_size Size of the path buffer
+ *
+ * @return ESP_OK if the image is cached, this counts as a hit.
+ * @return ESP_ERR_NOT_FOUND if the image is not cached, this counts as a miss.
+ */
+esp_err_t ota_image_cache_get_path(uint16_t vendor_id, uint16_t product_id, uint32_t software_version, char *path,
+                                   size_t path_size);
+
+typedef struct ota_image_cache_writer *ota_image_cache_writer_handle_t;
+
+/** Start staging an image in the cache, no image is evicted until the staged image has been verified
+ *
+ * @param[in] vendor_id VendorID of the image
+ * @param[in] product_id ProductID of the image
+ * @param[in] software_version Software version of the image
+ * @param[in] size Size of the image given by the DCL
+ * @param[in] checksum SHA-256 of the image given by the DCL
+ * @param[out] handle Handle of the writer
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM if the partition has no free space to stage the image.
+ * @return error if the image cannot be cached.
+ */
+esp_err_t ota_image_cache_writer_open(uint16_t vendor_id, uint16_t product_id, uint32_t software_version, size_t size,
+                                      const uint8_t checksum[k_ota_image_checksum_len],
+                                      ota_image_cache_writer_handle_t *handle);
+
+/** Write the next block of the image
+ *
+ * The image is added to the cache after its last block if its checksum is valid. The writer is released after the
+ * last block, or when data is NULL, which discards the image. If a block cannot be written, for example when the image
+ * is larger than the size given by the DCL, the next blocks are dropped and the image is discarded after the last one.
+ *
+ * This function has the signature of ota_prefetcher_sink_t, with the writer handle as context.
+ */
+void ota_image_cache_writer_write(const uint8_t *data, size_t len, bool eof, void *ctx);
+
+/** Get the statistics of the cache */
+void ota_image_cache_get_stats(ota_image_cache_stats_t *stats);
+
+} // namespace ota_provider
+} // namespace esp_matter
@@ -0,0 +1,101 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_http_client.h>
+
+namespace esp_matter {
+namespace ota_provider {
+
+/** Downloader of an OTA image which reads the next blocks ahead
+ *
+ * A background task connects to the image URL and downloads the blocks into a ring of block_count buffers while the
+ * previous blocks are sent to the requestor, so the BDX queries are answered without waiting for the HTTP server in
+ * the Matter task.
+ */
+typedef struct ota_prefetcher *ota_prefetcher_handle_t;
+
+/** Statistics of a download */
+typedef struct {
+    uint64_t bytes;
+    uint32_t blocks;
+    /* Time from the start of the prefetcher to the download of the last block */
+    int64_t time_us;
+} ota_prefetcher_stats_t;
+
+/** Sink receiving a copy of the downloaded blocks in the background task
+ *
+ * It is called for every block, eof is set for the last one. It is called once with a NULL block if the download fails
+ * or is stopped before the last block.
+ */
+typedef void (*ota_prefetcher_sink_t)(const uint8_t *data, size_t len, bool eof, void *ctx);
+
+/** Start downloading an image
+ *
+ * @param[in] config HTTP client configuration of the image, the URL is copied
+ * @param[in] block_size Size of the blocks
+ * @param[in] block_count Number of blocks read ahead
+ * @param[in] sink Optional sink of the downloaded blocks
+ * @param[in] sink_ctx Context of the sink
+ * @param[out] handle Handle of the prefetcher
+ *
+ * @return ESP_OK on success, the connection is established by the background task.
+ * @return error in case of failure, the sink is not called.
+ */
+esp_err_t ota_prefetcher_start(const esp_http_client_config_t *config, size_t block_size, size_t block_count,
+                               ota_prefetcher_sink_t sink, void *sink_ctx, ota_prefetcher_handle_t *handle);
+
+/** Start reading an image from a file, the blocks are read ahead in the same way as the downloaded blocks
+ *
+ * @param[in] path Path of the file, the path is copied
+ * @param[in] block_size Size of the blocks
+ * @param[in] block_count Number of blocks read ahead
+ * @param[out] handle Handle of the prefetcher
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t ota_prefetcher_start_from_file(const char *path, size_t block_size, size_t block_count,
+                                         ota_prefetcher_handle_t *handle);
+
+/** Get the next block without blocking
+ *
+ * @param[in] handle Handle of the prefetcher
+ * @param[out] data Data of the block, valid until ota_prefetcher_release_block() or ota_prefetcher_stop()
+ * @param[out] len Length of the block, shorter than the block size for the last block
+ * @param[out] eof Whether this is the last block of the image
+ *
+ * @return ESP_OK if the block is downloaded.
+ * @return ESP_ERR_NOT_FINISHED if the block is still being downloaded.
+ * @return ESP_FAIL if the download failed.
+ */
+esp_err_t ota_prefetcher_get_block(ota_prefetcher_handle_t handle, const uint8_t **data, size_t *len, bool *eof);
+
+/** Release the block given by ota_prefetcher_get_block(), so its buffer can receive a next block */
+void ota_prefetcher_release_block(ota_prefetcher_handle_t handle);
+
+/** Get the statistics of the download */
+void ota_prefetcher_get_stats(ota_prefetcher_handle_t handle, ota_prefetcher_stats_t *stats);
+
+/** Stop the download and release the prefetcher
+ *
+ * This function does not wait for the background task, which releases the buffers and the HTTP client when its
+ * ongoing read returns.
+ */
+void ota_prefetcher_stop(ota_prefetcher_handle_t handle);
+
+} // namespace ota_provider
+} // namespace esp_matter
@@ -16,6 +16,9 @@
 #include <esp_log.h>
 #include <esp_matter_ota_bdx_sender.h>
 #include <esp_matter_ota_http_downloader.h>
+#include <esp_matter_ota_image_cache.h>
+#include <esp_matter_ota_prefetcher.h>
+#include <inttypes.h>
 
 #include <lib/core/CHIPError.h>
 #include <lib/support/BitFlags.h>
@@ -81,6 +84,9 @@ void OtaBdxSender::HandleTransferSessionOutput(TransferSession::OutputEvent &eve
     }
     switch (event.EventType) {
     case TransferSession::OutputEventType::kNone:
+        if (mBlockQueryPending) {
+            SendPendingBlock();
+        }
         break;
     case TransferSession::OutputEventType::kMsgToSend: {
         chip::Messaging::SendFlags sendFlags;
@@ -117,57 +123,23 @@ void OtaBdxSender::HandleTransferSessionOutput(TransferSession::OutputEvent &eve
             ESP_LOGE(TAG, "AcceptTransfter failed error:%" CHIP_ERROR_FORMAT, err.Format());
             return;
         }
-        // Establish http connection
-        esp_http_client_config_t config = {
-            .url = mOtaImageUrl,
-            .event_handler = NULL,
-            .transport_type = HTTP_TRANSPORT_OVER_SSL,
-            .skip_cert_common_name_check = false,
-            .crt_bundle_attach = esp_crt_bundle_attach,
-            .keep_alive_enable = true,
-        };
-        if (mHttpDownloader) {
-            http_downloader_abort(mHttpDownloader);
+        if (mPrefetcher) {
+            ota_prefetcher_stop(mPrefetcher);
+            mPrefetcher = nullptr;
         }
-        if (http_downloader_start(&config, &mHttpDownloader) != ESP_OK) {
+        mBlockQueryPending = false;
+        mStalledQueries = 0;
+        if (StartImageSource() != ESP_OK) {
             LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
         }
         break;
     }
     case TransferSession::OutputEventType::kQueryReceived: {
-        TransferSession::BlockData blockData;
-        uint16_t bytesToRead = mTransfer.GetTransferBlockSize();
-
-        chip::System::PacketBufferHandle blockBuf = chip::System::PacketBufferHandle::New(bytesToRead);
-        if (blockBuf.IsNull()) {
-            LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
-            return;
-        }
-        // Read http response
-        int bytes_read =
-            http_downloader_read(mHttpDownloader, reinterpret_cast<char *>(blockBuf->Start()), bytesToRead);
-        if (bytes_read < 0) {
-            ESP_LOGE(TAG, "http_downloader_read failed");
-            LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
-            break;
-        }
-        if (mOtaImageSize == 0 && mNumBytesSent == 0) {
-            if (ParseOtaImageHeader(blockBuf->Start(), static_cast<size_t>(bytes_read)) != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to Parse OTA image header");
-                LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
-                break;
-            }
-        }
-        blockData.Data = blockBuf->Start();
-        blockData.Length =
-            static_cast<size_t>(std::min(static_cast<uint64_t>(bytes_read), (mOtaImageSize - mNumBytesSent)));
-        blockData.IsEof = (blockData.Length < bytesToRead) ||
-                          (mNumBytesSent + static_cast<uint64_t>(blockData.Length) == mOtaImageSize);
-        mNumBytesSent = static_cast<uint64_t>(mNumBytesSent + blockData.Length);
-
-        if (CHIP_NO_ERROR != mTransfer.PrepareBlock(blockData)) {
-            ESP_LOGE(TAG, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
-            LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
+        // The block is sent when it has been downloaded, at the latest on one of the next polls of the transfer
+        mBlockQueryPending = true;
+        SendPendingBlock();
+        if (mBlockQueryPending) {
+            mStalledQueries++;
         }
         break;
     }
@@ -175,6 +147,7 @@ void OtaBdxSender::HandleTransferSessionOutput(TransferSession::OutputEvent &eve
         break;
     case TransferSession::OutputEventType::kAckEOFReceived: {
         ESP_LOGI(TAG, "Transfer completed, got AckEOF");
+        LogTransferStats();
         Reset();
         break;
     }
@@ -202,6 +175,98 @@ void OtaBdxSender::HandleTransferSessionOutput(TransferSession::OutputEvent &eve
     return;
 }
 
+esp_err_t OtaBdxSender::StartImageSource()
+{
+    size_t block_size = mTransfer.GetTransferBlockSize();
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    char path[64];
+    if (ota_image_cache_get_path(mVendorId, mProductId, mSoftwareVersion, path, sizeof(path)) == ESP_OK) {
+        ESP_LOGI(TAG, "Serving the OTA image from %s", path);
+        return ota_prefetcher_start_from_file(path, block_size, CONFIG_ESP_MATTER_OTA_PROVIDER_PREFETCH_BLOCKS,
+                                              &mPrefetcher);
+    }
+#endif
+    // The http connection is established by the prefetcher task, which starts downloading the first blocks
+    esp_http_client_config_t config = {
+        .url = mOtaImageUrl,
+        .event_handler = NULL,
+        .transport_type = k_http_downloader_transport_type,
+        .skip_cert_common_name_check = false,
+        .crt_bundle_attach = esp_crt_bundle_attach,
+        .keep_alive_enable = true,
+    };
+    ota_prefetcher_sink_t sink = nullptr;
+    void *sink_ctx = nullptr;
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    // The downloaded image is written through to the cache, it is kept if it matches the DCL checksum
+    ota_image_cache_writer_handle_t writer = nullptr;
+    if (mOtaImageChecksumValid && ota_image_cache_writer_open(mVendorId, mProductId, mSoftwareVersion,
+                                                              mOtaImageDclSize, mOtaImageChecksum, &writer) == ESP_OK) {
+        sink = ota_image_cache_writer_write;
+        sink_ctx = writer;
+    }
+#endif
+    esp_err_t err = ota_prefetcher_start(&config, block_size, CONFIG_ESP_MATTER_OTA_PROVIDER_PREFETCH_BLOCKS, sink,
+                                         sink_ctx, &mPrefetcher);
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    if (err != ESP_OK && writer) {
+        ota_image_cache_writer_write(nullptr, 0, false, writer);
+    }
+#endif
+    return err;
+}
+
+void OtaBdxSender::SendPendingBlock()
+{
+    const uint8_t *data = nullptr;
+    size_t len = 0;
+    bool eof = false;
+    esp_err_t err = ota_prefetcher_get_block(mPrefetcher, &data, &len, &eof);
+    if (err == ESP_ERR_NOT_FINISHED) {
+        return;
+    }
+    mBlockQueryPending = false;
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to download the OTA image");
+        LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
+        return;
+    }
+    if (mOtaImageSize == 0 && mNumBytesSent == 0) {
+        if (ParseOtaImageHeader(data, len) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to Parse OTA image header");
+            LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
+            return;
+        }
+    }
+    TransferSession::BlockData blockData;
+    blockData.Data = data;
+    blockData.Length = static_cast<size_t>(std::min(static_cast<uint64_t>(len), (mOtaImageSize - mNumBytesSent)));
+    blockData.IsEof = eof || (blockData.Length < mTransfer.GetTransferBlockSize()) ||
+                      (mNumBytesSent + static_cast<uint64_t>(blockData.Length) == mOtaImageSize);
+    mNumBytesSent = static_cast<uint64_t>(mNumBytesSent + blockData.Length);
+
+    // The block is copied into the message, so its buffer can receive a next block
+    CHIP_ERROR chip_err = mTransfer.PrepareBlock(blockData);
+    ota_prefetcher_release_block(mPrefetcher);
+    if (CHIP_NO_ERROR != chip_err) {
+        ESP_LOGE(TAG, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, chip_err.Format());
+        LogErrorOnFailure(mTransfer.AbortTransfer(StatusCode::kUnknown));
+    }
+}
+
+void OtaBdxSender::LogTransferStats()
+{
+    if (!mPrefetcher) {
+        return;
+    }
+    ota_prefetcher_stats_t stats;
+    ota_prefetcher_get_stats(mPrefetcher, &stats);
+    ESP_LOGI(TAG, "Downloaded %" PRIu64 " bytes in %" PRIu32 " blocks in %" PRId64 " ms (%" PRIu64
+             " B/s), %" PRIu32 " block queries waited for the download",
+             stats.bytes, stats.blocks, stats.time_us / 1000,
+             stats.time_us > 0 ? stats.bytes * 1000000 / static_cast<uint64_t>(stats.time_us) : 0, mStalledQueries);
+}
+
 void OtaBdxSender::Reset()
 {
     mFabricIndex.ClearValue();
@@ -215,11 +280,17 @@ void OtaBdxSender::Reset()
     mInitialized = false;
     mNumBytesSent = 0;
     mOtaImageSize = 0;
-    if (mHttpDownloader) {
-        // Release current http client
-        http_downloader_abort(mHttpDownloader);
+    mBlockQueryPending = false;
+    mVendorId = 0;
+    mProductId = 0;
+    mSoftwareVersion = 0;
+    mOtaImageDclSize = 0;
+    mOtaImageChecksumValid = false;
+    if (mPrefetcher) {
+        // Release current http client and the prefetched blocks
+        ota_prefetcher_stop(mPrefetcher);
     }
-    mHttpDownloader = nullptr;
+    mPrefetcher = nullptr;
     memset(mOtaImageUrl, 0, sizeof(mOtaImageUrl));
 }
 
@@ -21,7 +21,9 @@
 #include <esp_log.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_ota_candidates.h>
+#include <esp_matter_ota_http_downloader.h>
 #include <esp_matter_ota_provider.h>
+#include <esp_rom_crc.h>
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
@@ -29,11 +31,14 @@
 #include <freertos/task.h>
 #include <functional>
 #include <inttypes.h>
+#include <nvs.h>
 
 #include <lib/core/DataModelTypes.h>
+#include <lib/support/Base64.h>
 #include <lib/support/ScopedMemoryBuffer.h>
 
 #include <string.h>
+#include <strings.h>
 
 using chip::Platform::ScopedMemoryBufferWithSize;
 
@@ -43,18 +48,81 @@ namespace ota_provider {
 static constexpr char TAG[] = "ota_provider";
 #if CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_MAINNET
 static constexpr char dcl_rest_url[] = "https://on.dcl.csa-iot.org/dcl/model/versions";
+static constexpr esp_http_client_transport_t dcl_transport_type = HTTP_TRANSPORT_OVER_SSL;
 #elif CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_TESTNET
 static constexpr char dcl_rest_url[] = "https://on.test-net.dcl.csa-iot.org/dcl/model/versions";
+static constexpr esp_http_client_transport_t dcl_transport_type = HTTP_TRANSPORT_OVER_SSL;
+#elif CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_CUSTOM
+static constexpr char dcl_rest_url[] = CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_CUSTOM_URL "/dcl/model/versions";
+static constexpr esp_http_client_transport_t dcl_transport_type = k_http_downloader_transport_type;
 #endif
 static constexpr size_t max_ota_candidate_count = CONFIG_ESP_MATTER_MAX_OTA_CANDIDATES_COUNT;
+// Number of the newest software versions of a model kept in its cache entry, the older versions are searched in the
+// full list of the DCL
+static constexpr size_t max_cached_software_version_count = 16;
+// Number of the requestor software versions without candidate remembered by a cache entry
+static constexpr size_t max_no_candidate_version_count = 4;
+static constexpr size_t etag_max_len = 64;
+static constexpr size_t last_modified_max_len = 32;
+static constexpr size_t ota_candidates_bucket_count = 2 * max_ota_candidate_count;
+static constexpr uint8_t invalid_entry_index = UINT8_MAX;
+static_assert(max_ota_candidate_count < invalid_entry_index, "Too many OTA candidates");
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+static constexpr char ota_candidates_nvs_namespace[] = "ota_candidates";
+#endif
+
+// Validators of the software version list of a model given by the DCL, sent back in the conditional requests
+typedef struct {
+    char etag[etag_max_len];
+    char last_modified[last_modified_max_len];
+} dcl_validators_t;
+
+// Part of a cache entry which is stored in the NVS
+typedef struct {
+    // The software_version is 0 if there is no candidate for the last requestor of the model
+    model_version_t candidate;
+    dcl_validators_t validators;
+    // The newest software versions of the model, in descending order
+    uint32_t software_versions[max_cached_software_version_count];
+    uint8_t software_version_count;
+    // The DCL lists more software versions than the cached ones
+    bool software_versions_truncated;
+} ota_candidate_record_t;
 
-static model_version_t *_ota_candidates_cache[max_ota_candidate_count];
+typedef struct {
+    ota_candidate_record_t record;
+    bool used;
+    // The software version list was validated with the DCL at validated_time
+    bool validated;
+    int64_t validated_time;
+    uint32_t last_used;
+    // CRC of the record last stored in the NVS, 0 if it is not stored
+    uint32_t stored_crc;
+    // Requestor software versions for which no candidate was found in the current software version list
+    uint32_t no_candidate_versions[max_no_candidate_version_count];
+    uint8_t no_candidate_version_count;
+    uint8_t no_candidate_version_next;
+    // Next entry in the same bucket
+    uint8_t next;
+} ota_candidate_entry_t;
+
+static ota_candidate_entry_t _ota_candidates_cache[max_ota_candidate_count];
+static uint8_t _ota_candidates_buckets[ota_candidates_bucket_count];
+static uint32_t _ota_candidates_use_counter = 0;
 static QueueHandle_t _ota_candidate_task_queue = NULL;
 #ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_UPDATE_PERIODICALLY
 static esp_timer_handle_t _ota_candidates_update_timer = NULL;
 #endif
 
+typedef enum {
+    OTA_CANDIDATE_ACTION_FETCH,
+    OTA_CANDIDATE_ACTION_UPDATE_ALL,
+    // Exit the task, callback_args is the semaphore given once the task no longer uses the cache
+    OTA_CANDIDATE_ACTION_STOP,
+} ota_candidate_action_type_t;
+
 typedef struct {
+    ota_candidate_action_type_t type;
     uint16_t vendor_id;
     uint16_t product_id;
     uint32_t software_version;
@@ -69,57 +137,193 @@ static bool _is_ota_candidate_valid(model_version_t *model, uint32_t current_sof
            model->min_applicable_software_version <= current_software_version;
 }
 
-// Search the OTA candidate from the cache, return the index of candidate on success, or return -1 on failure.
-static int _search_ota_candidate_from_cache(uint16_t vendor_id, uint16_t product_id, uint32_t software_ver)
+static size_t _ota_candidates_bucket(uint16_t vendor_id, uint16_t product_id)
 {
-    for (size_t index = 0; index < max_ota_candidate_count; ++index) {
-        model_version_t *cur_model = _ota_candidates_cache[index];
-        if (cur_model) {
-            if (cur_model->vendor_id == vendor_id && cur_model->product_id == product_id) {
-                if (_is_ota_candidate_valid(cur_model, software_ver)) {
-                    return index;
-                } else {
-                    // This candidate is not valid, expire it.
-                    esp_matter_mem_free(cur_model);
-                    _ota_candidates_cache[index] = nullptr;
-                    return -1;
-                }
-            }
+    uint32_t key = (static_cast<uint32_t>(vendor_id) << 16) | product_id;
+    // Fibonacci hashing spreads the product IDs of a vendor, which are usually consecutive
+    return ((key * 2654435761u) >> 8) % ota_candidates_bucket_count;
+}
+
+// Search the cache entry of a model, return the index of the entry on success, or return -1 on failure.
+static int _search_ota_candidate_from_cache(uint16_t vendor_id, uint16_t product_id)
+{
+    uint8_t index = _ota_candidates_buckets[_ota_candidates_bucket(vendor_id, product_id)];
+    while (index != invalid_entry_index) {
+        model_version_t &model = _ota_candidates_cache[index].record.candidate;
+        if (model.vendor_id == vendor_id && model.product_id == product_id) {
+            return index;
         }
+        index = _ota_candidates_cache[index].next;
     }
     return -1;
 }
 
-static size_t _find_empty_ota_candidates()
+static void _link_ota_candidate(size_t index)
+{
+    ota_candidate_entry_t &entry = _ota_candidates_cache[index];
+    uint8_t &head = _ota_candidates_buckets[_ota_candidates_bucket(entry.record.candidate.vendor_id,
+                                                                   entry.record.candidate.product_id)];
+    entry.next = head;
+    head = static_cast<uint8_t>(index);
+}
+
+static void _unlink_ota_candidate(size_t index)
+{
+    ota_candidate_entry_t &entry = _ota_candidates_cache[index];
+    uint8_t *cur = &_ota_candidates_buckets[_ota_candidates_bucket(entry.record.candidate.vendor_id,
+                                                                   entry.record.candidate.product_id)];
+    while (*cur != invalid_entry_index) {
+        if (*cur == index) {
+            *cur = entry.next;
+            break;
+        }
+        cur = &_ota_candidates_cache[*cur].next;
+    }
+    entry.next = invalid_entry_index;
+}
+
+static void _touch_ota_candidate(size_t index)
+{
+    _ota_candidates_cache[index].last_used = ++_ota_candidates_use_counter;
+}
+
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+static void _get_ota_candidate_nvs_key(size_t index, char *key, size_t key_size)
+{
+    snprintf(key, key_size, "cand%u", static_cast<unsigned>(index));
+}
+#endif
+
+static uint32_t _get_ota_candidate_crc(size_t index)
+{
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t *>(&_ota_candidates_cache[index].record),
+                            sizeof(ota_candidate_record_t));
+}
+
+// The record is only written if it changed since it was last stored
+static void _store_ota_candidate(size_t index)
+{
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+    uint32_t crc = _get_ota_candidate_crc(index);
+    if (crc == _ota_candidates_cache[index].stored_crc) {
+        return;
+    }
+    nvs_handle_t handle;
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    _get_ota_candidate_nvs_key(index, key, sizeof(key));
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, ota_candidates_nvs_namespace,
+                                            NVS_READWRITE, &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, key, &_ota_candidates_cache[index].record, sizeof(ota_candidate_record_t));
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to store OTA candidate %u: %s", static_cast<unsigned>(index), esp_err_to_name(err));
+        return;
+    }
+    _ota_candidates_cache[index].stored_crc = crc;
+#endif
+}
+
+static void _erase_ota_candidate(size_t index)
+{
+    _unlink_ota_candidate(index);
+    memset(&_ota_candidates_cache[index], 0, sizeof(ota_candidate_entry_t));
+    _ota_candidates_cache[index].next = invalid_entry_index;
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+    nvs_handle_t handle;
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    _get_ota_candidate_nvs_key(index, key, sizeof(key));
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, ota_candidates_nvs_namespace, NVS_READWRITE,
+                                &handle) == ESP_OK) {
+        if (nvs_erase_key(handle, key) == ESP_OK) {
+            nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+#endif
+}
+
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+static void _load_ota_candidates()
 {
-    uint32_t oldest_candidate_lifetime = 0;
-    size_t oldest_candidate_index = 0;
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, ota_candidates_nvs_namespace, NVS_READONLY,
+                                &handle) != ESP_OK) {
+        return;
+    }
+    size_t count = 0;
     for (size_t index = 0; index < max_ota_candidate_count; ++index) {
-        if (!_ota_candidates_cache[index]) {
-            return index;
-        } else {
-            if (oldest_candidate_lifetime < _ota_candidates_cache[index]->lifetime) {
-                oldest_candidate_lifetime = _ota_candidates_cache[index]->lifetime;
-                oldest_candidate_index = index;
-            }
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        _get_ota_candidate_nvs_key(index, key, sizeof(key));
+        ota_candidate_entry_t &entry = _ota_candidates_cache[index];
+        size_t size = sizeof(ota_candidate_record_t);
+        // The records written by another version of the structure are dropped
+        if (nvs_get_blob(handle, key, &entry.record, &size) != ESP_OK || size != sizeof(ota_candidate_record_t) ||
+                entry.record.software_version_count > max_cached_software_version_count ||
+                _search_ota_candidate_from_cache(entry.record.candidate.vendor_id,
+                                                 entry.record.candidate.product_id) >= 0) {
+            memset(&entry.record, 0, sizeof(entry.record));
+            continue;
         }
+        // The entries loaded from the NVS are revalidated with the DCL before their software version list is used
+        entry.used = true;
+        entry.validated = false;
+        entry.stored_crc = _get_ota_candidate_crc(index);
+        _link_ota_candidate(index);
+        _touch_ota_candidate(index);
+        count++;
     }
-    // expire the oldest candidate
-    esp_matter_mem_free(_ota_candidates_cache[oldest_candidate_index]);
-    _ota_candidates_cache[oldest_candidate_index] = nullptr;
-    return oldest_candidate_index;
+    nvs_close(handle);
+    ESP_LOGI(TAG, "Loaded %u OTA candidates", static_cast<unsigned>(count));
 }
+#endif
 
-static void _increase_ota_candidates_lifetime()
+// Get an entry for a model, the least recently used entry is evicted if the cache is full.
+static size_t _alloc_ota_candidate(uint16_t vendor_id, uint16_t product_id)
 {
+    size_t lru_index = 0;
     for (size_t index = 0; index < max_ota_candidate_count; ++index) {
-        if (_ota_candidates_cache[index]) {
-            _ota_candidates_cache[index]->lifetime++;
+        if (!_ota_candidates_cache[index].used) {
+            lru_index = index;
+            break;
+        }
+        if (_ota_candidates_cache[index].last_used < _ota_candidates_cache[lru_index].last_used) {
+            lru_index = index;
         }
     }
+    if (_ota_candidates_cache[lru_index].used) {
+        _erase_ota_candidate(lru_index);
+    }
+    ota_candidate_entry_t &entry = _ota_candidates_cache[lru_index];
+    entry.used = true;
+    entry.record.candidate.vendor_id = vendor_id;
+    entry.record.candidate.product_id = product_id;
+    _link_ota_candidate(lru_index);
+    _touch_ota_candidate(lru_index);
+    return lru_index;
+}
+
+static esp_err_t _http_event_handler(esp_http_client_event_t *evt)
+{
+    dcl_validators_t *validators = static_cast<dcl_validators_t *>(evt->user_data);
+    if (evt->event_id == HTTP_EVENT_ON_HEADER && validators && evt->header_key && evt->header_value) {
+        if (strcasecmp(evt->header_key, "ETag") == 0) {
+            strlcpy(validators->etag, evt->header_value, sizeof(validators->etag));
+        } else if (strcasecmp(evt->header_key, "Last-Modified") == 0) {
+            strlcpy(validators->last_modified, evt->header_value, sizeof(validators->last_modified));
+        }
+    }
+    return ESP_OK;
 }
 
+// Query the software versions of a model. The request is conditional if the validators of a previous response are
+// given: not_modified is set and the array is not allocated if the DCL answers that the list has not changed.
 static esp_err_t _query_software_version_array(const uint16_t vendor_id, const uint16_t product_id,
+                                               dcl_validators_t &validators, bool &not_modified,
                                                uint32_t **software_version_array, size_t &software_version_count)
 {
     if (!software_version_array) {
@@ -127,12 +331,15 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
     }
     esp_err_t ret = ESP_OK;
     int sw_ver_count = 0, sw_ver_index = 0;
-    char url[100];
+    char url[sizeof(dcl_rest_url) + 16];
+    dcl_validators_t new_validators = {};
     snprintf(url, sizeof(url), "%s/%d/%d", dcl_rest_url, vendor_id, product_id);
     esp_http_client_config_t config = {
         .url = url,
-        .transport_type = HTTP_TRANSPORT_OVER_SSL,
+        .event_handler = _http_event_handler,
+        .transport_type = dcl_transport_type,
         .buffer_size = 1024,
+        .user_data = &new_validators,
         .skip_cert_common_name_check = false,
         .crt_bundle_attach = esp_crt_bundle_attach,
     };
@@ -141,6 +348,7 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
     int http_len, http_status_code;
     cJSON *root = nullptr;
 
+    not_modified = false;
     client = esp_http_client_init(&config);
     if (!client) {
         ESP_LOGE(TAG, "Failed to initialise HTTP Client.");
@@ -148,6 +356,14 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
     }
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "accept", "application/json"), cleanup, TAG,
                       "Failed to set http header accept");
+    if (validators.etag[0]) {
+        ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "If-None-Match", validators.etag), cleanup, TAG,
+                          "Failed to set http header If-None-Match");
+    }
+    if (validators.last_modified[0]) {
+        ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "If-Modified-Since", validators.last_modified), cleanup,
+                          TAG, "Failed to set http header If-Modified-Since");
+    }
     ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_GET), cleanup, TAG, "Failed to set http method");
 
     // HTTP GET
@@ -156,6 +372,11 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
     // Read Response
     http_len = esp_http_client_fetch_headers(client);
     http_status_code = esp_http_client_get_status_code(client);
+    if (http_status_code == 304) {
+        ESP_LOGD(TAG, "Software versions of %d/%d not modified", vendor_id, product_id);
+        not_modified = true;
+        goto close;
+    }
     http_payload.Calloc(1024);
     if ((http_len > 0) && (http_status_code == 200)) {
         ESP_GOTO_ON_FALSE(http_payload.Get(), ESP_ERR_NO_MEM, close, TAG, "Failed to alloc memory for http_payload");
@@ -183,9 +404,8 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
                 software_version_count = sw_ver_count;
                 for (sw_ver_index = 0; sw_ver_index < sw_ver_count; ++sw_ver_index) {
                     cJSON *software_version = cJSON_GetArrayItem(software_versions, sw_ver_index);
-                    if (cJSON_IsNumber(software_version)) {
-                        ESP_RETURN_ON_FALSE(software_version->valuedouble >= 0 && software_version->valuedouble <= UINT32_MAX,
-                                            ESP_ERR_INVALID_ARG, TAG, "Invalid range");
+                    if (cJSON_IsNumber(software_version) && software_version->valuedouble >= 0 &&
+                            software_version->valuedouble <= UINT32_MAX) {
                         (*software_version_array)[sw_ver_index] = static_cast<uint32_t>(software_version->valuedouble);
                     } else {
                         ret = ESP_ERR_INVALID_ARG;
@@ -199,6 +419,9 @@ static esp_err_t _query_software_version_array(const uint16_t vendor_id, const u
         }
     }
     cJSON_Delete(root);
+    if (ret == ESP_OK) {
+        validators = new_validators;
+    }
 
 close:
     esp_http_client_close(client);
@@ -222,11 +445,11 @@ static esp_err_t _query_ota_candidate(model_version_t *model, uint32_t new_softw
         return ESP_ERR_INVALID_ARG;
     }
     esp_err_t ret = ESP_OK;
-    char url[128];
+    char url[sizeof(dcl_rest_url) + 28];
     snprintf(url, sizeof(url), "%s/%d/%d/%" PRIu32, dcl_rest_url, model->vendor_id, model->product_id, new_software_version);
     esp_http_client_config_t config = {
         .url = url,
-        .transport_type = HTTP_TRANSPORT_OVER_SSL,
+        .transport_type = dcl_transport_type,
         .buffer_size = 1024,
         .skip_cert_common_name_check = false,
         .crt_bundle_attach = esp_crt_bundle_attach,
@@ -297,6 +520,31 @@ static esp_err_t _query_ota_candidate(model_version_t *model, uint32_t new_softw
                 if (ota_url_value) {
                     strlcpy(model->ota_url, ota_url_value, sizeof(model->ota_url));
                 }
+                // The DCL encodes the 64-bit numbers as strings
+                cJSON *ota_file_size = cJSON_GetObjectItemCaseSensitive(model_version, "otaFileSize");
+                if (cJSON_IsNumber(ota_file_size) && ota_file_size->valuedouble >= 0 &&
+                        ota_file_size->valuedouble <= UINT32_MAX) {
+                    model->ota_file_size = static_cast<uint32_t>(ota_file_size->valuedouble);
+                } else if (cJSON_IsString(ota_file_size)) {
+                    model->ota_file_size = static_cast<uint32_t>(strtoul(ota_file_size->valuestring, nullptr, 10));
+                } else {
+                    model->ota_file_size = 0;
+                }
+                // Only the SHA-256 checksums (type 1 of the IANA Named Information Hash Algorithm Registry) are used
+                cJSON *ota_checksum = cJSON_GetObjectItemCaseSensitive(model_version, "otaChecksum");
+                cJSON *ota_checksum_type = cJSON_GetObjectItemCaseSensitive(model_version, "otaChecksumType");
+                const char *ota_checksum_value = cJSON_GetStringValue(ota_checksum);
+                model->ota_checksum_valid = false;
+                if (ota_checksum_value && cJSON_IsNumber(ota_checksum_type) && ota_checksum_type->valueint == 1) {
+                    uint8_t checksum[BASE64_MAX_DECODED_LEN(BASE64_ENCODED_LEN(sizeof(model->ota_checksum)))];
+                    size_t checksum_str_len = strlen(ota_checksum_value);
+                    if (checksum_str_len == BASE64_ENCODED_LEN(sizeof(model->ota_checksum)) &&
+                            chip::Base64Decode(ota_checksum_value, static_cast<uint16_t>(checksum_str_len), checksum) ==
+                            sizeof(model->ota_checksum)) {
+                        memcpy(model->ota_checksum, checksum, sizeof(model->ota_checksum));
+                        model->ota_checksum_valid = true;
+                    }
+                }
                 ret = ESP_OK;
             }
         }
@@ -313,37 +561,165 @@ cleanup:
     return ret;
 }
 
+// Refresh the software version list of a cache entry with a conditional request to the DCL. The list is not
+// requested again if it was validated less than CONFIG_ESP_MATTER_OTA_CANDIDATES_REVALIDATE_PERIOD minutes ago, unless
+// force is set. changed is set if the DCL returns a new list.
+static esp_err_t _refresh_ota_candidate(size_t index, bool force, bool &changed)
+{
+    ota_candidate_entry_t &entry = _ota_candidates_cache[index];
+    ota_candidate_record_t &record = entry.record;
+    int64_t now = esp_timer_get_time();
+    changed = false;
+    if (!force && entry.validated &&
+            now - entry.validated_time < (int64_t)CONFIG_ESP_MATTER_OTA_CANDIDATES_REVALIDATE_PERIOD * 60 * 1000 * 1000) {
+        return ESP_OK;
+    }
+    uint32_t *software_version_array = nullptr;
+    size_t software_version_count = 0;
+    bool not_modified = false;
+    dcl_validators_t validators = record.validators;
+    esp_err_t err = _query_software_version_array(record.candidate.vendor_id, record.candidate.product_id, validators,
+                                                  not_modified, &software_version_array, software_version_count);
+    if (err != ESP_OK) {
+        return err;
+    }
+    entry.validated = true;
+    entry.validated_time = now;
+    if (not_modified) {
+        return ESP_OK;
+    }
+    std::sort(&software_version_array[0], &software_version_array[software_version_count], std::greater<uint32_t>());
+    // Only the newest versions are kept, the candidates are searched from the newest version
+    record.software_version_count =
+        static_cast<uint8_t>(std::min(software_version_count, max_cached_software_version_count));
+    record.software_versions_truncated = software_version_count > max_cached_software_version_count;
+    memcpy(record.software_versions, software_version_array, record.software_version_count * sizeof(uint32_t));
+    record.validators = validators;
+    esp_matter_mem_free(software_version_array);
+    // The new software versions may have candidates for the requestors which had none
+    entry.no_candidate_version_count = 0;
+    entry.no_candidate_version_next = 0;
+    changed = true;
+    return ESP_OK;
+}
+
+static bool _has_no_ota_candidate(size_t index, uint32_t software_version)
+{
+    ota_candidate_entry_t &entry = _ota_candidates_cache[index];
+    for (size_t i = 0; i < entry.no_candidate_version_count; ++i) {
+        if (entry.no_candidate_versions[i] == software_version) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _set_no_ota_candidate(size_t index, uint32_t software_version)
+{
+    ota_candidate_entry_t &entry = _ota_candidates_cache[index];
+    entry.no_candidate_versions[entry.no_candidate_version_next] = software_version;
+    entry.no_candidate_version_next = (entry.no_candidate_version_next + 1) % max_no_candidate_version_count;
+    if (entry.no_candidate_version_count < max_no_candidate_version_count) {
+        entry.no_candidate_version_count++;
+    }
+}
+
+// Query the newest candidate applicable to the software version among the versions of the model older than
+// oldest_cached_version, which are not kept in the cache entry. The full list is requested without validators.
+static esp_err_t _select_uncached_ota_candidate(size_t index, uint32_t software_version,
+                                                uint32_t oldest_cached_version, bool &query_failed)
+{
+    ota_candidate_record_t &record = _ota_candidates_cache[index].record;
+    uint32_t *software_version_array = nullptr;
+    size_t software_version_count = 0;
+    bool not_modified = false;
+    dcl_validators_t validators = {};
+    esp_err_t err = _query_software_version_array(record.candidate.vendor_id, record.candidate.product_id, validators,
+                                                  not_modified, &software_version_array, software_version_count);
+    if (err != ESP_OK) {
+        query_failed = true;
+        return err;
+    }
+    std::sort(&software_version_array[0], &software_version_array[software_version_count], std::greater<uint32_t>());
+    err = ESP_ERR_NOT_FOUND;
+    for (size_t ver_index = 0;
+            ver_index < software_version_count && software_version_array[ver_index] > software_version; ++ver_index) {
+        if (software_version_array[ver_index] >= oldest_cached_version) {
+            continue;
+        }
+        esp_err_t query_err = _query_ota_candidate(&record.candidate, software_version_array[ver_index],
+                                                   software_version);
+        if (query_err == ESP_OK) {
+            err = ESP_OK;
+            break;
+        }
+        if (query_err != ESP_ERR_NOT_FINISHED) {
+            query_failed = true;
+        }
+    }
+    esp_matter_mem_free(software_version_array);
+    return err;
+}
+
+// Query the newest candidate of a cache entry which is applicable to the software version. Return ESP_ERR_NOT_FOUND if
+// the DCL has no candidate for it, or ESP_FAIL if the DCL could not be queried for some software versions.
+static esp_err_t _select_ota_candidate(size_t index, uint32_t software_version)
+{
+    ota_candidate_record_t &record = _ota_candidates_cache[index].record;
+    bool query_failed = false;
+    size_t ver_index = 0;
+    for (; ver_index < record.software_version_count && record.software_versions[ver_index] > software_version;
+            ++ver_index) {
+        if (record.software_versions[ver_index] == record.candidate.software_version) {
+            // This candidate has already been queried
+            if (_is_ota_candidate_valid(&record.candidate, software_version)) {
+                return ESP_OK;
+            }
+            continue;
+        }
+        esp_err_t err = _query_ota_candidate(&record.candidate, record.software_versions[ver_index], software_version);
+        if (err == ESP_OK) {
+            return ESP_OK;
+        }
+        if (err != ESP_ERR_NOT_FINISHED) {
+            query_failed = true;
+        }
+    }
+    if (record.software_versions_truncated && ver_index == record.software_version_count && ver_index > 0) {
+        // All the cached versions are newer than the requestor, the older ones may still be applicable
+        if (_select_uncached_ota_candidate(index, software_version, record.software_versions[ver_index - 1],
+                                           query_failed) == ESP_OK) {
+            return ESP_OK;
+        }
+    }
+    return query_failed ? ESP_FAIL : ESP_ERR_NOT_FOUND;
+}
+
 #ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_UPDATE_PERIODICALLY
 static void _update_all_ota_candidates_cache()
 {
     for (size_t index = 0; index < max_ota_candidate_count; ++index) {
-        model_version_t *candidate = _ota_candidates_cache[index];
-        if (candidate) {
-            uint32_t *software_version_array = nullptr;
-            size_t software_version_count;
-            esp_err_t err = _query_software_version_array(candidate->vendor_id, candidate->product_id,
-                                                          &software_version_array, software_version_count);
-            if (err == ESP_OK && software_version_array && software_version_count > 0) {
-                std::sort(&software_version_array[0], &software_version_array[software_version_count],
-                          std::greater<uint32_t>());
-                for (size_t ver_index = 0;
-                        ver_index < software_version_count && software_version_array[ver_index] > candidate->software_version;
-                        ++ver_index) {
-                    err = _query_ota_candidate(candidate, software_version_array[ver_index], candidate->software_version);
-                    if (err == ESP_OK) {
-                        break;
-                    }
-                }
-                esp_matter_mem_free(software_version_array);
-            }
+        ota_candidate_entry_t &entry = _ota_candidates_cache[index];
+        if (!entry.used) {
+            continue;
+        }
+        bool changed = false;
+        if (_refresh_ota_candidate(index, true, changed) != ESP_OK || !changed) {
+            // The DCL has not changed the software versions of this model
+            continue;
+        }
+        uint32_t software_version = entry.record.candidate.software_version;
+        if (software_version > 0) {
+            _select_ota_candidate(index, software_version);
         }
+        _store_ota_candidate(index);
     }
 }
 
 static void _ota_candidates_periodic_update_handler(void *arg)
 {
-    ota_candidate_fetch_action_t action;
-    action.vendor_id = chip::kMaxVendorId;
+    ota_candidate_fetch_action_t action = {};
+    action.type = OTA_CANDIDATE_ACTION_UPDATE_ALL;
     if (xQueueSend(_ota_candidate_task_queue, &action, portMAX_DELAY) != pdTRUE) {
         ESP_LOGE(TAG, "Failed send search ota candidate action");
     }
@@ -352,70 +728,69 @@ static void _ota_candidates_periodic_update_handler(void *arg)
 
 static void _ota_candidate_fetch_handler(ota_candidate_fetch_action_t &action)
 {
-    model_version_t *candidate = nullptr;
     assert(action.callback);
     // Search the ota candidate from cache, if we find a proper candidate return the candidate. Otherwise we will search
-    // a new candidate from DCL.
-    int candidate_index = _search_ota_candidate_from_cache(action.vendor_id, action.product_id, action.software_version);
-    if (candidate_index >= 0 && candidate_index < max_ota_candidate_count && _ota_candidates_cache[candidate_index]) {
-        candidate = _ota_candidates_cache[candidate_index];
+    // a new candidate from the software versions of the model, which are revalidated with the DCL.
+    int candidate_index = _search_ota_candidate_from_cache(action.vendor_id, action.product_id);
+    bool new_entry = candidate_index < 0;
+    if (new_entry) {
+        candidate_index = _alloc_ota_candidate(action.vendor_id, action.product_id);
+    }
+    ota_candidate_entry_t &entry = _ota_candidates_cache[candidate_index];
+    model_version_t *candidate = &entry.record.candidate;
+    _touch_ota_candidate(candidate_index);
+    if (_is_ota_candidate_valid(candidate, action.software_version)) {
         action.callback(EspOtaProvider::OTAQueryStatus::kUpdateAvailable, candidate->ota_url, candidate->ota_file_size,
-                        candidate->software_version, candidate->software_version_str, action.callback_args);
+                        candidate->ota_checksum_valid ? candidate->ota_checksum : nullptr, candidate->software_version,
+                        candidate->software_version_str, action.callback_args);
         return;
-    } else {
-        // Cannot find the candidate from cache, we need to query DCL for a new candidate;
-        uint32_t *software_version_array = nullptr;
-        size_t software_version_count;
-        esp_err_t err = _query_software_version_array(action.vendor_id, action.product_id, &software_version_array,
-                                                      software_version_count);
-        if (err == ESP_OK && software_version_array && software_version_count > 0) {
-            // Sort the software version array
-            std::sort(&software_version_array[0], &software_version_array[software_version_count],
-                      std::greater<uint32_t>());
-            candidate = (model_version_t *)esp_matter_mem_calloc(1, sizeof(model_version_t));
-            candidate->vendor_id = action.vendor_id;
-            candidate->product_id = action.product_id;
-            for (size_t index = 0;
-                    index < software_version_count && software_version_array[index] > action.software_version; ++index) {
-                err = _query_ota_candidate(candidate, software_version_array[index], action.software_version);
-                if (err == ESP_OK) {
-                    size_t empty_index = _find_empty_ota_candidates();
-                    _increase_ota_candidates_lifetime();
-                    candidate->lifetime = 0;
-                    // Add this candidate to cache
-                    _ota_candidates_cache[empty_index] = candidate;
-                    action.callback(EspOtaProvider::OTAQueryStatus::kUpdateAvailable, candidate->ota_url,
-                                    candidate->ota_file_size, candidate->software_version,
-                                    candidate->software_version_str, action.callback_args);
-                    esp_matter_mem_free(software_version_array);
-                    return;
-                }
-            }
-            esp_matter_mem_free(candidate);
-            esp_matter_mem_free(software_version_array);
+    }
+    bool changed = false;
+    esp_err_t err = _refresh_ota_candidate(candidate_index, false, changed);
+    if (err == ESP_OK && _has_no_ota_candidate(candidate_index, action.software_version)) {
+        // The software version list has not changed since no candidate was found for this version
+        err = ESP_ERR_NOT_FOUND;
+    } else if (err == ESP_OK) {
+        err = _select_ota_candidate(candidate_index, action.software_version);
+        if (err == ESP_ERR_NOT_FOUND) {
+            _set_no_ota_candidate(candidate_index, action.software_version);
         }
+        _store_ota_candidate(candidate_index);
+    } else if (new_entry) {
+        _erase_ota_candidate(candidate_index);
+    }
+    if (err == ESP_OK) {
+        action.callback(EspOtaProvider::OTAQueryStatus::kUpdateAvailable, candidate->ota_url, candidate->ota_file_size,
+                        candidate->ota_checksum_valid ? candidate->ota_checksum : nullptr, candidate->software_version,
+                        candidate->software_version_str, action.callback_args);
+        return;
     }
     // Cannot fetch the candidate
-    action.callback(EspOtaProvider::OTAQueryStatus::kNotAvailable, nullptr, 0, 0, nullptr, action.callback_args);
+    action.callback(EspOtaProvider::OTAQueryStatus::kNotAvailable, nullptr, 0, nullptr, 0, nullptr,
+                    action.callback_args);
 }
 
 static void ota_candidate_task(void *ctx)
 {
     ota_candidate_fetch_action_t action;
     while (true) {
-        if (xQueueReceive(_ota_candidate_task_queue, &action, portMAX_DELAY) == pdTRUE) {
-            if (action.vendor_id != chip::kMaxVendorId) {
-                _ota_candidate_fetch_handler(action);
-            }
+        if (xQueueReceive(_ota_candidate_task_queue, &action, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (action.type == OTA_CANDIDATE_ACTION_FETCH) {
+            _ota_candidate_fetch_handler(action);
+        }
 #ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_UPDATE_PERIODICALLY
-            else {
-                // If receiving an action with Max VendorId, try to update all the candidates cache.
-                _update_all_ota_candidates_cache();
-            }
+        else if (action.type == OTA_CANDIDATE_ACTION_UPDATE_ALL) {
+            _update_all_ota_candidates_cache();
+        }
 #endif
+        else if (action.type == OTA_CANDIDATE_ACTION_STOP) {
+            break;
         }
     }
-    vQueueDelete(_ota_candidate_task_queue);
+    // The queue is deleted by deinit_ota_candidates()
+    xSemaphoreGive(static_cast<SemaphoreHandle_t>(action.callback_args));
     vTaskDelete(NULL);
 }
 
@@ -430,6 +805,7 @@ esp_err_t fetch_ota_candidate(const uint16_t vendor_id, const uint16_t product_i
         return ESP_ERR_INVALID_ARG;
     }
     ota_candidate_fetch_action_t action;
+    action.type = OTA_CANDIDATE_ACTION_FETCH;
     action.vendor_id = vendor_id;
     action.product_id = product_id;
     action.software_version = software_version;
@@ -444,22 +820,29 @@ esp_err_t fetch_ota_candidate(const uint16_t vendor_id, const uint16_t product_i
 
 esp_err_t init_ota_candidates()
 {
-    memset(_ota_candidates_cache, 0, sizeof(_ota_candidates_cache));
     if (_ota_candidate_task_queue) {
         return ESP_ERR_INVALID_STATE;
     }
+    ESP_RETURN_ON_FALSE(http_downloader_is_url_allowed(dcl_rest_url), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "%s requires CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP", dcl_rest_url);
+    memset(_ota_candidates_cache, 0, sizeof(_ota_candidates_cache));
+    for (size_t index = 0; index < max_ota_candidate_count; ++index) {
+        _ota_candidates_cache[index].next = invalid_entry_index;
+    }
+    memset(_ota_candidates_buckets, invalid_entry_index, sizeof(_ota_candidates_buckets));
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+    _load_ota_candidates();
+#endif
     _ota_candidate_task_queue = xQueueCreate(8, sizeof(ota_candidate_fetch_action_t));
     if (!_ota_candidate_task_queue) {
         ESP_LOGE(TAG, "Failed to create ota_candidate task queue");
         return ESP_ERR_NO_MEM;
     }
 
-    static TaskHandle_t task_handle = NULL;
-    if (task_handle) {
-        return ESP_ERR_INVALID_STATE;
-    }
     if (xTaskCreate(ota_candidate_task, "ota_candidate", 8192, NULL, 5, NULL) != pdTRUE) {
         ESP_LOGE(TAG, "Failed to create ota_candidate task");
+        vQueueDelete(_ota_candidate_task_queue);
+        _ota_candidate_task_queue = NULL;
         return ESP_ERR_NO_MEM;
     }
 #ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_UPDATE_PERIODICALLY
@@ -477,5 +860,31 @@ esp_err_t init_ota_candidates()
     return ESP_OK;
 }
 
+esp_err_t deinit_ota_candidates()
+{
+    if (!_ota_candidate_task_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_UPDATE_PERIODICALLY
+    if (_ota_candidates_update_timer) {
+        esp_timer_stop(_ota_candidates_update_timer);
+        esp_timer_delete(_ota_candidates_update_timer);
+        _ota_candidates_update_timer = NULL;
+    }
+#endif
+    SemaphoreHandle_t stopped = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(stopped, ESP_ERR_NO_MEM, TAG, "Failed to create the stop semaphore");
+    // The fetches already queued are completed before the task exits
+    ota_candidate_fetch_action_t action = {};
+    action.type = OTA_CANDIDATE_ACTION_STOP;
+    action.callback_args = stopped;
+    xQueueSend(_ota_candidate_task_queue, &action, portMAX_DELAY);
+    xSemaphoreTake(stopped, portMAX_DELAY);
+    vSemaphoreDelete(stopped);
+    vQueueDelete(_ota_candidate_task_queue);
+    _ota_candidate_task_queue = NULL;
+    return ESP_OK;
+}
+
 } // namespace ota_provider
 } // namespace esp_matter
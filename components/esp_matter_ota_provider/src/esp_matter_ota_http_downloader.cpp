@@ -17,14 +17,30 @@
 #include <esp_http_client.h>
 #include <esp_log.h>
 #include <esp_matter_mem.h>
+#include <esp_matter_ota_bdx_sender.h>
 #include <esp_matter_ota_http_downloader.h>
 #include <sdkconfig.h>
+#include <string.h>
+#include <strings.h>
 
 static constexpr char TAG[] = "ota_provider";
 
 namespace esp_matter {
 namespace ota_provider {
 
+bool http_downloader_is_url_allowed(const char *url)
+{
+    if (!url) {
+        return false;
+    }
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP
+    if (strncasecmp(url, "http://", strlen("http://")) == 0) {
+        return true;
+    }
+#endif
+    return strncasecmp(url, "https://", strlen("https://")) == 0;
+}
+
 static bool _process_again(int status_code)
 {
     switch (status_code) {
@@ -49,6 +65,11 @@ static esp_err_t _http_handle_response_code(esp_http_client_handle_t http_client
             ESP_LOGE(TAG, "URL redirection Failed");
             return err;
         }
+        char url[OTA_URL_MAX_LEN];
+        if (esp_http_client_get_url(http_client, url, sizeof(url)) != ESP_OK || !http_downloader_is_url_allowed(url)) {
+            ESP_LOGE(TAG, "Redirection to a plain HTTP URL is not allowed");
+            return ESP_ERR_NOT_SUPPORTED;
+        }
     } else if (status_code == HttpStatus_Unauthorized) {
         esp_http_client_add_auth(http_client);
     } else if (status_code == HttpStatus_NotFound || status_code == HttpStatus_Forbidden) {
@@ -131,7 +152,7 @@ static int _http_client_read(esp_http_client_handle_t http_client, char *data, s
 {
     int read_len = 0;
     while (read_len < size) {
-        int len = _http_client_read_check_connection(http_client, data, size - read_len);
+        int len = _http_client_read_check_connection(http_client, data + read_len, size - read_len);
         if (esp_http_client_is_complete_data_received(http_client)) {
             ESP_LOGI(TAG, "Finish downloading");
             return read_len + len;
@@ -169,6 +190,8 @@ esp_err_t http_downloader_start(esp_http_client_config_t *config, esp_http_clien
 {
     esp_err_t ret = ESP_OK;
     ESP_RETURN_ON_FALSE(http_client, ESP_ERR_INVALID_ARG, TAG, "http_client cannot be NULL");
+    ESP_RETURN_ON_FALSE(config && http_downloader_is_url_allowed(config->url), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "The URL of the image is not allowed");
     *http_client = esp_http_client_init(config);
     ESP_RETURN_ON_FALSE(*http_client, ESP_ERR_NO_MEM, TAG, "Failed to initialize http client");
     ESP_GOTO_ON_ERROR(_http_connect(*http_client), exit, TAG, "Failed to connect to HTTP server");
@@ -0,0 +1,350 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_matter_ota_image_cache.h>
+
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+#include <dirent.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_spiffs.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <inttypes.h>
+#include <mbedtls/sha256.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static constexpr char TAG[] = "ota_image_cache";
+static constexpr char k_base_path[] = "/ota_cache";
+static constexpr size_t k_max_images = CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_MAX_IMAGES;
+// "/ota_cache/" + "vvvv_pppp_ssssssss.ota" + '\0', the name fits in the SPIFFS object name length
+static constexpr size_t k_path_len = sizeof(k_base_path) + 24;
+
+namespace esp_matter {
+namespace ota_provider {
+
+typedef struct {
+    bool used;
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint32_t software_version;
+    size_t size;
+    uint32_t last_used;
+} cached_image_t;
+
+struct ota_image_cache_writer {
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint32_t software_version;
+    size_t size;
+    size_t written;
+    // A block could not be written, the next blocks are dropped until the last one or the abort releases the writer
+    bool failed;
+    uint8_t checksum[k_ota_image_checksum_len];
+    FILE *file;
+    mbedtls_sha256_context sha256;
+};
+
+static cached_image_t s_images[k_max_images];
+static uint32_t s_use_count = 0;
+static ota_image_cache_stats_t s_stats = {};
+// Largest image staged so far, the room kept free in the partition for the temporary file of the next image
+static size_t s_staging_size = 0;
+static bool s_initialized = false;
+
+static SemaphoreHandle_t get_image_cache_lock()
+{
+    static StaticSemaphore_t s_image_cache_lock_buffer;
+    static SemaphoreHandle_t s_image_cache_lock = xSemaphoreCreateMutexStatic(&s_image_cache_lock_buffer);
+    return s_image_cache_lock;
+}
+
+class scoped_image_cache_lock {
+public:
+    scoped_image_cache_lock()
+    {
+        xSemaphoreTake(get_image_cache_lock(), portMAX_DELAY);
+    }
+    ~scoped_image_cache_lock()
+    {
+        xSemaphoreGive(get_image_cache_lock());
+    }
+};
+
+static void get_image_path(uint16_t vendor_id, uint16_t product_id, uint32_t software_version, const char *suffix,
+                           char *path, size_t path_size)
+{
+    snprintf(path, path_size, "%s/%04x_%04x_%08" PRIx32 ".%s", k_base_path, vendor_id, product_id, software_version,
+             suffix);
+}
+
+static cached_image_t *find_image(uint16_t vendor_id, uint16_t product_id, uint32_t software_version)
+{
+    for (size_t i = 0; i < k_max_images; ++i) {
+        cached_image_t &image = s_images[i];
+        if (image.used && image.vendor_id == vendor_id && image.product_id == product_id &&
+                image.software_version == software_version) {
+            return &image;
+        }
+    }
+    return nullptr;
+}
+
+static void evict_image(cached_image_t &image)
+{
+    char path[k_path_len];
+    get_image_path(image.vendor_id, image.product_id, image.software_version, "ota", path, sizeof(path));
+    remove(path);
+    ESP_LOGI(TAG, "Evicted image %04x/%04x/%" PRIu32, image.vendor_id, image.product_id, image.software_version);
+    image.used = false;
+    s_stats.evicted++;
+}
+
+static esp_err_t get_free_space(size_t *total, size_t *free_space)
+{
+    size_t used = 0;
+    ESP_RETURN_ON_ERROR(esp_spiffs_info(CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_PARTITION_LABEL, total, &used), TAG,
+                        "Failed to get SPIFFS info");
+    *free_space = *total >= used ? *total - used : 0;
+    return ESP_OK;
+}
+
+// Evict the least recently used images, but the kept one, until the partition has room to stage an image of this
+// size. This is only called once an image has been verified, so a failed transfer never evicts a cached image.
+static void make_room(size_t size, const cached_image_t *keep)
+{
+    size_t total = 0, free_space = 0;
+    while (get_free_space(&total, &free_space) == ESP_OK && free_space < size) {
+        cached_image_t *lru = nullptr;
+        for (size_t i = 0; i < k_max_images; ++i) {
+            if (s_images[i].used && &s_images[i] != keep && (!lru || s_images[i].last_used < lru->last_used)) {
+                lru = &s_images[i];
+            }
+        }
+        if (!lru) {
+            return;
+        }
+        evict_image(*lru);
+    }
+}
+
+esp_err_t ota_image_cache_init()
+{
+    if (s_initialized) {
+        return ESP_OK;
+    }
+    esp_vfs_spiffs_conf_t conf = {.base_path = k_base_path,
+                                  .partition_label = CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_PARTITION_LABEL,
+                                  .max_files = 3,
+                                  .format_if_mount_failed = true
+                                 };
+    ESP_RETURN_ON_ERROR(esp_vfs_spiffs_register(&conf), TAG, "Failed to initialize SPIFFS");
+
+    scoped_image_cache_lock lock;
+    DIR *dir = opendir(k_base_path);
+    ESP_RETURN_ON_FALSE(dir, ESP_FAIL, TAG, "Failed to open %s", k_base_path);
+    struct dirent *entry;
+    size_t count = 0;
+    while ((entry = readdir(dir)) != nullptr) {
+        unsigned vendor_id, product_id;
+        uint32_t software_version;
+        char suffix[4] = {0};
+        char path[k_path_len];
+        snprintf(path, sizeof(path), "%s/%s", k_base_path, entry->d_name);
+        if (sscanf(entry->d_name, "%4x_%4x_%8" SCNx32 ".%3s", &vendor_id, &product_id, &software_version, suffix) != 4 ||
+                strcmp(suffix, "ota") != 0 || count >= k_max_images) {
+            // The images being written when the device was reset, or which do not fit in the cache anymore
+            remove(path);
+            continue;
+        }
+        struct stat st;
+        if (stat(path, &st) != 0) {
+            continue;
+        }
+        cached_image_t &image = s_images[count++];
+        image.used = true;
+        image.vendor_id = static_cast<uint16_t>(vendor_id);
+        image.product_id = static_cast<uint16_t>(product_id);
+        image.software_version = software_version;
+        image.size = static_cast<size_t>(st.st_size);
+        image.last_used = ++s_use_count;
+    }
+    closedir(dir);
+    s_initialized = true;
+    ESP_LOGI(TAG, "%u cached OTA images", static_cast<unsigned>(count));
+    return ESP_OK;
+}
+
+esp_err_t ota_image_cache_get_path(uint16_t vendor_id, uint16_t product_id, uint32_t software_version, char *path,
+                                   size_t path_size)
+{
+    ESP_RETURN_ON_FALSE(path && path_size >= k_path_len, ESP_ERR_INVALID_ARG, TAG, "Invalid path buffer");
+    scoped_image_cache_lock lock;
+    cached_image_t *image = s_initialized ? find_image(vendor_id, product_id, software_version) : nullptr;
+    if (!image) {
+        s_stats.misses++;
+        return ESP_ERR_NOT_FOUND;
+    }
+    image->last_used = ++s_use_count;
+    s_stats.hits++;
+    get_image_path(vendor_id, product_id, software_version, "ota", path, path_size);
+    return ESP_OK;
+}
+
+esp_err_t ota_image_cache_writer_open(uint16_t vendor_id, uint16_t product_id, uint32_t software_version, size_t size,
+                                      const uint8_t checksum[k_ota_image_checksum_len],
+                                      ota_image_cache_writer_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(checksum && handle && size > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "Image cache is not initialized");
+    scoped_image_cache_lock lock;
+    if (find_image(vendor_id, product_id, software_version)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // The image is staged in a temporary file and the cached images are only evicted once it has been verified, so
+    // the staging needs the free space of the partition
+    size_t total = 0, free_space = 0;
+    ESP_RETURN_ON_ERROR(get_free_space(&total, &free_space), TAG, "No room for the image");
+    if (size > total) {
+        ESP_LOGW(TAG, "Image of %u bytes is larger than the cache partition", static_cast<unsigned>(size));
+        return ESP_ERR_NO_MEM;
+    }
+    s_staging_size = size > s_staging_size ? size : s_staging_size;
+    if (size > free_space) {
+        ESP_LOGW(TAG, "No room to stage the image of %u bytes, the next cached image will make room for it",
+                 static_cast<unsigned>(size));
+        return ESP_ERR_NO_MEM;
+    }
+    ota_image_cache_writer_handle_t writer = static_cast<ota_image_cache_writer_handle_t>(
+                                                 esp_matter_mem_calloc(1, sizeof(struct ota_image_cache_writer)));
+    ESP_RETURN_ON_FALSE(writer, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the image cache writer");
+    char path[k_path_len];
+    get_image_path(vendor_id, product_id, software_version, "tmp", path, sizeof(path));
+    writer->file = fopen(path, "wb");
+    if (!writer->file) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        esp_matter_mem_free(writer);
+        return ESP_FAIL;
+    }
+    writer->vendor_id = vendor_id;
+    writer->product_id = product_id;
+    writer->software_version = software_version;
+    writer->size = size;
+    memcpy(writer->checksum, checksum, sizeof(writer->checksum));
+    mbedtls_sha256_init(&writer->sha256);
+    mbedtls_sha256_starts(&writer->sha256, 0);
+    *handle = writer;
+    return ESP_OK;
+}
+
+static void close_writer(ota_image_cache_writer_handle_t writer, bool keep)
+{
+    char tmp_path[k_path_len];
+    get_image_path(writer->vendor_id, writer->product_id, writer->software_version, "tmp", tmp_path, sizeof(tmp_path));
+    fclose(writer->file);
+    mbedtls_sha256_free(&writer->sha256);
+    scoped_image_cache_lock lock;
+    if (keep) {
+        char path[k_path_len];
+        get_image_path(writer->vendor_id, writer->product_id, writer->software_version, "ota", path, sizeof(path));
+        cached_image_t *image = nullptr;
+        if (rename(tmp_path, path) == 0) {
+            for (size_t i = 0; i < k_max_images && !image; ++i) {
+                image = s_images[i].used ? nullptr : &s_images[i];
+            }
+            if (!image) {
+                // The image has been verified, the least recently used one can be replaced
+                image = &s_images[0];
+                for (size_t i = 1; i < k_max_images; ++i) {
+                    image = s_images[i].last_used < image->last_used ? &s_images[i] : image;
+                }
+                evict_image(*image);
+            }
+            image->used = true;
+            image->vendor_id = writer->vendor_id;
+            image->product_id = writer->product_id;
+            image->software_version = writer->software_version;
+            image->size = writer->written;
+            image->last_used = ++s_use_count;
+            s_stats.stored++;
+            ESP_LOGI(TAG, "Cached image %04x/%04x/%" PRIu32 " (%u bytes)", writer->vendor_id, writer->product_id,
+                     writer->software_version, static_cast<unsigned>(writer->written));
+            make_room(s_staging_size, image);
+        } else {
+            ESP_LOGW(TAG, "Failed to rename %s", tmp_path);
+            remove(tmp_path);
+        }
+    } else {
+        remove(tmp_path);
+    }
+    esp_matter_mem_free(writer);
+}
+
+void ota_image_cache_writer_write(const uint8_t *data, size_t len, bool eof, void *ctx)
+{
+    ota_image_cache_writer_handle_t writer = static_cast<ota_image_cache_writer_handle_t>(ctx);
+    if (!writer) {
+        return;
+    }
+    if (!data) {
+        close_writer(writer, false);
+        return;
+    }
+    // The sink is called for every block of the transfer, the writer must stay valid until the last one
+    if (!writer->failed && (writer->written + len > writer->size || fwrite(data, 1, len, writer->file) != len)) {
+        ESP_LOGW(TAG, "Failed to write image %04x/%04x/%" PRIu32, writer->vendor_id, writer->product_id,
+                 writer->software_version);
+        writer->failed = true;
+    }
+    if (writer->failed) {
+        if (eof) {
+            {
+                scoped_image_cache_lock lock;
+                s_stats.rejected++;
+            }
+            close_writer(writer, false);
+        }
+        return;
+    }
+    mbedtls_sha256_update(&writer->sha256, data, len);
+    writer->written += len;
+    if (!eof) {
+        return;
+    }
+    uint8_t checksum[k_ota_image_checksum_len];
+    mbedtls_sha256_finish(&writer->sha256, checksum);
+    bool valid = writer->written == writer->size && memcmp(checksum, writer->checksum, sizeof(checksum)) == 0;
+    if (!valid) {
+        ESP_LOGW(TAG, "Image %04x/%04x/%" PRIu32 " does not match the DCL checksum, not cached", writer->vendor_id,
+                 writer->product_id, writer->software_version);
+        scoped_image_cache_lock lock;
+        s_stats.rejected++;
+    }
+    close_writer(writer, valid);
+}
+
+void ota_image_cache_get_stats(ota_image_cache_stats_t *stats)
+{
+    if (stats) {
+        scoped_image_cache_lock lock;
+        *stats = s_stats;
+    }
+}
+
+} // namespace ota_provider
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
@@ -0,0 +1,263 @@
+// Copyright 2026 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_ota_bdx_sender.h>
+#include <esp_matter_ota_http_downloader.h>
+#include <esp_matter_ota_prefetcher.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <new>
+#include <stdio.h>
+#include <string.h>
+
+static constexpr char TAG[] = "ota_provider";
+static constexpr uint32_t k_prefetch_task_stack_size = 8192;
+// The task checks whether it is stopped at least at this period while all the buffers are full
+static constexpr TickType_t k_free_block_wait_ticks = pdMS_TO_TICKS(1000);
+
+namespace esp_matter {
+namespace ota_provider {
+
+struct ota_prefetcher {
+    esp_http_client_config_t config;
+    // URL of the image, or path of the file if from_file is set
+    char url[OTA_URL_MAX_LEN];
+    bool from_file;
+    ota_prefetcher_sink_t sink;
+    void *sink_ctx;
+    size_t block_size;
+    size_t block_count;
+    uint8_t *buffers;
+    size_t *lengths;
+    // Blocks released by the consumer and downloaded by the task, the buffer of a block is (index % block_count)
+    std::atomic<uint32_t> released;
+    std::atomic<uint32_t> downloaded;
+    // Number of free buffers
+    SemaphoreHandle_t free_blocks;
+    std::atomic<bool> failed;
+    std::atomic<bool> complete;
+    std::atomic<bool> stopped;
+    // Both the consumer and the task hold a reference, the last one releases the prefetcher
+    std::atomic<uint8_t> refs;
+    int64_t start_time;
+    std::atomic<int64_t> end_time;
+    uint64_t bytes;
+};
+
+static void _release_prefetcher(ota_prefetcher_handle_t prefetcher)
+{
+    if (prefetcher->refs.fetch_sub(1) != 1) {
+        return;
+    }
+    if (prefetcher->free_blocks) {
+        vSemaphoreDelete(prefetcher->free_blocks);
+    }
+    esp_matter_mem_free(prefetcher->buffers);
+    esp_matter_mem_free(prefetcher->lengths);
+    esp_matter_mem_free(prefetcher);
+}
+
+// Source of the blocks, either the HTTP connection or the file of the image
+typedef struct {
+    esp_http_client_handle_t http_client;
+    FILE *file;
+} prefetch_source_t;
+
+static esp_err_t _open_source(ota_prefetcher_handle_t prefetcher, prefetch_source_t &source)
+{
+    if (prefetcher->from_file) {
+        source.file = fopen(prefetcher->url, "rb");
+        return source.file ? ESP_OK : ESP_FAIL;
+    }
+    return http_downloader_start(&prefetcher->config, &source.http_client);
+}
+
+// Read a block, set complete if it is the last one
+static int _read_source(ota_prefetcher_handle_t prefetcher, prefetch_source_t &source, uint8_t *buf, bool &complete)
+{
+    if (prefetcher->from_file) {
+        size_t len = fread(buf, 1, prefetcher->block_size, source.file);
+        if (len < prefetcher->block_size && ferror(source.file)) {
+            return -1;
+        }
+        complete = len < prefetcher->block_size || feof(source.file);
+        return static_cast<int>(len);
+    }
+    int len = http_downloader_read(source.http_client, reinterpret_cast<char *>(buf), prefetcher->block_size);
+    complete = len >= 0 && (static_cast<size_t>(len) < prefetcher->block_size ||
+                            esp_http_client_is_complete_data_received(source.http_client));
+    return len;
+}
+
+static void _close_source(prefetch_source_t &source)
+{
+    if (source.file) {
+        fclose(source.file);
+    }
+    http_downloader_abort(source.http_client);
+}
+
+static void _prefetch_task(void *ctx)
+{
+    ota_prefetcher_handle_t prefetcher = static_cast<ota_prefetcher_handle_t>(ctx);
+    prefetch_source_t source = {};
+    if (_open_source(prefetcher, source) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open %s", prefetcher->url);
+        prefetcher->failed = true;
+    }
+    while (!prefetcher->failed && !prefetcher->complete && !prefetcher->stopped) {
+        if (xSemaphoreTake(prefetcher->free_blocks, k_free_block_wait_ticks) != pdTRUE) {
+            continue;
+        }
+        if (prefetcher->stopped) {
+            break;
+        }
+        uint32_t index = prefetcher->downloaded.load();
+        size_t slot = index % prefetcher->block_count;
+        uint8_t *buf = prefetcher->buffers + slot * prefetcher->block_size;
+        bool complete = false;
+        int len = _read_source(prefetcher, source, buf, complete);
+        if (len < 0) {
+            ESP_LOGE(TAG, "Failed to prefetch block %" PRIu32, index);
+            prefetcher->failed = true;
+            break;
+        }
+        prefetcher->lengths[slot] = static_cast<size_t>(len);
+        prefetcher->bytes += static_cast<size_t>(len);
+        if (prefetcher->sink) {
+            prefetcher->sink(buf, static_cast<size_t>(len), complete, prefetcher->sink_ctx);
+        }
+        if (complete) {
+            prefetcher->end_time = esp_timer_get_time();
+            prefetcher->complete = true;
+        }
+        // Publish the block after its length
+        prefetcher->downloaded.store(index + 1);
+    }
+    if (prefetcher->sink && !prefetcher->complete) {
+        prefetcher->sink(nullptr, 0, false, prefetcher->sink_ctx);
+    }
+    _close_source(source);
+    _release_prefetcher(prefetcher);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t _start_prefetcher(const esp_http_client_config_t *config, const char *url, size_t block_size,
+                                   size_t block_count, ota_prefetcher_sink_t sink, void *sink_ctx,
+                                   ota_prefetcher_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(url && handle && block_size > 0 && block_count > 0, ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid argument");
+    esp_err_t ret = ESP_OK;
+    ota_prefetcher_handle_t prefetcher =
+        static_cast<ota_prefetcher_handle_t>(esp_matter_mem_calloc(1, sizeof(struct ota_prefetcher)));
+    ESP_RETURN_ON_FALSE(prefetcher, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for prefetcher");
+    new (prefetcher) ota_prefetcher();
+    if (config) {
+        prefetcher->config = *config;
+    }
+    prefetcher->from_file = !config;
+    strlcpy(prefetcher->url, url, sizeof(prefetcher->url));
+    prefetcher->config.url = prefetcher->url;
+    prefetcher->sink = sink;
+    prefetcher->sink_ctx = sink_ctx;
+    prefetcher->block_size = block_size;
+    prefetcher->block_count = block_count;
+    prefetcher->refs = 1;
+    prefetcher->buffers = static_cast<uint8_t *>(esp_matter_mem_calloc(block_count, block_size));
+    prefetcher->lengths = static_cast<size_t *>(esp_matter_mem_calloc(block_count, sizeof(size_t)));
+    prefetcher->free_blocks = xSemaphoreCreateCounting(block_count, block_count);
+    ESP_GOTO_ON_FALSE(prefetcher->buffers && prefetcher->lengths && prefetcher->free_blocks, ESP_ERR_NO_MEM, cleanup,
+                      TAG, "Failed to alloc memory for prefetch buffers");
+    prefetcher->start_time = esp_timer_get_time();
+    prefetcher->refs = 2;
+    if (xTaskCreate(_prefetch_task, "ota_prefetch", k_prefetch_task_stack_size, prefetcher, 5, NULL) != pdTRUE) {
+        prefetcher->refs = 1;
+        ESP_LOGE(TAG, "Failed to create ota_prefetch task");
+        ret = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+    *handle = prefetcher;
+    return ESP_OK;
+cleanup:
+    _release_prefetcher(prefetcher);
+    return ret;
+}
+
+esp_err_t ota_prefetcher_start(const esp_http_client_config_t *config, size_t block_size, size_t block_count,
+                               ota_prefetcher_sink_t sink, void *sink_ctx, ota_prefetcher_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(config, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    return _start_prefetcher(config, config->url, block_size, block_count, sink, sink_ctx, handle);
+}
+
+esp_err_t ota_prefetcher_start_from_file(const char *path, size_t block_size, size_t block_count,
+                                         ota_prefetcher_handle_t *handle)
+{
+    return _start_prefetcher(nullptr, path, block_size, block_count, nullptr, nullptr, handle);
+}
+
+esp_err_t ota_prefetcher_get_block(ota_prefetcher_handle_t handle, const uint8_t **data, size_t *len, bool *eof)
+{
+    ESP_RETURN_ON_FALSE(handle && data && len && eof, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    uint32_t index = handle->released.load();
+    if (index == handle->downloaded.load()) {
+        return handle->failed ? ESP_FAIL : ESP_ERR_NOT_FINISHED;
+    }
+    size_t slot = index % handle->block_count;
+    *data = handle->buffers + slot * handle->block_size;
+    *len = handle->lengths[slot];
+    *eof = handle->complete && index + 1 == handle->downloaded.load();
+    return ESP_OK;
+}
+
+void ota_prefetcher_release_block(ota_prefetcher_handle_t handle)
+{
+    if (handle && handle->released.load() != handle->downloaded.load()) {
+        handle->released.fetch_add(1);
+        xSemaphoreGive(handle->free_blocks);
+    }
+}
+
+void ota_prefetcher_get_stats(ota_prefetcher_handle_t handle, ota_prefetcher_stats_t *stats)
+{
+    if (!handle || !stats) {
+        return;
+    }
+    stats->bytes = handle->bytes;
+    stats->blocks = handle->downloaded.load();
+    int64_t end_time = handle->complete ? handle->end_time.load() : esp_timer_get_time();
+    stats->time_us = end_time - handle->start_time;
+}
+
+void ota_prefetcher_stop(ota_prefetcher_handle_t handle)
+{
+    if (!handle) {
+        return;
+    }
+    handle->stopped = true;
+    // Wake up the task if it waits for a free buffer
+    xSemaphoreGive(handle->free_blocks);
+    _release_prefetcher(handle);
+}
+
+} // namespace ota_provider
+} // namespace esp_matter
@@ -19,6 +19,7 @@
 #include <esp_log.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_ota_candidates.h>
+#include <esp_matter_ota_image_cache.h>
 #include <esp_matter_ota_provider.h>
 
 #include <app/server/Server.h>
@@ -81,6 +82,11 @@ esp_err_t EspOtaProvider::Init(bool otaAllowedDefault, chip::System::Layer *syst
     mOtaRequestorList = nullptr;
     mOtaAllowedDefault = otaAllowedDefault;
     init_ota_candidates();
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    if (ota_image_cache_init() != ESP_OK) {
+        ESP_LOGW(TAG, "OTA images will not be cached");
+    }
+#endif
     return exchange_mgr->RegisterUnsolicitedMessageHandlerForProtocol(chip::Protocols::BDX::Id, &mOtaBdxSender) ==
            CHIP_NO_ERROR
            ? ESP_OK
@@ -137,6 +143,9 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
         bdxFlags.Set(TransferControlFlags::kReceiverDrive);
         if (mOtaBdxSender.InitializeTransfer(mSubjectDescriptor.fabricIndex, mSubjectDescriptor.subject) == ESP_OK) {
             mOtaBdxSender.SetOtaImageUrl(requestor->mOtaImageUrl);
+            mOtaBdxSender.SetOtaImageInfo(requestor->mVendorId, requestor->mProductId, requestor->mSoftwareVersion,
+                                          requestor->mOtaImageSize,
+                                          requestor->mOtaImageChecksumValid ? requestor->mOtaImageChecksum : nullptr);
             ESP_LOGI(TAG, "Bdx Sender will query the OTA image from %s", requestor->mOtaImageUrl);
             CHIP_ERROR bdx_error = mOtaBdxSender.PrepareForTransfer(mSystemLayer, chip::bdx::TransferRole::kSender,
                                                                     bdxFlags, kMaxBdxBlockSize, kBdxTimeout,
@@ -176,7 +185,8 @@ void EspOtaProvider::SendQueryImageResponse(OTAQueryStatus status)
 }
 
 void EspOtaProvider::FetchImageDoneCallback(OTAQueryStatus status, const char *imageUrl, size_t imageSize,
-                                            uint32_t softwareVersion, const char *softwareVersionStr, void *arg)
+                                            const uint8_t *imageChecksum, uint32_t softwareVersion,
+                                            const char *softwareVersionStr, void *arg)
 {
     EspOtaProvider *provider = (EspOtaProvider *)arg;
     assert(provider);
@@ -184,6 +194,10 @@ void EspOtaProvider::FetchImageDoneCallback(OTAQueryStatus status, const char *i
     if (requestor && status == OTAQueryStatus::kUpdateAvailable) {
         strncpy(requestor->mOtaImageUrl, imageUrl, sizeof(requestor->mOtaImageUrl) - 1);
         requestor->mOtaImageSize = imageSize;
+        requestor->mOtaImageChecksumValid = imageChecksum != nullptr;
+        if (imageChecksum) {
+            memcpy(requestor->mOtaImageChecksum, imageChecksum, sizeof(requestor->mOtaImageChecksum));
+        }
         requestor->mSoftwareVersion = softwareVersion;
         strncpy(requestor->mSoftwareVersionString, softwareVersionStr, sizeof(requestor->mSoftwareVersionString) - 1);
     }
@@ -220,6 +234,12 @@ void EspOtaProvider::HandleQueryImage(CommandHandler *commandObj, const Concrete
     // Use a command handle to hold the CommandHandler so that it will not be released.
     mSubjectDescriptor = commandObj->GetSubjectDescriptor();
     mPeerNodeId = commandObj->GetExchangeContext()->GetSessionHandle()->GetPeer();
+    EspOtaRequestorEntry *requestor = FindOtaRequestorEntry(mPeerNodeId);
+    if (requestor) {
+        // The image of the requestor is cached by VendorID, ProductID and software version
+        requestor->mVendorId = vendor_id;
+        requestor->mProductId = product_id;
+    }
     mAsyncCommandHandle = chip::app::CommandHandler::Handle(commandObj);
     mPath = commandPath;
     if (fetch_ota_candidate(vendor_id, product_id, software_version, FetchImageDoneCallback, this) != ESP_OK) {
@@ -331,6 +351,16 @@ EspOtaProvider::EspOtaRequestorEntry *EspOtaProvider::FindOtaRequestorEntry(cons
     return nullptr;
 }
 
+esp_err_t EspOtaProvider::GetImageCacheStats(ota_image_cache_stats_t &stats)
+{
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+    ota_image_cache_get_stats(&stats);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 esp_err_t EspOtaProvider::CreateOtaRequestorEntry(const chip::ScopedNodeId &nodeId)
 {
     EspOtaRequestorEntry *entry = FindOtaRequestorEntry(nodeId);
@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <dcl_stand_in.h>
+
+#include <atomic>
+#include <esp_event.h>
+#include <esp_http_server.h>
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace esp_matter::test {
+
+static const char *TAG = "dcl_stand_in";
+static constexpr char k_model_versions_prefix[] = "/dcl/model/versions/";
+
+static httpd_handle_t s_server = nullptr;
+static const dcl_model_t *s_models = nullptr;
+static size_t s_model_count = 0;
+static std::atomic<uint32_t> s_request_count(0);
+static std::atomic<uint32_t> s_not_modified_count(0);
+static bool s_etag_enabled = true;
+static size_t s_image_size = 1024;
+// The handlers run in the task of the server, one at a time
+static char s_response[1024];
+
+static const dcl_model_t *find_model(unsigned vendor_id, unsigned product_id)
+{
+    for (size_t i = 0; i < s_model_count; ++i) {
+        if (s_models[i].vendor_id == vendor_id && s_models[i].product_id == product_id) {
+            return &s_models[i];
+        }
+    }
+    return nullptr;
+}
+
+static uint32_t get_model_hash(const dcl_model_t &model)
+{
+    uint32_t hash = model.version_count;
+    for (size_t i = 0; i < model.version_count; ++i) {
+        hash = hash * 31 + model.versions[i].software_version;
+    }
+    return hash;
+}
+
+// The software version list is modified when its hash changes
+static bool is_not_modified(httpd_req_t *req, const char *etag, const char *last_modified)
+{
+    char value[32];
+    if (s_etag_enabled) {
+        return httpd_req_get_hdr_value_str(req, "If-None-Match", value, sizeof(value)) == ESP_OK &&
+               strcmp(value, etag) == 0;
+    }
+    return httpd_req_get_hdr_value_str(req, "If-Modified-Since", value, sizeof(value)) == ESP_OK &&
+           strcmp(value, last_modified) == 0;
+}
+
+static esp_err_t send_software_versions(httpd_req_t *req, const dcl_model_t &model)
+{
+    uint32_t hash = get_model_hash(model);
+    char etag[16];
+    snprintf(etag, sizeof(etag), "\"%08" PRIx32 "\"", hash);
+    char last_modified[32];
+    snprintf(last_modified, sizeof(last_modified), "Thu, 01 Jan 2026 %02u:%02u:%02u GMT", (unsigned)(hash / 3600 % 24),
+             (unsigned)(hash / 60 % 60), (unsigned)(hash % 60));
+    if (is_not_modified(req, etag, last_modified)) {
+        s_not_modified_count++;
+        httpd_resp_set_status(req, "304 Not Modified");
+        return httpd_resp_send(req, nullptr, 0);
+    }
+    int len = snprintf(s_response, sizeof(s_response),
+                       "{\"modelVersions\":{\"vid\":%u,\"pid\":%u,\"softwareVersions\":[", model.vendor_id,
+                       model.product_id);
+    for (size_t i = 0; i < model.version_count && len < (int)sizeof(s_response); ++i) {
+        len += snprintf(s_response + len, sizeof(s_response) - len, "%s%" PRIu32, i ? "," : "",
+                        model.versions[i].software_version);
+    }
+    if (len < (int)sizeof(s_response)) {
+        len += snprintf(s_response + len, sizeof(s_response) - len, "]}}");
+    }
+    if (len >= (int)sizeof(s_response)) {
+        ESP_LOGE(TAG, "Too many software versions for the response");
+        return httpd_resp_send_500(req);
+    }
+    httpd_resp_set_type(req, "application/json");
+    if (s_etag_enabled) {
+        httpd_resp_set_hdr(req, "ETag", etag);
+    }
+    httpd_resp_set_hdr(req, "Last-Modified", last_modified);
+    return httpd_resp_send(req, s_response, len);
+}
+
+static esp_err_t send_model_version(httpd_req_t *req, const dcl_model_t &model, uint32_t software_version)
+{
+    for (size_t i = 0; i < model.version_count; ++i) {
+        const dcl_model_version_t &version = model.versions[i];
+        if (version.software_version != software_version) {
+            continue;
+        }
+        int len = snprintf(s_response, sizeof(s_response),
+                           "{\"modelVersion\":{\"vid\":%u,\"pid\":%u,\"softwareVersion\":%" PRIu32
+                           ",\"softwareVersionString\":\"%" PRIu32 ".0\",\"cdVersionNumber\":1,"
+                           "\"softwareVersionValid\":true,\"otaUrl\":\"http://127.0.0.1:%u/ota/%" PRIu32 ".bin\","
+                           "\"otaFileSize\":\"%u\",\"minApplicableSoftwareVersion\":%" PRIu32
+                           ",\"maxApplicableSoftwareVersion\":%" PRIu32 "}}",
+                           model.vendor_id, model.product_id, software_version, software_version, k_dcl_stand_in_port,
+                           software_version, (unsigned)s_image_size, version.min_applicable_software_version,
+                           version.max_applicable_software_version);
+        httpd_resp_set_type(req, "application/json");
+        return httpd_resp_send(req, s_response, len);
+    }
+    return httpd_resp_send_404(req);
+}
+
+static esp_err_t model_versions_handler(httpd_req_t *req)
+{
+    s_request_count++;
+    unsigned vendor_id = 0, product_id = 0;
+    uint32_t software_version = 0;
+    int count = sscanf(req->uri + strlen(k_model_versions_prefix), "%u/%u/%" SCNu32, &vendor_id, &product_id,
+                       &software_version);
+    const dcl_model_t *model = count >= 2 ? find_model(vendor_id, product_id) : nullptr;
+    if (!model) {
+        return httpd_resp_send_404(req);
+    }
+    return count == 2 ? send_software_versions(req, *model) : send_model_version(req, *model, software_version);
+}
+
+static esp_err_t image_handler(httpd_req_t *req)
+{
+    s_request_count++;
+    httpd_resp_set_type(req, "application/octet-stream");
+    for (size_t offset = 0; offset < s_image_size;) {
+        size_t len = s_image_size - offset < sizeof(s_response) ? s_image_size - offset : sizeof(s_response);
+        for (size_t i = 0; i < len; ++i) {
+            s_response[i] = static_cast<char>(dcl_stand_in_image_byte(offset + i));
+        }
+        esp_err_t err = httpd_resp_send_chunk(req, s_response, len);
+        if (err != ESP_OK) {
+            return err;
+        }
+        offset += len;
+    }
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+esp_err_t dcl_stand_in_start(const dcl_model_t *models, size_t model_count)
+{
+    // The network stack may already be up if another test started it
+    esp_err_t err = esp_netif_init();
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    err = esp_event_loop_create_default();
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    s_models = models;
+    s_model_count = model_count;
+    s_request_count = 0;
+    s_not_modified_count = 0;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.server_port = k_dcl_stand_in_port;
+    config.uri_match_fn = httpd_uri_match_wildcard;
+    config.lru_purge_enable = true;
+    err = httpd_start(&s_server, &config);
+    if (err != ESP_OK) {
+        return err;
+    }
+    const httpd_uri_t model_versions = {
+        .uri = "/dcl/model/versions/*",
+        .method = HTTP_GET,
+        .handler = model_versions_handler,
+        .user_ctx = nullptr,
+    };
+    err = httpd_register_uri_handler(s_server, &model_versions);
+    if (err != ESP_OK) {
+        return err;
+    }
+    const httpd_uri_t image = {
+        .uri = "/ota/*",
+        .method = HTTP_GET,
+        .handler = image_handler,
+        .user_ctx = nullptr,
+    };
+    return httpd_register_uri_handler(s_server, &image);
+}
+
+void dcl_stand_in_set_image_size(size_t size)
+{
+    s_image_size = size;
+}
+
+void dcl_stand_in_set_etag_enabled(bool enabled)
+{
+    s_etag_enabled = enabled;
+}
+
+uint32_t dcl_stand_in_get_request_count()
+{
+    return s_request_count;
+}
+
+uint32_t dcl_stand_in_get_not_modified_count()
+{
+    return s_not_modified_count;
+}
+
+void dcl_stand_in_stop()
+{
+    if (s_server) {
+        httpd_stop(s_server);
+        s_server = nullptr;
+    }
+    s_models = nullptr;
+    s_model_count = 0;
+    s_image_size = 1024;
+    s_etag_enabled = true;
+}
+
+} // namespace esp_matter::test
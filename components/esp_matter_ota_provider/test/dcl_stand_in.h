@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter::test {
+
+// Port of the loopback HTTP server, CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_CUSTOM_URL is http://127.0.0.1:8080
+constexpr uint16_t k_dcl_stand_in_port = 8080;
+
+struct dcl_model_version_t {
+    uint32_t software_version;
+    uint32_t min_applicable_software_version;
+    uint32_t max_applicable_software_version;
+};
+
+struct dcl_model_t {
+    uint16_t vendor_id;
+    uint16_t product_id;
+    const dcl_model_version_t *versions;
+    size_t version_count;
+};
+
+/** Start a loopback HTTP server which answers the model version requests of the DCL REST API
+ *
+ * /dcl/model/versions/<vid>/<pid> lists the software versions of a model with an ETag and a Last-Modified date, and
+ * answers 304 to a request with the same If-None-Match, or with the same If-Modified-Since if the ETag is disabled. /dcl/model/versions/<vid>/<pid>/<version> gives a model version, whose otaUrl is
+ * /ota/<version>.bin. The models are not copied and must outlive the server.
+ *
+ * /ota/<anything> serves an image of the size set by dcl_stand_in_set_image_size(), whose bytes are given by
+ * dcl_stand_in_image_byte().
+ */
+esp_err_t dcl_stand_in_start(const dcl_model_t *models, size_t model_count);
+
+/** Set the size of the images, 1024 bytes by default */
+void dcl_stand_in_set_image_size(size_t size);
+
+inline uint8_t dcl_stand_in_image_byte(size_t offset)
+{
+    return static_cast<uint8_t>(offset % 251);
+}
+
+/** Send the ETag of the software version lists, enabled by default. When disabled, the lists are only revalidated
+ *  with their Last-Modified date.
+ */
+void dcl_stand_in_set_etag_enabled(bool enabled);
+
+/** Number of requests received since the server was started */
+uint32_t dcl_stand_in_get_request_count();
+
+/** Number of the requests answered with 304 Not Modified since the server was started */
+uint32_t dcl_stand_in_get_not_modified_count();
+
+void dcl_stand_in_stop();
+
+} // namespace esp_matter::test
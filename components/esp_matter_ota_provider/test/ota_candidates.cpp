@@ -0,0 +1,255 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <unity.h>
+
+#if defined(CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_CUSTOM) && defined(CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP)
+#include <dcl_stand_in.h>
+#include <esp_matter_ota_candidates.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <nvs_flash.h>
+
+using namespace esp_matter::ota_provider;
+using namespace esp_matter::test;
+using OTAQueryStatus = EspOtaProvider::OTAQueryStatus;
+
+static constexpr uint16_t k_vendor_id = 0xFFF1;
+static constexpr TickType_t k_fetch_timeout = pdMS_TO_TICKS(10000);
+// A requestor without candidate in the cache revalidates the software versions with a conditional request when the
+// revalidate period is 0
+static constexpr uint32_t k_revalidation_count = CONFIG_ESP_MATTER_OTA_CANDIDATES_REVALIDATE_PERIOD == 0 ? 1 : 0;
+
+struct fetch_result_t {
+    SemaphoreHandle_t done;
+    OTAQueryStatus status;
+    uint32_t software_version;
+    char ota_url[OTA_URL_MAX_LEN];
+};
+
+static void fetch_done(OTAQueryStatus status, const char *image_url, size_t image_size, const uint8_t *image_checksum,
+                       uint32_t software_version, const char *software_version_str, void *ctx)
+{
+    fetch_result_t *result = static_cast<fetch_result_t *>(ctx);
+    result->status = status;
+    result->software_version = software_version;
+    strlcpy(result->ota_url, image_url ? image_url : "", sizeof(result->ota_url));
+    xSemaphoreGive(result->done);
+}
+
+// The candidates are initialized once per boot, the tests use different ProductIDs
+static void init_candidates()
+{
+    // The cache is stored in the NVS partition of ESP Matter
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_init());
+    esp_err_t err = init_ota_candidates();
+    TEST_ASSERT_TRUE(err == ESP_OK || err == ESP_ERR_INVALID_STATE);
+}
+
+// Fetch the candidate of a requestor, return the number of DCL requests it took
+static uint32_t fetch(uint16_t product_id, uint32_t software_version, fetch_result_t &result)
+{
+    uint32_t request_count = dcl_stand_in_get_request_count();
+    TEST_ASSERT_EQUAL(ESP_OK, fetch_ota_candidate(k_vendor_id, product_id, software_version, fetch_done, &result));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(result.done, k_fetch_timeout));
+    return dcl_stand_in_get_request_count() - request_count;
+}
+
+TEST_CASE("a requestor without candidate does not query the DCL again", "[ota_candidates]")
+{
+    static const dcl_model_version_t versions[] = {
+        { 2, 5, 10 },
+        { 3, 5, 10 },
+        { 4, 1, 1 },
+    };
+    static const dcl_model_t model = { k_vendor_id, 0x8001, versions, 3 };
+    init_candidates();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(&model, 1));
+    fetch_result_t result = { xSemaphoreCreateBinary() };
+
+    // The list, then every version newer than the requestor
+    TEST_ASSERT_EQUAL(3, fetch(0x8001, 2, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+    TEST_ASSERT_EQUAL(k_revalidation_count, fetch(0x8001, 2, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+
+    // Another software version of the requestor is still searched, then found in the cache entry
+    TEST_ASSERT_EQUAL(k_revalidation_count + 1, fetch(0x8001, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    TEST_ASSERT_EQUAL(4, result.software_version);
+    TEST_ASSERT_EQUAL(0, fetch(0x8001, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    TEST_ASSERT_EQUAL(k_revalidation_count, fetch(0x8001, 2, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+    TEST_ASSERT_EQUAL(3 * k_revalidation_count, dcl_stand_in_get_not_modified_count());
+
+    dcl_stand_in_stop();
+    vSemaphoreDelete(result.done);
+}
+
+TEST_CASE("the software versions older than the cached ones are searched in the DCL", "[ota_candidates]")
+{
+    // Only the oldest of the 20 versions is applicable to the requestor, the entry keeps the 16 newest
+    static dcl_model_version_t versions[20];
+    for (uint32_t i = 0; i < 20; ++i) {
+        versions[i] = { i + 2, i == 0 ? 1u : 100u, i == 0 ? 1u : 100u };
+    }
+    static const dcl_model_t model = { k_vendor_id, 0x8002, versions, 20 };
+    init_candidates();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(&model, 1));
+    fetch_result_t result = { xSemaphoreCreateBinary() };
+
+    // The list, the 16 cached versions, the full list and the 4 older versions
+    TEST_ASSERT_EQUAL(22, fetch(0x8002, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    TEST_ASSERT_EQUAL(2, result.software_version);
+    TEST_ASSERT_EQUAL(0, fetch(0x8002, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    TEST_ASSERT_EQUAL(2, result.software_version);
+
+    dcl_stand_in_stop();
+    vSemaphoreDelete(result.done);
+}
+
+#if CONFIG_ESP_MATTER_OTA_CANDIDATES_REVALIDATE_PERIOD == 0
+TEST_CASE("the software versions are revalidated with the ETag of the DCL", "[ota_candidates]")
+{
+    static const dcl_model_version_t versions[] = {
+        { 2, 5, 10 },
+        { 3, 5, 10 },
+        { 4, 1, 1 },
+    };
+    // The last version is published later
+    static dcl_model_t model = { k_vendor_id, 0x8003, versions, 2 };
+    init_candidates();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(&model, 1));
+    fetch_result_t result = { xSemaphoreCreateBinary() };
+
+    TEST_ASSERT_EQUAL(3, fetch(0x8003, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+    TEST_ASSERT_EQUAL(0, dcl_stand_in_get_not_modified_count());
+
+    // The unchanged list is not sent again, nor are its versions queried again for the same requestor
+    TEST_ASSERT_EQUAL(1, fetch(0x8003, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+    TEST_ASSERT_EQUAL(1, dcl_stand_in_get_not_modified_count());
+
+    // The new list has a new ETag, the requestors without candidate are searched again
+    model.version_count = 3;
+    TEST_ASSERT_EQUAL(2, fetch(0x8003, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    TEST_ASSERT_EQUAL(4, result.software_version);
+    TEST_ASSERT_EQUAL(1, dcl_stand_in_get_not_modified_count());
+
+    dcl_stand_in_stop();
+    vSemaphoreDelete(result.done);
+}
+
+TEST_CASE("the software versions are revalidated with the Last-Modified date of the DCL", "[ota_candidates]")
+{
+    static const dcl_model_version_t versions[] = {
+        { 2, 5, 10 },
+        { 3, 1, 1 },
+    };
+    static dcl_model_t model = { k_vendor_id, 0x8004, versions, 1 };
+    init_candidates();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(&model, 1));
+    dcl_stand_in_set_etag_enabled(false);
+    fetch_result_t result = { xSemaphoreCreateBinary() };
+
+    TEST_ASSERT_EQUAL(2, fetch(0x8004, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+    TEST_ASSERT_EQUAL(1, fetch(0x8004, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+    TEST_ASSERT_EQUAL(1, dcl_stand_in_get_not_modified_count());
+
+    model.version_count = 2;
+    TEST_ASSERT_EQUAL(2, fetch(0x8004, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    TEST_ASSERT_EQUAL(3, result.software_version);
+
+    dcl_stand_in_stop();
+    vSemaphoreDelete(result.done);
+}
+#endif // CONFIG_ESP_MATTER_OTA_CANDIDATES_REVALIDATE_PERIOD == 0
+
+TEST_CASE("the least recently used candidate is evicted when the cache is full", "[ota_candidates]")
+{
+    // One model more than the cache entries, each with a candidate for the software version 1
+    static constexpr size_t k_model_count = CONFIG_ESP_MATTER_MAX_OTA_CANDIDATES_COUNT + 1;
+    static constexpr uint16_t k_first_product_id = 0x8100;
+    static const dcl_model_version_t versions[] = {
+        { 2, 1, 1 },
+    };
+    static dcl_model_t models[k_model_count];
+    for (size_t i = 0; i < k_model_count; ++i) {
+        models[i] = { k_vendor_id, static_cast<uint16_t>(k_first_product_id + i), versions, 1 };
+    }
+    init_candidates();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(models, k_model_count));
+    fetch_result_t result = { xSemaphoreCreateBinary() };
+
+    // Fill the cache, the entries of the previous cases are evicted first
+    for (size_t i = 0; i < k_model_count - 1; ++i) {
+        TEST_ASSERT_EQUAL(2, fetch(k_first_product_id + i, 1, result));
+        TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    }
+    // The first model is used again, the second one becomes the least recently used
+    TEST_ASSERT_EQUAL(0, fetch(k_first_product_id, 1, result));
+    TEST_ASSERT_EQUAL(2, fetch(k_first_product_id + k_model_count - 1, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+
+    for (size_t i = 0; i < k_model_count; ++i) {
+        if (i != 1) {
+            TEST_ASSERT_EQUAL(0, fetch(k_first_product_id + i, 1, result));
+            TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+            TEST_ASSERT_EQUAL(2, result.software_version);
+        }
+    }
+    TEST_ASSERT_EQUAL(2, fetch(k_first_product_id + 1, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+
+    dcl_stand_in_stop();
+    vSemaphoreDelete(result.done);
+}
+
+#ifdef CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+TEST_CASE("the candidates are loaded from the NVS on init", "[ota_candidates]")
+{
+    static const dcl_model_version_t versions[] = {
+        { 2, 1, 1 },
+    };
+    static const dcl_model_t model = { k_vendor_id, 0x8200, versions, 1 };
+    init_candidates();
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(&model, 1));
+    fetch_result_t result = { xSemaphoreCreateBinary() };
+
+    TEST_ASSERT_EQUAL(2, fetch(0x8200, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+
+    // Like a reboot of the provider
+    TEST_ASSERT_EQUAL(ESP_OK, deinit_ota_candidates());
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, fetch_ota_candidate(k_vendor_id, 0x8200, 1, fetch_done, &result));
+    TEST_ASSERT_EQUAL(ESP_OK, init_ota_candidates());
+
+    // The stored candidate is answered without querying the DCL
+    TEST_ASSERT_EQUAL(0, fetch(0x8200, 1, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kUpdateAvailable, result.status);
+    TEST_ASSERT_EQUAL(2, result.software_version);
+    TEST_ASSERT_EQUAL_STRING("http://127.0.0.1:8080/ota/2.bin", result.ota_url);
+
+    // The loaded software versions are revalidated with the stored ETag before they are used
+    TEST_ASSERT_EQUAL(1, fetch(0x8200, 2, result));
+    TEST_ASSERT_EQUAL(OTAQueryStatus::kNotAvailable, result.status);
+    TEST_ASSERT_EQUAL(1, dcl_stand_in_get_not_modified_count());
+
+    dcl_stand_in_stop();
+    vSemaphoreDelete(result.done);
+}
+#endif // CONFIG_ESP_MATTER_OTA_CANDIDATES_PERSISTENT
+
+#endif // CONFIG_ESP_MATTER_OTA_PROVIDER_DCL_CUSTOM && CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP
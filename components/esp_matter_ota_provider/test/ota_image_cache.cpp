@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unity.h>
+
+#ifdef CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
+#include <esp_matter_ota_image_cache.h>
+#include <mbedtls/sha256.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+using namespace esp_matter::ota_provider;
+
+static constexpr uint16_t k_vendor_id = 0xFFF1;
+static constexpr uint16_t k_product_id = 0x8001;
+static constexpr size_t k_max_images = CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE_MAX_IMAGES;
+static constexpr size_t k_image_size = 8 * 1024 + 100;
+static constexpr size_t k_block_size = 1024;
+// The oversized transfers send this many blocks more than the DCL size
+static constexpr size_t k_extra_blocks = 3;
+
+typedef enum {
+    IMAGE_VALID,
+    IMAGE_CORRUPTED,
+    IMAGE_TRUNCATED,
+    IMAGE_ABORTED,
+    IMAGE_OVERSIZED,
+    IMAGE_OVERSIZED_ABORTED,
+} image_transfer_t;
+
+static uint8_t get_image_byte(uint32_t software_version, size_t offset)
+{
+    return static_cast<uint8_t>((offset + software_version) % 251);
+}
+
+// Write an image through the cache writer like the BDX sender, the checksum is the one of the valid image
+static esp_err_t write_image(uint32_t software_version, image_transfer_t transfer)
+{
+    static uint8_t image[k_image_size + k_extra_blocks * k_block_size];
+    for (size_t i = 0; i < sizeof(image); ++i) {
+        image[i] = get_image_byte(software_version, i);
+    }
+    uint8_t checksum[k_ota_image_checksum_len];
+    mbedtls_sha256(image, k_image_size, checksum, 0);
+    if (transfer == IMAGE_CORRUPTED) {
+        image[k_image_size / 2] ^= 0xFF;
+    }
+
+    ota_image_cache_writer_handle_t writer = nullptr;
+    esp_err_t err = ota_image_cache_writer_open(k_vendor_id, k_product_id, software_version, k_image_size, checksum,
+                                                &writer);
+    if (err != ESP_OK) {
+        return err;
+    }
+    size_t size = k_image_size;
+    if (transfer == IMAGE_TRUNCATED) {
+        size = k_image_size - 1;
+    } else if (transfer == IMAGE_OVERSIZED || transfer == IMAGE_OVERSIZED_ABORTED) {
+        size = sizeof(image);
+    }
+    // Like the prefetcher, the writer is called for every block even after a write failed
+    for (size_t offset = 0; offset < size; offset += k_block_size) {
+        if ((transfer == IMAGE_ABORTED && offset >= size / 2) ||
+                (transfer == IMAGE_OVERSIZED_ABORTED && offset >= k_image_size + k_block_size)) {
+            ota_image_cache_writer_write(nullptr, 0, false, writer);
+            return ESP_OK;
+        }
+        size_t len = size - offset < k_block_size ? size - offset : k_block_size;
+        ota_image_cache_writer_write(image + offset, len, offset + len == size, writer);
+    }
+    return ESP_OK;
+}
+
+static bool is_cached(uint32_t software_version)
+{
+    char path[64];
+    return ota_image_cache_get_path(k_vendor_id, k_product_id, software_version, path, sizeof(path)) == ESP_OK;
+}
+
+// Fill the cache with the images of the software versions [first, first + k_max_images)
+static void fill_cache(uint32_t first)
+{
+    for (uint32_t version = first; version < first + k_max_images; ++version) {
+        TEST_ASSERT_EQUAL(ESP_OK, write_image(version, IMAGE_VALID));
+        TEST_ASSERT_TRUE(is_cached(version));
+    }
+}
+
+TEST_CASE("a verified image is cached and served from the partition", "[ota_image_cache]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, ota_image_cache_init());
+    ota_image_cache_stats_t before, after;
+    ota_image_cache_get_stats(&before);
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(100, IMAGE_VALID));
+    ota_image_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.stored + 1, after.stored);
+
+    char path[64];
+    TEST_ASSERT_EQUAL(ESP_OK, ota_image_cache_get_path(k_vendor_id, k_product_id, 100, path, sizeof(path)));
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, stat(path, &st));
+    TEST_ASSERT_EQUAL(k_image_size, st.st_size);
+    FILE *file = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    for (size_t i = 0; i < k_image_size; ++i) {
+        if (fgetc(file) != get_image_byte(100, i)) {
+            fclose(file);
+            TEST_FAIL_MESSAGE("Unexpected image byte");
+        }
+    }
+    fclose(file);
+    // The same image is not written twice
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, write_image(100, IMAGE_VALID));
+}
+
+TEST_CASE("a failed transfer does not evict the cached images", "[ota_image_cache]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, ota_image_cache_init());
+    fill_cache(200);
+    ota_image_cache_stats_t before, after;
+    ota_image_cache_get_stats(&before);
+
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(300, IMAGE_CORRUPTED));
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(301, IMAGE_TRUNCATED));
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(302, IMAGE_ABORTED));
+
+    ota_image_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.rejected + 2, after.rejected);
+    TEST_ASSERT_EQUAL(before.stored, after.stored);
+    TEST_ASSERT_EQUAL(before.evicted, after.evicted);
+    TEST_ASSERT_FALSE(is_cached(300));
+    TEST_ASSERT_FALSE(is_cached(301));
+    TEST_ASSERT_FALSE(is_cached(302));
+    for (uint32_t version = 200; version < 200 + k_max_images; ++version) {
+        TEST_ASSERT_TRUE(is_cached(version));
+    }
+}
+
+TEST_CASE("a verified image replaces the least recently used one", "[ota_image_cache]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, ota_image_cache_init());
+    fill_cache(400);
+    // Serve the first image again, the second one becomes the least recently used
+    TEST_ASSERT_TRUE(is_cached(400));
+    ota_image_cache_stats_t before, after;
+    ota_image_cache_get_stats(&before);
+
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(500, IMAGE_VALID));
+
+    ota_image_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.stored + 1, after.stored);
+    TEST_ASSERT_EQUAL(before.evicted + 1, after.evicted);
+    TEST_ASSERT_TRUE(is_cached(500));
+    if (k_max_images > 1) {
+        TEST_ASSERT_TRUE(is_cached(400));
+        TEST_ASSERT_FALSE(is_cached(401));
+    }
+}
+
+TEST_CASE("an image larger than the DCL size is not cached", "[ota_image_cache]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, ota_image_cache_init());
+    fill_cache(600);
+    ota_image_cache_stats_t before, after;
+    ota_image_cache_get_stats(&before);
+
+    // The writer drops the blocks past the DCL size and is released by the last block or by the abort, once
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(700, IMAGE_OVERSIZED));
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(701, IMAGE_OVERSIZED_ABORTED));
+
+    ota_image_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.rejected + 1, after.rejected);
+    TEST_ASSERT_EQUAL(before.stored, after.stored);
+    TEST_ASSERT_EQUAL(before.evicted, after.evicted);
+    TEST_ASSERT_FALSE(is_cached(700));
+    TEST_ASSERT_FALSE(is_cached(701));
+    for (uint32_t version = 600; version < 600 + k_max_images; ++version) {
+        TEST_ASSERT_TRUE(is_cached(version));
+    }
+    // The temporary files were removed, the image can be staged again
+    TEST_ASSERT_EQUAL(ESP_OK, write_image(700, IMAGE_VALID));
+    TEST_ASSERT_TRUE(is_cached(700));
+}
+
+#endif // CONFIG_ESP_MATTER_OTA_PROVIDER_IMAGE_CACHE
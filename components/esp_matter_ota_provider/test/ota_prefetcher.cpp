@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unity.h>
+
+#if defined(CONFIG_ESP_MATTER_OTA_PROVIDER_ENABLED) && defined(CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP)
+#include <dcl_stand_in.h>
+#include <esp_matter_ota_http_downloader.h>
+#include <esp_matter_ota_prefetcher.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+using namespace esp_matter::ota_provider;
+using namespace esp_matter::test;
+
+static constexpr char k_image_url[] = "http://127.0.0.1:8080/ota/1.bin";
+static constexpr size_t k_image_size = 64 * 1024 + 100;
+// The benchmark downloads an image of the size of a real firmware, the stand-in generates its bytes
+static constexpr size_t k_benchmark_image_size = 2 * 1024 * 1024 + 100;
+static constexpr size_t k_block_size = 1024;
+static constexpr size_t k_block_count = CONFIG_ESP_MATTER_OTA_PROVIDER_PREFETCH_BLOCKS;
+static constexpr int64_t k_download_timeout_us = 240 * 1000 * 1000;
+
+struct sink_result_t {
+    size_t bytes;
+    bool eof;
+    bool failed;
+};
+
+static void count_blocks(const uint8_t *data, size_t len, bool eof, void *ctx)
+{
+    sink_result_t *result = static_cast<sink_result_t *>(ctx);
+    if (!data) {
+        result->failed = true;
+        return;
+    }
+    result->bytes += len;
+    result->eof = eof;
+}
+
+static esp_http_client_config_t get_image_config()
+{
+    esp_http_client_config_t config = {};
+    config.url = k_image_url;
+    config.transport_type = k_http_downloader_transport_type;
+    config.keep_alive_enable = true;
+    return config;
+}
+
+static void check_image_bytes(const uint8_t *data, size_t len, size_t offset)
+{
+    for (size_t i = 0; i < len; ++i) {
+        if (data[i] != dcl_stand_in_image_byte(offset + i)) {
+            TEST_FAIL_MESSAGE("Unexpected image byte");
+        }
+    }
+}
+
+// Consume the blocks of the prefetcher like the BDX sender, waiting processing_ticks for every block. Return the
+// number of bytes.
+static size_t consume_blocks(ota_prefetcher_handle_t prefetcher, TickType_t processing_ticks)
+{
+    size_t offset = 0;
+    int64_t start = esp_timer_get_time();
+    bool eof = false;
+    while (!eof) {
+        TEST_ASSERT_LESS_THAN(k_download_timeout_us, esp_timer_get_time() - start);
+        const uint8_t *data = nullptr;
+        size_t len = 0;
+        esp_err_t err = ota_prefetcher_get_block(prefetcher, &data, &len, &eof);
+        if (err == ESP_ERR_NOT_FINISHED) {
+            vTaskDelay(1);
+            continue;
+        }
+        TEST_ASSERT_EQUAL(ESP_OK, err);
+        check_image_bytes(data, len, offset);
+        offset += len;
+        ota_prefetcher_release_block(prefetcher);
+        if (processing_ticks) {
+            vTaskDelay(processing_ticks);
+        }
+    }
+    return offset;
+}
+
+TEST_CASE("the prefetcher downloads an image from a local HTTP server", "[ota_prefetcher]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(nullptr, 0));
+    dcl_stand_in_set_image_size(k_image_size);
+    esp_http_client_config_t config = get_image_config();
+    sink_result_t sink_result = {};
+    ota_prefetcher_handle_t prefetcher = nullptr;
+    TEST_ASSERT_EQUAL(ESP_OK, ota_prefetcher_start(&config, k_block_size, k_block_count, count_blocks, &sink_result,
+                                                   &prefetcher));
+
+    TEST_ASSERT_EQUAL(k_image_size, consume_blocks(prefetcher, 0));
+    ota_prefetcher_stats_t stats;
+    ota_prefetcher_get_stats(prefetcher, &stats);
+    TEST_ASSERT_EQUAL(k_image_size, stats.bytes);
+    TEST_ASSERT_EQUAL((k_image_size + k_block_size - 1) / k_block_size, stats.blocks);
+    TEST_ASSERT_EQUAL(k_image_size, sink_result.bytes);
+    TEST_ASSERT_TRUE(sink_result.eof);
+    TEST_ASSERT_FALSE(sink_result.failed);
+    ota_prefetcher_stop(prefetcher);
+    dcl_stand_in_stop();
+}
+
+TEST_CASE("the downloader only accepts the allowed URL schemes", "[ota_prefetcher]")
+{
+    TEST_ASSERT_TRUE(http_downloader_is_url_allowed("https://example.com/image.bin"));
+    TEST_ASSERT_TRUE(http_downloader_is_url_allowed(k_image_url));
+    TEST_ASSERT_FALSE(http_downloader_is_url_allowed("ftp://example.com/image.bin"));
+    TEST_ASSERT_FALSE(http_downloader_is_url_allowed(nullptr));
+}
+
+TEST_CASE("benchmark the prefetcher against blocking reads", "[ota_prefetcher][benchmark]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, dcl_stand_in_start(nullptr, 0));
+    dcl_stand_in_set_image_size(k_benchmark_image_size);
+    esp_http_client_config_t config = get_image_config();
+
+    // The Matter task reading every block from the HTTP server before sending it
+    static uint8_t block[k_block_size];
+    int64_t start = esp_timer_get_time();
+    esp_http_client_handle_t client = nullptr;
+    TEST_ASSERT_EQUAL(ESP_OK, http_downloader_start(&config, &client));
+    size_t offset = 0;
+    while (offset < k_benchmark_image_size) {
+        int len = http_downloader_read(client, reinterpret_cast<char *>(block), sizeof(block));
+        TEST_ASSERT_GREATER_THAN(0, len);
+        check_image_bytes(block, static_cast<size_t>(len), offset);
+        offset += static_cast<size_t>(len);
+        vTaskDelay(1);
+    }
+    http_downloader_abort(client);
+    int64_t blocking_time = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    ota_prefetcher_handle_t prefetcher = nullptr;
+    TEST_ASSERT_EQUAL(ESP_OK,
+                      ota_prefetcher_start(&config, k_block_size, k_block_count, nullptr, nullptr, &prefetcher));
+    TEST_ASSERT_EQUAL(k_benchmark_image_size, consume_blocks(prefetcher, 1));
+    int64_t prefetch_time = esp_timer_get_time() - start;
+    ota_prefetcher_stats_t stats;
+    ota_prefetcher_get_stats(prefetcher, &stats);
+    ota_prefetcher_stop(prefetcher);
+    dcl_stand_in_stop();
+
+    printf("blocking reads: %" PRIu64 " B/s\n",
+           static_cast<uint64_t>(k_benchmark_image_size) * 1000000 / blocking_time);
+    printf("prefetched blocks (%u): %" PRIu64 " B/s, download alone %" PRIu64 " B/s\n", (unsigned)k_block_count,
+           static_cast<uint64_t>(k_benchmark_image_size) * 1000000 / prefetch_time,
+           stats.time_us > 0 ? stats.bytes * 1000000 / static_cast<uint64_t>(stats.time_us) : 0);
+}
+
+#endif // CONFIG_ESP_MATTER_OTA_PROVIDER_ENABLED && CONFIG_ESP_MATTER_OTA_PROVIDER_ALLOW_PLAIN_HTTP
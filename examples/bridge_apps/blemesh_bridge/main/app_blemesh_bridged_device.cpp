@@ -109,3 +109,9 @@ esp_err_t app_blemesh_bridged_device_t::erase_dev_addr()
     ESP_RETURN_ON_ERROR(nvs_commit(scopedNvsHandle), TAG, "Error commit NVS");
     return ESP_OK;
 }
+
+uint32_t hash_blemesh_dev_addr(const void *addr_ctx)
+{
+    const blemesh_device_addr_t *addr = static_cast<const blemesh_device_addr_t *>(addr_ctx);
+    return app_bridge_hash_bytes(&addr->blemesh_addr, sizeof(addr->blemesh_addr));
+}
@@ -109,3 +109,9 @@ esp_err_t app_espnow_bridged_device_t::erase_dev_addr()
     ESP_RETURN_ON_ERROR(nvs_commit(scopedNvsHandle), TAG, "Error committing NVS");
     return ESP_OK;
 }
+
+uint32_t hash_espnow_dev_addr(const void *addr_ctx)
+{
+    const espnow_device_addr_t *addr = static_cast<const espnow_device_addr_t *>(addr_ctx);
+    return app_bridge_hash_bytes(addr->espnow_macaddr, sizeof(addr->espnow_macaddr));
+}
@@ -28,3 +28,6 @@ public:
 
     esp_err_t erase_dev_addr() override;
 };
+
+// dev_addr_hash_callback_t of the ESP-NOW bridged devices
+uint32_t hash_espnow_dev_addr(const void *addr_ctx);
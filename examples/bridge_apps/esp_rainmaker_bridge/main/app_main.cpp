@@ -206,7 +206,7 @@ extern "C" void app_main()
     ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start Matter, err:%d", err));
 
     err = app_bridge_initialize(node, create_bridge_devices, create_rainmaker_bridged_device,
-                                free_rainmaker_bridged_device);
+                                free_rainmaker_bridged_device, hash_rainmaker_dev_addr);
     ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to resume the bridged endpoints: %d", err));
 
     rainmaker_controller_start();
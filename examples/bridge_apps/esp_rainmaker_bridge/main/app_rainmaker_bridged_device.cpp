@@ -11,6 +11,7 @@
 #include <esp_log.h>
 #include <esp_matter_mem.h>
 #include <nvs.h>
+#include <string.h>
 
 #include <lib/support/CodeUtils.h>
 #include <platform/ESP32/ScopedNvsHandle.h>
@@ -109,3 +110,11 @@ esp_err_t app_rainmaker_bridged_device_t::erase_dev_addr()
     ESP_RETURN_ON_ERROR(nvs_commit(scopedNvsHandle), TAG, "Error committing NVS");
     return ESP_OK;
 }
+
+uint32_t hash_rainmaker_dev_addr(const void *addr_ctx)
+{
+    const rainmaker_device_addr_t *addr = static_cast<const rainmaker_device_addr_t *>(addr_ctx);
+    // check_dev_addr() compares the node IDs only
+    return app_bridge_hash_bytes(addr->rainmaker_node_id,
+                                 strnlen(addr->rainmaker_node_id, sizeof(addr->rainmaker_node_id) - 1));
+}
@@ -109,3 +109,12 @@ esp_err_t app_zigbee_bridged_device_t::erase_dev_addr()
     ESP_RETURN_ON_ERROR(nvs_commit(scopedNvsHandle), TAG, "Error committing NVS");
     return ESP_OK;
 }
+
+uint32_t hash_zigbee_dev_addr(const void *addr_ctx)
+{
+    const zigbee_device_addr_t *addr = static_cast<const zigbee_device_addr_t *>(addr_ctx);
+    // Hash the fields, the padding of the address is not set by all the callers
+    uint8_t key[3] = { addr->endpoint_id, static_cast<uint8_t>(addr->shortaddr),
+                       static_cast<uint8_t>(addr->shortaddr >> 8) };
+    return app_bridge_hash_bytes(key, sizeof(key));
+}
@@ -29,3 +29,6 @@ public:
 
     esp_err_t erase_dev_addr() override;
 };
+
+// dev_addr_hash_callback_t of the Zigbee bridged devices
+uint32_t hash_zigbee_dev_addr(const void *addr_ctx);
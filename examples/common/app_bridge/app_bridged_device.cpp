@@ -32,6 +32,90 @@ app_bridged_device_t *g_bridged_device_list = nullptr;
 static uint8_t g_current_bridged_device_count = 0;
 static create_device_callback_t g_create_device_cb = nullptr;
 static free_device_callback_t g_free_device_cb = nullptr;
+static dev_addr_hash_callback_t g_dev_addr_hash_cb = nullptr;
+
+static constexpr size_t get_index_bucket_count(size_t device_count)
+{
+    size_t count = 1;
+    while (count < device_count) {
+        count <<= 1;
+    }
+    return count;
+}
+
+// The bridged devices are chained in the buckets of an index by address hash and of an index by endpoint, with about
+// one device per bucket, so that the lookups of the packets received from the bridged devices do not walk the list.
+static constexpr size_t k_index_bucket_count = get_index_bucket_count(MAX_BRIDGED_DEVICE_COUNT);
+static app_bridged_device_t *g_addr_index[k_index_bucket_count];
+static app_bridged_device_t *g_endpoint_index[k_index_bucket_count];
+
+static size_t get_addr_bucket(uint32_t dev_addr_hash)
+{
+    return dev_addr_hash & (k_index_bucket_count - 1);
+}
+
+static size_t get_endpoint_bucket(uint16_t endpoint_id)
+{
+    return endpoint_id & (k_index_bucket_count - 1);
+}
+
+// Adds the device, which has its Matter device and its address, to the device list and to the indexes
+static void add_device(app_bridged_device_t *bridged_device)
+{
+    uint32_t dev_addr_hash = 0;
+    if (g_dev_addr_hash_cb && bridged_device->get_dev_addr()) {
+        dev_addr_hash = g_dev_addr_hash_cb(bridged_device->get_dev_addr());
+    }
+    bridged_device->set_index_keys(dev_addr_hash, endpoint::get_id(bridged_device->get_matter_device()->endpoint));
+
+    bridged_device->set_next(g_bridged_device_list);
+    g_bridged_device_list = bridged_device;
+    size_t addr_bucket = get_addr_bucket(dev_addr_hash);
+    bridged_device->set_next_by_addr(g_addr_index[addr_bucket]);
+    g_addr_index[addr_bucket] = bridged_device;
+    size_t endpoint_bucket = get_endpoint_bucket(bridged_device->get_endpoint_id());
+    bridged_device->set_next_by_endpoint(g_endpoint_index[endpoint_bucket]);
+    g_endpoint_index[endpoint_bucket] = bridged_device;
+    g_current_bridged_device_count++;
+}
+
+static void remove_from_indexes(app_bridged_device_t *bridged_device)
+{
+    size_t addr_bucket = get_addr_bucket(bridged_device->get_dev_addr_hash());
+    if (g_addr_index[addr_bucket] == bridged_device) {
+        g_addr_index[addr_bucket] = bridged_device->get_next_by_addr();
+    } else {
+        for (app_bridged_device_t *dev = g_addr_index[addr_bucket]; dev; dev = dev->get_next_by_addr()) {
+            if (dev->get_next_by_addr() == bridged_device) {
+                dev->set_next_by_addr(bridged_device->get_next_by_addr());
+                break;
+            }
+        }
+    }
+    size_t endpoint_bucket = get_endpoint_bucket(bridged_device->get_endpoint_id());
+    if (g_endpoint_index[endpoint_bucket] == bridged_device) {
+        g_endpoint_index[endpoint_bucket] = bridged_device->get_next_by_endpoint();
+    } else {
+        for (app_bridged_device_t *dev = g_endpoint_index[endpoint_bucket]; dev; dev = dev->get_next_by_endpoint()) {
+            if (dev->get_next_by_endpoint() == bridged_device) {
+                dev->set_next_by_endpoint(bridged_device->get_next_by_endpoint());
+                break;
+            }
+        }
+    }
+    bridged_device->set_next_by_addr(nullptr);
+    bridged_device->set_next_by_endpoint(nullptr);
+}
+
+uint32_t app_bridge_hash_bytes(const void *data, size_t len)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
 
 esp_err_t map_matter_error(CHIP_ERROR error)
 {
@@ -52,7 +136,8 @@ esp_err_t map_matter_error(CHIP_ERROR error)
 
 /** Bridged Device APIs */
 esp_err_t app_bridge_initialize(node_t *node, esp_matter_bridge::bridge_device_type_callback_t device_type_cb,
-                                create_device_callback_t create_cb, free_device_callback_t free_cb)
+                                create_device_callback_t create_cb, free_device_callback_t free_cb,
+                                dev_addr_hash_callback_t hash_cb)
 {
     // Free_callback can be null if the user doesn't want to delete app_bridged_device_t app_bridge_remove_device()
     VerifyOrReturnValue(node && device_type_cb && create_cb, ESP_ERR_INVALID_ARG);
@@ -65,6 +150,9 @@ esp_err_t app_bridge_initialize(node_t *node, esp_matter_bridge::bridge_device_t
     g_current_bridged_device_count = 0;
     g_create_device_cb = create_cb;
     g_free_device_cb = free_cb;
+    g_dev_addr_hash_cb = hash_cb;
+    memset(g_addr_index, 0, sizeof(g_addr_index));
+    memset(g_endpoint_index, 0, sizeof(g_endpoint_index));
     uint16_t matter_endpoint_id_array[MAX_BRIDGED_DEVICE_COUNT];
     esp_matter_bridge::get_bridged_endpoint_ids(matter_endpoint_id_array);
     for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
@@ -78,9 +166,7 @@ esp_err_t app_bridge_initialize(node_t *node, esp_matter_bridge::bridge_device_t
             VerifyOrReturnValue(bridged_device->get_matter_device(), ESP_ERR_NO_MEM);
             err = bridged_device->restore_dev_addr();
             VerifyOrReturnValue(err == ESP_OK, err);
-            bridged_device->set_next(g_bridged_device_list);
-            g_bridged_device_list = bridged_device;
-            g_current_bridged_device_count++;
+            add_device(bridged_device);
             // Enable the resumed endpoint
             esp_matter::endpoint::enable(bridged_device->get_matter_device()->endpoint);
         }
@@ -112,9 +198,7 @@ esp_err_t app_bridge_create_new_device(node_t *node, uint16_t parent_endpoint_id
     }
     bridged_device->set_dev_addr(addr_ctx);
     bridged_device->set_priv_data(priv_data);
-    bridged_device->set_next(g_bridged_device_list);
-    g_bridged_device_list = bridged_device;
-    g_current_bridged_device_count++;
+    add_device(bridged_device);
 
     if (ESP_OK != bridged_device->store_dev_addr()) {
         ESP_LOGW(TAG, "Failed to store the bridged device information");
@@ -148,6 +232,8 @@ esp_err_t app_bridge_remove_device(app_bridged_device_t *bridged_device)
             return ESP_ERR_NOT_FOUND;
         }
     }
+    remove_from_indexes(bridged_device);
+    g_current_bridged_device_count--;
 
     bridged_device->erase_dev_addr();
     bridged_device->delete_dev_addr();
@@ -166,38 +252,43 @@ esp_err_t app_bridge_remove_device(app_bridged_device_t *bridged_device)
 
 app_bridged_device_t *app_bridge_get_device(const void *dev_addr)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
+    if (!g_dev_addr_hash_cb) {
+        app_bridged_device_t *current_dev = g_bridged_device_list;
+        while (current_dev) {
+            if (current_dev->check_dev_addr(dev_addr)) {
+                return current_dev;
+            }
+            current_dev = current_dev->get_next();
+        }
+        return nullptr;
+    }
+    VerifyOrReturnValue(dev_addr, nullptr);
+    uint32_t dev_addr_hash = g_dev_addr_hash_cb(dev_addr);
+    app_bridged_device_t *current_dev = g_addr_index[get_addr_bucket(dev_addr_hash)];
     while (current_dev) {
-        if (current_dev->check_dev_addr(dev_addr)) {
+        if (current_dev->get_dev_addr_hash() == dev_addr_hash && current_dev->check_dev_addr(dev_addr)) {
             return current_dev;
         }
-        current_dev = current_dev->get_next();
+        current_dev = current_dev->get_next_by_addr();
     }
     return nullptr;
 }
 
 app_bridged_device_t *app_bridge_get_device(uint16_t endpoint_id)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
+    app_bridged_device_t *current_dev = g_endpoint_index[get_endpoint_bucket(endpoint_id)];
     while (current_dev) {
-        if (current_dev->get_matter_device() &&
-                esp_matter::endpoint::get_id(current_dev->get_matter_device()->endpoint) == endpoint_id) {
+        if (current_dev->get_endpoint_id() == endpoint_id) {
             return current_dev;
         }
-        current_dev = current_dev->get_next();
+        current_dev = current_dev->get_next_by_endpoint();
     }
     return nullptr;
 }
 
 uint16_t app_bridge_get_endpoint(const void *dev_addr)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if (current_dev->check_dev_addr(dev_addr) && current_dev->get_matter_device()) {
-            return endpoint::get_id(current_dev->get_matter_device()->endpoint);
-        }
-        current_dev = current_dev->get_next();
-    }
-    return chip::kInvalidEndpointId;
+    app_bridged_device_t *bridged_device = app_bridge_get_device(dev_addr);
+    return bridged_device ? bridged_device->get_endpoint_id() : chip::kInvalidEndpointId;
 }
 #endif
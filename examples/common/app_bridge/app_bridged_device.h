@@ -17,6 +17,7 @@
 
 #include <nvs.h>
 #include <esp_matter_bridge.h>
+#include <lib/core/DataModelTypes.h>
 #include <nvs_key_allocator.h>
 
 using esp_matter::node_t;
@@ -24,7 +25,9 @@ using esp_matter::node_t;
 /* Virtual Class for Bridged Device */
 class app_bridged_device_t {
 public:
-    app_bridged_device_t() : m_dev(nullptr), m_dev_addr_ctx(nullptr), m_next(nullptr), m_priv_data(nullptr) {};
+    app_bridged_device_t()
+        : m_dev(nullptr), m_dev_addr_ctx(nullptr), m_next(nullptr), m_priv_data(nullptr), m_dev_addr_hash(0),
+          m_endpoint_id(chip::kInvalidEndpointId), m_next_by_addr(nullptr), m_next_by_endpoint(nullptr) {};
 
     virtual ~app_bridged_device_t() = default;
 
@@ -76,6 +79,38 @@ public:
         m_priv_data = priv_data;
     }
 
+    // The following functions are used by the address and endpoint indexes of app_bridge. The address hash and the
+    // endpoint are recorded when the device is added, so the address must not be changed afterwards.
+    uint32_t get_dev_addr_hash() const
+    {
+        return m_dev_addr_hash;
+    }
+    uint16_t get_endpoint_id() const
+    {
+        return m_endpoint_id;
+    }
+    void set_index_keys(uint32_t dev_addr_hash, uint16_t endpoint_id)
+    {
+        m_dev_addr_hash = dev_addr_hash;
+        m_endpoint_id = endpoint_id;
+    }
+    app_bridged_device_t *get_next_by_addr() const
+    {
+        return m_next_by_addr;
+    }
+    void set_next_by_addr(app_bridged_device_t *next)
+    {
+        m_next_by_addr = next;
+    }
+    app_bridged_device_t *get_next_by_endpoint() const
+    {
+        return m_next_by_endpoint;
+    }
+    void set_next_by_endpoint(app_bridged_device_t *next)
+    {
+        m_next_by_endpoint = next;
+    }
+
 protected:
     /** Bridged Device */
     esp_matter_bridge::device_t *m_dev;
@@ -85,6 +120,13 @@ protected:
     app_bridged_device_t *m_next;
     /* User initialization data */
     void *m_priv_data;
+    /** Hash of the address context, computed by the dev_addr_hash_callback_t of app_bridge */
+    uint32_t m_dev_addr_hash;
+    /** Matter endpoint of the Bridged Device */
+    uint16_t m_endpoint_id;
+    /** Pointers of Next Bridged Devices in the same bucket of the address and endpoint indexes */
+    app_bridged_device_t *m_next_by_addr;
+    app_bridged_device_t *m_next_by_endpoint;
 };
 
 namespace esp_matter_bridge {
@@ -102,9 +144,18 @@ esp_err_t map_matter_error(CHIP_ERROR error);
 
 typedef app_bridged_device_t *(*create_device_callback_t)(node_t *node, uint16_t endpoint_id);
 typedef void (*free_device_callback_t)(app_bridged_device_t *device);
+// Returns the hash of an address context. The addresses for which check_dev_addr() returns true must have the same
+// hash.
+typedef uint32_t (*dev_addr_hash_callback_t)(const void *addr_ctx);
 
+// When hash_cb is NULL, app_bridge_get_device(const void *) and app_bridge_get_endpoint() compare the address with the
+// address of every bridged device.
 esp_err_t app_bridge_initialize(node_t *node, esp_matter_bridge::bridge_device_type_callback_t device_type_cb,
-                                create_device_callback_t create_cb, free_device_callback_t free_cb);
+                                create_device_callback_t create_cb, free_device_callback_t free_cb,
+                                dev_addr_hash_callback_t hash_cb = nullptr);
+
+// FNV-1a hash of a buffer, for the dev_addr_hash_callback_t of the bridged devices
+uint32_t app_bridge_hash_bytes(const void *data, size_t len);
 
 esp_err_t app_bridge_create_new_device(node_t *node, uint16_t parent_endpoint_id, uint32_t matter_device_type_id,
                                        void *addr_ctx, void *priv_data);
@@ -0,0 +1,328 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unity.h>
+#include <esp_check.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <esp_matter_bridge.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model.h>
+#include <esp_matter_mem.h>
+#include <nvs.h>
+
+#include <app_bridged_device.h>
+
+#include "cluster_lifecycle_common.h"
+
+#if MAX_BRIDGED_DEVICE_COUNT > 0
+
+using namespace esp_matter;
+
+static constexpr uint32_t k_device_type_id = 0x0100;
+static constexpr uint8_t k_device_type_version = 3;
+static constexpr size_t k_benchmark_rounds = 1000;
+
+// Same bucket count as the indexes of app_bridge, the endpoints whose difference is a multiple of it share a bucket
+static constexpr uint16_t get_index_bucket_count()
+{
+    uint16_t count = 1;
+    while (count < MAX_BRIDGED_DEVICE_COUNT) {
+        count <<= 1;
+    }
+    return count;
+}
+
+// Bridged device whose address is an integer, stored in the bridge NVS namespace like the addresses of the examples
+class test_bridged_device_t : public app_bridged_device_t {
+public:
+    esp_err_t set_dev_addr(const void *addr_ctx) override
+    {
+        VerifyOrReturnValue(addr_ctx, ESP_ERR_INVALID_ARG);
+        m_addr = *static_cast<const uint32_t *>(addr_ctx);
+        m_dev_addr_ctx = &m_addr;
+        return ESP_OK;
+    }
+
+    bool check_dev_addr(const void *addr_ctx) override
+    {
+        return m_dev_addr_ctx && addr_ctx && *static_cast<const uint32_t *>(addr_ctx) == m_addr;
+    }
+
+    esp_err_t delete_dev_addr() override
+    {
+        m_dev_addr_ctx = nullptr;
+        return ESP_OK;
+    }
+
+    esp_err_t store_dev_addr() override
+    {
+        nvs_handle_t handle;
+        ESP_RETURN_ON_ERROR(open_nvs(NVS_READWRITE, &handle), "test_bridged_device", "Failed to open the NVS");
+        esp_err_t err = nvs_set_u32(handle, get_key().KeyName(), m_addr);
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+        return err;
+    }
+
+    esp_err_t restore_dev_addr() override
+    {
+        nvs_handle_t handle;
+        ESP_RETURN_ON_ERROR(open_nvs(NVS_READONLY, &handle), "test_bridged_device", "Failed to open the NVS");
+        esp_err_t err = nvs_get_u32(handle, get_key().KeyName(), &m_addr);
+        nvs_close(handle);
+        m_dev_addr_ctx = err == ESP_OK ? &m_addr : nullptr;
+        return err;
+    }
+
+    esp_err_t erase_dev_addr() override
+    {
+        nvs_handle_t handle;
+        ESP_RETURN_ON_ERROR(open_nvs(NVS_READWRITE, &handle), "test_bridged_device", "Failed to open the NVS");
+        esp_err_t err = nvs_erase_key(handle, get_key().KeyName());
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+        return err;
+    }
+
+private:
+    static esp_err_t open_nvs(nvs_open_mode_t open_mode, nvs_handle_t *handle)
+    {
+        return nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE,
+                                       open_mode, handle);
+    }
+
+    StorageKeyName get_key() const
+    {
+        return esp_matter_bridge::nvs_key_allocator::endpoint_dev_addr(endpoint::get_id(m_dev->endpoint));
+    }
+
+    uint32_t m_addr = 0;
+};
+
+static esp_err_t device_type_callback(endpoint_t *endpoint, uint32_t device_type_id, void *priv_data)
+{
+    return endpoint::add_device_type(endpoint, device_type_id, k_device_type_version);
+}
+
+static app_bridged_device_t *create_test_device(node_t *node, uint16_t endpoint_id)
+{
+    return new test_bridged_device_t();
+}
+
+static void free_test_device(app_bridged_device_t *device)
+{
+    delete device;
+}
+
+// The hashes differ but their low bits are zero, so all the addresses are chained in the first bucket of the index
+static uint32_t hash_in_first_bucket(const void *addr_ctx)
+{
+    return *static_cast<const uint32_t *>(addr_ctx) << 16;
+}
+
+static uint32_t hash_addr(const void *addr_ctx)
+{
+    return app_bridge_hash_bytes(addr_ctx, sizeof(uint32_t));
+}
+
+static uint16_t get_aggregator_endpoint_id(node_t *node)
+{
+    static endpoint_t *aggregator = nullptr;
+    if (!aggregator) {
+        endpoint::aggregator::config_t config;
+        aggregator = endpoint::aggregator::create(node, &config, ENDPOINT_FLAG_NONE, nullptr);
+        TEST_ASSERT_NOT_NULL(aggregator);
+    }
+    return endpoint::get_id(aggregator);
+}
+
+// Initialize app_bridge with an empty bridge registry
+static uint16_t init_app_bridge(node_t *node, dev_addr_hash_callback_t hash_cb)
+{
+    test::start_matter_if_needed();
+    uint16_t parent_endpoint_id = get_aggregator_endpoint_id(node);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::initialize(node, device_type_callback));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_matter_bridge::factory_reset());
+    TEST_ASSERT_EQUAL(ESP_OK, app_bridge_initialize(node, device_type_callback, create_test_device, free_test_device,
+                                                    hash_cb));
+    return parent_endpoint_id;
+}
+
+static app_bridged_device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t addr)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, app_bridge_create_new_device(node, parent_endpoint_id, k_device_type_id, &addr,
+                                                           nullptr));
+    app_bridged_device_t *device = app_bridge_get_device(&addr);
+    TEST_ASSERT_NOT_NULL(device);
+    return device;
+}
+
+// Like a reboot for the bridge: the endpoints and the devices are gone but their registry and addresses are kept in
+// the NVS
+static void release_devices(const uint32_t *addrs, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        app_bridged_device_t *device = app_bridge_get_device(&addrs[i]);
+        TEST_ASSERT_NOT_NULL(device);
+        esp_matter_bridge::device_t *matter_device = device->get_matter_device();
+        TEST_ASSERT_EQUAL(ESP_OK, endpoint::destroy(matter_device->node, matter_device->endpoint));
+        esp_matter_mem_free(matter_device);
+        delete device;
+    }
+}
+
+static void remove_devices(const uint32_t *addrs, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        app_bridged_device_t *device = app_bridge_get_device(&addrs[i]);
+        TEST_ASSERT_NOT_NULL(device);
+        TEST_ASSERT_EQUAL(ESP_OK, app_bridge_remove_device(device));
+        TEST_ASSERT_NULL(app_bridge_get_device(&addrs[i]));
+    }
+}
+
+static uint16_t get_device_count(node_t *node)
+{
+    uint16_t available = CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT - endpoint::get_count(node);
+    return available < MAX_BRIDGED_DEVICE_COUNT ? available : MAX_BRIDGED_DEVICE_COUNT;
+}
+
+TEST_CASE("a bridged device is removed from the middle of the bucket chains of the indexes", "[app_bridge]")
+{
+    node_t *node = test::get_or_create_node();
+    uint16_t parent_endpoint_id = init_app_bridge(node, hash_in_first_bucket);
+
+    // Three devices in the same bucket of both indexes, the endpoints which fall in other buckets are removed
+    const uint32_t addrs[] = {1, 2, 3};
+    app_bridged_device_t *devices[3] = {create_device(node, parent_endpoint_id, addrs[0]), nullptr, nullptr};
+    uint16_t endpoint_ids[3] = {devices[0]->get_endpoint_id(), 0, 0};
+    for (size_t i = 1; i < 3;) {
+        app_bridged_device_t *device = create_device(node, parent_endpoint_id, addrs[i]);
+        if ((device->get_endpoint_id() - endpoint_ids[0]) % get_index_bucket_count() != 0) {
+            TEST_ASSERT_EQUAL(ESP_OK, app_bridge_remove_device(device));
+            continue;
+        }
+        devices[i] = device;
+        endpoint_ids[i] = device->get_endpoint_id();
+        ++i;
+    }
+
+    // The chains are in the reverse order of addition, the second device is in the middle of both
+    TEST_ASSERT_EQUAL(ESP_OK, app_bridge_remove_device(devices[1]));
+    TEST_ASSERT_NULL(app_bridge_get_device(&addrs[1]));
+    TEST_ASSERT_NULL(app_bridge_get_device(endpoint_ids[1]));
+    TEST_ASSERT_EQUAL(chip::kInvalidEndpointId, app_bridge_get_endpoint(&addrs[1]));
+    for (size_t i = 0; i < 3; i += 2) {
+        TEST_ASSERT_EQUAL_PTR(devices[i], app_bridge_get_device(&addrs[i]));
+        TEST_ASSERT_EQUAL_PTR(devices[i], app_bridge_get_device(endpoint_ids[i]));
+        TEST_ASSERT_EQUAL(endpoint_ids[i], app_bridge_get_endpoint(&addrs[i]));
+    }
+
+    // Then the tail and the head of the chains
+    TEST_ASSERT_EQUAL(ESP_OK, app_bridge_remove_device(devices[0]));
+    TEST_ASSERT_NULL(app_bridge_get_device(endpoint_ids[0]));
+    TEST_ASSERT_EQUAL_PTR(devices[2], app_bridge_get_device(&addrs[2]));
+    TEST_ASSERT_EQUAL_PTR(devices[2], app_bridge_get_device(endpoint_ids[2]));
+    remove_devices(&addrs[2], 1);
+    TEST_ASSERT_NULL(app_bridge_get_device(endpoint_ids[2]));
+}
+
+TEST_CASE("the resumed bridged devices are found by address and by endpoint", "[app_bridge]")
+{
+    node_t *node = test::get_or_create_node();
+    uint16_t parent_endpoint_id = init_app_bridge(node, hash_addr);
+    uint16_t count = get_device_count(node);
+    TEST_ASSERT_GREATER_THAN(1, count);
+    uint32_t addrs[MAX_BRIDGED_DEVICE_COUNT];
+    uint16_t endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    for (uint16_t i = 0; i < count; ++i) {
+        addrs[i] = 0x1000 + i;
+        endpoint_ids[i] = create_device(node, parent_endpoint_id, addrs[i])->get_endpoint_id();
+    }
+
+    release_devices(addrs, count);
+    TEST_ASSERT_EQUAL(ESP_OK, app_bridge_initialize(node, device_type_callback, create_test_device, free_test_device,
+                                                    hash_addr));
+    for (uint16_t i = 0; i < count; ++i) {
+        app_bridged_device_t *device = app_bridge_get_device(&addrs[i]);
+        TEST_ASSERT_NOT_NULL(device);
+        TEST_ASSERT_EQUAL(endpoint_ids[i], device->get_endpoint_id());
+        TEST_ASSERT_EQUAL_PTR(device, app_bridge_get_device(endpoint_ids[i]));
+        TEST_ASSERT_EQUAL(endpoint_ids[i], app_bridge_get_endpoint(&addrs[i]));
+    }
+    const uint32_t unknown_addr = 0x2000;
+    TEST_ASSERT_NULL(app_bridge_get_device(&unknown_addr));
+    TEST_ASSERT_NULL(app_bridge_get_device(static_cast<uint16_t>(endpoint_ids[count - 1] + 1)));
+
+    // The resumed devices are removed from the indexes like the created ones
+    remove_devices(addrs, count);
+    for (uint16_t i = 0; i < count; ++i) {
+        TEST_ASSERT_NULL(app_bridge_get_device(endpoint_ids[i]));
+    }
+}
+
+// Time of a lookup of every device and of an unknown address, in ns per lookup
+static int64_t time_addr_lookups(const uint32_t *addrs, uint16_t count)
+{
+    const uint32_t unknown_addr = 0x2000;
+    int64_t start = esp_timer_get_time();
+    for (size_t round = 0; round < k_benchmark_rounds; ++round) {
+        for (uint16_t i = 0; i < count; ++i) {
+            TEST_ASSERT_NOT_NULL(app_bridge_get_device(&addrs[i]));
+        }
+        TEST_ASSERT_NULL(app_bridge_get_device(&unknown_addr));
+    }
+    return (esp_timer_get_time() - start) * 1000 / (int64_t)(k_benchmark_rounds * (count + 1));
+}
+
+static int64_t time_endpoint_lookups(const uint16_t *endpoint_ids, uint16_t count)
+{
+    int64_t start = esp_timer_get_time();
+    for (size_t round = 0; round < k_benchmark_rounds; ++round) {
+        for (uint16_t i = 0; i < count; ++i) {
+            TEST_ASSERT_NOT_NULL(app_bridge_get_device(endpoint_ids[i]));
+        }
+    }
+    return (esp_timer_get_time() - start) * 1000 / (int64_t)(k_benchmark_rounds * count);
+}
+
+TEST_CASE("benchmark the bridged device lookups with the list and with the indexes", "[app_bridge][benchmark]")
+{
+    // Without a hash callback the lookups by address compare the address of every device of the list
+    node_t *node = test::get_or_create_node();
+    uint16_t parent_endpoint_id = init_app_bridge(node, nullptr);
+    uint16_t count = get_device_count(node);
+    TEST_ASSERT_GREATER_THAN(1, count);
+    uint32_t addrs[MAX_BRIDGED_DEVICE_COUNT];
+    uint16_t endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    for (uint16_t i = 0; i < count; ++i) {
+        addrs[i] = 0x1000 + i;
+        endpoint_ids[i] = create_device(node, parent_endpoint_id, addrs[i])->get_endpoint_id();
+    }
+    int64_t list_time = time_addr_lookups(addrs, count);
+
+    // The same devices resumed with a hash callback are looked up in the address index
+    release_devices(addrs, count);
+    TEST_ASSERT_EQUAL(ESP_OK, app_bridge_initialize(node, device_type_callback, create_test_device, free_test_device,
+                                                    hash_addr));
+    int64_t index_time = time_addr_lookups(addrs, count);
+    int64_t endpoint_time = time_endpoint_lookups(endpoint_ids, count);
+
+    printf("%u bridged devices (MAX_BRIDGED_DEVICE_COUNT %d)\n", count, MAX_BRIDGED_DEVICE_COUNT);
+    printf("lookup by address: list %" PRId64 " ns, index %" PRId64 " ns\n", list_time, index_time);
+    printf("lookup by endpoint: index %" PRId64 " ns\n", endpoint_time);
+
+    remove_devices(addrs, count);
+}
+
+#endif // MAX_BRIDGED_DEVICE_COUNT > 0
@@ -0,0 +1,314 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <measurement_reporter.h>
+
+static const char *TAG = "measurement_reporter";
+
+using namespace esp_matter;
+
+// Attribute updates applied with one stack lock, a flush with more reporters applies several batches
+static constexpr size_t k_max_batch_size = 8;
+
+struct measurement_reporter {
+    measurement_reporter_config_t config;
+    esp_matter_val_type_t type;
+
+    // Filter window, written by the driver tasks
+    float samples[MEASUREMENT_REPORTER_MAX_FILTER_WINDOW];
+    uint8_t sample_count;
+    uint8_t sample_index;
+    bool has_new_sample;
+
+    // Reporting state, only used from the Matter thread
+    bool reported;
+    // A change above the delta is waiting for the minimum interval
+    bool held;
+    int64_t last_reported_value;
+    int64_t last_report_time_us;
+
+    measurement_reporter_stats_t stats;
+    measurement_reporter *next;
+};
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static measurement_reporter *s_reporters = nullptr;
+static esp_timer_handle_t s_flush_timer = nullptr;
+static uint32_t s_batch_window_ms = 0;
+// The flush timer is armed for the earliest requested flush, protected by the flush timer lock
+static bool s_flush_armed = false;
+static int64_t s_flush_deadline_us = 0;
+
+static SemaphoreHandle_t get_flush_timer_lock()
+{
+    static StaticSemaphore_t s_flush_timer_lock_buffer;
+    static SemaphoreHandle_t s_flush_timer_lock = xSemaphoreCreateMutexStatic(&s_flush_timer_lock_buffer);
+    return s_flush_timer_lock;
+}
+
+class scoped_flush_timer_lock {
+public:
+    scoped_flush_timer_lock()
+    {
+        xSemaphoreTake(get_flush_timer_lock(), portMAX_DELAY);
+    }
+    ~scoped_flush_timer_lock()
+    {
+        xSemaphoreGive(get_flush_timer_lock());
+    }
+};
+
+static bool is_supported_type(esp_matter_val_type_t type)
+{
+    return type == ESP_MATTER_VAL_TYPE_INT16 || type == ESP_MATTER_VAL_TYPE_UINT16 ||
+           type == ESP_MATTER_VAL_TYPE_INT32 || type == ESP_MATTER_VAL_TYPE_UINT32;
+}
+
+// The null value of the nullable types is the minimum of the signed types and the maximum of the unsigned types, so it
+// is excluded for all of them
+static void set_attr_val(esp_matter_attr_val_t *val, int64_t value)
+{
+    switch (val->get_storage_type()) {
+    case ESP_MATTER_VAL_TYPE_INT16:
+        val->val.i16 = static_cast<int16_t>(value < INT16_MIN + 1 ? INT16_MIN + 1 : (value > INT16_MAX ? INT16_MAX : value));
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+        val->val.u16 = static_cast<uint16_t>(value < 0 ? 0 : (value > UINT16_MAX - 1 ? UINT16_MAX - 1 : value));
+        break;
+    case ESP_MATTER_VAL_TYPE_INT32:
+        val->val.i32 = static_cast<int32_t>(value < INT32_MIN + 1 ? INT32_MIN + 1 : (value > INT32_MAX ? INT32_MAX : value));
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+        val->val.u32 = static_cast<uint32_t>(value < 0 ? 0 : (value > UINT32_MAX - 1 ? UINT32_MAX - 1 : value));
+        break;
+    default:
+        break;
+    }
+}
+
+static int compare_float(const void *a, const void *b)
+{
+    float fa = *static_cast<const float *>(a);
+    float fb = *static_cast<const float *>(b);
+    return (fa > fb) - (fa < fb);
+}
+
+// Called with s_lock held
+static float get_filtered_value(const measurement_reporter *reporter)
+{
+    uint8_t count = reporter->sample_count;
+    switch (reporter->config.filter) {
+    case MEASUREMENT_FILTER_MOVING_AVERAGE: {
+        float sum = 0.0f;
+        for (uint8_t i = 0; i < count; ++i) {
+            sum += reporter->samples[i];
+        }
+        return sum / count;
+    }
+    case MEASUREMENT_FILTER_MEDIAN: {
+        float sorted[MEASUREMENT_REPORTER_MAX_FILTER_WINDOW];
+        memcpy(sorted, reporter->samples, count * sizeof(float));
+        qsort(sorted, count, sizeof(float), compare_float);
+        return count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    }
+    default: {
+        uint8_t last = (reporter->sample_index + reporter->config.filter_window - 1) % reporter->config.filter_window;
+        return reporter->samples[last];
+    }
+    }
+}
+
+static bool is_above_delta(const measurement_reporter_config_t &config, int64_t last, int64_t value)
+{
+    int64_t delta = llabs(value - last);
+    if (config.abs_delta <= 0.0f && config.percent_delta <= 0.0f) {
+        return delta > 0;
+    }
+    if (config.abs_delta > 0.0f && delta >= config.abs_delta) {
+        return true;
+    }
+    // An unchanged value is never above a percentage of the last value, even when the last value is 0
+    return config.percent_delta > 0.0f && delta > 0 && delta * 100.0f >= llabs(last) * config.percent_delta;
+}
+
+static void arm_flush_timer(uint64_t timeout_us)
+{
+    scoped_flush_timer_lock lock;
+    int64_t deadline_us = esp_timer_get_time() + timeout_us;
+    if (s_flush_armed) {
+        if (deadline_us >= s_flush_deadline_us) {
+            return;
+        }
+        // A sooner flush is requested, e.g. the batch window of a new sample while another reporter holds a change
+        // for its minimum interval
+        esp_timer_stop(s_flush_timer);
+    }
+    if (esp_timer_start_once(s_flush_timer, timeout_us) == ESP_OK) {
+        s_flush_armed = true;
+        s_flush_deadline_us = deadline_us;
+    }
+}
+
+// Runs in the Matter thread
+static void flush_reports()
+{
+    esp_matter_attr_val_t vals[k_max_batch_size];
+    attribute::batch_entry_t entries[k_max_batch_size];
+    size_t count = 0;
+    int64_t now = esp_timer_get_time();
+    int64_t next_flush_us = INT64_MAX;
+
+    for (measurement_reporter *reporter = s_reporters; reporter; reporter = reporter->next) {
+        const measurement_reporter_config_t &config = reporter->config;
+        portENTER_CRITICAL(&s_lock);
+        bool evaluate = (reporter->has_new_sample || reporter->held) && reporter->sample_count > 0;
+        float filtered = evaluate ? get_filtered_value(reporter) : 0.0f;
+        reporter->has_new_sample = false;
+        portEXIT_CRITICAL(&s_lock);
+        if (!evaluate) {
+            continue;
+        }
+
+        int64_t value = llroundf(filtered);
+        int64_t elapsed_us = now - reporter->last_report_time_us;
+        bool report = !reporter->reported;
+        bool forced = false;
+        reporter->held = false;
+        if (!report && is_above_delta(config, reporter->last_reported_value, value)) {
+            report = elapsed_us >= config.min_interval_ms * 1000LL;
+            if (!report) {
+                reporter->held = true;
+                reporter->stats.suppressed_by_interval++;
+                next_flush_us = std::min(next_flush_us, reporter->last_report_time_us + config.min_interval_ms * 1000LL);
+            }
+        } else if (!report && value != reporter->last_reported_value && config.max_interval_ms > 0 &&
+                   elapsed_us >= config.max_interval_ms * 1000LL) {
+            report = true;
+            forced = true;
+        } else if (!report) {
+            reporter->stats.suppressed_by_delta++;
+        }
+        if (!report) {
+            continue;
+        }
+
+        vals[count].type = reporter->type;
+        set_attr_val(&vals[count], value);
+        entries[count] = {config.endpoint_id, config.cluster_id, config.attribute_id, &vals[count]};
+        count++;
+        reporter->reported = true;
+        reporter->last_reported_value = value;
+        reporter->last_report_time_us = now;
+        reporter->stats.reports++;
+        if (forced) {
+            reporter->stats.forced_by_interval++;
+        }
+        if (count == k_max_batch_size) {
+            attribute::update_batch(entries, count);
+            count = 0;
+        }
+    }
+    if (count > 0) {
+        attribute::update_batch(entries, count);
+    }
+    if (next_flush_us != INT64_MAX) {
+        arm_flush_timer(next_flush_us > now ? next_flush_us - now : 0);
+    }
+}
+
+static void flush_timer_cb(void *arg)
+{
+    {
+        // The timer has expired, the next arming starts it again even though the flush is not run yet
+        scoped_flush_timer_lock lock;
+        s_flush_armed = false;
+    }
+    // schedule the attribute updates so that we can report them from matter thread
+    chip::DeviceLayer::SystemLayer().ScheduleLambda([]() { flush_reports(); });
+}
+
+esp_err_t measurement_reporter_init(uint32_t batch_window_ms)
+{
+    ESP_RETURN_ON_FALSE(!s_flush_timer, ESP_ERR_INVALID_STATE, TAG, "Already initialized");
+    esp_timer_create_args_t args = {
+        .callback = flush_timer_cb,
+        .name = "measurement_reporter",
+    };
+    ESP_RETURN_ON_ERROR(esp_timer_create(&args, &s_flush_timer), TAG, "Failed to create the flush timer");
+    s_batch_window_ms = batch_window_ms;
+    return ESP_OK;
+}
+
+esp_err_t measurement_reporter_create(const measurement_reporter_config_t *config,
+                                      measurement_reporter_handle_t *handle)
+{
+    ESP_RETURN_ON_FALSE(config && handle, ESP_ERR_INVALID_ARG, TAG, "config and handle cannot be NULL");
+    ESP_RETURN_ON_FALSE(s_flush_timer, ESP_ERR_INVALID_STATE, TAG, "Not initialized");
+    ESP_RETURN_ON_FALSE(config->filter_window >= 1 && config->filter_window <= MEASUREMENT_REPORTER_MAX_FILTER_WINDOW,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid filter window %u", config->filter_window);
+    ESP_RETURN_ON_FALSE(config->max_interval_ms == 0 || config->max_interval_ms >= config->min_interval_ms,
+                        ESP_ERR_INVALID_ARG, TAG, "The maximum interval is less than the minimum interval");
+
+    attribute_t *attribute = attribute::get(config->endpoint_id, config->cluster_id, config->attribute_id);
+    ESP_RETURN_ON_FALSE(attribute, ESP_ERR_INVALID_ARG, TAG, "Attribute 0x%04x/0x%08" PRIx32 "/0x%08" PRIx32
+                        " not found", config->endpoint_id, config->cluster_id, config->attribute_id);
+    esp_matter_attr_val_t val;
+    ESP_RETURN_ON_ERROR(attribute::get_val(attribute, &val), TAG, "Failed to get the attribute value");
+    ESP_RETURN_ON_FALSE(is_supported_type(val.get_storage_type()), ESP_ERR_INVALID_ARG, TAG,
+                        "Unsupported attribute type %d", val.type);
+
+    measurement_reporter *reporter = static_cast<measurement_reporter *>(calloc(1, sizeof(measurement_reporter)));
+    ESP_RETURN_ON_FALSE(reporter, ESP_ERR_NO_MEM, TAG, "Failed to allocate the reporter");
+    reporter->config = *config;
+    reporter->type = val.type;
+
+    portENTER_CRITICAL(&s_lock);
+    reporter->next = s_reporters;
+    s_reporters = reporter;
+    portEXIT_CRITICAL(&s_lock);
+    *handle = reporter;
+    return ESP_OK;
+}
+
+esp_err_t measurement_reporter_push(measurement_reporter_handle_t handle, float value)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "handle cannot be NULL");
+    portENTER_CRITICAL(&s_lock);
+    handle->samples[handle->sample_index] = value * handle->config.scale;
+    handle->sample_index = (handle->sample_index + 1) % handle->config.filter_window;
+    if (handle->sample_count < handle->config.filter_window) {
+        handle->sample_count++;
+    }
+    handle->has_new_sample = true;
+    handle->stats.samples++;
+    portEXIT_CRITICAL(&s_lock);
+    arm_flush_timer(s_batch_window_ms * 1000ULL);
+    return ESP_OK;
+}
+
+esp_err_t measurement_reporter_get_stats(measurement_reporter_handle_t handle, measurement_reporter_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(handle && stats, ESP_ERR_INVALID_ARG, TAG, "handle and stats cannot be NULL");
+    portENTER_CRITICAL(&s_lock);
+    *stats = handle->stats;
+    portEXIT_CRITICAL(&s_lock);
+    return ESP_OK;
+}
@@ -0,0 +1,118 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+// This file implements the reporting of sensor samples to the MeasuredValue attributes of the measurement clusters
+// (temperature, humidity, pressure, illuminance, flow, ...).
+//
+// The drivers push their samples from any task. The samples are filtered and the attribute is only updated when the
+// value has changed by more than a delta, so that the jitter of a sensor does not generate subscription reports and
+// NVS writes. The updates of all the sensors are applied together from the Matter thread, with one stack lock and one
+// data version change per cluster.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#define MEASUREMENT_REPORTER_MAX_FILTER_WINDOW 8
+
+typedef enum {
+    // The last sample is reported
+    MEASUREMENT_FILTER_NONE = 0,
+    // The mean of the last filter_window samples is reported
+    MEASUREMENT_FILTER_MOVING_AVERAGE,
+    // The median of the last filter_window samples is reported, which drops the isolated spikes
+    MEASUREMENT_FILTER_MEDIAN,
+} measurement_filter_t;
+
+typedef struct {
+    // Path of the attribute, its type is one of the (nullable) int16, uint16, int32 or uint32 types
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+
+    // The attribute value is the sample multiplied by scale, e.g. 100 for a temperature in 0.01 °C
+    float scale = 1.0f;
+
+    // The value is reported when it differs from the last reported value by at least abs_delta, in attribute units,
+    // or by at least percent_delta percent of the last reported value. When both are 0, any change is reported.
+    float abs_delta = 0.0f;
+    float percent_delta = 0.0f;
+
+    // Minimum time between two reports, a change above the delta is held until then
+    uint32_t min_interval_ms = 0;
+    // Maximum time a change below the delta is held, 0 holds it until the delta is reached
+    uint32_t max_interval_ms = 0;
+
+    measurement_filter_t filter = MEASUREMENT_FILTER_NONE;
+    // Number of samples of the filter, up to MEASUREMENT_REPORTER_MAX_FILTER_WINDOW
+    uint8_t filter_window = 1;
+} measurement_reporter_config_t;
+
+typedef struct {
+    // Samples pushed by the driver
+    uint32_t samples;
+    // Attribute updates
+    uint32_t reports;
+    // Evaluations which did not update the attribute because the change was below the delta
+    uint32_t suppressed_by_delta;
+    // Evaluations which held a change above the delta because of the minimum interval
+    uint32_t suppressed_by_interval;
+    // Reports of a change below the delta after the maximum interval
+    uint32_t forced_by_interval;
+} measurement_reporter_stats_t;
+
+typedef struct measurement_reporter *measurement_reporter_handle_t;
+
+/**
+ * @brief Initialize the measurement reporting. This function should be called once before creating the reporters.
+ *
+ * @param batch_window_ms The samples pushed within this window are reported together.
+ *
+ * @return esp_err_t - ESP_OK on success,
+ *                     ESP_ERR_INVALID_STATE if already initialized
+ *                     appropriate error code otherwise
+ */
+esp_err_t measurement_reporter_init(uint32_t batch_window_ms);
+
+/**
+ * @brief Create the reporter of an attribute.
+ *
+ * @param config reporter configurations, the configuration is copied.
+ * @param handle handle of the reporter.
+ *
+ * @return esp_err_t - ESP_OK on success,
+ *                     ESP_ERR_INVALID_ARG if the configuration is invalid
+ *                     ESP_ERR_INVALID_STATE if not initialized
+ *                     appropriate error code otherwise
+ */
+esp_err_t measurement_reporter_create(const measurement_reporter_config_t *config,
+                                      measurement_reporter_handle_t *handle);
+
+/**
+ * @brief Push a sample of the sensor. This function can be called from any task, except from an ISR.
+ *
+ * @param handle handle of the reporter.
+ * @param value sample in the unit of the sensor, it is multiplied by the scale of the reporter.
+ *
+ * @return esp_err_t - ESP_OK on success,
+ *                     ESP_ERR_INVALID_ARG if handle is NULL
+ *                     appropriate error code otherwise
+ */
+esp_err_t measurement_reporter_push(measurement_reporter_handle_t handle, float value);
+
+/**
+ * @brief Get the report statistics of a reporter.
+ *
+ * @param handle handle of the reporter.
+ * @param stats statistics of the reporter.
+ *
+ * @return esp_err_t - ESP_OK on success,
+ *                     ESP_ERR_INVALID_ARG if handle or stats is NULL
+ */
+esp_err_t measurement_reporter_get_stats(measurement_reporter_handle_t handle, measurement_reporter_stats_t *stats);
@@ -0,0 +1,280 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unity.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_matter.h>
+#include <esp_matter_core.h>
+#include <measurement_reporter.h>
+
+#include "cluster_lifecycle_common.h"
+
+using namespace esp_matter;
+using namespace chip::app::Clusters;
+
+static constexpr uint32_t k_batch_window_ms = 20;
+// Time for the batch window to expire and for the flush to run in the Matter thread
+static constexpr uint32_t k_flush_wait_ms = 200;
+
+static void wait_for_flush(uint32_t wait_ms = k_flush_wait_ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(wait_ms));
+}
+
+// Each case reports to the MeasuredValue of its own temperature sensor, the reporters of the previous cases get no
+// more samples and are not evaluated again
+static measurement_reporter_handle_t create_reporter(measurement_reporter_config_t *config)
+{
+    node_t *node = test::get_or_create_node();
+    test::start_matter_if_needed();
+    esp_err_t err = measurement_reporter_init(k_batch_window_ms);
+    TEST_ASSERT_TRUE(err == ESP_OK || err == ESP_ERR_INVALID_STATE);
+
+    endpoint::temperature_sensor::config_t endpoint_config;
+    endpoint_t *endpoint = endpoint::temperature_sensor::create(node, &endpoint_config, ENDPOINT_FLAG_DESTROYABLE,
+                                                                nullptr);
+    TEST_ASSERT_NOT_NULL(endpoint);
+    TEST_ASSERT_EQUAL(ESP_OK, endpoint::enable(endpoint));
+
+    config->endpoint_id = endpoint::get_id(endpoint);
+    config->cluster_id = TemperatureMeasurement::Id;
+    config->attribute_id = TemperatureMeasurement::Attributes::MeasuredValue::Id;
+    measurement_reporter_handle_t handle = nullptr;
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_create(config, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+    return handle;
+}
+
+static int16_t get_measured_value(const measurement_reporter_config_t &config)
+{
+    attribute_t *attribute = attribute::get(config.endpoint_id, config.cluster_id, config.attribute_id);
+    TEST_ASSERT_NOT_NULL(attribute);
+    esp_matter_attr_val_t val;
+    TEST_ASSERT_EQUAL(ESP_OK, attribute::get_val(attribute, &val));
+    return val.val.i16;
+}
+
+static measurement_reporter_stats_t get_stats(measurement_reporter_handle_t handle)
+{
+    measurement_reporter_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_get_stats(handle, &stats));
+    return stats;
+}
+
+TEST_CASE("measurement reporter rejects invalid configurations", "[measurement_reporter]")
+{
+    measurement_reporter_config_t config;
+    measurement_reporter_handle_t handle = create_reporter(&config);
+    measurement_reporter_handle_t invalid = nullptr;
+
+    measurement_reporter_config_t invalid_config = config;
+    invalid_config.filter_window = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, measurement_reporter_create(&invalid_config, &invalid));
+    invalid_config.filter_window = MEASUREMENT_REPORTER_MAX_FILTER_WINDOW + 1;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, measurement_reporter_create(&invalid_config, &invalid));
+
+    invalid_config = config;
+    invalid_config.min_interval_ms = 1000;
+    invalid_config.max_interval_ms = 500;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, measurement_reporter_create(&invalid_config, &invalid));
+
+    // The attribute must exist and have an integer type of 16 or 32 bits
+    invalid_config = config;
+    invalid_config.cluster_id = OnOff::Id;
+    invalid_config.attribute_id = OnOff::Attributes::OnOff::Id;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, measurement_reporter_create(&invalid_config, &invalid));
+    invalid_config = config;
+    invalid_config.cluster_id = Identify::Id;
+    invalid_config.attribute_id = Identify::Attributes::IdentifyType::Id;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, measurement_reporter_create(&invalid_config, &invalid));
+    TEST_ASSERT_NULL(invalid);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, measurement_reporter_push(nullptr, 1.0f));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, measurement_reporter_get_stats(handle, nullptr));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, measurement_reporter_init(k_batch_window_ms));
+}
+
+TEST_CASE("measurement reporter suppresses the changes below the absolute delta", "[measurement_reporter]")
+{
+    measurement_reporter_config_t config;
+    config.scale = 100.0f;
+    config.abs_delta = 50.0f;
+    measurement_reporter_handle_t handle = create_reporter(&config);
+
+    // The first sample is always reported
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 20.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(2000, get_measured_value(config));
+
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 20.3f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(2000, get_measured_value(config));
+
+    // The delta is taken from the last reported value, not from the last sample
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 20.5f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(2050, get_measured_value(config));
+
+    measurement_reporter_stats_t stats = get_stats(handle);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.reports);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.suppressed_by_delta);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.suppressed_by_interval);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.forced_by_interval);
+}
+
+TEST_CASE("measurement reporter suppresses the changes below the percent delta", "[measurement_reporter]")
+{
+    measurement_reporter_config_t config;
+    config.percent_delta = 10.0f;
+    measurement_reporter_handle_t handle = create_reporter(&config);
+
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 0.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(0, get_measured_value(config));
+
+    // An unchanged 0 is not reported again, any change from 0 is
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 0.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats(handle).reports);
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 100.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(100, get_measured_value(config));
+
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 109.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(100, get_measured_value(config));
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 90.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(90, get_measured_value(config));
+
+    measurement_reporter_stats_t stats = get_stats(handle);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.reports);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.suppressed_by_delta);
+}
+
+TEST_CASE("measurement reporter holds a change until the minimum interval", "[measurement_reporter]")
+{
+    measurement_reporter_config_t config;
+    config.abs_delta = 1.0f;
+    config.min_interval_ms = 1000;
+    measurement_reporter_handle_t handle = create_reporter(&config);
+
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 10.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(10, get_measured_value(config));
+
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 20.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(10, get_measured_value(config));
+    measurement_reporter_stats_t stats = get_stats(handle);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.reports);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.suppressed_by_interval);
+
+    // The held change is reported without a new sample
+    wait_for_flush(config.min_interval_ms);
+    TEST_ASSERT_EQUAL_INT16(20, get_measured_value(config));
+    stats = get_stats(handle);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.reports);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.suppressed_by_delta);
+}
+
+TEST_CASE("measurement reporter forces a change below the delta after the maximum interval", "[measurement_reporter]")
+{
+    measurement_reporter_config_t config;
+    config.abs_delta = 100.0f;
+    config.max_interval_ms = 500;
+    measurement_reporter_handle_t handle = create_reporter(&config);
+
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 10.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 20.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(10, get_measured_value(config));
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats(handle).suppressed_by_delta);
+
+    wait_for_flush(config.max_interval_ms);
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 20.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(20, get_measured_value(config));
+
+    // An unchanged value is not forced
+    wait_for_flush(config.max_interval_ms);
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 20.0f));
+    wait_for_flush();
+
+    measurement_reporter_stats_t stats = get_stats(handle);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.reports);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.forced_by_interval);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.suppressed_by_delta);
+}
+
+TEST_CASE("measurement reporter filters the samples with a moving average or a median", "[measurement_reporter]")
+{
+    measurement_reporter_config_t average_config;
+    average_config.filter = MEASUREMENT_FILTER_MOVING_AVERAGE;
+    average_config.filter_window = 4;
+    measurement_reporter_handle_t average = create_reporter(&average_config);
+
+    measurement_reporter_config_t median_config;
+    median_config.filter = MEASUREMENT_FILTER_MEDIAN;
+    median_config.filter_window = 3;
+    measurement_reporter_handle_t median = create_reporter(&median_config);
+
+    // The samples pushed within the batch window are evaluated once
+    const float average_samples[] = {10.0f, 20.0f, 30.0f, 40.0f};
+    for (float sample : average_samples) {
+        TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(average, sample));
+    }
+    const float median_samples[] = {10.0f, 1000.0f, 12.0f};
+    for (float sample : median_samples) {
+        TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(median, sample));
+    }
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(25, get_measured_value(average_config));
+    TEST_ASSERT_EQUAL_INT16(12, get_measured_value(median_config));
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats(average).reports);
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats(median).reports);
+
+    // The oldest sample leaves the window
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(average, 50.0f));
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(median, 14.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(35, get_measured_value(average_config));
+    TEST_ASSERT_EQUAL_INT16(14, get_measured_value(median_config));
+}
+
+TEST_CASE("measurement reporter flushes a new sample while another reporter holds a change", "[measurement_reporter]")
+{
+    measurement_reporter_config_t held_config;
+    held_config.min_interval_ms = 2000;
+    measurement_reporter_handle_t held = create_reporter(&held_config);
+
+    measurement_reporter_config_t config;
+    measurement_reporter_handle_t handle = create_reporter(&config);
+
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(held, 10.0f));
+    wait_for_flush();
+    // The flush timer is armed for the minimum interval of the held change
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(held, 20.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats(held).suppressed_by_interval);
+
+    // The batch window of the new sample is sooner, the timer is restarted for it
+    TEST_ASSERT_EQUAL(ESP_OK, measurement_reporter_push(handle, 30.0f));
+    wait_for_flush();
+    TEST_ASSERT_EQUAL_INT16(30, get_measured_value(config));
+    TEST_ASSERT_EQUAL_INT16(10, get_measured_value(held_config));
+
+    // The held change is still reported at the end of its minimum interval
+    wait_for_flush(held_config.min_interval_ms);
+    TEST_ASSERT_EQUAL_INT16(20, get_measured_value(held_config));
+    TEST_ASSERT_EQUAL_UINT32(2, get_stats(held).reports);
+}
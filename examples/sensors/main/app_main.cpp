@@ -18,6 +18,7 @@
 #include <app_openthread_config.h>
 #include <app_reset.h>
 #include <common_macros.h>
+#include <measurement_reporter.h>
 
 // drivers implemented by this example
 #include <drivers/shtc3.h>
@@ -30,42 +31,20 @@ using namespace esp_matter::attribute;
 using namespace esp_matter::endpoint;
 using namespace chip::app::Clusters;
 
-// Application cluster specification, 7.18.2.11. Temperature
-// represents a temperature on the Celsius scale with a resolution of 0.01°C.
-// temp = (temperature in °C) x 100
+static measurement_reporter_handle_t s_temp_reporter = nullptr;
+static measurement_reporter_handle_t s_humidity_reporter = nullptr;
+
+// The SHTC3 samples are pushed to the measurement reporters, which update the attributes only when the filtered value
+// changes by more than the deltas configured in create_measurement_reporters(), so the jitter of the sensor does not
+// generate subscription reports.
 static void temp_sensor_notification(uint16_t endpoint_id, float temp, void *user_data)
 {
-    // schedule the attribute update so that we can report it from matter thread
-    chip::DeviceLayer::SystemLayer().ScheduleLambda([endpoint_id, temp]() {
-        attribute_t * attribute = attribute::get(endpoint_id,
-                                                 TemperatureMeasurement::Id,
-                                                 TemperatureMeasurement::Attributes::MeasuredValue::Id);
-
-        esp_matter_attr_val_t val;
-        attribute::get_val(attribute, &val);
-        val.val.i16 = static_cast<int16_t>(temp * 100);
-
-        attribute::update(endpoint_id, TemperatureMeasurement::Id, TemperatureMeasurement::Attributes::MeasuredValue::Id, &val);
-    });
+    measurement_reporter_push(s_temp_reporter, temp);
 }
 
-// Application cluster specification, 2.6.4.1. MeasuredValue Attribute
-// represents the humidity in percent.
-// humidity = (humidity in %) x 100
 static void humidity_sensor_notification(uint16_t endpoint_id, float humidity, void *user_data)
 {
-    // schedule the attribute update so that we can report it from matter thread
-    chip::DeviceLayer::SystemLayer().ScheduleLambda([endpoint_id, humidity]() {
-        attribute_t * attribute = attribute::get(endpoint_id,
-                                                 RelativeHumidityMeasurement::Id,
-                                                 RelativeHumidityMeasurement::Attributes::MeasuredValue::Id);
-
-        esp_matter_attr_val_t val;
-        attribute::get_val(attribute, &val);
-        val.val.u16 = static_cast<uint16_t>(humidity * 100);
-
-        attribute::update(endpoint_id, RelativeHumidityMeasurement::Id, RelativeHumidityMeasurement::Attributes::MeasuredValue::Id, &val);
-    });
+    measurement_reporter_push(s_humidity_reporter, humidity);
 }
 
 static void occupancy_sensor_notification(uint16_t endpoint_id, bool occupancy, void *user_data)
@@ -84,6 +63,43 @@ static void occupancy_sensor_notification(uint16_t endpoint_id, bool occupancy,
     });
 }
 
+static esp_err_t create_measurement_reporters(uint16_t temp_endpoint_id, uint16_t humidity_endpoint_id)
+{
+    esp_err_t err = measurement_reporter_init(CONFIG_MEASUREMENT_REPORT_BATCH_WINDOW_MS);
+    VerifyOrReturnError(err == ESP_OK, err);
+
+    // Application cluster specification, 7.18.2.11. Temperature
+    // represents a temperature on the Celsius scale with a resolution of 0.01°C.
+    // temp = (temperature in °C) x 100
+    measurement_reporter_config_t temp_config;
+    temp_config.endpoint_id = temp_endpoint_id;
+    temp_config.cluster_id = TemperatureMeasurement::Id;
+    temp_config.attribute_id = TemperatureMeasurement::Attributes::MeasuredValue::Id;
+    temp_config.scale = 100;
+    temp_config.abs_delta = CONFIG_TEMPERATURE_REPORT_DELTA;
+    temp_config.min_interval_ms = CONFIG_MEASUREMENT_REPORT_MIN_INTERVAL_MS;
+    temp_config.max_interval_ms = CONFIG_MEASUREMENT_REPORT_MAX_INTERVAL_MS;
+    temp_config.filter = MEASUREMENT_FILTER_MEDIAN;
+    temp_config.filter_window = 3;
+    err = measurement_reporter_create(&temp_config, &s_temp_reporter);
+    VerifyOrReturnError(err == ESP_OK, err);
+
+    // Application cluster specification, 2.6.4.1. MeasuredValue Attribute
+    // represents the humidity in percent.
+    // humidity = (humidity in %) x 100
+    measurement_reporter_config_t humidity_config;
+    humidity_config.endpoint_id = humidity_endpoint_id;
+    humidity_config.cluster_id = RelativeHumidityMeasurement::Id;
+    humidity_config.attribute_id = RelativeHumidityMeasurement::Attributes::MeasuredValue::Id;
+    humidity_config.scale = 100;
+    humidity_config.abs_delta = CONFIG_HUMIDITY_REPORT_DELTA;
+    humidity_config.min_interval_ms = CONFIG_MEASUREMENT_REPORT_MIN_INTERVAL_MS;
+    humidity_config.max_interval_ms = CONFIG_MEASUREMENT_REPORT_MAX_INTERVAL_MS;
+    humidity_config.filter = MEASUREMENT_FILTER_MOVING_AVERAGE;
+    humidity_config.filter_window = 4;
+    return measurement_reporter_create(&humidity_config, &s_humidity_reporter);
+}
+
 static esp_err_t factory_reset_button_register()
 {
     button_handle_t push_button;
@@ -177,6 +193,9 @@ extern "C" void app_main()
     endpoint_t * humidity_sensor_ep = humidity_sensor::create(node, &humidity_sensor_config, ENDPOINT_FLAG_NONE, NULL);
     ABORT_APP_ON_FAILURE(humidity_sensor_ep != nullptr, ESP_LOGE(TAG, "Failed to create humidity_sensor endpoint"));
 
+    err = create_measurement_reporters(endpoint::get_id(temp_sensor_ep), endpoint::get_id(humidity_sensor_ep));
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to create measurement reporters, err:%d", err));
+
     // initialize temperature and humidity sensor driver (shtc3)
     static shtc3_sensor_config_t shtc3_config = {
         .temperature = {
@@ -4,6 +4,52 @@
 import pytest
 from pytest_embedded_qemu.dut import QemuDut
 
+# Builds of the app, see README.md: "defaults" only uses sdkconfig.defaults, "features" also enables the optional
+# features of sdkconfig.defaults.features
+CONFIGS = ["defaults", "features"]
+
+# Unity groups run in every build, each group gets its own QEMU boot
+GROUPS = [
+    "path_index",
+    "nvs_cache",
+    "mem_pool",
+    "ember_stubs",
+    "frozen",
+    "read_cache",
+    "bridge",
+    "dispatch",
+    "encoded_payload",
+    "nvs_preload",
+    "instance_pool",
+    "measurement_reporter",
+    "app_bridge",
+]
+
+# Unity groups whose cases are only built with the options of sdkconfig.defaults.features
+FEATURE_GROUPS = [
+    "client_cache",
+    "ota_candidates",
+    "ota_image_cache",
+    "ota_prefetcher",
+]
+
+# Timeouts of the groups whose cases take longer than the default of run_group(), in seconds
+GROUP_TIMEOUTS = {
+    # The prefetcher benchmark downloads a multi-MB image twice
+    "ota_prefetcher": 600,
+}
+
+# Builds of the esp_matter_controller tests, which disable the Matter server for the commissioner, see README.md
+CONTROLLER_CONFIGS = ["controller_spiffs", "controller_dcl"]
+
+# Unity groups of the controller builds
+CONTROLLER_GROUPS = [
+    "da_revocation",
+    "trust_store",
+    "report_log",
+    "fanout",
+]
+
 
 def run_group(dut: QemuDut, group: str, timeout: int = 120) -> None:
     """Run all Unity cases matching a group tag, then verify no failures.
@@ -25,6 +71,7 @@ def run_group(dut: QemuDut, group: str, timeout: int = 120) -> None:
 @pytest.mark.host_test
 @pytest.mark.qemu
 @pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
 def test_get_val(dut: QemuDut) -> None:
     run_group(dut, "get_val")
 
@@ -32,6 +79,7 @@ def test_get_val(dut: QemuDut) -> None:
 @pytest.mark.host_test
 @pytest.mark.qemu
 @pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
 def test_get_val_type(dut: QemuDut) -> None:
     run_group(dut, "get_val_type")
 
@@ -39,6 +87,7 @@ def test_get_val_type(dut: QemuDut) -> None:
 @pytest.mark.host_test
 @pytest.mark.qemu
 @pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
 def test_update_report(dut: QemuDut) -> None:
     run_group(dut, "report")
     run_group(dut, "update")
@@ -47,6 +96,7 @@ def test_update_report(dut: QemuDut) -> None:
 @pytest.mark.host_test
 @pytest.mark.qemu
 @pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
 def test_jsontlv(dut: QemuDut) -> None:
     run_group(dut, "jsontlv")
 
@@ -54,6 +104,7 @@ def test_jsontlv(dut: QemuDut) -> None:
 @pytest.mark.host_test
 @pytest.mark.qemu
 @pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
 def test_lifecycle(dut: QemuDut) -> None:
     run_group(dut, "cluster_lifecycle")
 
@@ -61,6 +112,7 @@ def test_lifecycle(dut: QemuDut) -> None:
 @pytest.mark.host_test
 @pytest.mark.qemu
 @pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
 def test_attribute_create_value_persistence(dut: QemuDut) -> None:
     """Runs TEST_CASE_MULTIPLE_STAGES cases (both stages, including across SW reset)."""
     dut.run_all_single_board_cases(
@@ -76,5 +128,33 @@ def test_attribute_create_value_persistence(dut: QemuDut) -> None:
 @pytest.mark.host_test
 @pytest.mark.qemu
 @pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
 def test_optional_clusters(dut: QemuDut) -> None:
     run_group(dut, "optional_clusters")
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONFIGS, indirect=True)
+@pytest.mark.parametrize("group", GROUPS)
+def test_group(dut: QemuDut, group: str) -> None:
+    run_group(dut, group)
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.esp32c3
+@pytest.mark.parametrize("config", ["features"], indirect=True)
+@pytest.mark.parametrize("group", FEATURE_GROUPS)
+def test_feature_group(dut: QemuDut, group: str) -> None:
+    run_group(dut, group, GROUP_TIMEOUTS.get(group, 120))
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.esp32c3
+@pytest.mark.parametrize("config", CONTROLLER_CONFIGS, indirect=True)
+@pytest.mark.parametrize("group", CONTROLLER_GROUPS)
+def test_controller_group(dut: QemuDut, group: str) -> None:
+    run_group(dut, group)